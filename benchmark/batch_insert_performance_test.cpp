@@ -0,0 +1,125 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/log/log.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 对比逐条插入与批量插入的速度
+ * @details 使用磁盘日志，表上有一个 B+ 树索引。参数是每次插入的行数。
+ * 没有使用 MVCC 事务，因为提交时要等待日志刷盘，时间主要花在等待上
+ */
+class BatchInsertBenchmark : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State &state) override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    RC rc = db_->init("bench_db", test_directory_.c_str(), "vacuous", "disk");
+    ASSERT(OB_SUCC(rc), "failed to init db. rc=%s", strrc(rc));
+
+    AttrInfoSqlNode attr_infos[2];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "name";
+    attr_infos[1].type   = AttrType::CHARS;
+    attr_infos[1].length = 32;
+    rc = db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 2));
+    ASSERT(OB_SUCC(rc), "failed to create table. rc=%s", strrc(rc));
+
+    table_   = db_->find_table("t");
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    rc       = table_->create_index(trx, table_->table_meta().field("id"), "i_id", IndexType::BPLUS_TREE, 1.0f);
+    ASSERT(OB_SUCC(rc), "failed to create index. rc=%s", strrc(rc));
+    db_->trx_kit().destroy_trx(trx);
+    next_id_ = 0;
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+  void make_records(int num, vector<Record> &records)
+  {
+    records.resize(num);
+    for (int i = 0; i < num; i++) {
+      Value values[2] = {Value(next_id_++), Value("benchmark")};
+      table_->make_record(2, values, records[i]);
+    }
+  }
+
+protected:
+  filesystem::path test_directory_{"batch_insert_benchmark"};
+  unique_ptr<Db>   db_;
+  Table           *table_   = nullptr;
+  int              next_id_ = 0;
+};
+
+/// 每行一次 Trx::insert_record，相当于每行一条 INSERT 语句
+BENCHMARK_DEFINE_F(BatchInsertBenchmark, SingleRow)(benchmark::State &state)
+{
+  const int      rows = static_cast<int>(state.range(0));
+  vector<Record> records;
+  for (auto _ : state) {
+    state.PauseTiming();
+    make_records(rows, records);
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    state.ResumeTiming();
+
+    for (Record &record : records) {
+      trx->insert_record(table_, record);
+    }
+    trx->commit();
+
+    state.PauseTiming();
+    db_->trx_kit().destroy_trx(trx);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+/// 所有行一次 Trx::insert_records，相当于一条多行的 INSERT 语句
+BENCHMARK_DEFINE_F(BatchInsertBenchmark, Batch)(benchmark::State &state)
+{
+  const int      rows = static_cast<int>(state.range(0));
+  vector<Record> records;
+  for (auto _ : state) {
+    state.PauseTiming();
+    make_records(rows, records);
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    state.ResumeTiming();
+
+    trx->insert_records(table_, records);
+    trx->commit();
+
+    state.PauseTiming();
+    db_->trx_kit().destroy_trx(trx);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+BENCHMARK_REGISTER_F(BatchInsertBenchmark, SingleRow)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_REGISTER_F(BatchInsertBenchmark, Batch)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+
+#include "common/lang/algorithm.h"
+#include "common/lang/random.h"
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/index/bplus_tree.h"
+#include "storage/index/bplus_tree_bulk_loader.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 只统计日志条数和大小，不落盘
+ */
+class CountingLogHandler : public VacuousLogHandler
+{
+public:
+  int64_t entry_count = 0;
+  int64_t entry_bytes = 0;
+
+private:
+  RC _append(LSN &lsn, LogModule module, vector<char> &&data) override
+  {
+    lsn = 0;
+    entry_count++;
+    entry_bytes += static_cast<int64_t>(data.size());
+    return RC::SUCCESS;
+  }
+};
+
+/**
+ * @brief 对比逐条插入与批量构建B+树的耗时和日志量
+ * @details 参数是数据条数。数据按照随机顺序给出，模拟扫描一张表建索引的场景。
+ */
+class BplusTreeBuildBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    LoggerFactory::init_default("bplus_tree_build_performance_test.log", LOG_LEVEL_WARN);
+    bpm_ = make_unique<BufferPoolManager>();
+    bpm_->init(make_unique<VacuousDoubleWriteBuffer>());
+    log_handler_.entry_count = 0;
+    log_handler_.entry_bytes = 0;
+
+    keys_.resize(state.range(0));
+    for (int32_t i = 0; i < static_cast<int32_t>(keys_.size()); i++) {
+      keys_[i] = i;
+    }
+    shuffle(keys_.begin(), keys_.end(), mt19937(static_cast<uint32_t>(keys_.size())));
+  }
+
+  void TearDown(const State &state) override
+  {
+    bpm_.reset();
+    ::remove(filename_.c_str());
+  }
+
+protected:
+  void CreateTree()
+  {
+    ::remove(filename_.c_str());
+    if (bpm_->create_file(filename_.c_str()) != RC::SUCCESS ||
+        bpm_->open_file(log_handler_, filename_.c_str(), buffer_pool_) != RC::SUCCESS ||
+        handler_.create(log_handler_, *buffer_pool_, AttrType::INTS, sizeof(int32_t)) != RC::SUCCESS) {
+      throw runtime_error("failed to create btree");
+    }
+  }
+
+  void CloseTree()
+  {
+    handler_.close();
+    bpm_->close_file(filename_.c_str());
+    buffer_pool_ = nullptr;
+  }
+
+  void ReportLog(State &state)
+  {
+    state.counters["log_entries"] = Counter(log_handler_.entry_count, Counter::kAvgIterations);
+    state.counters["log_bytes"]   = Counter(log_handler_.entry_bytes, Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * keys_.size());
+  }
+
+protected:
+  string                        filename_ = "bplus_tree_build_performance_test.btree";
+  unique_ptr<BufferPoolManager> bpm_;
+  CountingLogHandler            log_handler_;
+  DiskBufferPool               *buffer_pool_ = nullptr;
+  BplusTreeHandler              handler_;
+  vector<int32_t>               keys_;
+};
+
+BENCHMARK_DEFINE_F(BplusTreeBuildBenchmark, InsertEntry)(State &state)
+{
+  for (auto _ : state) {
+    state.PauseTiming();
+    CreateTree();
+    state.ResumeTiming();
+
+    for (int32_t key : keys_) {
+      RID rid(key / 1024, key % 1024);
+      if (handler_.insert_entry(reinterpret_cast<const char *>(&key), &rid) != RC::SUCCESS) {
+        throw runtime_error("failed to insert entry");
+      }
+    }
+
+    state.PauseTiming();
+    CloseTree();
+    state.ResumeTiming();
+  }
+  ReportLog(state);
+}
+
+BENCHMARK_DEFINE_F(BplusTreeBuildBenchmark, BulkLoad)(State &state)
+{
+  for (auto _ : state) {
+    state.PauseTiming();
+    CreateTree();
+    state.ResumeTiming();
+
+    {
+      BplusTreeEntrySorter sorter(AttrType::INTS, sizeof(int32_t), filename_);
+      for (int32_t key : keys_) {
+        RID rid(key / 1024, key % 1024);
+        sorter.add(reinterpret_cast<const char *>(&key), rid);
+      }
+      BplusTreeBulkLoader loader(handler_, DEFAULT_INDEX_FILL_FACTOR);
+      if (sorter.sort() != RC::SUCCESS || loader.load(sorter) != RC::SUCCESS) {
+        throw runtime_error("failed to bulk load");
+      }
+    }
+
+    state.PauseTiming();
+    CloseTree();
+    state.ResumeTiming();
+  }
+  ReportLog(state);
+}
+
+BENCHMARK_REGISTER_F(BplusTreeBuildBenchmark, InsertEntry)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(BplusTreeBuildBenchmark, BulkLoad)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,181 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+
+#include "common/lang/algorithm.h"
+#include "common/lang/random.h"
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/index/bplus_tree.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief CHAR(64) 字段上的B+树索引的高度、页面个数和点查性能
+ * @details 参数是键值的个数。键值是随机顺序插入的邮箱地址，长度远小于字段长度，并且有较长的公共前缀。
+ * 构建一千万个键值的索引需要很长时间，同一个参数的多次运行共用一份数据。
+ */
+class CharsIndexBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    const int64_t key_num = state.range(0);
+    if (key_num == key_num_) {
+      return;
+    }
+
+    LoggerFactory::init_default("bplus_tree_chars_performance_test.log", LOG_LEVEL_WARN);
+    cleanup();
+
+    // 缓冲池足够大，索引的所有页面都在内存中，页面个数就是索引占用的缓冲池大小
+    bpm_ = make_unique<BufferPoolManager>(static_cast<int>(BUFFER_POOL_MEMORY));
+    bpm_->init(make_unique<VacuousDoubleWriteBuffer>());
+    if (bpm_->create_file(file_name_.c_str()) != RC::SUCCESS ||
+        bpm_->open_file(log_handler_, file_name_.c_str(), buffer_pool_) != RC::SUCCESS ||
+        handler_.create(log_handler_, *buffer_pool_, AttrType::CHARS, ATTR_LENGTH) != RC::SUCCESS) {
+      throw runtime_error("failed to create btree");
+    }
+
+    vector<int32_t> ids(key_num);
+    for (int32_t i = 0; i < static_cast<int32_t>(key_num); i++) {
+      ids[i] = i;
+    }
+    shuffle(ids.begin(), ids.end(), mt19937(static_cast<uint32_t>(key_num)));
+
+    char key[ATTR_LENGTH];
+    for (int32_t id : ids) {
+      make_key(id, key);
+      RID rid(id / 1024, id % 1024);
+      if (handler_.insert_entry(key, &rid) != RC::SUCCESS) {
+        throw runtime_error("failed to insert entry");
+      }
+    }
+
+    ids.resize(PROBE_NUM);
+    mt19937 random(static_cast<uint32_t>(key_num));
+    for (int32_t &id : ids) {
+      id = uniform_int_distribution<int32_t>(0, static_cast<int32_t>(key_num - 1))(random);
+    }
+    probe_ids_ = std::move(ids);
+    collect_statistics();
+    key_num_ = key_num;
+  }
+
+  void TearDown(const State &state) override {}
+
+  static void cleanup()
+  {
+    handler_.close();
+    bpm_.reset();
+    buffer_pool_ = nullptr;
+    ::remove(file_name_.c_str());
+    key_num_ = 0;
+  }
+
+protected:
+  static void make_key(int32_t id, char *key)
+  {
+    memset(key, 0, ATTR_LENGTH);
+    snprintf(key, ATTR_LENGTH, "user%010d@mail.example.com", id);
+  }
+
+  /// @brief 从根节点开始逐层遍历，统计树的高度和每一层的页面个数
+  static void collect_statistics()
+  {
+    BplusTreeMiniTransaction mtr(handler_);
+    const IndexFileHeader   &header = handler_.file_header();
+
+    height_ = 0;
+    pages_  = 0;
+    vector<PageNum> level{header.root_page};
+    while (!level.empty()) {
+      height_++;
+      pages_ += static_cast<int64_t>(level.size());
+
+      vector<PageNum> next_level;
+      for (PageNum page_num : level) {
+        Frame *frame = nullptr;
+        if (buffer_pool_->get_this_page(page_num, &frame) != RC::SUCCESS) {
+          throw runtime_error("failed to get page");
+        }
+        IndexNodeHandler node(mtr, header, frame);
+        if (!node.is_leaf()) {
+          InternalIndexNodeHandler internal_node(mtr, header, frame);
+          for (int i = 0; i < internal_node.size(); i++) {
+            next_level.push_back(internal_node.value_at(i));
+          }
+        }
+        buffer_pool_->unpin_page(frame);
+      }
+      leaf_pages_ = static_cast<int64_t>(level.size());
+      level.swap(next_level);
+    }
+  }
+
+  static void report(State &state)
+  {
+    state.counters["height"]        = height_;
+    state.counters["leaf_pages"]    = leaf_pages_;
+    state.counters["pages"]         = pages_;
+    state.counters["footprint_MiB"] = static_cast<double>(pages_) * BP_PAGE_SIZE / (1024 * 1024);
+    state.counters["leaf_max_size"] = handler_.file_header().leaf_max_size;
+  }
+
+protected:
+  static constexpr int     ATTR_LENGTH        = 64;
+  static constexpr int     PROBE_NUM          = 65536;
+  static constexpr int64_t BUFFER_POOL_MEMORY = 1800LL * 1024 * 1024;
+
+  static inline string                        file_name_ = "bplus_tree_chars_performance_test.btree";
+  static inline unique_ptr<BufferPoolManager> bpm_;
+  static inline VacuousLogHandler             log_handler_;
+  static inline DiskBufferPool               *buffer_pool_ = nullptr;
+  static inline BplusTreeHandler              handler_;
+  static inline vector<int32_t>               probe_ids_;
+  static inline int64_t                       key_num_    = 0;
+  static inline int                           height_     = 0;
+  static inline int64_t                       leaf_pages_ = 0;
+  static inline int64_t                       pages_      = 0;
+};
+
+BENCHMARK_DEFINE_F(CharsIndexBenchmark, GetEntry)(State &state)
+{
+  char      key[ATTR_LENGTH];
+  list<RID> rids;
+  for (auto _ : state) {
+    for (int32_t id : probe_ids_) {
+      make_key(id, key);
+      rids.clear();
+      if (handler_.get_entry(key, static_cast<int>(strlen(key)), rids) != RC::SUCCESS || rids.size() != 1) {
+        throw runtime_error("failed to get entry");
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * probe_ids_.size());
+  report(state);
+}
+
+BENCHMARK_REGISTER_F(CharsIndexBenchmark, GetEntry)->Arg(1000000)->Arg(10000000);
+
+int main(int argc, char **argv)
+{
+  Initialize(&argc, argv);
+  RunSpecifiedBenchmarks();
+  CharsIndexBenchmark::cleanup();
+  Shutdown();
+  return 0;
+}
@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 #include <benchmark/benchmark.h>
 #include <inttypes.h>
 
+#include "common/lang/atomic.h"
+
 #include "common/lang/stdexcept.h"
 #include "common/log/log.h"
 #include "common/math/integer_generator.h"
@@ -42,6 +44,35 @@ struct Stat
   int64_t scan_other_count       = 0;
 };
 
+/**
+ * @brief 统计写入了多少日志，日志本身直接丢弃
+ */
+class CountingLogHandler : public VacuousLogHandler
+{
+public:
+  void reset()
+  {
+    bytes_   = 0;
+    entries_ = 0;
+  }
+
+  int64_t bytes() const { return bytes_.load(); }
+  int64_t entries() const { return entries_.load(); }
+
+private:
+  RC _append(LSN &lsn, LogModule module, vector<char> &&data) override
+  {
+    bytes_ += static_cast<int64_t>(data.size());
+    entries_++;
+    lsn = 0;
+    return RC::SUCCESS;
+  }
+
+private:
+  atomic<int64_t> bytes_{0};
+  atomic<int64_t> entries_{0};
+};
+
 class BenchmarkBase : public Fixture
 {
 public:
@@ -64,6 +95,8 @@ public:
     LoggerFactory::init_default(log_name.c_str(), LOG_LEVEL_TRACE);
 
     ::remove(btree_filename.c_str());
+    log_handler_.reset();
+    insert_count_ = 0;
 
     const int internal_max_size = 200;
     const int leaf_max_size     = 200;
@@ -117,6 +150,7 @@ public:
     const char *key = reinterpret_cast<const char *>(&value);
     RID         rid(value, value);
 
+    insert_count_++;
     RC rc = handler_.insert_entry(key, &rid);
     switch (rc) {
       case RC::SUCCESS: {
@@ -181,9 +215,10 @@ public:
   }
 
 protected:
-  BufferPoolManager bpm_{512};
-  BplusTreeHandler  handler_;
-  VacuousLogHandler log_handler_;
+  BufferPoolManager  bpm_{64 * 1024 * 1024};  // 整棵树都在内存中，不测试换页
+  BplusTreeHandler   handler_;
+  CountingLogHandler log_handler_;
+  atomic<int64_t>    insert_count_{0};
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -206,9 +241,14 @@ BENCHMARK_DEFINE_F(InsertionBenchmark, Insertion)(State &state)
   state.counters["success"]   = Counter(stat.insert_success_count, Counter::kIsRate);
   state.counters["duplicate"] = Counter(stat.duplicate_count, Counter::kIsRate);
   state.counters["other"]     = Counter(stat.insert_other_count, Counter::kIsRate);
+
+  // 循环结束时所有线程都已经停止插入，每个线程报告的都是总数
+  const double inserts                     = static_cast<double>(max<int64_t>(insert_count_.load(), 1));
+  state.counters["log_bytes_per_insert"]   = Counter(log_handler_.bytes() / inserts, Counter::kAvgThreads);
+  state.counters["log_entries_per_insert"] = Counter(log_handler_.entries() / inserts, Counter::kAvgThreads);
 }
 
-BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(10);
+BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(1)->Threads(10);
 
 ////////////////////////////////////////////////////////////////////////////////
 
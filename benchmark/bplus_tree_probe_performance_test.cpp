@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+
+#include "common/lang/algorithm.h"
+#include "common/lang/random.h"
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/index/bplus_tree.h"
+#include "storage/index/bplus_tree_bulk_loader.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 对比逐个查找与批量查找B+树的吞吐量
+ * @details 第一个参数是一批查找多少个键值，第二个参数是一批键值分布在多大的范围内。
+ * 范围小表示键值比较密集，比如连接时外表的数据有序且与内表的键值接近。
+ * 每轮查找的键值总数相同，缓冲池可以放下整棵树，结果不受磁盘读写的影响。
+ */
+class BplusTreeProbeBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    LoggerFactory::init_default("bplus_tree_probe_performance_test.log", LOG_LEVEL_WARN);
+    bpm_ = make_unique<BufferPoolManager>(BUFFER_POOL_MEMORY);
+    bpm_->init(make_unique<VacuousDoubleWriteBuffer>());
+
+    ::remove(filename_.c_str());
+    if (bpm_->create_file(filename_.c_str()) != RC::SUCCESS ||
+        bpm_->open_file(log_handler_, filename_.c_str(), buffer_pool_) != RC::SUCCESS ||
+        handler_.create(log_handler_, *buffer_pool_, AttrType::INTS, sizeof(int32_t)) != RC::SUCCESS) {
+      throw runtime_error("failed to create btree");
+    }
+
+    BplusTreeEntrySorter sorter(AttrType::INTS, sizeof(int32_t), filename_);
+    for (int32_t key = 0; key < KEY_NUM; key++) {
+      RID rid(key / 1024, key % 1024);
+      sorter.add(reinterpret_cast<const char *>(&key), rid);
+    }
+    BplusTreeBulkLoader loader(handler_);
+    if (sorter.sort() != RC::SUCCESS || loader.load(sorter) != RC::SUCCESS) {
+      throw runtime_error("failed to bulk load");
+    }
+
+    // 预先生成所有批次的查找键值，每一批内部排好序
+    const int batch_size = static_cast<int>(state.range(0));
+    const int spread     = static_cast<int>(state.range(1));
+    mt19937   random(batch_size);
+
+    keys_.resize(PROBE_NUM);
+    for (int batch = 0; batch < PROBE_NUM / batch_size; batch++) {
+      const int32_t base  = uniform_int_distribution<int32_t>(0, KEY_NUM - spread)(random);
+      auto          begin = keys_.begin() + batch * batch_size;
+      for (int i = 0; i < batch_size; i++) {
+        *(begin + i) = base + uniform_int_distribution<int32_t>(0, spread - 1)(random);
+      }
+      sort(begin, begin + batch_size);
+    }
+  }
+
+  void TearDown(const State &state) override
+  {
+    handler_.close();
+    bpm_.reset();
+    buffer_pool_ = nullptr;
+    ::remove(filename_.c_str());
+  }
+
+protected:
+  static constexpr int32_t KEY_NUM            = 1000000;
+  static constexpr int     PROBE_NUM          = 65536;
+  static constexpr int     BUFFER_POOL_MEMORY = 128 * 1024 * 1024;
+
+  string                        filename_ = "bplus_tree_probe_performance_test.btree";
+  unique_ptr<BufferPoolManager> bpm_;
+  VacuousLogHandler             log_handler_;
+  DiskBufferPool               *buffer_pool_ = nullptr;
+  BplusTreeHandler              handler_;
+  vector<int32_t>               keys_;
+};
+
+BENCHMARK_DEFINE_F(BplusTreeProbeBenchmark, GetEntry)(State &state)
+{
+  list<RID> rids;
+  for (auto _ : state) {
+    for (int32_t key : keys_) {
+      rids.clear();
+      if (handler_.get_entry(reinterpret_cast<const char *>(&key), sizeof(key), rids) != RC::SUCCESS ||
+          rids.size() != 1) {
+        throw runtime_error("failed to get entry");
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys_.size());
+}
+
+BENCHMARK_DEFINE_F(BplusTreeProbeBenchmark, GetEntries)(State &state)
+{
+  const int batch_size = static_cast<int>(state.range(0));
+
+  vector<const char *> key_ptrs(keys_.size());
+  for (size_t i = 0; i < keys_.size(); i++) {
+    key_ptrs[i] = reinterpret_cast<const char *>(&keys_[i]);
+  }
+
+  vector<pair<int, RID>> entries;
+  for (auto _ : state) {
+    for (size_t offset = 0; offset < key_ptrs.size(); offset += batch_size) {
+      entries.clear();
+      span<const char *const> batch(key_ptrs.data() + offset, batch_size);
+      if (handler_.get_entries(batch, entries) != RC::SUCCESS || static_cast<int>(entries.size()) != batch_size) {
+        throw runtime_error("failed to get entries");
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys_.size());
+}
+
+static void probe_arguments(internal::Benchmark *b)
+{
+  for (int batch_size : {1, 64, 1024}) {
+    for (int spread : {1000000, 65536}) {
+      b->Args({batch_size, spread});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(BplusTreeProbeBenchmark, GetEntry)->Apply(probe_arguments);
+BENCHMARK_REGISTER_F(BplusTreeProbeBenchmark, GetEntries)->Apply(probe_arguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,111 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/record/record_manager.h"
+
+using namespace std;
+
+/**
+ * @brief 测试打开数据文件的耗时
+ * @details 第一个参数是文件中数据页面的个数，第二个参数表示文件中是否已经有空闲空间映射。
+ * 没有映射时打开文件需要扫描所有页面，有映射时只需要读取映射页面。
+ * 每次迭代都从模板文件复制一份新的文件，复制的时间不计算在内
+ */
+class FreeSpaceMapBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int RECORD_SIZE = 100;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+
+    const int  page_num       = static_cast<int>(state.range(0));
+    const bool free_space_map = state.range(1) != 0;
+
+    BufferPoolManager bpm;
+    RC                rc = bpm.init(make_unique<VacuousDoubleWriteBuffer>());
+    ASSERT(OB_SUCC(rc), "failed to init buffer pool manager. rc=%s", strrc(rc));
+    rc = bpm.create_file(template_file_.c_str());
+    ASSERT(OB_SUCC(rc), "failed to create file. rc=%s", strrc(rc));
+    DiskBufferPool *buffer_pool = nullptr;
+    rc                          = bpm.open_file(log_handler_, template_file_.c_str(), buffer_pool);
+    ASSERT(OB_SUCC(rc), "failed to open file. rc=%s", strrc(rc));
+
+    // 直接初始化数据页面，这样生成的文件和以前的版本一样，没有空闲空间映射
+    for (int i = 0; i < page_num; i++) {
+      Frame *frame = nullptr;
+      rc           = buffer_pool->allocate_page(&frame);
+      ASSERT(OB_SUCC(rc), "failed to allocate page. rc=%s", strrc(rc));
+
+      RowRecordPageHandler page_handler;
+      rc = page_handler.init_empty_page(*buffer_pool, log_handler_, frame->page_num(), RECORD_SIZE, nullptr);
+      ASSERT(OB_SUCC(rc), "failed to init page. rc=%s", strrc(rc));
+      page_handler.cleanup();
+      frame->unpin();
+    }
+
+    if (free_space_map) {
+      RecordFileHandler record_file_handler(StorageFormat::ROW_FORMAT);
+      rc = record_file_handler.init(*buffer_pool, log_handler_, nullptr);
+      ASSERT(OB_SUCC(rc), "failed to init record file handler. rc=%s", strrc(rc));
+      record_file_handler.close();
+    }
+    bpm.close_file(template_file_.c_str());
+  }
+
+  void TearDown(const ::benchmark::State &state) override { filesystem::remove_all(test_directory_); }
+
+protected:
+  filesystem::path  test_directory_{"free_space_map_benchmark"};
+  filesystem::path  template_file_{test_directory_ / "template.bp"};
+  filesystem::path  data_file_{test_directory_ / "data.bp"};
+  VacuousLogHandler log_handler_;
+};
+
+BENCHMARK_DEFINE_F(FreeSpaceMapBenchmark, Open)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    state.PauseTiming();
+    filesystem::copy_file(template_file_, data_file_, filesystem::copy_options::overwrite_existing);
+    BufferPoolManager bpm;
+    bpm.init(make_unique<VacuousDoubleWriteBuffer>());
+    state.ResumeTiming();
+
+    DiskBufferPool *buffer_pool = nullptr;
+    RC              rc          = bpm.open_file(log_handler_, data_file_.c_str(), buffer_pool);
+    ASSERT(OB_SUCC(rc), "failed to open file. rc=%s", strrc(rc));
+
+    RecordFileHandler record_file_handler(StorageFormat::ROW_FORMAT);
+    rc = record_file_handler.init(*buffer_pool, log_handler_, nullptr);
+    ASSERT(OB_SUCC(rc), "failed to init record file handler. rc=%s", strrc(rc));
+
+    state.PauseTiming();
+    record_file_handler.close();
+    bpm.close_file(data_file_.c_str());
+    state.ResumeTiming();
+  }
+}
+
+BENCHMARK_REGISTER_F(FreeSpaceMapBenchmark, Open)
+    ->ArgNames({"pages", "fsm"})
+    ->ArgsProduct({{1024, 4096, 16384}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,149 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+
+#include "common/lang/algorithm.h"
+#include "common/lang/random.h"
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/index/bplus_tree.h"
+#include "storage/index/bplus_tree_bulk_loader.h"
+#include "storage/index/hash_index_handler.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 对比哈希索引与B+树索引的点查性能
+ * @details 参数是索引中键值的个数。两个索引包含相同的数据，B+树使用批量构建，哈希索引逐条插入。
+ * 构建一亿个键值的索引需要很长时间，同一个参数的多次运行共用一份数据。
+ */
+class IndexLookupBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    const int64_t key_num = state.range(0);
+    if (key_num == key_num_) {
+      return;
+    }
+
+    LoggerFactory::init_default("hash_index_performance_test.log", LOG_LEVEL_WARN);
+    cleanup();
+
+    // 一百万个键值时两个索引都可以放在内存中，只比较查找本身的开销。
+    // 一亿个键值时缓冲池放不下，B+树的内部节点访问频繁会留在内存中，哈希索引每次查找基本上只读一个页面
+    const int64_t memory_size = min(MAX_BUFFER_POOL_MEMORY, max(MIN_BUFFER_POOL_MEMORY, key_num * 48));
+    bpm_ = make_unique<BufferPoolManager>(static_cast<int>(memory_size));
+    bpm_->init(make_unique<VacuousDoubleWriteBuffer>());
+
+    if (bplus_tree_.create(log_handler_, *bpm_, bplus_tree_file_.c_str(), AttrType::INTS, sizeof(int32_t)) !=
+            RC::SUCCESS ||
+        hash_index_.create(log_handler_, *bpm_, hash_index_file_.c_str(), AttrType::INTS, sizeof(int32_t)) !=
+            RC::SUCCESS) {
+      throw runtime_error("failed to create index");
+    }
+
+    BplusTreeEntrySorter sorter(AttrType::INTS, sizeof(int32_t), bplus_tree_file_);
+    for (int32_t key = 0; key < key_num; key++) {
+      RID rid(key / 1024, key % 1024);
+      sorter.add(reinterpret_cast<const char *>(&key), rid);
+      if (hash_index_.insert_entry(reinterpret_cast<const char *>(&key), &rid) != RC::SUCCESS) {
+        throw runtime_error("failed to insert into hash index");
+      }
+    }
+    BplusTreeBulkLoader loader(bplus_tree_);
+    if (sorter.sort() != RC::SUCCESS || loader.load(sorter) != RC::SUCCESS) {
+      throw runtime_error("failed to bulk load");
+    }
+
+    mt19937 random(static_cast<uint32_t>(key_num));
+    keys_.resize(PROBE_NUM);
+    for (int32_t &key : keys_) {
+      key = uniform_int_distribution<int32_t>(0, static_cast<int32_t>(key_num - 1))(random);
+    }
+    key_num_ = key_num;
+  }
+
+  void TearDown(const State &state) override {}
+
+  static void cleanup()
+  {
+    bplus_tree_.close();
+    hash_index_.close();
+    bpm_.reset();
+    ::remove(bplus_tree_file_.c_str());
+    ::remove(hash_index_file_.c_str());
+    key_num_ = 0;
+  }
+
+protected:
+  static constexpr int     PROBE_NUM             = 65536;
+  static constexpr int64_t MIN_BUFFER_POOL_MEMORY = 128LL * 1024 * 1024;
+  static constexpr int64_t MAX_BUFFER_POOL_MEMORY = 1536LL * 1024 * 1024;
+
+  static inline string                        bplus_tree_file_ = "hash_index_performance_test.btree";
+  static inline string                        hash_index_file_ = "hash_index_performance_test.hash";
+  static inline unique_ptr<BufferPoolManager> bpm_;
+  static inline VacuousLogHandler             log_handler_;
+  static inline BplusTreeHandler              bplus_tree_;
+  static inline HashIndexHandler              hash_index_;
+  static inline vector<int32_t>               keys_;
+  static inline int64_t                       key_num_ = 0;
+};
+
+BENCHMARK_DEFINE_F(IndexLookupBenchmark, BplusTree)(State &state)
+{
+  list<RID> rids;
+  for (auto _ : state) {
+    for (int32_t key : keys_) {
+      rids.clear();
+      if (bplus_tree_.get_entry(reinterpret_cast<const char *>(&key), sizeof(key), rids) != RC::SUCCESS ||
+          rids.size() != 1) {
+        throw runtime_error("failed to get entry from b+ tree");
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys_.size());
+}
+
+BENCHMARK_DEFINE_F(IndexLookupBenchmark, Hash)(State &state)
+{
+  vector<RID> rids;
+  for (auto _ : state) {
+    for (int32_t key : keys_) {
+      rids.clear();
+      if (hash_index_.get_entry(reinterpret_cast<const char *>(&key), rids) != RC::SUCCESS || rids.size() != 1) {
+        throw runtime_error("failed to get entry from hash index");
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys_.size());
+}
+
+// 相同数据量的测试放在一起，避免重复构建索引
+BENCHMARK_REGISTER_F(IndexLookupBenchmark, BplusTree)->Arg(1000000);
+BENCHMARK_REGISTER_F(IndexLookupBenchmark, Hash)->Arg(1000000);
+BENCHMARK_REGISTER_F(IndexLookupBenchmark, BplusTree)->Arg(100000000);
+BENCHMARK_REGISTER_F(IndexLookupBenchmark, Hash)->Arg(100000000);
+
+int main(int argc, char **argv)
+{
+  Initialize(&argc, argv);
+  RunSpecifiedBenchmarks();
+  IndexLookupBenchmark::cleanup();
+  Shutdown();
+  return 0;
+}
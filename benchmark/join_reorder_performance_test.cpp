@@ -0,0 +1,232 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <random>
+
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/join_logical_operator.h"
+#include "sql/operator/predicate_logical_operator.h"
+#include "sql/operator/table_get_logical_operator.h"
+#include "sql/optimizer/join_reorder_rule.h"
+#include "sql/optimizer/physical_plan_generator.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+using namespace benchmark;
+
+/**
+ * @brief 类似 TPC-H 的五张表，每张表通过第二列关联到前一张表
+ * @details region 5行，nation 25行，customer 3000行，orders 30000行，lineitem 60000行
+ */
+struct TableDesc
+{
+  const char *name;
+  const char *key;
+  const char *ref;  ///< 关联前一张表的列
+  int         rows;
+};
+
+static const TableDesc TABLES[] = {
+    {"region", "r_id", "r_flag", 5},
+    {"nation", "n_id", "n_region", 25},
+    {"customer", "c_id", "c_nation", 3000},
+    {"orders", "o_id", "o_cust", 30000},
+    {"lineitem", "l_id", "l_order", 60000},
+};
+
+class JoinReorderBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    if (db_ != nullptr) {
+      return;
+    }
+
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    if (db_->init("bench_db", test_directory_.c_str(), "vacuous", "vacuous") != RC::SUCCESS) {
+      db_.reset();
+      return;
+    }
+
+    for (size_t i = 0; i < sizeof(TABLES) / sizeof(TABLES[0]); i++) {
+      const int ref_rows = (i == 0) ? 1 : TABLES[i - 1].rows;
+      if (create_table(TABLES[i], ref_rows) != RC::SUCCESS) {
+        db_.reset();
+        return;
+      }
+    }
+  }
+
+  void TearDown(const State &state) override {}
+
+  /**
+   * @brief 使用前 num 张表，按照 seed 随机打乱 from 中的顺序生成计划
+   * @details select * from ... where n_region = r_id and c_nation = n_id and ... and r_id < 2
+   */
+  unique_ptr<LogicalOperator> make_plan(int num, int seed)
+  {
+    vector<int> from(num);
+    for (int i = 0; i < num; i++) {
+      from[i] = i;
+    }
+    mt19937 random(seed);
+    shuffle(from.begin(), from.end(), random);
+
+    unique_ptr<LogicalOperator> plan;
+    for (int index : from) {
+      Table *table     = db_->find_table(TABLES[index].name);
+      auto   table_get = make_unique<TableGetLogicalOperator>(table, ReadWriteMode::READ_ONLY);
+      if (plan == nullptr) {
+        plan = std::move(table_get);
+      } else {
+        auto join = make_unique<JoinLogicalOperator>();
+        join->add_child(std::move(plan));
+        join->add_child(std::move(table_get));
+        plan = std::move(join);
+      }
+    }
+
+    vector<unique_ptr<Expression>> conditions;
+    for (int i = 1; i < num; i++) {
+      conditions.emplace_back(make_unique<ComparisonExpr>(
+          EQUAL_TO, field(TABLES[i].name, TABLES[i].ref), field(TABLES[i - 1].name, TABLES[i - 1].key)));
+    }
+    conditions.emplace_back(make_unique<ComparisonExpr>(
+        LESS_THAN, field(TABLES[0].name, TABLES[0].key), make_unique<ValueExpr>(Value(2))));
+
+    auto predicate = make_unique<PredicateLogicalOperator>(
+        make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, conditions));
+    predicate->add_child(std::move(plan));
+    return predicate;
+  }
+
+  /// 重新选择连接顺序，可选地执行生成的计划
+  void run(State &state, bool execute)
+  {
+    if (db_ == nullptr) {
+      state.SkipWithError("failed to prepare tables");
+      return;
+    }
+
+    const int num  = static_cast<int>(state.range(0));
+    const int seed = static_cast<int>(state.range(1));
+    int64_t   rows = 0;
+    for (auto _ : state) {
+      unique_ptr<LogicalOperator> plan        = make_plan(num, seed);
+      bool                        change_made = false;
+      if (rule_.rewrite(plan, change_made) != RC::SUCCESS) {
+        state.SkipWithError("failed to reorder joins");
+        return;
+      }
+
+      if (execute && execute_plan(*plan, rows) != RC::SUCCESS) {
+        state.SkipWithError("failed to execute plan");
+        return;
+      }
+      DoNotOptimize(plan);
+    }
+    if (execute) {
+      state.counters["rows"] = static_cast<double>(rows);
+    }
+  }
+
+private:
+  RC create_table(const TableDesc &desc, int ref_rows)
+  {
+    vector<AttrInfoSqlNode> attr_infos(2);
+    attr_infos[0].name = desc.key;
+    attr_infos[1].name = desc.ref;
+    for (AttrInfoSqlNode &attr_info : attr_infos) {
+      attr_info.type   = AttrType::INTS;
+      attr_info.length = sizeof(int);
+    }
+
+    RC rc = db_->create_table(desc.name, attr_infos);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    Table        *table = db_->find_table(desc.name);
+    vector<Value> values(2);
+    for (int i = 0; i < desc.rows && OB_SUCC(rc); i++) {
+      values[0] = Value(i);
+      values[1] = Value(i % ref_rows);
+      Record record;
+      if (OB_SUCC(rc = table->make_record(static_cast<int>(values.size()), values.data(), record))) {
+        rc = table->insert_record(record);
+      }
+    }
+    return OB_SUCC(rc) ? table->analyze(nullptr) : rc;
+  }
+
+  unique_ptr<Expression> field(const char *table_name, const char *field_name)
+  {
+    Table *table = db_->find_table(table_name);
+    return make_unique<FieldExpr>(table, table->table_meta().field(field_name));
+  }
+
+  RC execute_plan(LogicalOperator &logical_oper, int64_t &rows)
+  {
+    unique_ptr<PhysicalOperator> physical_oper;
+    RC                           rc = physical_plan_generator_.create(logical_oper, physical_oper);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    if (OB_SUCC(rc = physical_oper->open(trx))) {
+      rows = 0;
+      while (OB_SUCC(rc = physical_oper->next())) {
+        rows++;
+      }
+      rc       = (rc == RC::RECORD_EOF) ? RC::SUCCESS : rc;
+      RC close = physical_oper->close();
+      rc       = OB_SUCC(rc) ? close : rc;
+    }
+    db_->trx_kit().destroy_trx(trx);
+    return rc;
+  }
+
+protected:
+  // 所有的测试共用一份数据，只在第一次 SetUp 时创建
+  static inline unique_ptr<Db> db_;
+  filesystem::path             test_directory_{"join_reorder_benchmark"};
+  JoinReorderRule              rule_;
+  PhysicalPlanGenerator        physical_plan_generator_;
+};
+
+/// 只选择连接顺序，不执行
+BENCHMARK_DEFINE_F(JoinReorderBenchmark, Plan)(State &state) { run(state, false); }
+
+/// 选择连接顺序并执行，from 中的顺序不同时执行的时间应该接近
+BENCHMARK_DEFINE_F(JoinReorderBenchmark, Execute)(State &state) { run(state, true); }
+
+BENCHMARK_REGISTER_F(JoinReorderBenchmark, Plan)
+    ->ArgsProduct({{3, 4, 5}, {1, 2, 3}})
+    ->ArgNames({"tables", "seed"})
+    ->Unit(kMicrosecond);
+BENCHMARK_REGISTER_F(JoinReorderBenchmark, Execute)
+    ->ArgsProduct({{3, 4, 5}, {1, 2, 3}})
+    ->ArgNames({"tables", "seed"})
+    ->Unit(kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,112 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+
+#include "common/log/log.h"
+#include "sql/executor/data_loader.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 测试 LOAD DATA 的吞吐量
+ * @details 第一个参数是线程数，第二个参数表示是否记录数据页面的日志。
+ * 每次迭代都导入到一张新表中，表上没有索引
+ */
+class LoadDataBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int ROW_NUM = 200000;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    RC rc = db_->init("bench_db", test_directory_.c_str(), "vacuous", "disk");
+    ASSERT(OB_SUCC(rc), "failed to init db. rc=%s", strrc(rc));
+
+    data_file_ = (test_directory_ / "data.txt").string();
+    ofstream ofs(data_file_, ios::binary | ios::trunc);
+    for (int i = 0; i < ROW_NUM; i++) {
+      ofs << i << "|" << i % 1000 << "|" << i * 0.5f << "|benchmark_name_" << i << "\n";
+    }
+    ofs.close();
+    table_num_ = 0;
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+  Table *create_table()
+  {
+    AttrInfoSqlNode attr_infos[4];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "g";
+    attr_infos[1].type   = AttrType::INTS;
+    attr_infos[1].length = sizeof(int);
+    attr_infos[2].name   = "f";
+    attr_infos[2].type   = AttrType::FLOATS;
+    attr_infos[2].length = sizeof(float);
+    attr_infos[3].name   = "name";
+    attr_infos[3].type   = AttrType::CHARS;
+    attr_infos[3].length = 32;
+
+    string table_name = "t" + to_string(table_num_++);
+    RC     rc         = db_->create_table(table_name.c_str(), span<const AttrInfoSqlNode>(attr_infos, 4));
+    ASSERT(OB_SUCC(rc), "failed to create table. rc=%s", strrc(rc));
+    return db_->find_table(table_name.c_str());
+  }
+
+protected:
+  filesystem::path test_directory_{"load_data_benchmark"};
+  unique_ptr<Db>   db_;
+  string           data_file_;
+  int              table_num_ = 0;
+};
+
+BENCHMARK_DEFINE_F(LoadDataBenchmark, Load)(benchmark::State &state)
+{
+  DataLoader::Options options;
+  options.threads = static_cast<int>(state.range(0));
+  options.logging = state.range(1) != 0;
+
+  int64_t bytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    Table *table = create_table();
+    state.ResumeTiming();
+
+    DataLoader loader(table, options);
+    RC         rc = loader.load(data_file_.c_str());
+    ASSERT(OB_SUCC(rc), "failed to load data. rc=%s", strrc(rc));
+    bytes += loader.byte_count();
+  }
+  state.SetBytesProcessed(bytes);
+  state.SetItemsProcessed(state.iterations() * ROW_NUM);
+}
+
+BENCHMARK_REGISTER_F(LoadDataBenchmark, Load)
+    ->ArgNames({"threads", "logging"})
+    ->ArgsProduct({{1, 2, 4}, {1, 0}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+
+#include "common/lang/algorithm.h"
+#include "common/lang/atomic.h"
+#include "common/lang/vector.h"
+#include "storage/trx/lock_manager.h"
+
+using namespace std;
+
+/**
+ * @brief 按照 Zipf 分布生成 [0, n) 之间的整数，越小的数出现的越多
+ */
+class ZipfGenerator
+{
+public:
+  ZipfGenerator(int n, double theta) : cdf_(n)
+  {
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += 1.0 / pow(i + 1, theta);
+      cdf_[i] = sum;
+    }
+    for (double &value : cdf_) {
+      value /= sum;
+    }
+  }
+
+  int next(mt19937 &random)
+  {
+    double value = uniform_real_distribution<double>(0, 1)(random);
+    return static_cast<int>(lower_bound(cdf_.begin(), cdf_.end(), value) - cdf_.begin());
+  }
+
+private:
+  vector<double> cdf_;
+};
+
+static constexpr int ROW_NUM       = 10000;
+static constexpr int ROWS_PER_TRX  = 2;
+static constexpr int WORK_PER_ROW  = 2000;
+
+static atomic<int32_t> trx_id_generator{0};
+
+/**
+ * @brief 模拟热点行上的更新事务
+ * @details 每个事务按照 Zipf 分布选择两行，依次加锁，每拿到一个锁做一些计算，最后提交释放锁。
+ * 参数为 0 时不等待，遇到冲突立即回滚重试，和以前遇到冲突直接失败的方式一样；为 1 时在锁上排队等待。
+ * 死锁或者冲突导致的回滚都会重试，一直到提交成功
+ */
+static void UpdateHotRows(benchmark::State &state)
+{
+  static LockManager wait_lock_manager;
+  static LockManager no_wait_lock_manager;
+  static once_flag   init_flag;
+  call_once(init_flag, []() { no_wait_lock_manager.set_wait_timeout(chrono::milliseconds(0)); });
+
+  LockManager  &lock_manager = state.range(0) != 0 ? wait_lock_manager : no_wait_lock_manager;
+  ZipfGenerator zipf(ROW_NUM, 0.99);
+  mt19937       random(state.thread_index());
+
+  int64_t commit_count = 0;
+  int64_t abort_count  = 0;
+  int64_t work         = 0;
+  for (auto _ : state) {
+    RowLockKey keys[ROWS_PER_TRX];
+    for (RowLockKey &key : keys) {
+      key.table_id = 0;
+      key.rid      = RID(zipf.next(random) / 100 + 1, zipf.next(random) % 100);
+    }
+
+    while (true) {
+      int32_t    trx_id = ++trx_id_generator;
+      RowLockSet locked;
+      RC         rc = RC::SUCCESS;
+      for (const RowLockKey &key : keys) {
+        rc = lock_manager.lock_row(trx_id, key);
+        if (OB_FAIL(rc)) {
+          break;
+        }
+        locked.insert(key);
+        for (int i = 0; i < WORK_PER_ROW; i++) {
+          benchmark::DoNotOptimize(work += i);
+        }
+      }
+      lock_manager.unlock_rows(trx_id, locked);
+      if (OB_SUCC(rc)) {
+        commit_count++;
+        break;
+      }
+      abort_count++;
+    }
+  }
+
+  state.counters["commits"]    = benchmark::Counter(commit_count, benchmark::Counter::kIsRate);
+  state.counters["abort_rate"] = benchmark::Counter(
+      static_cast<double>(abort_count) / (commit_count + abort_count), benchmark::Counter::kAvgThreads);
+}
+
+BENCHMARK(UpdateHotRows)->ArgName("wait")->Arg(0)->Arg(1)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
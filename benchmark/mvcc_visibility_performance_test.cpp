@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/log/log.h"
+#include "storage/db/db.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 对比 MVCC 下按行扫描与按批扫描的速度
+ * @details 表中的数据都已经提交，另有一个没有提交的事务删除了一部分数据。
+ * 按行扫描时每个页面批量判断可见性，按批扫描时不可见的记录不会拷贝到 Chunk 中
+ */
+class MvccScanBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int ROW_NUM = 100000;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    RC rc = db_->init("bench_db", test_directory_.c_str(), "mvcc", "vacuous");
+    ASSERT(OB_SUCC(rc), "failed to init db. rc=%s", strrc(rc));
+
+    AttrInfoSqlNode attr_infos[2];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "name";
+    attr_infos[1].type   = AttrType::CHARS;
+    attr_infos[1].length = 16;
+    rc = db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 2));
+    ASSERT(OB_SUCC(rc), "failed to create table. rc=%s", strrc(rc));
+    table_ = db_->find_table("t");
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    trx->start_if_need();
+    vector<Record> records(ROW_NUM);
+    for (int i = 0; i < ROW_NUM; i++) {
+      Value values[2] = {Value(i), Value("benchmark")};
+      table_->make_record(2, values, records[i]);
+    }
+    rc = trx->insert_records(table_, records);
+    ASSERT(OB_SUCC(rc), "failed to insert records. rc=%s", strrc(rc));
+    trx->commit();
+    db_->trx_kit().destroy_trx(trx);
+
+    // 每 10 条删除一条，不提交
+    deleter_ = db_->trx_kit().create_trx(db_->log_handler());
+    deleter_->start_if_need();
+    for (int i = 0; i < ROW_NUM; i += 10) {
+      deleter_->delete_record(table_, records[i]);
+    }
+
+    reader_ = db_->trx_kit().create_trx(db_->log_handler());
+    reader_->start_if_need();
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    deleter_->rollback();
+    db_->trx_kit().destroy_trx(deleter_);
+    db_->trx_kit().destroy_trx(reader_);
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  filesystem::path test_directory_{"mvcc_scan_benchmark"};
+  unique_ptr<Db>   db_;
+  Table           *table_   = nullptr;
+  Trx             *deleter_ = nullptr;
+  Trx             *reader_  = nullptr;
+};
+
+BENCHMARK_DEFINE_F(MvccScanBenchmark, RecordScan)(benchmark::State &state)
+{
+  int64_t rows = 0;
+  for (auto _ : state) {
+    RecordFileScanner scanner;
+    table_->get_record_scanner(scanner, reader_, ReadWriteMode::READ_ONLY);
+    Record record;
+    while (OB_SUCC(scanner.next(record))) {
+      rows++;
+    }
+    scanner.close_scan();
+  }
+  state.SetItemsProcessed(rows);
+}
+
+BENCHMARK_DEFINE_F(MvccScanBenchmark, ChunkScan)(benchmark::State &state)
+{
+  const FieldMeta *field = table_->table_meta().field("id");
+  Chunk            chunk;
+  chunk.add_column(make_unique<Column>(*field), field->field_id());
+
+  int64_t rows = 0;
+  for (auto _ : state) {
+    ChunkFileScanner scanner;
+    table_->get_chunk_scanner(scanner, reader_, ReadWriteMode::READ_ONLY);
+    chunk.reset_data();
+    while (OB_SUCC(scanner.next_chunk(chunk))) {
+      rows += chunk.rows();
+      chunk.reset_data();
+    }
+    scanner.close_scan();
+  }
+  state.SetItemsProcessed(rows);
+}
+
+/// 只比较可见性判断本身：逐条调用 visit_record 与一次判断一个页面
+BENCHMARK_DEFINE_F(MvccScanBenchmark, VisitRecord)(benchmark::State &state)
+{
+  const bool batch = state.range(0) != 0;
+
+  RecordFileScanner scanner;
+  table_->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY);
+  vector<Record> records;
+  records.reserve(ROW_NUM);
+  Record record;
+  while (OB_SUCC(scanner.next(record))) {
+    records.push_back(record);
+    records.back().copy_data(record.data(), record.len());
+  }
+  scanner.close_scan();
+
+  span<const FieldMeta> trx_fields = table_->table_meta().trx_fields();
+  vector<int32_t>       begin_xids(records.size());
+  vector<int32_t>       end_xids(records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    memcpy(&begin_xids[i], records[i].data() + trx_fields[0].offset(), sizeof(int32_t));
+    memcpy(&end_xids[i], records[i].data() + trx_fields[1].offset(), sizeof(int32_t));
+  }
+
+  vector<uint8_t> visible(records.size());
+  int64_t         visible_count = 0;
+  for (auto _ : state) {
+    if (batch) {
+      visible.assign(records.size(), 1);
+      reader_->filter_visible_records(
+          begin_xids.data(), end_xids.data(), static_cast<int>(records.size()), visible.data());
+      for (uint8_t v : visible) {
+        visible_count += v;
+      }
+    } else {
+      for (Record &r : records) {
+        visible_count += reader_->visit_record(table_, r, ReadWriteMode::READ_ONLY) == RC::SUCCESS;
+      }
+    }
+  }
+  benchmark::DoNotOptimize(visible_count);
+  state.SetItemsProcessed(state.iterations() * records.size());
+}
+
+BENCHMARK_REGISTER_F(MvccScanBenchmark, RecordScan)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(MvccScanBenchmark, ChunkScan)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(MvccScanBenchmark, VisitRecord)->ArgName("batch")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/group_by_vec_physical_operator.h"
+#include "sql/operator/parallel_group_by_vec_physical_operator.h"
+#include "sql/operator/table_scan_vec_physical_operator.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 对比串行与并行执行 select g, sum(id) from t group by g
+ * @details 参数是工作线程的个数，1 表示使用串行的 GroupByVecPhysicalOperator
+ */
+class ParallelGroupByBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int ROW_NUM   = 500000;
+  static constexpr int GROUP_NUM = 100;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    if (db_ != nullptr) {
+      return;
+    }
+
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    RC rc = db_->init("bench_db", test_directory_.c_str(), "vacuous", "vacuous");
+    ASSERT(OB_SUCC(rc), "failed to init db. rc=%s", strrc(rc));
+
+    AttrInfoSqlNode attr_infos[2];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "g";
+    attr_infos[1].type   = AttrType::INTS;
+    attr_infos[1].length = sizeof(int);
+    rc = db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 2));
+    ASSERT(OB_SUCC(rc), "failed to create table. rc=%s", strrc(rc));
+
+    table_ = db_->find_table("t");
+    for (int i = 0; i < ROW_NUM; i++) {
+      Value  values[2] = {Value(i), Value(i % GROUP_NUM)};
+      Record record;
+      table_->make_record(2, values, record);
+      table_->insert_record(record);
+    }
+  }
+
+  unique_ptr<PhysicalOperator> plan(int workers)
+  {
+    auto field = [this](const char *name) {
+      return make_unique<FieldExpr>(table_, table_->table_meta().field(name));
+    };
+    sum_expr_ = make_unique<AggregateExpr>(AggregateExpr::Type::SUM, field("id"));
+    vector<unique_ptr<Expression>> group_by_exprs;
+    group_by_exprs.push_back(field("g"));
+    vector<Expression *> aggregate_exprs{sum_expr_.get()};
+
+    if (workers <= 1) {
+      auto oper = make_unique<GroupByVecPhysicalOperator>(std::move(group_by_exprs), std::move(aggregate_exprs));
+      oper->add_child(make_unique<TableScanVecPhysicalOperator>(table_, ReadWriteMode::READ_ONLY));
+      return oper;
+    }
+
+    auto oper = make_unique<ParallelGroupByVecPhysicalOperator>(
+        table_, std::move(group_by_exprs), std::move(aggregate_exprs));
+    for (int i = 0; i < workers; i++) {
+      auto scan = make_unique<TableScanVecPhysicalOperator>(table_, ReadWriteMode::READ_ONLY);
+      scan->set_morsel_iterator(&oper->morsel_iterator());
+      oper->add_child(std::move(scan));
+    }
+    return oper;
+  }
+
+protected:
+  // 所有的测试共用一份数据，只在第一次 SetUp 时创建
+  static inline unique_ptr<Db> db_;
+  static inline Table         *table_ = nullptr;
+  filesystem::path             test_directory_{"parallel_group_by_benchmark"};
+  unique_ptr<AggregateExpr>    sum_expr_;
+};
+
+BENCHMARK_DEFINE_F(ParallelGroupByBenchmark, GroupBy)(benchmark::State &state)
+{
+  auto plan_oper = plan(static_cast<int>(state.range(0)));
+  Trx *trx       = db_->trx_kit().create_trx(db_->log_handler());
+  for (auto _ : state) {
+    plan_oper->open(trx);
+    Chunk chunk;
+    while (OB_SUCC(plan_oper->next(chunk))) {
+      benchmark::DoNotOptimize(chunk.rows());
+    }
+    plan_oper->close();
+  }
+  db_->trx_kit().destroy_trx(trx);
+  state.SetItemsProcessed(state.iterations() * ROW_NUM);
+}
+
+BENCHMARK_REGISTER_F(ParallelGroupByBenchmark, GroupBy)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
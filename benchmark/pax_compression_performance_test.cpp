@@ -0,0 +1,257 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <set>
+
+#include "common/lang/sstream.h"
+
+#define private public
+#define protected public
+#include "storage/table/table.h"
+#undef private
+#undef protected
+
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/common/chunk.h"
+#include "storage/record/record_manager.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 对比行存和压缩的 PAX 格式在分析型扫描上的空间、缓冲池命中率和扫描性能
+ * @details 表 t(id int, day int, region char(8), category int, amount float, status char(8))，
+ * day 有序，region、category 和 status 的基数很小，amount 随机。参数 0 表示 ROW_FORMAT，1 表示 PAX_FORMAT。
+ * 缓冲池只有 2MiB，行存的数据放不下，扫描时需要反复从磁盘读取页面。
+ * 过滤扫描的条件是 `region = 'west' and day >= ...`，PAX 格式把条件下推到页面上，行存在数据块上逐行判断。
+ */
+class PaxCompressionBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    const int format = static_cast<int>(state.range(0));
+    if (format == format_) {
+      return;
+    }
+
+    LoggerFactory::init_default("pax_compression_performance_test.log", LOG_LEVEL_WARN);
+    cleanup();
+
+    AttrInfoSqlNode attr_infos[6];
+    const pair<const char *, AttrType> columns[] = {{"id", AttrType::INTS},
+        {"day", AttrType::INTS},
+        {"region", AttrType::CHARS},
+        {"category", AttrType::INTS},
+        {"amount", AttrType::FLOATS},
+        {"status", AttrType::CHARS}};
+    for (int i = 0; i < 6; i++) {
+      attr_infos[i].name   = columns[i].first;
+      attr_infos[i].type   = columns[i].second;
+      attr_infos[i].length = columns[i].second == AttrType::CHARS ? 8 : 4;
+    }
+    const StorageFormat storage_format = format == 0 ? StorageFormat::ROW_FORMAT : StorageFormat::PAX_FORMAT;
+    if (table_.table_meta_.init(1, "t", nullptr, span<const AttrInfoSqlNode>(attr_infos, 6), storage_format) !=
+        RC::SUCCESS) {
+      throw runtime_error("failed to init table meta");
+    }
+
+    bpm_ = make_unique<BufferPoolManager>(BUFFER_POOL_MEMORY);
+    bpm_->init(make_unique<VacuousDoubleWriteBuffer>());
+    if (bpm_->create_file(file_name_) != RC::SUCCESS ||
+        bpm_->open_file(log_handler_, file_name_, buffer_pool_) != RC::SUCCESS) {
+      throw runtime_error("failed to create file");
+    }
+    file_handler_ = make_unique<RecordFileHandler>(storage_format);
+    if (file_handler_->init(*buffer_pool_, log_handler_, &table_.table_meta_) != RC::SUCCESS) {
+      throw runtime_error("failed to init record file handler");
+    }
+
+    const char *regions[]  = {"east", "west", "north", "south", "center"};
+    const char *statuses[] = {"paid", "shipped", "refunded"};
+    mt19937     random(ROW_NUM);
+    const int   record_size = table_.table_meta_.record_size();
+    vector<char> record(record_size);
+    set<PageNum> pages;
+    for (int i = 0; i < ROW_NUM; i++) {
+      memset(record.data(), 0, record_size);
+      const int   day      = 20240101 + i / 1000;
+      const int   category = static_cast<int>(random() % 16);
+      const float amount   = static_cast<float>(random() % 100000) / 100;
+      const char *region   = regions[random() % 5];
+      const char *status   = statuses[random() % 10 == 0 ? 2 : random() % 2];
+      memcpy(record.data() + field("id")->offset(), &i, sizeof(i));
+      memcpy(record.data() + field("day")->offset(), &day, sizeof(day));
+      memcpy(record.data() + field("region")->offset(), region, strlen(region));
+      memcpy(record.data() + field("category")->offset(), &category, sizeof(category));
+      memcpy(record.data() + field("amount")->offset(), &amount, sizeof(amount));
+      memcpy(record.data() + field("status")->offset(), status, strlen(status));
+
+      RID rid;
+      if (file_handler_->insert_record(record.data(), record_size, &rid) != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+      pages.insert(rid.page_num);
+    }
+    page_count_ = static_cast<int>(pages.size());
+    format_     = format;
+  }
+
+  void TearDown(const State &state) override {}
+
+  static void cleanup()
+  {
+    if (file_handler_ != nullptr) {
+      file_handler_->close();
+      file_handler_.reset();
+    }
+    if (bpm_ != nullptr) {
+      bpm_->close_file(file_name_);
+      bpm_.reset();
+    }
+    buffer_pool_ = nullptr;
+    ::remove(file_name_);
+    format_ = -1;
+  }
+
+protected:
+  static const FieldMeta *field(const char *name) { return table_.table_meta_.field(name); }
+
+  static int column_id(const char *name)
+  {
+    return table_.table_meta_.sys_field_num() + field(name)->field_id();
+  }
+
+  static void add_column(Chunk &chunk, const char *name)
+  {
+    chunk.add_column(make_unique<Column>(*field(name)), column_id(name));
+  }
+
+  /// 开始计数之前清空当前线程的缓冲池统计
+  static void reset_stat() { BufferPoolStat::thread_local_stat() = BufferPoolStat(); }
+
+  static void report(State &state)
+  {
+    const BufferPoolStat &stat = BufferPoolStat::thread_local_stat();
+    const double          accesses = static_cast<double>(stat.hit_count + stat.miss_count);
+    state.SetItemsProcessed(state.iterations() * ROW_NUM);
+    state.counters["pages"]          = page_count_;
+    state.counters["rows_per_page"]  = static_cast<double>(ROW_NUM) / page_count_;
+    state.counters["hit_rate"]       = accesses > 0 ? stat.hit_count / accesses : 0;
+    state.counters["reads_per_scan"] = static_cast<double>(stat.read_count) / state.iterations();
+  }
+
+protected:
+  static constexpr int ROW_NUM            = 200000;
+  static constexpr int BUFFER_POOL_MEMORY = 2 * 1024 * 1024;
+
+  static inline const char                   *file_name_ = "pax_compression_performance_test.data";
+  static inline Table                         table_;
+  static inline unique_ptr<BufferPoolManager> bpm_;
+  static inline VacuousLogHandler             log_handler_;
+  static inline DiskBufferPool               *buffer_pool_ = nullptr;
+  static inline unique_ptr<RecordFileHandler> file_handler_;
+  static inline int                           format_     = -1;
+  static inline int                           page_count_ = 0;
+};
+
+BENCHMARK_DEFINE_F(PaxCompressionBenchmark, Scan)(State &state)
+{
+  Chunk chunk;
+  add_column(chunk, "day");
+  add_column(chunk, "amount");
+
+  reset_stat();
+  for (auto _ : state) {
+    ChunkFileScanner scanner;
+    if (scanner.open_scan_chunk(&table_, *buffer_pool_, nullptr, log_handler_, ReadWriteMode::READ_ONLY) !=
+        RC::SUCCESS) {
+      throw runtime_error("failed to open scanner");
+    }
+    double total = 0;
+    int    rows  = 0;
+    while (OB_SUCC(scanner.next_chunk(chunk))) {
+      const float *amounts = reinterpret_cast<const float *>(chunk.column(1).data());
+      for (int i = 0; i < chunk.rows(); i++) {
+        total += amounts[i];
+      }
+      rows += chunk.rows();
+      chunk.reset_data();
+    }
+    scanner.close_scan();
+    if (rows != ROW_NUM) {
+      throw runtime_error("unexpected row count");
+    }
+    DoNotOptimize(total);
+  }
+  report(state);
+}
+
+BENCHMARK_DEFINE_F(PaxCompressionBenchmark, FilteredScan)(State &state)
+{
+  const int  min_day = 20240101 + ROW_NUM / 1000 / 2;
+  const bool pushdown = table_.table_meta_.storage_format() == StorageFormat::PAX_FORMAT;
+
+  Chunk chunk;
+  add_column(chunk, "day");
+  add_column(chunk, "region");
+  add_column(chunk, "amount");
+
+  reset_stat();
+  for (auto _ : state) {
+    ChunkFileScanner scanner;
+    if (scanner.open_scan_chunk(&table_, *buffer_pool_, nullptr, log_handler_, ReadWriteMode::READ_ONLY) !=
+        RC::SUCCESS) {
+      throw runtime_error("failed to open scanner");
+    }
+    if (pushdown) {
+      scanner.set_predicates({ColumnPredicate{column_id("region"), EQUAL_TO, Value("west")},
+          ColumnPredicate{column_id("day"), GREAT_EQUAL, Value(min_day)}});
+    }
+
+    double total = 0;
+    int    rows  = 0;
+    while (OB_SUCC(scanner.next_chunk(chunk))) {
+      const int   *days    = reinterpret_cast<const int *>(chunk.column(0).data());
+      const char  *regions = chunk.column(1).data();
+      const float *amounts = reinterpret_cast<const float *>(chunk.column(2).data());
+      for (int i = 0; i < chunk.rows(); i++) {
+        if (pushdown || (days[i] >= min_day && strncmp(regions + i * 8, "west", 8) == 0)) {
+          total += amounts[i];
+          rows++;
+        }
+      }
+      chunk.reset_data();
+    }
+    scanner.close_scan();
+    DoNotOptimize(total);
+    DoNotOptimize(rows);
+  }
+  report(state);
+}
+
+BENCHMARK_REGISTER_F(PaxCompressionBenchmark, Scan)->ArgName("pax")->Arg(0)->Arg(1)->Unit(kMillisecond);
+BENCHMARK_REGISTER_F(PaxCompressionBenchmark, FilteredScan)->ArgName("pax")->Arg(0)->Arg(1)->Unit(kMillisecond);
+
+int main(int argc, char **argv)
+{
+  Initialize(&argc, argv);
+  RunSpecifiedBenchmarks();
+  Shutdown();
+  PaxCompressionBenchmark::cleanup();
+  return 0;
+}
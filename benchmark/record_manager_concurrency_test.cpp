@@ -256,7 +256,8 @@ BENCHMARK_DEFINE_F(InsertionBenchmark, Insertion)(State &state)
   state.counters["other"]   = Counter(stat.insert_other_count, Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(10);
+// 每个线程插入到不同的页面上，吞吐量应该随线程数增加
+BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->ThreadRange(1, 32)->UseRealTime();
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,106 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "common/lang/memory.h"
+#include "common/lang/vector.h"
+#include "common/types.h"
+#include "sql/operator/sort_vec_physical_operator.h"
+
+using namespace std;
+using namespace benchmark;
+
+/**
+ * @brief 按批输出一列整数，模拟 select x from t 的表扫描
+ */
+class IntColumnPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit IntColumnPhysicalOperator(const vector<int> &values) : values_(values)
+  {
+    chunk_.add_column(make_unique<Column>(AttrType::INTS, sizeof(int)), 0);
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::TABLE_SCAN_VEC; }
+
+  RC open(Trx *) override
+  {
+    position_ = 0;
+    return RC::SUCCESS;
+  }
+  RC next(Chunk &chunk) override
+  {
+    if (position_ >= values_.size()) {
+      return RC::RECORD_EOF;
+    }
+    chunk_.reset_data();
+    const int num = static_cast<int>(std::min(values_.size() - position_, static_cast<size_t>(chunk_.capacity())));
+    chunk_.column(0).append(const_cast<char *>(reinterpret_cast<const char *>(&values_[position_])), num);
+    position_ += num;
+    return chunk.reference(chunk_);
+  }
+  RC close() override { return RC::SUCCESS; }
+
+private:
+  const vector<int> &values_;
+  size_t             position_ = 0;
+  Chunk              chunk_;
+};
+
+class SortBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    values_.resize(state.range(0));
+    mt19937 random(0);
+    for (int &value : values_) {
+      value = static_cast<int>(random());
+    }
+  }
+
+  void TearDown(const State &state) override { vector<int>().swap(values_); }
+
+  /// select x from t order by x [limit limit]
+  void sort(State &state, int64_t limit)
+  {
+    for (auto _ : state) {
+      SortVecPhysicalOperator sort({{0, true}}, 1, limit, DEFAULT_SORT_BUFFER_SIZE);
+      sort.add_child(make_unique<IntColumnPhysicalOperator>(values_));
+      if (sort.open(nullptr) != RC::SUCCESS) {
+        state.SkipWithError("failed to sort");
+        return;
+      }
+
+      Chunk   chunk;
+      int64_t rows = 0;
+      while (sort.next(chunk) == RC::SUCCESS) {
+        rows += chunk.rows();
+      }
+      sort.close();
+      DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+protected:
+  vector<int> values_;
+};
+
+BENCHMARK_DEFINE_F(SortBenchmark, FullSort)(State &state) { sort(state, -1); }
+
+BENCHMARK_DEFINE_F(SortBenchmark, TopN)(State &state) { sort(state, 10); }
+
+BENCHMARK_REGISTER_F(SortBenchmark, FullSort)->Arg(1000000)->Arg(10000000)->Unit(kMillisecond);
+BENCHMARK_REGISTER_F(SortBenchmark, TopN)->Arg(1000000)->Arg(10000000)->Unit(kMillisecond);
+
+BENCHMARK_MAIN();
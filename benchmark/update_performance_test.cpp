@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/log/log.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 对比 update_record 与先删除再插入的方式修改数据
+ * @details 表 t(id int, score int, name char(16))，score 上有索引。每次修改一条记录的 id 字段，
+ * 不涉及索引字段。参数 0 表示 vacuous 事务，1 表示 mvcc 事务
+ */
+class UpdateBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int ROW_NUM = 10000;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    RC rc = db_->init("bench_db", test_directory_.c_str(), state.range(0) == 0 ? "vacuous" : "mvcc", "vacuous");
+    ASSERT(OB_SUCC(rc), "failed to init db. rc=%s", strrc(rc));
+
+    AttrInfoSqlNode attr_infos[3];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "score";
+    attr_infos[1].type   = AttrType::INTS;
+    attr_infos[1].length = sizeof(int);
+    attr_infos[2].name   = "name";
+    attr_infos[2].type   = AttrType::CHARS;
+    attr_infos[2].length = 16;
+    rc = db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 3));
+    ASSERT(OB_SUCC(rc), "failed to create table. rc=%s", strrc(rc));
+    table_ = db_->find_table("t");
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    trx->start_if_need();
+    rc = table_->create_index(trx, table_->table_meta().field("score"), "i_score", IndexType::BPLUS_TREE, 1.0f);
+    ASSERT(OB_SUCC(rc), "failed to create index. rc=%s", strrc(rc));
+
+    records_.resize(ROW_NUM);
+    for (int i = 0; i < ROW_NUM; i++) {
+      Value values[3] = {Value(i), Value(i), Value("benchmark")};
+      table_->make_record(3, values, records_[i]);
+      rc = trx->insert_record(table_, records_[i]);
+      ASSERT(OB_SUCC(rc), "failed to insert record. rc=%s", strrc(rc));
+    }
+    trx->commit();
+    db_->trx_kit().destroy_trx(trx);
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    records_.clear();
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  /// 每个事务修改一条记录，修改后的记录替换 records_ 中原来的记录，下一轮在新版本上修改
+  template <typename Modifier>
+  void run(benchmark::State &state, Modifier modify)
+  {
+    const FieldMeta *field = table_->table_meta().field("id");
+    int              i     = 0;
+    for (auto _ : state) {
+      Record &old_record = records_[i % ROW_NUM];
+      Record  new_record;
+      new_record.copy_data(old_record.data(), old_record.len());
+      new_record.set_rid(old_record.rid());
+      table_->set_value_to_record(new_record.data(), Value(i), field);
+
+      Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+      trx->start_if_need();
+      RC rc = modify(trx, old_record, new_record);
+      ASSERT(OB_SUCC(rc), "failed to modify record. rc=%s", strrc(rc));
+      trx->commit();
+      db_->trx_kit().destroy_trx(trx);
+
+      old_record = std::move(new_record);
+      i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+protected:
+  filesystem::path test_directory_{"update_benchmark"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+  vector<Record>   records_;
+};
+
+BENCHMARK_DEFINE_F(UpdateBenchmark, Update)(benchmark::State &state)
+{
+  run(state, [this](Trx *trx, Record &old_record, Record &new_record) {
+    return trx->update_record(table_, old_record, new_record);
+  });
+}
+
+BENCHMARK_DEFINE_F(UpdateBenchmark, DeleteInsert)(benchmark::State &state)
+{
+  run(state, [this](Trx *trx, Record &old_record, Record &new_record) {
+    RC rc = trx->delete_record(table_, old_record);
+    if (OB_SUCC(rc)) {
+      rc = trx->insert_record(table_, new_record);
+    }
+    return rc;
+  });
+}
+
+BENCHMARK_REGISTER_F(UpdateBenchmark, Update)->ArgName("mvcc")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(UpdateBenchmark, DeleteInsert)->ArgName("mvcc")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
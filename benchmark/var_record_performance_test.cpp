@@ -0,0 +1,115 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/log/log.h"
+#include "common/math/integer_generator.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 对比定长行存和变长行存在字符串较多的表上的空间和扫描性能
+ * @details 表 t(id int, name char(64), comment char(256))，字符串的实际长度是声明长度的 10%~50%。
+ * 参数 0 表示 ROW_FORMAT，1 表示 VAR_ROW_FORMAT。计数器 rows_per_page 是平均每个数据页面存放的记录数
+ */
+class VarRecordBenchmark : public benchmark::Fixture
+{
+public:
+  static constexpr int ROW_NUM = 20000;
+
+  void SetUp(const ::benchmark::State &state) override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    RC rc = db_->init("bench_db", test_directory_.c_str(), "vacuous", "vacuous");
+    ASSERT(OB_SUCC(rc), "failed to init db. rc=%s", strrc(rc));
+
+    AttrInfoSqlNode attr_infos[3];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "name";
+    attr_infos[1].type   = AttrType::CHARS;
+    attr_infos[1].length = 64;
+    attr_infos[2].name   = "comment";
+    attr_infos[2].type   = AttrType::CHARS;
+    attr_infos[2].length = 256;
+    const StorageFormat format = state.range(0) == 0 ? StorageFormat::ROW_FORMAT : StorageFormat::VAR_ROW_FORMAT;
+    rc = db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 3), format);
+    ASSERT(OB_SUCC(rc), "failed to create table. rc=%s", strrc(rc));
+    table_ = db_->find_table("t");
+
+    IntegerGenerator name_len(6, 32);
+    IntegerGenerator comment_len(25, 128);
+    Trx             *trx = db_->trx_kit().create_trx(db_->log_handler());
+    trx->start_if_need();
+    for (int i = 0; i < ROW_NUM; i++) {
+      string name(name_len.next(), 'n');
+      string comment(comment_len.next(), 'c');
+      Value  values[3] = {Value(i), Value(name.c_str()), Value(comment.c_str())};
+      Record record;
+      table_->make_record(3, values, record);
+      rc = trx->insert_record(table_, record);
+      ASSERT(OB_SUCC(rc), "failed to insert record. rc=%s", strrc(rc));
+    }
+    trx->commit();
+    db_->trx_kit().destroy_trx(trx);
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  filesystem::path test_directory_{"var_record_benchmark"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+};
+
+BENCHMARK_DEFINE_F(VarRecordBenchmark, Scan)(benchmark::State &state)
+{
+  const FieldMeta *comment    = table_->table_meta().field("comment");
+  int              page_count = 0;  // 存放了记录的数据页面个数
+  for (auto _ : state) {
+    PageNum last_page = BP_INVALID_PAGE_NUM;
+    page_count        = 0;
+    RecordFileScanner scanner;
+    RC                rc = table_->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY);
+    ASSERT(OB_SUCC(rc), "failed to open scanner. rc=%s", strrc(rc));
+
+    int64_t total_len = 0;
+    Record  record;
+    while (OB_SUCC(scanner.next(record))) {
+      total_len += strnlen(record.data() + comment->offset(), comment->len());
+      if (record.rid().page_num != last_page) {
+        last_page = record.rid().page_num;
+        page_count++;
+      }
+    }
+    scanner.close_scan();
+    benchmark::DoNotOptimize(total_len);
+  }
+  state.SetItemsProcessed(state.iterations() * ROW_NUM);
+  state.counters["pages"]         = page_count;
+  state.counters["rows_per_page"] = static_cast<double>(ROW_NUM) / page_count;
+}
+
+BENCHMARK_REGISTER_F(VarRecordBenchmark, Scan)->ArgName("var_row")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
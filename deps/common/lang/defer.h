@@ -36,7 +36,10 @@ private:
 
 }  // namespace common
 
-#define _SCOPE_UNIQUE_NAME(B, C) B##C
+#define _SCOPE_UNIQUE_NAME_CONCAT(B, C) B##C
+
+// 多一层展开，让__LINE__先替换成行号
+#define _SCOPE_UNIQUE_NAME(B, C) _SCOPE_UNIQUE_NAME_CONCAT(B, C)
 
 #define SCOPE_UNIQUE_NAME(B) _SCOPE_UNIQUE_NAME(B, __LINE__)
 
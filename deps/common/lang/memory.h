@@ -12,5 +12,7 @@ See the Mulan PSL v2 for more details. */
 
 #include <memory>
 
+using std::make_shared;
 using std::make_unique;
+using std::shared_ptr;
 using std::unique_ptr;
\ No newline at end of file
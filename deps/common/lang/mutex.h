@@ -35,6 +35,7 @@ using std::lock_guard;
 using std::mutex;
 using std::once_flag;
 using std::scoped_lock;
+using std::shared_lock;
 using std::shared_mutex;
 using std::unique_lock;
 
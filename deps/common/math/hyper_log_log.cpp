@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <math.h>
+#include <string.h>
+
+#include "common/math/hyper_log_log.h"
+#include "common/lang/algorithm.h"
+
+namespace common {
+
+namespace {
+
+/// MurmurHash3 的 finalizer，让每一位输入都能影响所有的输出位
+uint64_t fmix64(uint64_t k)
+{
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+}  // namespace
+
+HyperLogLog::HyperLogLog(int precision)
+    : precision_(std::clamp(precision, MIN_PRECISION, MAX_PRECISION)), registers_(size_t(1) << precision_, 0)
+{}
+
+uint64_t HyperLogLog::hash(const void *data, size_t len)
+{
+  const uint8_t *bytes  = static_cast<const uint8_t *>(data);
+  uint64_t       result = 0x9e3779b97f4a7c15ULL ^ (len * 0xc6a4a7935bd1e995ULL);
+  size_t         i      = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(word));
+    result = fmix64(result ^ word) * 0x9e3779b97f4a7c15ULL;
+  }
+
+  uint64_t tail = 0;
+  for (size_t shift = 0; i < len; i++, shift += 8) {
+    tail |= static_cast<uint64_t>(bytes[i]) << shift;
+  }
+  return fmix64(result ^ tail);
+}
+
+void HyperLogLog::add_hash(uint64_t hash_value)
+{
+  const uint64_t index = hash_value & ((uint64_t(1) << precision_) - 1);
+  const uint64_t rest  = hash_value >> precision_;
+  // 剩余的位全是0时，第一个1的位置是 64 - precision + 1
+  const uint8_t rank = rest == 0 ? static_cast<uint8_t>(64 - precision_ + 1)
+                                 : static_cast<uint8_t>(__builtin_ctzll(rest) + 1);
+  if (registers_[index] < rank) {
+    registers_[index] = rank;
+  }
+}
+
+void HyperLogLog::merge(const HyperLogLog &other)
+{
+  if (other.precision_ != precision_) {
+    return;
+  }
+  for (size_t i = 0; i < registers_.size(); i++) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+double HyperLogLog::estimate() const
+{
+  const double m = static_cast<double>(registers_.size());
+
+  double sum        = 0;
+  int    zero_count = 0;
+  for (uint8_t reg : registers_) {
+    sum += ldexp(1.0, -static_cast<int>(reg));
+    if (reg == 0) {
+      zero_count++;
+    }
+  }
+
+  const double alpha    = 0.7213 / (1.0 + 1.079 / m);
+  const double estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zero_count > 0) {
+    // 基数较小时原始估算的偏差很大，使用线性计数
+    return m * log(m / zero_count);
+  }
+  return estimate;
+}
+
+void HyperLogLog::clear() { std::fill(registers_.begin(), registers_.end(), 0); }
+
+}  // namespace common
@@ -0,0 +1,59 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/lang/vector.h"
+
+namespace common {
+
+/**
+ * @brief 使用 HyperLogLog 估算不同值的个数(NDV)
+ * @details 每个值哈希成64位，低 precision 位选择一个寄存器，寄存器中记录剩余位中第一个1出现的位置的最大值。
+ * 使用 2^precision 个字节的内存，标准误差大约是 1.04/sqrt(2^precision)，precision=12 时大约是1.6%。
+ * 基数较小时使用线性计数(linear counting)修正。
+ */
+class HyperLogLog
+{
+public:
+  static constexpr int DEFAULT_PRECISION = 12;
+  static constexpr int MIN_PRECISION     = 4;
+  static constexpr int MAX_PRECISION     = 16;
+
+  explicit HyperLogLog(int precision = DEFAULT_PRECISION);
+
+  /// 加入一个值，值按照字节内容计算哈希
+  void add(const void *data, size_t len) { add_hash(hash(data, len)); }
+
+  /// 加入一个已经计算好的64位哈希值
+  void add_hash(uint64_t hash_value);
+
+  /// 合并另一个精度相同的估算器，相当于两个集合的并集
+  void merge(const HyperLogLog &other);
+
+  /// 估算加入过的不同值的个数
+  double estimate() const;
+
+  void clear();
+
+  int precision() const { return precision_; }
+
+  /// 对任意字节计算64位哈希，结果在不同平台和不同进程间保持一致
+  static uint64_t hash(const void *data, size_t len);
+
+private:
+  int             precision_;
+  vector<uint8_t> registers_;
+};
+
+}  // namespace common
@@ -30,6 +30,13 @@ int mm256_sum_epi32(const int *values, int size)
   return sum;
 }
 
+uint32_t mm256_cmpeq_epi8_mask(const char *data, char c)
+{
+  __m256i chars  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  __m256i target = _mm256_set1_epi8(c);
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, target)));
+}
+
 float mm256_sum_ps(const float *values, int size)
 {
   // your code here
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 
 #if defined(USE_SIMD)
 #include <immintrin.h>
+#include <stdint.h>
 
 static constexpr int SIMD_WIDTH = 8;  // AVX2 (256bit)
 
@@ -22,6 +23,9 @@ int mm256_extract_epi32_var_indx(const __m256i vec, const unsigned int i);
 int   mm256_sum_epi32(const int *values, int size);
 float mm256_sum_ps(const float *values, int size);
 
+/// @brief 比较 data 开始的 32 个字节是否等于 c，返回的第 i 位表示第 i 个字节是否相等
+uint32_t mm256_cmpeq_epi8_mask(const char *data, char c);
+
 /// @brief selective load 的标量实现
 template <typename V>
 void selective_load(V *memory, int offset, V *vec, __m256i &inv);
@@ -107,8 +107,16 @@ int ThreadPoolExecutor::await_termination()
     return -1;
   }
 
-  while (threads_.size() > 0) {
-    this_thread::sleep_for(200ms);
+  // 查询内并行执行时每次查询都会等待线程池退出，等待的间隔不能太长。
+  // 在锁内检查，保证退出的线程已经不再访问线程池
+  while (true) {
+    {
+      lock_guard guard(lock_);
+      if (threads_.empty()) {
+        break;
+      }
+    }
+    this_thread::sleep_for(1ms);
   }
   return 0;
 }
@@ -167,11 +175,12 @@ void ThreadPoolExecutor::thread_func()
   delete thread_data.thread_ptr;
   thread_data.thread_ptr = nullptr;
 
+  // 从 threads_ 中删除后 await_termination 就可能返回，线程池对象随时会被销毁，之后不能再访问成员变量
+  LOG_INFO("[%s] thread exit", pool_name_.c_str());
+
   lock_.lock();
   threads_.erase(this_thread::get_id());
   lock_.unlock();
-
-  LOG_INFO("[%s] thread exit", pool_name_.c_str());
 }
 
 int ThreadPoolExecutor::create_thread(bool core_thread)
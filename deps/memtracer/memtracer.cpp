@@ -157,4 +157,6 @@ void MemTracer::stat()
     std::this_thread::sleep_for(std::chrono::milliseconds(sleep_interval));
   }
 }
-}  // namespace memtracer
\ No newline at end of file
+}  // namespace memtracer
+
+extern "C" size_t mt_allocated_memory() { return memtracer::MT.allocated_memory(); }
\ No newline at end of file
@@ -82,4 +82,9 @@ private:
   size_t         print_interval_ms_ = 0;
   thread         t_;
 };
-}  // namespace memtracer
\ No newline at end of file
+}  // namespace memtracer
+
+// Returns the memory currently allocated by the process.
+// Other modules do not link memtracer; they look this symbol up with dlsym,
+// which fails when memtracer is not preloaded.
+extern "C" mt_visible size_t mt_allocated_memory();
\ No newline at end of file
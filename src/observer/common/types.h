@@ -42,13 +42,26 @@ enum class ReadWriteMode
 
 /**
  * @brief 存储格式
- * @details 当前仅支持行存格式（ROW_FORMAT）以及 PAX 存储格式（PAX_FORMAT）。
+ * @details 支持定长的行存格式（ROW_FORMAT）、变长的行存格式（VAR_ROW_FORMAT）以及 PAX 存储格式（PAX_FORMAT）。
  */
 enum class StorageFormat
 {
   UNKNOWN_FORMAT = 0,  // 未知格式
   ROW_FORMAT,          // 行存格式
-  PAX_FORMAT           // PAX 存储格式
+  PAX_FORMAT,          // PAX 存储格式
+  VAR_ROW_FORMAT       // 变长行存格式，字符串只保存实际的长度，超长的数据放在溢出页面中
+};
+
+/**
+ * @brief 索引类型
+ * @details 默认使用B+树索引，可以通过 CREATE INDEX ... USING HASH 创建哈希索引。
+ * 哈希索引只支持等值查询，但是点查只需要访问一个桶。
+ */
+enum class IndexType
+{
+  UNKNOWN_TYPE = 0,  // 未知类型
+  BPLUS_TREE,        // B+树索引
+  HASH               // 哈希索引
 };
 
 /**
@@ -62,5 +75,16 @@ enum class ExecutionMode
   CHUNK_ITERATOR     // 按批处理模式
 };
 
+/// 批量构建索引时默认的页面填充因子。留出一些空间，避免构建完成后的插入立即引起页面分裂
+static constexpr float DEFAULT_INDEX_FILL_FACTOR = 0.9f;
+
+/// 排序算子默认可以使用的内存大小，超过后会把有序的数据段写到临时文件中，最后再做多路归并
+static constexpr int64_t DEFAULT_SORT_BUFFER_SIZE = 64LL * 1024 * 1024;
+
+/// 查询内并行执行默认使用的线程数，1 表示不并行
+static constexpr int DEFAULT_PARALLEL_DEGREE = 1;
+/// 查询内并行执行最多使用的线程数
+static constexpr int MAX_PARALLEL_DEGREE = 64;
+
 /// page 的 CRC 校验和
 using CheckSum = unsigned int;  // CRC 校验和，使用无符号整数表示
@@ -14,6 +14,8 @@ miniob is licensed under Mulan PSL v2.
 #pragma once  // 防止头文件被多次包含
 
 #include "common/lang/string.h"       // 引入字符串处理相关的头文件
+#include "common/lang/vector.h"       // 引入 vector 相关的头文件
+#include "common/value.h"             // 引入参数值相关的头文件
 #include "event/sql_debug.h"          // 引入 SQL 调试相关的头文件
 #include "sql/executor/sql_result.h"  // 引入 SQL 执行结果相关的头文件
 
@@ -71,6 +73,32 @@ public:
    */
   const string &query() const { return query_; }
 
+  /**
+   * @brief 设置要执行的预编译语句
+   *
+   * @param statement_id 预编译语句的编号，此时 query 是预编译语句的文本。
+   * @param params 本次执行绑定的参数。
+   */
+  void set_statement(uint32_t statement_id, vector<Value> &&params)
+  {
+    statement_id_ = statement_id;
+    params_       = std::move(params);
+  }
+
+  /**
+   * @brief 获取要执行的预编译语句的编号
+   *
+   * @return 返回预编译语句的编号，0 表示这是一个普通的文本请求。
+   */
+  uint32_t statement_id() const { return statement_id_; }
+
+  /**
+   * @brief 获取执行预编译语句时绑定的参数
+   *
+   * @return 返回参数列表的引用。
+   */
+  vector<Value> &params() { return params_; }
+
   /**
    * @brief 获取 SQL 执行结果
    *
@@ -90,4 +118,6 @@ private:
   SqlResult     sql_result_;              ///< SQL 执行结果
   SqlDebug      sql_debug_;               ///< SQL 调试信息
   string        query_;                   ///< SQL 查询字符串
+  uint32_t      statement_id_ = 0;        ///< 预编译语句的编号
+  vector<Value> params_;                  ///< 预编译语句的参数
 };
@@ -16,6 +16,7 @@ miniob is licensed under Mulan PSL v2.
 #include "common/lang/string.h"              // 引入字符串处理相关的头文件
 #include "common/lang/memory.h"              // 引入内存管理相关的头文件
 #include "sql/operator/physical_operator.h"  // 引入物理操作符相关的头文件
+#include "sql/plan_cache/plan_cache.h"       // 引入计划缓存相关的头文件
 
 class SessionEvent;   // 前向声明 SessionEvent 类
 class Stmt;           // 前向声明 Stmt 类
@@ -116,10 +117,33 @@ public:
    */
   void set_operator(unique_ptr<PhysicalOperator> oper) { operator_ = std::move(oper); }
 
+  /**
+   * @brief 获取计划缓存中的计划
+   *
+   * @details 命中缓存时物理操作符就是缓存的计划。没有命中时这里只有参数，生成的计划执行完成后放入缓存。
+   * @return 返回缓存计划的智能指针的引用，语句不能缓存时为空
+   */
+  unique_ptr<CachedPlan> &cached_plan() { return cached_plan_; }
+
+  /**
+   * @brief 设置计划缓存中的计划
+   *
+   * @param cached_plan 缓存计划的智能指针
+   */
+  void set_cached_plan(unique_ptr<CachedPlan> cached_plan) { cached_plan_ = std::move(cached_plan); }
+
+  /**
+   * @brief 获取语句中参数(?)的值
+   *
+   * @return 返回参数值的指针，没有参数时为空
+   */
+  const vector<Value> *params() const { return cached_plan_ ? &cached_plan_->params : nullptr; }
+
 private:
   SessionEvent                *session_event_ = nullptr;  ///< 关联的会话事件指针
   string                       sql_;                      ///< 处理的 SQL 语句
   unique_ptr<ParsedSqlNode>    sql_node_;                 ///< 解析后的 SQL 命令
   Stmt                        *stmt_ = nullptr;           ///< 解析后生成的 SQL 语句数据结构
   unique_ptr<PhysicalOperator> operator_;                 ///< 生成的物理执行计划
+  unique_ptr<CachedPlan>       cached_plan_;              ///< 计划缓存中的计划
 };
@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2022/11/22.
 //
 
+#include <limits.h>
 #include <string.h>
 #include <vector>
 
@@ -22,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 #include "net/buffered_writer.h"
 #include "net/mysql_communicator.h"
 #include "sql/operator/string_list_physical_operator.h"
+#include "sql/plan_cache/prepared_statement.h"
 
 /**
  * @brief MySQL协议相关实现
@@ -60,6 +62,21 @@ enum ResultSetMetaData
   RESULTSET_METADATA_FULL = 1,
 };
 
+/**
+ * @brief 客户端发过来的命令
+ * @details [Command Phase](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_command_phase.html)
+ * @ingroup MySQLProtocol
+ */
+enum CommandType
+{
+  COM_QUERY               = 0x03,
+  COM_STMT_PREPARE        = 0x16,
+  COM_STMT_EXECUTE        = 0x17,
+  COM_STMT_SEND_LONG_DATA = 0x18,
+  COM_STMT_CLOSE          = 0x19,
+  COM_STMT_RESET          = 0x1a,
+};
+
 /**
  * @brief Column types for MySQL
  * @details 枚举值类型是从MySQL的协议中抄过来的
@@ -279,6 +296,148 @@ int store_lenenc_string(char *buf, const char *s)
   return pos + len;
 }
 
+/**
+ * @brief 写入一行数据开头的部分，不包含包头
+ * @details 文本协议中一行就是每列值的字符串，没有额外的内容。
+ * 二进制协议(执行预编译语句的结果)中一行以 0x00 开头，后面跟着 NULL 标识的位图，位图从第2个bit开始使用。
+ * 因为列描述信息中所有的列都是字符串类型，二进制协议中每列的值与文本协议的编码方式相同。
+ * [Binary Protocol Resultset Row](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_binary_resultset.html)
+ *
+ * @param buf 数据缓存
+ * @param column_num 列数
+ * @param binary 是否使用二进制协议
+ * @return int 写入的字节数
+ * @ingroup MySQLProtocolStore
+ */
+int store_row_header(char *buf, int column_num, bool binary)
+{
+  if (!binary) {
+    return 0;
+  }
+
+  const int null_bitmap_len = (column_num + 7 + 2) / 8;
+  buf[0]                    = 0x00;
+  memset(buf + 1, 0, null_bitmap_len);  // miniob 中没有 NULL
+  return 1 + null_bitmap_len;
+}
+
+/**
+ * @brief 根据MySQL协议的描述实现的数据读取函数
+ * @defgroup MySQLProtocolFetch
+ * @details 与 @ref MySQLProtocolStore 对应，同样仅考虑小端模式。
+ * 客户端发过来的数据不一定可靠，所以每次读取前都会检查长度。
+ */
+
+/**
+ * @brief 从数据包中读取固定长度的数据
+ *
+ * @param packet 数据包，不包含包头
+ * @param[in,out] pos 读取的位置，读取成功后向后移动
+ * @param[out] value 读取出来的数据
+ * @param len 要读取的字节数
+ * @return bool 数据包的长度不够时返回false
+ * @ingroup MySQLProtocolFetch
+ */
+bool fetch_fix_length(const vector<char> &packet, size_t &pos, void *value, size_t len)
+{
+  if (pos + len > packet.size()) {
+    return false;
+  }
+
+  memcpy(value, packet.data() + pos, len);
+  pos += len;
+  return true;
+}
+
+/**
+ * @brief 读取一个变长编码的整数
+ * @details [Length-Encoded Integer](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_basic_dt_integers.html)
+ * @ingroup MySQLProtocolFetch
+ */
+bool fetch_lenenc_int(const vector<char> &packet, size_t &pos, uint64_t &value)
+{
+  uint8_t first = 0;
+  if (!fetch_fix_length(packet, pos, &first, 1)) {
+    return false;
+  }
+
+  value = 0;
+  if (first < 0xfb) {
+    value = first;
+    return true;
+  } else if (first == 0xfc) {
+    return fetch_fix_length(packet, pos, &value, 2);
+  } else if (first == 0xfd) {
+    return fetch_fix_length(packet, pos, &value, 3);
+  } else if (first == 0xfe) {
+    return fetch_fix_length(packet, pos, &value, 8);
+  }
+  return false;  // 0xfb 表示 NULL，0xff 是错误包的标识
+}
+
+/**
+ * @brief 读取一个带有长度标识的字符串
+ * @ingroup MySQLProtocolFetch
+ */
+bool fetch_lenenc_string(const vector<char> &packet, size_t &pos, string &value)
+{
+  uint64_t len = 0;
+  if (!fetch_lenenc_int(packet, pos, len) || len > packet.size() - pos) {
+    return false;
+  }
+
+  value.assign(packet.data() + pos, len);
+  pos += len;
+  return true;
+}
+
+/**
+ * @brief 写入一个列描述信息，不包含包头
+ * @details 当前所有的列都按照字符串类型返回。预编译语句的参数描述也使用相同的格式。
+ * [Column Definition](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_query_response_text_resultset_column_definition.html)
+ *
+ * @param buf 数据缓存
+ * @param table 表名
+ * @param name 列名
+ * @return int 写入的字节数
+ * @ingroup MySQLProtocolStore
+ */
+int store_column_definition(char *buf, const char *table, const char *name)
+{
+  const char *catalog          = "def";  // The catalog used. Currently always "def"
+  const char *schema           = "sys";  // schema name
+  const char *org_table        = table;
+  const char *org_name         = name;
+  int         fixed_len_fields = 0x0c;
+  int         character_set    = 33;
+  int         column_length    = 16384;
+  int         type             = MYSQL_TYPE_VAR_STRING;
+  int16_t     flags            = 0;
+  int8_t      decimals         = 0x1f;
+
+  int pos = 0;
+  pos += store_lenenc_string(buf + pos, catalog);
+  pos += store_lenenc_string(buf + pos, schema);
+  pos += store_lenenc_string(buf + pos, table);
+  pos += store_lenenc_string(buf + pos, org_table);
+  pos += store_lenenc_string(buf + pos, name);
+  pos += store_lenenc_string(buf + pos, org_name);
+  pos += store_lenenc_int(buf + pos, fixed_len_fields);
+  store_int2(buf + pos, character_set);
+  pos += 2;
+  store_int4(buf + pos, column_length);
+  pos += 4;
+  store_int1(buf + pos, type);
+  pos += 1;
+  store_int2(buf + pos, flags);
+  pos += 2;
+  store_int1(buf + pos, decimals);
+  pos += 1;
+  store_int2(buf + pos, 0);  // 按照mariadb的文档描述，最后还有一个unused字段int<2>，不过mysql的文档没有给出这样的描述
+  pos += 2;
+  return pos;
+}
+
 /**
  * @brief 每个包都有一个包头
  * @details [MySQL Basic Packet](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_basic_packets.html)
@@ -509,6 +668,48 @@ struct ErrPacket : public BasePacket
   }
 };
 
+/**
+ * @brief 预编译成功的响应包
+ * @ingroup MySQLProtocol
+ * @details 后面还会跟着参数和列的描述信息。
+ * [COM_STMT_PREPARE Response](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_stmt_prepare.html)
+ */
+struct PrepareOkPacket : public BasePacket
+{
+  int8_t   status        = 0x00;
+  uint32_t statement_id  = 0;
+  int16_t  num_columns   = 0;
+  int16_t  num_params    = 0;
+  int16_t  warning_count = 0;
+
+  PrepareOkPacket(int8_t sequence = 0) : BasePacket(sequence) {}
+  virtual ~PrepareOkPacket() = default;
+
+  RC encode(uint32_t capabilities, vector<char> &net_packet) const override
+  {
+    net_packet.resize(20);
+    char *buf = net_packet.data();
+    int   pos = 0;
+
+    pos += 3;
+    pos += store_int1(buf + pos, packet_header.sequence_id);
+    pos += store_int1(buf + pos, status);
+    pos += store_int4(buf + pos, statement_id);
+    pos += store_int2(buf + pos, num_columns);
+    pos += store_int2(buf + pos, num_params);
+    pos += store_int1(buf + pos, 0);  // reserved
+    pos += store_int2(buf + pos, warning_count);
+    if (capabilities & CLIENT_OPTIONAL_RESULTSET_METADATA) {
+      pos += store_int1(buf + pos, static_cast<int>(ResultSetMetaData::RESULTSET_METADATA_FULL));
+    }
+
+    int payload_length = pos - 4;
+    store_int3(buf, payload_length);
+    net_packet.resize(pos);
+    return RC::SUCCESS;
+  }
+};
+
 /**
  * @brief MySQL客户端发过来的请求包
  * @ingroup MySQLProtocol
@@ -536,6 +737,149 @@ RC decode_query_packet(vector<char> &net_packet, QueryPacket &query_packet)
   return RC::SUCCESS;
 }
 
+/**
+ * @brief 按照客户端绑定的类型读取一个参数
+ * @details miniob 的整数和浮点数都是4个字节，超出范围的整数直接报错，double 转换成 float。
+ * 字符串和 decimal 都按照字符串处理。miniob 没有 NULL，也不支持日期等其它类型。
+ * [Binary Protocol Value](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_binary_resultset.html)
+ * @param type 参数类型，高位的 0x80 表示无符号
+ */
+RC decode_param_value(const vector<char> &net_packet, size_t &pos, uint16_t type, Value &value)
+{
+  const bool is_unsigned = (type & 0x8000) != 0;
+  int64_t    int_value   = 0;
+  bool       is_int      = true;
+  bool       ok          = true;
+  switch (type & 0xff) {
+    case MYSQL_TYPE_TINY: {
+      int8_t v = 0;
+      ok       = fetch_fix_length(net_packet, pos, &v, sizeof(v));
+      int_value = is_unsigned ? static_cast<uint8_t>(v) : v;
+    } break;
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_YEAR: {
+      int16_t v = 0;
+      ok        = fetch_fix_length(net_packet, pos, &v, sizeof(v));
+      int_value = is_unsigned ? static_cast<uint16_t>(v) : v;
+    } break;
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_INT24: {
+      int32_t v = 0;
+      ok        = fetch_fix_length(net_packet, pos, &v, sizeof(v));
+      int_value = is_unsigned ? static_cast<uint32_t>(v) : v;
+    } break;
+    case MYSQL_TYPE_LONGLONG: {
+      ok = fetch_fix_length(net_packet, pos, &int_value, sizeof(int_value));
+      if (is_unsigned && int_value < 0) {
+        int_value = INT64_MAX;  // 超出范围，下面会报错
+      }
+    } break;
+    case MYSQL_TYPE_FLOAT: {
+      float v = 0;
+      ok      = fetch_fix_length(net_packet, pos, &v, sizeof(v));
+      is_int  = false;
+      value   = Value(v);
+    } break;
+    case MYSQL_TYPE_DOUBLE: {
+      double v = 0;
+      ok       = fetch_fix_length(net_packet, pos, &v, sizeof(v));
+      is_int   = false;
+      value    = Value(static_cast<float>(v));
+    } break;
+    case MYSQL_TYPE_DECIMAL:
+    case MYSQL_TYPE_NEWDECIMAL:
+    case MYSQL_TYPE_VARCHAR:
+    case MYSQL_TYPE_TINY_BLOB:
+    case MYSQL_TYPE_MEDIUM_BLOB:
+    case MYSQL_TYPE_LONG_BLOB:
+    case MYSQL_TYPE_BLOB:
+    case MYSQL_TYPE_VAR_STRING:
+    case MYSQL_TYPE_STRING: {
+      string v;
+      ok     = fetch_lenenc_string(net_packet, pos, v);
+      is_int = false;
+      value  = Value(v.c_str());
+    } break;
+    default: {
+      LOG_WARN("unsupported param type. type=%d", type);
+      return RC::UNSUPPORTED;
+    }
+  }
+
+  if (!ok) {
+    LOG_WARN("execute packet is too short. length=%ld", net_packet.size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (is_int) {
+    if (int_value < INT_MIN || int_value > INT_MAX) {
+      LOG_WARN("integer param is out of range. value=%ld", int_value);
+      return RC::INVALID_ARGUMENT;
+    }
+    value = Value(static_cast<int>(int_value));
+  }
+  return RC::SUCCESS;
+}
+
+/**
+ * @brief 解析执行预编译语句的请求包，读取绑定的参数
+ * @details 只有参数类型变化时客户端才会发送参数类型，否则使用上次绑定的类型。
+ * [COM_STMT_EXECUTE](https://dev.mysql.com/doc/dev/mysql-server/latest/page_protocol_com_stmt_execute.html)
+ * @param net_packet 请求包，不包含包头
+ * @param stmt 要执行的预编译语句
+ * @param[out] params 绑定的参数
+ */
+RC decode_execute_packet(const vector<char> &net_packet, PreparedStatement &stmt, vector<Value> &params)
+{
+  // command(1) statement_id(4) flags(1) iteration_count(4)
+  size_t pos       = 10;
+  int    param_num = stmt.param_num();
+  if (net_packet.size() < pos) {
+    LOG_WARN("execute packet is too short. length=%ld", net_packet.size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  params.clear();
+  if (param_num == 0) {
+    return RC::SUCCESS;
+  }
+
+  vector<uint8_t> null_bitmap((param_num + 7) / 8);
+  uint8_t         new_params_bound = 0;
+  if (!fetch_fix_length(net_packet, pos, null_bitmap.data(), null_bitmap.size()) ||
+      !fetch_fix_length(net_packet, pos, &new_params_bound, 1)) {
+    LOG_WARN("execute packet is too short. length=%ld", net_packet.size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  vector<uint16_t> &param_types = stmt.bound_param_types();
+  if (new_params_bound == 1) {
+    param_types.resize(param_num);
+    if (!fetch_fix_length(net_packet, pos, param_types.data(), param_num * sizeof(uint16_t))) {
+      LOG_WARN("execute packet is too short. length=%ld", net_packet.size());
+      return RC::INVALID_ARGUMENT;
+    }
+  } else if (static_cast<int>(param_types.size()) != param_num) {
+    LOG_WARN("params are never bound. statement id=%u", stmt.id());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  params.resize(param_num);
+  for (int i = 0; i < param_num; i++) {
+    if (null_bitmap[i / 8] & (1 << (i % 8))) {
+      LOG_WARN("null param is not supported. statement id=%u, param index=%d", stmt.id(), i);
+      return RC::UNSUPPORTED;
+    }
+
+    RC rc = decode_param_value(net_packet, pos, param_types[i], params[i]);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to decode param. statement id=%u, param index=%d, rc=%s", stmt.id(), i, strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 /**
  * @brief MySQL客户端连接时会发起一个"select @@version_comment"的查询，这里对这个查询进行特殊处理
  * @param[out] sql_result 生成的结果
@@ -663,7 +1007,7 @@ RC MysqlCommunicator::read_event(SessionEvent *&event)
   LOG_TRACE("recv command from client =%d", command_type);
 
   /// 已经做过握手，接收普通的消息包
-  if (command_type == 0x03) {  // COM_QUERY，这是一个普通的文本请求
+  if (command_type == COM_QUERY) {  // 这是一个普通的文本请求
     QueryPacket query_packet;
     rc = decode_query_packet(buf, query_packet);
     if (rc != RC::SUCCESS) {
@@ -679,6 +1023,15 @@ RC MysqlCommunicator::read_event(SessionEvent *&event)
 
     event = new SessionEvent(this);
     event->set_query(query_packet.query);
+  } else if (command_type == COM_STMT_PREPARE) {
+    rc = handle_stmt_prepare(buf);
+  } else if (command_type == COM_STMT_EXECUTE) {
+    rc = handle_stmt_execute(buf, event);
+  } else if (command_type == COM_STMT_CLOSE || command_type == COM_STMT_RESET) {
+    rc = handle_stmt_close_or_reset(command_type, buf);
+  } else if (command_type == COM_STMT_SEND_LONG_DATA) {
+    /// 按照协议，这个请求没有响应。不支持分段发送参数，执行时会因为缺少参数而报错
+    LOG_WARN("COM_STMT_SEND_LONG_DATA is not supported. addr=%s", addr());
   } else {
     /// 其它的非文本请求，暂时不支持
     OkPacket ok_packet(sequence_id_);
@@ -692,6 +1045,135 @@ RC MysqlCommunicator::read_event(SessionEvent *&event)
   return rc;
 }
 
+/**
+ * @brief 预编译语句
+ * @details 预编译时只做语法检查，不知道结果有多少列，所以返回的列数是0，执行时会返回完整的列描述信息。
+ * 参数都按照字符串类型描述，客户端可以使用任意支持的类型绑定参数。
+ */
+RC MysqlCommunicator::handle_stmt_prepare(const vector<char> &buf)
+{
+  string sql(buf.data() + 1, buf.size() - 1);
+  sql.append(1, ';');
+
+  PreparedStatement *stmt = nullptr;
+  RC rc = session_->prepare_statement(sql, stmt);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to prepare statement. sql=%s, rc=%s", sql.c_str(), strrc(rc));
+    return send_err_packet(rc, "Failed to prepare sql");
+  }
+
+  PrepareOkPacket prepare_ok_packet(sequence_id_++);
+  prepare_ok_packet.statement_id = stmt->id();
+  prepare_ok_packet.num_params   = stmt->param_num();
+  rc = send_packet(prepare_ok_packet);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to send prepare ok packet. addr=%s, rc=%s", addr(), strrc(rc));
+    return rc;
+  }
+
+  if (stmt->param_num() > 0) {
+    vector<char> net_packet(1024);
+    char        *packet_buf = net_packet.data();
+    for (int i = 0; i < stmt->param_num(); i++) {
+      int pos = 3;
+      pos += store_int1(packet_buf + pos, sequence_id_++);
+      pos += store_column_definition(packet_buf + pos, "", "?");
+      store_int3(packet_buf, pos - 4);
+      rc = writer_->writen(packet_buf, pos);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to send param definition to client. addr=%s, error=%s", addr(), strerror(errno));
+        return rc;
+      }
+    }
+
+    if (!(client_capabilities_flag_ & CLIENT_DEPRECATE_EOF)) {
+      EofPacket eof_packet(sequence_id_++);
+      rc = send_packet(eof_packet);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to send eof packet to client. addr=%s, rc=%s", addr(), strrc(rc));
+        return rc;
+      }
+    }
+  }
+
+  writer_->flush();
+  return rc;
+}
+
+/**
+ * @brief 执行预编译语句
+ * @details 参数解析成功后生成一个普通的请求，请求的文本就是预编译语句的文本，由 PlanCacheStage 使用语句上保存的计划。
+ * 结果使用二进制协议返回。
+ */
+RC MysqlCommunicator::handle_stmt_execute(const vector<char> &buf, SessionEvent *&event)
+{
+  uint32_t statement_id = 0;
+  if (buf.size() < 5) {
+    return send_err_packet(RC::INVALID_ARGUMENT, "Malformed packet");
+  }
+  memcpy(&statement_id, buf.data() + 1, sizeof(statement_id));
+
+  PreparedStatement *stmt = session_->find_prepared_statement(statement_id);
+  if (nullptr == stmt) {
+    LOG_WARN("no such prepared statement. id=%u, addr=%s", statement_id, addr());
+    return send_err_packet(RC::NOTFOUND, "Unknown prepared statement handler");
+  }
+
+  vector<Value> params;
+  RC rc = decode_execute_packet(buf, *stmt, params);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to decode execute packet. id=%u, rc=%s", statement_id, strrc(rc));
+    return send_err_packet(rc, "Failed to bind params");
+  }
+
+  event = new SessionEvent(this);
+  event->set_query(stmt->sql());
+  event->set_statement(statement_id, std::move(params));
+  return RC::SUCCESS;
+}
+
+/**
+ * @brief 关闭或重置预编译语句
+ * @details 按照协议，COM_STMT_CLOSE 没有响应。没有支持分段发送参数，所以重置时不需要做任何事情。
+ */
+RC MysqlCommunicator::handle_stmt_close_or_reset(int8_t command_type, const vector<char> &buf)
+{
+  uint32_t statement_id = 0;
+  if (buf.size() >= 5) {
+    memcpy(&statement_id, buf.data() + 1, sizeof(statement_id));
+  }
+
+  if (command_type == COM_STMT_CLOSE) {
+    LOG_TRACE("close prepared statement. id=%u", statement_id);
+    session_->close_prepared_statement(statement_id);
+    return RC::SUCCESS;
+  }
+
+  if (nullptr == session_->find_prepared_statement(statement_id)) {
+    return send_err_packet(RC::NOTFOUND, "Unknown prepared statement handler");
+  }
+
+  OkPacket ok_packet(sequence_id_++);
+  RC rc = send_packet(ok_packet);
+  writer_->flush();
+  return rc;
+}
+
+RC MysqlCommunicator::send_err_packet(RC rc, const char *message)
+{
+  ErrPacket err_packet(sequence_id_++);
+  err_packet.error_code    = static_cast<int>(rc);
+  err_packet.error_message = string(strrc(rc)) + " > " + message;
+
+  RC send_rc = send_packet(err_packet);
+  if (OB_FAIL(send_rc)) {
+    LOG_WARN("failed to send err packet to client. addr=%s, rc=%s", addr(), strrc(send_rc));
+    return send_rc;
+  }
+  writer_->flush();
+  return RC::SUCCESS;
+}
+
 RC MysqlCommunicator::write_state(SessionEvent *event, bool &need_disconnect)
 {
   SqlResult *sql_result = event->sql_result();
@@ -867,40 +1349,8 @@ RC MysqlCommunicator::send_column_definition(SqlResult *sql_result, bool &need_d
     store_int1(buf + pos, sequence_id_++);
     pos += 1;
 
-    const TupleCellSpec &spec      = tuple_schema.cell_at(i);
-    const char          *catalog   = "def";  // The catalog used. Currently always "def"
-    const char          *schema    = "sys";  // schema name
-    const char          *table     = spec.table_name();
-    const char          *org_table = spec.table_name();
-    const char          *name      = spec.alias();
-    // const char *org_name = spec.field_name();
-    const char *org_name         = spec.alias();
-    int         fixed_len_fields = 0x0c;
-    int         character_set    = 33;
-    int         column_length    = 16384;
-    int         type             = MYSQL_TYPE_VAR_STRING;
-    int16_t     flags            = 0;
-    int8_t      decimals         = 0x1f;
-
-    pos += store_lenenc_string(buf + pos, catalog);
-    pos += store_lenenc_string(buf + pos, schema);
-    pos += store_lenenc_string(buf + pos, table);
-    pos += store_lenenc_string(buf + pos, org_table);
-    pos += store_lenenc_string(buf + pos, name);
-    pos += store_lenenc_string(buf + pos, org_name);
-    pos += store_lenenc_int(buf + pos, fixed_len_fields);
-    store_int2(buf + pos, character_set);
-    pos += 2;
-    store_int4(buf + pos, column_length);
-    pos += 4;
-    store_int1(buf + pos, type);
-    pos += 1;
-    store_int2(buf + pos, flags);
-    pos += 2;
-    store_int1(buf + pos, decimals);
-    pos += 1;
-    store_int2(buf + pos, 0);  // 按照mariadb的文档描述，最后还有一个unused字段int<2>，不过mysql的文档没有给出这样的描述
-    pos += 2;
+    const TupleCellSpec &spec = tuple_schema.cell_at(i);
+    pos += store_column_definition(buf + pos, spec.table_name(), spec.alias());
 
     payload_length = pos - 4;
     store_int3(buf, payload_length);
@@ -946,6 +1396,7 @@ RC MysqlCommunicator::send_result_rows(SessionEvent *event, SqlResult *sql_resul
   packet.resize(4 * 1024 * 1024);  // TODO warning: length cannot be fix
 
   int    affected_rows = 0;
+  binary_protocol_     = event->statement_id() != 0;
   if (event->session()->get_execution_mode() == ExecutionMode::CHUNK_ITERATOR
       && event->session()->used_chunk_mode()) {
     rc = write_chunk_result(sql_result, packet, affected_rows, need_disconnect);
@@ -994,6 +1445,7 @@ RC MysqlCommunicator::write_tuple_result(SqlResult *sql_result, vector<char> &pa
 
     pos += 3;
     pos += store_int1(buf + pos, sequence_id_++);
+    pos += store_row_header(buf + pos, cell_num, binary_protocol_);
 
     Value value;
     for (int i = 0; i < cell_num; i++) {
@@ -1036,6 +1488,7 @@ RC MysqlCommunicator::write_chunk_result(SqlResult *sql_result, vector<char> &pa
 
       pos += 3;
       pos += store_int1(buf + pos, sequence_id_++);
+      pos += store_row_header(buf + pos, column_num, binary_protocol_);
 
       for (int col_idx = 0; col_idx < column_num; col_idx++) {
         Value value = chunk.get_value(col_idx, i);
@@ -91,6 +91,29 @@ private:
    */
   RC handle_version_comment(bool &need_disconnect);
 
+  /**
+   * @brief 预编译语句(COM_STMT_PREPARE)，预编译好的语句保存在会话中
+   * @param buf 请求包，不包含包头
+   */
+  RC handle_stmt_prepare(const vector<char> &buf);
+
+  /**
+   * @brief 执行预编译语句(COM_STMT_EXECUTE)
+   * @param buf 请求包，不包含包头
+   * @param[out] event 参数绑定成功时生成一个执行预编译语句的 SessionEvent
+   */
+  RC handle_stmt_execute(const vector<char> &buf, SessionEvent *&event);
+
+  /**
+   * @brief 关闭(COM_STMT_CLOSE)或重置(COM_STMT_RESET)预编译语句
+   */
+  RC handle_stmt_close_or_reset(int8_t command_type, const vector<char> &buf);
+
+  /**
+   * @brief 请求在进入SQL处理流程之前就出错时，直接返回一个 ERR 包
+   */
+  RC send_err_packet(RC rc, const char *message);
+
   RC write_tuple_result(SqlResult *sql_result, vector<char> &packet, int &affected_rows, bool &need_disconnect);
   RC write_chunk_result(SqlResult *sql_result, vector<char> &packet, int &affected_rows, bool &need_disconnect);
 
@@ -104,4 +127,7 @@ private:
   //! 在一次通讯过程中(一个任务的请求与处理)，每个包(packet)都有一个sequence id
   //! 这个sequence id是递增的
   int8_t sequence_id_ = 0;
+
+  //! 当前返回的结果是否使用二进制协议，执行预编译语句时使用
+  bool binary_protocol_ = false;
 };
@@ -85,6 +85,19 @@ RC SqlTaskHandler::handle_sql(SQLStageEvent *sql_event)
     return rc;
   }
 
+  // 查找执行计划缓存
+  rc = plan_cache_stage_.handle_request(sql_event);
+  // 如果处理失败，记录并返回错误码
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("failed to do plan cache. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 命中了执行计划缓存，不需要解析和优化，直接执行
+  if (sql_event->physical_operator() != nullptr) {
+    return execute_stage_.handle_request(sql_event);
+  }
+
   // 处理解析请求
   rc = parse_stage_.handle_request(sql_event);
   // 如果处理失败，记录并返回错误码
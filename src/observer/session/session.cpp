@@ -17,6 +17,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/db/db.h"
 #include "storage/default/default_handler.h"
 #include "storage/trx/trx.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/plan_cache/prepared_statement.h"
 
 /**
  * @brief 获取默认的Session实例
@@ -100,8 +102,65 @@ void Session::set_current_db(const string &dbname)
   LOG_TRACE("change db to %s", dbname.c_str());
   // 将找到的数据库对象设置为当前数据库
   db_ = db;
+  // 缓存的计划引用的是原来数据库中的表
+  clear_plans();
 }
 
+// 获取当前会话的执行计划缓存，第一次使用时创建
+PlanCache &Session::plan_cache()
+{
+  if (plan_cache_ == nullptr) {
+    plan_cache_ = make_unique<PlanCache>();
+  }
+  return *plan_cache_;
+}
+
+// 预编译语句的计划回到语句上，语句已经关闭时直接丢弃
+void Session::put_plan(unique_ptr<CachedPlan> plan)
+{
+  if (plan->statement_id == 0) {
+    plan_cache().put(std::move(plan));
+    return;
+  }
+
+  PreparedStatement *stmt = find_prepared_statement(plan->statement_id);
+  if (stmt != nullptr) {
+    stmt->put_plan(std::move(plan));
+  }
+}
+
+void Session::clear_plans()
+{
+  if (plan_cache_ != nullptr) {
+    plan_cache_->clear();
+  }
+  for (auto &[id, stmt] : prepared_statements_) {
+    stmt->clear_plan();
+  }
+}
+
+RC Session::prepare_statement(const string &sql, PreparedStatement *&stmt)
+{
+  unique_ptr<PreparedStatement> prepared_stmt;
+  RC rc = PreparedStatement::create(next_statement_id_, sql, prepared_stmt);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  next_statement_id_++;
+  stmt = prepared_stmt.get();
+  prepared_statements_.emplace(stmt->id(), std::move(prepared_stmt));
+  return RC::SUCCESS;
+}
+
+PreparedStatement *Session::find_prepared_statement(uint32_t id)
+{
+  auto iter = prepared_statements_.find(id);
+  return iter == prepared_statements_.end() ? nullptr : iter->second.get();
+}
+
+void Session::close_prepared_statement(uint32_t id) { prepared_statements_.erase(id); }
+
 /**
  * 设置事务的多操作模式
  * 
@@ -16,10 +16,16 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/types.h"
 #include "common/lang/string.h"
+#include "common/lang/memory.h"
+#include "common/lang/unordered_map.h"
+#include "common/rc.h"
 
 class Trx;
 class Db;
 class SessionEvent;
+class PlanCache;
+class PreparedStatement;
+struct CachedPlan;
 
 /**
  * @brief 表示会话
@@ -83,6 +89,52 @@ public:
   void          set_execution_mode(const ExecutionMode mode) { execution_mode_ = mode; }
   ExecutionMode get_execution_mode() const { return execution_mode_; }
 
+  void  set_index_fill_factor(float fill_factor) { index_fill_factor_ = fill_factor; }
+  float index_fill_factor() const { return index_fill_factor_; }
+
+  void    set_sort_buffer_size(int64_t sort_buffer_size) { sort_buffer_size_ = sort_buffer_size; }
+  int64_t sort_buffer_size() const { return sort_buffer_size_; }
+
+  void set_parallel_degree(int parallel_degree) { parallel_degree_ = parallel_degree; }
+  int  parallel_degree() const { return parallel_degree_; }
+
+  void set_load_data_logging(bool logging) { load_data_logging_ = logging; }
+  bool load_data_logging() const { return load_data_logging_; }
+
+  void set_plan_cache_enabled(bool enabled) { plan_cache_enabled_ = enabled; }
+  bool plan_cache_enabled() const { return plan_cache_enabled_; }
+
+  /**
+   * @brief 当前会话的执行计划缓存
+   */
+  PlanCache &plan_cache();
+
+  /**
+   * @brief 执行完成后归还计划
+   * @details 预编译语句的计划保存回语句上，其它的放回计划缓存
+   */
+  void put_plan(unique_ptr<CachedPlan> plan);
+
+  /**
+   * @brief 清空计划缓存和预编译语句上保存的计划
+   * @details 切换数据库或者修改会话参数之后，原来的计划都不能再使用
+   */
+  void clear_plans();
+
+  /**
+   * @brief 预编译一条语句
+   * @param sql 带参数(?)的语句
+   * @param[out] stmt 预编译好的语句，由会话持有，直到关闭语句或会话结束
+   */
+  RC prepare_statement(const string &sql, PreparedStatement *&stmt);
+
+  /**
+   * @brief 根据编号查找预编译语句，找不到时返回空
+   */
+  PreparedStatement *find_prepared_statement(uint32_t id);
+
+  void close_prepared_statement(uint32_t id);
+
   bool used_chunk_mode() { return used_chunk_mode_; }
 
   void set_used_chunk_mode(bool used_chunk_mode) { used_chunk_mode_ = used_chunk_mode; }
@@ -113,4 +165,18 @@ private:
   bool used_chunk_mode_ = false;
 
   ExecutionMode execution_mode_ = ExecutionMode::TUPLE_ITERATOR;
+
+  float index_fill_factor_ = DEFAULT_INDEX_FILL_FACTOR;  ///< 在已有数据的表上创建索引时，批量构建使用的页面填充因子
+
+  int64_t sort_buffer_size_ = DEFAULT_SORT_BUFFER_SIZE;  ///< 排序算子可以使用的内存大小，单位是字节
+
+  int parallel_degree_ = DEFAULT_PARALLEL_DEGREE;  ///< 按批执行的聚合查询和导入数据使用的线程数
+
+  bool load_data_logging_ = true;  ///< 导入数据时是否记录数据页面的日志
+
+  bool                  plan_cache_enabled_ = true;  ///< 是否使用执行计划缓存
+  unique_ptr<PlanCache> plan_cache_;                 ///< 执行计划缓存，第一次使用时创建
+
+  uint32_t                                              next_statement_id_ = 1;  ///< 预编译语句的编号，从1开始
+  unordered_map<uint32_t, unique_ptr<PreparedStatement>> prepared_statements_;
 };
@@ -0,0 +1,35 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/executor/analyze_table_executor.h"
+#include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/stmt/analyze_table_stmt.h"
+#include "storage/table/table.h"
+
+RC AnalyzeTableExecutor::execute(SQLStageEvent *sql_event)
+{
+  Stmt    *stmt    = sql_event->stmt();
+  Session *session = sql_event->session_event()->session();
+  ASSERT(stmt->type() == StmtType::ANALYZE_TABLE,
+      "analyze table executor can not run this command: %d",
+      static_cast<int>(stmt->type()));
+
+  AnalyzeTableStmt *analyze_table_stmt = static_cast<AnalyzeTableStmt *>(stmt);
+
+  Table *table = analyze_table_stmt->table();
+  RC     rc    = table->analyze(session->current_trx());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to analyze table. table=%s, rc=%s", table->name(), strrc(rc));
+  }
+  return rc;
+}
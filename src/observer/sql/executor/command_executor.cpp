@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/executor/command_executor.h"
 #include "common/log/log.h"
 #include "event/sql_event.h"
+#include "sql/executor/analyze_table_executor.h"
 #include "sql/executor/create_index_executor.h"
 #include "sql/executor/create_table_executor.h"
 #include "sql/executor/desc_table_executor.h"
@@ -24,6 +25,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/executor/show_tables_executor.h"
 #include "sql/executor/trx_begin_executor.h"
 #include "sql/executor/trx_end_executor.h"
+#include "sql/plan_cache/plan_cache.h"
 #include "sql/stmt/stmt.h"
 
 // CommandExecutor类用于执行SQL命令
@@ -56,6 +58,12 @@ public:
         rc = executor.execute(sql_event);
       } break;
 
+      // 如果是收集统计信息的语句，使用AnalyzeTableExecutor执行
+      case StmtType::ANALYZE_TABLE: {
+        AnalyzeTableExecutor executor;
+        rc = executor.execute(sql_event);
+      } break;
+
       // 如果是帮助命令，使用HelpExecutor执行
       case StmtType::HELP: {
         HelpExecutor executor;
@@ -107,6 +115,8 @@ public:
 
     // 如果执行成功并且是DDL（数据定义语言）命令，则同步数据库以确保元数据与日志一致
     if (OB_SUCC(rc) && stmt_type_ddl(stmt->type())) {
+      // 元数据发生了变化，计划缓存中的计划都需要重新生成
+      PlanCache::bump_schema_version();
       rc = sql_event->session_event()->session()->get_current_db()->sync();
       LOG_INFO("sync db after ddl. rc=%d", rc);
     }
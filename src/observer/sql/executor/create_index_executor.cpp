@@ -50,6 +50,10 @@ public:
     // 从创建索引语句中获取表对象
     Table *table = create_index_stmt->table();
     // 调用表对象的create_index方法来创建索引，并返回结果
-    return table->create_index(trx, create_index_stmt->field_meta(), create_index_stmt->index_name().c_str());
+    return table->create_index(trx,
+        create_index_stmt->field_meta(),
+        create_index_stmt->index_name().c_str(),
+        create_index_stmt->index_type(),
+        session->index_fill_factor());
   }
 };
\ No newline at end of file
@@ -0,0 +1,377 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common/lang/limits.h"
+#include "common/lang/memory.h"
+#include "common/log/log.h"
+#include "common/math/simd_util.h"
+#include "common/thread/thread_pool_executor.h"
+#include "common/type/data_type.h"
+#include "sql/executor/data_loader.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+
+using namespace std;
+using namespace common;
+
+namespace {
+
+/// 每次插入到表中的记录数
+constexpr int INSERT_BATCH_SIZE = 1024;
+
+/**
+ * @brief 在一段文本中依次查找字段分隔符和换行符
+ * @details 开启 USE_SIMD 时每次比较 32 个字节，得到的掩码中每一位对应一个字节，
+ * 依次取出掩码中的位就是各个分隔符的位置，一个 32 字节的窗口只需要比较一次。
+ */
+class SeparatorScanner
+{
+public:
+  SeparatorScanner(const char *begin, const char *end, char delimiter)
+      : pos_(begin), end_(end), delimiter_(delimiter)
+  {}
+
+  /// 返回下一个分隔符或换行符的位置，没有时返回 end
+  const char *next()
+  {
+#if defined(USE_SIMD)
+    while (pos_ + 32 <= end_) {
+      if (!loaded_) {
+        mask_   = mm256_cmpeq_epi8_mask(pos_, delimiter_) | mm256_cmpeq_epi8_mask(pos_, '\n');
+        loaded_ = true;
+      }
+      if (mask_ != 0) {
+        const int index = __builtin_ctz(mask_);
+        mask_ &= mask_ - 1;
+        return pos_ + index;
+      }
+      pos_ += 32;
+      loaded_ = false;
+    }
+#endif
+    while (pos_ < end_) {
+      const char *p = pos_++;
+      if (*p == delimiter_ || *p == '\n') {
+        return p;
+      }
+    }
+    return end_;
+  }
+
+private:
+  const char *pos_;
+  const char *end_;
+  char        delimiter_;
+#if defined(USE_SIMD)
+  uint32_t mask_   = 0;
+  bool     loaded_ = false;
+#endif
+};
+
+bool is_blank_line(const char *begin, const char *end)
+{
+  for (const char *p = begin; p < end; p++) {
+    if (!isspace(*p)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+DataLoader::DataLoader(Table *table, const Options &options) : table_(table), options_(options)
+{
+  options_.threads    = max(options_.threads, 1);
+  options_.block_size = max(options_.block_size, 1);
+}
+
+RC DataLoader::load(const char *file_name)
+{
+  line_count_   = 0;
+  record_count_ = 0;
+  byte_count_   = 0;
+  error_message_.clear();
+  first_failed_seq_ = numeric_limits<int64_t>::max();
+
+  int fd = ::open(file_name, O_RDONLY);
+  if (fd < 0) {
+    error_message_ = string("Failed to open file: ") + file_name + ". system error=" + strerror(errno);
+    return RC::FILE_NOT_EXIST;
+  }
+  // 文件只顺序读一遍，让内核更积极地预读
+  (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  const int          threads = options_.threads;
+  ThreadPoolExecutor executor;
+  if (threads > 1 && executor.init("LoadData", threads, threads, 0 /*keep_alive_time_ms*/) != 0) {
+    LOG_WARN("failed to init thread pool of load data. threads=%d", threads);
+    ::close(fd);
+    return RC::INTERNAL;
+  }
+
+  // 同时在处理中的块最多是线程数的两倍，读文件和处理数据可以重叠，内存占用也有上限
+  const int          max_inflight = 2 * threads;
+  int                inflight     = 0;
+  mutex              inflight_mutex;
+  condition_variable inflight_cond;
+
+  auto dispatch = [&](Block *block) {
+    if (threads <= 1) {
+      load_block(*block);
+      return;
+    }
+
+    {
+      unique_lock<mutex> lock(inflight_mutex);
+      inflight_cond.wait(lock, [&]() { return inflight < max_inflight; });
+      inflight++;
+    }
+    executor.execute([this, block, &inflight, &inflight_mutex, &inflight_cond]() {
+      load_block(*block);
+      lock_guard<mutex> lock(inflight_mutex);
+      inflight--;
+      inflight_cond.notify_one();
+    });
+  };
+
+  RC                        rc = RC::SUCCESS;
+  vector<unique_ptr<Block>> blocks;
+  unique_ptr<char[]>        buffer(new char[options_.block_size]);
+  string                    carry;  // 上一次读取的最后一个不完整的行
+  while (first_failed_seq_.load() == numeric_limits<int64_t>::max()) {
+    ssize_t read_size = ::read(fd, buffer.get(), options_.block_size);
+    if (read_size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG_WARN("failed to read file. file=%s, error=%s", file_name, strerror(errno));
+      error_message_ = string("Failed to read file: ") + file_name + ". system error=" + strerror(errno);
+      rc             = RC::IOERR_READ;
+      break;
+    }
+
+    if (read_size == 0) {
+      if (!carry.empty()) {
+        auto block  = make_unique<Block>();
+        block->seq  = static_cast<int64_t>(blocks.size());
+        block->data = std::move(carry);
+        blocks.push_back(std::move(block));
+        dispatch(blocks.back().get());
+      }
+      break;
+    }
+
+    byte_count_ += read_size;
+    const char *last_newline = static_cast<const char *>(memrchr(buffer.get(), '\n', read_size));
+    if (last_newline == nullptr) {
+      carry.append(buffer.get(), read_size);
+      continue;
+    }
+
+    const size_t complete_size = last_newline - buffer.get() + 1;
+    auto         block         = make_unique<Block>();
+    block->seq                 = static_cast<int64_t>(blocks.size());
+    block->data.reserve(carry.size() + complete_size);
+    block->data.append(carry).append(buffer.get(), complete_size);
+    carry.assign(buffer.get() + complete_size, read_size - complete_size);
+    blocks.push_back(std::move(block));
+    dispatch(blocks.back().get());
+  }
+  ::close(fd);
+
+  if (threads > 1) {
+    executor.shutdown();
+    executor.await_termination();
+  }
+
+  for (const unique_ptr<Block> &block : blocks) {
+    if (OB_FAIL(block->rc)) {
+      if (OB_SUCC(rc)) {
+        rc             = block->rc;
+        error_message_ = "Line:" + to_string(line_count_ + block->error_line + 1) +
+                         " insert record failed:" + block->error + ". error:" + strrc(block->rc);
+      }
+      line_count_ += block->error_line + 1;
+      record_count_ += block->record_count;
+      break;
+    }
+    line_count_ += block->line_count;
+    record_count_ += block->record_count;
+  }
+
+  if (!options_.logging) {
+    // 数据页面的修改没有日志，只能在导入结束时把它们刷到磁盘
+    RC sync_rc = table_->sync();
+    if (OB_FAIL(sync_rc)) {
+      LOG_WARN("failed to sync table after loading data. table=%s, rc=%s", table_->name(), strrc(sync_rc));
+      if (OB_SUCC(rc)) {
+        rc = sync_rc;
+      }
+    }
+  }
+
+  LOG_INFO("load data done. table=%s, lines=%ld, records=%ld, bytes=%ld, threads=%d, logging=%d, rc=%s",
+      table_->name(), line_count_, record_count_, byte_count_, threads, options_.logging, strrc(rc));
+  return rc;
+}
+
+void DataLoader::load_block(Block &block)
+{
+  if (block.seq > first_failed_seq_.load()) {
+    return;
+  }
+
+  const int field_num = table_->table_meta().field_num() - table_->table_meta().sys_field_num();
+
+  vector<Value>       values(field_num);
+  vector<string_view> fields;
+  string              field_buffer;
+  vector<Record>      records;
+  vector<int64_t>     record_lines;  // 每条记录在块中的行号
+  records.reserve(INSERT_BATCH_SIZE);
+  record_lines.reserve(INSERT_BATCH_SIZE);
+
+  RC rc = RC::SUCCESS;
+
+  // 把攒下的记录插入到表中，失败时设置出错的行
+  auto flush = [&]() {
+    if (records.empty()) {
+      return RC::SUCCESS;
+    }
+    int failed_index = -1;
+    RC  insert_rc    = insert_records(records, failed_index, block.error);
+    if (OB_FAIL(insert_rc)) {
+      block.record_count += failed_index;
+      block.error_line = record_lines[failed_index];
+    } else {
+      block.record_count += static_cast<int64_t>(records.size());
+    }
+    records.clear();
+    record_lines.clear();
+    return insert_rc;
+  };
+
+  const char      *begin       = block.data.data();
+  const char      *end         = begin + block.data.size();
+  const char      *line_begin  = begin;
+  const char      *field_begin = begin;
+  int64_t          line_index  = 0;
+  SeparatorScanner scanner(begin, end, options_.delimiter);
+  while (line_begin < end && OB_SUCC(rc)) {
+    const char *sep = scanner.next();
+    // 与 common::split_string 一致，忽略空的字段
+    if (sep > field_begin) {
+      fields.emplace_back(field_begin, sep - field_begin);
+    }
+    if (sep != end && *sep == options_.delimiter) {
+      field_begin = sep + 1;
+      continue;
+    }
+
+    // sep 是一行的结尾
+    if (!is_blank_line(line_begin, sep)) {
+      records.emplace_back();
+      rc = make_record(fields, values, field_buffer, records.back(), block.error);
+      if (OB_FAIL(rc)) {
+        records.pop_back();
+        // 先插入出错的行之前的记录，它们出错时报告更早的行
+        RC flush_rc = flush();
+        if (OB_FAIL(flush_rc)) {
+          rc = flush_rc;
+        } else {
+          block.error_line = line_index;
+        }
+        break;
+      }
+      record_lines.push_back(line_index);
+      if (static_cast<int>(records.size()) >= INSERT_BATCH_SIZE) {
+        rc = flush();
+      }
+    }
+
+    fields.clear();
+    line_index++;
+    line_begin = field_begin = sep + 1;
+  }
+
+  if (OB_SUCC(rc)) {
+    rc = flush();
+  }
+
+  block.rc         = rc;
+  block.line_count = line_index;
+  if (OB_FAIL(rc)) {
+    int64_t expected = first_failed_seq_.load();
+    while (block.seq < expected && !first_failed_seq_.compare_exchange_weak(expected, block.seq)) {}
+  }
+
+  // 处理完的块不再需要数据，释放内存
+  string().swap(block.data);
+}
+
+RC DataLoader::make_record(
+    const vector<string_view> &fields, vector<Value> &values, string &field_buffer, Record &record, string &error)
+{
+  const int field_num     = static_cast<int>(values.size());
+  const int sys_field_num = table_->table_meta().sys_field_num();
+  if (static_cast<int>(fields.size()) < field_num) {
+    return RC::SCHEMA_FIELD_MISSING;
+  }
+
+  for (int i = 0; i < field_num; i++) {
+    const FieldMeta *field = table_->table_meta().field(i + sys_field_num);
+    field_buffer.assign(fields[i].data(), fields[i].size());
+    if (field->type() != AttrType::CHARS) {
+      common::strip(field_buffer);
+    }
+    RC rc = DataType::type_instance(field->type())->set_value_from_str(values[i], field_buffer);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  RC rc = table_->make_record(field_num, values.data(), record);
+  if (OB_FAIL(rc)) {
+    error = "insert failed.";
+  }
+  return rc;
+}
+
+RC DataLoader::insert_records(vector<Record> &records, int &failed_index, string &error)
+{
+#ifndef CONCURRENCY
+  lock_guard<mutex> guard(insert_mutex_);
+#endif
+
+  RC rc = table_->insert_records(records, options_.logging);
+  if (OB_SUCC(rc)) {
+    return rc;
+  }
+
+  // 批量插入失败时所有记录都回滚了，逐条插入找出出错的记录，它之前的记录保留下来
+  for (int i = 0; i < static_cast<int>(records.size()); i++) {
+    rc = table_->insert_record(records[i]);
+    if (OB_FAIL(rc)) {
+      failed_index = i;
+      error        = "insert failed.";
+      return rc;
+    }
+  }
+
+  // 逐条插入都成功了，可能是批量插入时某个页面的空间不够等原因
+  LOG_INFO("batch insert failed but inserting one by one succeeded. table=%s, records=%zu",
+      table_->name(), records.size());
+  return RC::SUCCESS;
+}
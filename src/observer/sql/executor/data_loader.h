@@ -0,0 +1,106 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/mutex.h"
+#include "common/lang/string.h"
+#include "common/lang/string_view.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+#include "common/value.h"
+
+class Table;
+class Record;
+
+/**
+ * @brief 把文本文件中的数据导入到表中
+ * @ingroup Executor
+ * @details 每行是一条记录，字段之间使用分隔符分开。
+ * 当前线程按块读取文件，每个块都是完整的若干行，交给工作线程解析并批量插入到表中。
+ * 同时在处理中的块的个数是有限的，所以不管文件有多大，占用的内存都是固定的。
+ * 遇到错误时停止导入，报告出错的行号。因为块是并行处理的，出错行之后的其它块中的数据可能已经导入了。
+ */
+class DataLoader
+{
+public:
+  struct Options
+  {
+    int  threads    = 1;                ///< 解析和插入数据的线程数
+    bool logging    = true;             ///< 是否记录数据页面的日志。不记录时导入结束后把表刷到磁盘
+    int  block_size = 4 * 1024 * 1024;  ///< 每次从文件中读取的字节数
+    char delimiter  = '|';              ///< 字段分隔符
+  };
+
+public:
+  DataLoader(Table *table, const Options &options);
+  virtual ~DataLoader() = default;
+
+  /**
+   * @brief 导入文件中的数据
+   * @details 文件打不开时返回 FILE_NOT_EXIST，某一行导入失败时返回该行的错误码，
+   * 出错的行号和原因通过 error_message 获取
+   */
+  RC load(const char *file_name);
+
+  int64_t line_count() const { return line_count_; }
+  int64_t record_count() const { return record_count_; }
+  int64_t byte_count() const { return byte_count_; }
+
+  /// 格式是 "Line:N insert record failed:xxx. error:yyy"
+  const string &error_message() const { return error_message_; }
+
+private:
+  /// 文件中连续的若干个完整的行
+  struct Block
+  {
+    string  data;
+    int64_t line_count   = 0;   ///< 块中行的个数
+    int64_t record_count = 0;   ///< 块中导入成功的记录数
+    int64_t seq          = 0;   ///< 块在文件中的序号
+    int64_t error_line   = -1;  ///< 出错的行在块中的行号，从 0 开始
+    RC      rc           = RC::SUCCESS;
+    string  error;
+  };
+
+  /**
+   * @brief 解析一个块中的所有行并插入到表中
+   */
+  void load_block(Block &block);
+
+  /**
+   * @brief 把一行中的各个字段转换成记录
+   * @param values 和 field_buffer 是为了避免频繁申请内存而由调用者提供的
+   */
+  RC make_record(const vector<string_view> &fields, vector<Value> &values, string &field_buffer, Record &record,
+      string &error);
+
+  /**
+   * @brief 插入一批记录，失败时逐条插入，找出出错的那条记录
+   * @param failed_index 出错的记录在 records 中的下标
+   */
+  RC insert_records(vector<Record> &records, int &failed_index, string &error);
+
+private:
+  Table  *table_ = nullptr;
+  Options options_;
+
+  /// 没有打开 CONCURRENCY 时，表上的插入操作不是线程安全的，需要串行化
+  mutex insert_mutex_;
+
+  /// 第一个出错的块的序号。它之后的块不再处理，它之前的块都会处理完，这样出错的行号是准确的
+  atomic<int64_t> first_failed_seq_;
+
+  int64_t line_count_   = 0;
+  int64_t record_count_ = 0;
+  int64_t byte_count_   = 0;
+  string  error_message_;
+};
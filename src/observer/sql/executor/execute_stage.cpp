@@ -89,6 +89,8 @@ public:
     SqlResult *sql_result = sql_event->session_event()->sql_result();
     // 将物理操作符设置到SQL结果中
     sql_result->set_operator(std::move(physical_operator));
+    // 计划可以缓存时，执行完成后由SQL结果放回计划缓存
+    sql_result->set_cached_plan(std::move(sql_event->cached_plan()));
     // 返回处理结果
     return rc;
   }
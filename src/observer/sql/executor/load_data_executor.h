@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 // 引入必要的头文件
 #pragma once  // 确保头文件只被包含一次
 #include "common/rc.h"  // 包含RC类，用于返回状态码
+#include "sql/executor/data_loader.h"
 
 // 引入相关类，这些类在代码中被使用，但未在代码片段中定义
 class SQLStageEvent;
@@ -41,6 +42,7 @@ private:
   // load_data函数用于将数据从文件加载到表中
   // table参数表示要导入数据的表
   // file_name参数表示包含要导入数据的文件的名称
+  // options参数是导入使用的线程数、是否记录日志等选项
   // sql_result参数表示SQL操作的结果
-  void load_data(Table *table, const char *file_name, SqlResult *sql_result);
+  void load_data(Table *table, const char *file_name, const DataLoader::Options &options, SqlResult *sql_result);
 };
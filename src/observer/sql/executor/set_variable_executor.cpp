@@ -43,10 +43,56 @@ RC SetVariableExecutor::execute(SQLStageEvent *sql_event)
       } else {
         rc = RC::INVALID_ARGUMENT;
       }
+    } else if (strcasecmp(var_name, "index_fill_factor") == 0) {
+      float fill_factor = 0;
+      // 获取页面填充因子
+      rc = get_fill_factor(var_value, fill_factor);
+      if (rc == RC::SUCCESS) {
+        session->set_index_fill_factor(fill_factor);
+        LOG_TRACE("set index_fill_factor to %f", fill_factor);
+      }
+    } else if (strcasecmp(var_name, "plan_cache") == 0) {
+      bool bool_value = false;
+      // 将值转换为布尔型
+      rc              = var_value_to_boolean(var_value, bool_value);
+      if (rc == RC::SUCCESS) {
+        // 设置是否使用执行计划缓存
+        session->set_plan_cache_enabled(bool_value);
+        LOG_TRACE("set plan_cache to %d", bool_value);
+      }
+    } else if (strcasecmp(var_name, "sort_buffer_size") == 0) {
+      int64_t sort_buffer_size = 0;
+      // 获取排序可以使用的内存大小
+      rc = get_sort_buffer_size(var_value, sort_buffer_size);
+      if (rc == RC::SUCCESS) {
+        session->set_sort_buffer_size(sort_buffer_size);
+        LOG_TRACE("set sort_buffer_size to %ld", sort_buffer_size);
+      }
+    } else if (strcasecmp(var_name, "parallel_degree") == 0) {
+      int parallel_degree = 0;
+      // 获取查询内并行执行使用的线程数
+      rc = get_parallel_degree(var_value, parallel_degree);
+      if (rc == RC::SUCCESS) {
+        session->set_parallel_degree(parallel_degree);
+        LOG_TRACE("set parallel_degree to %d", parallel_degree);
+      }
+    } else if (strcasecmp(var_name, "load_data_logging") == 0) {
+      bool bool_value = false;
+      // 导入数据时是否记录数据页面的日志
+      rc              = var_value_to_boolean(var_value, bool_value);
+      if (rc == RC::SUCCESS) {
+        session->set_load_data_logging(bool_value);
+        LOG_TRACE("set load_data_logging to %d", bool_value);
+      }
     } else {
       rc = RC::VARIABLE_NOT_EXISTS;  // 变量名不存在
     }
 
+    // 缓存的计划是按照原来的会话参数生成的(比如排序使用的内存)，需要重新生成
+    if (rc == RC::SUCCESS) {
+      session->clear_plans();
+    }
+
     return rc;  // 返回操作结果
 }
 
@@ -110,4 +156,49 @@ RC SetVariableExecutor::get_execution_mode(const Value &var_value, ExecutionMode
     }
 
     return rc;  // 返回操作结果
+}
+
+// get_fill_factor函数用于将Value类型的值转换为页面填充因子，取值范围是(0, 1]
+RC SetVariableExecutor::get_fill_factor(const Value &var_value, float &fill_factor) const
+{
+    if (var_value.attr_type() == AttrType::FLOATS) {
+      fill_factor = var_value.get_float();
+    } else if (var_value.attr_type() == AttrType::INTS) {
+      fill_factor = static_cast<float>(var_value.get_int());
+    } else {
+      return RC::VARIABLE_NOT_VALID;  // 值不是数字类型
+    }
+
+    if (fill_factor <= 0 || fill_factor > 1) {
+      return RC::VARIABLE_NOT_VALID;  // 超出取值范围
+    }
+    return RC::SUCCESS;
+}
+
+// get_sort_buffer_size函数用于将Value类型的值转换为排序内存大小，单位是字节，不能小于64KB
+RC SetVariableExecutor::get_sort_buffer_size(const Value &var_value, int64_t &sort_buffer_size) const
+{
+    if (var_value.attr_type() != AttrType::INTS) {
+      return RC::VARIABLE_NOT_VALID;  // 值不是整数类型
+    }
+
+    sort_buffer_size = var_value.get_int();
+    if (sort_buffer_size < 64 * 1024) {
+      return RC::VARIABLE_NOT_VALID;  // 内存太小，每个有序段的读缓冲都放不下
+    }
+    return RC::SUCCESS;
+}
+
+// get_parallel_degree函数用于将Value类型的值转换为查询内并行执行的线程数，取值范围是[1, MAX_PARALLEL_DEGREE]
+RC SetVariableExecutor::get_parallel_degree(const Value &var_value, int &parallel_degree) const
+{
+    if (var_value.attr_type() != AttrType::INTS) {
+      return RC::VARIABLE_NOT_VALID;  // 值不是整数类型
+    }
+
+    parallel_degree = var_value.get_int();
+    if (parallel_degree < 1 || parallel_degree > MAX_PARALLEL_DEGREE) {
+      return RC::VARIABLE_NOT_VALID;  // 超出取值范围
+    }
+    return RC::SUCCESS;
 }
\ No newline at end of file
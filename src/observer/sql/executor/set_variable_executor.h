@@ -43,4 +43,13 @@ private:
 
   // get_execution_mode函数用于从Value中获取执行模式
   RC get_execution_mode(const Value &var_value, ExecutionMode &execution_mode) const;
+
+  // get_fill_factor函数用于从Value中获取索引页面的填充因子
+  RC get_fill_factor(const Value &var_value, float &fill_factor) const;
+
+  // get_sort_buffer_size函数用于从Value中获取排序算子可以使用的内存大小
+  RC get_sort_buffer_size(const Value &var_value, int64_t &sort_buffer_size) const;
+
+  // get_parallel_degree函数用于从Value中获取查询内并行执行的线程数
+  RC get_parallel_degree(const Value &var_value, int &parallel_degree) const;
 };
\ No newline at end of file
@@ -54,8 +54,16 @@ RC SqlResult::close()
     LOG_WARN("failed to close operator. rc=%s", strrc(rc));
   }
 
+  // 执行成功的计划放回计划缓存，下次执行相同形状的语句时直接复用
+  if (rc == RC::SUCCESS && cached_plan_ != nullptr && session_ != nullptr) {
+    cached_plan_->plan       = std::move(operator_);
+    cached_plan_->chunk_mode = session_->used_chunk_mode();
+    session_->put_plan(std::move(cached_plan_));
+  }
+
   // 重置操作符指针
   operator_.reset();
+  cached_plan_.reset();
 
   // 如果会话不是多操作模式，根据操作结果提交或回滚事务
   if (session_ && !session_->is_trx_multi_operation_mode()) {
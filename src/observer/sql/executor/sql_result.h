@@ -20,6 +20,7 @@ See the Mulan PSL v2 for more details. */
 // 引入相关类的定义
 #include "sql/expr/tuple.h"
 #include "sql/operator/physical_operator.h"
+#include "sql/plan_cache/plan_cache.h"
 
 // 声明Session类，表示会话
 class Session;
@@ -52,6 +53,9 @@ public:
   // 设置执行计划的操作符
   void set_operator(std::unique_ptr<PhysicalOperator> oper);
 
+  // 设置执行计划对应的缓存项，执行成功后计划放回会话的计划缓存
+  void set_cached_plan(std::unique_ptr<CachedPlan> cached_plan) { cached_plan_ = std::move(cached_plan); }
+
   // 检查是否有操作符，即是否有执行计划
   bool has_operator() const { return operator_ != nullptr; }
   
@@ -81,6 +85,8 @@ private:
   Session                          *session_ = nullptr;
   // 执行计划的操作符，可能是一个查询计划或其他类型的操作
   std::unique_ptr<PhysicalOperator> operator_;
+  // 执行计划对应的缓存项，计划不能缓存时为空
+  std::unique_ptr<CachedPlan>       cached_plan_;
   // 返回的表头信息，可能存在也可能不存在
   TupleSchema                       tuple_schema_;
   // 返回代码，表示执行结果
@@ -21,8 +21,86 @@ See the Mulan PSL v2 for more details. */
  */
 RC StandardAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk)
 {
-  // 这里实现您的代码
-  exit(-1);  // 暂未实现
+  if (aggrs_chunk.column_num() != static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("aggregation column number mismatch. expect=%zu, actual=%d", aggr_types_.size(), aggrs_chunk.column_num());
+    return RC::INVALID_ARGUMENT;
+  }
+  if (groups_chunk.column_num() > 0 && groups_chunk.rows() != aggrs_chunk.rows()) {
+    LOG_WARN("groups_chunk and aggrs_chunk rows must be equal.");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC            rc = RC::SUCCESS;
+  vector<Value> group_values(groups_chunk.column_num());
+  for (int row = 0; row < aggrs_chunk.rows(); row++) {
+    for (int i = 0; i < groups_chunk.column_num(); i++) {
+      group_values[i] = groups_chunk.get_value(i, row);
+    }
+
+    auto iter = aggr_values_.find(group_values);
+    if (iter == aggr_values_.end()) {
+      // 新的分组，直接使用当前行的值作为聚合的初始值
+      vector<Value> aggr_values(aggrs_chunk.column_num());
+      for (int i = 0; i < aggrs_chunk.column_num(); i++) {
+        aggr_values[i] = aggrs_chunk.get_value(i, row);
+      }
+      aggr_values_.emplace(group_values, std::move(aggr_values));
+      continue;
+    }
+
+    for (int i = 0; i < aggrs_chunk.column_num() && OB_SUCC(rc); i++) {
+      rc = aggregate(aggr_types_[i], iter->second[i], aggrs_chunk.get_value(i, row));
+    }
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+/**
+ * @brief 合并另一个哈希表中的聚合结果
+ *
+ * @param other 另一个哈希表
+ * @return RC   返回操作结果
+ */
+RC StandardAggregateHashTable::merge(StandardAggregateHashTable &other)
+{
+  if (other.aggr_types_ != aggr_types_) {
+    LOG_WARN("cannot merge aggregate hash tables with different aggregations");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = RC::SUCCESS;
+  for (auto &[group_values, other_aggr_values] : other.aggr_values_) {
+    auto iter = aggr_values_.find(group_values);
+    if (iter == aggr_values_.end()) {
+      aggr_values_.emplace(group_values, std::move(other_aggr_values));
+      continue;
+    }
+
+    for (size_t i = 0; i < aggr_types_.size() && OB_SUCC(rc); i++) {
+      rc = aggregate(aggr_types_[i], iter->second[i], other_aggr_values[i]);
+    }
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  other.aggr_values_.clear();
+  return rc;
+}
+
+RC StandardAggregateHashTable::aggregate(AggregateExpr::Type type, Value &aggr_value, const Value &value)
+{
+  switch (type) {
+    case AggregateExpr::Type::SUM: {
+      return Value::add(aggr_value, value, aggr_value);
+    }
+    default: {
+      LOG_WARN("unsupported aggregation type. type=%d", static_cast<int>(type));
+      return RC::UNIMPLEMENTED;
+    }
+  }
 }
 
 /**
@@ -46,7 +124,7 @@ RC StandardAggregateHashTable::Scanner::next(Chunk &output_chunk)
     return RC::RECORD_EOF;  // 到达结束
   }
   // 在迭代器未到达末尾且输出块容量未满时填充输出块
-  while (it_ != end_ && output_chunk.rows() <= output_chunk.capacity()) {
+  while (it_ != end_ && output_chunk.rows() < output_chunk.capacity()) {
     auto &group_by_values = it_->first;   // 获取分组值
     auto &aggrs           = it_->second;  // 获取聚合值
     for (int i = 0; i < output_chunk.column_num(); i++) {
@@ -8,6 +8,8 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#pragma once
+
 #include <vector>
 #include <iostream>
 #include <unordered_map>
@@ -128,6 +130,18 @@ public:
    */
   RC add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk) override;
 
+  /**
+   * @brief 把另一个哈希表中的聚合结果合并到当前哈希表中
+   * @details 并行聚合时每个线程先聚合到自己的哈希表中，最后再合并到一起
+   * @param other 聚合表达式与当前哈希表相同的哈希表
+   */
+  RC merge(StandardAggregateHashTable &other);
+
+  /**
+   * @brief 哈希表中的分组个数
+   */
+  size_t size() const { return aggr_values_.size(); }
+
   /**
    * @brief 返回哈希表的开始迭代器
    * @return StandardHashTable::iterator 哈希表开始迭代器
@@ -140,6 +154,12 @@ public:
    */
   StandardHashTable::iterator end() { return aggr_values_.end(); }
 
+private:
+  /**
+   * @brief 把 value 聚合到 aggr_value 中
+   */
+  RC aggregate(AggregateExpr::Type type, Value &aggr_value, const Value &value);
+
 private:
   /// group by 值到聚合值的映射
   StandardHashTable                aggr_values_;  // 存储聚合值的哈希表
@@ -15,6 +15,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/expr/expression.h"
 #include "sql/expr/tuple.h"
 #include "sql/expr/arithmetic_operator.hpp"
+#include "storage/record/record_manager.h"
+#include "storage/table/table_meta.h"
 
 using namespace std;
 
@@ -120,6 +122,69 @@ RC ValueExpr::get_column(Chunk &chunk, Column &column)
   return RC::SUCCESS;
 }
 
+ParamExpr::ParamExpr(int index, const std::vector<Value> *params) : index_(index), params_(params)
+{
+  value_type_ = params_->at(index_).attr_type();
+}
+
+bool ParamExpr::equal(const Expression &other) const
+{
+  if (this == &other) {
+    return true;
+  }
+  if (other.type() != ExprType::PARAM) {
+    return false;
+  }
+  // 同一个序号的参数总是绑定相同的值
+  const auto &other_param_expr = static_cast<const ParamExpr &>(other);
+  return index_ == other_param_expr.index_ && value_type_ == other_param_expr.value_type_;
+}
+
+RC ParamExpr::try_get_value(Value &value) const
+{
+  const Value &param = params_->at(index_);
+  if (param.attr_type() == value_type_) {
+    value = param;
+    return RC::SUCCESS;
+  }
+  return Value::cast_to(param, value_type_, value);
+}
+
+RC ParamExpr::get_column(Chunk &chunk, Column &column)
+{
+  Value value;
+  RC    rc = try_get_value(value);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  column.init(value);
+  return RC::SUCCESS;
+}
+
+int ParamExpr::value_length() const
+{
+  Value value;
+  if (OB_FAIL(try_get_value(value))) {
+    return -1;
+  }
+  return value.length();
+}
+
+RC ParamExpr::cast_to(AttrType attr_type)
+{
+  AttrType old_type = value_type_;
+  value_type_       = attr_type;
+
+  Value value;
+  RC    rc = try_get_value(value);
+  if (OB_FAIL(rc)) {
+    value_type_ = old_type;
+    LOG_WARN("failed to cast param %d from %s to %s. rc=%s",
+        index_, attr_type_to_string(old_type), attr_type_to_string(attr_type), strrc(rc));
+  }
+  return rc;
+}
+
 /**
  * @brief CastExpr 的构造函数，初始化转换表达式。
  *
@@ -389,6 +454,54 @@ RC ComparisonExpr::compare_column(const Column &left, const Column &right, std::
   return rc;  // 返回执行状态
 }
 
+/**
+ * @brief 把 `常量 op 字段` 转换成 `字段 op' 常量` 时使用的比较操作符
+ */
+static CompOp mirror_comp(CompOp comp)
+{
+  switch (comp) {
+    case LESS_THAN: return GREAT_THAN;
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    default: return comp;
+  }
+}
+
+bool ComparisonExpr::to_column_predicate(const TableMeta &table_meta, ColumnPredicate &predicate) const
+{
+  CompOp            comp       = comp_;
+  const Expression *field_expr = left_.get();
+  const Expression *value_expr = right_.get();
+  if (field_expr->type() != ExprType::FIELD) {
+    swap(field_expr, value_expr);
+    comp = mirror_comp(comp);
+  }
+  if (field_expr->type() != ExprType::FIELD || comp == NO_OP ||
+      (value_expr->type() != ExprType::VALUE && value_expr->type() != ExprType::PARAM)) {
+    return false;
+  }
+
+  // 字段需要属于扫描的这张表
+  const FieldMeta *field = static_cast<const FieldExpr *>(field_expr)->field().meta();
+  if (field == nullptr || table_meta.field(field->name()) != field) {
+    return false;
+  }
+
+  Value value;
+  if (OB_FAIL(value_expr->try_get_value(value)) || value.attr_type() != field->type()) {
+    return false;
+  }
+  if (field->type() != AttrType::INTS && field->type() != AttrType::FLOATS && field->type() != AttrType::CHARS) {
+    return false;
+  }
+
+  predicate.column_id = table_meta.sys_field_num() + field->field_id();
+  predicate.comp      = comp;
+  predicate.value     = value;
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Conjunction expression constructor, initializes conjunction type and child expressions
 /**
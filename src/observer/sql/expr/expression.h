@@ -23,6 +23,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/common/chunk.h"
 
 class Tuple;
+class TableMeta;
+struct ColumnPredicate;
 
 /**
  * @defgroup Expression
@@ -42,6 +44,7 @@ enum class ExprType
 
   FIELD,        ///< 字段。在实际执行时，根据行数据内容提取对应字段的值
   VALUE,        ///< 常量值
+  PARAM,        ///< 参数，计划缓存中的语句把常量替换成参数，执行时再绑定具体的值
   CAST,         ///< 需要做类型转换的表达式
   COMPARISON,   ///< 需要做比较的表达式
   CONJUNCTION,  ///< 多个表达式使用同一种关系(AND或OR)来联结
@@ -436,6 +439,54 @@ private:
   Value value_;  ///< 表达式的常量值
 };
 
+/**
+ * @brief 参数表达式类 `ParamExpr`，表示语句中的一个 `?`。
+ * @ingroup Expression
+ * @details 计划缓存会把语句中的常量替换成参数，生成的执行计划可以在不同的常量值之间复用。
+ * 参数的值保存在外部的一个数组中(见 CachedPlan)，每次执行前绑定新的值，表达式本身不需要修改。
+ * 生成计划时如果需要做隐式类型转换，不能像常量一样提前算好，记录下目标类型，取值时再转换。
+ */
+class ParamExpr : public Expression
+{
+public:
+  /**
+   * @param index 参数在语句中的序号，从0开始
+   * @param params 参数的值，生命周期要比表达式长
+   */
+  ParamExpr(int index, const std::vector<Value> *params);
+  virtual ~ParamExpr() = default;
+
+  bool equal(const Expression &other) const override;
+
+  RC get_value(const Tuple &tuple, Value &value) const override { return try_get_value(value); }
+
+  RC get_column(Chunk &chunk, Column &column) override;
+
+  /**
+   * @brief 获取当前绑定的参数值，必要时转换成目标类型
+   */
+  RC try_get_value(Value &value) const override;
+
+  ExprType type() const override { return ExprType::PARAM; }
+
+  AttrType value_type() const override { return value_type_; }
+
+  int value_length() const override;
+
+  /**
+   * @brief 取值时把参数转换成指定的类型
+   * @details 会用当前绑定的值检查一次能否转换
+   */
+  RC cast_to(AttrType attr_type);
+
+  int index() const { return index_; }
+
+private:
+  int                       index_  = -1;       ///< 参数的序号
+  const std::vector<Value> *params_ = nullptr;  ///< 参数的值
+  AttrType                  value_type_;        ///< 取值时返回的类型
+};
+
 /**
  * @brief 类型转换表达式类 `CastExpr`，用于将一个表达式的值类型转换为指定的目标类型。
  * @ingroup Expression
@@ -595,6 +646,15 @@ public:
   template <typename T>
   RC compare_column(const Column &left, const Column &right, std::vector<uint8_t> &result) const;
 
+  /**
+   * @brief 把 `字段 op 常量` 形式的比较转换成可以下推到存储层的过滤条件。
+   * 只接受类型相同的 INTS、FLOATS 和 CHARS，其它情况需要类型转换，仍然在算子中计算。
+   * @param table_meta 字段所在的表。
+   * @param[out] predicate 转换后的条件。
+   * @return 可以转换时返回 true。
+   */
+  bool to_column_predicate(const TableMeta &table_meta, ColumnPredicate &predicate) const;
+
 private:
   CompOp                      comp_;   ///< 比较操作符
   std::unique_ptr<Expression> left_;   ///< 左操作数表达式
@@ -76,7 +76,8 @@ RC ExpressionIterator::iterate_child_expr(Expression &expr, function<RC(unique_p
     case ExprType::STAR:           // 星号表达式（如 SELECT *）
     case ExprType::UNBOUND_FIELD:  // 未绑定字段
     case ExprType::FIELD:          // 字段表达式
-    case ExprType::VALUE: {        // 值表达式
+    case ExprType::VALUE:          // 值表达式
+    case ExprType::PARAM: {        // 参数表达式
       // 不处理任何子表达式，直接返回
     } break;
 
@@ -129,8 +129,23 @@ void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Col
  */
 RC AggregateVecPhysicalOperator::next(Chunk &chunk)
 {
-  // 这里需要实现获取下一行数据的逻辑
-  exit(-1);  // 暂时未实现
+  // 没有分组时只输出一行
+  if (output_chunk_.rows() > 0) {
+    return RC::RECORD_EOF;
+  }
+
+  for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+    if (aggregate_expr->value_type() == AttrType::INTS) {
+      append_to_column<SumState<int>, int>(aggr_values_.at(aggr_idx), output_chunk_.column(aggr_idx));
+    } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
+      append_to_column<SumState<float>, float>(aggr_values_.at(aggr_idx), output_chunk_.column(aggr_idx));
+    } else {
+      ASSERT(false, "not supported value type");
+    }
+  }
+  chunk.reference(output_chunk_);
+  return RC::SUCCESS;
 }
 
 /**
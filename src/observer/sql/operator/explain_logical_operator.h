@@ -26,8 +26,8 @@ See the Mulan PSL v2 for more details. */
 class ExplainLogicalOperator : public LogicalOperator
 {
 public:
-  ExplainLogicalOperator()          = default;  // 默认构造函数
-  virtual ~ExplainLogicalOperator() = default;  // 默认析构函数
+  explicit ExplainLogicalOperator(bool analyze = false) : analyze_(analyze) {}  // 构造函数
+  virtual ~ExplainLogicalOperator() = default;                                  // 默认析构函数
 
   /**
    * @brief 获取逻辑算子的类型
@@ -37,4 +37,10 @@ public:
    * 此方法重载自基类，返回解释算子的逻辑类型。
    */
   LogicalOperatorType type() const override { return LogicalOperatorType::EXPLAIN; }  // 返回逻辑算子类型为 EXPLAIN
+
+  /// 是否为 EXPLAIN ANALYZE，需要执行计划并统计每个算子的执行信息
+  bool analyze() const { return analyze_; }
+
+private:
+  bool analyze_ = false;
 };
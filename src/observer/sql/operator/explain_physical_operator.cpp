@@ -14,6 +14,9 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/explain_physical_operator.h"  // 包含解释物理算子的头文件
 #include "common/log/log.h"                          // 包含日志记录的头文件
+#include "sql/operator/profile_physical_operator.h"  // 包含统计算子执行信息的头文件
+#include <chrono>                                    // 包含计时的头文件
+#include <iomanip>                                   // 包含格式化输出的头文件
 #include <sstream>                                   // 包含字符串流头文件，用于构建字符串
 using namespace std;                                 // 使用标准命名空间
 
@@ -25,10 +28,11 @@ using namespace std;                                 // 使用标准命名空间
  *
  * 此函数断言必须有一个子操作符，因为解释操作需要一个执行计划作为输入。
  */
-RC ExplainPhysicalOperator::open(Trx *)
+RC ExplainPhysicalOperator::open(Trx *trx)
 {
   ASSERT(children_.size() == 1, "explain must has 1 child");  // 确保只有一个子操作符
-  return RC::SUCCESS;                                      // 返回成功
+  trx_ = trx;                                                 // EXPLAIN ANALYZE 执行子算子时使用
+  return RC::SUCCESS;                                         // 返回成功
 }
 
 /**
@@ -64,9 +68,55 @@ void ExplainPhysicalOperator::generate_physical_plan()
     to_string(ss, children_[children_size - 1].get(), level, true /*last_child*/, ends);  // 处理最后子节点
   }
 
+  if (analyze_) {
+    ss << "Execution Time: " << fixed << setprecision(3) << total_ns_ / 1000000.0 << "ms\n";  // 输出总耗时
+  }
+
   physical_plan_ = ss.str();  // 将构建的字符串赋值给物理计划成员变量
 }
 
+/**
+ * @brief 执行子算子并统计每个算子的执行信息
+ *
+ * @param chunk_mode 是否按批执行，与外层调用的 next 保持一致
+ * @return RC 返回操作结果代码
+ *
+ * 先把每个算子包装成 ProfilePhysicalOperator，然后像返回结果一样执行完整个计划，但是丢弃输出的数据。
+ */
+RC ExplainPhysicalOperator::analyze(bool chunk_mode)
+{
+  ProfilePhysicalOperator::instrument(*this);  // 只有 EXPLAIN ANALYZE 才会包装算子
+
+  const auto        start = chrono::steady_clock::now();
+  PhysicalOperator *child = children_[0].get();
+
+  RC rc = child->open(trx_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (chunk_mode) {
+    Chunk chunk;
+    while (OB_SUCC(rc = child->next(chunk))) {}
+  } else {
+    while (OB_SUCC(rc = child->next())) {}
+  }
+
+  RC close_rc = child->close();
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to execute child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+  if (OB_FAIL(close_rc)) {
+    LOG_WARN("failed to close child operator. rc=%s", strrc(close_rc));
+    return close_rc;
+  }
+
+  total_ns_ = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+  return RC::SUCCESS;
+}
+
 /**
  * @brief 获取下一条记录
  *
@@ -80,6 +130,12 @@ RC ExplainPhysicalOperator::next()
   if (!physical_plan_.empty()) {
     return RC::RECORD_EOF;  // 如果物理计划已生成，返回记录结束
   }
+  if (analyze_) {
+    RC rc = analyze(false /*chunk_mode*/);  // 先执行一遍计划
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
   generate_physical_plan();  // 生成物理计划
 
   vector<Value> cells;                         // 存储单元格的向量
@@ -102,6 +158,12 @@ RC ExplainPhysicalOperator::next(Chunk &chunk)
   if (!physical_plan_.empty()) {
     return RC::RECORD_EOF;  // 如果物理计划已生成，返回记录结束
   }
+  if (analyze_) {
+    RC rc = analyze(true /*chunk_mode*/);  // 先执行一遍计划
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
   generate_physical_plan();  // 生成物理计划
 
   Value cell(physical_plan_.c_str());      // 创建包含物理计划字符串的值
@@ -153,6 +215,12 @@ void ExplainPhysicalOperator::to_string(
   if (!param.empty()) {
     os << "(" << param << ")";  // 如果参数不为空，打印参数
   }
+  if (analyze_) {
+    // EXPLAIN ANALYZE 时所有的算子都被包装过，打印执行信息，然后继续打印被包装的算子的子算子
+    auto *profile_oper = static_cast<ProfilePhysicalOperator *>(oper);
+    os << " [" << profile_oper->profile().to_string() << "]";
+    oper = profile_oper->target();
+  }
   os << '\n';  // 换行
 
   if (static_cast<int>(ends.size()) < level + 2) {
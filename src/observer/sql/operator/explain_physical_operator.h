@@ -21,13 +21,14 @@ See the Mulan PSL v2 for more details. */
  *
  * 该类表示用于执行解释操作的物理算子。它继承自
  * PhysicalOperator 基类，并实现特定的物理算子类型。
+ * EXPLAIN ANALYZE 时会先执行子算子，输出的计划中每个算子后面带上它的执行信息，参考 ProfilePhysicalOperator。
  * @ingroup PhysicalOperator
  */
 class ExplainPhysicalOperator : public PhysicalOperator
 {
 public:
-  ExplainPhysicalOperator()          = default;  // 默认构造函数
-  virtual ~ExplainPhysicalOperator() = default;  // 默认析构函数
+  explicit ExplainPhysicalOperator(bool analyze = false) : analyze_(analyze) {}  // 构造函数
+  virtual ~ExplainPhysicalOperator() = default;                                   // 默认析构函数
 
   /**
    * @brief 获取物理算子的类型
@@ -77,7 +78,17 @@ private:
    */
   void generate_physical_plan();
 
+  /**
+   * @brief EXPLAIN ANALYZE 时执行子算子，丢弃输出的结果，只统计每个算子的执行信息
+   *
+   * @param chunk_mode 是否按批执行
+   */
+  RC analyze(bool chunk_mode);
+
 private:
-  std::string    physical_plan_;  // 存储生成的物理执行计划字符串
-  ValueListTuple tuple_;          // 当前元组，用于存储值的列表
+  std::string    physical_plan_;       // 存储生成的物理执行计划字符串
+  ValueListTuple tuple_;               // 当前元组，用于存储值的列表
+  bool           analyze_  = false;    // 是否为 EXPLAIN ANALYZE
+  Trx           *trx_      = nullptr;  // 执行子算子使用的事务
+  int64_t        total_ns_ = 0;        // EXPLAIN ANALYZE 执行子算子的总耗时
 };
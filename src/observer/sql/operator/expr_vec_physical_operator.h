@@ -47,6 +47,9 @@ public:
   RC next(Chunk &chunk) override;  // 获取下一个结果并填充到 Chunk 中
   RC close() override;             // 关闭算子，释放资源
 
+  // 表达式计算不改变行数，把 LIMIT 继续下推给子算子
+  void push_down_limit(int64_t limit) override { children_[0]->push_down_limit(limit); }
+
 private:
   std::vector<Expression *> expressions_;   /// 表达式列表，存储要执行的表达式
   Chunk                     chunk_;         /// 当前处理的 Chunk
@@ -8,4 +8,122 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#include "common/log/log.h"
 #include "sql/operator/group_by_vec_physical_operator.h"  // 引入 GroupByVecPhysicalOperator 类的头文件
+
+using namespace std;
+
+GroupByVecPhysicalOperator::GroupByVecPhysicalOperator(
+    vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions)
+    : group_by_exprs_(std::move(group_by_exprs)), aggregate_expressions_(std::move(expressions))
+{
+  value_expressions_.reserve(aggregate_expressions_.size());
+  for (Expression *expr : aggregate_expressions_) {
+    ASSERT(expr->type() == ExprType::AGGREGATION, "expected an aggregation expression");
+    Expression *child_expr = static_cast<AggregateExpr *>(expr)->child().get();
+    ASSERT(child_expr != nullptr, "aggregation expression must have a child expression");
+    value_expressions_.push_back(child_expr);
+  }
+}
+
+RC GroupByVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "group by operator only support one child, but got %d", children_.size());
+
+  PhysicalOperator &child = *children_[0];
+  RC                rc    = child.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_INFO("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 计划缓存中的计划会被反复打开，每次都重新聚合
+  hash_table_ = make_unique<StandardAggregateHashTable>(aggregate_expressions_);
+  while (OB_SUCC(rc = child.next(chunk_))) {
+    rc = aggregate_chunk(chunk_, *hash_table_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to aggregate chunk. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get next chunk from child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  open_scan();
+  return RC::SUCCESS;
+}
+
+RC GroupByVecPhysicalOperator::aggregate_chunk(Chunk &chunk, StandardAggregateHashTable &hash_table)
+{
+  RC    rc = RC::SUCCESS;
+  Chunk groups_chunk;
+  Chunk aggrs_chunk;
+  for (size_t i = 0; i < group_by_exprs_.size() && OB_SUCC(rc); i++) {
+    auto column = make_unique<Column>();
+    rc          = group_by_exprs_[i]->get_column(chunk, *column);
+    groups_chunk.add_column(std::move(column), static_cast<int>(i));
+  }
+  for (size_t i = 0; i < value_expressions_.size() && OB_SUCC(rc); i++) {
+    auto column = make_unique<Column>();
+    rc          = value_expressions_[i]->get_column(chunk, *column);
+    aggrs_chunk.add_column(std::move(column), static_cast<int>(i));
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to evaluate expressions of group by. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  return hash_table.add_chunk(groups_chunk, aggrs_chunk);
+}
+
+void GroupByVecPhysicalOperator::open_scan()
+{
+  output_chunk_.reset();
+  const int group_num = static_cast<int>(group_by_exprs_.size());
+  for (int i = 0; i < group_num; i++) {
+    Expression *expr = group_by_exprs_[i].get();
+    output_chunk_.add_column(make_unique<Column>(expr->value_type(), expr->value_length()), i);
+  }
+  for (size_t i = 0; i < aggregate_expressions_.size(); i++) {
+    Expression *expr = aggregate_expressions_[i];
+    output_chunk_.add_column(
+        make_unique<Column>(expr->value_type(), expr->value_length()), group_num + static_cast<int>(i));
+  }
+
+  scanner_ = make_unique<StandardAggregateHashTable::Scanner>(hash_table_.get());
+  scanner_->open_scan();
+}
+
+RC GroupByVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (scanner_ == nullptr) {
+    return RC::RECORD_EOF;
+  }
+
+  output_chunk_.reset_data();
+  RC rc = scanner_->next(output_chunk_);
+  if (OB_SUCC(rc)) {
+    chunk.reference(output_chunk_);
+  }
+  return rc;
+}
+
+RC GroupByVecPhysicalOperator::close()
+{
+  if (scanner_ != nullptr) {
+    scanner_->close_scan();
+    scanner_.reset();
+  }
+  hash_table_.reset();
+
+  RC rc = RC::SUCCESS;
+  for (unique_ptr<PhysicalOperator> &child : children_) {
+    RC child_rc = child->close();
+    rc          = OB_SUCC(rc) ? child_rc : rc;
+  }
+  LOG_INFO("close group by operator");
+  return rc;
+}
@@ -16,29 +16,49 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief Group By 物理算子(vectorized)
  * @ingroup PhysicalOperator
+ * @details open 时读取子算子的所有数据，按照分组表达式的值聚合到哈希表中，next 时从哈希表中输出结果。
+ * 输出的 chunk 中先是分组的值，然后是聚合的值，与逻辑计划中设置的表达式位置(pos)一致。
  */
 class GroupByVecPhysicalOperator : public PhysicalOperator
 {
 public:
   // 构造函数，接受分组表达式和聚合表达式
   GroupByVecPhysicalOperator(
-      std::vector<std::unique_ptr<Expression>> &&group_by_exprs, std::vector<Expression *> &&expressions)
-  {}  // 初始化
+      std::vector<std::unique_ptr<Expression>> &&group_by_exprs, std::vector<Expression *> &&expressions);
 
   virtual ~GroupByVecPhysicalOperator() = default;  // 默认析构函数
 
   // 返回物理算子的类型
   PhysicalOperatorType type() const override { return PhysicalOperatorType::GROUP_BY_VEC; }
 
-  // 打开物理算子，准备操作
-  RC open(Trx *trx) override { return RC::UNIMPLEMENTED; }  // 该函数尚未实现
+  // 打开物理算子，读取子算子的所有数据并聚合
+  RC open(Trx *trx) override;
 
   // 获取下一个数据块
-  RC next(Chunk &chunk) override { return RC::UNIMPLEMENTED; }  // 该函数尚未实现
+  RC next(Chunk &chunk) override;
 
   // 关闭物理算子，清理资源
-  RC close() override { return RC::UNIMPLEMENTED; }  // 该函数尚未实现
+  RC close() override;
 
-private:
-  // 私有成员变量可以在这里添加，例如用于存储聚合结果等
+protected:
+  /**
+   * @brief 计算 chunk 中每一行的分组值和聚合函数的参数，聚合到 hash_table 中
+   * @details 不修改算子的状态，可以在多个线程中使用不同的哈希表同时调用
+   */
+  RC aggregate_chunk(Chunk &chunk, StandardAggregateHashTable &hash_table);
+
+  /**
+   * @brief 聚合完成后准备输出结果
+   */
+  void open_scan();
+
+protected:
+  std::vector<std::unique_ptr<Expression>> group_by_exprs_;         // 分组表达式
+  std::vector<Expression *>                aggregate_expressions_;  // 聚合表达式
+  std::vector<Expression *>                value_expressions_;      // 聚合函数的参数
+
+  std::unique_ptr<StandardAggregateHashTable>          hash_table_;  // 聚合结果
+  std::unique_ptr<StandardAggregateHashTable::Scanner> scanner_;     // 输出聚合结果
+  Chunk                                                chunk_;         // 子算子输出的数据块
+  Chunk                                                output_chunk_;  // 输出结果的数据块
 };
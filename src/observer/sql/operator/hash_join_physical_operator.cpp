@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/hash_join_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+HashJoinPhysicalOperator::HashJoinPhysicalOperator(vector<unique_ptr<Expression>> &&left_keys,
+    vector<unique_ptr<Expression>> &&right_keys, unique_ptr<Expression> predicate)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys)), predicate_(std::move(predicate))
+{
+  ASSERT(left_keys_.size() == right_keys_.size() && !left_keys_.empty(), "invalid hash join keys");
+}
+
+RC HashJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("hash join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  left_        = children_[0].get();
+  matches_     = nullptr;
+  match_index_ = 0;
+  emitted_     = 0;
+
+  RC rc = children_[1]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open build side. rc=%s", strrc(rc));
+    return rc;
+  }
+  rc = build();
+  RC close_rc = children_[1]->close();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  if (OB_FAIL(close_rc)) {
+    LOG_WARN("failed to close build side. rc=%s", strrc(close_rc));
+    return close_rc;
+  }
+
+  return left_->open(trx);
+}
+
+RC HashJoinPhysicalOperator::build()
+{
+  build_rows_.clear();
+  hash_table_.clear();
+
+  RC                rc    = RC::SUCCESS;
+  PhysicalOperator *right = children_[1].get();
+  string            key;
+  while (OB_SUCC(rc = right->next())) {
+    Tuple *tuple = right->current_tuple();
+    if (OB_FAIL(rc = make_key(right_keys_, *tuple, key))) {
+      return rc;
+    }
+
+    ValueListTuple row;
+    if (OB_FAIL(rc = ValueListTuple::make(*tuple, row))) {
+      LOG_WARN("failed to copy build row. rc=%s", strrc(rc));
+      return rc;
+    }
+    hash_table_[key].push_back(build_rows_.size());
+    build_rows_.emplace_back(std::move(row));
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read build side. rc=%s", strrc(rc));
+    return rc;
+  }
+  LOG_TRACE("hash join build done. rows=%zu, keys=%zu", build_rows_.size(), hash_table_.size());
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::make_key(vector<unique_ptr<Expression>> &keys, const Tuple &tuple, string &key)
+{
+  key.clear();
+  for (unique_ptr<Expression> &expr : keys) {
+    Value value;
+    RC    rc = expr->get_value(tuple, value);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    key.append(value.to_string()).push_back('\0');
+  }
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::next()
+{
+  if (limit_ >= 0 && emitted_ >= limit_) {
+    return RC::RECORD_EOF;  // 上层需要的行已经全部输出
+  }
+
+  RC     rc = RC::SUCCESS;
+  string key;
+  while (true) {
+    // 继续输出当前左表行关联的右表行
+    while (matches_ != nullptr && match_index_ < matches_->size()) {
+      joined_tuple_.set_right(&build_rows_[(*matches_)[match_index_++]]);
+
+      Value value;
+      if (OB_FAIL(rc = predicate_->get_value(joined_tuple_, value))) {
+        LOG_WARN("failed to evaluate join predicate. rc=%s", strrc(rc));
+        return rc;
+      }
+      if (value.get_boolean()) {
+        emitted_++;
+        return RC::SUCCESS;
+      }
+    }
+
+    if (OB_FAIL(rc = left_->next())) {
+      return rc;
+    }
+
+    Tuple *left_tuple = left_->current_tuple();
+    if (OB_FAIL(rc = make_key(left_keys_, *left_tuple, key))) {
+      return rc;
+    }
+    joined_tuple_.set_left(left_tuple);
+
+    auto iter    = hash_table_.find(key);
+    matches_     = (iter == hash_table_.end()) ? nullptr : &iter->second;
+    match_index_ = 0;
+  }
+}
+
+RC HashJoinPhysicalOperator::close()
+{
+  build_rows_.clear();
+  hash_table_.clear();
+  matches_ = nullptr;
+  return left_->close();
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 等值连接的哈希连接算子
+ * @ingroup PhysicalOperator
+ * @details 打开时读取右表(构建侧)的所有行，按照连接键放到内存的哈希表中，
+ * 然后依次遍历左表(探测侧)的每一行，在哈希表中找到连接键相同的行。
+ * 连接键使用值的字符串形式做哈希，可能把不相等的值放在一起，所以找到的每一行都要再计算一遍完整的连接条件。
+ * 输出的顺序与嵌套循环连接相同：按照左表的顺序，同一个左表行关联的右表行按照右表的顺序。
+ */
+class HashJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param left_keys 左表的连接键
+   * @param right_keys 右表的连接键，与 left_keys 一一对应
+   * @param predicate 完整的连接条件，包含连接键的等值条件
+   */
+  HashJoinPhysicalOperator(vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys,
+      unique_ptr<Expression> predicate);
+  virtual ~HashJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::HASH_JOIN; }
+
+  string param() const override { return limit_ >= 0 ? "limit=" + std::to_string(limit_) : ""; }
+
+  RC     open(Trx *trx) override;
+  RC     next() override;
+  RC     close() override;
+  Tuple *current_tuple() override { return &joined_tuple_; }
+
+  // 上层最多需要 limit 行，输出足够的行之后不再遍历左表
+  void push_down_limit(int64_t limit) override { limit_ = limit; }
+
+private:
+  /// 计算连接键，键中任意一个值计算失败时返回错误
+  RC make_key(vector<unique_ptr<Expression>> &keys, const Tuple &tuple, string &key);
+
+  /// 读取右表的所有行，构建哈希表
+  RC build();
+
+private:
+  vector<unique_ptr<Expression>> left_keys_;
+  vector<unique_ptr<Expression>> right_keys_;
+  unique_ptr<Expression>         predicate_;
+
+  vector<ValueListTuple>                build_rows_;             ///< 右表的所有行
+  unordered_map<string, vector<size_t>> hash_table_;             ///< 连接键到右表行号的映射
+  const vector<size_t>                 *matches_     = nullptr;  ///< 当前左表行在右表中关联的行
+  size_t                                match_index_ = 0;        ///< 下一个要检查的关联行
+
+  PhysicalOperator *left_ = nullptr;
+  JoinedTuple       joined_tuple_;
+  int64_t           limit_   = -1;  ///< 最多输出多少行，小于0表示不限制
+  int64_t           emitted_ = 0;   ///< 已经输出了多少行
+};
@@ -54,6 +54,16 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;                         // 返回内部错误
   }
 
+  // 查找的值来自参数，使用本次执行绑定的值
+  if (key_expr_ != nullptr) {
+    RC rc = key_expr_->try_get_value(left_value_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get index key from param. rc=%s", strrc(rc));
+      return rc;
+    }
+    right_value_ = left_value_;
+  }
+
   // 创建索引扫描器
   IndexScanner *index_scanner = index_->create_scanner(left_value_.data(),
       left_value_.length(),                      // 左侧值数据和长度
@@ -77,7 +87,8 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
 
   tuple_.set_schema(table_, table_->table_meta().field_metas());  // 设置元组的模式
 
-  trx_ = trx;          // 保存当前事务
+  trx_     = trx;      // 保存当前事务
+  emitted_ = 0;
   return RC::SUCCESS;  // 返回成功
 }
 
@@ -90,6 +101,15 @@ RC IndexScanPhysicalOperator::next()
   RID rid;               // 定义记录标识符
   RC  rc = RC::SUCCESS;  // 初始化返回代码为成功
 
+  // 上层需要的行已经全部输出，提前销毁扫描器，不再访问后面的叶子节点
+  if (limit_ >= 0 && emitted_ >= limit_) {
+    if (index_scanner_ != nullptr) {
+      index_scanner_->destroy();
+      index_scanner_ = nullptr;
+    }
+    return RC::RECORD_EOF;
+  }
+
   bool filter_result = false;                                       // 过滤结果初始化为 false
   while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {  // 循环获取下一个索引条目
     rc = record_handler_->get_record(rid, current_record_);         // 根据 RID 获取记录
@@ -118,6 +138,9 @@ RC IndexScanPhysicalOperator::next()
       LOG_TRACE("record invisible");   // 记录不可见日志
       continue;                        // 继续下一个循环
     } else {
+      if (OB_SUCC(rc)) {
+        emitted_++;
+      }
       return rc;  // 返回其他结果代码
     }
   }
@@ -131,8 +154,10 @@ RC IndexScanPhysicalOperator::next()
  */
 RC IndexScanPhysicalOperator::close()
 {
-  index_scanner_->destroy();  // 销毁索引扫描器
-  index_scanner_ = nullptr;   // 清空索引扫描器指针
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();  // 销毁索引扫描器
+    index_scanner_ = nullptr;   // 清空索引扫描器指针
+  }
   return RC::SUCCESS;         // 返回成功
 }
 
@@ -190,5 +215,9 @@ RC IndexScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
  */
 std::string IndexScanPhysicalOperator::param() const
 {
-  return std::string(index_->index_meta().name()) + " ON " + table_->name();  // 返回索引名称和表名
+  std::string param = std::string(index_->index_meta().name()) + " ON " + table_->name();  // 返回索引名称和表名
+  if (limit_ >= 0) {
+    param += ", limit=" + std::to_string(limit_);
+  }
+  return param;
 }
@@ -58,6 +58,19 @@ public:
    */
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 上层最多需要 limit 行
+   * @details 输出足够的行之后就销毁索引扫描器，不再遍历后面的叶子节点，同时释放叶子节点上的锁
+   */
+  void push_down_limit(int64_t limit) override { limit_ = limit; }
+
+  /**
+   * @brief 索引查找的值来自一个参数
+   * @details 计划缓存中的计划每次执行时参数的值可能不同，每次打开时用这个表达式重新计算查找的值。
+   * 表达式是 predicates 中的一部分，生命周期与算子相同。
+   */
+  void set_key_expr(const Expression *expr) { key_expr_ = expr; }
+
 private:
   // 与 TableScanPhysicalOperator 代码相同，可以优化
   /**
@@ -84,5 +97,10 @@ private:
   bool  left_inclusive_  = false;  // 左侧是否包含边界
   bool  right_inclusive_ = false;  // 右侧是否包含边界
 
+  const Expression *key_expr_ = nullptr;  // 查找的值来自参数时，计算查找值的表达式
+
+  int64_t limit_   = -1;  // 最多输出多少行，小于0表示不限制
+  int64_t emitted_ = 0;   // 已经输出了多少行
+
   std::vector<std::unique_ptr<Expression>> predicates_;  // 过滤条件的表达式列表
 };
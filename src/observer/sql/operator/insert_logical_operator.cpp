@@ -16,7 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/insert_logical_operator.h"  // 包含插入逻辑算子的头文件
 
 // 构造函数实现
-InsertLogicalOperator::InsertLogicalOperator(Table *table, std::vector<Value> values)
-    : table_(table),   // 初始化表指针
-      values_(values)  // 初始化值向量
+InsertLogicalOperator::InsertLogicalOperator(Table *table, std::vector<std::vector<Value>> rows)
+    : table_(table),          // 初始化表指针
+      rows_(std::move(rows))  // 初始化所有行
 {}
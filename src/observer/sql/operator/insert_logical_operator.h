@@ -28,7 +28,7 @@ class InsertLogicalOperator : public LogicalOperator
 {
 public:
   // 构造函数
-  InsertLogicalOperator(Table *table, std::vector<Value> values);
+  InsertLogicalOperator(Table *table, std::vector<std::vector<Value>> rows);
   virtual ~InsertLogicalOperator() = default;  // 默认析构函数
 
   // 返回逻辑算子类型
@@ -36,12 +36,12 @@ public:
 
   // 获取表指针
   Table *table() const { return table_; }
-  // 获取值的常量引用
-  const std::vector<Value> &values() const { return values_; }
-  // 获取值的可变引用
-  std::vector<Value> &values() { return values_; }
+  // 获取所有行的常量引用
+  const std::vector<std::vector<Value>> &rows() const { return rows_; }
+  // 获取所有行的可变引用
+  std::vector<std::vector<Value>> &rows() { return rows_; }
 
 private:
-  Table             *table_ = nullptr;  // 表指针
-  std::vector<Value> values_;           // 存储插入值的向量
+  Table                          *table_ = nullptr;  // 表指针
+  std::vector<std::vector<Value>> rows_;             // 要插入的所有行，每一行是一个值数组
 };
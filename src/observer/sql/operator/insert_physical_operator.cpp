@@ -20,26 +20,34 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;  // 使用标准命名空间
 
-// 构造函数：初始化目标表和要插入的值
-InsertPhysicalOperator::InsertPhysicalOperator(Table *table, vector<Value> &&values)
-    : table_(table), values_(std::move(values))  // 使用 std::move 移动值以避免拷贝
+// 构造函数：初始化目标表和要插入的所有行
+InsertPhysicalOperator::InsertPhysicalOperator(Table *table, vector<vector<Value>> &&rows)
+    : table_(table), rows_(std::move(rows))  // 使用 std::move 移动值以避免拷贝
 {}
 
 // 打开物理算子，准备插入记录
 RC InsertPhysicalOperator::open(Trx *trx)
 {
-  Record record;  // 定义记录对象
-  // 创建记录，参数包括字段数量、字段值数组和记录对象
-  RC rc = table_->make_record(static_cast<int>(values_.size()), values_.data(), record);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to make record. rc=%s", strrc(rc));  // 记录错误信息
-    return rc;                                           // 返回错误代码
+  // 先创建所有的记录，任何一行的值不合法都不会插入数据
+  vector<Record> records(rows_.size());
+  for (size_t i = 0; i < rows_.size(); i++) {
+    // 创建记录，参数包括字段数量、字段值数组和记录对象
+    RC rc = table_->make_record(static_cast<int>(rows_[i].size()), rows_[i].data(), records[i]);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to make record. row=%d, rc=%s", static_cast<int>(i), strrc(rc));  // 记录错误信息
+      return rc;                                                                         // 返回错误代码
+    }
   }
 
-  // 通过事务插入记录
-  rc = trx->insert_record(table_, record);
+  // 通过事务插入记录，多行时走批量插入的接口
+  RC rc = RC::SUCCESS;
+  if (records.size() == 1) {
+    rc = trx->insert_record(table_, records[0]);
+  } else {
+    rc = trx->insert_records(table_, records);
+  }
   if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to insert record by transaction. rc=%s", strrc(rc));  // 记录错误信息
+    LOG_WARN("failed to insert record by transaction. rows=%d, rc=%s", static_cast<int>(records.size()), strrc(rc));
   }
   return rc;  // 返回插入结果的错误代码
 }
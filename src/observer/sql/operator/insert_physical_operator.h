@@ -29,7 +29,7 @@ class InsertPhysicalOperator : public PhysicalOperator
 {
 public:
   // 构造函数
-  InsertPhysicalOperator(Table *table, std::vector<Value> &&values);
+  InsertPhysicalOperator(Table *table, std::vector<std::vector<Value>> &&rows);
 
   virtual ~InsertPhysicalOperator() = default;  // 默认析构函数
 
@@ -49,6 +49,6 @@ public:
   Tuple *current_tuple() override { return nullptr; }
 
 private:
-  Table             *table_ = nullptr;  // 指向目标表的指针
-  std::vector<Value> values_;           // 存储要插入的值
+  Table                          *table_ = nullptr;  // 指向目标表的指针
+  std::vector<std::vector<Value>> rows_;             // 存储要插入的所有行
 };
@@ -21,6 +21,7 @@ See the Mulan PSL v2 for more details. */
  * @brief 连接算子
  * @ingroup LogicalOperator
  * @details 连接算子，用于连接两个表。对应的物理算子或者实现，可能有 NestedLoopJoin，HashJoin 等等。
+ * expressions 中保存连接条件，多个条件之间是 AND 的关系。连接条件由 JoinReorderRule 从 where 中拆分出来。
  */
 class JoinLogicalOperator : public LogicalOperator
 {
@@ -30,7 +31,4 @@ public:
 
   // 返回算子的类型，这里返回的是 JOIN 类型
   LogicalOperatorType type() const override { return LogicalOperatorType::JOIN; }
-
-private:
-  // 这里可以添加连接算子的特定成员变量，例如连接条件、左表、右表等
 };
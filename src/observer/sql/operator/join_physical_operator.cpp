@@ -30,14 +30,45 @@ RC NestedLoopJoinPhysicalOperator::open(Trx *trx)
   right_        = children_[1].get();  // 获取右表的物理算子
   right_closed_ = true;                // 右表初始状态为关闭
   round_done_   = true;                // 初始标志位，表示右表是否完成一轮遍历
+  emitted_      = 0;
 
   rc   = left_->open(trx);  // 打开左表
   trx_ = trx;               // 保存当前事务
   return rc;                // 返回状态码
 }
 
-// 获取下一个结果元组
+// 获取下一个满足连接条件的结果元组
 RC NestedLoopJoinPhysicalOperator::next()
+{
+  if (limit_ >= 0 && emitted_ >= limit_) {
+    return RC::RECORD_EOF;  // 上层需要的行已经全部输出
+  }
+
+  RC rc = RC::SUCCESS;
+  while (OB_SUCC(rc = next_pair())) {
+    if (predicate_ == nullptr) {
+      break;
+    }
+
+    Value value;
+    rc = predicate_->get_value(joined_tuple_, value);  // 计算连接条件
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to evaluate join predicate. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (value.get_boolean()) {
+      break;
+    }
+  }
+
+  if (OB_SUCC(rc)) {
+    emitted_++;
+  }
+  return rc;
+}
+
+// 关联下一对左右表的元组
+RC NestedLoopJoinPhysicalOperator::next_pair()
 {
   bool left_need_step = (left_tuple_ == nullptr);  // 左元组是否需要更新
   RC   rc             = RC::SUCCESS;               // 初始化返回代码为成功
@@ -15,12 +15,13 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "sql/expr/expression.h"             // 包含连接条件使用的表达式定义
 #include "sql/operator/physical_operator.h"  // 包含物理算子的基类头文件
 #include "sql/parser/parse.h"                // 包含解析器的相关定义
 
 /**
  * @brief 最简单的两表（称为左表、右表）join算子
- * @details 依次遍历左表的每一行，然后关联右表的每一行
+ * @details 依次遍历左表的每一行，然后关联右表的每一行，只输出满足连接条件的行
  * @ingroup PhysicalOperator
  */
 class NestedLoopJoinPhysicalOperator : public PhysicalOperator
@@ -32,6 +33,9 @@ public:
   // 返回算子的类型，这里返回的是 NESTED_LOOP_JOIN 类型
   PhysicalOperatorType type() const override { return PhysicalOperatorType::NESTED_LOOP_JOIN; }
 
+  // 返回参数字符串，下推了 LIMIT 时显示出来
+  std::string param() const override { return limit_ >= 0 ? "limit=" + std::to_string(limit_) : ""; }
+
   // 打开算子，初始化相关资源
   RC open(Trx *trx) override;
 
@@ -44,7 +48,17 @@ public:
   // 获取当前关联的元组
   Tuple *current_tuple() override;
 
+  // 设置连接条件，为空时输出左右两表的笛卡尔积
+  void set_predicate(std::unique_ptr<Expression> predicate) { predicate_ = std::move(predicate); }
+
+  // 上层最多需要 limit 行，输出足够的行之后不再遍历左表，也不再重新打开右表
+  // 每个左表元组可能关联任意多行，所以不能下推给子算子
+  void push_down_limit(int64_t limit) override { limit_ = limit; }
+
 private:
+  // 关联下一对左右表的元组，不考虑连接条件
+  RC next_pair();
+
   // 左表遍历下一条数据
   RC left_next();
 
@@ -62,4 +76,8 @@ private:
   JoinedTuple       joined_tuple_;           // 当前关联的左右两个元组
   bool              round_done_   = true;    // 右表遍历的一轮是否结束
   bool              right_closed_ = true;    // 右表算子是否已经关闭
+  int64_t           limit_        = -1;      // 最多输出多少行，小于0表示不限制
+  int64_t           emitted_      = 0;       // 已经输出了多少行
+
+  std::unique_ptr<Expression> predicate_;  // 连接条件，可能为空
 };
@@ -0,0 +1,34 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/logical_operator.h"  // 引入逻辑算子的头文件
+
+/**
+ * @brief LIMIT 逻辑算子
+ * @ingroup LogicalOperator
+ * @details 跳过前面 offset 行，最多输出 limit 行
+ */
+class LimitLogicalOperator : public LogicalOperator
+{
+public:
+  LimitLogicalOperator(int64_t limit, int64_t offset) : limit_(limit), offset_(offset) {}
+  virtual ~LimitLogicalOperator() = default;
+
+  LogicalOperatorType type() const override { return LogicalOperatorType::LIMIT; }
+
+  int64_t limit() const { return limit_; }
+  int64_t offset() const { return offset_; }
+
+private:
+  int64_t limit_;   ///< 最多输出多少行
+  int64_t offset_;  ///< 跳过前面多少行
+};
@@ -0,0 +1,60 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/limit_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+string LimitPhysicalOperator::param() const
+{
+  return "limit=" + to_string(limit_) + ", offset=" + to_string(offset_);
+}
+
+RC LimitPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "limit operator only support one child, but got %d", children_.size());
+
+  skipped_  = 0;
+  returned_ = 0;
+  RC rc     = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC LimitPhysicalOperator::next()
+{
+  if (limit_ >= 0 && returned_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+
+  PhysicalOperator &child = *children_[0];
+  RC                rc    = RC::SUCCESS;
+  for (; skipped_ < offset_; skipped_++) {
+    rc = child.next();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  rc = child.next();
+  if (OB_SUCC(rc)) {
+    returned_++;
+  }
+  return rc;
+}
+
+RC LimitPhysicalOperator::close()
+{
+  children_[0]->close();
+  return RC::SUCCESS;
+}
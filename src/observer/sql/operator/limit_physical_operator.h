@@ -0,0 +1,45 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/physical_operator.h"  // 引入物理算子的定义
+
+/**
+ * @brief LIMIT 物理算子
+ * @ingroup PhysicalOperator
+ * @details 跳过子算子的前 offset 行，最多输出 limit 行，输出够了以后不再从子算子获取数据
+ */
+class LimitPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param limit 最多输出多少行，小于0表示不限制
+   * @param offset 跳过前面多少行
+   */
+  LimitPhysicalOperator(int64_t limit, int64_t offset) : limit_(limit), offset_(offset) {}
+  virtual ~LimitPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::LIMIT; }
+  std::string          param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override { return children_[0]->current_tuple(); }
+  RC     tuple_schema(TupleSchema &schema) const override { return children_[0]->tuple_schema(schema); }
+
+private:
+  int64_t limit_    = -1;
+  int64_t offset_   = 0;
+  int64_t skipped_  = 0;  ///< 已经跳过的行数
+  int64_t returned_ = 0;  ///< 已经输出的行数
+};
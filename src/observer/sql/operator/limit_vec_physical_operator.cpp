@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/limit_vec_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+string LimitVecPhysicalOperator::param() const
+{
+  return "limit=" + to_string(limit_) + ", offset=" + to_string(offset_);
+}
+
+RC LimitVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "limit operator only support one child, but got %d", children_.size());
+
+  skipped_  = 0;
+  returned_ = 0;
+  RC rc     = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC LimitVecPhysicalOperator::next(Chunk &chunk)
+{
+  PhysicalOperator &child = *children_[0];
+  while (limit_ < 0 || returned_ < limit_) {
+    RC rc = child.next(child_chunk_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    const int64_t rows  = child_chunk_.rows();
+    const int64_t start = std::min(rows, offset_ - skipped_);
+    skipped_ += start;
+    int64_t num = rows - start;
+    if (limit_ >= 0) {
+      num = std::min(num, limit_ - returned_);
+    }
+    if (num == 0) {
+      continue;
+    }
+
+    returned_ += num;
+    if (num == rows) {
+      return chunk.reference(child_chunk_);
+    }
+
+    // 只需要 [start, start + num) 这部分数据
+    output_.reset();
+    for (int i = 0; i < child_chunk_.column_num(); i++) {
+      Column &column = child_chunk_.column(i);
+      auto    output = make_unique<Column>(column.attr_type(), column.attr_len(), num);
+      if (column.column_type() == Column::Type::CONSTANT_COLUMN) {
+        for (int64_t row = 0; row < num; row++) {
+          output->append_one(column.data());
+        }
+      } else {
+        output->append(column.data() + start * column.attr_len(), static_cast<int>(num));
+      }
+      output_.add_column(std::move(output), child_chunk_.column_ids(i));
+    }
+    return chunk.reference(output_);
+  }
+  return RC::RECORD_EOF;
+}
+
+RC LimitVecPhysicalOperator::close()
+{
+  child_chunk_.reset();
+  output_.reset();
+  children_[0]->close();
+  return RC::SUCCESS;
+}
@@ -0,0 +1,43 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/physical_operator.h"  // 引入物理算子的定义
+
+/**
+ * @brief LIMIT 物理算子（向量化）
+ * @ingroup PhysicalOperator
+ * @details 整批都需要输出时直接引用子算子的 Chunk，只需要其中一部分时拷贝出来
+ */
+class LimitVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  LimitVecPhysicalOperator(int64_t limit, int64_t offset) : limit_(limit), offset_(offset) {}
+  virtual ~LimitVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::LIMIT_VEC; }
+  std::string          param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+  RC tuple_schema(TupleSchema &schema) const override { return children_[0]->tuple_schema(schema); }
+
+private:
+  int64_t limit_    = -1;
+  int64_t offset_   = 0;
+  int64_t skipped_  = 0;  ///< 已经跳过的行数
+  int64_t returned_ = 0;  ///< 已经输出的行数
+
+  Chunk child_chunk_;  ///< 子算子返回的数据
+  Chunk output_;       ///< 只输出子算子一部分数据时，拷贝到这里
+};
@@ -36,6 +36,7 @@ bool LogicalOperator::can_generate_vectorized_operator(const LogicalOperatorType
   {
     case LogicalOperatorType::CALC:    // 如果是计算算子
     case LogicalOperatorType::DELETE:  // 如果是删除算子
+    case LogicalOperatorType::UPDATE:  // 如果是更新算子
     case LogicalOperatorType::INSERT:  // 如果是插入算子
       bool_ret = false;                // 不可以生成矢量化算子
       break;
@@ -40,8 +40,11 @@ enum class LogicalOperatorType
   JOIN,        ///< 连接操作
   INSERT,      ///< 插入操作
   DELETE,      ///< 删除操作，删除可能会有子查询
+  UPDATE,      ///< 更新操作
   EXPLAIN,     ///< 查看执行计划
   GROUP_BY,    ///< 分组操作
+  SORT,        ///< 排序
+  LIMIT,       ///< 限制输出的行数
 };
 
 /**
@@ -0,0 +1,150 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "common/log/log.h"
+#include "common/thread/thread_pool_executor.h"
+#include "sql/operator/parallel_group_by_vec_physical_operator.h"
+#include "storage/table/table.h"
+
+using namespace std;
+using namespace common;
+
+ParallelGroupByVecPhysicalOperator::ParallelGroupByVecPhysicalOperator(
+    Table *table, vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions)
+    : GroupByVecPhysicalOperator(std::move(group_by_exprs), std::move(expressions)), table_(table)
+{}
+
+ParallelGroupByVecPhysicalOperator::~ParallelGroupByVecPhysicalOperator()
+{
+  // 子算子中的扫描器引用了 morsel_iterator_，要先于它析构
+  children_.clear();
+}
+
+string ParallelGroupByVecPhysicalOperator::param() const { return "workers=" + to_string(children_.size()); }
+
+RC ParallelGroupByVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(!children_.empty(), "parallel group by operator should have children");
+
+  RC rc = table_->init_morsel_iterator(morsel_iterator_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  for (unique_ptr<PhysicalOperator> &child : children_) {
+    rc = child->open(trx);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  const int                                 worker_num = static_cast<int>(children_.size());
+  vector<unique_ptr<StandardAggregateHashTable>> partial_tables;
+  for (int i = 0; i < worker_num; i++) {
+    partial_tables.emplace_back(make_unique<StandardAggregateHashTable>(aggregate_expressions_));
+  }
+  vector<RC>             worker_rcs(worker_num, RC::SUCCESS);
+  vector<BufferPoolStat> worker_stats(worker_num);
+
+  // 线程只属于本次查询，所有的子算子都执行完后线程池就退出了
+  ThreadPoolExecutor executor;
+  if (executor.init("ParallelAgg", worker_num, worker_num, 0 /*keep_alive_time_ms*/) != 0) {
+    LOG_WARN("failed to init thread pool of parallel group by. workers=%d", worker_num);
+    return RC::INTERNAL;
+  }
+
+  for (int i = 0; i < worker_num; i++) {
+    executor.execute([this, i, &partial_tables, &worker_rcs, &worker_stats]() {
+      const BufferPoolStat start = BufferPoolStat::thread_local_stat();
+
+      worker_rcs[i] = run_worker(*children_[i], *partial_tables[i]);
+
+      const BufferPoolStat &end = BufferPoolStat::thread_local_stat();
+      worker_stats[i].hit_count  = end.hit_count - start.hit_count;
+      worker_stats[i].miss_count = end.miss_count - start.miss_count;
+      worker_stats[i].read_count = end.read_count - start.read_count;
+    });
+  }
+  executor.shutdown();
+  executor.await_termination();
+
+  // 工作线程访问的页面也算在当前线程上，EXPLAIN ANALYZE 显示的是整个算子访问的页面
+  BufferPoolStat &stat = BufferPoolStat::thread_local_stat();
+  for (const BufferPoolStat &worker_stat : worker_stats) {
+    stat.hit_count += worker_stat.hit_count;
+    stat.miss_count += worker_stat.miss_count;
+    stat.read_count += worker_stat.read_count;
+  }
+
+  for (int i = 0; i < worker_num; i++) {
+    if (OB_FAIL(worker_rcs[i])) {
+      LOG_WARN("parallel group by worker failed. worker=%d, rc=%s", i, strrc(worker_rcs[i]));
+      return worker_rcs[i];
+    }
+  }
+
+  hash_table_ = std::move(partial_tables[0]);
+  for (int i = 1; i < worker_num; i++) {
+    rc = hash_table_->merge(*partial_tables[i]);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to merge partial aggregation. worker=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+  }
+
+  if (group_by_exprs_.empty() && hash_table_->size() == 0) {
+    rc = add_empty_result();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  LOG_TRACE("parallel group by done. workers=%d, groups=%zu", worker_num, hash_table_->size());
+  open_scan();
+  return RC::SUCCESS;
+}
+
+RC ParallelGroupByVecPhysicalOperator::run_worker(PhysicalOperator &child, StandardAggregateHashTable &hash_table)
+{
+  RC    rc = RC::SUCCESS;
+  Chunk chunk;
+  while (OB_SUCC(rc = child.next(chunk))) {
+    rc = aggregate_chunk(chunk, hash_table);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to aggregate chunk. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
+RC ParallelGroupByVecPhysicalOperator::add_empty_result()
+{
+  // 与 AggregateVecPhysicalOperator 一样，没有数据时 SUM 的结果是 0
+  Chunk groups_chunk;
+  Chunk aggrs_chunk;
+  for (size_t i = 0; i < aggregate_expressions_.size(); i++) {
+    Value zero;
+    switch (aggregate_expressions_[i]->value_type()) {
+      case AttrType::INTS: zero = Value(0); break;
+      case AttrType::FLOATS: zero = Value(0.0f); break;
+      default: {
+        LOG_WARN("unsupported value type of aggregation. type=%s",
+                 attr_type_to_string(aggregate_expressions_[i]->value_type()));
+        return RC::UNIMPLEMENTED;
+      }
+    }
+    auto column = make_unique<Column>();
+    column->init(zero);
+    aggrs_chunk.add_column(std::move(column), static_cast<int>(i));
+  }
+  return hash_table_->add_chunk(groups_chunk, aggrs_chunk);
+}
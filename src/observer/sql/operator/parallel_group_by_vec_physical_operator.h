@@ -0,0 +1,57 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/group_by_vec_physical_operator.h"
+#include "storage/record/record_manager.h"
+
+class Table;
+
+/**
+ * @brief 并行的分组聚合物理算子(vectorized)
+ * @ingroup PhysicalOperator
+ * @details 每个子算子是同一张表上的一个 TABLE_SCAN_VEC，它们从共享的 PageMorselIterator 中领取页面，
+ * 合起来正好扫描整张表一次。open 时为本次查询创建一个线程池，每个子算子在一个线程上完成
+ * 扫描、过滤、计算表达式以及聚合到自己的哈希表中，最后在当前线程上合并所有的哈希表。
+ * 没有分组表达式时也可以使用，结果只有一行。
+ */
+class ParallelGroupByVecPhysicalOperator : public GroupByVecPhysicalOperator
+{
+public:
+  ParallelGroupByVecPhysicalOperator(Table *table, std::vector<std::unique_ptr<Expression>> &&group_by_exprs,
+      std::vector<Expression *> &&expressions);
+
+  virtual ~ParallelGroupByVecPhysicalOperator();
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::PARALLEL_GROUP_BY_VEC; }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+
+  /// 子算子共享的页面迭代器
+  PageMorselIterator &morsel_iterator() { return morsel_iterator_; }
+
+private:
+  /**
+   * @brief 在工作线程上读取一个子算子的所有数据，聚合到 hash_table 中
+   */
+  RC run_worker(PhysicalOperator &child, StandardAggregateHashTable &hash_table);
+
+  /**
+   * @brief 没有分组表达式而且没有数据时，也要输出一行聚合结果
+   */
+  RC add_empty_result();
+
+private:
+  Table             *table_ = nullptr;
+  PageMorselIterator morsel_iterator_;
+};
@@ -25,19 +25,26 @@ std::string physical_operator_type_name(PhysicalOperatorType type)
     case PhysicalOperatorType::TABLE_SCAN: return "TABLE_SCAN";              // 表扫描
     case PhysicalOperatorType::INDEX_SCAN: return "INDEX_SCAN";              // 索引扫描
     case PhysicalOperatorType::NESTED_LOOP_JOIN: return "NESTED_LOOP_JOIN";  // 嵌套循环连接
+    case PhysicalOperatorType::HASH_JOIN: return "HASH_JOIN";                // 哈希连接
     case PhysicalOperatorType::EXPLAIN: return "EXPLAIN";                    // 执行计划解释
     case PhysicalOperatorType::PREDICATE: return "PREDICATE";                // 谓词
     case PhysicalOperatorType::INSERT: return "INSERT";                      // 插入操作
     case PhysicalOperatorType::DELETE: return "DELETE";                      // 删除操作
+    case PhysicalOperatorType::UPDATE: return "UPDATE";                      // 更新操作
     case PhysicalOperatorType::PROJECT: return "PROJECT";                    // 投影操作
     case PhysicalOperatorType::STRING_LIST: return "STRING_LIST";            // 字符串列表
     case PhysicalOperatorType::HASH_GROUP_BY: return "HASH_GROUP_BY";        // 哈希分组
     case PhysicalOperatorType::SCALAR_GROUP_BY: return "SCALAR_GROUP_BY";    // 标量分组
     case PhysicalOperatorType::AGGREGATE_VEC: return "AGGREGATE_VEC";        // 矢量化聚合
     case PhysicalOperatorType::GROUP_BY_VEC: return "GROUP_BY_VEC";          // 矢量化分组
+    case PhysicalOperatorType::PARALLEL_GROUP_BY_VEC: return "PARALLEL_GROUP_BY_VEC";  // 并行的矢量化分组
     case PhysicalOperatorType::PROJECT_VEC: return "PROJECT_VEC";            // 矢量化投影
     case PhysicalOperatorType::TABLE_SCAN_VEC: return "TABLE_SCAN_VEC";      // 矢量化表扫描
     case PhysicalOperatorType::EXPR_VEC: return "EXPR_VEC";                  // 矢量化表达式
+    case PhysicalOperatorType::SORT: return "SORT";                          // 排序
+    case PhysicalOperatorType::SORT_VEC: return "SORT_VEC";                  // 矢量化排序
+    case PhysicalOperatorType::LIMIT: return "LIMIT";                        // 限制输出的行数
+    case PhysicalOperatorType::LIMIT_VEC: return "LIMIT_VEC";                // 矢量化限制输出的行数
     default: return "UNKNOWN";                                               // 未知类型
   }
 }
@@ -42,6 +42,7 @@ enum class PhysicalOperatorType
   TABLE_SCAN_VEC,    ///< 矢量化表扫描
   INDEX_SCAN,        ///< 索引扫描
   NESTED_LOOP_JOIN,  ///< 嵌套循环连接
+  HASH_JOIN,         ///< 哈希连接
   EXPLAIN,           ///< 执行计划解释
   PREDICATE,         ///< 谓词
   PREDICATE_VEC,     ///< 矢量化谓词
@@ -50,12 +51,18 @@ enum class PhysicalOperatorType
   CALC,              ///< 计算操作
   STRING_LIST,       ///< 字符串列表
   DELETE,            ///< 删除操作
+  UPDATE,            ///< 更新操作
   INSERT,            ///< 插入操作
   SCALAR_GROUP_BY,   ///< 标量分组
   HASH_GROUP_BY,     ///< 哈希分组
   GROUP_BY_VEC,      ///< 矢量化分组
+  PARALLEL_GROUP_BY_VEC,  ///< 并行的矢量化分组
   AGGREGATE_VEC,     ///< 矢量化聚合
   EXPR_VEC,          ///< 矢量化表达式
+  SORT,              ///< 排序
+  SORT_VEC,          ///< 矢量化排序
+  LIMIT,             ///< 限制输出的行数
+  LIMIT_VEC,         ///< 矢量化限制输出的行数
 };
 
 /**
@@ -128,6 +135,15 @@ public:
    */
   virtual RC tuple_schema(TupleSchema &schema) const { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 告诉算子上层最多只会取走多少行数据
+   * @details 用于 LIMIT 下推，在生成物理计划时由 LIMIT 算子向下传递，默认什么都不做。
+   * 扫描算子输出足够的行之后就不再读取新的页面或者叶子节点，直接返回 RECORD_EOF；
+   * 输出行数与输入行数相同的算子(比如投影)继续把它传给子算子。
+   * @param limit 最多需要的行数，不小于0
+   */
+  virtual void push_down_limit(int64_t limit) {}
+
   /**
    * @brief 添加子物理算子
    * @param oper 要添加的子物理算子
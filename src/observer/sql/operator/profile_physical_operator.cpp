@@ -0,0 +1,139 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <chrono>
+#include <dlfcn.h>
+#include <iomanip>
+#include <sstream>
+
+#include "sql/operator/profile_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+using namespace std;
+
+namespace {
+
+using AllocatedMemoryFunc = size_t (*)();
+
+/**
+ * @brief 查找 memtracer 导出的 mt_allocated_memory
+ * @details observer 不链接 memtracer，只有通过 LD_PRELOAD 加载了 memtracer 时才能找到
+ */
+AllocatedMemoryFunc allocated_memory_func()
+{
+  static AllocatedMemoryFunc func = reinterpret_cast<AllocatedMemoryFunc>(dlsym(RTLD_DEFAULT, "mt_allocated_memory"));
+  return func;
+}
+
+int64_t now_ns()
+{
+  return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+/**
+ * @brief 记录一次调用的耗时和访问的页面
+ */
+class ProfilePhysicalOperator::Scope
+{
+public:
+  Scope(ProfilePhysicalOperator &oper, int64_t &elapsed_ns)
+      : oper_(oper), elapsed_ns_(elapsed_ns), stat_(BufferPoolStat::thread_local_stat()), start_ns_(now_ns())
+  {}
+
+  ~Scope()
+  {
+    elapsed_ns_ += now_ns() - start_ns_;
+
+    const BufferPoolStat &stat    = BufferPoolStat::thread_local_stat();
+    OperatorProfile      &profile = oper_.profile_;
+    profile.buffer_hit += stat.hit_count - stat_.hit_count;
+    profile.buffer_miss += stat.miss_count - stat_.miss_count;
+    profile.buffer_read += stat.read_count - stat_.read_count;
+
+    if (oper_.base_memory_ >= 0) {
+      const int64_t memory = static_cast<int64_t>(allocated_memory_func()()) - oper_.base_memory_;
+      profile.peak_memory  = std::max(profile.peak_memory, memory);
+    }
+  }
+
+private:
+  ProfilePhysicalOperator &oper_;
+  int64_t                 &elapsed_ns_;
+  const BufferPoolStat     stat_;  ///< 调用之前的计数
+  const int64_t            start_ns_;
+};
+
+string OperatorProfile::to_string() const
+{
+  stringstream ss;
+  ss << fixed << setprecision(3);
+  ss << "loops=" << loops << " rows=" << rows;
+  if (chunks > 0) {
+    ss << " chunks=" << chunks;
+  }
+  ss << " open=" << open_ns / 1000000.0 << "ms"
+     << " next=" << next_ns / 1000000.0 << "ms"
+     << " close=" << close_ns / 1000000.0 << "ms";
+  ss << " hit=" << buffer_hit << " miss=" << buffer_miss << " read=" << buffer_read;
+  if (peak_memory >= 0) {
+    ss << " peak_memory=" << peak_memory;
+  }
+  return ss.str();
+}
+
+void ProfilePhysicalOperator::instrument(PhysicalOperator &oper)
+{
+  for (unique_ptr<PhysicalOperator> &child : oper.children()) {
+    instrument(*child);
+    child = make_unique<ProfilePhysicalOperator>(std::move(child));
+  }
+}
+
+RC ProfilePhysicalOperator::open(Trx *trx)
+{
+  if (base_memory_ < 0 && allocated_memory_func() != nullptr) {
+    base_memory_         = static_cast<int64_t>(allocated_memory_func()());
+    profile_.peak_memory = 0;
+  }
+
+  profile_.loops++;
+  Scope scope(*this, profile_.open_ns);
+  return oper_->open(trx);
+}
+
+RC ProfilePhysicalOperator::next()
+{
+  Scope scope(*this, profile_.next_ns);
+  RC    rc = oper_->next();
+  if (OB_SUCC(rc)) {
+    profile_.rows++;
+  }
+  return rc;
+}
+
+RC ProfilePhysicalOperator::next(Chunk &chunk)
+{
+  Scope scope(*this, profile_.next_ns);
+  RC    rc = oper_->next(chunk);
+  if (OB_SUCC(rc)) {
+    profile_.chunks++;
+    profile_.rows += chunk.rows();
+  }
+  return rc;
+}
+
+RC ProfilePhysicalOperator::close()
+{
+  Scope scope(*this, profile_.close_ns);
+  return oper_->close();
+}
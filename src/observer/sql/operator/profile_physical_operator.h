@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 一个算子的执行信息
+ * @details 时间、页面访问和内存都包含子算子，与 PostgreSQL 的 EXPLAIN ANALYZE 一样
+ */
+struct OperatorProfile
+{
+  int64_t open_ns  = 0;  ///< open 的耗时
+  int64_t next_ns  = 0;  ///< 所有 next 调用的耗时
+  int64_t close_ns = 0;  ///< close 的耗时
+
+  int64_t loops  = 0;  ///< open 的次数，比如嵌套循环连接的右表每一行都会打开一次
+  int64_t rows   = 0;  ///< 输出的行数
+  int64_t chunks = 0;  ///< 按批执行时输出的 chunk 个数
+
+  uint64_t buffer_hit  = 0;  ///< 在缓冲池中找到的页面
+  uint64_t buffer_miss = 0;  ///< 不在缓冲池中的页面
+  uint64_t buffer_read = 0;  ///< 从磁盘读取的页面
+
+  int64_t peak_memory = -1;  ///< 执行期间比 open 之前多分配的内存的最大值，没有加载 memtracer 时为 -1
+
+  string to_string() const;
+};
+
+/**
+ * @brief 统计一个算子的执行信息
+ * @ingroup PhysicalOperator
+ * @details EXPLAIN ANALYZE 执行前把计划中的每个算子都包装一层，在调用被包装的算子前后记录时间、
+ * 当前线程的缓冲池计数(BufferPoolStat)和 memtracer 统计的内存。
+ * 它对上层算子是透明的：类型、名称、输出的行都与被包装的算子相同。
+ * 普通的查询不会创建这个算子，所以关闭时没有任何开销。
+ *
+ * 内存是 memtracer 统计的整个进程的内存，有其它会话同时执行时只能作为参考。
+ */
+class ProfilePhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit ProfilePhysicalOperator(unique_ptr<PhysicalOperator> oper) : oper_(std::move(oper)) {}
+  virtual ~ProfilePhysicalOperator() = default;
+
+  /**
+   * @brief 把 oper 下面的所有算子(不包括 oper 自己)都包装一层
+   */
+  static void instrument(PhysicalOperator &oper);
+
+  PhysicalOperatorType type() const override { return oper_->type(); }
+  string               name() const override { return oper_->name(); }
+  string               param() const override { return oper_->param(); }
+
+  RC     open(Trx *trx) override;
+  RC     next() override;
+  RC     next(Chunk &chunk) override;
+  RC     close() override;
+  Tuple *current_tuple() override { return oper_->current_tuple(); }
+
+  RC   tuple_schema(TupleSchema &schema) const override { return oper_->tuple_schema(schema); }
+  void push_down_limit(int64_t limit) override { oper_->push_down_limit(limit); }
+
+  /// 被包装的算子，它的子算子也都是 ProfilePhysicalOperator
+  PhysicalOperator      *target() const { return oper_.get(); }
+  const OperatorProfile &profile() const { return profile_; }
+
+private:
+  class Scope;
+
+private:
+  unique_ptr<PhysicalOperator> oper_;
+  OperatorProfile              profile_;
+  int64_t                      base_memory_ = -1;  ///< open 之前分配的内存
+};
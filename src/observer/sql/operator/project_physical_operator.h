@@ -77,6 +77,16 @@ public:
    */
   RC tuple_schema(TupleSchema &schema) const override;
 
+  /**
+   * @brief 投影不改变行数，把 LIMIT 继续下推给子算子
+   */
+  void push_down_limit(int64_t limit) override
+  {
+    if (!children_.empty()) {
+      children_[0]->push_down_limit(limit);
+    }
+  }
+
 private:
   std::vector<std::unique_ptr<Expression>>     expressions_;  ///< 用于投影的表达式列表
   ExpressionTuple<std::unique_ptr<Expression>> tuple_;        ///< 存储结果元组的表达式元组
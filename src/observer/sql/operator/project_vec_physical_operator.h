@@ -65,6 +65,16 @@ public:
    */
   RC tuple_schema(TupleSchema &schema) const override;
 
+  /**
+   * @brief 投影不改变行数，把 LIMIT 继续下推给子算子
+   */
+  void push_down_limit(int64_t limit) override
+  {
+    if (!children_.empty()) {
+      children_[0]->push_down_limit(limit);
+    }
+  }
+
   /**
    * @brief 获取表达式列表
    * @return 返回表达式列表的引用
@@ -0,0 +1,45 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/logical_operator.h"  // 引入逻辑算子的头文件
+#include "sql/stmt/select_stmt.h"           // 引入OrderByUnit的定义
+
+/**
+ * @brief 排序逻辑算子
+ * @ingroup LogicalOperator
+ * @details 放在投影算子之上，按照投影结果中的某几列排序。投影结果的最后几列可能是只用于排序的隐藏列，
+ * 排序后只输出前面 visible_column_num 列。
+ */
+class SortLogicalOperator : public LogicalOperator
+{
+public:
+  /**
+   * @param order_by 排序列
+   * @param visible_column_num 输出的列数
+   * @param limit 上层最多需要多少行，小于0表示全部需要。排序时只需要保留最小的 limit 行
+   */
+  SortLogicalOperator(const std::vector<OrderByUnit> &order_by, int visible_column_num, int64_t limit)
+      : order_by_(order_by), visible_column_num_(visible_column_num), limit_(limit)
+  {}
+  virtual ~SortLogicalOperator() = default;
+
+  LogicalOperatorType type() const override { return LogicalOperatorType::SORT; }
+
+  const std::vector<OrderByUnit> &order_by() const { return order_by_; }
+  int                             visible_column_num() const { return visible_column_num_; }
+  int64_t                         limit() const { return limit_; }
+
+private:
+  std::vector<OrderByUnit> order_by_;            ///< 排序列
+  int                      visible_column_num_;  ///< 输出的列数
+  int64_t                  limit_;               ///< 最多需要多少行
+};
@@ -0,0 +1,204 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/sort_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+SortPhysicalOperator::SortPhysicalOperator(
+    const vector<OrderByUnit> &order_by, int visible_column_num, int64_t limit, int64_t memory_limit)
+    : order_by_(order_by), visible_column_num_(visible_column_num), limit_(limit), memory_limit_(memory_limit)
+{}
+
+string SortPhysicalOperator::param() const
+{
+  string param;
+  for (const OrderByUnit &unit : order_by_) {
+    if (!param.empty()) {
+      param += ", ";
+    }
+    param += "#" + to_string(unit.column) + (unit.ascending ? " ASC" : " DESC");
+  }
+  if (limit_ >= 0) {
+    param += ", top " + to_string(limit_);
+  }
+  return param;
+}
+
+void SortPhysicalOperator::serialize_values(const vector<Value> &values, string &payload)
+{
+  for (const Value &value : values) {
+    const int32_t header[2] = {static_cast<int32_t>(value.attr_type()), value.length()};
+    payload.append(reinterpret_cast<const char *>(header), sizeof(header));
+    if (value.attr_type() == AttrType::CHARS) {
+      payload.append(value.data(), value.length());
+      payload.push_back('\0');
+    } else {
+      payload.append(value.data(), value.length());
+    }
+  }
+}
+
+RC SortPhysicalOperator::deserialize_values(const char *payload, int payload_length, vector<Value> &values)
+{
+  values.clear();
+  const char *end = payload + payload_length;
+  while (payload < end) {
+    int32_t header[2];
+    memcpy(header, payload, sizeof(header));
+    payload += sizeof(header);
+
+    const AttrType attr_type = static_cast<AttrType>(header[0]);
+    const int      length    = header[1];
+    switch (attr_type) {
+      case AttrType::CHARS: {
+        values.emplace_back(payload);
+        payload += length + 1;
+      } break;
+      case AttrType::INTS: {
+        int value = 0;
+        memcpy(&value, payload, sizeof(value));
+        values.emplace_back(value);
+        payload += length;
+      } break;
+      case AttrType::FLOATS: {
+        float value = 0;
+        memcpy(&value, payload, sizeof(value));
+        values.emplace_back(value);
+        payload += length;
+      } break;
+      case AttrType::BOOLEANS: {
+        values.emplace_back(payload[0] != 0);
+        payload += length;
+      } break;
+      default: {
+        LOG_WARN("unsupported value type in sort payload: %d", header[0]);
+        return RC::INTERNAL;
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC SortPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "sort operator only support one child, but got %d", children_.size());
+
+  PhysicalOperator &child = *children_[0];
+  RC                rc    = child.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  TupleSchema schema;
+  tuple_schema(schema);
+  vector<TupleCellSpec> specs;
+  for (int i = 0; i < schema.cell_num(); i++) {
+    specs.push_back(schema.cell_at(i));
+  }
+  tuple_.set_names(specs);
+
+  // 读取子算子的全部数据，每行的排序键是规范化后的字节串，负载是需要输出的列
+  sorter_ = make_unique<Sorter>(memory_limit_, limit_);
+  string        key;
+  string        payload;
+  vector<Value> values(visible_column_num_);
+  Value         value;
+  while (OB_SUCC(rc = child.next())) {
+    Tuple *tuple = child.current_tuple();
+    if (nullptr == tuple) {
+      LOG_WARN("failed to get current tuple");
+      return RC::INTERNAL;
+    }
+
+    key.clear();
+    for (const OrderByUnit &unit : order_by_) {
+      rc = tuple->cell_at(unit.column, value);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get sort key. column=%d, rc=%s", unit.column, strrc(rc));
+        return rc;
+      }
+      rc = Sorter::append_key(value.attr_type(), value.data(), value.length(), unit.ascending, key);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    for (int i = 0; i < visible_column_num_; i++) {
+      rc = tuple->cell_at(i, values[i]);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get cell. index=%d, rc=%s", i, strrc(rc));
+        return rc;
+      }
+    }
+    payload.clear();
+    serialize_values(values, payload);
+
+    rc = sorter_->add(key.data(), static_cast<int>(key.size()), payload.data(), static_cast<int>(payload.size()));
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to add row to sorter. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get next tuple from child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = sorter_->sort();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sort. rc=%s", strrc(rc));
+    return rc;
+  }
+  LOG_TRACE("sort operator opened. rows=%ld, runs=%d", sorter_->count(), sorter_->run_num());
+  return RC::SUCCESS;
+}
+
+RC SortPhysicalOperator::next()
+{
+  const char *payload        = nullptr;
+  int         payload_length = 0;
+  RC          rc             = sorter_->next(payload, payload_length);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = deserialize_values(payload, payload_length, values_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  tuple_.set_cells(values_);
+  return RC::SUCCESS;
+}
+
+RC SortPhysicalOperator::close()
+{
+  sorter_.reset();
+  children_[0]->close();
+  return RC::SUCCESS;
+}
+
+RC SortPhysicalOperator::tuple_schema(TupleSchema &schema) const
+{
+  TupleSchema child_schema;
+  RC          rc = children_[0]->tuple_schema(child_schema);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 去掉只用于排序的隐藏列
+  for (int i = 0; i < visible_column_num_ && i < child_schema.cell_num(); i++) {
+    schema.append_cell(child_schema.cell_at(i));
+  }
+  return RC::SUCCESS;
+}
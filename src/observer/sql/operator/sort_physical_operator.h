@@ -0,0 +1,71 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/physical_operator.h"  // 引入物理算子的定义
+#include "sql/operator/sorter.h"             // 引入排序器
+#include "sql/stmt/select_stmt.h"            // 引入OrderByUnit的定义
+
+/**
+ * @brief 排序物理算子
+ * @ingroup PhysicalOperator
+ * @details open 时读取子算子的全部数据交给 Sorter 排序，next 时按顺序输出。
+ * 子算子是投影算子，排序键从投影结果的指定列中取，输出时只保留前面 visible_column_num 列。
+ * 如果上层只需要前 limit 行，Sorter 只保留最小的 limit 行，不需要对全部数据排序。
+ */
+class SortPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param order_by 排序列
+   * @param visible_column_num 输出的列数
+   * @param limit 上层最多需要多少行，小于0表示全部需要
+   * @param memory_limit 排序可以使用的内存大小
+   */
+  SortPhysicalOperator(
+      const std::vector<OrderByUnit> &order_by, int visible_column_num, int64_t limit, int64_t memory_limit);
+  virtual ~SortPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::SORT; }
+  std::string          param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  /// @brief 上层只需要前 limit 行时，排序时只保留最小的 limit 行
+  void push_down_limit(int64_t limit) override
+  {
+    if (limit_ < 0 || limit < limit_) {
+      limit_ = limit;
+    }
+  }
+
+  Tuple *current_tuple() override { return &tuple_; }
+  RC     tuple_schema(TupleSchema &schema) const override;
+
+  /**
+   * @brief 把一行的值序列化到 payload 后面
+   * @details 向量化的排序算子直接拷贝列中的数据，不使用这个格式
+   */
+  static void serialize_values(const std::vector<Value> &values, std::string &payload);
+  static RC   deserialize_values(const char *payload, int payload_length, std::vector<Value> &values);
+
+private:
+  std::vector<OrderByUnit> order_by_;
+  int                      visible_column_num_ = 0;
+  int64_t                  limit_              = -1;
+  int64_t                  memory_limit_       = 0;
+
+  std::unique_ptr<Sorter> sorter_;
+  ValueListTuple          tuple_;   ///< 当前输出的行
+  std::vector<Value>      values_;  ///< 当前输出的行中的值
+};
@@ -0,0 +1,160 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/sort_vec_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+SortVecPhysicalOperator::SortVecPhysicalOperator(
+    const vector<OrderByUnit> &order_by, int visible_column_num, int64_t limit, int64_t memory_limit)
+    : order_by_(order_by), visible_column_num_(visible_column_num), limit_(limit), memory_limit_(memory_limit)
+{}
+
+RC SortVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "sort operator only support one child, but got %d", children_.size());
+
+  PhysicalOperator &child = *children_[0];
+  RC                rc    = child.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  sorter_ = make_unique<Sorter>(memory_limit_, limit_);
+  output_.reset();
+  eof_ = false;
+
+  Chunk chunk;
+  while (OB_SUCC(rc = child.next(chunk))) {
+    rc = add_chunk(chunk);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get next chunk from child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = sorter_->sort();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sort. rc=%s", strrc(rc));
+    return rc;
+  }
+  LOG_TRACE("sort operator opened. rows=%ld, runs=%d", sorter_->count(), sorter_->run_num());
+  return RC::SUCCESS;
+}
+
+RC SortVecPhysicalOperator::add_chunk(Chunk &chunk)
+{
+  if (chunk.column_num() < visible_column_num_) {
+    LOG_WARN("too few columns in child chunk. columns=%d, expect=%d", chunk.column_num(), visible_column_num_);
+    return RC::INTERNAL;
+  }
+
+  if (output_.column_num() == 0) {
+    for (int i = 0; i < visible_column_num_; i++) {
+      const Column &column = chunk.column(i);
+      output_.add_column(make_unique<Column>(column.attr_type(), column.attr_len()), i);
+    }
+  }
+
+  // 常量列只有一个值，所有行共用
+  auto value_at = [](Column &column, int row) {
+    const int index = column.column_type() == Column::Type::CONSTANT_COLUMN ? 0 : row;
+    return column.data() + static_cast<size_t>(index) * column.attr_len();
+  };
+
+  RC     rc = RC::SUCCESS;
+  string key;
+  string payload;
+  for (int row = 0; row < chunk.rows(); row++) {
+    key.clear();
+    for (const OrderByUnit &unit : order_by_) {
+      Column &column = chunk.column(unit.column);
+      rc = Sorter::append_key(column.attr_type(), value_at(column, row), column.attr_len(), unit.ascending, key);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    payload.clear();
+    for (int i = 0; i < visible_column_num_; i++) {
+      Column &column = chunk.column(i);
+      payload.append(value_at(column, row), column.attr_len());
+    }
+
+    rc = sorter_->add(key.data(), static_cast<int>(key.size()), payload.data(), static_cast<int>(payload.size()));
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to add row to sorter. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC SortVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (eof_ || output_.column_num() == 0) {
+    return RC::RECORD_EOF;
+  }
+
+  output_.reset_data();
+  RC rc = RC::SUCCESS;
+  while (output_.rows() < output_.capacity()) {
+    const char *payload        = nullptr;
+    int         payload_length = 0;
+    rc                         = sorter_->next(payload, payload_length);
+    if (rc == RC::RECORD_EOF) {
+      eof_ = true;
+      break;
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get next row from sorter. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    for (int i = 0; i < visible_column_num_; i++) {
+      Column &column = output_.column(i);
+      column.append_one(const_cast<char *>(payload));
+      payload += column.attr_len();
+    }
+  }
+
+  if (output_.rows() == 0) {
+    return RC::RECORD_EOF;
+  }
+  return chunk.reference(output_);
+}
+
+RC SortVecPhysicalOperator::close()
+{
+  sorter_.reset();
+  output_.reset();
+  children_[0]->close();
+  return RC::SUCCESS;
+}
+
+RC SortVecPhysicalOperator::tuple_schema(TupleSchema &schema) const
+{
+  TupleSchema child_schema;
+  RC          rc = children_[0]->tuple_schema(child_schema);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 去掉只用于排序的隐藏列
+  for (int i = 0; i < visible_column_num_ && i < child_schema.cell_num(); i++) {
+    schema.append_cell(child_schema.cell_at(i));
+  }
+  return RC::SUCCESS;
+}
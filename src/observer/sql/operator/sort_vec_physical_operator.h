@@ -0,0 +1,59 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/physical_operator.h"  // 引入物理算子的定义
+#include "sql/operator/sorter.h"             // 引入排序器
+#include "sql/stmt/select_stmt.h"            // 引入OrderByUnit的定义
+
+/**
+ * @brief 排序物理算子（向量化）
+ * @ingroup PhysicalOperator
+ * @details 与 SortPhysicalOperator 相同，只是按列读取子算子的数据，排序键直接从列中的数据编码，
+ * 负载是输出列中定长数据的拼接，输出时再按列拷贝回 Chunk 中。
+ */
+class SortVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  SortVecPhysicalOperator(
+      const std::vector<OrderByUnit> &order_by, int visible_column_num, int64_t limit, int64_t memory_limit);
+  virtual ~SortVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::SORT_VEC; }
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+  /// @brief 上层只需要前 limit 行时，排序时只保留最小的 limit 行
+  void push_down_limit(int64_t limit) override
+  {
+    if (limit_ < 0 || limit < limit_) {
+      limit_ = limit;
+    }
+  }
+
+  RC tuple_schema(TupleSchema &schema) const override;
+
+private:
+  /// @brief 把子算子返回的一批数据交给排序器
+  RC add_chunk(Chunk &chunk);
+
+private:
+  std::vector<OrderByUnit> order_by_;
+  int                      visible_column_num_ = 0;
+  int64_t                  limit_              = -1;
+  int64_t                  memory_limit_       = 0;
+
+  std::unique_ptr<Sorter> sorter_;
+  Chunk                   output_;  ///< 输出的数据，第一次拿到子算子的数据时按照列的类型创建
+  bool                    eof_ = false;
+};
@@ -0,0 +1,449 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sql/operator/sorter.h"
+#include "common/io/io.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/filesystem.h"
+#include "common/log/log.h"
+
+using namespace common;
+
+/// 写临时文件和归并时每个run的读缓冲大小
+static constexpr size_t RUN_BUFFER_SIZE = 64 * 1024;
+
+/// 每条数据前面记录键和负载长度的头部大小
+static constexpr size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+static void append_big_endian(uint32_t value, string &key)
+{
+  const char bytes[4] = {static_cast<char>(value >> 24),
+      static_cast<char>(value >> 16),
+      static_cast<char>(value >> 8),
+      static_cast<char>(value)};
+  key.append(bytes, sizeof(bytes));
+}
+
+Sorter::Sorter(int64_t memory_limit, int64_t limit) : memory_limit_(memory_limit), limit_(limit)
+{
+  use_top_ = limit_ >= 0;
+}
+
+Sorter::~Sorter()
+{
+  for (Run &run : runs_) {
+    if (run.fd >= 0) {
+      ::close(run.fd);
+    }
+  }
+}
+
+RC Sorter::append_key(AttrType attr_type, const char *data, int length, bool ascending, string &key)
+{
+  const size_t start = key.size();
+  switch (attr_type) {
+    case AttrType::INTS: {
+      int32_t value = 0;
+      memcpy(&value, data, sizeof(value));
+      append_big_endian(static_cast<uint32_t>(value) ^ 0x80000000U, key);
+    } break;
+    case AttrType::FLOATS: {
+      float value = 0;
+      memcpy(&value, data, sizeof(value));
+      if (value == 0) {
+        value = 0;  // -0.0 与 0.0 相等
+      }
+      uint32_t bits = 0;
+      memcpy(&bits, &value, sizeof(bits));
+      bits = (bits & 0x80000000U) ? ~bits : (bits ^ 0x80000000U);
+      append_big_endian(bits, key);
+    } break;
+    case AttrType::BOOLEANS: {
+      key.push_back(data[0] != 0 ? 1 : 0);
+    } break;
+    case AttrType::CHARS: {
+      key.append(data, strnlen(data, length));
+      key.push_back('\0');
+    } break;
+    default: {
+      LOG_WARN("unsupported sort key type: %s", attr_type_to_string(attr_type));
+      return RC::UNSUPPORTED;
+    }
+  }
+
+  if (!ascending) {
+    for (size_t i = start; i < key.size(); i++) {
+      key[i] = static_cast<char>(~key[i]);
+    }
+  }
+  return RC::SUCCESS;
+}
+
+uint64_t Sorter::key_prefix(const char *key, int key_length)
+{
+  uint64_t prefix = 0;
+  const int n     = std::min(key_length, static_cast<int>(sizeof(prefix)));
+  for (int i = 0; i < n; i++) {
+    prefix |= static_cast<uint64_t>(static_cast<uint8_t>(key[i])) << (8 * (7 - i));
+  }
+  return prefix;
+}
+
+int Sorter::compare_key(
+    uint64_t left_prefix, const char *left, int left_length, uint64_t right_prefix, const char *right, int right_length)
+{
+  if (left_prefix != right_prefix) {
+    return left_prefix < right_prefix ? -1 : 1;
+  }
+  // 前缀相同时还要比较完整的键，短的键在前缀中补的0可能与长的键中的0相同
+  const int result = memcmp(left, right, std::min(left_length, right_length));
+  if (result != 0) {
+    return result;
+  }
+  return left_length - right_length;
+}
+
+bool Sorter::entry_less(const Entry &left, const Entry &right) const
+{
+  if (left.prefix != right.prefix) {
+    return left.prefix < right.prefix;
+  }
+  const char *left_record  = memory_.data() + left.offset;
+  const char *right_record = memory_.data() + right.offset;
+  return compare_key(left.prefix,
+             record_key(left.offset),
+             record_key_length(left_record),
+             right.prefix,
+             record_key(right.offset),
+             record_key_length(right_record)) < 0;
+}
+
+bool Sorter::run_greater(int left, int right) const
+{
+  const char *left_record  = run_current(runs_[left]);
+  const char *right_record = run_current(runs_[right]);
+  return compare_key(runs_[left].prefix,
+             left_record + RECORD_HEADER_SIZE,
+             record_key_length(left_record),
+             runs_[right].prefix,
+             right_record + RECORD_HEADER_SIZE,
+             record_key_length(right_record)) > 0;
+}
+
+RC Sorter::add(const char *key, int key_length, const char *payload, int payload_length)
+{
+  ASSERT(!sorted_, "cannot add entry after sorted");
+
+  count_++;
+  if (use_top_) {
+    return add_top(key, key_length, payload, payload_length);
+  }
+  return add_memory(key, key_length, payload, payload_length);
+}
+
+RC Sorter::add_memory(const char *key, int key_length, const char *payload, int payload_length)
+{
+  const size_t record_size = RECORD_HEADER_SIZE + key_length + payload_length;
+  const int64_t memory_used =
+      static_cast<int64_t>(memory_.size() + record_size + (entries_.size() + 1) * sizeof(Entry));
+  if (!entries_.empty() && memory_used > memory_limit_) {
+    RC rc = spill();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  const size_t offset = memory_.size();
+  memory_.resize(offset + record_size);
+  char          *record  = memory_.data() + offset;
+  const uint32_t lengths[2] = {static_cast<uint32_t>(key_length), static_cast<uint32_t>(payload_length)};
+  memcpy(record, lengths, RECORD_HEADER_SIZE);
+  memcpy(record + RECORD_HEADER_SIZE, key, key_length);
+  memcpy(record + RECORD_HEADER_SIZE + key_length, payload, payload_length);
+  entries_.push_back(Entry{key_prefix(key, key_length), offset});
+  return RC::SUCCESS;
+}
+
+RC Sorter::add_top(const char *key, int key_length, const char *payload, int payload_length)
+{
+  if (limit_ == 0) {
+    return RC::SUCCESS;
+  }
+
+  auto less = [](const TopEntry &left, const TopEntry &right) {
+    return compare_key(left.prefix, left.data.data(), left.key_length, right.prefix, right.data.data(), right.key_length) <
+           0;
+  };
+
+  const uint64_t prefix = key_prefix(key, key_length);
+  if (static_cast<int64_t>(top_.size()) >= limit_) {
+    // 堆顶是已经保留的数据中最大的，比它大的数据一定不在结果中
+    const TopEntry &max_entry = top_.front();
+    if (compare_key(prefix, key, key_length, max_entry.prefix, max_entry.data.data(), max_entry.key_length) >= 0) {
+      return RC::SUCCESS;
+    }
+    std::pop_heap(top_.begin(), top_.end(), less);
+    top_memory_ -= static_cast<int64_t>(top_.back().data.size() + sizeof(TopEntry));
+    top_.pop_back();
+  }
+
+  TopEntry entry;
+  entry.prefix     = prefix;
+  entry.key_length = key_length;
+  entry.data.reserve(key_length + payload_length);
+  entry.data.append(key, key_length);
+  entry.data.append(payload, payload_length);
+  top_memory_ += static_cast<int64_t>(entry.data.size() + sizeof(TopEntry));
+  top_.push_back(std::move(entry));
+  std::push_heap(top_.begin(), top_.end(), less);
+
+  if (top_memory_ > memory_limit_) {
+    return top_to_memory();
+  }
+  return RC::SUCCESS;
+}
+
+RC Sorter::top_to_memory()
+{
+  LOG_INFO("too many rows to keep in the top-n heap, fall back to external sort. limit=%ld, rows=%ld",
+           limit_, static_cast<int64_t>(top_.size()));
+  use_top_ = false;
+  vector<TopEntry> top;
+  top.swap(top_);
+  top_memory_ = 0;
+  for (const TopEntry &entry : top) {
+    RC rc = add_memory(entry.data.data(),
+        entry.key_length,
+        entry.data.data() + entry.key_length,
+        static_cast<int>(entry.data.size()) - entry.key_length);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void Sorter::sort_memory()
+{
+  std::sort(entries_.begin(), entries_.end(), [this](const Entry &left, const Entry &right) {
+    return entry_less(left, right);
+  });
+  memory_position_ = 0;
+}
+
+RC Sorter::spill()
+{
+  sort_memory();
+
+  // 临时文件创建后马上删除，关闭文件时空间会自动回收
+  string file_name = (filesystem::temp_directory_path() / "miniob_sort_XXXXXX").string();
+  int    fd        = ::mkstemp(file_name.data());
+  if (fd < 0) {
+    LOG_WARN("failed to create sort file. file=%s, errno=%d:%s", file_name.c_str(), errno, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  ::unlink(file_name.c_str());
+
+  // 按照排好的顺序拷贝到连续的缓冲区中，攒够一批再写文件
+  vector<char> write_buffer;
+  write_buffer.reserve(RUN_BUFFER_SIZE);
+  for (const Entry &entry : entries_) {
+    const char *record      = memory_.data() + entry.offset;
+    const size_t record_size = RECORD_HEADER_SIZE + record_key_length(record) + record_payload_length(record);
+    write_buffer.insert(write_buffer.end(), record, record + record_size);
+    if (write_buffer.size() >= RUN_BUFFER_SIZE) {
+      if (writen(fd, write_buffer.data(), static_cast<int>(write_buffer.size())) != 0) {
+        LOG_WARN("failed to write sort file. errno=%d:%s", errno, strerror(errno));
+        ::close(fd);
+        return RC::IOERR_WRITE;
+      }
+      write_buffer.clear();
+    }
+  }
+  if (!write_buffer.empty() && writen(fd, write_buffer.data(), static_cast<int>(write_buffer.size())) != 0) {
+    LOG_WARN("failed to write sort file. errno=%d:%s", errno, strerror(errno));
+    ::close(fd);
+    return RC::IOERR_WRITE;
+  }
+
+  Run run;
+  run.fd = fd;
+  runs_.push_back(std::move(run));
+
+  LOG_DEBUG("spill a sorted run. rows=%ld, bytes=%ld", static_cast<int64_t>(entries_.size()),
+            static_cast<int64_t>(memory_.size()));
+
+  memory_.clear();
+  entries_.clear();
+  return RC::SUCCESS;
+}
+
+RC Sorter::fill_run(Run &run)
+{
+  while (true) {
+    // buffer 中从 position 开始是否有一条完整的数据
+    const size_t available = run.buffer_len - run.position;
+    size_t       need      = RECORD_HEADER_SIZE;
+    if (available >= need) {
+      const char *record = run_current(run);
+      need += record_key_length(record) + record_payload_length(record);
+      if (available >= need) {
+        run.prefix = key_prefix(record + RECORD_HEADER_SIZE, record_key_length(record));
+        return RC::SUCCESS;
+      }
+    }
+
+    if (run.eof) {
+      if (available != 0) {
+        LOG_WARN("sort file is truncated. remain=%ld", static_cast<int64_t>(available));
+        return RC::IOERR_READ;
+      }
+      return RC::SUCCESS;
+    }
+
+    // 把剩下的半条数据挪到 buffer 开头，再从文件中读
+    memmove(run.buffer.data(), run.buffer.data() + run.position, available);
+    run.buffer_len = available;
+    run.position   = 0;
+    if (run.buffer.size() < std::max(RUN_BUFFER_SIZE, need)) {
+      run.buffer.resize(std::max(RUN_BUFFER_SIZE, need));
+    }
+
+    ssize_t read_len = 0;
+    do {
+      read_len = ::read(run.fd, run.buffer.data() + run.buffer_len, run.buffer.size() - run.buffer_len);
+    } while (read_len < 0 && errno == EINTR);
+    if (read_len < 0) {
+      LOG_WARN("failed to read sort file. errno=%d:%s", errno, strerror(errno));
+      return RC::IOERR_READ;
+    }
+    if (read_len == 0) {
+      run.eof = true;
+    }
+    run.buffer_len += read_len;
+  }
+}
+
+RC Sorter::sort()
+{
+  sorted_ = true;
+  if (use_top_) {
+    auto less = [](const TopEntry &left, const TopEntry &right) {
+      return compare_key(
+                 left.prefix, left.data.data(), left.key_length, right.prefix, right.data.data(), right.key_length) < 0;
+    };
+    std::sort_heap(top_.begin(), top_.end(), less);
+    return RC::SUCCESS;
+  }
+
+  if (runs_.empty()) {
+    sort_memory();
+    return RC::SUCCESS;
+  }
+
+  // 数据已经写到文件中了，剩余的数据也写下去，统一做多路归并
+  RC rc = RC::SUCCESS;
+  if (!entries_.empty()) {
+    rc = spill();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  memory_.shrink_to_fit();
+  entries_.shrink_to_fit();
+
+  for (int i = 0; i < static_cast<int>(runs_.size()); i++) {
+    Run &run = runs_[i];
+    if (::lseek(run.fd, 0, SEEK_SET) < 0) {
+      LOG_WARN("failed to seek sort file. errno=%d:%s", errno, strerror(errno));
+      return RC::IOERR_SEEK;
+    }
+    rc = fill_run(run);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (run_valid(run)) {
+      heap_.push_back(i);
+    }
+  }
+
+  auto greater = [this](int left, int right) { return run_greater(left, right); };
+  std::make_heap(heap_.begin(), heap_.end(), greater);
+  LOG_INFO("begin to merge sorted runs. runs=%d, rows=%ld", static_cast<int>(runs_.size()), count_);
+  return RC::SUCCESS;
+}
+
+RC Sorter::next(const char *&payload, int &payload_length)
+{
+  ASSERT(sorted_, "should sort before fetching entries");
+
+  if (limit_ >= 0 && output_count_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+
+  if (use_top_) {
+    if (memory_position_ >= top_.size()) {
+      return RC::RECORD_EOF;
+    }
+    const TopEntry &entry = top_[memory_position_++];
+    payload               = entry.data.data() + entry.key_length;
+    payload_length        = static_cast<int>(entry.data.size()) - entry.key_length;
+    output_count_++;
+    return RC::SUCCESS;
+  }
+
+  if (runs_.empty()) {
+    if (memory_position_ >= entries_.size()) {
+      return RC::RECORD_EOF;
+    }
+    const char *record = memory_.data() + entries_[memory_position_++].offset;
+    payload            = record + RECORD_HEADER_SIZE + record_key_length(record);
+    payload_length     = record_payload_length(record);
+    output_count_++;
+    return RC::SUCCESS;
+  }
+
+  auto greater = [this](int left, int right) { return run_greater(left, right); };
+
+  // 上次返回的数据可能还在被使用，所以直到这次调用时才移动对应的run
+  if (last_run_ >= 0) {
+    Run        &run    = runs_[last_run_];
+    const char *record = run_current(run);
+    run.position += RECORD_HEADER_SIZE + record_key_length(record) + record_payload_length(record);
+    RC rc = fill_run(run);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (run_valid(run)) {
+      heap_.push_back(last_run_);
+      std::push_heap(heap_.begin(), heap_.end(), greater);
+    }
+    last_run_ = -1;
+  }
+
+  if (heap_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  std::pop_heap(heap_.begin(), heap_.end(), greater);
+  last_run_ = heap_.back();
+  heap_.pop_back();
+
+  const char *record = run_current(runs_[last_run_]);
+  payload            = record + RECORD_HEADER_SIZE + record_key_length(record);
+  payload_length     = record_payload_length(record);
+  output_count_++;
+  return RC::SUCCESS;
+}
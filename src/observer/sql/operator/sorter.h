@@ -0,0 +1,149 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/rc.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/type/attr_type.h"
+
+/**
+ * @brief 排序算子使用的排序器
+ * @ingroup PhysicalOperator
+ * @details 每条数据由排序键和负载两部分组成，排序器只看排序键，负载原样返回。
+ * 排序键是规范化之后的字节串(见 append_key)，直接用 memcmp 比较就是最终的顺序，不需要关心类型和升降序。
+ * 内存中的数据紧凑地放在一块连续内存中，排序时只移动 {键的前8个字节, 偏移} 这样的小结构，
+ * 大部分比较只看前8个字节就能得出结果，不需要访问数据本身。
+ * 数据量超过内存限制时，把内存中的数据排好序写到临时文件中(一个run)，最后对所有run做多路归并。
+ * 如果设置了 limit，只需要保留最小的 limit 条数据，使用一个大小为 limit 的大顶堆，
+ * 这个堆超过内存限制时再退化成普通的外部排序。
+ */
+class Sorter
+{
+public:
+  /**
+   * @param memory_limit 内存中最多缓存多少字节的数据
+   * @param limit 最多返回多少条数据，小于0表示不限制
+   */
+  Sorter(int64_t memory_limit, int64_t limit = -1);
+  ~Sorter();
+
+  /**
+   * @brief 把一个值编码成规范化的排序键，追加到 key 后面
+   * @details 多个值依次追加得到的键，按字节比较的结果与逐个按值比较的结果相同。
+   * 整数翻转符号位后按大端存放；浮点数非负时翻转符号位，负数时按位取反；字符串以'\0'结尾；
+   * 降序时把编码后的所有字节取反。
+   */
+  static RC append_key(AttrType attr_type, const char *data, int length, bool ascending, string &key);
+
+  /**
+   * @brief 添加一条数据
+   * @details 只能在 sort 之前调用
+   */
+  RC add(const char *key, int key_length, const char *payload, int payload_length);
+
+  /**
+   * @brief 输入结束，开始排序
+   * @details 如果有数据写到了临时文件，在这里准备多路归并
+   */
+  RC sort();
+
+  /**
+   * @brief 按顺序获取下一条数据的负载
+   * @param[out] payload 返回的数据在下次调用 next 之前有效
+   * @return 没有更多数据时返回 RECORD_EOF
+   */
+  RC next(const char *&payload, int &payload_length);
+
+  /// @brief 一共添加了多少条数据
+  int64_t count() const { return count_; }
+  /// @brief 写了多少个有序run到临时文件中
+  int run_num() const { return static_cast<int>(runs_.size()); }
+
+private:
+  /**
+   * @brief 内存中的一条数据
+   * @details 数据保存在 memory_ 中，格式是 [键长度][负载长度][键][负载]，长度都是4个字节
+   */
+  struct Entry
+  {
+    uint64_t prefix;  ///< 键的前8个字节，按大端转换成整数，不足8个字节的补0
+    size_t   offset;  ///< 数据在 memory_ 中的偏移
+  };
+
+  /**
+   * @brief 使用大顶堆保留最小的 limit 条数据时，堆中的一条数据
+   */
+  struct TopEntry
+  {
+    uint64_t prefix;
+    int      key_length;
+    string   data;  ///< 键和负载
+  };
+
+  /**
+   * @brief 一个写到临时文件中的有序run
+   */
+  struct Run
+  {
+    int          fd        = -1;
+    vector<char> buffer;             ///< 从文件中读到的数据
+    size_t       buffer_len = 0;     ///< buffer 中有效数据的长度
+    size_t       position   = 0;     ///< 当前数据在 buffer 中的偏移
+    bool         eof        = false;  ///< 文件中的数据已经全部读到了 buffer 中
+    uint64_t     prefix     = 0;     ///< 当前数据的键的前8个字节
+  };
+
+  static uint64_t key_prefix(const char *key, int key_length);
+  static int      compare_key(uint64_t left_prefix, const char *left, int left_length, uint64_t right_prefix,
+           const char *right, int right_length);
+
+  const char *record_key(size_t offset) const { return memory_.data() + offset + 2 * sizeof(uint32_t); }
+  int         record_key_length(const char *record) const { return *reinterpret_cast<const uint32_t *>(record); }
+  int         record_payload_length(const char *record) const
+  {
+    return *reinterpret_cast<const uint32_t *>(record + sizeof(uint32_t));
+  }
+  bool entry_less(const Entry &left, const Entry &right) const;
+  /// @brief 比较两个run当前的数据，用于多路归并的小顶堆
+  bool run_greater(int left, int right) const;
+
+  RC   add_memory(const char *key, int key_length, const char *payload, int payload_length);
+  RC   add_top(const char *key, int key_length, const char *payload, int payload_length);
+  /// @brief 堆中的数据太多，放不下了，转成普通的外部排序
+  RC   top_to_memory();
+  void sort_memory();
+  /// @brief 将内存中的数据排好序后写到临时文件
+  RC   spill();
+  /// @brief 确保 run 的 buffer 中有一条完整的数据
+  RC   fill_run(Run &run);
+  bool run_valid(const Run &run) const { return run.position < run.buffer_len; }
+  const char *run_current(const Run &run) const { return run.buffer.data() + run.position; }
+
+private:
+  int64_t memory_limit_ = 0;
+  int64_t limit_        = -1;
+  int64_t count_        = 0;
+  int64_t output_count_ = 0;
+  bool    sorted_       = false;
+
+  vector<char>  memory_;   ///< 内存中缓存的数据
+  vector<Entry> entries_;  ///< 内存中的每条数据
+  size_t        memory_position_ = 0;
+
+  bool             use_top_    = false;  ///< 是否在使用大顶堆保留最小的 limit 条数据
+  vector<TopEntry> top_;
+  int64_t          top_memory_ = 0;
+
+  vector<Run> runs_;
+  vector<int> heap_;           ///< 多路归并使用的小顶堆，元素是 runs_ 的下标
+  int         last_run_ = -1;  ///< 上次 next 返回的数据所属的run，下次 next 时再前进
+};
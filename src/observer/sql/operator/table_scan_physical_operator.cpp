@@ -26,8 +26,20 @@ RC TableScanPhysicalOperator::open(Trx *trx)
   if (rc == RC::SUCCESS) {
     // 设置元组的模式
     tuple_.set_schema(table_, table_->table_meta().field_metas());
+
+    // 简单的比较条件用来根据区域映射跳过页面，返回的记录仍然需要计算所有的条件
+    vector<ColumnPredicate> zone_predicates;
+    for (const unique_ptr<Expression> &expr : predicates_) {
+      ColumnPredicate predicate;
+      if (expr->type() == ExprType::COMPARISON &&
+          static_cast<ComparisonExpr &>(*expr).to_column_predicate(table_->table_meta(), predicate)) {
+        zone_predicates.push_back(std::move(predicate));
+      }
+    }
+    record_scanner_.set_zone_predicates(std::move(zone_predicates));
   }
-  trx_ = trx;  // 保存当前事务
+  trx_     = trx;  // 保存当前事务
+  emitted_ = 0;
   return rc;   // 返回结果代码
 }
 
@@ -37,6 +49,12 @@ RC TableScanPhysicalOperator::next()
   RC   rc            = RC::SUCCESS;  // 初始化结果代码
   bool filter_result = false;        // 过滤结果
 
+  // 上层需要的行已经全部输出，不再访问后面的记录，提前释放当前页面
+  if (limit_ >= 0 && emitted_ >= limit_) {
+    record_scanner_.close_scan();
+    return RC::RECORD_EOF;
+  }
+
   // 迭代获取记录
   while (OB_SUCC(rc = record_scanner_.next(current_record_))) {
     LOG_TRACE("got a record. rid=%s", current_record_.rid().to_string().c_str());
@@ -52,6 +70,7 @@ RC TableScanPhysicalOperator::next()
 
     if (filter_result) {                                         // 如果过滤通过
       sql_debug("get a tuple: %s", tuple_.to_string().c_str());  // 调试日志
+      emitted_++;
       break;                                                     // 结束循环
     } else {
       sql_debug("a tuple is filtered: %s", tuple_.to_string().c_str());  // 被过滤的元组
@@ -71,7 +90,13 @@ Tuple *TableScanPhysicalOperator::current_tuple()
 }
 
 // 返回参数字符串（表名）
-string TableScanPhysicalOperator::param() const { return table_->name(); }
+string TableScanPhysicalOperator::param() const
+{
+  if (limit_ >= 0) {
+    return string(table_->name()) + ", limit=" + to_string(limit_);
+  }
+  return table_->name();
+}
 
 // 设置过滤条件
 void TableScanPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&exprs)
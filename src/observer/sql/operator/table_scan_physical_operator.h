@@ -52,6 +52,9 @@ public:
   // 设置过滤条件
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  // 上层最多需要 limit 行，输出足够的行之后不再读取新的页面
+  void push_down_limit(int64_t limit) override { limit_ = limit; }
+
 private:
   // 根据过滤条件对元组进行过滤
   RC filter(RowTuple &tuple, bool &result);
@@ -64,4 +67,6 @@ private:
   Record                                   current_record_;                     // 当前记录
   RowTuple                                 tuple_;                              // 当前元组
   std::vector<std::unique_ptr<Expression>> predicates_;                         // 过滤条件表达式
+  int64_t                                  limit_   = -1;                       // 最多输出多少行，小于0表示不限制
+  int64_t                                  emitted_ = 0;                        // 已经输出了多少行
 };
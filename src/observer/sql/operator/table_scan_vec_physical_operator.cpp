@@ -21,14 +21,44 @@ RC TableScanVecPhysicalOperator::open(Trx *trx)
     LOG_WARN("failed to get chunk scanner", strrc(rc));
     return rc;
   }
+  if (morsel_iterator_ != nullptr) {
+    chunk_scanner_.set_morsel_iterator(morsel_iterator_);
+  }
+
+  // PAX 格式的页面可以在编码后的数据上直接判断简单的比较条件，剩下的条件在数据块上计算。
+  // 其它格式只用这些条件根据区域映射跳过页面，仍然在数据块上计算所有的条件
+  const TableMeta        &table_meta = table_->table_meta();
+  const bool              pax        = table_meta.storage_format() == StorageFormat::PAX_FORMAT;
+  vector<ColumnPredicate> column_predicates;
+  residual_predicates_.clear();
+  for (const unique_ptr<Expression> &expr : predicates()) {
+    ColumnPredicate column_predicate;
+    const bool      pushed = expr->type() == ExprType::COMPARISON &&
+                        static_cast<ComparisonExpr &>(*expr).to_column_predicate(table_meta, column_predicate);
+    if (pushed) {
+      column_predicates.push_back(std::move(column_predicate));
+    }
+    if (!pushed || !pax) {
+      residual_predicates_.push_back(expr.get());
+    }
+  }
+  if (pax) {
+    chunk_scanner_.set_predicates(std::move(column_predicates));
+  } else {
+    chunk_scanner_.set_zone_predicates(std::move(column_predicates));
+  }
 
+  // 计划缓存中的计划会被反复打开，先清掉上次打开时添加的列
+  all_columns_.reset();
+  filtered_columns_.reset();
   // TODO: 不需要从记录管理器获取所有列
   for (int i = 0; i < table_->table_meta().field_num(); ++i) {
     all_columns_.add_column(
         make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
-    filterd_columns_.add_column(
+    filtered_columns_.add_column(
         make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
   }
+  emitted_ = 0;
   return rc;
 }
 
@@ -36,15 +66,31 @@ RC TableScanVecPhysicalOperator::next(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
 
-  all_columns_.reset_data();      // 重置所有列数据
-  filterd_columns_.reset_data();  // 重置经过过滤的列数据
+  // 上层需要的行已经全部输出，不再读取新的页面
+  if (limit_ >= 0 && emitted_ >= limit_) {
+    chunk_scanner_.close_scan();
+    return RC::RECORD_EOF;
+  }
+
+  all_columns_.reset_data();       // 重置所有列数据
+  filtered_columns_.reset_data();  // 重置经过过滤的列数据
 
   // 获取下一个数据块
   if (OB_SUCC(rc = chunk_scanner_.next_chunk(all_columns_))) {
     select_.assign(all_columns_.rows(), 1);  // 初始化选择位图，默认选择所有行
 
-    if (predicates_.empty()) {
+    const int64_t remain = limit_ >= 0 ? limit_ - emitted_ : INT64_MAX;  // 上层还需要多少行
+    if (residual_predicates_.empty() && all_columns_.rows() <= remain) {
       chunk.reference(all_columns_);  // 如果没有过滤条件，直接引用所有列
+      emitted_ += all_columns_.rows();
+    } else if (residual_predicates_.empty()) {
+      // 最后一批数据，只拷贝上层需要的行
+      for (int j = 0; j < all_columns_.column_num(); j++) {
+        filtered_columns_.column(j).append(
+            all_columns_.column(filtered_columns_.column_ids(j)).data(), static_cast<int>(remain));
+      }
+      chunk.reference(filtered_columns_);
+      emitted_ += remain;
     } else {
       rc = filter(all_columns_);  // 进行过滤
       if (rc != RC::SUCCESS) {
@@ -52,16 +98,17 @@ RC TableScanVecPhysicalOperator::next(Chunk &chunk)
         return rc;
       }
       // TODO: 如果所有条件都设置，不需要逐个设置
-      for (int i = 0; i < all_columns_.rows(); i++) {
+      for (int i = 0; i < all_columns_.rows() && filtered_columns_.rows() < remain; i++) {
         if (select_[i] == 0) {  // 如果当前行没有被选择，跳过
           continue;
         }
         for (int j = 0; j < all_columns_.column_num(); j++) {
-          filterd_columns_.column(j).append_one(
-              (char *)all_columns_.column(filterd_columns_.column_ids(j)).get_value(i).data());
+          filtered_columns_.column(j).append_one(
+              (char *)all_columns_.column(filtered_columns_.column_ids(j)).get_value(i).data());
         }
       }
-      chunk.reference(filterd_columns_);  // 引用经过过滤的列
+      chunk.reference(filtered_columns_);  // 引用经过过滤的列
+      emitted_ += filtered_columns_.rows();
     }
   }
   return rc;
@@ -69,7 +116,13 @@ RC TableScanVecPhysicalOperator::next(Chunk &chunk)
 
 RC TableScanVecPhysicalOperator::close() { return chunk_scanner_.close_scan(); }
 
-string TableScanVecPhysicalOperator::param() const { return table_->name(); }
+string TableScanVecPhysicalOperator::param() const
+{
+  if (limit_ >= 0) {
+    return string(table_->name()) + ", limit=" + to_string(limit_);
+  }
+  return table_->name();
+}
 
 void TableScanVecPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&exprs)
 {
@@ -79,7 +132,7 @@ void TableScanVecPhysicalOperator::set_predicates(vector<unique_ptr<Expression>>
 RC TableScanVecPhysicalOperator::filter(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
-  for (unique_ptr<Expression> &expr : predicates_) {
+  for (Expression *expr : residual_predicates_) {
     rc = expr->eval(chunk, select_);  // 对每个过滤条件进行评估
     if (rc != RC::SUCCESS) {
       return rc;  // 如果评估失败，返回错误
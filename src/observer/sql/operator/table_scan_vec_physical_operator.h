@@ -48,10 +48,29 @@ public:
   // 设置过滤条件
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 使用 owner 的过滤条件
+   * @details 并行扫描同一张表的多个算子使用同一组过滤条件，由其中一个算子持有。表达式求值时不修改表达式，可以并发执行
+   */
+  void share_predicates(const TableScanVecPhysicalOperator &owner) { predicate_owner_ = &owner; }
+
+  /**
+   * @brief 从多个扫描算子共享的迭代器中领取页面，只扫描表的一部分
+   */
+  void set_morsel_iterator(PageMorselIterator *morsel_iterator) { morsel_iterator_ = morsel_iterator; }
+
+  // 上层最多需要 limit 行，最后一批数据只输出剩余的行数，之后不再读取新的页面
+  void push_down_limit(int64_t limit) override { limit_ = limit; }
+
 private:
   // 过滤数据块
   RC filter(Chunk &chunk);
 
+  const std::vector<std::unique_ptr<Expression>> &predicates() const
+  {
+    return predicate_owner_ != nullptr ? predicate_owner_->predicates_ : predicates_;
+  }
+
 private:
   Table                                   *table_ = nullptr;                    // 指向表的指针
   ReadWriteMode                            mode_  = ReadWriteMode::READ_WRITE;  // 读写模式
@@ -60,4 +79,9 @@ private:
   Chunk                                    filtered_columns_;                   // 存储经过过滤的列数据
   std::vector<uint8_t>                     select_;                             // 选择位图
   std::vector<std::unique_ptr<Expression>> predicates_;                         // 过滤条件
+  std::vector<Expression *>                residual_predicates_;                // 没有下推到页面上的过滤条件
+  const TableScanVecPhysicalOperator      *predicate_owner_ = nullptr;          // 过滤条件由这个算子持有
+  PageMorselIterator                      *morsel_iterator_ = nullptr;          // 并行扫描时共享的页面迭代器
+  int64_t                                  limit_   = -1;                       // 最多输出多少行，小于0表示不限制
+  int64_t                                  emitted_ = 0;                        // 已经输出了多少行
 };
@@ -0,0 +1,40 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/vector.h"
+#include "common/value.h"
+#include "sql/operator/logical_operator.h"
+
+class FieldMeta;
+
+/**
+ * @brief 逻辑算子，用于执行update语句
+ * @details 子算子给出要更新的记录，每条记录的 fields 字段被设置为对应的 values
+ * @ingroup LogicalOperator
+ */
+class UpdateLogicalOperator : public LogicalOperator
+{
+public:
+  UpdateLogicalOperator(Table *table, vector<const FieldMeta *> fields, vector<Value> values);
+  virtual ~UpdateLogicalOperator() = default;
+
+  LogicalOperatorType type() const override { return LogicalOperatorType::UPDATE; }
+
+  Table                           *table() const { return table_; }
+  const vector<const FieldMeta *> &fields() const { return fields_; }
+  const vector<Value>             &values() const { return values_; }
+
+private:
+  Table                    *table_ = nullptr;
+  vector<const FieldMeta *> fields_;
+  vector<Value>             values_;
+};
@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/update_physical_operator.h"
+#include "common/log/log.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+RC UpdatePhysicalOperator::open(Trx *trx)
+{
+  if (children_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  unique_ptr<PhysicalOperator> &child = children_[0];
+
+  RC rc = child->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator: %s", strrc(rc));
+    return rc;
+  }
+
+  trx_ = trx;
+
+  while (OB_SUCC(rc = child->next())) {
+    Tuple *tuple = child->current_tuple();
+    if (nullptr == tuple) {
+      LOG_WARN("failed to get current record: %s", strrc(rc));
+      return rc;
+    }
+
+    // 扫描出来的记录可能直接指向页面，更新时页面会发生变化，需要复制一份
+    RowTuple     *row_tuple = static_cast<RowTuple *>(tuple);
+    const Record &record    = row_tuple->record();
+    records_.emplace_back();
+    records_.back().copy_data(record.data(), record.len());
+    records_.back().set_rid(record.rid());
+  }
+
+  child->close();
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to fetch records to update: %s", strrc(rc));
+    return rc;
+  }
+
+  // 在旧数据的基础上设置新值，然后交给事务去更新
+  Record new_record;
+  for (Record &record : records_) {
+    new_record.copy_data(record.data(), record.len());
+    new_record.set_rid(record.rid());
+    for (size_t i = 0; i < fields_.size(); i++) {
+      // 先清空字段，短字符串后面不会留下旧值，没有变化的字段也能判断出来
+      memset(new_record.data() + fields_[i]->offset(), 0, fields_[i]->len());
+      rc = table_->set_value_to_record(new_record.data(), values_[i], fields_[i]);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to set value to record. field=%s, rc=%s", fields_[i]->name(), strrc(rc));
+        return rc;
+      }
+    }
+
+    rc = trx_->update_record(table_, record, new_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to update record: %s", strrc(rc));
+      return rc;
+    }
+    updated_count_++;
+  }
+
+  return RC::SUCCESS;
+}
+
+RC UpdatePhysicalOperator::next() { return RC::RECORD_EOF; }
+
+RC UpdatePhysicalOperator::close()
+{
+  records_.clear();
+  return RC::SUCCESS;
+}
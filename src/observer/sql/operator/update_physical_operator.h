@@ -0,0 +1,54 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/vector.h"
+#include "common/value.h"
+#include "sql/operator/physical_operator.h"
+#include "storage/record/record.h"
+
+class Trx;
+class FieldMeta;
+
+/**
+ * @brief 物理算子，执行更新操作
+ * @ingroup PhysicalOperator
+ * @details 与删除一样，先从子算子中收集所有要更新的记录，再逐条更新，
+ * 避免更新后产生的新版本又被扫描出来。记录如何更新由事务决定，参考 Trx::update_record
+ */
+class UpdatePhysicalOperator : public PhysicalOperator
+{
+public:
+  UpdatePhysicalOperator(Table *table, vector<const FieldMeta *> fields, vector<Value> values)
+      : table_(table), fields_(std::move(fields)), values_(std::move(values))
+  {}
+
+  virtual ~UpdatePhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::UPDATE; }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override { return nullptr; }
+
+  /// 更新的记录条数
+  int updated_count() const { return updated_count_; }
+
+private:
+  Table                    *table_ = nullptr;
+  vector<const FieldMeta *> fields_;
+  vector<Value>             values_;
+  Trx                      *trx_           = nullptr;
+  int                       updated_count_ = 0;
+  vector<Record>            records_;  ///< 待更新的记录
+};
@@ -0,0 +1,343 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <math.h>
+
+#include "sql/optimizer/cost_model.h"
+#include "common/lang/algorithm.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/table_get_logical_operator.h"
+#include "storage/index/index.h"
+#include "storage/table/table.h"
+
+using namespace std;
+
+namespace {
+
+bool is_constant(const Expression &expr) { return expr.type() == ExprType::VALUE || expr.type() == ExprType::PARAM; }
+
+/// 把 value op field 转换成 field op' value
+CompOp mirror(CompOp op)
+{
+  switch (op) {
+    case LESS_THAN: return GREAT_THAN;
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    default: return op;
+  }
+}
+
+double default_selectivity(CompOp op)
+{
+  switch (op) {
+    case EQUAL_TO: return CostModel::DEFAULT_EQUAL_SELECTIVITY;
+    case NOT_EQUAL: return 1.0 - CostModel::DEFAULT_EQUAL_SELECTIVITY;
+    default: return CostModel::DEFAULT_RANGE_SELECTIVITY;
+  }
+}
+
+/// 字段的NDV，没有统计信息时返回0
+int64_t field_ndv(const FieldExpr &field_expr)
+{
+  const Table *table = field_expr.field().table();
+  if (table == nullptr) {
+    return 0;
+  }
+  shared_ptr<const TableStatistics> statistics = table->statistics();
+  const ColumnStatistics *column = statistics == nullptr ? nullptr : statistics->column(field_expr.field_name());
+  return column == nullptr ? 0 : column->ndv;
+}
+
+double comparison_selectivity(ComparisonExpr &comparison)
+{
+  CompOp      op    = comparison.comp();
+  Expression *left  = comparison.left().get();
+  Expression *right = comparison.right().get();
+  if (left->type() != ExprType::FIELD && right->type() == ExprType::FIELD) {
+    std::swap(left, right);
+    op = mirror(op);
+  }
+  if (left->type() != ExprType::FIELD) {
+    return default_selectivity(op);
+  }
+
+  auto *field_expr = static_cast<FieldExpr *>(left);
+  if (right->type() == ExprType::FIELD) {
+    // 连接条件 a.x = b.y，认为值少的一边的每个值都能在另一边找到
+    const int64_t ndv = max(field_ndv(*field_expr), field_ndv(*static_cast<FieldExpr *>(right)));
+    return (op == EQUAL_TO && ndv > 0) ? 1.0 / ndv : default_selectivity(op);
+  }
+
+  if (right->type() == ExprType::PARAM) {
+    // 参数的值每次执行时都可能不同，计划不能依赖某个具体的值
+    const int64_t ndv = field_ndv(*field_expr);
+    if (ndv > 0 && (op == EQUAL_TO || op == NOT_EQUAL)) {
+      return op == EQUAL_TO ? 1.0 / ndv : 1.0 - 1.0 / ndv;
+    }
+    return default_selectivity(op);
+  }
+
+  Value value;
+  if (right->type() != ExprType::VALUE || OB_FAIL(right->try_get_value(value))) {
+    return default_selectivity(op);
+  }
+
+  const Table *table = field_expr->field().table();
+  shared_ptr<const TableStatistics> statistics = table == nullptr ? nullptr : table->statistics();
+  const ColumnStatistics *column = statistics == nullptr ? nullptr : statistics->column(field_expr->field_name());
+  const double result = column == nullptr ? -1 : column->selectivity(op, value);
+  return result < 0 ? default_selectivity(op) : result;
+}
+
+/// 使用索引查找一次的代价，不包含读取记录
+double index_lookup_cost(const Index &index, double table_rows)
+{
+  if (index.index_meta().type() == IndexType::HASH) {
+    return CostModel::RANDOM_PAGE_COST;
+  }
+  const double height = 1 + ceil(log(max(table_rows, 1.0)) / log(CostModel::BPLUS_TREE_FANOUT));
+  return height * CostModel::RANDOM_PAGE_COST;
+}
+
+}  // namespace
+
+bool CostModel::is_field_equal_constant(Expression &predicate, FieldExpr *&field_expr, Expression *&value_expr)
+{
+  if (predicate.type() != ExprType::COMPARISON) {
+    return false;
+  }
+  auto *comparison = static_cast<ComparisonExpr *>(&predicate);
+  if (comparison->comp() != EQUAL_TO) {
+    return false;
+  }
+
+  Expression *left  = comparison->left().get();
+  Expression *right = comparison->right().get();
+  if (left->type() == ExprType::FIELD && is_constant(*right)) {
+    field_expr = static_cast<FieldExpr *>(left);
+    value_expr = right;
+    return true;
+  }
+  if (right->type() == ExprType::FIELD && is_constant(*left)) {
+    field_expr = static_cast<FieldExpr *>(right);
+    value_expr = left;
+    return true;
+  }
+  return false;
+}
+
+bool CostModel::is_equi_join_condition(Expression &predicate, const unordered_set<const Table *> &left_tables,
+    const unordered_set<const Table *> &right_tables, FieldExpr *&left_field, FieldExpr *&right_field)
+{
+  if (predicate.type() != ExprType::COMPARISON) {
+    return false;
+  }
+  auto *comparison = static_cast<ComparisonExpr *>(&predicate);
+  if (comparison->comp() != EQUAL_TO || comparison->left()->type() != ExprType::FIELD ||
+      comparison->right()->type() != ExprType::FIELD) {
+    return false;
+  }
+
+  auto *first  = static_cast<FieldExpr *>(comparison->left().get());
+  auto *second = static_cast<FieldExpr *>(comparison->right().get());
+  if (first->value_type() != second->value_type()) {
+    return false;  // 类型不同时相等的值可能有不同的哈希键
+  }
+  if (left_tables.count(second->field().table()) > 0 && right_tables.count(first->field().table()) > 0) {
+    std::swap(first, second);
+  }
+  if (left_tables.count(first->field().table()) == 0 || right_tables.count(second->field().table()) == 0) {
+    return false;
+  }
+  left_field  = first;
+  right_field = second;
+  return true;
+}
+
+void CostModel::collect_tables(LogicalOperator &oper, unordered_set<const Table *> &tables)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    tables.insert(static_cast<TableGetLogicalOperator &>(oper).table());
+  }
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    collect_tables(*child, tables);
+  }
+}
+
+PlanCost CostModel::join_cost(const PlanCost &left, const PlanCost &right, bool hash_join, double selectivity)
+{
+  PlanCost result;
+  result.rows = left.rows * right.rows * selectivity;
+  if (hash_join) {
+    // 两边各执行一次，右边的每一行放到哈希表中，左边的每一行查找一次哈希表，再检查找到的每一行
+    result.cost = left.cost + right.cost + right.rows * CPU_TUPLE_COST + left.rows * CPU_OPERATOR_COST +
+                  result.rows * CPU_OPERATOR_COST;
+  } else {
+    // 嵌套循环连接，左边的每一行都要完整地执行一遍右边，每一对行都要计算一次连接条件
+    result.cost = left.cost + max(left.rows, 1.0) * right.cost + left.rows * right.rows * CPU_OPERATOR_COST;
+  }
+  result.cost += result.rows * CPU_TUPLE_COST;
+  return result;
+}
+
+double CostModel::selectivity(Expression &predicate)
+{
+  switch (predicate.type()) {
+    case ExprType::CONJUNCTION: {
+      auto  &conjunction = static_cast<ConjunctionExpr &>(predicate);
+      double result      = 1.0;
+      if (conjunction.conjunction_type() == ConjunctionExpr::Type::AND) {
+        for (unique_ptr<Expression> &child : conjunction.children()) {
+          result *= selectivity(*child);
+        }
+        return result;
+      }
+      // 假设各个条件相互独立
+      for (unique_ptr<Expression> &child : conjunction.children()) {
+        result *= 1.0 - selectivity(*child);
+      }
+      return 1.0 - result;
+    }
+
+    case ExprType::COMPARISON: {
+      return comparison_selectivity(static_cast<ComparisonExpr &>(predicate));
+    }
+
+    case ExprType::VALUE: {
+      // 常量条件在改写阶段已经计算成了 true/false
+      Value value;
+      if (OB_SUCC(predicate.try_get_value(value)) && value.attr_type() == AttrType::BOOLEANS) {
+        return value.get_boolean() ? 1.0 : 0.0;
+      }
+      return DEFAULT_RANGE_SELECTIVITY;
+    }
+
+    default: {
+      return DEFAULT_RANGE_SELECTIVITY;
+    }
+  }
+}
+
+bool CostModel::choose_access_path(TableGetLogicalOperator &table_get, AccessPath &path)
+{
+  Table                            *table      = table_get.table();
+  shared_ptr<const TableStatistics> statistics = table->statistics();
+  if (statistics == nullptr) {
+    return false;
+  }
+
+  // 统计信息收集之后表可能又有变化，页面数按照行数等比例估算
+  const double table_rows = static_cast<double>(max<int64_t>(table->estimated_row_count(), 0));
+  double       pages      = static_cast<double>(statistics->page_count);
+  if (statistics->row_count > 0) {
+    pages = pages * table_rows / statistics->row_count;
+  }
+  pages = max(pages, 1.0);
+
+  vector<unique_ptr<Expression>> &predicates    = table_get.predicates();
+  const double                    predicate_num = static_cast<double>(predicates.size());
+
+  double result_selectivity = 1.0;
+  for (unique_ptr<Expression> &predicate : predicates) {
+    result_selectivity *= selectivity(*predicate);
+  }
+
+  path.index      = nullptr;
+  path.value_expr = nullptr;
+  path.cost.rows  = table_rows * result_selectivity;
+  path.cost.cost  = pages * SEQ_PAGE_COST + table_rows * (CPU_TUPLE_COST + predicate_num * CPU_OPERATOR_COST);
+
+  for (unique_ptr<Expression> &predicate : predicates) {
+    FieldExpr  *field_expr = nullptr;
+    Expression *value_expr = nullptr;
+    if (!is_field_equal_constant(*predicate, field_expr, value_expr)) {
+      continue;
+    }
+    Index *index = table->find_equality_index(field_expr->field_name());
+    if (index == nullptr) {
+      continue;
+    }
+
+    // 索引查找到的每一行都要随机读取一次记录，再计算其它的谓词
+    const double matched_rows = table_rows * selectivity(*predicate);
+    const double cost         = index_lookup_cost(*index, table_rows) +
+                        matched_rows * (RANDOM_PAGE_COST + CPU_TUPLE_COST + predicate_num * CPU_OPERATOR_COST);
+    if (cost < path.cost.cost) {
+      path.index      = index;
+      path.value_expr = value_expr;
+      path.cost.cost  = cost;
+    }
+  }
+  return true;
+}
+
+bool CostModel::estimate(LogicalOperator &oper, PlanCost &cost)
+{
+  vector<unique_ptr<LogicalOperator>> &children = oper.children();
+  switch (oper.type()) {
+    case LogicalOperatorType::TABLE_GET: {
+      AccessPath path;
+      if (!choose_access_path(static_cast<TableGetLogicalOperator &>(oper), path)) {
+        return false;
+      }
+      cost = path.cost;
+      return true;
+    }
+
+    case LogicalOperatorType::JOIN: {
+      PlanCost left;
+      PlanCost right;
+      if (children.size() != 2 || !estimate(*children[0], left) || !estimate(*children[1], right)) {
+        return false;
+      }
+
+      // 与生成物理计划时的规则相同，有等值连接条件时使用哈希连接
+      unordered_set<const Table *> left_tables;
+      unordered_set<const Table *> right_tables;
+      collect_tables(*children[0], left_tables);
+      collect_tables(*children[1], right_tables);
+
+      bool   hash_join          = false;
+      double result_selectivity = 1.0;
+      for (unique_ptr<Expression> &expr : oper.expressions()) {
+        FieldExpr *left_field  = nullptr;
+        FieldExpr *right_field = nullptr;
+        if (is_equi_join_condition(*expr, left_tables, right_tables, left_field, right_field)) {
+          hash_join = true;
+        }
+        result_selectivity *= selectivity(*expr);
+      }
+      cost = join_cost(left, right, hash_join, result_selectivity);
+      return true;
+    }
+
+    case LogicalOperatorType::PREDICATE: {
+      if (children.size() != 1 || !estimate(*children[0], cost)) {
+        return false;
+      }
+      const double input_rows = cost.rows;
+      for (unique_ptr<Expression> &expr : oper.expressions()) {
+        cost.rows *= selectivity(*expr);
+      }
+      cost.cost += input_rows * CPU_OPERATOR_COST;
+      return true;
+    }
+
+    default: {
+      // 其它算子不改变行数，只增加处理每一行的代价
+      if (children.size() != 1 || !estimate(*children[0], cost)) {
+        return false;
+      }
+      cost.cost += cost.rows * CPU_TUPLE_COST;
+      return true;
+    }
+  }
+}
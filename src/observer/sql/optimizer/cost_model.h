@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/unordered_set.h"
+#include "sql/operator/logical_operator.h"
+
+class Expression;
+class FieldExpr;
+class Index;
+class Table;
+class TableGetLogicalOperator;
+
+/**
+ * @brief 估算的执行代价
+ * @ingroup SQLOptimizer
+ */
+struct PlanCost
+{
+  double rows = 0;  ///< 输出的行数
+  double cost = 0;  ///< 执行代价，以顺序读取一个页面的代价为单位
+};
+
+/**
+ * @brief 访问一张表的方式
+ * @ingroup SQLOptimizer
+ */
+struct AccessPath
+{
+  Index      *index      = nullptr;  ///< 使用的索引，为空时全表扫描
+  Expression *value_expr = nullptr;  ///< 使用索引做等值查找时的值
+  PlanCost    cost;
+};
+
+/**
+ * @brief 根据统计信息估算执行代价
+ * @ingroup SQLOptimizer
+ * @details 代价由读取页面的代价和处理每行数据的CPU代价组成，常量的取值参考了 PostgreSQL。
+ * 谓词的选择率优先使用 ANALYZE TABLE 收集的直方图和NDV，没有统计信息的表无法估算代价，
+ * 调用者需要退回到基于规则的选择。
+ */
+class CostModel
+{
+public:
+  static constexpr double SEQ_PAGE_COST     = 1.0;     ///< 顺序读取一个页面
+  static constexpr double RANDOM_PAGE_COST  = 4.0;     ///< 随机读取一个页面
+  static constexpr double CPU_TUPLE_COST    = 0.01;    ///< 处理一行数据
+  static constexpr double CPU_OPERATOR_COST = 0.0025;  ///< 计算一次表达式
+
+  static constexpr double DEFAULT_EQUAL_SELECTIVITY = 0.1;        ///< 无法估算时等值条件的选择率
+  static constexpr double DEFAULT_RANGE_SELECTIVITY = 1.0 / 3.0;  ///< 无法估算时范围条件的选择率
+  static constexpr double BPLUS_TREE_FANOUT         = 100;        ///< 估算B+树高度时使用的扇出
+
+  /**
+   * @brief 估算逻辑计划的输出行数和执行代价
+   * @return 计划中有表没有统计信息时返回false
+   */
+  static bool estimate(LogicalOperator &oper, PlanCost &cost);
+
+  /**
+   * @brief 在全表扫描和可用的索引中选择代价最小的访问方式
+   * @return 表没有统计信息时返回false
+   */
+  static bool choose_access_path(TableGetLogicalOperator &table_get, AccessPath &path);
+
+  /**
+   * @brief 估算谓词的选择率，即满足条件的行所占的比例
+   */
+  static double selectivity(Expression &predicate);
+
+  /**
+   * @brief 判断谓词是不是 字段 = 常量(或参数) 的形式，这种谓词可以使用索引做等值查找
+   */
+  static bool is_field_equal_constant(Expression &predicate, FieldExpr *&field_expr, Expression *&value_expr);
+
+  /**
+   * @brief 估算两个输入连接之后的行数和代价
+   * @param hash_join 是否使用哈希连接。哈希连接使用右边的输入构建哈希表，否则使用嵌套循环连接
+   * @param selectivity 连接条件的选择率
+   */
+  static PlanCost join_cost(const PlanCost &left, const PlanCost &right, bool hash_join, double selectivity);
+
+  /**
+   * @brief 判断连接条件是不是 左边的字段 = 右边的字段 的形式，并且两个字段的类型相同，这种条件可以做哈希连接
+   * @param left_tables 连接左边的所有表
+   * @param right_tables 连接右边的所有表
+   * @param[out] left_field 来自左边的字段
+   * @param[out] right_field 来自右边的字段
+   */
+  static bool is_equi_join_condition(Expression &predicate, const unordered_set<const Table *> &left_tables,
+      const unordered_set<const Table *> &right_tables, FieldExpr *&left_field, FieldExpr *&right_field);
+
+  /**
+   * @brief 收集逻辑计划中访问的所有表
+   */
+  static void collect_tables(LogicalOperator &oper, unordered_set<const Table *> &tables);
+};
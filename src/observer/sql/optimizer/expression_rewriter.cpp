@@ -92,7 +92,8 @@ RC ExpressionRewriter::rewrite_expression(unique_ptr<Expression> &expr, bool &ch
   // 根据表达式的类型进行不同的处理
   switch (expr->type()) {
     case ExprType::FIELD:  // 字段类型，不需要处理
-    case ExprType::VALUE: {  // 值类型，不需要处理
+    case ExprType::VALUE:    // 值类型，不需要处理
+    case ExprType::PARAM: {  // 参数类型，不需要处理
       // do nothing
     } break;
 
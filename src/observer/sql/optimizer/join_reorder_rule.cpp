@@ -0,0 +1,463 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <bit>
+
+#include "sql/optimizer/join_reorder_rule.h"
+#include "common/lang/unordered_map.h"
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/expression_iterator.h"
+#include "sql/operator/join_logical_operator.h"
+#include "sql/operator/predicate_logical_operator.h"
+#include "sql/operator/table_get_logical_operator.h"
+#include "sql/optimizer/cost_model.h"
+#include "sql/optimizer/predicate_pushdown_rewriter.h"
+
+using namespace std;
+
+namespace {
+
+/// 连接的一个输入，通常就是一张表
+struct JoinInput
+{
+  unique_ptr<LogicalOperator> oper;
+  PlanCost                    cost;
+};
+
+/// 从 where 中拆分出来的一个条件
+struct JoinCondition
+{
+  unique_ptr<Expression> expr;
+  uint64_t               inputs      = 0;      ///< 条件中引用到的输入，为0表示与表无关的常量条件
+  double                 selectivity = 1.0;    ///< 条件的选择率
+  bool                   equi_join   = false;  ///< 是否是两个输入的字段相等的条件，这种条件可以做哈希连接
+};
+
+/// 一组输入连接起来的计划，记录最后一次连接的左右两边
+struct JoinPlan
+{
+  PlanCost cost;
+  uint64_t left  = 0;
+  uint64_t right = 0;
+};
+
+/**
+ * @brief 为一棵连接树枚举连接的顺序
+ * @details 用 uint64_t 中的每一位表示一个输入，一组输入就是一个位图
+ */
+class JoinEnumerator
+{
+public:
+  /// 展开连接树，连接算子上已有的条件也拆出来重新放置
+  void add_inputs(unique_ptr<LogicalOperator> &oper)
+  {
+    if (oper->type() == LogicalOperatorType::JOIN) {
+      for (unique_ptr<Expression> &expr : oper->expressions()) {
+        add_condition(std::move(expr));
+      }
+      for (unique_ptr<LogicalOperator> &child : oper->children()) {
+        add_inputs(child);
+      }
+      return;
+    }
+
+    JoinInput input;
+    input.oper = std::move(oper);
+    inputs_.emplace_back(std::move(input));
+  }
+
+  /// 添加一个条件，AND 连接的多个条件会拆开
+  void add_condition(unique_ptr<Expression> expr)
+  {
+    if (expr->type() == ExprType::CONJUNCTION &&
+        static_cast<ConjunctionExpr &>(*expr).conjunction_type() == ConjunctionExpr::Type::AND) {
+      for (unique_ptr<Expression> &child : static_cast<ConjunctionExpr &>(*expr).children()) {
+        add_condition(std::move(child));
+      }
+      return;
+    }
+
+    JoinCondition condition;
+    condition.expr = std::move(expr);
+    conditions_.emplace_back(std::move(condition));
+  }
+
+  /// 确定每个条件引用的输入，下推单个输入的条件，估算每个输入的行数
+  RC init()
+  {
+    const int input_num = static_cast<int>(inputs_.size());
+    full_set_           = input_num >= 64 ? ~0ULL : (1ULL << input_num) - 1;
+
+    for (int i = 0; i < input_num; i++) {
+      unordered_set<const Table *> tables;
+      CostModel::collect_tables(*inputs_[i].oper, tables);
+      for (const Table *table : tables) {
+        if (!table_inputs_.emplace(table, i).second) {
+          ambiguous_ = true;  // 同一张表出现了多次，无法区分条件中的字段属于哪个输入
+        }
+      }
+    }
+
+    vector<vector<unique_ptr<Expression>>> local_conditions(input_num);
+    for (JoinCondition &condition : conditions_) {
+      bool unknown     = false;
+      condition.inputs = referenced_inputs(*condition.expr, unknown);
+      if (unknown || ambiguous_) {
+        condition.inputs = full_set_;  // 放在最上面的连接上计算
+      }
+
+      if (condition.inputs != 0 && std::popcount(condition.inputs) == 1) {
+        local_conditions[std::countr_zero(condition.inputs)].emplace_back(std::move(condition.expr));
+        continue;
+      }
+
+      condition.selectivity = CostModel::selectivity(*condition.expr);
+      condition.equi_join   = std::popcount(condition.inputs) == 2 && is_equi_join(*condition.expr);
+    }
+
+    for (int i = 0; i < input_num; i++) {
+      push_down(inputs_[i].oper, local_conditions[i]);
+      if (!CostModel::estimate(*inputs_[i].oper, inputs_[i].cost)) {
+        has_statistics_ = false;
+      }
+    }
+    return RC::SUCCESS;
+  }
+
+  /// 选择连接的顺序
+  void enumerate()
+  {
+    const int input_num = static_cast<int>(inputs_.size());
+    for (int i = 0; i < input_num; i++) {
+      plans_[1ULL << i].cost = inputs_[i].cost;
+    }
+
+    if (!has_statistics_ || ambiguous_) {
+      LOG_TRACE("keep join order in from clause. statistics=%d, ambiguous=%d", has_statistics_, ambiguous_);
+      enumerate_in_order();
+    } else if (input_num <= JoinReorderRule::DP_INPUT_LIMIT) {
+      enumerate_dp();
+    } else {
+      enumerate_greedy();
+    }
+    LOG_TRACE("join order chosen. inputs=%d, rows=%.1f, cost=%.2f",
+              input_num, plans_[full_set_].cost.rows, plans_[full_set_].cost.cost);
+  }
+
+  /**
+   * @brief 按照选择的顺序生成新的连接树
+   * @param[out] residual 与表无关的条件，由调用者放到连接树的上面
+   */
+  unique_ptr<LogicalOperator> build(vector<unique_ptr<Expression>> &residual)
+  {
+    unique_ptr<LogicalOperator> result = build(full_set_);
+    for (JoinCondition &condition : conditions_) {
+      if (condition.expr != nullptr) {
+        residual.emplace_back(std::move(condition.expr));
+      }
+    }
+    return result;
+  }
+
+private:
+  /// 条件中引用了哪些输入。引用了不在连接树中的表时 unknown 设置为 true
+  uint64_t referenced_inputs(Expression &expr, bool &unknown)
+  {
+    if (expr.type() == ExprType::FIELD) {
+      auto iter = table_inputs_.find(static_cast<FieldExpr &>(expr).field().table());
+      if (iter == table_inputs_.end()) {
+        unknown = true;
+        return 0;
+      }
+      return 1ULL << iter->second;
+    }
+
+    uint64_t inputs = 0;
+    ExpressionIterator::iterate_child_expr(expr, [this, &inputs, &unknown](unique_ptr<Expression> &child) {
+      inputs |= referenced_inputs(*child, unknown);
+      return RC::SUCCESS;
+    });
+    return inputs;
+  }
+
+  /// 字段 = 字段，并且两边的类型相同。与 CostModel::is_equi_join_condition 的判断保持一致
+  static bool is_equi_join(Expression &expr)
+  {
+    if (expr.type() != ExprType::COMPARISON) {
+      return false;
+    }
+    auto &comparison = static_cast<ComparisonExpr &>(expr);
+    return comparison.comp() == EQUAL_TO && comparison.left()->type() == ExprType::FIELD &&
+           comparison.right()->type() == ExprType::FIELD &&
+           comparison.left()->value_type() == comparison.right()->value_type();
+  }
+
+  /**
+   * @brief 把单个输入的条件放到这个输入上
+   * @details 简单的比较条件直接交给 table get 算子，其它的条件在输入上面加一个过滤算子
+   */
+  static void push_down(unique_ptr<LogicalOperator> &oper, vector<unique_ptr<Expression>> &conditions)
+  {
+    if (conditions.empty()) {
+      return;
+    }
+
+    vector<unique_ptr<Expression>> remains;
+    if (oper->type() == LogicalOperatorType::TABLE_GET) {
+      vector<unique_ptr<Expression>> &predicates = static_cast<TableGetLogicalOperator &>(*oper).predicates();
+      for (unique_ptr<Expression> &condition : conditions) {
+        if (PredicatePushdownRewriter::can_pushdown(*condition)) {
+          predicates.emplace_back(std::move(condition));
+        } else {
+          remains.emplace_back(std::move(condition));
+        }
+      }
+    } else {
+      remains = std::move(conditions);
+    }
+
+    if (remains.empty()) {
+      return;
+    }
+
+    unique_ptr<Expression> predicate;
+    if (remains.size() == 1) {
+      predicate = std::move(remains.front());
+    } else {
+      predicate = make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, remains);
+    }
+    auto predicate_oper = make_unique<PredicateLogicalOperator>(std::move(predicate));
+    predicate_oper->add_child(std::move(oper));
+    oper = std::move(predicate_oper);
+  }
+
+  /**
+   * @brief 估算连接 left 和 right 两组输入的代价
+   * @param[out] connected 两组输入之间是否有连接条件，没有时就是笛卡尔积
+   */
+  JoinPlan join(uint64_t left, uint64_t right, bool &connected)
+  {
+    const uint64_t all         = left | right;
+    double         selectivity = 1.0;
+    bool           hash_join   = false;
+    connected                  = false;
+    for (const JoinCondition &condition : conditions_) {
+      // 只考虑在这一次连接时才能计算的条件
+      if (condition.expr == nullptr || (condition.inputs & ~all) != 0 || (condition.inputs & left) == 0 ||
+          (condition.inputs & right) == 0) {
+        continue;
+      }
+      connected = true;
+      selectivity *= condition.selectivity;
+      hash_join = hash_join || condition.equi_join;
+    }
+
+    JoinPlan plan;
+    plan.cost  = CostModel::join_cost(plans_[left].cost, plans_[right].cost, hash_join, selectivity);
+    plan.left  = left;
+    plan.right = right;
+    return plan;
+  }
+
+  /// 保持输入原来的顺序，生成左深树
+  void enumerate_in_order()
+  {
+    uint64_t current = 1;
+    for (size_t i = 1; i < inputs_.size(); i++) {
+      bool           connected = false;
+      const uint64_t next      = 1ULL << i;
+      plans_[current | next]   = join(current, next, connected);
+      current |= next;
+    }
+  }
+
+  /// 按照从小到大的顺序枚举所有的集合，一个集合的所有子集一定在它之前处理过
+  void enumerate_dp()
+  {
+    for (uint64_t set = 1; set <= full_set_; set++) {
+      if (std::popcount(set) == 1) {
+        continue;
+      }
+
+      JoinPlan best;
+      JoinPlan best_cross;  // 没有连接条件的划分只在没有其它选择时使用
+      bool     found       = false;
+      bool     found_cross = false;
+      for (uint64_t left = (set - 1) & set; left > 0; left = (left - 1) & set) {
+        bool           connected = false;
+        const JoinPlan plan      = join(left, set ^ left, connected);
+        if (connected) {
+          if (!found || plan.cost.cost < best.cost.cost) {
+            best  = plan;
+            found = true;
+          }
+        } else if (!found_cross || plan.cost.cost < best_cross.cost.cost) {
+          best_cross  = plan;
+          found_cross = true;
+        }
+      }
+      plans_[set] = found ? best : best_cross;
+    }
+  }
+
+  /// 从行数最少的输入开始，每次加入一个代价最小的输入，两个输入都可以作为哈希连接的构建侧
+  void enumerate_greedy()
+  {
+    const int input_num = static_cast<int>(inputs_.size());
+    int       first     = 0;
+    for (int i = 1; i < input_num; i++) {
+      if (inputs_[i].cost.rows < inputs_[first].cost.rows) {
+        first = i;
+      }
+    }
+
+    uint64_t current = 1ULL << first;
+    while (current != full_set_) {
+      JoinPlan best;
+      bool     best_connected = false;
+      bool     found          = false;
+      for (int i = 0; i < input_num; i++) {
+        const uint64_t next = 1ULL << i;
+        if ((current & next) != 0) {
+          continue;
+        }
+
+        for (const bool next_on_right : {true, false}) {
+          bool           connected = false;
+          const JoinPlan plan = next_on_right ? join(current, next, connected) : join(next, current, connected);
+          // 有连接条件的输入优先于笛卡尔积
+          if (!found || (connected && !best_connected) ||
+              (connected == best_connected && plan.cost.cost < best.cost.cost)) {
+            best           = plan;
+            best_connected = connected;
+            found          = true;
+          }
+        }
+      }
+
+      current         = best.left | best.right;
+      plans_[current] = best;
+    }
+  }
+
+  unique_ptr<LogicalOperator> build(uint64_t set)
+  {
+    if (std::popcount(set) == 1) {
+      return std::move(inputs_[std::countr_zero(set)].oper);
+    }
+
+    const JoinPlan &plan      = plans_[set];
+    auto            join_oper = make_unique<JoinLogicalOperator>();
+    join_oper->add_child(build(plan.left));
+    join_oper->add_child(build(plan.right));
+
+    // 子树中的条件已经放到下面了，剩下的就是在这一层才能计算的条件
+    for (JoinCondition &condition : conditions_) {
+      if (condition.expr != nullptr && condition.inputs != 0 && (condition.inputs & ~set) == 0) {
+        join_oper->expressions().emplace_back(std::move(condition.expr));
+      }
+    }
+    return join_oper;
+  }
+
+private:
+  vector<JoinInput>                 inputs_;
+  vector<JoinCondition>             conditions_;
+  unordered_map<const Table *, int> table_inputs_;  ///< 表在哪个输入中
+  unordered_map<uint64_t, JoinPlan> plans_;         ///< 每组输入的最优计划
+  uint64_t                          full_set_       = 0;
+  bool                              has_statistics_ = true;
+  bool                              ambiguous_      = false;
+};
+
+int join_input_num(LogicalOperator &oper)
+{
+  if (oper.type() != LogicalOperatorType::JOIN) {
+    return 1;
+  }
+  int num = 0;
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    num += join_input_num(*child);
+  }
+  return num;
+}
+
+}  // namespace
+
+RC JoinReorderRule::rewrite(unique_ptr<LogicalOperator> &oper, bool &change_made)
+{
+  vector<unique_ptr<LogicalOperator>> &children = oper->children();
+  const bool predicate_on_join = oper->type() == LogicalOperatorType::PREDICATE && children.size() == 1 &&
+                                 children.front()->type() == LogicalOperatorType::JOIN;
+  if (predicate_on_join || oper->type() == LogicalOperatorType::JOIN) {
+    return reorder(oper, change_made);
+  }
+
+  for (unique_ptr<LogicalOperator> &child : children) {
+    RC rc = rewrite(child, change_made);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC JoinReorderRule::reorder(unique_ptr<LogicalOperator> &oper, bool &change_made)
+{
+  LogicalOperator *predicate_oper = oper->type() == LogicalOperatorType::PREDICATE ? oper.get() : nullptr;
+  unique_ptr<LogicalOperator> &join_oper = predicate_oper != nullptr ? oper->children().front() : oper;
+  if (join_input_num(*join_oper) > MAX_INPUT_NUM) {
+    LOG_INFO("too many join inputs, skip join reorder. inputs=%d", join_input_num(*join_oper));
+    return RC::SUCCESS;
+  }
+
+  JoinEnumerator enumerator;
+  enumerator.add_inputs(join_oper);
+  if (predicate_oper != nullptr) {
+    for (unique_ptr<Expression> &expr : predicate_oper->expressions()) {
+      enumerator.add_condition(std::move(expr));
+    }
+    predicate_oper->expressions().clear();
+  }
+
+  RC rc = enumerator.init();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init join enumerator. rc=%s", strrc(rc));
+    return rc;
+  }
+  enumerator.enumerate();
+
+  vector<unique_ptr<Expression>> residual;
+  join_oper   = enumerator.build(residual);
+  change_made = true;
+
+  unique_ptr<Expression> residual_expr;
+  if (residual.size() == 1) {
+    residual_expr = std::move(residual.front());
+  } else if (residual.size() > 1) {
+    residual_expr = make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, residual);
+  }
+
+  if (predicate_oper != nullptr) {
+    if (residual_expr) {
+      predicate_oper->expressions().emplace_back(std::move(residual_expr));
+    } else {
+      // 所有的条件都下推了，不再需要这个过滤算子
+      unique_ptr<LogicalOperator> child = std::move(join_oper);
+      oper                              = std::move(child);
+    }
+  } else if (residual_expr) {
+    auto new_predicate_oper = make_unique<PredicateLogicalOperator>(std::move(residual_expr));
+    new_predicate_oper->add_child(std::move(oper));
+    oper = std::move(new_predicate_oper);
+  }
+  return RC::SUCCESS;
+}
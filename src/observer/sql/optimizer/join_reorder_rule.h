@@ -0,0 +1,47 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/optimizer/rewrite_rule.h"
+
+/**
+ * @brief 选择多表连接的顺序
+ * @ingroup Rewriter
+ * @details 把连接树展开成多个输入(通常就是 from 中的表)，where 中的条件按照 AND 拆开：
+ * 只引用一个输入的条件下推到这个输入上，连接条件放到最低的可以计算它的连接算子上，
+ * 这样就不需要先做笛卡尔积再过滤。
+ *
+ * 所有的表都有统计信息时，使用 CostModel 估算的行数和代价重新选择连接的顺序。
+ * 输入的个数不超过 DP_INPUT_LIMIT 时，使用动态规划枚举所有的子集，优先选择有连接条件的划分，
+ * 没有的时候才做笛卡尔积；输入更多时使用贪心算法，每次把代价最小的一个输入加入到连接中。
+ * 有等值连接条件时会使用哈希连接，右边的输入构建哈希表，所以代价模型会倾向于把行数少的一边放在右边。
+ * 没有统计信息时保持 from 中的顺序，只下推条件。
+ *
+ * 这个规则依赖统计信息，在 OptimizeStage::optimize 中执行一次，不参与 Rewriter 中的反复改写。
+ */
+class JoinReorderRule : public RewriteRule
+{
+public:
+  static constexpr int DP_INPUT_LIMIT = 10;  ///< 使用动态规划的最大输入个数
+  static constexpr int MAX_INPUT_NUM  = 64;  ///< 输入超过这个数量时不做改写
+
+  JoinReorderRule()          = default;
+  virtual ~JoinReorderRule() = default;
+
+  RC rewrite(std::unique_ptr<LogicalOperator> &oper, bool &change_made) override;
+
+private:
+  /**
+   * @brief 改写一棵连接树
+   * @param oper 连接算子，或者下面是连接算子的过滤算子
+   */
+  RC reorder(std::unique_ptr<LogicalOperator> &oper, bool &change_made);
+};
@@ -26,6 +26,9 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/project_logical_operator.h"
 #include "sql/operator/table_get_logical_operator.h"
 #include "sql/operator/group_by_logical_operator.h"
+#include "sql/operator/limit_logical_operator.h"
+#include "sql/operator/sort_logical_operator.h"
+#include "sql/operator/update_logical_operator.h"
 
 // 包含各种SQL语句的头文件
 #include "sql/stmt/calc_stmt.h"
@@ -35,6 +38,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/insert_stmt.h"
 #include "sql/stmt/select_stmt.h"
 #include "sql/stmt/stmt.h"
+#include "sql/stmt/update_stmt.h"
 
 #include "sql/expr/expression_iterator.h"  // 包含表达式迭代器的头文件
 
@@ -71,6 +75,12 @@ RC LogicalPlanGenerator::create(Stmt *stmt, unique_ptr<LogicalOperator> &logical
       rc = create_plan(delete_stmt, logical_operator);  // 创建删除语句的逻辑计划
     } break;
 
+    case StmtType::UPDATE: {  // 更新语句
+      UpdateStmt *update_stmt = static_cast<UpdateStmt *>(stmt);  // 转换为UpdateStmt类型
+
+      rc = create_plan(update_stmt, logical_operator);  // 创建更新语句的逻辑计划
+    } break;
+
     case StmtType::EXPLAIN: {  // 解释语句
       ExplainStmt *explain_stmt = static_cast<ExplainStmt *>(stmt);  // 转换为ExplainStmt类型
 
@@ -151,7 +161,24 @@ if (*last_oper) {  // 如果最后一个操作符存在
   project_oper->add_child(std::move(*last_oper));  // 将最后一个操作符作为PROJECT操作符的子操作符
 }
 
-logical_operator = std::move(project_oper);  // 将PROJECT操作符赋值给输出参数
+unique_ptr<LogicalOperator> top_oper = std::move(project_oper);  // 当前计划树的根节点
+
+// 创建SORT操作符。排序列可能是投影结果中的隐藏列，排序后去掉
+if (!select_stmt->order_by().empty()) {
+  const int64_t limit = select_stmt->limit() < 0 ? -1 : static_cast<int64_t>(select_stmt->limit()) + select_stmt->offset();
+  auto sort_oper = make_unique<SortLogicalOperator>(select_stmt->order_by(), select_stmt->visible_expression_num(), limit);
+  sort_oper->add_child(std::move(top_oper));
+  top_oper = std::move(sort_oper);
+}
+
+// 创建LIMIT操作符
+if (select_stmt->limit() >= 0 || select_stmt->offset() > 0) {
+  auto limit_oper = make_unique<LimitLogicalOperator>(select_stmt->limit(), select_stmt->offset());
+  limit_oper->add_child(std::move(top_oper));
+  top_oper = std::move(limit_oper);
+}
+
+logical_operator = std::move(top_oper);  // 将计划树的根节点赋值给输出参数
 return RC::SUCCESS;  // 返回成功
 
 // create_plan函数用于根据过滤语句生成逻辑操作符
@@ -164,19 +191,28 @@ RC LogicalPlanGenerator::create_plan(FilterStmt *filter_stmt, unique_ptr<Logical
     const FilterObj &filter_obj_right = filter_unit->right();  // 获取右过滤对象
 
     // 根据过滤对象的类型创建表达式
-    unique_ptr<Expression> left(filter_obj_left.is_attr
-                                ? static_cast<Expression *>(new FieldExpr(filter_obj_left.field))
-                                : static_cast<Expression *>(new ValueExpr(filter_obj_left.value)));
-
-    unique_ptr<Expression> right(filter_obj_right.is_attr
-                                ? static_cast<Expression *>(new FieldExpr(filter_obj_right.field))
-                                : static_cast<Expression *>(new ValueExpr(filter_obj_right.value)));
+    unique_ptr<Expression> left;
+    unique_ptr<Expression> right;
+    if (OB_FAIL(rc = create_filter_obj_expr(filter_obj_left, left)) ||
+        OB_FAIL(rc = create_filter_obj_expr(filter_obj_right, right))) {
+      return rc;
+    }
 
     // 检查左右表达式的值类型是否匹配，如果不匹配则进行类型转换
     if (left->value_type() != right->value_type()) {
       auto left_to_right_cost = implicit_cast_cost(left->value_type(), right->value_type());
       auto right_to_left_cost = implicit_cast_cost(right->value_type(), left->value_type());
-      if (left_to_right_cost <= right_to_left_cost && left_to_right_cost != INT32_MAX) {
+      if (left_to_right_cost <= right_to_left_cost && left_to_right_cost != INT32_MAX && left->type() == ExprType::PARAM) {
+        // 参数的值每次执行都可能不同，不能提前转换，取值时再转换
+        if (OB_FAIL(rc = static_cast<ParamExpr *>(left.get())->cast_to(right->value_type()))) {
+          return rc;
+        }
+      } else if (right_to_left_cost < left_to_right_cost && right_to_left_cost != INT32_MAX &&
+                 right->type() == ExprType::PARAM) {
+        if (OB_FAIL(rc = static_cast<ParamExpr *>(right.get())->cast_to(left->value_type()))) {
+          return rc;
+        }
+      } else if (left_to_right_cost <= right_to_left_cost && left_to_right_cost != INT32_MAX) {
         // 如果向左向右转换成本相同或向左转换成本低，则将左表达式转换为右表达式的类型
         ExprType left_type = left->type();
         auto cast_expr = make_unique<CastExpr>(std::move(left), right->value_type());
@@ -226,6 +262,22 @@ RC LogicalPlanGenerator::create_plan(FilterStmt *filter_stmt, unique_ptr<Logical
   logical_operator = std::move(predicate_oper);  // 将谓词逻辑操作符赋值给输出参数
   return rc;  // 返回返回码
 }
+
+// create_filter_obj_expr函数用于根据过滤对象生成字段、常量或参数表达式
+RC LogicalPlanGenerator::create_filter_obj_expr(const FilterObj &filter_obj, unique_ptr<Expression> &expr) {
+  if (filter_obj.is_attr) {
+    expr = make_unique<FieldExpr>(filter_obj.field);
+  } else if (filter_obj.param_index >= 0) {
+    if (params_ == nullptr || filter_obj.param_index >= static_cast<int>(params_->size())) {
+      LOG_WARN("no value bound to param %d", filter_obj.param_index);
+      return RC::INVALID_ARGUMENT;
+    }
+    expr = make_unique<ParamExpr>(filter_obj.param_index, params_);
+  } else {
+    expr = make_unique<ValueExpr>(filter_obj.value);
+  }
+  return RC::SUCCESS;
+}
 // implicit_cast_cost函数用于计算从一种数据类型隐式转换到另一种数据类型的成本
 int LogicalPlanGenerator::implicit_cast_cost(AttrType from, AttrType to) {
   if (from == to) {  // 如果数据类型相同，则成本为0
@@ -238,10 +290,10 @@ int LogicalPlanGenerator::implicit_cast_cost(AttrType from, AttrType to) {
 // create_plan函数用于根据插入语句生成逻辑操作符
 RC LogicalPlanGenerator::create_plan(InsertStmt *insert_stmt, unique_ptr<LogicalOperator> &logical_operator) {
   Table *table = insert_stmt->table();  // 获取插入语句的目标表
-  vector<Value> values(insert_stmt->values(), insert_stmt->values() + insert_stmt->value_amount());  // 获取插入语句的值列表
+  vector<vector<Value>> rows = insert_stmt->rows();  // 获取插入语句的所有行
 
-  // 创建插入逻辑操作符，并设置目标表和值列表
-  InsertLogicalOperator *insert_operator = new InsertLogicalOperator(table, values);
+  // 创建插入逻辑操作符，并设置目标表和所有行
+  InsertLogicalOperator *insert_operator = new InsertLogicalOperator(table, std::move(rows));
   logical_operator.reset(insert_operator);  // 将插入逻辑操作符赋值给输出参数
   return RC::SUCCESS;  // 返回成功
 }
@@ -275,6 +327,33 @@ RC LogicalPlanGenerator::create_plan(DeleteStmt *delete_stmt, unique_ptr<Logical
   return rc;  // 返回返回码
 }
 
+// create_plan函数用于根据更新语句生成逻辑操作符，结构与删除相同
+RC LogicalPlanGenerator::create_plan(UpdateStmt *update_stmt, unique_ptr<LogicalOperator> &logical_operator) {
+  Table      *table       = update_stmt->table();
+  FilterStmt *filter_stmt = update_stmt->filter_stmt();
+
+  unique_ptr<LogicalOperator> table_get_oper(new TableGetLogicalOperator(table, ReadWriteMode::READ_WRITE));
+
+  unique_ptr<LogicalOperator> predicate_oper;
+  RC rc = create_plan(filter_stmt, predicate_oper);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  unique_ptr<LogicalOperator> update_oper(
+      new UpdateLogicalOperator(table, update_stmt->fields(), update_stmt->values()));
+
+  if (predicate_oper) {
+    predicate_oper->add_child(std::move(table_get_oper));
+    update_oper->add_child(std::move(predicate_oper));
+  } else {
+    update_oper->add_child(std::move(table_get_oper));
+  }
+
+  logical_operator = std::move(update_oper);
+  return rc;
+}
+
 // create_plan函数用于根据解释语句生成逻辑操作符
 RC LogicalPlanGenerator::create_plan(ExplainStmt *explain_stmt, unique_ptr<LogicalOperator> &logical_operator) {
   unique_ptr<LogicalOperator> child_oper;  // 创建一个子逻辑操作符的智能指针
@@ -287,7 +366,7 @@ RC LogicalPlanGenerator::create_plan(ExplainStmt *explain_stmt, unique_ptr<Logic
     return rc;  // 返回失败的返回码
   }
 
-  logical_operator = unique_ptr<LogicalOperator>(new ExplainLogicalOperator);  // 创建解释逻辑操作符
+  logical_operator = unique_ptr<LogicalOperator>(new ExplainLogicalOperator(explain_stmt->analyze()));  // 创建解释逻辑操作符
   logical_operator->add_child(std::move(child_oper));  // 将子逻辑操作符作为解释逻辑操作符的子操作符
   return rc;  // 返回返回码
 }
@@ -14,9 +14,11 @@ See the Mulan PSL v2 for more details. */
 #pragma once  // 预处理指令，确保头文件只被包含一次
 
 #include <memory>  // 包含C++标准库中的智能指针支持
+#include <vector>
 
 #include "common/rc.h"  // 包含自定义的返回码定义
 #include "common/type/attr_type.h"  // 包含自定义的数据类型定义
+#include "common/value.h"
 
 // 声明相关的类，这些类的定义在其他头文件中
 class Stmt;
@@ -25,8 +27,11 @@ class SelectStmt;
 class FilterStmt;
 class InsertStmt;
 class DeleteStmt;
+class UpdateStmt;
 class ExplainStmt;
 class LogicalOperator;
+class Expression;
+struct FilterObj;
 
 // LogicalPlanGenerator类用于生成SQL查询的逻辑计划
 class LogicalPlanGenerator
@@ -34,6 +39,8 @@ class LogicalPlanGenerator
 public:
   // 默认构造函数
   LogicalPlanGenerator() = default;
+  // 语句中有参数(?)时，需要传入参数的值，生成的计划引用这些值，执行前可以重新绑定
+  explicit LogicalPlanGenerator(const std::vector<Value> *params) : params_(params) {}
   // 默认虚析构函数，允许派生类的析构函数被正确调用
   virtual ~LogicalPlanGenerator() = default;
 
@@ -47,11 +54,18 @@ private:
   RC create_plan(FilterStmt *filter_stmt, std::unique_ptr<LogicalOperator> &logical_operator);
   RC create_plan(InsertStmt *insert_stmt, std::unique_ptr<LogicalOperator> &logical_operator);
   RC create_plan(DeleteStmt *delete_stmt, std::unique_ptr<LogicalOperator> &logical_operator);
+  RC create_plan(UpdateStmt *update_stmt, std::unique_ptr<LogicalOperator> &logical_operator);
   RC create_plan(ExplainStmt *explain_stmt, std::unique_ptr<LogicalOperator> &logical_operator);
 
   // create_group_by_plan函数用于根据选择语句生成GROUP BY逻辑操作符
   RC create_group_by_plan(SelectStmt *select_stmt, std::unique_ptr<LogicalOperator> &logical_operator);
 
+  // create_filter_obj_expr函数用于根据过滤对象生成字段、常量或参数表达式
+  RC create_filter_obj_expr(const FilterObj &filter_obj, std::unique_ptr<Expression> &expr);
+
   // implicit_cast_cost函数用于计算从一种数据类型隐式转换到另一种数据类型的成本
   int implicit_cast_cost(AttrType from, AttrType to);
+
+private:
+  const std::vector<Value> *params_ = nullptr;  ///< 语句中参数的值
 };
\ No newline at end of file
@@ -23,7 +23,10 @@ See the Mulan PSL v2 for more details. */
 #include "event/session_event.h"  // 包含会话事件的头文件
 #include "event/sql_event.h"  // 包含SQL事件的头文件
 #include "sql/operator/logical_operator.h"  // 包含逻辑操作符的头文件
+#include "sql/operator/table_get_logical_operator.h"  // 包含表获取逻辑操作符的头文件
+#include "sql/plan_cache/plan_cache.h"  // 包含计划缓存的头文件
 #include "sql/stmt/stmt.h"  // 包含SQL语句的头文件
+#include "storage/table/table.h"  // 包含表的头文件
 
 using namespace std;  // 使用标准命名空间
 using namespace common;  // 使用common命名空间
@@ -70,10 +73,35 @@ RC OptimizeStage::handle_request(SQLStageEvent *sql_event) {
   return rc;  // 返回返回码
 }
 
-// optimize函数用于优化逻辑操作符，当前实现为空
+// optimize函数用于根据代价模型优化逻辑操作符
 RC OptimizeStage::optimize(unique_ptr<LogicalOperator> &oper) {
-  // do nothing
-  return RC::SUCCESS;
+  refresh_statistics(*oper);
+
+  bool change_made = false;
+  RC   rc          = join_reorder_rule_.rewrite(oper, change_made);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to reorder joins. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+// refresh_statistics函数用于重新收集计划中过期的统计信息
+void OptimizeStage::refresh_statistics(LogicalOperator &oper) {
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    Table *table     = static_cast<TableGetLogicalOperator &>(oper).table();
+    bool   refreshed = false;
+    RC     rc        = table->refresh_statistics_if_expired(refreshed);
+    if (OB_FAIL(rc)) {
+      // 统计信息只影响计划的好坏，失败了继续使用旧的统计信息
+      LOG_WARN("failed to refresh statistics. table=%s, rc=%s", table->name(), strrc(rc));
+    } else if (refreshed) {
+      PlanCache::bump_schema_version();  // 缓存的计划是根据旧的统计信息生成的
+    }
+  }
+
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    refresh_statistics(*child);
+  }
 }
 
 // generate_physical_plan函数用于生成物理计划
@@ -120,5 +148,7 @@ RC OptimizeStage::create_logical_plan(SQLStageEvent *sql_event, unique_ptr<Logic
     return RC::UNIMPLEMENTED;  // 返回未实现的返回码
   }
 
-  return logical_plan_generator_.create(stmt, logical_operator);  // 创建逻辑计划
+  // 语句中的参数(?)在生成的计划中引用事件中保存的参数值，所以每个请求使用自己的生成器
+  LogicalPlanGenerator logical_plan_generator(sql_event->params());
+  return logical_plan_generator.create(stmt, logical_operator);  // 创建逻辑计划
 }
\ No newline at end of file
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "session/session.h"
 #include "sql/operator/logical_operator.h"
 #include "sql/operator/physical_operator.h"
+#include "sql/optimizer/join_reorder_rule.h"
 #include "sql/optimizer/logical_plan_generator.h"
 #include "sql/optimizer/physical_plan_generator.h"
 #include "sql/optimizer/rewriter.h"
@@ -59,11 +60,17 @@ private:
 
   /**
    * @brief 优化逻辑计划
-   * @details 当前什么都没做。可以增加每个逻辑计划的代价模型，然后根据代价模型进行优化。
+   * @details 根据代价模型进行优化。统计信息过期的表先重新收集统计信息，然后选择多表连接的顺序，
+   * 见 JoinReorderRule。索引的选择在生成物理计划时进行。
    * @param logical_operator 需要优化的逻辑计划
    */
   RC optimize(std::unique_ptr<LogicalOperator> &logical_operator);
 
+  /**
+   * @brief 修改的行数超过阈值时，重新收集计划中用到的表的统计信息
+   */
+  void refresh_statistics(LogicalOperator &oper);
+
   /**
    * @brief 根据逻辑计划生成物理计划
    * @details 生成的物理计划就可以直接让后面的执行器完全按照物理计划执行了。
@@ -75,7 +82,7 @@ private:
       std::unique_ptr<PhysicalOperator> &physical_operator, Session *session);
 
 private:
-  LogicalPlanGenerator  logical_plan_generator_;   ///< 根据SQL生成逻辑计划
   PhysicalPlanGenerator physical_plan_generator_;  ///< 根据逻辑计划生成物理计划
   Rewriter              rewriter_;                 ///< 逻辑计划改写
+  JoinReorderRule       join_reorder_rule_;        ///< 选择连接的顺序
 };
@@ -25,11 +25,16 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/explain_physical_operator.h"
 #include "sql/operator/expr_vec_physical_operator.h"
 #include "sql/operator/group_by_vec_physical_operator.h"
+#include "sql/operator/hash_join_physical_operator.h"
 #include "sql/operator/index_scan_physical_operator.h"
 #include "sql/operator/insert_logical_operator.h"
 #include "sql/operator/insert_physical_operator.h"
 #include "sql/operator/join_logical_operator.h"
 #include "sql/operator/join_physical_operator.h"
+#include "sql/operator/limit_logical_operator.h"
+#include "sql/operator/limit_physical_operator.h"
+#include "sql/operator/limit_vec_physical_operator.h"
+#include "sql/operator/parallel_group_by_vec_physical_operator.h"
 #include "sql/operator/predicate_logical_operator.h"
 #include "sql/operator/predicate_physical_operator.h"
 #include "sql/operator/project_logical_operator.h"
@@ -41,8 +46,16 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/group_by_physical_operator.h"
 #include "sql/operator/hash_group_by_physical_operator.h"
 #include "sql/operator/scalar_group_by_physical_operator.h"
+#include "sql/operator/sort_logical_operator.h"
+#include "sql/operator/sort_physical_operator.h"
+#include "sql/operator/sort_vec_physical_operator.h"
 #include "sql/operator/table_scan_vec_physical_operator.h"
+#include "sql/operator/update_logical_operator.h"
+#include "sql/operator/update_physical_operator.h"
+#include "sql/optimizer/cost_model.h"
 #include "sql/optimizer/physical_plan_generator.h"
+#include "session/session.h"
+#include "storage/index/index.h"
 
 using namespace std;
 
@@ -76,6 +89,10 @@ RC PhysicalPlanGenerator::create(LogicalOperator &logical_operator, unique_ptr<P
       return create_plan(static_cast<DeleteLogicalOperator &>(logical_operator), oper);  // 创建删除物理操作符
     } break;
 
+    case LogicalOperatorType::UPDATE: {  // 更新逻辑操作符
+      return create_plan(static_cast<UpdateLogicalOperator &>(logical_operator), oper);  // 创建更新物理操作符
+    } break;
+
     case LogicalOperatorType::EXPLAIN: {  // 解释逻辑操作符
       return create_plan(static_cast<ExplainLogicalOperator &>(logical_operator), oper);  // 创建解释物理操作符
     } break;
@@ -88,6 +105,14 @@ RC PhysicalPlanGenerator::create(LogicalOperator &logical_operator, unique_ptr<P
       return create_plan(static_cast<GroupByLogicalOperator &>(logical_operator), oper);  // 创建GROUP BY物理操作符
     } break;
 
+    case LogicalOperatorType::SORT: {  // 排序逻辑操作符
+      return create_plan(static_cast<SortLogicalOperator &>(logical_operator), oper);  // 创建排序物理操作符
+    } break;
+
+    case LogicalOperatorType::LIMIT: {  // LIMIT逻辑操作符
+      return create_plan(static_cast<LimitLogicalOperator &>(logical_operator), oper);  // 创建LIMIT物理操作符
+    } break;
+
     default: {  // 未知的逻辑操作符类型
       ASSERT(false, "unknown logical operator type");  // 断言未知类型
       return RC::INVALID_ARGUMENT;  // 返回无效参数的返回码
@@ -111,6 +136,12 @@ RC PhysicalPlanGenerator::create_vec(LogicalOperator &logical_operator, unique_p
     case LogicalOperatorType::GROUP_BY: {  // GROUP BY逻辑操作符
       return create_vec_plan(static_cast<GroupByLogicalOperator &>(logical_operator), oper);  // 创建向量化GROUP BY物理操作符
     } break;
+    case LogicalOperatorType::SORT: {  // 排序逻辑操作符
+      return create_vec_plan(static_cast<SortLogicalOperator &>(logical_operator), oper);  // 创建向量化排序物理操作符
+    } break;
+    case LogicalOperatorType::LIMIT: {  // LIMIT逻辑操作符
+      return create_vec_plan(static_cast<LimitLogicalOperator &>(logical_operator), oper);  // 创建向量化LIMIT物理操作符
+    } break;
     case LogicalOperatorType::EXPLAIN: {  // 解释逻辑操作符
       return create_vec_plan(static_cast<ExplainLogicalOperator &>(logical_operator), oper);  // 创建向量化解释物理操作符
     } break;
@@ -136,6 +167,12 @@ RC PhysicalPlanGenerator::create_vec(LogicalOperator &logical_operator, unique_p
     case LogicalOperatorType::GROUP_BY: {  // GROUP BY逻辑操作符
       return create_vec_plan(static_cast<GroupByLogicalOperator &>(logical_operator), oper);  // 创建向量化GROUP BY物理操作符
     } break;
+    case LogicalOperatorType::SORT: {  // 排序逻辑操作符
+      return create_vec_plan(static_cast<SortLogicalOperator &>(logical_operator), oper);  // 创建向量化排序物理操作符
+    } break;
+    case LogicalOperatorType::LIMIT: {  // LIMIT逻辑操作符
+      return create_vec_plan(static_cast<LimitLogicalOperator &>(logical_operator), oper);  // 创建向量化LIMIT物理操作符
+    } break;
     case LogicalOperatorType::EXPLAIN: {  // 解释逻辑操作符
       return create_vec_plan(static_cast<ExplainLogicalOperator &>(logical_operator), oper);  // 创建向量化解释物理操作符
     } break;
@@ -151,47 +188,46 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
   vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();  // 获取谓词表达式
   Table *table = table_get_oper.table();  // 获取表对象
 
-  // 遍历谓词表达式，寻找可用于索引查找的表达式
-  for (auto &expr : predicates) {
-    if (expr->type() == ExprType::COMPARISON) {  // 比较表达式
-      auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());  // 转换为比较表达式对象
-      // 简单处理，只寻找等值查询
-      if (comparison_expr->comp() != EQUAL_TO) {
-        continue;
-      }
+  Index      *index      = nullptr;
+  Expression *value_expr = nullptr;
 
-      unique_ptr<Expression> &left_expr  = comparison_expr->left();
-      unique_ptr<Expression> &right_expr = comparison_expr->right();
-      // 左右比较的一边至少是一个值
-      if (left_expr->type() != ExprType::VALUE && right_expr->type() != ExprType::VALUE) {
+  // 有统计信息时根据代价在全表扫描和各个索引之间选择
+  AccessPath access_path;
+  if (CostModel::choose_access_path(table_get_oper, access_path)) {
+    index      = access_path.index;
+    value_expr = access_path.value_expr;
+    LOG_TRACE("choose access path by cost. table=%s, cost=%.2f, rows=%.2f",
+              table->name(), access_path.cost.cost, access_path.cost.rows);
+  } else {
+    // 否则只要等值条件上有索引就使用
+    for (auto &expr : predicates) {
+      FieldExpr  *field_expr  = nullptr;
+      Expression *field_value = nullptr;
+      if (!CostModel::is_field_equal_constant(*expr, field_expr, field_value)) {
         continue;
       }
 
-      FieldExpr *field_expr = nullptr;
-      ValueExpr *value_expr = nullptr;
-      // 确定字段表达式和值表达式
-      if (left_expr->type() == ExprType::FIELD) {
-        field_expr = static_cast<FieldExpr *>(left_expr.get());
-        value_expr = static_cast<ValueExpr *>(right_expr.get());
-      } else if (right_expr->type() == ExprType::FIELD) {
-        field_expr = static_cast<FieldExpr *>(right_expr.get());
-        value_expr = static_cast<ValueExpr *>(left_expr.get());
+      Index *field_index = table->find_equality_index(field_expr->field_name());
+      // 多个条件上都有索引时优先使用哈希索引，等值查找只需要访问一个桶
+      if (field_index != nullptr && (index == nullptr || field_index->index_meta().type() == IndexType::HASH)) {
+        index      = field_index;
+        value_expr = field_value;
       }
 
-      // 如果找到了字段表达式，则尝试寻找对应的索引
-      if (field_expr != nullptr) {
-        const Field &field = field_expr->field();
-        Index *index = table->find_index_by_field(field.field_name());
-        if (index != nullptr) {  // 如果找到了索引
-          break;  // 退出循环
-        }
+      if (index != nullptr && index->index_meta().type() == IndexType::HASH) {
+        break;  // 找到了哈希索引，退出循环
       }
     }
   }
 
   // 如果找到了索引，则创建索引扫描物理操作符
   if (index != nullptr && value_expr != nullptr) {
-    const Value &value = value_expr->get_value();
+    Value value;
+    RC    rc = value_expr->try_get_value(value);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get index key value. rc=%s", strrc(rc));
+      return rc;
+    }
     IndexScanPhysicalOperator *index_scan_oper = new IndexScanPhysicalOperator(table,
         index,
         table_get_oper.read_write_mode(),
@@ -200,6 +236,9 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
         &value,
         true /*right_inclusive*/);
 
+    if (value_expr->type() == ExprType::PARAM) {
+      index_scan_oper->set_key_expr(value_expr);  // 参数的值每次执行时重新获取
+    }
     index_scan_oper->set_predicates(std::move(predicates));
     oper = unique_ptr<PhysicalOperator>(index_scan_oper);
     LOG_TRACE("use index scan");
@@ -267,10 +306,10 @@ RC PhysicalPlanGenerator::create_plan(ProjectLogicalOperator &project_oper, uniq
 // create_plan函数用于根据插入逻辑操作符生成物理操作符
 RC PhysicalPlanGenerator::create_plan(InsertLogicalOperator &insert_oper, unique_ptr<PhysicalOperator> &oper) {
   Table *table = insert_oper.table();  // 获取目标表
-  vector<Value> &values = insert_oper.values();  // 获取插入的值列表
+  vector<vector<Value>> &rows = insert_oper.rows();  // 获取插入的所有行
 
   // 创建插入物理操作符
-  InsertPhysicalOperator *insert_phy_oper = new InsertPhysicalOperator(table, std::move(values));
+  InsertPhysicalOperator *insert_phy_oper = new InsertPhysicalOperator(table, std::move(rows));
   oper.reset(insert_phy_oper);  // 将插入物理操作符赋值给输出参数
   return RC::SUCCESS;  // 返回成功
 }
@@ -299,12 +338,37 @@ RC PhysicalPlanGenerator::create_plan(DeleteLogicalOperator &delete_oper, unique
   return rc;  // 返回返回码
 }
 
+// create_plan函数用于根据更新逻辑操作符生成物理操作符
+RC PhysicalPlanGenerator::create_plan(UpdateLogicalOperator &update_oper, unique_ptr<PhysicalOperator> &oper) {
+  vector<unique_ptr<LogicalOperator>> &child_opers = update_oper.children();
+
+  unique_ptr<PhysicalOperator> child_physical_oper;
+  RC rc = RC::SUCCESS;
+  if (!child_opers.empty()) {
+    LogicalOperator *child_oper = child_opers.front().get();
+
+    rc = create(*child_oper, child_physical_oper);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to create physical operator. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  oper = unique_ptr<PhysicalOperator>(
+      new UpdatePhysicalOperator(update_oper.table(), update_oper.fields(), update_oper.values()));
+
+  if (child_physical_oper) {
+    oper->add_child(std::move(child_physical_oper));
+  }
+  return rc;
+}
+
 // create_plan函数用于根据解释逻辑操作符生成物理操作符
 RC PhysicalPlanGenerator::create_plan(ExplainLogicalOperator &explain_oper, unique_ptr<PhysicalOperator> &oper) {
   vector<unique_ptr<LogicalOperator>> &child_opers = explain_oper.children();  // 获取子逻辑操作符列表
 
   RC rc = RC::SUCCESS;
-  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator);  // 创建解释物理操作符
+  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator(explain_oper.analyze()));  // 创建解释物理操作符
   for (unique_ptr<LogicalOperator> &child_oper : child_opers) {  // 遍历子逻辑操作符
     unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
     rc = create(*child_oper, child_physical_oper);  // 递归创建子物理操作符
@@ -330,7 +394,42 @@ RC PhysicalPlanGenerator::create_plan(JoinLogicalOperator &join_oper, unique_ptr
     return RC::INTERNAL;  // 返回内部错误
   }
 
-  unique_ptr<PhysicalOperator> join_physical_oper(new NestedLoopJoinPhysicalOperator);  // 创建嵌套循环连接物理操作符
+  // 有 左表字段 = 右表字段 的连接条件时使用哈希连接，右表构建哈希表，否则使用嵌套循环连接
+  unordered_set<const Table *> left_tables;
+  unordered_set<const Table *> right_tables;
+  CostModel::collect_tables(*child_opers[0], left_tables);
+  CostModel::collect_tables(*child_opers[1], right_tables);
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  vector<unique_ptr<Expression>> &conditions = join_oper.expressions();
+  for (unique_ptr<Expression> &condition : conditions) {
+    FieldExpr *left_field  = nullptr;
+    FieldExpr *right_field = nullptr;
+    if (CostModel::is_equi_join_condition(*condition, left_tables, right_tables, left_field, right_field)) {
+      left_keys.emplace_back(make_unique<FieldExpr>(left_field->field()));
+      right_keys.emplace_back(make_unique<FieldExpr>(right_field->field()));
+    }
+  }
+
+  unique_ptr<Expression> predicate;
+  if (conditions.size() == 1) {
+    predicate = std::move(conditions.front());
+  } else if (conditions.size() > 1) {
+    predicate = make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, conditions);
+  }
+  conditions.clear();
+
+  unique_ptr<PhysicalOperator> join_physical_oper;
+  if (!left_keys.empty()) {
+    join_physical_oper =
+        make_unique<HashJoinPhysicalOperator>(std::move(left_keys), std::move(right_keys), std::move(predicate));
+  } else {
+    auto nested_loop_join = make_unique<NestedLoopJoinPhysicalOperator>();  // 创建嵌套循环连接物理操作符
+    nested_loop_join->set_predicate(std::move(predicate));
+    join_physical_oper = std::move(nested_loop_join);
+  }
+
   for (auto &child_oper : child_opers) {  // 遍历子逻辑操作符
     unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
     rc = create(*child_oper, child_physical_oper);  // 递归创建子物理操作符
@@ -397,8 +496,24 @@ RC PhysicalPlanGenerator::create_vec_plan(TableGetLogicalOperator &table_get_ope
   return RC::SUCCESS;  // 返回成功
 }
 
+// 查询内并行执行使用的线程数，可以通过会话变量 parallel_degree 设置
+static int parallel_degree()
+{
+  Session *session = Session::current_session();
+  return session != nullptr ? session->parallel_degree() : DEFAULT_PARALLEL_DEGREE;
+}
+
 // create_vec_plan函数用于根据GROUP BY逻辑操作符生成向量化物理操作符
 RC PhysicalPlanGenerator::create_vec_plan(GroupByLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper) {
+  ASSERT(logical_oper.children().size() == 1, "group by operator should have 1 child");  // 断言GROUP BY操作符有一个子操作符
+
+  // 直接聚合一张表的数据时，可以由多个线程各自扫描一部分页面并聚合
+  LogicalOperator &table_oper = *logical_oper.children().front();
+  if (parallel_degree() > 1 && table_oper.type() == LogicalOperatorType::TABLE_GET) {
+    return create_parallel_vec_plan(
+        logical_oper, static_cast<TableGetLogicalOperator &>(table_oper), parallel_degree(), oper);
+  }
+
   RC rc = RC::SUCCESS;
   unique_ptr<PhysicalOperator> physical_oper;  // 创建物理操作符的智能指针
   if (logical_oper.group_by_expressions().empty()) {  // 如果没有GROUP BY表达式
@@ -408,8 +523,6 @@ RC PhysicalPlanGenerator::create_vec_plan(GroupByLogicalOperator &logical_oper,
       std::move(logical_oper.group_by_expressions()), std::move(logical_oper.aggregate_expressions()));
   }
 
-  ASSERT(logical_oper.children().size() == 1, "group by operator should have 1 child");  // 断言GROUP BY操作符有一个子操作符
-
   LogicalOperator &child_oper = *logical_oper.children().front();  // 获取子逻辑操作符
   unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
   rc = create_vec(child_oper, child_physical_oper);  // 递归创建子物理操作符
@@ -423,6 +536,32 @@ RC PhysicalPlanGenerator::create_vec_plan(GroupByLogicalOperator &logical_oper,
   return rc;  // 返回返回码
 }
 
+// create_parallel_vec_plan函数为每个线程生成一个表扫描，它们从共享的页面迭代器中领取页面
+RC PhysicalPlanGenerator::create_parallel_vec_plan(GroupByLogicalOperator &logical_oper,
+    TableGetLogicalOperator &table_get_oper, int parallel_degree, unique_ptr<PhysicalOperator> &oper) {
+  Table *table = table_get_oper.table();  // 获取表对象
+  auto   parallel_oper = make_unique<ParallelGroupByVecPhysicalOperator>(
+      table, std::move(logical_oper.group_by_expressions()), std::move(logical_oper.aggregate_expressions()));
+
+  // 过滤条件由第一个表扫描持有，其它的表扫描共用
+  TableScanVecPhysicalOperator *predicate_owner = nullptr;
+  for (int i = 0; i < parallel_degree; i++) {
+    auto scan_oper = make_unique<TableScanVecPhysicalOperator>(table, table_get_oper.read_write_mode());
+    if (predicate_owner == nullptr) {
+      scan_oper->set_predicates(std::move(table_get_oper.predicates()));
+      predicate_owner = scan_oper.get();
+    } else {
+      scan_oper->share_predicates(*predicate_owner);
+    }
+    scan_oper->set_morsel_iterator(&parallel_oper->morsel_iterator());
+    parallel_oper->add_child(std::move(scan_oper));
+  }
+
+  oper = std::move(parallel_oper);  // 将物理操作符赋值给输出参数
+  LOG_TRACE("use parallel group by. workers=%d", parallel_degree);
+  return RC::SUCCESS;
+}
+
 // create_vec_plan函数用于根据投影逻辑操作符生成向量化物理操作符
 RC PhysicalPlanGenerator::create_vec_plan(ProjectLogicalOperator &project_oper, unique_ptr<PhysicalOperator> &oper) {
   vector<unique_ptr<LogicalOperator>> &child_opers = project_oper.children();  // 获取子逻辑操作符列表
@@ -460,7 +599,7 @@ RC PhysicalPlanGenerator::create_vec_plan(ExplainLogicalOperator &explain_oper,
 
   RC rc = RC::SUCCESS;
   // 重用解释物理操作符
-  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator);  // 创建解释物理操作符
+  unique_ptr<PhysicalOperator> explain_physical_oper(new ExplainPhysicalOperator(explain_oper.analyze()));  // 创建解释物理操作符
   for (unique_ptr<LogicalOperator> &child_oper : child_opers) {  // 遍历子逻辑操作符
     unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
     rc = create_vec(*child_oper, child_physical_oper);  // 递归创建子物理操作符
@@ -474,4 +613,90 @@ RC PhysicalPlanGenerator::create_vec_plan(ExplainLogicalOperator &explain_oper,
 
   oper = std::move(explain_physical_oper);  // 将解释物理操作符赋值给输出参数
   return rc;  // 返回返回码
+}
+
+// 排序可以使用的内存大小，可以通过会话变量 sort_buffer_size 设置
+static int64_t sort_buffer_size()
+{
+  Session *session = Session::current_session();
+  return session != nullptr ? session->sort_buffer_size() : DEFAULT_SORT_BUFFER_SIZE;
+}
+
+// create_plan函数用于根据排序逻辑操作符生成物理操作符
+RC PhysicalPlanGenerator::create_plan(SortLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper) {
+  vector<unique_ptr<LogicalOperator>> &child_opers = logical_oper.children();  // 获取子逻辑操作符
+  ASSERT(child_opers.size() == 1, "sort operator should have 1 child");
+
+  unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
+  RC rc = create(*child_opers.front(), child_physical_oper);  // 递归创建子物理操作符
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child physical operator of sort operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  oper = make_unique<SortPhysicalOperator>(
+      logical_oper.order_by(), logical_oper.visible_column_num(), logical_oper.limit(), sort_buffer_size());
+  oper->add_child(std::move(child_physical_oper));  // 添加子物理操作符
+  return rc;
+}
+
+// create_plan函数用于根据LIMIT逻辑操作符生成物理操作符
+RC PhysicalPlanGenerator::create_plan(LimitLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper) {
+  vector<unique_ptr<LogicalOperator>> &child_opers = logical_oper.children();  // 获取子逻辑操作符
+  ASSERT(child_opers.size() == 1, "limit operator should have 1 child");
+
+  unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
+  RC rc = create(*child_opers.front(), child_physical_oper);  // 递归创建子物理操作符
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child physical operator of limit operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 子算子最多只需要输出 limit + offset 行，扫描算子据此提前结束
+  if (logical_oper.limit() >= 0) {
+    child_physical_oper->push_down_limit(logical_oper.limit() + logical_oper.offset());
+  }
+
+  oper = make_unique<LimitPhysicalOperator>(logical_oper.limit(), logical_oper.offset());
+  oper->add_child(std::move(child_physical_oper));  // 添加子物理操作符
+  return rc;
+}
+
+// create_vec_plan函数用于根据排序逻辑操作符生成向量化物理操作符
+RC PhysicalPlanGenerator::create_vec_plan(SortLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper) {
+  vector<unique_ptr<LogicalOperator>> &child_opers = logical_oper.children();  // 获取子逻辑操作符
+  ASSERT(child_opers.size() == 1, "sort operator should have 1 child");
+
+  unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
+  RC rc = create_vec(*child_opers.front(), child_physical_oper);  // 递归创建子物理操作符
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child physical operator of sort operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  oper = make_unique<SortVecPhysicalOperator>(
+      logical_oper.order_by(), logical_oper.visible_column_num(), logical_oper.limit(), sort_buffer_size());
+  oper->add_child(std::move(child_physical_oper));  // 添加子物理操作符
+  return rc;
+}
+
+// create_vec_plan函数用于根据LIMIT逻辑操作符生成向量化物理操作符
+RC PhysicalPlanGenerator::create_vec_plan(LimitLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper) {
+  vector<unique_ptr<LogicalOperator>> &child_opers = logical_oper.children();  // 获取子逻辑操作符
+  ASSERT(child_opers.size() == 1, "limit operator should have 1 child");
+
+  unique_ptr<PhysicalOperator> child_physical_oper;  // 创建子物理操作符的智能指针
+  RC rc = create_vec(*child_opers.front(), child_physical_oper);  // 递归创建子物理操作符
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child physical operator of limit operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (logical_oper.limit() >= 0) {
+    child_physical_oper->push_down_limit(logical_oper.limit() + logical_oper.offset());
+  }
+
+  oper = make_unique<LimitVecPhysicalOperator>(logical_oper.limit(), logical_oper.offset());
+  oper->add_child(std::move(child_physical_oper));  // 添加子物理操作符
+  return rc;
 }
\ No newline at end of file
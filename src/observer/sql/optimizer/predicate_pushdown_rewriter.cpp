@@ -117,22 +117,30 @@ RC PredicatePushdownRewriter::get_exprs_can_pushdown(
         ++iter;
       }
     }
-  } else if (expr->type() == ExprType::COMPARISON) {
-    // 如果是比较操作，并且比较的左边或右边是表某个列值，那么就下推下去
-    auto   comparison_expr = static_cast<ComparisonExpr *>(expr.get());
-
-    std::unique_ptr<Expression> &left_expr  = comparison_expr->left();
-    std::unique_ptr<Expression> &right_expr = comparison_expr->right();
-    // 比较操作的左右两边只要有一个是取列字段值的并且另一边也是取字段值或常量，就pushdown
-    if (left_expr->type() != ExprType::FIELD && right_expr->type() != ExprType::FIELD) {
-      return rc;
-    }
-    if (left_expr->type() != ExprType::FIELD && left_expr->type() != ExprType::VALUE &&
-        right_expr->type() != ExprType::FIELD && right_expr->type() != ExprType::VALUE) {
-      return rc;
-    }
-
+  } else if (can_pushdown(*expr)) {
     pushdown_exprs.emplace_back(std::move(expr));
   }
   return rc;
 }
+
+bool PredicatePushdownRewriter::can_pushdown(Expression &expr)
+{
+  // 如果是比较操作，并且比较的左边或右边是表某个列值，那么就下推下去
+  if (expr.type() != ExprType::COMPARISON) {
+    return false;
+  }
+
+  auto       &comparison_expr = static_cast<ComparisonExpr &>(expr);
+  Expression *left_expr       = comparison_expr.left().get();
+  Expression *right_expr      = comparison_expr.right().get();
+  // 比较操作的左右两边只要有一个是取列字段值的并且另一边也是取字段值或常量，就pushdown
+  if (left_expr->type() != ExprType::FIELD && right_expr->type() != ExprType::FIELD) {
+    return false;
+  }
+  auto is_constant = [](const Expression *e) { return e->type() == ExprType::VALUE || e->type() == ExprType::PARAM; };
+  if (left_expr->type() != ExprType::FIELD && !is_constant(left_expr) &&
+      right_expr->type() != ExprType::FIELD && !is_constant(right_expr)) {
+    return false;
+  }
+  return true;
+}
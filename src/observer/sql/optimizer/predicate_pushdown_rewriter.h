@@ -30,6 +30,12 @@ public:
 
   RC rewrite(std::unique_ptr<LogicalOperator> &oper, bool &change_made) override;
 
+  /**
+   * @brief 单表的条件是否可以下推到 table get 算子中
+   * @details 只有比较运算，并且左右两边都是字段或常量的条件才可以下推
+   */
+  static bool can_pushdown(Expression &expr);
+
 private:
   RC get_exprs_can_pushdown(
       std::unique_ptr<Expression> &expr, std::vector<std::unique_ptr<Expression>> &pushdown_exprs);
@@ -73,6 +73,29 @@ struct ConditionSqlNode
                                  ///< 1时，操作符右边是属性名，0时，是属性值
   RelAttrSqlNode right_attr;     ///< right-hand side attribute if right_is_attr = TRUE 右边的属性
   Value          right_value;    ///< right-hand side value if right_is_attr = FALSE
+  int            left_param  = -1;  ///< 左边是参数(?)时参数的序号，此时 left_value 无效
+  int            right_param = -1;  ///< 右边是参数(?)时参数的序号，此时 right_value 无效
+};
+
+/**
+ * @brief 描述 order by 中的一项
+ * @ingroup SQLParser
+ */
+struct OrderBySqlNode
+{
+  std::unique_ptr<Expression> expression;        ///< 排序的表达式
+  bool                        ascending = true;  ///< 是否升序
+};
+
+/**
+ * @brief 描述 limit 子句
+ * @ingroup SQLParser
+ * @details limit 小于0表示没有 limit 子句
+ */
+struct LimitSqlNode
+{
+  int limit  = -1;  ///< 最多返回多少行
+  int offset = 0;   ///< 跳过前面多少行
 };
 
 /**
@@ -92,6 +115,8 @@ struct SelectSqlNode
   std::vector<std::string>                 relations;    ///< 查询的表
   std::vector<ConditionSqlNode>            conditions;   ///< 查询条件，使用AND串联起来多个条件
   std::vector<std::unique_ptr<Expression>> group_by;     ///< group by clause
+  std::vector<OrderBySqlNode>              order_by;     ///< order by clause
+  LimitSqlNode                             limit;        ///< limit clause
 };
 
 /**
@@ -110,8 +135,8 @@ struct CalcSqlNode
  */
 struct InsertSqlNode
 {
-  std::string        relation_name;  ///< Relation to insert into
-  std::vector<Value> values;         ///< 要插入的值
+  std::string                     relation_name;  ///< Relation to insert into
+  std::vector<std::vector<Value>> values;         ///< 要插入的值，每个元素是一行
 };
 
 /**
@@ -124,15 +149,24 @@ struct DeleteSqlNode
   std::vector<ConditionSqlNode> conditions;
 };
 
+/**
+ * @brief 描述 update 语句中的一个 set 子句
+ * @ingroup SQLParser
+ */
+struct SetClauseSqlNode
+{
+  std::string attribute_name;  ///< 更新的字段
+  Value       value;           ///< 更新的值
+};
+
 /**
  * @brief 描述一个update语句
  * @ingroup SQLParser
  */
 struct UpdateSqlNode
 {
-  std::string                   relation_name;   ///< Relation to update
-  std::string                   attribute_name;  ///< 更新的字段，仅支持一个字段
-  Value                         value;           ///< 更新的值，仅支持一个字段
+  std::string                   relation_name;  ///< Relation to update
+  std::vector<SetClauseSqlNode> set_clauses;    ///< 更新的字段和值，至少有一个
   std::vector<ConditionSqlNode> conditions;
 };
 
@@ -146,6 +180,7 @@ struct AttrInfoSqlNode
   AttrType    type;    ///< Type of attribute
   std::string name;    ///< Attribute name
   size_t      length;  ///< Length of attribute
+  bool        var_len = false;  ///< 是否是变长的字符串(VARCHAR/TEXT)，最大长度是 length
 };
 
 /**
@@ -180,6 +215,7 @@ struct CreateIndexSqlNode
   std::string index_name;      ///< Index name
   std::string relation_name;   ///< Relation name
   std::string attribute_name;  ///< Attribute name
+  std::string index_type;      ///< Index type, empty means default (BTREE)
 };
 
 /**
@@ -202,6 +238,16 @@ struct DescTableSqlNode
   std::string relation_name;
 };
 
+/**
+ * @brief 描述一个analyze table语句
+ * @ingroup SQLParser
+ * @details 收集表和字段的统计信息，供优化器估算代价
+ */
+struct AnalyzeTableSqlNode
+{
+  std::string relation_name;
+};
+
 /**
  * @brief 描述一个load data语句
  * @ingroup SQLParser
@@ -232,10 +278,12 @@ class ParsedSqlNode;
  * @details 会创建operator的语句，才能用explain输出执行计划。
  * 一个command就是一个语句，比如select语句，insert语句等。
  * 可能改成SqlCommand更合适。
+ * EXPLAIN ANALYZE 会真正执行语句，输出每个算子的执行信息。
  */
 struct ExplainSqlNode
 {
   std::unique_ptr<ParsedSqlNode> sql_node;
+  bool                           analyze = false;  ///< 是否为 EXPLAIN ANALYZE
 };
 
 /**
@@ -269,6 +317,7 @@ enum SqlCommandFlag
   SCF_SYNC,
   SCF_SHOW_TABLES,
   SCF_DESC_TABLE,
+  SCF_ANALYZE_TABLE,  ///< 收集统计信息
   SCF_BEGIN,  ///< 事务开始语句，可以在这里扩展只读事务
   SCF_COMMIT,
   SCF_CLOG_SYNC,
@@ -298,6 +347,7 @@ public:
   CreateIndexSqlNode  create_index;
   DropIndexSqlNode    drop_index;
   DescTableSqlNode    desc_table;
+  AnalyzeTableSqlNode analyze_table;
   LoadDataSqlNode     load_data;
   ExplainSqlNode      explain;
   SetVariableSqlNode  set_variable;
@@ -318,6 +368,12 @@ public:
 
   std::vector<std::unique_ptr<ParsedSqlNode>> &sql_nodes() { return sql_nodes_; }
 
+  /// @brief 语句中出现了一个参数(?)，返回它的序号
+  int add_param() { return param_num_++; }
+  /// @brief 语句中参数的个数
+  int param_num() const { return param_num_; }
+
 private:
   std::vector<std::unique_ptr<ParsedSqlNode>> sql_nodes_;  ///< 这里记录SQL命令。虽然看起来支持多个，但是当前仅处理一个
+  int                                         param_num_ = 0;
 };
@@ -178,78 +178,99 @@ enum yysymbol_kind_t
   YYSYMBOL_STRING_T = 26,                  /* STRING_T  */
   YYSYMBOL_FLOAT_T = 27,                   /* FLOAT_T  */
   YYSYMBOL_VECTOR_T = 28,                  /* VECTOR_T  */
-  YYSYMBOL_HELP = 29,                      /* HELP  */
-  YYSYMBOL_EXIT = 30,                      /* EXIT  */
-  YYSYMBOL_DOT = 31,                       /* DOT  */
-  YYSYMBOL_INTO = 32,                      /* INTO  */
-  YYSYMBOL_VALUES = 33,                    /* VALUES  */
-  YYSYMBOL_FROM = 34,                      /* FROM  */
-  YYSYMBOL_WHERE = 35,                     /* WHERE  */
-  YYSYMBOL_AND = 36,                       /* AND  */
-  YYSYMBOL_SET = 37,                       /* SET  */
-  YYSYMBOL_ON = 38,                        /* ON  */
-  YYSYMBOL_LOAD = 39,                      /* LOAD  */
-  YYSYMBOL_DATA = 40,                      /* DATA  */
-  YYSYMBOL_INFILE = 41,                    /* INFILE  */
-  YYSYMBOL_EXPLAIN = 42,                   /* EXPLAIN  */
-  YYSYMBOL_STORAGE = 43,                   /* STORAGE  */
-  YYSYMBOL_FORMAT = 44,                    /* FORMAT  */
-  YYSYMBOL_EQ = 45,                        /* EQ  */
-  YYSYMBOL_LT = 46,                        /* LT  */
-  YYSYMBOL_GT = 47,                        /* GT  */
-  YYSYMBOL_LE = 48,                        /* LE  */
-  YYSYMBOL_GE = 49,                        /* GE  */
-  YYSYMBOL_NE = 50,                        /* NE  */
-  YYSYMBOL_NUMBER = 51,                    /* NUMBER  */
-  YYSYMBOL_FLOAT = 52,                     /* FLOAT  */
-  YYSYMBOL_ID = 53,                        /* ID  */
-  YYSYMBOL_SSS = 54,                       /* SSS  */
-  YYSYMBOL_55_ = 55,                       /* '+'  */
-  YYSYMBOL_56_ = 56,                       /* '-'  */
-  YYSYMBOL_57_ = 57,                       /* '*'  */
-  YYSYMBOL_58_ = 58,                       /* '/'  */
-  YYSYMBOL_UMINUS = 59,                    /* UMINUS  */
-  YYSYMBOL_YYACCEPT = 60,                  /* $accept  */
-  YYSYMBOL_commands = 61,                  /* commands  */
-  YYSYMBOL_command_wrapper = 62,           /* command_wrapper  */
-  YYSYMBOL_exit_stmt = 63,                 /* exit_stmt  */
-  YYSYMBOL_help_stmt = 64,                 /* help_stmt  */
-  YYSYMBOL_sync_stmt = 65,                 /* sync_stmt  */
-  YYSYMBOL_begin_stmt = 66,                /* begin_stmt  */
-  YYSYMBOL_commit_stmt = 67,               /* commit_stmt  */
-  YYSYMBOL_rollback_stmt = 68,             /* rollback_stmt  */
-  YYSYMBOL_drop_table_stmt = 69,           /* drop_table_stmt  */
-  YYSYMBOL_show_tables_stmt = 70,          /* show_tables_stmt  */
-  YYSYMBOL_desc_table_stmt = 71,           /* desc_table_stmt  */
-  YYSYMBOL_create_index_stmt = 72,         /* create_index_stmt  */
-  YYSYMBOL_drop_index_stmt = 73,           /* drop_index_stmt  */
-  YYSYMBOL_create_table_stmt = 74,         /* create_table_stmt  */
-  YYSYMBOL_attr_def_list = 75,             /* attr_def_list  */
-  YYSYMBOL_attr_def = 76,                  /* attr_def  */
-  YYSYMBOL_number = 77,                    /* number  */
-  YYSYMBOL_type = 78,                      /* type  */
-  YYSYMBOL_insert_stmt = 79,               /* insert_stmt  */
-  YYSYMBOL_value_list = 80,                /* value_list  */
-  YYSYMBOL_value = 81,                     /* value  */
-  YYSYMBOL_storage_format = 82,            /* storage_format  */
-  YYSYMBOL_delete_stmt = 83,               /* delete_stmt  */
-  YYSYMBOL_update_stmt = 84,               /* update_stmt  */
-  YYSYMBOL_select_stmt = 85,               /* select_stmt  */
-  YYSYMBOL_calc_stmt = 86,                 /* calc_stmt  */
-  YYSYMBOL_expression_list = 87,           /* expression_list  */
-  YYSYMBOL_expression = 88,                /* expression  */
-  YYSYMBOL_rel_attr = 89,                  /* rel_attr  */
-  YYSYMBOL_relation = 90,                  /* relation  */
-  YYSYMBOL_rel_list = 91,                  /* rel_list  */
-  YYSYMBOL_where = 92,                     /* where  */
-  YYSYMBOL_condition_list = 93,            /* condition_list  */
-  YYSYMBOL_condition = 94,                 /* condition  */
-  YYSYMBOL_comp_op = 95,                   /* comp_op  */
-  YYSYMBOL_group_by = 96,                  /* group_by  */
-  YYSYMBOL_load_data_stmt = 97,            /* load_data_stmt  */
-  YYSYMBOL_explain_stmt = 98,              /* explain_stmt  */
-  YYSYMBOL_set_variable_stmt = 99,         /* set_variable_stmt  */
-  YYSYMBOL_opt_semicolon = 100             /* opt_semicolon  */
+  YYSYMBOL_VARCHAR_T = 29,                 /* VARCHAR_T  */
+  YYSYMBOL_TEXT_T = 30,                    /* TEXT_T  */
+  YYSYMBOL_HELP = 31,                      /* HELP  */
+  YYSYMBOL_EXIT = 32,                      /* EXIT  */
+  YYSYMBOL_DOT = 33,                       /* DOT  */
+  YYSYMBOL_INTO = 34,                      /* INTO  */
+  YYSYMBOL_VALUES = 35,                    /* VALUES  */
+  YYSYMBOL_FROM = 36,                      /* FROM  */
+  YYSYMBOL_WHERE = 37,                     /* WHERE  */
+  YYSYMBOL_AND = 38,                       /* AND  */
+  YYSYMBOL_SET = 39,                       /* SET  */
+  YYSYMBOL_ON = 40,                        /* ON  */
+  YYSYMBOL_LOAD = 41,                      /* LOAD  */
+  YYSYMBOL_DATA = 42,                      /* DATA  */
+  YYSYMBOL_INFILE = 43,                    /* INFILE  */
+  YYSYMBOL_EXPLAIN = 44,                   /* EXPLAIN  */
+  YYSYMBOL_STORAGE = 45,                   /* STORAGE  */
+  YYSYMBOL_FORMAT = 46,                    /* FORMAT  */
+  YYSYMBOL_USING = 47,                     /* USING  */
+  YYSYMBOL_ORDER = 48,                     /* ORDER  */
+  YYSYMBOL_ASC = 49,                       /* ASC  */
+  YYSYMBOL_LIMIT = 50,                     /* LIMIT  */
+  YYSYMBOL_OFFSET = 51,                    /* OFFSET  */
+  YYSYMBOL_ANALYZE = 52,                   /* ANALYZE  */
+  YYSYMBOL_EQ = 53,                        /* EQ  */
+  YYSYMBOL_LT = 54,                        /* LT  */
+  YYSYMBOL_GT = 55,                        /* GT  */
+  YYSYMBOL_LE = 56,                        /* LE  */
+  YYSYMBOL_GE = 57,                        /* GE  */
+  YYSYMBOL_NE = 58,                        /* NE  */
+  YYSYMBOL_NUMBER = 59,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 60,                     /* FLOAT  */
+  YYSYMBOL_ID = 61,                        /* ID  */
+  YYSYMBOL_SSS = 62,                       /* SSS  */
+  YYSYMBOL_63_ = 63,                       /* '+'  */
+  YYSYMBOL_64_ = 64,                       /* '-'  */
+  YYSYMBOL_65_ = 65,                       /* '*'  */
+  YYSYMBOL_66_ = 66,                       /* '/'  */
+  YYSYMBOL_UMINUS = 67,                    /* UMINUS  */
+  YYSYMBOL_68_ = 68,                       /* '?'  */
+  YYSYMBOL_YYACCEPT = 69,                  /* $accept  */
+  YYSYMBOL_commands = 70,                  /* commands  */
+  YYSYMBOL_command_wrapper = 71,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 72,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 73,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 74,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 75,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 76,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 77,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 78,           /* drop_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 79,          /* show_tables_stmt  */
+  YYSYMBOL_desc_table_stmt = 80,           /* desc_table_stmt  */
+  YYSYMBOL_analyze_table_stmt = 81,        /* analyze_table_stmt  */
+  YYSYMBOL_create_index_stmt = 82,         /* create_index_stmt  */
+  YYSYMBOL_index_type = 83,                /* index_type  */
+  YYSYMBOL_drop_index_stmt = 84,           /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 85,         /* create_table_stmt  */
+  YYSYMBOL_attr_def_list = 86,             /* attr_def_list  */
+  YYSYMBOL_attr_def = 87,                  /* attr_def  */
+  YYSYMBOL_var_type = 88,                  /* var_type  */
+  YYSYMBOL_number = 89,                    /* number  */
+  YYSYMBOL_type = 90,                      /* type  */
+  YYSYMBOL_insert_stmt = 91,               /* insert_stmt  */
+  YYSYMBOL_value_row = 92,                 /* value_row  */
+  YYSYMBOL_value_row_list = 93,            /* value_row_list  */
+  YYSYMBOL_value_list = 94,                /* value_list  */
+  YYSYMBOL_value = 95,                     /* value  */
+  YYSYMBOL_storage_format = 96,            /* storage_format  */
+  YYSYMBOL_delete_stmt = 97,               /* delete_stmt  */
+  YYSYMBOL_update_stmt = 98,               /* update_stmt  */
+  YYSYMBOL_set_clause_list = 99,           /* set_clause_list  */
+  YYSYMBOL_set_clause = 100,               /* set_clause  */
+  YYSYMBOL_select_stmt = 101,              /* select_stmt  */
+  YYSYMBOL_calc_stmt = 102,                /* calc_stmt  */
+  YYSYMBOL_expression_list = 103,          /* expression_list  */
+  YYSYMBOL_expression = 104,               /* expression  */
+  YYSYMBOL_rel_attr = 105,                 /* rel_attr  */
+  YYSYMBOL_relation = 106,                 /* relation  */
+  YYSYMBOL_rel_list = 107,                 /* rel_list  */
+  YYSYMBOL_where = 108,                    /* where  */
+  YYSYMBOL_condition_list = 109,           /* condition_list  */
+  YYSYMBOL_condition = 110,                /* condition  */
+  YYSYMBOL_param = 111,                    /* param  */
+  YYSYMBOL_comp_op = 112,                  /* comp_op  */
+  YYSYMBOL_group_by = 113,                 /* group_by  */
+  YYSYMBOL_order_by = 114,                 /* order_by  */
+  YYSYMBOL_order_by_list = 115,            /* order_by_list  */
+  YYSYMBOL_order_by_item = 116,            /* order_by_item  */
+  YYSYMBOL_limit = 117,                    /* limit  */
+  YYSYMBOL_load_data_stmt = 118,           /* load_data_stmt  */
+  YYSYMBOL_explain_stmt = 119,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 120,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 121             /* opt_semicolon  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -578,21 +599,21 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  65
+#define YYFINAL  69
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   141
+#define YYLAST   220
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  60
+#define YYNTOKENS  69
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  41
+#define YYNNTS  53
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  92
+#define YYNRULES  124
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  166
+#define YYNSTATES  215
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK   310
+#define YYMAXUTOK   318
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
@@ -610,9 +631,9 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,    57,    55,     2,    56,     2,    58,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,    65,    63,     2,    64,     2,    66,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    68,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -637,23 +658,26 @@ static const yytype_int8 yytranslate[] =
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
-      59
+      55,    56,    57,    58,    59,    60,    61,    62,    67
 };
 
 #if YYDEBUG
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   189,   189,   197,   198,   199,   200,   201,   202,   203,
-     204,   205,   206,   207,   208,   209,   210,   211,   212,   213,
-     214,   215,   216,   220,   226,   231,   237,   243,   249,   255,
-     262,   268,   276,   290,   300,   324,   327,   340,   348,   358,
-     361,   362,   363,   364,   367,   384,   387,   398,   402,   406,
-     415,   418,   425,   437,   452,   477,   486,   491,   502,   505,
-     508,   511,   514,   518,   521,   526,   532,   539,   544,   554,
-     559,   564,   578,   581,   587,   590,   595,   602,   614,   626,
-     638,   653,   654,   655,   656,   657,   658,   664,   669,   682,
-     690,   700,   701
+       0,   215,   215,   223,   224,   225,   226,   227,   228,   229,
+     230,   231,   232,   233,   234,   235,   236,   237,   238,   239,
+     240,   241,   242,   243,   247,   253,   258,   264,   270,   276,
+     282,   289,   295,   303,   311,   330,   333,   340,   350,   374,
+     377,   390,   398,   406,   415,   427,   428,   431,   434,   435,
+     436,   437,   440,   456,   471,   474,   487,   490,   501,   505,
+     509,   518,   521,   528,   540,   554,   560,   568,   578,   613,
+     622,   627,   638,   641,   644,   647,   650,   654,   657,   662,
+     668,   675,   680,   690,   695,   700,   714,   717,   723,   726,
+     731,   738,   750,   762,   774,   786,   797,   808,   819,   830,
+     842,   849,   850,   851,   852,   853,   854,   860,   866,   869,
+     875,   881,   889,   894,   899,   908,   911,   916,   922,   930,
+     943,   948,   957,   967,   968
 };
 #endif
 
@@ -673,18 +697,22 @@ static const char *const yytname[] =
   "CREATE", "DROP", "GROUP", "TABLE", "TABLES", "INDEX", "CALC", "SELECT",
   "DESC", "SHOW", "SYNC", "INSERT", "DELETE", "UPDATE", "LBRACE", "RBRACE",
   "COMMA", "TRX_BEGIN", "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "STRING_T",
-  "FLOAT_T", "VECTOR_T", "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM",
-  "WHERE", "AND", "SET", "ON", "LOAD", "DATA", "INFILE", "EXPLAIN",
-  "STORAGE", "FORMAT", "EQ", "LT", "GT", "LE", "GE", "NE", "NUMBER",
-  "FLOAT", "ID", "SSS", "'+'", "'-'", "'*'", "'/'", "UMINUS", "$accept",
-  "commands", "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt",
-  "begin_stmt", "commit_stmt", "rollback_stmt", "drop_table_stmt",
-  "show_tables_stmt", "desc_table_stmt", "create_index_stmt",
+  "FLOAT_T", "VECTOR_T", "VARCHAR_T", "TEXT_T", "HELP", "EXIT", "DOT",
+  "INTO", "VALUES", "FROM", "WHERE", "AND", "SET", "ON", "LOAD", "DATA",
+  "INFILE", "EXPLAIN", "STORAGE", "FORMAT", "USING", "ORDER", "ASC",
+  "LIMIT", "OFFSET", "ANALYZE", "EQ", "LT", "GT", "LE", "GE", "NE",
+  "NUMBER", "FLOAT", "ID", "SSS", "'+'", "'-'", "'*'", "'/'", "UMINUS",
+  "'?'", "$accept", "commands", "command_wrapper", "exit_stmt",
+  "help_stmt", "sync_stmt", "begin_stmt", "commit_stmt", "rollback_stmt",
+  "drop_table_stmt", "show_tables_stmt", "desc_table_stmt",
+  "analyze_table_stmt", "create_index_stmt", "index_type",
   "drop_index_stmt", "create_table_stmt", "attr_def_list", "attr_def",
-  "number", "type", "insert_stmt", "value_list", "value", "storage_format",
-  "delete_stmt", "update_stmt", "select_stmt", "calc_stmt",
-  "expression_list", "expression", "rel_attr", "relation", "rel_list",
-  "where", "condition_list", "condition", "comp_op", "group_by",
+  "var_type", "number", "type", "insert_stmt", "value_row",
+  "value_row_list", "value_list", "value", "storage_format", "delete_stmt",
+  "update_stmt", "set_clause_list", "set_clause", "select_stmt",
+  "calc_stmt", "expression_list", "expression", "rel_attr", "relation",
+  "rel_list", "where", "condition_list", "condition", "param", "comp_op",
+  "group_by", "order_by", "order_by_list", "order_by_item", "limit",
   "load_data_stmt", "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
 };
 
@@ -695,7 +723,7 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-97)
+#define YYPACT_NINF (-149)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -707,25 +735,30 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-static const yytype_int8 yypact[] =
+static const yytype_int16 yypact[] =
 {
-      51,     6,    14,   -16,   -16,   -38,     2,   -97,    -5,    -3,
-     -24,   -97,   -97,   -97,   -97,   -97,   -23,    -6,    51,    32,
-      36,   -97,   -97,   -97,   -97,   -97,   -97,   -97,   -97,   -97,
-     -97,   -97,   -97,   -97,   -97,   -97,   -97,   -97,   -97,   -97,
-     -97,    -2,    17,    23,    25,   -16,   -97,   -97,    24,   -97,
-     -16,   -97,   -97,   -97,    -8,   -97,    45,   -97,   -97,    38,
-      39,    52,    49,    54,   -97,   -97,   -97,   -97,    77,    59,
-     -97,    60,   -12,    46,   -97,   -16,   -16,   -16,   -16,   -16,
-      47,    68,    67,    55,   -42,    53,    56,    57,    58,   -97,
-     -97,   -97,   -32,   -32,   -97,   -97,   -97,    91,    67,    94,
-     -47,   -97,    69,   -97,    83,    -7,    95,    98,   -97,    47,
-     -97,   -42,    37,    37,   -97,    82,   -42,   111,   -97,   -97,
-     -97,   -97,   101,    56,   102,    70,   -97,   -97,   100,   -97,
-     -97,   -97,   -97,   -97,   -97,   -47,   -47,   -47,    67,    71,
-      74,    95,    84,   106,   -42,   108,   -97,   -97,   -97,   -97,
-     -97,   -97,   -97,   -97,   109,   -97,    86,   -97,   -97,   100,
-     -97,   -97,    87,   -97,    78,   -97
+     112,     1,    10,   143,   143,   -30,    28,  -149,    29,    38,
+       3,  -149,  -149,  -149,  -149,  -149,     4,    37,   154,    81,
+      90,    88,  -149,  -149,  -149,  -149,  -149,  -149,  -149,  -149,
+    -149,  -149,  -149,  -149,  -149,  -149,  -149,  -149,  -149,  -149,
+    -149,  -149,  -149,    43,    44,    46,    47,   143,  -149,  -149,
+      77,  -149,   143,  -149,  -149,  -149,   -15,  -149,    76,  -149,
+    -149,    52,    54,    80,    63,    78,    70,  -149,    59,  -149,
+    -149,  -149,   113,    91,  -149,    93,     7,    79,  -149,   143,
+     143,   143,   143,   143,    84,   102,   101,    85,   -38,    86,
+    -149,  -149,    89,    94,    96,  -149,  -149,  -149,   -36,   -36,
+    -149,  -149,  -149,   118,   101,   123,   -45,  -149,    99,   101,
+     126,  -149,   115,    17,   133,   139,  -149,    84,  -149,   -38,
+     142,  -149,    42,    42,  -149,   135,    42,   -38,  -149,    85,
+     166,  -149,  -149,  -149,  -149,  -149,  -149,   156,   160,    89,
+     161,   119,  -149,   134,   162,   123,  -149,  -149,  -149,  -149,
+    -149,  -149,  -149,   -45,   -45,   -45,   -45,  -149,  -149,   127,
+     125,   125,   133,   144,   167,   186,   141,   -38,   172,   142,
+    -149,  -149,  -149,  -149,  -149,  -149,  -149,  -149,  -149,  -149,
+    -149,  -149,   174,   176,  -149,   151,  -149,   152,   143,   125,
+    -149,   162,  -149,  -149,  -149,  -149,   147,   140,  -149,   -10,
+    -149,   188,   -13,  -149,   149,  -149,  -149,  -149,   143,   125,
+     125,  -149,  -149,  -149,  -149
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -733,43 +766,50 @@ static const yytype_int8 yypact[] =
    means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,    25,     0,     0,
-       0,    26,    27,    28,    24,    23,     0,     0,     0,     0,
-      91,    22,    21,    14,    15,    16,    17,     9,    10,    11,
-      12,    13,     8,     5,     7,     6,     4,     3,    18,    19,
-      20,     0,     0,     0,     0,     0,    47,    48,    67,    49,
-       0,    66,    64,    55,    56,    65,     0,    31,    30,     0,
-       0,     0,     0,     0,    89,     1,    92,     2,     0,     0,
-      29,     0,     0,     0,    63,     0,     0,     0,     0,     0,
-       0,     0,    72,     0,     0,     0,     0,     0,     0,    62,
-      68,    57,    58,    59,    60,    61,    69,    70,    72,     0,
-      74,    52,     0,    90,     0,     0,    35,     0,    33,     0,
-      87,     0,     0,     0,    73,    75,     0,     0,    40,    41,
-      42,    43,    38,     0,     0,     0,    71,    54,    45,    81,
-      82,    83,    84,    85,    86,     0,     0,    74,    72,     0,
-       0,    35,    50,     0,     0,     0,    78,    80,    77,    79,
-      76,    53,    88,    39,     0,    36,     0,    34,    32,    45,
-      44,    37,     0,    46,     0,    51
+       0,     0,     0,     0,     0,     0,     0,    26,     0,     0,
+       0,    27,    28,    29,    25,    24,     0,     0,     0,     0,
+       0,   123,    23,    22,    15,    16,    17,    18,     9,    10,
+      11,    12,    13,    14,     8,     5,     7,     6,     4,     3,
+      19,    20,    21,     0,     0,     0,     0,     0,    58,    59,
+      81,    60,     0,    80,    78,    69,    70,    79,     0,    32,
+      31,     0,     0,     0,     0,     0,     0,   120,     0,     1,
+     124,     2,     0,     0,    30,     0,     0,     0,    77,     0,
+       0,     0,     0,     0,     0,     0,    86,     0,     0,     0,
+     121,    33,     0,     0,     0,    76,    82,    71,    72,    73,
+      74,    75,    83,    84,    86,     0,    88,    63,     0,    86,
+      65,   122,     0,     0,    39,     0,    37,     0,   107,     0,
+      54,   100,     0,     0,    87,    89,     0,     0,    64,     0,
+       0,    48,    49,    50,    51,    45,    46,    44,    42,     0,
+       0,     0,    85,   108,    56,     0,    52,   101,   102,   103,
+     104,   105,   106,     0,     0,    88,     0,    67,    66,     0,
+       0,     0,    39,    61,     0,     0,   115,     0,     0,    54,
+      92,    94,    98,    91,    93,    95,    90,    97,    96,    99,
+     119,    47,     0,     0,    40,     0,    38,    35,     0,     0,
+      68,    56,    53,    55,    43,    41,     0,     0,    34,   112,
+     109,   110,   116,    57,     0,    36,   114,   113,     0,     0,
+       0,    62,   111,   118,   117
 };
 
 /* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int16 yypgoto[] =
 {
-     -97,   -97,   115,   -97,   -97,   -97,   -97,   -97,   -97,   -97,
-     -97,   -97,   -97,   -97,   -97,    -1,    11,   -97,   -97,   -97,
-     -22,   -83,   -97,   -97,   -97,   -97,   -97,    -4,    27,   -77,
-     -97,    26,   -96,     1,   -97,    28,   -97,   -97,   -97,   -97,
-     -97
+    -149,  -149,   -14,  -149,  -149,  -149,  -149,  -149,  -149,  -149,
+    -149,  -149,  -149,  -149,  -149,  -149,  -149,    49,    73,  -149,
+    -148,  -149,  -149,    68,    45,    24,   -87,  -149,  -149,  -149,
+      87,  -149,  -149,  -149,    -2,   -47,   -96,  -149,   100,   -97,
+      64,  -149,  -128,   -20,  -149,  -149,    12,  -149,  -149,  -149,
+    -149,  -149,  -149
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
-       0,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,    31,    32,   124,   106,   154,   122,    33,
-     145,    52,   157,    34,    35,    36,    37,    53,    54,    55,
-      97,    98,   101,   114,   115,   135,   127,    38,    39,    40,
-      67
+       0,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,   198,    33,    34,   140,   114,   137,
+     182,   138,    35,   120,   146,   168,    54,   186,    36,    37,
+     109,   110,    38,    39,    55,    56,    57,   103,   104,   107,
+     124,   125,   126,   153,   143,   166,   200,   201,   190,    40,
+      41,    42,    71
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -777,40 +817,56 @@ static const yytype_uint8 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      56,   103,   110,    45,    46,    47,    48,    49,    89,    46,
-      47,    58,    49,    75,    41,    57,    42,   112,   118,   119,
-     120,   121,    43,   113,    44,    78,    79,    59,   128,    61,
-      62,    60,    65,   138,    63,    46,    47,    48,    49,    66,
-      50,    51,   151,    76,    77,    78,    79,    76,    77,    78,
-      79,    68,   146,   148,   112,    73,     1,     2,   147,   149,
-     113,   159,     3,     4,     5,     6,     7,     8,     9,    10,
-      69,    91,    72,    11,    12,    13,    70,    74,    71,    80,
-      14,    15,   129,   130,   131,   132,   133,   134,    16,    83,
-      17,    81,    82,    18,    84,    85,    86,    87,    88,    90,
-      96,    99,   100,    92,    93,    94,    95,   104,   102,   105,
-     107,   108,   109,   111,   116,   117,   123,   125,   137,   139,
-     140,   144,   142,   143,   152,   153,   158,   156,   160,   161,
-     162,   165,   164,    64,   141,   126,     0,   163,   150,     0,
-     155,   136
+      76,   111,    58,   206,    67,    78,    79,   118,   209,    43,
+     123,    44,   128,   183,    48,    49,    50,    51,    45,   122,
+      46,    48,    49,   121,    51,   172,   175,    95,   179,    82,
+      83,    59,   144,    98,    99,   100,   101,    60,   210,   207,
+     157,   202,   131,   132,   133,   134,   135,   136,    80,    81,
+      82,    83,    90,    80,    81,    82,    83,   171,   174,   123,
+     178,   213,   214,    61,    63,    64,   170,   173,   122,   177,
+      80,    81,    82,    83,    62,     1,     2,    97,    68,    65,
+     191,     3,     4,     5,     6,     7,     8,     9,    10,    68,
+      69,    70,    11,    12,    13,   147,   148,   149,   150,   151,
+     152,    14,    15,   154,    72,    73,   156,    74,    75,    16,
+      77,    17,    84,    85,    18,    86,    88,     1,     2,    87,
+      91,    89,    19,     3,     4,     5,     6,     7,     8,     9,
+      10,    93,    92,    94,    11,    12,    13,   105,   106,   117,
+      96,   199,   119,    14,    15,   102,   108,   129,   112,   130,
+     113,    16,   127,    17,   139,   115,    18,   116,   141,     1,
+       2,   199,    47,   145,    19,     3,     4,     5,     6,     7,
+       8,     9,    10,   155,   159,   160,    11,    12,    13,   161,
+     164,   163,   165,   167,   181,    14,    15,   187,   180,   185,
+     188,   189,   192,    16,   194,    17,   195,   196,    18,   197,
+     204,   205,    48,    49,    50,    51,    66,    52,    53,   208,
+     211,   184,   162,   169,   193,   203,   158,   142,     0,   176,
+     212
 };
 
 static const yytype_int16 yycheck[] =
 {
-       4,    84,    98,    19,    51,    52,    53,    54,    20,    51,
-      52,     9,    54,    21,     8,    53,    10,   100,    25,    26,
-      27,    28,     8,   100,    10,    57,    58,    32,   111,    53,
-      53,    34,     0,   116,    40,    51,    52,    53,    54,     3,
-      56,    57,   138,    55,    56,    57,    58,    55,    56,    57,
-      58,    53,   135,   136,   137,    31,     5,     6,   135,   136,
-     137,   144,    11,    12,    13,    14,    15,    16,    17,    18,
-      53,    75,    45,    22,    23,    24,    53,    50,    53,    34,
-      29,    30,    45,    46,    47,    48,    49,    50,    37,    37,
-      39,    53,    53,    42,    45,    41,    19,    38,    38,    53,
-      53,    33,    35,    76,    77,    78,    79,    54,    53,    53,
-      53,    53,    21,    19,    45,    32,    21,    19,    36,     8,
-      19,    21,    20,    53,    53,    51,    20,    43,    20,    20,
-      44,    53,    45,    18,   123,   109,    -1,   159,   137,    -1,
-     141,   113
+      47,    88,     4,    13,    18,    52,    21,   104,    21,     8,
+     106,    10,   109,   161,    59,    60,    61,    62,     8,   106,
+      10,    59,    60,    68,    62,   153,   154,    20,   156,    65,
+      66,    61,   119,    80,    81,    82,    83,     9,    51,    49,
+     127,   189,    25,    26,    27,    28,    29,    30,    63,    64,
+      65,    66,    66,    63,    64,    65,    66,   153,   154,   155,
+     156,   209,   210,    34,    61,    61,   153,   154,   155,   156,
+      63,    64,    65,    66,    36,     5,     6,    79,     8,    42,
+     167,    11,    12,    13,    14,    15,    16,    17,    18,     8,
+       0,     3,    22,    23,    24,    53,    54,    55,    56,    57,
+      58,    31,    32,   123,    61,    61,   126,    61,    61,    39,
+      33,    41,    36,    61,    44,    61,    53,     5,     6,    39,
+      61,    43,    52,    11,    12,    13,    14,    15,    16,    17,
+      18,    40,    19,    40,    22,    23,    24,    35,    37,    21,
+      61,   188,    19,    31,    32,    61,    61,    21,    62,    34,
+      61,    39,    53,    41,    21,    61,    44,    61,    19,     5,
+       6,   208,    19,    21,    52,    11,    12,    13,    14,    15,
+      16,    17,    18,    38,     8,    19,    22,    23,    24,    19,
+      61,    20,    48,    21,    59,    31,    32,    20,    61,    45,
+       4,    50,    20,    39,    20,    41,    20,    46,    44,    47,
+      53,    61,    59,    60,    61,    62,    52,    64,    65,    21,
+      61,   162,   139,   145,   169,   191,   129,   117,    -1,   155,
+     208
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -818,37 +874,45 @@ static const yytype_int16 yycheck[] =
 static const yytype_int8 yystos[] =
 {
        0,     5,     6,    11,    12,    13,    14,    15,    16,    17,
-      18,    22,    23,    24,    29,    30,    37,    39,    42,    61,
-      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
-      72,    73,    74,    79,    83,    84,    85,    86,    97,    98,
-      99,     8,    10,     8,    10,    19,    51,    52,    53,    54,
-      56,    57,    81,    87,    88,    89,    87,    53,     9,    32,
-      34,    53,    53,    40,    62,     0,     3,   100,    53,    53,
-      53,    53,    88,    31,    88,    21,    55,    56,    57,    58,
-      34,    53,    53,    37,    45,    41,    19,    38,    38,    20,
-      53,    87,    88,    88,    88,    88,    53,    90,    91,    33,
-      35,    92,    53,    81,    54,    53,    76,    53,    53,    21,
-      92,    19,    81,    89,    93,    94,    45,    32,    25,    26,
-      27,    28,    78,    21,    75,    19,    91,    96,    81,    45,
-      46,    47,    48,    49,    50,    95,    95,    36,    81,     8,
-      19,    76,    20,    53,    21,    80,    81,    89,    81,    89,
-      93,    92,    53,    51,    77,    75,    43,    82,    20,    81,
-      20,    20,    44,    80,    45,    53
+      18,    22,    23,    24,    31,    32,    39,    41,    44,    52,
+      70,    71,    72,    73,    74,    75,    76,    77,    78,    79,
+      80,    81,    82,    84,    85,    91,    97,    98,   101,   102,
+     118,   119,   120,     8,    10,     8,    10,    19,    59,    60,
+      61,    62,    64,    65,    95,   103,   104,   105,   103,    61,
+       9,    34,    36,    61,    61,    42,    52,    71,     8,     0,
+       3,   121,    61,    61,    61,    61,   104,    33,   104,    21,
+      63,    64,    65,    66,    36,    61,    61,    39,    53,    43,
+      71,    61,    19,    40,    40,    20,    61,   103,   104,   104,
+     104,   104,    61,   106,   107,    35,    37,   108,    61,    99,
+     100,    95,    62,    61,    87,    61,    61,    21,   108,    19,
+      92,    68,    95,   105,   109,   110,   111,    53,   108,    21,
+      34,    25,    26,    27,    28,    29,    30,    88,    90,    21,
+      86,    19,   107,   113,    95,    21,    93,    53,    54,    55,
+      56,    57,    58,   112,   112,    38,   112,    95,    99,     8,
+      19,    19,    87,    20,    61,    48,   114,    21,    94,    92,
+      95,   105,   111,    95,   105,   111,   109,    95,   105,   111,
+      61,    59,    89,    89,    86,    45,    96,    20,     4,    50,
+     117,    95,    20,    93,    20,    20,    46,    47,    83,   104,
+     115,   116,    89,    94,    53,    61,    13,    49,    21,    21,
+      51,    61,   115,    89,    89
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
-       0,    60,    61,    62,    62,    62,    62,    62,    62,    62,
-      62,    62,    62,    62,    62,    62,    62,    62,    62,    62,
-      62,    62,    62,    63,    64,    65,    66,    67,    68,    69,
-      70,    71,    72,    73,    74,    75,    75,    76,    76,    77,
-      78,    78,    78,    78,    79,    80,    80,    81,    81,    81,
-      82,    82,    83,    84,    85,    86,    87,    87,    88,    88,
-      88,    88,    88,    88,    88,    88,    88,    89,    89,    90,
-      91,    91,    92,    92,    93,    93,    93,    94,    94,    94,
-      94,    95,    95,    95,    95,    95,    95,    96,    97,    98,
-      99,   100,   100
+       0,    69,    70,    71,    71,    71,    71,    71,    71,    71,
+      71,    71,    71,    71,    71,    71,    71,    71,    71,    71,
+      71,    71,    71,    71,    72,    73,    74,    75,    76,    77,
+      78,    79,    80,    81,    82,    83,    83,    84,    85,    86,
+      86,    87,    87,    87,    87,    88,    88,    89,    90,    90,
+      90,    90,    91,    92,    93,    93,    94,    94,    95,    95,
+      95,    96,    96,    97,    98,    99,    99,   100,   101,   102,
+     103,   103,   104,   104,   104,   104,   104,   104,   104,   104,
+     104,   105,   105,   106,   107,   107,   108,   108,   109,   109,
+     109,   110,   110,   110,   110,   110,   110,   110,   110,   110,
+     111,   112,   112,   112,   112,   112,   112,   113,   114,   114,
+     115,   115,   116,   116,   116,   117,   117,   117,   117,   118,
+     119,   119,   120,   121,   121
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -856,14 +920,17 @@ static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
-       2,     2,     8,     5,     8,     0,     3,     5,     2,     1,
-       1,     1,     1,     1,     8,     0,     3,     1,     1,     1,
-       0,     4,     4,     7,     6,     2,     1,     3,     3,     3,
-       3,     3,     3,     2,     1,     1,     1,     1,     3,     1,
-       1,     3,     0,     2,     0,     1,     3,     3,     3,     3,
-       3,     1,     1,     1,     1,     1,     1,     0,     7,     2,
-       4,     0,     1
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       3,     2,     2,     3,     9,     0,     2,     5,     8,     0,
+       3,     5,     2,     5,     2,     1,     1,     1,     1,     1,
+       1,     1,     6,     4,     0,     3,     0,     3,     1,     1,
+       1,     0,     4,     4,     5,     1,     3,     3,     8,     2,
+       1,     3,     3,     3,     3,     3,     3,     2,     1,     1,
+       1,     1,     3,     1,     1,     3,     0,     2,     0,     1,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       1,     1,     1,     1,     1,     1,     1,     0,     0,     3,
+       1,     3,     1,     2,     2,     0,     2,     4,     4,     7,
+       2,     3,     4,     0,     1
 };
 
 
@@ -1725,108 +1792,138 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* commands: command_wrapper opt_semicolon  */
-#line 190 "yacc_sql.y"
+#line 216 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1734 "yacc_sql.cpp"
+#line 1801 "yacc_sql.cpp"
     break;
 
-  case 23: /* exit_stmt: EXIT  */
-#line 220 "yacc_sql.y"
+  case 24: /* exit_stmt: EXIT  */
+#line 247 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1743 "yacc_sql.cpp"
+#line 1810 "yacc_sql.cpp"
     break;
 
-  case 24: /* help_stmt: HELP  */
-#line 226 "yacc_sql.y"
+  case 25: /* help_stmt: HELP  */
+#line 253 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1751 "yacc_sql.cpp"
+#line 1818 "yacc_sql.cpp"
     break;
 
-  case 25: /* sync_stmt: SYNC  */
-#line 231 "yacc_sql.y"
+  case 26: /* sync_stmt: SYNC  */
+#line 258 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1759 "yacc_sql.cpp"
+#line 1826 "yacc_sql.cpp"
     break;
 
-  case 26: /* begin_stmt: TRX_BEGIN  */
-#line 237 "yacc_sql.y"
+  case 27: /* begin_stmt: TRX_BEGIN  */
+#line 264 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1767 "yacc_sql.cpp"
+#line 1834 "yacc_sql.cpp"
     break;
 
-  case 27: /* commit_stmt: TRX_COMMIT  */
-#line 243 "yacc_sql.y"
+  case 28: /* commit_stmt: TRX_COMMIT  */
+#line 270 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1775 "yacc_sql.cpp"
+#line 1842 "yacc_sql.cpp"
     break;
 
-  case 28: /* rollback_stmt: TRX_ROLLBACK  */
-#line 249 "yacc_sql.y"
+  case 29: /* rollback_stmt: TRX_ROLLBACK  */
+#line 276 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1783 "yacc_sql.cpp"
+#line 1850 "yacc_sql.cpp"
     break;
 
-  case 29: /* drop_table_stmt: DROP TABLE ID  */
-#line 255 "yacc_sql.y"
+  case 30: /* drop_table_stmt: DROP TABLE ID  */
+#line 282 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1793 "yacc_sql.cpp"
+#line 1860 "yacc_sql.cpp"
     break;
 
-  case 30: /* show_tables_stmt: SHOW TABLES  */
-#line 262 "yacc_sql.y"
+  case 31: /* show_tables_stmt: SHOW TABLES  */
+#line 289 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 1801 "yacc_sql.cpp"
+#line 1868 "yacc_sql.cpp"
     break;
 
-  case 31: /* desc_table_stmt: DESC ID  */
-#line 268 "yacc_sql.y"
+  case 32: /* desc_table_stmt: DESC ID  */
+#line 295 "yacc_sql.y"
              {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
       (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1811 "yacc_sql.cpp"
+#line 1878 "yacc_sql.cpp"
+    break;
+
+  case 33: /* analyze_table_stmt: ANALYZE TABLE ID  */
+#line 303 "yacc_sql.y"
+                      {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+      (yyval.sql_node)->analyze_table.relation_name = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 1888 "yacc_sql.cpp"
     break;
 
-  case 32: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID RBRACE  */
-#line 277 "yacc_sql.y"
+  case 34: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID RBRACE index_type  */
+#line 312 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
-      create_index.index_name = (yyvsp[-5].string);
-      create_index.relation_name = (yyvsp[-3].string);
-      create_index.attribute_name = (yyvsp[-1].string);
-      free((yyvsp[-5].string));
-      free((yyvsp[-3].string));
-      free((yyvsp[-1].string));
+      create_index.index_name = (yyvsp[-6].string);
+      create_index.relation_name = (yyvsp[-4].string);
+      create_index.attribute_name = (yyvsp[-2].string);
+      free((yyvsp[-6].string));
+      free((yyvsp[-4].string));
+      free((yyvsp[-2].string));
+      if ((yyvsp[0].string) != nullptr) {
+        create_index.index_type = (yyvsp[0].string);
+        free((yyvsp[0].string));
+      }
     }
-#line 1826 "yacc_sql.cpp"
+#line 1907 "yacc_sql.cpp"
     break;
 
-  case 33: /* drop_index_stmt: DROP INDEX ID ON ID  */
-#line 291 "yacc_sql.y"
+  case 35: /* index_type: %empty  */
+#line 330 "yacc_sql.y"
+    {
+      (yyval.string) = nullptr;
+    }
+#line 1915 "yacc_sql.cpp"
+    break;
+
+  case 36: /* index_type: USING ID  */
+#line 334 "yacc_sql.y"
+    {
+      (yyval.string) = (yyvsp[0].string);
+    }
+#line 1923 "yacc_sql.cpp"
+    break;
+
+  case 37: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 341 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -1834,11 +1931,11 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 1838 "yacc_sql.cpp"
+#line 1935 "yacc_sql.cpp"
     break;
 
-  case 34: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format  */
-#line 301 "yacc_sql.y"
+  case 38: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format  */
+#line 351 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
@@ -1859,19 +1956,19 @@ yyreduce:
         free((yyvsp[0].string));
       }
     }
-#line 1863 "yacc_sql.cpp"
+#line 1960 "yacc_sql.cpp"
     break;
 
-  case 35: /* attr_def_list: %empty  */
-#line 324 "yacc_sql.y"
+  case 39: /* attr_def_list: %empty  */
+#line 374 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 1871 "yacc_sql.cpp"
+#line 1968 "yacc_sql.cpp"
     break;
 
-  case 36: /* attr_def_list: COMMA attr_def attr_def_list  */
-#line 328 "yacc_sql.y"
+  case 40: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 378 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -1881,11 +1978,11 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 1885 "yacc_sql.cpp"
+#line 1982 "yacc_sql.cpp"
     break;
 
-  case 37: /* attr_def: ID type LBRACE number RBRACE  */
-#line 341 "yacc_sql.y"
+  case 41: /* attr_def: ID type LBRACE number RBRACE  */
+#line 391 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
@@ -1893,11 +1990,11 @@ yyreduce:
       (yyval.attr_info)->length = (yyvsp[-1].number);
       free((yyvsp[-4].string));
     }
-#line 1897 "yacc_sql.cpp"
+#line 1994 "yacc_sql.cpp"
     break;
 
-  case 38: /* attr_def: ID type  */
-#line 349 "yacc_sql.y"
+  case 42: /* attr_def: ID type  */
+#line 399 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
@@ -1905,66 +2002,141 @@ yyreduce:
       (yyval.attr_info)->length = 4;
       free((yyvsp[-1].string));
     }
-#line 1909 "yacc_sql.cpp"
+#line 2006 "yacc_sql.cpp"
+    break;
+
+  case 43: /* attr_def: ID var_type LBRACE number RBRACE  */
+#line 407 "yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = AttrType::CHARS;
+      (yyval.attr_info)->name = (yyvsp[-4].string);
+      (yyval.attr_info)->length = (yyvsp[-1].number);
+      (yyval.attr_info)->var_len = true;
+      free((yyvsp[-4].string));
+    }
+#line 2019 "yacc_sql.cpp"
+    break;
+
+  case 44: /* attr_def: ID var_type  */
+#line 416 "yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = AttrType::CHARS;
+      (yyval.attr_info)->name = (yyvsp[-1].string);
+      (yyval.attr_info)->length = (yyvsp[0].number);
+      (yyval.attr_info)->var_len = true;
+      free((yyvsp[-1].string));
+    }
+#line 2032 "yacc_sql.cpp"
     break;
 
-  case 39: /* number: NUMBER  */
-#line 358 "yacc_sql.y"
+  case 45: /* var_type: VARCHAR_T  */
+#line 427 "yacc_sql.y"
+              { (yyval.number) = 255; }
+#line 2038 "yacc_sql.cpp"
+    break;
+
+  case 46: /* var_type: TEXT_T  */
+#line 428 "yacc_sql.y"
+              { (yyval.number) = 4096; }
+#line 2044 "yacc_sql.cpp"
+    break;
+
+  case 47: /* number: NUMBER  */
+#line 431 "yacc_sql.y"
            {(yyval.number) = (yyvsp[0].number);}
-#line 1915 "yacc_sql.cpp"
+#line 2050 "yacc_sql.cpp"
     break;
 
-  case 40: /* type: INT_T  */
-#line 361 "yacc_sql.y"
+  case 48: /* type: INT_T  */
+#line 434 "yacc_sql.y"
                { (yyval.number) = static_cast<int>(AttrType::INTS); }
-#line 1921 "yacc_sql.cpp"
+#line 2056 "yacc_sql.cpp"
     break;
 
-  case 41: /* type: STRING_T  */
-#line 362 "yacc_sql.y"
+  case 49: /* type: STRING_T  */
+#line 435 "yacc_sql.y"
                { (yyval.number) = static_cast<int>(AttrType::CHARS); }
-#line 1927 "yacc_sql.cpp"
+#line 2062 "yacc_sql.cpp"
     break;
 
-  case 42: /* type: FLOAT_T  */
-#line 363 "yacc_sql.y"
+  case 50: /* type: FLOAT_T  */
+#line 436 "yacc_sql.y"
                { (yyval.number) = static_cast<int>(AttrType::FLOATS); }
-#line 1933 "yacc_sql.cpp"
+#line 2068 "yacc_sql.cpp"
     break;
 
-  case 43: /* type: VECTOR_T  */
-#line 364 "yacc_sql.y"
+  case 51: /* type: VECTOR_T  */
+#line 437 "yacc_sql.y"
                { (yyval.number) = static_cast<int>(AttrType::VECTORS); }
-#line 1939 "yacc_sql.cpp"
+#line 2074 "yacc_sql.cpp"
     break;
 
-  case 44: /* insert_stmt: INSERT INTO ID VALUES LBRACE value value_list RBRACE  */
-#line 368 "yacc_sql.y"
+  case 52: /* insert_stmt: INSERT INTO ID VALUES value_row value_row_list  */
+#line 441 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
-      (yyval.sql_node)->insertion.relation_name = (yyvsp[-5].string);
-      if ((yyvsp[-1].value_list) != nullptr) {
-        (yyval.sql_node)->insertion.values.swap(*(yyvsp[-1].value_list));
-        delete (yyvsp[-1].value_list);
+      (yyval.sql_node)->insertion.relation_name = (yyvsp[-3].string);
+      if ((yyvsp[0].value_rows) != nullptr) {
+        (yyval.sql_node)->insertion.values.swap(*(yyvsp[0].value_rows));
+        delete (yyvsp[0].value_rows);
       }
-      (yyval.sql_node)->insertion.values.emplace_back(*(yyvsp[-2].value));
+      (yyval.sql_node)->insertion.values.emplace_back(std::move(*(yyvsp[-1].value_list)));
       std::reverse((yyval.sql_node)->insertion.values.begin(), (yyval.sql_node)->insertion.values.end());
+      delete (yyvsp[-1].value_list);
+      free((yyvsp[-3].string));
+    }
+#line 2091 "yacc_sql.cpp"
+    break;
+
+  case 53: /* value_row: LBRACE value value_list RBRACE  */
+#line 457 "yacc_sql.y"
+    {
+      if ((yyvsp[-1].value_list) != nullptr) {
+        (yyval.value_list) = (yyvsp[-1].value_list);
+      } else {
+        (yyval.value_list) = new std::vector<Value>;
+      }
+      (yyval.value_list)->emplace_back(*(yyvsp[-2].value));
+      std::reverse((yyval.value_list)->begin(), (yyval.value_list)->end());
       delete (yyvsp[-2].value);
-      free((yyvsp[-5].string));
     }
-#line 1956 "yacc_sql.cpp"
+#line 2106 "yacc_sql.cpp"
+    break;
+
+  case 54: /* value_row_list: %empty  */
+#line 471 "yacc_sql.y"
+    {
+      (yyval.value_rows) = nullptr;
+    }
+#line 2114 "yacc_sql.cpp"
     break;
 
-  case 45: /* value_list: %empty  */
-#line 384 "yacc_sql.y"
+  case 55: /* value_row_list: COMMA value_row value_row_list  */
+#line 474 "yacc_sql.y"
+                                     {
+      if ((yyvsp[0].value_rows) != nullptr) {
+        (yyval.value_rows) = (yyvsp[0].value_rows);
+      } else {
+        (yyval.value_rows) = new std::vector<std::vector<Value>>;
+      }
+      (yyval.value_rows)->emplace_back(std::move(*(yyvsp[-1].value_list)));
+      delete (yyvsp[-1].value_list);
+    }
+#line 2128 "yacc_sql.cpp"
+    break;
+
+  case 56: /* value_list: %empty  */
+#line 487 "yacc_sql.y"
     {
       (yyval.value_list) = nullptr;
     }
-#line 1964 "yacc_sql.cpp"
+#line 2136 "yacc_sql.cpp"
     break;
 
-  case 46: /* value_list: COMMA value value_list  */
-#line 387 "yacc_sql.y"
+  case 57: /* value_list: COMMA value value_list  */
+#line 490 "yacc_sql.y"
                               { 
       if ((yyvsp[0].value_list) != nullptr) {
         (yyval.value_list) = (yyvsp[0].value_list);
@@ -1974,56 +2146,56 @@ yyreduce:
       (yyval.value_list)->emplace_back(*(yyvsp[-1].value));
       delete (yyvsp[-1].value);
     }
-#line 1978 "yacc_sql.cpp"
+#line 2150 "yacc_sql.cpp"
     break;
 
-  case 47: /* value: NUMBER  */
-#line 398 "yacc_sql.y"
+  case 58: /* value: NUMBER  */
+#line 501 "yacc_sql.y"
            {
       (yyval.value) = new Value((int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 1987 "yacc_sql.cpp"
+#line 2159 "yacc_sql.cpp"
     break;
 
-  case 48: /* value: FLOAT  */
-#line 402 "yacc_sql.y"
+  case 59: /* value: FLOAT  */
+#line 505 "yacc_sql.y"
            {
       (yyval.value) = new Value((float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 1996 "yacc_sql.cpp"
+#line 2168 "yacc_sql.cpp"
     break;
 
-  case 49: /* value: SSS  */
-#line 406 "yacc_sql.y"
+  case 60: /* value: SSS  */
+#line 509 "yacc_sql.y"
          {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
       free((yyvsp[0].string));
     }
-#line 2007 "yacc_sql.cpp"
+#line 2179 "yacc_sql.cpp"
     break;
 
-  case 50: /* storage_format: %empty  */
-#line 415 "yacc_sql.y"
+  case 61: /* storage_format: %empty  */
+#line 518 "yacc_sql.y"
     {
       (yyval.string) = nullptr;
     }
-#line 2015 "yacc_sql.cpp"
+#line 2187 "yacc_sql.cpp"
     break;
 
-  case 51: /* storage_format: STORAGE FORMAT EQ ID  */
-#line 419 "yacc_sql.y"
+  case 62: /* storage_format: STORAGE FORMAT EQ ID  */
+#line 522 "yacc_sql.y"
     {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2023 "yacc_sql.cpp"
+#line 2195 "yacc_sql.cpp"
     break;
 
-  case 52: /* delete_stmt: DELETE FROM ID where  */
-#line 426 "yacc_sql.y"
+  case 63: /* delete_stmt: DELETE FROM ID where  */
+#line 529 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -2033,74 +2205,115 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2037 "yacc_sql.cpp"
+#line 2209 "yacc_sql.cpp"
     break;
 
-  case 53: /* update_stmt: UPDATE ID SET ID EQ value where  */
-#line 438 "yacc_sql.y"
+  case 64: /* update_stmt: UPDATE ID SET set_clause_list where  */
+#line 541 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
-      (yyval.sql_node)->update.relation_name = (yyvsp[-5].string);
-      (yyval.sql_node)->update.attribute_name = (yyvsp[-3].string);
-      (yyval.sql_node)->update.value = *(yyvsp[-1].value);
+      (yyval.sql_node)->update.relation_name = (yyvsp[-3].string);
+      (yyval.sql_node)->update.set_clauses.swap(*(yyvsp[-1].set_clause_list));
+      delete (yyvsp[-1].set_clause_list);
       if ((yyvsp[0].condition_list) != nullptr) {
         (yyval.sql_node)->update.conditions.swap(*(yyvsp[0].condition_list));
         delete (yyvsp[0].condition_list);
       }
-      free((yyvsp[-5].string));
       free((yyvsp[-3].string));
     }
-#line 2054 "yacc_sql.cpp"
+#line 2225 "yacc_sql.cpp"
+    break;
+
+  case 65: /* set_clause_list: set_clause  */
+#line 555 "yacc_sql.y"
+    {
+      (yyval.set_clause_list) = new std::vector<SetClauseSqlNode>;
+      (yyval.set_clause_list)->emplace_back(std::move(*(yyvsp[0].set_clause)));
+      delete (yyvsp[0].set_clause);
+    }
+#line 2235 "yacc_sql.cpp"
     break;
 
-  case 54: /* select_stmt: SELECT expression_list FROM rel_list where group_by  */
-#line 453 "yacc_sql.y"
+  case 66: /* set_clause_list: set_clause COMMA set_clause_list  */
+#line 561 "yacc_sql.y"
+    {
+      (yyval.set_clause_list) = (yyvsp[0].set_clause_list);
+      (yyval.set_clause_list)->emplace((yyval.set_clause_list)->begin(), std::move(*(yyvsp[-2].set_clause)));
+      delete (yyvsp[-2].set_clause);
+    }
+#line 2245 "yacc_sql.cpp"
+    break;
+
+  case 67: /* set_clause: ID EQ value  */
+#line 569 "yacc_sql.y"
+    {
+      (yyval.set_clause) = new SetClauseSqlNode;
+      (yyval.set_clause)->attribute_name = (yyvsp[-2].string);
+      (yyval.set_clause)->value = *(yyvsp[0].value);
+      delete (yyvsp[0].value);
+      free((yyvsp[-2].string));
+    }
+#line 2257 "yacc_sql.cpp"
+    break;
+
+  case 68: /* select_stmt: SELECT expression_list FROM rel_list where group_by order_by limit  */
+#line 579 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
-      if ((yyvsp[-4].expression_list) != nullptr) {
-        (yyval.sql_node)->selection.expressions.swap(*(yyvsp[-4].expression_list));
-        delete (yyvsp[-4].expression_list);
+      if ((yyvsp[-6].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.expressions.swap(*(yyvsp[-6].expression_list));
+        delete (yyvsp[-6].expression_list);
       }
 
-      if ((yyvsp[-2].relation_list) != nullptr) {
-        (yyval.sql_node)->selection.relations.swap(*(yyvsp[-2].relation_list));
-        delete (yyvsp[-2].relation_list);
+      if ((yyvsp[-4].relation_list) != nullptr) {
+        (yyval.sql_node)->selection.relations.swap(*(yyvsp[-4].relation_list));
+        delete (yyvsp[-4].relation_list);
       }
 
-      if ((yyvsp[-1].condition_list) != nullptr) {
-        (yyval.sql_node)->selection.conditions.swap(*(yyvsp[-1].condition_list));
-        delete (yyvsp[-1].condition_list);
+      if ((yyvsp[-3].condition_list) != nullptr) {
+        (yyval.sql_node)->selection.conditions.swap(*(yyvsp[-3].condition_list));
+        delete (yyvsp[-3].condition_list);
       }
 
-      if ((yyvsp[0].expression_list) != nullptr) {
-        (yyval.sql_node)->selection.group_by.swap(*(yyvsp[0].expression_list));
-        delete (yyvsp[0].expression_list);
+      if ((yyvsp[-2].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.group_by.swap(*(yyvsp[-2].expression_list));
+        delete (yyvsp[-2].expression_list);
+      }
+
+      if ((yyvsp[-1].order_by_list) != nullptr) {
+        (yyval.sql_node)->selection.order_by.swap(*(yyvsp[-1].order_by_list));
+        delete (yyvsp[-1].order_by_list);
+      }
+
+      if ((yyvsp[0].limit) != nullptr) {
+        (yyval.sql_node)->selection.limit = *(yyvsp[0].limit);
+        delete (yyvsp[0].limit);
       }
     }
-#line 2081 "yacc_sql.cpp"
+#line 2294 "yacc_sql.cpp"
     break;
 
-  case 55: /* calc_stmt: CALC expression_list  */
-#line 478 "yacc_sql.y"
+  case 69: /* calc_stmt: CALC expression_list  */
+#line 614 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2091 "yacc_sql.cpp"
+#line 2304 "yacc_sql.cpp"
     break;
 
-  case 56: /* expression_list: expression  */
-#line 487 "yacc_sql.y"
+  case 70: /* expression_list: expression  */
+#line 623 "yacc_sql.y"
     {
       (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
       (yyval.expression_list)->emplace_back((yyvsp[0].expression));
     }
-#line 2100 "yacc_sql.cpp"
+#line 2313 "yacc_sql.cpp"
     break;
 
-  case 57: /* expression_list: expression COMMA expression_list  */
-#line 492 "yacc_sql.y"
+  case 71: /* expression_list: expression COMMA expression_list  */
+#line 628 "yacc_sql.y"
     {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2109,99 +2322,99 @@ yyreduce:
       }
       (yyval.expression_list)->emplace((yyval.expression_list)->begin(), (yyvsp[-2].expression));
     }
-#line 2113 "yacc_sql.cpp"
+#line 2326 "yacc_sql.cpp"
     break;
 
-  case 58: /* expression: expression '+' expression  */
-#line 502 "yacc_sql.y"
+  case 72: /* expression: expression '+' expression  */
+#line 638 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2121 "yacc_sql.cpp"
+#line 2334 "yacc_sql.cpp"
     break;
 
-  case 59: /* expression: expression '-' expression  */
-#line 505 "yacc_sql.y"
+  case 73: /* expression: expression '-' expression  */
+#line 641 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2129 "yacc_sql.cpp"
+#line 2342 "yacc_sql.cpp"
     break;
 
-  case 60: /* expression: expression '*' expression  */
-#line 508 "yacc_sql.y"
+  case 74: /* expression: expression '*' expression  */
+#line 644 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2137 "yacc_sql.cpp"
+#line 2350 "yacc_sql.cpp"
     break;
 
-  case 61: /* expression: expression '/' expression  */
-#line 511 "yacc_sql.y"
+  case 75: /* expression: expression '/' expression  */
+#line 647 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2145 "yacc_sql.cpp"
+#line 2358 "yacc_sql.cpp"
     break;
 
-  case 62: /* expression: LBRACE expression RBRACE  */
-#line 514 "yacc_sql.y"
+  case 76: /* expression: LBRACE expression RBRACE  */
+#line 650 "yacc_sql.y"
                                {
       (yyval.expression) = (yyvsp[-1].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2154 "yacc_sql.cpp"
+#line 2367 "yacc_sql.cpp"
     break;
 
-  case 63: /* expression: '-' expression  */
-#line 518 "yacc_sql.y"
+  case 77: /* expression: '-' expression  */
+#line 654 "yacc_sql.y"
                                   {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
     }
-#line 2162 "yacc_sql.cpp"
+#line 2375 "yacc_sql.cpp"
     break;
 
-  case 64: /* expression: value  */
-#line 521 "yacc_sql.y"
+  case 78: /* expression: value  */
+#line 657 "yacc_sql.y"
             {
       (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value);
     }
-#line 2172 "yacc_sql.cpp"
+#line 2385 "yacc_sql.cpp"
     break;
 
-  case 65: /* expression: rel_attr  */
-#line 526 "yacc_sql.y"
+  case 79: /* expression: rel_attr  */
+#line 662 "yacc_sql.y"
                {
       RelAttrSqlNode *node = (yyvsp[0].rel_attr);
       (yyval.expression) = new UnboundFieldExpr(node->relation_name, node->attribute_name);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].rel_attr);
     }
-#line 2183 "yacc_sql.cpp"
+#line 2396 "yacc_sql.cpp"
     break;
 
-  case 66: /* expression: '*'  */
-#line 532 "yacc_sql.y"
+  case 80: /* expression: '*'  */
+#line 668 "yacc_sql.y"
           {
       (yyval.expression) = new StarExpr();
     }
-#line 2191 "yacc_sql.cpp"
+#line 2404 "yacc_sql.cpp"
     break;
 
-  case 67: /* rel_attr: ID  */
-#line 539 "yacc_sql.y"
+  case 81: /* rel_attr: ID  */
+#line 675 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2201 "yacc_sql.cpp"
+#line 2414 "yacc_sql.cpp"
     break;
 
-  case 68: /* rel_attr: ID DOT ID  */
-#line 544 "yacc_sql.y"
+  case 82: /* rel_attr: ID DOT ID  */
+#line 680 "yacc_sql.y"
                 {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2209,29 +2422,29 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2213 "yacc_sql.cpp"
+#line 2426 "yacc_sql.cpp"
     break;
 
-  case 69: /* relation: ID  */
-#line 554 "yacc_sql.y"
+  case 83: /* relation: ID  */
+#line 690 "yacc_sql.y"
        {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2221 "yacc_sql.cpp"
+#line 2434 "yacc_sql.cpp"
     break;
 
-  case 70: /* rel_list: relation  */
-#line 559 "yacc_sql.y"
+  case 84: /* rel_list: relation  */
+#line 695 "yacc_sql.y"
              {
       (yyval.relation_list) = new std::vector<std::string>();
       (yyval.relation_list)->push_back((yyvsp[0].string));
       free((yyvsp[0].string));
     }
-#line 2231 "yacc_sql.cpp"
+#line 2444 "yacc_sql.cpp"
     break;
 
-  case 71: /* rel_list: relation COMMA rel_list  */
-#line 564 "yacc_sql.y"
+  case 85: /* rel_list: relation COMMA rel_list  */
+#line 700 "yacc_sql.y"
                               {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
@@ -2242,55 +2455,55 @@ yyreduce:
       (yyval.relation_list)->insert((yyval.relation_list)->begin(), (yyvsp[-2].string));
       free((yyvsp[-2].string));
     }
-#line 2246 "yacc_sql.cpp"
+#line 2459 "yacc_sql.cpp"
     break;
 
-  case 72: /* where: %empty  */
-#line 578 "yacc_sql.y"
+  case 86: /* where: %empty  */
+#line 714 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2254 "yacc_sql.cpp"
+#line 2467 "yacc_sql.cpp"
     break;
 
-  case 73: /* where: WHERE condition_list  */
-#line 581 "yacc_sql.y"
+  case 87: /* where: WHERE condition_list  */
+#line 717 "yacc_sql.y"
                            {
       (yyval.condition_list) = (yyvsp[0].condition_list);  
     }
-#line 2262 "yacc_sql.cpp"
+#line 2475 "yacc_sql.cpp"
     break;
 
-  case 74: /* condition_list: %empty  */
-#line 587 "yacc_sql.y"
+  case 88: /* condition_list: %empty  */
+#line 723 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2270 "yacc_sql.cpp"
+#line 2483 "yacc_sql.cpp"
     break;
 
-  case 75: /* condition_list: condition  */
-#line 590 "yacc_sql.y"
+  case 89: /* condition_list: condition  */
+#line 726 "yacc_sql.y"
                 {
       (yyval.condition_list) = new std::vector<ConditionSqlNode>;
       (yyval.condition_list)->emplace_back(*(yyvsp[0].condition));
       delete (yyvsp[0].condition);
     }
-#line 2280 "yacc_sql.cpp"
+#line 2493 "yacc_sql.cpp"
     break;
 
-  case 76: /* condition_list: condition AND condition_list  */
-#line 595 "yacc_sql.y"
+  case 90: /* condition_list: condition AND condition_list  */
+#line 731 "yacc_sql.y"
                                    {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
     }
-#line 2290 "yacc_sql.cpp"
+#line 2503 "yacc_sql.cpp"
     break;
 
-  case 77: /* condition: rel_attr comp_op value  */
-#line 603 "yacc_sql.y"
+  case 91: /* condition: rel_attr comp_op value  */
+#line 739 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2302,11 +2515,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].value);
     }
-#line 2306 "yacc_sql.cpp"
+#line 2519 "yacc_sql.cpp"
     break;
 
-  case 78: /* condition: value comp_op value  */
-#line 615 "yacc_sql.y"
+  case 92: /* condition: value comp_op value  */
+#line 751 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2318,11 +2531,11 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].value);
     }
-#line 2322 "yacc_sql.cpp"
+#line 2535 "yacc_sql.cpp"
     break;
 
-  case 79: /* condition: rel_attr comp_op rel_attr  */
-#line 627 "yacc_sql.y"
+  case 93: /* condition: rel_attr comp_op rel_attr  */
+#line 763 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2334,11 +2547,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].rel_attr);
     }
-#line 2338 "yacc_sql.cpp"
+#line 2551 "yacc_sql.cpp"
     break;
 
-  case 80: /* condition: value comp_op rel_attr  */
-#line 639 "yacc_sql.y"
+  case 94: /* condition: value comp_op rel_attr  */
+#line 775 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2350,55 +2563,237 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].rel_attr);
     }
-#line 2354 "yacc_sql.cpp"
+#line 2567 "yacc_sql.cpp"
     break;
 
-  case 81: /* comp_op: EQ  */
-#line 653 "yacc_sql.y"
+  case 95: /* condition: rel_attr comp_op param  */
+#line 787 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-2].rel_attr);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_param = (yyvsp[0].number);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[-2].rel_attr);
+    }
+#line 2582 "yacc_sql.cpp"
+    break;
+
+  case 96: /* condition: param comp_op rel_attr  */
+#line 798 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_param = (yyvsp[-2].number);
+      (yyval.condition)->right_is_attr = 1;
+      (yyval.condition)->right_attr = *(yyvsp[0].rel_attr);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[0].rel_attr);
+    }
+#line 2597 "yacc_sql.cpp"
+    break;
+
+  case 97: /* condition: param comp_op value  */
+#line 809 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_param = (yyvsp[-2].number);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = *(yyvsp[0].value);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[0].value);
+    }
+#line 2612 "yacc_sql.cpp"
+    break;
+
+  case 98: /* condition: value comp_op param  */
+#line 820 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = *(yyvsp[-2].value);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_param = (yyvsp[0].number);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[-2].value);
+    }
+#line 2627 "yacc_sql.cpp"
+    break;
+
+  case 99: /* condition: param comp_op param  */
+#line 831 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_param = (yyvsp[-2].number);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_param = (yyvsp[0].number);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+    }
+#line 2640 "yacc_sql.cpp"
+    break;
+
+  case 100: /* param: '?'  */
+#line 843 "yacc_sql.y"
+    {
+      (yyval.number) = sql_result->add_param();
+    }
+#line 2648 "yacc_sql.cpp"
+    break;
+
+  case 101: /* comp_op: EQ  */
+#line 849 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 2360 "yacc_sql.cpp"
+#line 2654 "yacc_sql.cpp"
     break;
 
-  case 82: /* comp_op: LT  */
-#line 654 "yacc_sql.y"
+  case 102: /* comp_op: LT  */
+#line 850 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 2366 "yacc_sql.cpp"
+#line 2660 "yacc_sql.cpp"
     break;
 
-  case 83: /* comp_op: GT  */
-#line 655 "yacc_sql.y"
+  case 103: /* comp_op: GT  */
+#line 851 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 2372 "yacc_sql.cpp"
+#line 2666 "yacc_sql.cpp"
     break;
 
-  case 84: /* comp_op: LE  */
-#line 656 "yacc_sql.y"
+  case 104: /* comp_op: LE  */
+#line 852 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 2378 "yacc_sql.cpp"
+#line 2672 "yacc_sql.cpp"
     break;
 
-  case 85: /* comp_op: GE  */
-#line 657 "yacc_sql.y"
+  case 105: /* comp_op: GE  */
+#line 853 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 2384 "yacc_sql.cpp"
+#line 2678 "yacc_sql.cpp"
     break;
 
-  case 86: /* comp_op: NE  */
-#line 658 "yacc_sql.y"
+  case 106: /* comp_op: NE  */
+#line 854 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 2390 "yacc_sql.cpp"
+#line 2684 "yacc_sql.cpp"
     break;
 
-  case 87: /* group_by: %empty  */
-#line 664 "yacc_sql.y"
+  case 107: /* group_by: %empty  */
+#line 860 "yacc_sql.y"
     {
       (yyval.expression_list) = nullptr;
     }
-#line 2398 "yacc_sql.cpp"
+#line 2692 "yacc_sql.cpp"
+    break;
+
+  case 108: /* order_by: %empty  */
+#line 866 "yacc_sql.y"
+    {
+      (yyval.order_by_list) = nullptr;
+    }
+#line 2700 "yacc_sql.cpp"
+    break;
+
+  case 109: /* order_by: ORDER BY order_by_list  */
+#line 870 "yacc_sql.y"
+    {
+      (yyval.order_by_list) = (yyvsp[0].order_by_list);
+    }
+#line 2708 "yacc_sql.cpp"
+    break;
+
+  case 110: /* order_by_list: order_by_item  */
+#line 876 "yacc_sql.y"
+    {
+      (yyval.order_by_list) = new std::vector<OrderBySqlNode>;
+      (yyval.order_by_list)->emplace_back(std::move(*(yyvsp[0].order_by_item)));
+      delete (yyvsp[0].order_by_item);
+    }
+#line 2718 "yacc_sql.cpp"
+    break;
+
+  case 111: /* order_by_list: order_by_item COMMA order_by_list  */
+#line 882 "yacc_sql.y"
+    {
+      (yyval.order_by_list) = (yyvsp[0].order_by_list);
+      (yyval.order_by_list)->emplace((yyval.order_by_list)->begin(), std::move(*(yyvsp[-2].order_by_item)));
+      delete (yyvsp[-2].order_by_item);
+    }
+#line 2728 "yacc_sql.cpp"
+    break;
+
+  case 112: /* order_by_item: expression  */
+#line 890 "yacc_sql.y"
+    {
+      (yyval.order_by_item) = new OrderBySqlNode;
+      (yyval.order_by_item)->expression.reset((yyvsp[0].expression));
+    }
+#line 2737 "yacc_sql.cpp"
+    break;
+
+  case 113: /* order_by_item: expression ASC  */
+#line 895 "yacc_sql.y"
+    {
+      (yyval.order_by_item) = new OrderBySqlNode;
+      (yyval.order_by_item)->expression.reset((yyvsp[-1].expression));
+    }
+#line 2746 "yacc_sql.cpp"
     break;
 
-  case 88: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
-#line 670 "yacc_sql.y"
+  case 114: /* order_by_item: expression DESC  */
+#line 900 "yacc_sql.y"
+    {
+      (yyval.order_by_item) = new OrderBySqlNode;
+      (yyval.order_by_item)->expression.reset((yyvsp[-1].expression));
+      (yyval.order_by_item)->ascending = false;
+    }
+#line 2756 "yacc_sql.cpp"
+    break;
+
+  case 115: /* limit: %empty  */
+#line 908 "yacc_sql.y"
+    {
+      (yyval.limit) = nullptr;
+    }
+#line 2764 "yacc_sql.cpp"
+    break;
+
+  case 116: /* limit: LIMIT number  */
+#line 912 "yacc_sql.y"
+    {
+      (yyval.limit) = new LimitSqlNode;
+      (yyval.limit)->limit = (yyvsp[0].number);
+    }
+#line 2773 "yacc_sql.cpp"
+    break;
+
+  case 117: /* limit: LIMIT number OFFSET number  */
+#line 917 "yacc_sql.y"
+    {
+      (yyval.limit) = new LimitSqlNode;
+      (yyval.limit)->limit  = (yyvsp[-2].number);
+      (yyval.limit)->offset = (yyvsp[0].number);
+    }
+#line 2783 "yacc_sql.cpp"
+    break;
+
+  case 118: /* limit: LIMIT number COMMA number  */
+#line 923 "yacc_sql.y"
+    {
+      (yyval.limit) = new LimitSqlNode;
+      (yyval.limit)->limit  = (yyvsp[0].number);
+      (yyval.limit)->offset = (yyvsp[-2].number);
+    }
+#line 2793 "yacc_sql.cpp"
+    break;
+
+  case 119: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
+#line 931 "yacc_sql.y"
     {
       char *tmp_file_name = common::substr((yyvsp[-3].string), 1, strlen((yyvsp[-3].string)) - 2);
       
@@ -2408,20 +2803,30 @@ yyreduce:
       free((yyvsp[0].string));
       free(tmp_file_name);
     }
-#line 2412 "yacc_sql.cpp"
+#line 2807 "yacc_sql.cpp"
+    break;
+
+  case 120: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 944 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
+      (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
+    }
+#line 2816 "yacc_sql.cpp"
     break;
 
-  case 89: /* explain_stmt: EXPLAIN command_wrapper  */
-#line 683 "yacc_sql.y"
+  case 121: /* explain_stmt: EXPLAIN ANALYZE command_wrapper  */
+#line 949 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
+      (yyval.sql_node)->explain.analyze = true;
     }
-#line 2421 "yacc_sql.cpp"
+#line 2826 "yacc_sql.cpp"
     break;
 
-  case 90: /* set_variable_stmt: SET ID EQ value  */
-#line 691 "yacc_sql.y"
+  case 122: /* set_variable_stmt: SET ID EQ value  */
+#line 958 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -2429,11 +2834,11 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 2433 "yacc_sql.cpp"
+#line 2838 "yacc_sql.cpp"
     break;
 
 
-#line 2437 "yacc_sql.cpp"
+#line 2842 "yacc_sql.cpp"
 
       default: break;
     }
@@ -2662,7 +3067,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 703 "yacc_sql.y"
+#line 970 "yacc_sql.y"
 
 //_____________________________________________________________________
 extern void scan_string(const char *str, yyscan_t scanner);
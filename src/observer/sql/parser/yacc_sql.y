@@ -90,6 +90,8 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
         STRING_T
         FLOAT_T
         VECTOR_T
+        VARCHAR_T
+        TEXT_T
         HELP
         EXIT
         DOT //QUOTE
@@ -106,6 +108,12 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
         EXPLAIN
         STORAGE
         FORMAT
+        USING
+        ORDER
+        ASC
+        LIMIT
+        OFFSET
+        ANALYZE
         EQ
         LT
         GT
@@ -125,9 +133,15 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
   Expression *                               expression;
   std::vector<std::unique_ptr<Expression>> * expression_list;
   std::vector<Value> *                       value_list;
+  std::vector<std::vector<Value>> *          value_rows;
   std::vector<ConditionSqlNode> *            condition_list;
   std::vector<RelAttrSqlNode> *              rel_attr_list;
   std::vector<std::string> *                 relation_list;
+  std::vector<OrderBySqlNode> *              order_by_list;
+  SetClauseSqlNode *                         set_clause;
+  std::vector<SetClauseSqlNode> *            set_clause_list;
+  OrderBySqlNode *                           order_by_item;
+  LimitSqlNode *                             limit;
   char *                                     string;
   int                                        number;
   float                                      floats;
@@ -143,20 +157,31 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
 %type <number>              type
 %type <condition>           condition
 %type <value>               value
+%type <number>              param
 %type <number>              number
 %type <string>              relation
 %type <comp>                comp_op
 %type <rel_attr>            rel_attr
 %type <attr_infos>          attr_def_list
 %type <attr_info>           attr_def
+%type <number>              var_type
 %type <value_list>          value_list
+%type <value_list>          value_row
+%type <value_rows>          value_row_list
 %type <condition_list>      where
 %type <condition_list>      condition_list
 %type <string>              storage_format
+%type <string>              index_type
 %type <relation_list>       rel_list
 %type <expression>          expression
 %type <expression_list>     expression_list
 %type <expression_list>     group_by
+%type <order_by_list>       order_by
+%type <order_by_list>       order_by_list
+%type <order_by_item>       order_by_item
+%type <set_clause>          set_clause
+%type <set_clause_list>     set_clause_list
+%type <limit>               limit
 %type <sql_node>            calc_stmt
 %type <sql_node>            select_stmt
 %type <sql_node>            insert_stmt
@@ -166,6 +191,7 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            show_tables_stmt
 %type <sql_node>            desc_table_stmt
+%type <sql_node>            analyze_table_stmt
 %type <sql_node>            create_index_stmt
 %type <sql_node>            drop_index_stmt
 %type <sql_node>            sync_stmt
@@ -203,6 +229,7 @@ command_wrapper:
   | drop_table_stmt
   | show_tables_stmt
   | desc_table_stmt
+  | analyze_table_stmt
   | create_index_stmt
   | drop_index_stmt
   | sync_stmt
@@ -272,8 +299,16 @@ desc_table_stmt:
     }
     ;
 
+analyze_table_stmt:
+    ANALYZE TABLE ID  {
+      $$ = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+      $$->analyze_table.relation_name = $3;
+      free($3);
+    }
+    ;
+
 create_index_stmt:    /*create index 语句的语法解析树*/
-    CREATE INDEX ID ON ID LBRACE ID RBRACE
+    CREATE INDEX ID ON ID LBRACE ID RBRACE index_type
     {
       $$ = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = $$->create_index;
@@ -283,6 +318,21 @@ create_index_stmt:    /*create index 语句的语法解析树*/
       free($3);
       free($5);
       free($7);
+      if ($9 != nullptr) {
+        create_index.index_type = $9;
+        free($9);
+      }
+    }
+    ;
+
+index_type:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | USING ID
+    {
+      $$ = $2;
     }
     ;
 
@@ -353,6 +403,29 @@ attr_def:
       $$->length = 4;
       free($1);
     }
+    | ID var_type LBRACE number RBRACE
+    {
+      $$ = new AttrInfoSqlNode;
+      $$->type = AttrType::CHARS;
+      $$->name = $1;
+      $$->length = $4;
+      $$->var_len = true;
+      free($1);
+    }
+    | ID var_type
+    {
+      $$ = new AttrInfoSqlNode;
+      $$->type = AttrType::CHARS;
+      $$->name = $1;
+      $$->length = $2;
+      $$->var_len = true;
+      free($1);
+    }
+    ;
+/* 变长的字符串类型，值是没有指定长度时的默认长度 */
+var_type:
+    VARCHAR_T { $$ = 255; }
+    | TEXT_T  { $$ = 4096; }
     ;
 number:
     NUMBER {$$ = $1;}
@@ -364,21 +437,51 @@ type:
     | VECTOR_T { $$ = static_cast<int>(AttrType::VECTORS); }
     ;
 insert_stmt:        /*insert   语句的语法解析树*/
-    INSERT INTO ID VALUES LBRACE value value_list RBRACE 
+    INSERT INTO ID VALUES value_row value_row_list
     {
       $$ = new ParsedSqlNode(SCF_INSERT);
       $$->insertion.relation_name = $3;
-      if ($7 != nullptr) {
-        $$->insertion.values.swap(*$7);
-        delete $7;
+      if ($6 != nullptr) {
+        $$->insertion.values.swap(*$6);
+        delete $6;
       }
-      $$->insertion.values.emplace_back(*$6);
+      $$->insertion.values.emplace_back(std::move(*$5));
       std::reverse($$->insertion.values.begin(), $$->insertion.values.end());
-      delete $6;
+      delete $5;
       free($3);
     }
     ;
 
+value_row:
+    LBRACE value value_list RBRACE
+    {
+      if ($3 != nullptr) {
+        $$ = $3;
+      } else {
+        $$ = new std::vector<Value>;
+      }
+      $$->emplace_back(*$2);
+      std::reverse($$->begin(), $$->end());
+      delete $2;
+    }
+    ;
+
+value_row_list:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | COMMA value_row value_row_list {
+      if ($3 != nullptr) {
+        $$ = $3;
+      } else {
+        $$ = new std::vector<std::vector<Value>>;
+      }
+      $$->emplace_back(std::move(*$2));
+      delete $2;
+    }
+    ;
+
 value_list:
     /* empty */
     {
@@ -434,22 +537,45 @@ delete_stmt:    /*  delete 语句的语法解析树*/
     }
     ;
 update_stmt:      /*  update 语句的语法解析树*/
-    UPDATE ID SET ID EQ value where 
+    UPDATE ID SET set_clause_list where 
     {
       $$ = new ParsedSqlNode(SCF_UPDATE);
       $$->update.relation_name = $2;
-      $$->update.attribute_name = $4;
-      $$->update.value = *$6;
-      if ($7 != nullptr) {
-        $$->update.conditions.swap(*$7);
-        delete $7;
+      $$->update.set_clauses.swap(*$4);
+      delete $4;
+      if ($5 != nullptr) {
+        $$->update.conditions.swap(*$5);
+        delete $5;
       }
       free($2);
-      free($4);
+    }
+    ;
+set_clause_list:
+    set_clause
+    {
+      $$ = new std::vector<SetClauseSqlNode>;
+      $$->emplace_back(std::move(*$1));
+      delete $1;
+    }
+    | set_clause COMMA set_clause_list
+    {
+      $$ = $3;
+      $$->emplace($$->begin(), std::move(*$1));
+      delete $1;
+    }
+    ;
+set_clause:
+    ID EQ value
+    {
+      $$ = new SetClauseSqlNode;
+      $$->attribute_name = $1;
+      $$->value = *$3;
+      delete $3;
+      free($1);
     }
     ;
 select_stmt:        /*  select 语句的语法解析树*/
-    SELECT expression_list FROM rel_list where group_by
+    SELECT expression_list FROM rel_list where group_by order_by limit
     {
       $$ = new ParsedSqlNode(SCF_SELECT);
       if ($2 != nullptr) {
@@ -471,6 +597,16 @@ select_stmt:        /*  select 语句的语法解析树*/
         $$->selection.group_by.swap(*$6);
         delete $6;
       }
+
+      if ($7 != nullptr) {
+        $$->selection.order_by.swap(*$7);
+        delete $7;
+      }
+
+      if ($8 != nullptr) {
+        $$->selection.limit = *$8;
+        delete $8;
+      }
     }
     ;
 calc_stmt:
@@ -647,6 +783,66 @@ condition:
       delete $1;
       delete $3;
     }
+    | rel_attr comp_op param
+    {
+      $$ = new ConditionSqlNode;
+      $$->left_is_attr = 1;
+      $$->left_attr = *$1;
+      $$->right_is_attr = 0;
+      $$->right_param = $3;
+      $$->comp = $2;
+
+      delete $1;
+    }
+    | param comp_op rel_attr
+    {
+      $$ = new ConditionSqlNode;
+      $$->left_is_attr = 0;
+      $$->left_param = $1;
+      $$->right_is_attr = 1;
+      $$->right_attr = *$3;
+      $$->comp = $2;
+
+      delete $3;
+    }
+    | param comp_op value
+    {
+      $$ = new ConditionSqlNode;
+      $$->left_is_attr = 0;
+      $$->left_param = $1;
+      $$->right_is_attr = 0;
+      $$->right_value = *$3;
+      $$->comp = $2;
+
+      delete $3;
+    }
+    | value comp_op param
+    {
+      $$ = new ConditionSqlNode;
+      $$->left_is_attr = 0;
+      $$->left_value = *$1;
+      $$->right_is_attr = 0;
+      $$->right_param = $3;
+      $$->comp = $2;
+
+      delete $1;
+    }
+    | param comp_op param
+    {
+      $$ = new ConditionSqlNode;
+      $$->left_is_attr = 0;
+      $$->left_param = $1;
+      $$->right_is_attr = 0;
+      $$->right_param = $3;
+      $$->comp = $2;
+    }
+    ;
+
+param:
+    '?'
+    {
+      $$ = sql_result->add_param();
+    }
     ;
 
 comp_op:
@@ -665,6 +861,71 @@ group_by:
       $$ = nullptr;
     }
     ;
+order_by:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | ORDER BY order_by_list
+    {
+      $$ = $3;
+    }
+    ;
+order_by_list:
+    order_by_item
+    {
+      $$ = new std::vector<OrderBySqlNode>;
+      $$->emplace_back(std::move(*$1));
+      delete $1;
+    }
+    | order_by_item COMMA order_by_list
+    {
+      $$ = $3;
+      $$->emplace($$->begin(), std::move(*$1));
+      delete $1;
+    }
+    ;
+order_by_item:
+    expression
+    {
+      $$ = new OrderBySqlNode;
+      $$->expression.reset($1);
+    }
+    | expression ASC
+    {
+      $$ = new OrderBySqlNode;
+      $$->expression.reset($1);
+    }
+    | expression DESC
+    {
+      $$ = new OrderBySqlNode;
+      $$->expression.reset($1);
+      $$->ascending = false;
+    }
+    ;
+limit:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | LIMIT number
+    {
+      $$ = new LimitSqlNode;
+      $$->limit = $2;
+    }
+    | LIMIT number OFFSET number
+    {
+      $$ = new LimitSqlNode;
+      $$->limit  = $2;
+      $$->offset = $4;
+    }
+    | LIMIT number COMMA number
+    {
+      $$ = new LimitSqlNode;
+      $$->limit  = $4;
+      $$->offset = $2;
+    }
+    ;
 load_data_stmt:
     LOAD DATA INFILE SSS INTO TABLE ID 
     {
@@ -684,6 +945,12 @@ explain_stmt:
       $$ = new ParsedSqlNode(SCF_EXPLAIN);
       $$->explain.sql_node = std::unique_ptr<ParsedSqlNode>($2);
     }
+    | EXPLAIN ANALYZE command_wrapper
+    {
+      $$ = new ParsedSqlNode(SCF_EXPLAIN);
+      $$->explain.sql_node = std::unique_ptr<ParsedSqlNode>($3);
+      $$->explain.analyze = true;
+    }
     ;
 
 set_variable_stmt:
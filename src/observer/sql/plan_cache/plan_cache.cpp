@@ -0,0 +1,254 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include "sql/plan_cache/plan_cache.h"
+#include "common/lang/atomic.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+static atomic<uint64_t> global_schema_version{0};
+
+uint64_t PlanCache::schema_version() { return global_schema_version.load(memory_order_acquire); }
+
+void PlanCache::bump_schema_version() { global_schema_version.fetch_add(1, memory_order_acq_rel); }
+
+namespace {
+
+/// @brief 与 lex_sql.l 中的 WHITE_SAPCE 和换行保持一致
+bool is_white_space(char c) { return c == ' ' || c == '\t' || c == '\b' || c == '\f' || c == '\n'; }
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+bool is_word_start(char c) { return isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+
+bool is_word_char(char c) { return isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+
+}  // namespace
+
+bool PlanCache::parameterize(const string &sql, string &normalized_sql, string &key, vector<Value> &params)
+{
+  normalized_sql.clear();
+  key.clear();
+  params.clear();
+
+  bool         first_word = true;
+  bool         in_where   = false;  // 只有 where 中的常量会替换成参数
+  const size_t length     = sql.size();
+  size_t       i          = 0;
+  while (i < length) {
+    const char c = sql[i];
+    if (is_white_space(c)) {
+      if (!normalized_sql.empty() && normalized_sql.back() != ' ') {
+        normalized_sql.push_back(' ');
+      }
+      i++;
+      continue;
+    }
+
+    // 标识符或关键字
+    if (is_word_start(c)) {
+      size_t end = i + 1;
+      while (end < length && is_word_char(sql[end])) {
+        end++;
+      }
+      const string word = sql.substr(i, end - i);
+      if (first_word && 0 != strcasecmp(word.c_str(), "select")) {
+        return false;
+      }
+      first_word = false;
+
+      if (0 == strcasecmp(word.c_str(), "where")) {
+        in_where = true;
+      } else if (0 == strcasecmp(word.c_str(), "group") || 0 == strcasecmp(word.c_str(), "order") ||
+                 0 == strcasecmp(word.c_str(), "limit")) {
+        in_where = false;
+      }
+      normalized_sql.append(word);
+      i = end;
+      continue;
+    }
+
+    if (first_word) {
+      return false;
+    }
+
+    // 整数或浮点数，负号是常量的一部分
+    if (is_digit(c) || (c == '-' && i + 1 < length && is_digit(sql[i + 1]))) {
+      size_t end = (c == '-') ? i + 1 : i;
+      while (end < length && is_digit(sql[end])) {
+        end++;
+      }
+      const bool is_float = end + 1 < length && sql[end] == '.' && is_digit(sql[end + 1]);
+      if (is_float) {
+        end++;
+        while (end < length && is_digit(sql[end])) {
+          end++;
+        }
+      }
+
+      const string text = sql.substr(i, end - i);
+      if (in_where) {
+        normalized_sql.push_back('?');
+        if (is_float) {
+          params.emplace_back(static_cast<float>(atof(text.c_str())));
+        } else {
+          params.emplace_back(atoi(text.c_str()));
+        }
+      } else {
+        normalized_sql.append(text);
+      }
+      i = end;
+      continue;
+    }
+
+    // 字符串
+    if (c == '\'' || c == '"') {
+      const size_t end = sql.find(c, i + 1);
+      if (end == string::npos) {
+        return false;
+      }
+      if (in_where) {
+        normalized_sql.push_back('?');
+        params.emplace_back(sql.substr(i + 1, end - i - 1).c_str());
+      } else {
+        normalized_sql.append(sql, i, end - i + 1);
+      }
+      i = end + 1;
+      continue;
+    }
+
+    // 语句中原来的参数不能和替换出来的参数混在一起
+    if (c == '?') {
+      return false;
+    }
+
+    normalized_sql.push_back(c);
+    i++;
+  }
+
+  if (first_word) {
+    return false;
+  }
+  while (!normalized_sql.empty() && normalized_sql.back() == ' ') {
+    normalized_sql.pop_back();
+  }
+
+  key = make_key(normalized_sql, params);
+  return true;
+}
+
+string PlanCache::make_key(const string &normalized_sql, const vector<Value> &params)
+{
+  string key;
+  key.reserve(normalized_sql.size() + params.size() + 1);
+  key.append(normalized_sql).append(1, '\0');
+  for (const Value &param : params) {
+    switch (param.attr_type()) {
+      case AttrType::INTS: {
+        key.push_back('i');
+      } break;
+      case AttrType::FLOATS: {
+        key.push_back('f');
+      } break;
+      case AttrType::CHARS: {
+        key.push_back('s');
+      } break;
+      default: {
+        key.push_back(static_cast<char>('0' + static_cast<int>(param.attr_type())));
+      } break;
+    }
+  }
+  return key;
+}
+
+bool PlanCache::reusable(PhysicalOperator &oper)
+{
+  switch (oper.type()) {
+    case PhysicalOperatorType::TABLE_SCAN:
+    case PhysicalOperatorType::TABLE_SCAN_VEC:
+    case PhysicalOperatorType::INDEX_SCAN:
+    case PhysicalOperatorType::NESTED_LOOP_JOIN:
+    case PhysicalOperatorType::HASH_JOIN:
+    case PhysicalOperatorType::PREDICATE:
+    case PhysicalOperatorType::PROJECT:
+    case PhysicalOperatorType::PROJECT_VEC:
+    case PhysicalOperatorType::EXPR_VEC:
+    case PhysicalOperatorType::GROUP_BY_VEC:
+    case PhysicalOperatorType::PARALLEL_GROUP_BY_VEC:
+    case PhysicalOperatorType::SORT:
+    case PhysicalOperatorType::SORT_VEC:
+    case PhysicalOperatorType::LIMIT:
+    case PhysicalOperatorType::LIMIT_VEC: {
+      // 这些算子在 open 时会重置所有的执行状态
+    } break;
+
+    default: {
+      // 标量分组聚合等算子在 open 时会累加状态，不能重复执行
+      return false;
+    }
+  }
+
+  for (unique_ptr<PhysicalOperator> &child : oper.children()) {
+    if (!reusable(*child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+unique_ptr<CachedPlan> PlanCache::take(const string &key)
+{
+  auto iter = index_.find(key);
+  if (iter == index_.end()) {
+    return nullptr;
+  }
+
+  unique_ptr<CachedPlan> plan = std::move(*iter->second);
+  entries_.erase(iter->second);
+  index_.erase(iter);
+
+  if (plan->schema_version != schema_version()) {
+    LOG_TRACE("drop expired plan. plan version=%lu, current version=%lu", plan->schema_version, schema_version());
+    return nullptr;
+  }
+  return plan;
+}
+
+void PlanCache::put(unique_ptr<CachedPlan> plan)
+{
+  if (plan == nullptr || plan->plan == nullptr || !reusable(*plan->plan)) {
+    return;
+  }
+
+  auto iter = index_.find(plan->key);
+  if (iter != index_.end()) {
+    entries_.erase(iter->second);
+    index_.erase(iter);
+  }
+
+  entries_.push_front(std::move(plan));
+  index_.emplace(entries_.front()->key, entries_.begin());
+
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back()->key);
+    entries_.pop_back();
+  }
+}
+
+void PlanCache::clear()
+{
+  index_.clear();
+  entries_.clear();
+}
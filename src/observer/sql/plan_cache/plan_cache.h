@@ -0,0 +1,107 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/list.h"
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
+#include "common/value.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 缓存的一个执行计划
+ * @ingroup SQLStage
+ * @details 计划中的常量都替换成了参数(ParamExpr)，参数表达式引用的是这里的 params，
+ * 执行前把新的常量值写到 params 中就可以直接复用整个物理计划。
+ */
+struct CachedPlan
+{
+  string                       key;                 ///< 参数化之后的语句，见 PlanCache::parameterize
+  uint64_t                     schema_version = 0;  ///< 生成计划时的元数据版本
+  vector<Value>                params;              ///< 参数的值
+  unique_ptr<PhysicalOperator> plan;                ///< 物理计划，执行期间由 SqlResult 持有
+  bool                         chunk_mode = false;  ///< 计划是否是向量化的算子
+  uint32_t                     statement_id = 0;    ///< 所属的预编译语句，0 表示放在计划缓存中
+};
+
+/**
+ * @brief 会话级别的执行计划缓存
+ * @ingroup SQLStage
+ * @details 使用语句参数化之后的文本作为键，相同形状的语句(比如只有 where 中常量不同的点查)共用同一个计划，
+ * 省掉解析、语义检查、重写和生成计划的开销。
+ * 一个计划同一时刻只能被一个请求执行，所以使用时从缓存中取出，执行完成后再放回去。
+ * 计划中保存了 Table、Index 等元数据的指针，元数据变化(DDL)时递增全局的版本号，版本号不同的计划直接丢弃。
+ * 只有可以反复 open/close 的算子组成的计划才会被缓存。
+ */
+class PlanCache
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 128;
+
+  explicit PlanCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+
+  /**
+   * @brief 把语句中的常量替换成参数
+   * @details 只处理 select 语句 where 中的常量，group by/order by/limit 中的常量会影响计划的形状，保留原样。
+   * 切分单词的规则与词法分析(lex_sql.l)保持一致，连续的空白字符合并成一个空格。
+   * @param sql 原始语句
+   * @param[out] normalized_sql 常量替换成 ? 之后的语句，可以直接交给语法分析
+   * @param[out] key 缓存的键，包含参数化之后的语句和每个参数的类型
+   * @param[out] params 按出现的顺序排列的常量
+   * @return 语句不能参数化(不是 select 语句或者词法有错误)时返回false
+   */
+  static bool parameterize(const string &sql, string &normalized_sql, string &key, vector<Value> &params);
+
+  /**
+   * @brief 生成缓存的键
+   * @details 参数的类型不同时，隐式类型转换可能不同，所以键中包含每个参数的类型
+   * @param normalized_sql 参数化之后的语句
+   * @param params 参数的值
+   */
+  static string make_key(const string &normalized_sql, const vector<Value> &params);
+
+  /**
+   * @brief 当前的元数据版本，创建表、创建索引等操作成功之后递增
+   */
+  static uint64_t schema_version();
+  static void     bump_schema_version();
+
+  /**
+   * @brief 取出一个计划
+   * @details 取出之后缓存中就没有这个计划了，执行完成后调用 put 放回来。
+   * 过期的计划会直接销毁，返回空。
+   */
+  unique_ptr<CachedPlan> take(const string &key);
+
+  /**
+   * @brief 放入一个计划
+   * @details 计划中包含不能重复执行的算子时不缓存。缓存满了以后淘汰最久没有使用的计划。
+   */
+  void put(unique_ptr<CachedPlan> plan);
+
+  void clear();
+
+  size_t size() const { return entries_.size(); }
+
+  /**
+   * @brief 计划中的算子是否都可以重复 open/close
+   */
+  static bool reusable(PhysicalOperator &oper);
+
+private:
+  using EntryList = list<unique_ptr<CachedPlan>>;
+
+  size_t                                     capacity_;
+  EntryList                                  entries_;  ///< 越靠前的越是最近使用过的
+  unordered_map<string, EntryList::iterator> index_;
+};
@@ -1,25 +1,118 @@
-/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
-miniob is licensed under Mulan PSL v2.
-You can use this software according to the terms and conditions of the Mulan PSL v2.
-You may obtain a copy of Mulan PSL v2 at:
-         http://license.coscl.org.cn/MulanPSL2
-THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
-EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
-MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
-See the Mulan PSL v2 for more details. */
-
-//
-// Created by Longda on 2021/4/13.
-//
-
-#include <string.h>
-#include <string>
-
-#include "plan_cache_stage.h"
-
-#include "common/conf/ini.h"
-#include "common/io/io.h"
-#include "common/lang/string.h"
-#include "common/log/log.h"
-
-using namespace common;
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+//
+// Created by Longda on 2021/4/13.
+//
+
+#include <string.h>
+#include <string>
+
+#include "plan_cache_stage.h"
+
+#include "common/conf/ini.h"
+#include "common/io/io.h"
+#include "common/lang/string.h"
+#include "common/log/log.h"
+#include "event/session_event.h"
+#include "event/sql_event.h"
+#include "session/session.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/plan_cache/prepared_statement.h"
+
+using namespace std;
+using namespace common;
+
+/**
+ * @brief 不同的执行模式生成的计划不同
+ */
+static void append_execution_mode(Session *session, string &key)
+{
+  key.push_back(static_cast<char>('0' + static_cast<int>(session->get_execution_mode())));
+}
+
+/**
+ * @brief 命中时，计划中的参数表达式引用的是 hit_plan->params，替换成本次执行的参数即可
+ */
+static void use_cached_plan(SQLStageEvent *sql_event, unique_ptr<CachedPlan> hit_plan, vector<Value> &params)
+{
+  hit_plan->params = std::move(params);
+  sql_event->session_event()->session()->set_used_chunk_mode(hit_plan->chunk_mode);
+  sql_event->set_operator(std::move(hit_plan->plan));
+  sql_event->set_cached_plan(std::move(hit_plan));
+}
+
+RC PlanCacheStage::handle_request(SQLStageEvent *sql_event)
+{
+  if (sql_event->session_event()->statement_id() != 0) {
+    return handle_prepared_request(sql_event);
+  }
+
+  Session *session = sql_event->session_event()->session();
+  if (!session->plan_cache_enabled()) {
+    return RC::SUCCESS;
+  }
+
+  auto   cached_plan = make_unique<CachedPlan>();
+  string normalized_sql;
+  if (!PlanCache::parameterize(sql_event->sql(), normalized_sql, cached_plan->key, cached_plan->params)) {
+    return RC::SUCCESS;
+  }
+  append_execution_mode(session, cached_plan->key);
+
+  unique_ptr<CachedPlan> hit_plan = session->plan_cache().take(cached_plan->key);
+  if (hit_plan != nullptr) {
+    LOG_TRACE("plan cache hit. sql=%s", sql_event->sql().c_str());
+    use_cached_plan(sql_event, std::move(hit_plan), cached_plan->params);
+    return RC::SUCCESS;
+  }
+
+  // 在生成计划之前记录元数据的版本，生成计划期间如果有DDL，这个计划就不会被使用
+  cached_plan->schema_version = PlanCache::schema_version();
+  sql_event->set_sql(normalized_sql.c_str());
+  sql_event->set_cached_plan(std::move(cached_plan));
+  return RC::SUCCESS;
+}
+
+RC PlanCacheStage::handle_prepared_request(SQLStageEvent *sql_event)
+{
+  SessionEvent      *session_event = sql_event->session_event();
+  Session           *session       = session_event->session();
+  PreparedStatement *stmt          = session->find_prepared_statement(session_event->statement_id());
+  if (nullptr == stmt) {
+    LOG_WARN("no such prepared statement. id=%u", session_event->statement_id());
+    return RC::NOTFOUND;
+  }
+
+  vector<Value> &params = session_event->params();
+  if (static_cast<int>(params.size()) != stmt->param_num()) {
+    LOG_WARN("param number mismatch. id=%u, expect=%d, actual=%d", stmt->id(), stmt->param_num(), params.size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  string key = PlanCache::make_key(stmt->sql(), params);
+  append_execution_mode(session, key);
+
+  unique_ptr<CachedPlan> hit_plan = stmt->take_plan(key);
+  if (hit_plan != nullptr) {
+    LOG_TRACE("prepared statement plan hit. id=%u", stmt->id());
+    use_cached_plan(sql_event, std::move(hit_plan), params);
+    return RC::SUCCESS;
+  }
+
+  // 语句的文本已经是带参数的，按照本次的参数生成计划
+  auto cached_plan            = make_unique<CachedPlan>();
+  cached_plan->key            = std::move(key);
+  cached_plan->schema_version = PlanCache::schema_version();
+  cached_plan->params         = std::move(params);
+  cached_plan->statement_id   = stmt->id();
+  sql_event->set_cached_plan(std::move(cached_plan));
+  return RC::SUCCESS;
+}
@@ -16,11 +16,22 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/rc.h"
 
+class SQLStageEvent;
+
 /**
  * @brief 尝试从Plan的缓存中获取Plan，如果没有命中，则执行Optimizer
  * @ingroup SQLStage
- * @details 实际上现在什么都没做。不过PlanCache对数据库的优化提升明显，是一个非常有趣的功能，
- * 感兴趣的同学可以参考OceanBase的实现
+ * @details 先把语句中 where 里的常量替换成参数(见 PlanCache::parameterize)，用参数化之后的语句查找会话的计划缓存。
+ * 命中时把本次的常量绑定到缓存的计划上，直接设置物理计划，后面的解析、语义检查和优化都不需要再做。
+ * 没有命中时使用参数化之后的语句继续后面的流程，这样生成的计划中常量都是参数，执行完成后放入缓存(见 SqlResult::close)。
+ * 执行预编译语句时(见 PreparedStatement)，使用语句上保存的计划，不受计划缓存开关的影响。
+ * 多个线程会共用同一个 PlanCacheStage，所以这里不保存任何状态。
  */
 class PlanCacheStage
-{};
+{
+public:
+  RC handle_request(SQLStageEvent *sql_event);
+
+private:
+  RC handle_prepared_request(SQLStageEvent *sql_event);
+};
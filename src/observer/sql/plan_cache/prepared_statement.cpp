@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/plan_cache/prepared_statement.h"
+#include "common/log/log.h"
+#include "sql/parser/parse.h"
+
+using namespace std;
+
+RC PreparedStatement::create(uint32_t id, const string &sql, unique_ptr<PreparedStatement> &stmt)
+{
+  ParsedSqlResult parsed_sql_result;
+  parse(sql.c_str(), &parsed_sql_result);
+  if (parsed_sql_result.sql_nodes().empty()) {
+    LOG_WARN("nothing to prepare. sql=%s", sql.c_str());
+    return RC::SQL_SYNTAX;
+  }
+
+  if (parsed_sql_result.sql_nodes().size() > 1) {
+    LOG_WARN("cannot prepare multi sql commands. sql=%s", sql.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (parsed_sql_result.sql_nodes().front()->flag == SCF_ERROR) {
+    LOG_WARN("failed to parse sql. sql=%s", sql.c_str());
+    return RC::SQL_SYNTAX;
+  }
+
+  stmt = make_unique<PreparedStatement>(id, sql, parsed_sql_result.param_num());
+  LOG_TRACE("prepare statement. id=%u, param num=%d, sql=%s", id, stmt->param_num(), sql.c_str());
+  return RC::SUCCESS;
+}
+
+unique_ptr<CachedPlan> PreparedStatement::take_plan(const string &key)
+{
+  if (plan_ == nullptr || plan_->key != key) {
+    return nullptr;
+  }
+
+  unique_ptr<CachedPlan> plan = std::move(plan_);
+  if (plan->schema_version != PlanCache::schema_version()) {
+    LOG_TRACE("drop expired plan of prepared statement. id=%u", id_);
+    return nullptr;
+  }
+  return plan;
+}
+
+void PreparedStatement::put_plan(unique_ptr<CachedPlan> plan)
+{
+  if (plan == nullptr || plan->plan == nullptr || !PlanCache::reusable(*plan->plan)) {
+    return;
+  }
+  plan_ = std::move(plan);
+}
@@ -0,0 +1,68 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/rc.h"
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "sql/plan_cache/plan_cache.h"
+
+/**
+ * @brief 预编译语句
+ * @ingroup SQLStage
+ * @details 对应 MySQL 协议中的 COM_STMT_PREPARE。语句中使用 ? 表示参数，预编译时只做语法检查并记录参数的个数。
+ * 第一次执行时按照绑定的参数生成计划，计划保存在语句上，之后参数类型不变的执行直接使用这个计划，
+ * 不再做解析、语义检查和优化。计划同样受元数据版本的约束，DDL 之后会重新生成。
+ */
+class PreparedStatement
+{
+public:
+  PreparedStatement(uint32_t id, const string &sql, int param_num) : id_(id), sql_(sql), param_num_(param_num) {}
+
+  /**
+   * @brief 预编译一条语句
+   * @param id 语句的编号
+   * @param sql 带参数的语句
+   * @param[out] stmt 语法正确时返回预编译好的语句
+   */
+  static RC create(uint32_t id, const string &sql, unique_ptr<PreparedStatement> &stmt);
+
+  uint32_t      id() const { return id_; }
+  const string &sql() const { return sql_; }
+  int           param_num() const { return param_num_; }
+
+  /**
+   * @brief 客户端绑定参数时使用的类型
+   * @details 由通讯层维护，MySQL 协议中只有参数类型变化时客户端才会重新发送
+   */
+  vector<uint16_t> &bound_param_types() { return bound_param_types_; }
+
+  /**
+   * @brief 取出保存的计划
+   * @details 键不同(参数类型或执行模式变化)或者计划已经过期时返回空
+   */
+  unique_ptr<CachedPlan> take_plan(const string &key);
+
+  /**
+   * @brief 执行完成后保存计划，包含不能重复执行的算子的计划不保存
+   */
+  void put_plan(unique_ptr<CachedPlan> plan);
+
+  void clear_plan() { plan_.reset(); }
+
+private:
+  uint32_t               id_        = 0;
+  string                 sql_;
+  int                    param_num_ = 0;
+  vector<uint16_t>       bound_param_types_;
+  unique_ptr<CachedPlan> plan_;
+};
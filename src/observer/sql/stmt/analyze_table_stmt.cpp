@@ -0,0 +1,25 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/stmt/analyze_table_stmt.h"
+#include "common/log/log.h"
+#include "storage/db/db.h"
+
+RC AnalyzeTableStmt::create(Db *db, const AnalyzeTableSqlNode &analyze_table, Stmt *&stmt)
+{
+  Table *table = db->find_table(analyze_table.relation_name.c_str());
+  if (table == nullptr) {
+    LOG_WARN("no such table. db=%s, table_name=%s", db->name(), analyze_table.relation_name.c_str());
+    return RC::SCHEMA_TABLE_NOT_EXIST;
+  }
+
+  stmt = new AnalyzeTableStmt(table);
+  return RC::SUCCESS;
+}
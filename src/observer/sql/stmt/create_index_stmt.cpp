@@ -66,7 +66,30 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
     return RC::SCHEMA_INDEX_NAME_REPEAT;
   }
 
+  // 没有指定索引类型时使用B+树
+  IndexType index_type = IndexType::BPLUS_TREE;
+  if (!create_index.index_type.empty()) {
+    index_type = get_index_type(create_index.index_type.c_str());
+  }
+  if (index_type == IndexType::UNKNOWN_TYPE) {
+    LOG_WARN("unsupported index type. index name=%s, type=%s",
+             create_index.index_name.c_str(), create_index.index_type.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
   // 创建创建索引语句对象并返回成功
-  stmt = new CreateIndexStmt(table, field_meta, create_index.index_name);
+  stmt = new CreateIndexStmt(table, field_meta, create_index.index_name, index_type);
   return RC::SUCCESS;
+}
+
+// 获取索引类型的静态方法
+IndexType CreateIndexStmt::get_index_type(const char *type_str)
+{
+  IndexType type = IndexType::UNKNOWN_TYPE;
+  if (0 == strcasecmp(type_str, "BTREE")) {
+    type = IndexType::BPLUS_TREE;
+  } else if (0 == strcasecmp(type_str, "HASH")) {
+    type = IndexType::HASH;
+  }
+  return type;
 }
\ No newline at end of file
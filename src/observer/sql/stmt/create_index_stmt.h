@@ -17,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 #include <string>  // 引入标准库中的字符串类
 
 // 引入项目中定义的其他头文件
+#include "common/types.h"  // 引入索引类型定义
 #include "sql/stmt/stmt.h"  // 引入SQL语句基类的头文件
 
 // 声明外部依赖的结构体和类
@@ -32,8 +33,8 @@ class CreateIndexStmt : public Stmt  // 继承自Stmt基类
 {
 public:
   // 构造函数，初始化表对象、字段元数据和索引名
-  CreateIndexStmt(Table *table, const FieldMeta *field_meta, const std::string &index_name)
-      : table_(table), field_meta_(field_meta), index_name_(index_name) {}
+  CreateIndexStmt(Table *table, const FieldMeta *field_meta, const std::string &index_name, IndexType index_type)
+      : table_(table), field_meta_(field_meta), index_name_(index_name), index_type_(index_type) {}
 
   // 默认的虚析构函数
   virtual ~CreateIndexStmt() = default;
@@ -50,13 +51,20 @@ public:
   // 提供对索引名的访问
   const std::string &index_name() const { return index_name_; }
 
+  // 提供对索引类型的访问
+  IndexType index_type() const { return index_type_; }
+
 public:
   // 静态方法，用于创建CreateIndexStmt对象
   static RC create(Db *db, const CreateIndexSqlNode &create_index, Stmt *&stmt);
 
+  // 静态方法，将 USING 子句中的类型名称转换为索引类型，不区分大小写
+  static IndexType get_index_type(const char *type_str);
+
 private:
   // 成员变量
   Table *table_;      // 指向表对象的指针
   const FieldMeta *field_meta_;  // 指向字段元数据的指针
   std::string index_name_;  // 索引名
+  IndexType index_type_ = IndexType::BPLUS_TREE;  // 索引类型
 };
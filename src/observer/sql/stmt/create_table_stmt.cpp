@@ -13,6 +13,8 @@ See the Mulan PSL v2 for more details. */
 //
 // 包含日志记录相关的头文件
 #include "common/log/log.h"
+// 包含算法相关的头文件
+#include "common/lang/algorithm.h"
 // 包含类型定义的头文件
 #include "common/types.h"
 // 包含创建表语句的头文件
@@ -25,9 +27,11 @@ RC CreateTableStmt::create(Db *db, const CreateTableSqlNode &create_table, Stmt
 {
   // 初始化存储格式为未知
   StorageFormat storage_format = StorageFormat::UNKNOWN_FORMAT;
-  // 如果没有指定存储格式，则默认使用行格式
+  // 如果没有指定存储格式，有变长字符串字段时使用变长行格式，否则默认使用行格式
   if (create_table.storage_format.length() == 0) {
-    storage_format = StorageFormat::ROW_FORMAT;
+    const bool has_var_len = any_of(create_table.attr_infos.begin(), create_table.attr_infos.end(),
+        [](const AttrInfoSqlNode &attr_info) { return attr_info.var_len; });
+    storage_format = has_var_len ? StorageFormat::VAR_ROW_FORMAT : StorageFormat::ROW_FORMAT;
   } else {
     // 否则，根据字符串解析存储格式
     storage_format = get_storage_format(create_table.storage_format.c_str());
@@ -54,6 +58,9 @@ StorageFormat CreateTableStmt::get_storage_format(const char *format_str) {
   // 如果字符串为"PAX"（不区分大小写），则设置为PAX格式
   } else if (0 == strcasecmp(format_str, "PAX")) {
     format = StorageFormat::PAX_FORMAT;
+  // 如果字符串为"VAR_ROW"（不区分大小写），则设置为变长行格式
+  } else if (0 == strcasecmp(format_str, "VAR_ROW")) {
+    format = StorageFormat::VAR_ROW_FORMAT;
   // 如果不是已知的存储格式，保持为未知
   } else {
     format = StorageFormat::UNKNOWN_FORMAT;
@@ -16,7 +16,9 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/stmt.h"  // 包含SQL语句基类的头文件
 
 // 解释语句类的构造函数
-ExplainStmt::ExplainStmt(std::unique_ptr<Stmt> child_stmt) : child_stmt_(std::move(child_stmt)) {}
+ExplainStmt::ExplainStmt(std::unique_ptr<Stmt> child_stmt, bool analyze)
+    : child_stmt_(std::move(child_stmt)), analyze_(analyze)
+{}
 
 // 创建解释语句的静态方法
 RC ExplainStmt::create(Db *db, const ExplainSqlNode &explain, Stmt *&stmt)
@@ -31,6 +33,6 @@ RC ExplainStmt::create(Db *db, const ExplainSqlNode &explain, Stmt *&stmt)
   // 创建一个指向子语句的智能指针
   std::unique_ptr<Stmt> child_stmt_ptr = std::unique_ptr<Stmt>(child_stmt);
   // 创建解释语句对象，并将子语句的智能指针传递给构造函数
-  stmt = new ExplainStmt(std::move(child_stmt_ptr));
+  stmt = new ExplainStmt(std::move(child_stmt_ptr), explain.analyze);
   return rc;  // 返回创建子语句时的状态码
 }
\ No newline at end of file
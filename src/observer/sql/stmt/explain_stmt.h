@@ -24,8 +24,10 @@ See the Mulan PSL v2 for more details. */
 class ExplainStmt : public Stmt  // 继承自Stmt基类
 {
 public:
-  // 构造函数，接受一个指向子语句的unique_ptr
-  ExplainStmt(std::unique_ptr<Stmt> child_stmt) : child_stmt_(std::move(child_stmt)) {}
+  // 构造函数，接受一个指向子语句的unique_ptr，analyze 表示是否为 EXPLAIN ANALYZE
+  ExplainStmt(std::unique_ptr<Stmt> child_stmt, bool analyze)
+      : child_stmt_(std::move(child_stmt)), analyze_(analyze)
+  {}
 
   // 默认的虚析构函数
   virtual ~ExplainStmt() = default;
@@ -36,10 +38,15 @@ public:
   // 提供对子语句的访问
   Stmt *child() const { return child_stmt_.get(); }
 
+  // 是否为 EXPLAIN ANALYZE，需要执行语句
+  bool analyze() const { return analyze_; }
+
   // 静态方法，用于创建ExplainStmt对象
   static RC create(Db *db, const ExplainSqlNode &query, Stmt *&stmt);
 
 private:
   // 成员变量，指向子语句的unique_ptr
   std::unique_ptr<Stmt> child_stmt_;
+  // 是否为 EXPLAIN ANALYZE
+  bool analyze_ = false;
 };
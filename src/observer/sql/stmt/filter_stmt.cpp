@@ -111,7 +111,11 @@ RC FilterStmt::create_filter_unit(Db *db, Table *default_table, std::unordered_m
     filter_unit->set_left(filter_obj);  // 设置左操作数
   } else {  // 如果条件的左操作数是值
     FilterObj filter_obj;  // 创建FilterObj对象
-    filter_obj.init_value(condition.left_value);  // 初始化为值
+    if (condition.left_param >= 0) {
+      filter_obj.init_param(condition.left_param);  // 初始化为参数
+    } else {
+      filter_obj.init_value(condition.left_value);  // 初始化为值
+    }
     filter_unit->set_left(filter_obj);  // 设置左操作数
   }
 
@@ -129,7 +133,11 @@ RC FilterStmt::create_filter_unit(Db *db, Table *default_table, std::unordered_m
     filter_unit->set_right(filter_obj);  // 设置右操作数
   } else {  // 如果条件的右操作数是值
     FilterObj filter_obj;  // 创建FilterObj对象
-    filter_obj.init_value(condition.right_value);  // 初始化为值
+    if (condition.right_param >= 0) {
+      filter_obj.init_param(condition.right_param);  // 初始化为参数
+    } else {
+      filter_obj.init_value(condition.right_value);  // 初始化为值
+    }
     filter_unit->set_right(filter_obj);  // 设置右操作数
   }
 
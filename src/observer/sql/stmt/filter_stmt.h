@@ -30,6 +30,7 @@ struct FilterObj
   bool  is_attr;         // 是否是属性
   Field field;          // 字段信息，当is_attr为true时使用
   Value value;          // 值信息，当is_attr为false时使用
+  int   param_index = -1;  // 参数(?)的序号，不小于0时表示是参数，执行时才知道值
 
   // 初始化为属性
   void init_attr(const Field &field)
@@ -44,6 +45,13 @@ struct FilterObj
     is_attr = false;
     this->value = value;
   }
+
+  // 初始化为参数
+  void init_param(int index)
+  {
+    is_attr = false;
+    param_index = index;
+  }
 };
 
 // 过滤单元类，表示一个条件表达式，如 "field = value"
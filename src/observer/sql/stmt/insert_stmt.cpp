@@ -19,11 +19,8 @@ See the Mulan PSL v2 for more details. */
 
 // 插入语句的构造函数
 // @table: 要插入数据的表
-// @values: 要插入的值数组
-// @value_amount: 值的数量
-InsertStmt::InsertStmt(Table *table, const Value *values, int value_amount)
-    : table_(table), values_(values), value_amount_(value_amount)
-{}
+// @rows: 要插入的所有行
+InsertStmt::InsertStmt(Table *table, const std::vector<std::vector<Value>> *rows) : table_(table), rows_(rows) {}
 
 // 创建插入语句的函数
 // @db: 数据库实例
@@ -50,18 +47,19 @@ RC InsertStmt::create(Db *db, const InsertSqlNode &inserts, Stmt *&stmt)
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
-  // 检查字段数量是否匹配
-  const Value     *values     = inserts.values.data();     // 要插入的值数组
-  const int        value_num  = static_cast<int>(inserts.values.size());  // 值的数量
+  // 检查每一行的字段数量是否匹配
   const TableMeta &table_meta = table->table_meta();       // 表的元数据
   const int        field_num  = table_meta.field_num() - table_meta.sys_field_num();  // 表的字段数量（不包括系统字段）
-  if (field_num != value_num) {
-    // 如果字段数量不匹配，记录警告日志，并返回字段缺失错误码
-    LOG_WARN("schema mismatch. value num=%d, field num in schema=%d", value_num, field_num);
-    return RC::SCHEMA_FIELD_MISSING;
+  for (size_t i = 0; i < inserts.values.size(); i++) {
+    const int value_num = static_cast<int>(inserts.values[i].size());  // 这一行值的数量
+    if (field_num != value_num) {
+      // 如果字段数量不匹配，记录警告日志，并返回字段缺失错误码
+      LOG_WARN("schema mismatch. row=%d, value num=%d, field num in schema=%d", static_cast<int>(i), value_num, field_num);
+      return RC::SCHEMA_FIELD_MISSING;
+    }
   }
 
   // 如果一切正常，创建插入语句对象，并返回成功码
-  stmt = new InsertStmt(table, values, value_num);
+  stmt = new InsertStmt(table, &inserts.values);
   return RC::SUCCESS;
 }
\ No newline at end of file
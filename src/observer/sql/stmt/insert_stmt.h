@@ -31,9 +31,8 @@ public:
 
   // 带参数的构造函数
   // @table: 要插入数据的表
-  // @values: 要插入的值数组
-  // @value_amount: 值的数量
-  InsertStmt(Table *table, const Value *values, int value_amount);
+  // @rows: 要插入的所有行，每一行是一个值数组
+  InsertStmt(Table *table, const std::vector<std::vector<Value>> *rows);
 
   // 返回语句类型，这里是插入语句
   StmtType type() const override { return StmtType::INSERT; }
@@ -49,19 +48,16 @@ public:
   // 获取插入语句相关的表对象
   Table *table() const { return table_; }
 
-  // 获取要插入的值数组
-  const Value *values() const { return values_; }
+  // 获取要插入的所有行
+  const std::vector<std::vector<Value>> &rows() const { return *rows_; }
 
-  // 获取要插入的值的数量
-  int value_amount() const { return value_amount_; }
+  // 获取要插入的行数
+  int row_amount() const { return static_cast<int>(rows_->size()); }
 
 private:
   // 插入语句相关的表对象指针
   Table *table_ = nullptr;
 
-  // 要插入的值数组指针
-  const Value *values_ = nullptr;
-
-  // 要插入的值的数量
-  int value_amount_ = 0;
+  // 要插入的所有行，指向语法树中的数据
+  const std::vector<std::vector<Value>> *rows_ = nullptr;
 };
@@ -83,6 +83,54 @@ RC SelectStmt::create(Db *db, SelectSqlNode &select_sql, Stmt *&stmt)
     }
   }
 
+  // 绑定ORDER BY子句。排序的表达式如果不在SELECT子句中，就作为隐藏列追加到查询表达式的后面，
+  // 这样排序算子只需要放在投影之上，按照列的下标取排序键，输出时再去掉隐藏列
+  const int           visible_expression_num = static_cast<int>(bound_expressions.size());  // SELECT子句中的列数
+  vector<OrderByUnit> order_by;  // 排序列
+  for (OrderBySqlNode &order_by_node : select_sql.order_by) {
+    unique_ptr<Expression> &expression = order_by_node.expression;
+    if (expression->type() == ExprType::VALUE) {
+      // ORDER BY 1 表示按照SELECT子句中的第1列排序
+      const Value &value = static_cast<ValueExpr *>(expression.get())->get_value();
+      if (value.attr_type() != AttrType::INTS || value.get_int() < 1 || value.get_int() > visible_expression_num) {
+        LOG_WARN("invalid order by position. value=%s, select list size=%d", value.to_string().c_str(), visible_expression_num);
+        return RC::INVALID_ARGUMENT;
+      }
+      order_by.push_back(OrderByUnit{value.get_int() - 1, order_by_node.ascending});
+      continue;
+    }
+
+    vector<unique_ptr<Expression>> order_by_expressions;  // 绑定后的排序表达式
+    RC rc = expression_binder.bind_expression(expression, order_by_expressions);
+    if (OB_FAIL(rc)) {
+      LOG_INFO("bind order by expression failed. rc=%s", strrc(rc));  // 日志记录绑定表达式失败的信息
+      return rc;
+    }
+    if (order_by_expressions.size() != 1) {
+      LOG_WARN("order by expression should be a single column. size=%d", order_by_expressions.size());
+      return RC::INVALID_ARGUMENT;
+    }
+
+    unique_ptr<Expression> &order_by_expression = order_by_expressions.front();
+    int column = -1;  // 排序表达式在查询表达式中的位置
+    for (size_t i = 0; i < bound_expressions.size(); i++) {
+      if (bound_expressions[i]->equal(*order_by_expression)) {
+        column = static_cast<int>(i);
+        break;
+      }
+    }
+    if (column < 0) {
+      column = static_cast<int>(bound_expressions.size());
+      bound_expressions.push_back(std::move(order_by_expression));  // 作为隐藏列
+    }
+    order_by.push_back(OrderByUnit{column, order_by_node.ascending});
+  }
+
+  if (select_sql.limit.offset < 0) {
+    LOG_WARN("invalid offset. offset=%d", select_sql.limit.offset);
+    return RC::INVALID_ARGUMENT;
+  }
+
   Table *default_table = nullptr;  // 默认表对象指针
   if (tables.size() == 1) {
     default_table = tables[0];  // 如果只有一个表，则设置为默认表
@@ -108,6 +156,10 @@ RC SelectStmt::create(Db *db, SelectSqlNode &select_sql, Stmt *&stmt)
   select_stmt->query_expressions_.swap(bound_expressions);  // 交换查询表达式向量
   select_stmt->filter_stmt_ = filter_stmt;  // 设置过滤语句对象
   select_stmt->group_by_.swap(group_by_expressions);  // 交换GROUP BY子句中的表达式向量
+  select_stmt->order_by_.swap(order_by);  // 交换ORDER BY子句的排序列
+  select_stmt->visible_expression_num_ = visible_expression_num;
+  select_stmt->limit_  = select_sql.limit.limit;
+  select_stmt->offset_ = select_sql.limit.offset;
   stmt                      = select_stmt;  // 将SelectStmt对象赋值给stmt
   return RC::SUCCESS;  // 返回成功
 }
\ No newline at end of file
@@ -26,6 +26,16 @@ class FilterStmt;  // 过滤语句类的前向声明
 class Db;  // 数据库类的前向声明
 class Table;  // 表类的前向声明
 
+/**
+ * @brief order by 中的一项
+ * @details 排序的表达式都放在查询表达式中，这里只记录它在查询表达式中的位置
+ */
+struct OrderByUnit
+{
+  int  column;     ///< 排序表达式在查询表达式中的下标
+  bool ascending;  ///< 是否升序
+};
+
 /**
  * @brief 表示select语句
  * @ingroup Statement
@@ -48,9 +58,18 @@ public:
   std::vector<std::unique_ptr<Expression>> &query_expressions() { return query_expressions_; }  // 获取查询表达式向量的访问器
   std::vector<std::unique_ptr<Expression>> &group_by() { return group_by_; }  // 获取GROUP BY子句中表达式向量的访问器
 
+  const std::vector<OrderByUnit> &order_by() const { return order_by_; }  // 获取ORDER BY子句的访问器
+  int  visible_expression_num() const { return visible_expression_num_; }  // 查询结果中需要返回给客户端的列数
+  int  limit() const { return limit_; }  // 最多返回多少行，小于0表示没有limit
+  int  offset() const { return offset_; }  // 跳过前面多少行
+
 private:
   std::vector<std::unique_ptr<Expression>> query_expressions_;  // 存储查询表达式的向量
   std::vector<Table *> tables_;  // 存储表对象的向量
   FilterStmt *filter_stmt_ = nullptr;  // 指向过滤语句对象的指针
   std::vector<std::unique_ptr<Expression>> group_by_;  // 存储GROUP BY子句中表达式的向量
+  std::vector<OrderByUnit> order_by_;  // 存储ORDER BY子句的排序列
+  int visible_expression_num_ = 0;  // 查询表达式中前面这些是SELECT子句中的，后面的是只用于排序的隐藏列
+  int limit_ = -1;  // LIMIT子句
+  int offset_ = 0;  // OFFSET子句
 };
\ No newline at end of file
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 #include "sql/stmt/stmt.h"  // 包含基础的SQL语句类定义
 #include "common/log/log.h"  // 包含日志记录功能
+#include "sql/stmt/analyze_table_stmt.h"  // 包含收集统计信息语句类定义
 #include "sql/stmt/calc_stmt.h"  // 包含计算语句类定义
 #include "sql/stmt/create_index_stmt.h"  // 包含创建索引语句类定义
 #include "sql/stmt/create_table_stmt.h"  // 包含创建表语句类定义
@@ -28,6 +29,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/show_tables_stmt.h"  // 包含显示表语句类定义
 #include "sql/stmt/trx_begin_stmt.h"  // 包含事务开始语句类定义
 #include "sql/stmt/trx_end_stmt.h"  // 包含事务结束语句类定义
+#include "sql/stmt/update_stmt.h"  // 包含更新语句类定义
 
 // 判断语句类型是否为数据定义语言（DDL）类型
 bool stmt_type_ddl(StmtType type) {
@@ -35,7 +37,8 @@ bool stmt_type_ddl(StmtType type) {
     case StmtType::CREATE_TABLE:  // 创建表
     case StmtType::DROP_TABLE:  // 删除表
     case StmtType::DROP_INDEX:  // 删除索引
-    case StmtType::CREATE_INDEX: {  // 创建索引
+    case StmtType::CREATE_INDEX:  // 创建索引
+    case StmtType::ANALYZE_TABLE: {  // 收集统计信息，统计信息保存在元数据中
       return true;  // 是DDL类型
     }
     default: {
@@ -56,6 +59,9 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt) {
     case SCF_DELETE: {  // 删除语句
       return DeleteStmt::create(db, sql_node.deletion, stmt);
     }
+    case SCF_UPDATE: {  // 更新语句
+      return UpdateStmt::create(db, sql_node.update, stmt);
+    }
     case SCF_SELECT: {  // 查询语句
       return SelectStmt::create(db, sql_node.selection, stmt);
     }
@@ -76,6 +82,10 @@ RC Stmt::create_stmt(Db *db, ParsedSqlNode &sql_node, Stmt *&stmt) {
       return DescTableStmt::create(db, sql_node.desc_table, stmt);
     }
 
+    case SCF_ANALYZE_TABLE: {  // 收集统计信息语句
+      return AnalyzeTableStmt::create(db, sql_node.analyze_table, stmt);
+    }
+
     case SCF_HELP: {  // 帮助语句
       return HelpStmt::create(stmt);
     }
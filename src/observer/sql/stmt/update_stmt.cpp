@@ -12,21 +12,89 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2022/5/22.
 //
 #include "sql/stmt/update_stmt.h"  // 包含更新语句类的头文件
+#include "common/log/log.h"
+#include "sql/stmt/filter_stmt.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
 
 // 构造函数，初始化更新语句所需的成员变量
-UpdateStmt::UpdateStmt(Table *table, Value *values, int value_amount)
-    : table_(table), values_(values), value_amount_(value_amount)
+UpdateStmt::UpdateStmt(
+    Table *table, std::vector<const FieldMeta *> fields, std::vector<Value> values, FilterStmt *filter_stmt)
+    : table_(table), fields_(std::move(fields)), values_(std::move(values)), filter_stmt_(filter_stmt)
 {}
 
+UpdateStmt::~UpdateStmt()
+{
+  if (nullptr != filter_stmt_) {
+    delete filter_stmt_;
+    filter_stmt_ = nullptr;
+  }
+}
+
 // 静态方法，用于创建UpdateStmt对象
 RC UpdateStmt::create(Db *db, const UpdateSqlNode &update, Stmt *&stmt)
 {
-  // TODO: 这里应该包含根据提供的更新SQL节点（update）来创建更新语句对象的逻辑
-  // 目前这部分代码还未实现，只是一个占位符
-  
-  // 初始化stmt为nullptr，表示创建失败或尚未创建对象
   stmt = nullptr;
-  
-  // 返回内部错误状态码，表示创建过程未完成或存在错误
-  return RC::INTERNAL;
+
+  const char *table_name = update.relation_name.c_str();
+  if (nullptr == db || update.set_clauses.empty()) {
+    LOG_WARN("invalid argument. db=%p, set clauses=%d", db, static_cast<int>(update.set_clauses.size()));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 检查表是否存在
+  Table *table = db->find_table(table_name);
+  if (nullptr == table) {
+    LOG_WARN("no such table. db=%s, table_name=%s", db->name(), table_name);
+    return RC::SCHEMA_TABLE_NOT_EXIST;
+  }
+
+  // 检查字段是否存在，并把值转换成字段的类型
+  const TableMeta               &table_meta = table->table_meta();
+  std::vector<const FieldMeta *> fields;
+  std::vector<Value>             values;
+  for (const SetClauseSqlNode &set_clause : update.set_clauses) {
+    const FieldMeta *field = table_meta.field(set_clause.attribute_name.c_str());
+    if (nullptr == field || !field->visible()) {
+      LOG_WARN("no such field. table=%s, field=%s", table_name, set_clause.attribute_name.c_str());
+      return RC::SCHEMA_FIELD_NOT_EXIST;
+    }
+
+    for (const FieldMeta *other : fields) {
+      if (other == field) {
+        LOG_WARN("field updated more than once. table=%s, field=%s", table_name, field->name());
+        return RC::INVALID_ARGUMENT;
+      }
+    }
+
+    Value value;
+    if (field->type() != set_clause.value.attr_type()) {
+      RC rc = Value::cast_to(set_clause.value, field->type(), value);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to cast value. table=%s, field=%s, value=%s, rc=%s",
+                 table_name, field->name(), set_clause.value.to_string().c_str(), strrc(rc));
+        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+      }
+    } else {
+      value = set_clause.value;
+    }
+
+    fields.push_back(field);
+    values.emplace_back(std::move(value));
+  }
+
+  // 创建过滤条件语句
+  std::unordered_map<std::string, Table *> table_map;
+  table_map.insert(std::pair<std::string, Table *>(std::string(table_name), table));
+
+  FilterStmt *filter_stmt = nullptr;
+  RC          rc          = FilterStmt::create(
+      db, table, &table_map, update.conditions.data(), static_cast<int>(update.conditions.size()), filter_stmt);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create filter statement. rc=%d:%s", rc, strrc(rc));
+    return rc;
+  }
+
+  stmt = new UpdateStmt(table, std::move(fields), std::move(values), filter_stmt);
+  return RC::SUCCESS;
 }
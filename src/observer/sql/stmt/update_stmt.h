@@ -17,6 +17,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/stmt.h"  // 引入基础的SQL语句类定义
 
 class Table;  // 声明Table类，表示数据库中的表
+class FieldMeta;
+class FilterStmt;
 
 /**
  * @brief 代表更新语句的类
@@ -28,8 +30,15 @@ public:
   // 默认构造函数
   UpdateStmt() = default;
 
-  // 构造函数，初始化更新语句所需的成员变量
-  UpdateStmt(Table *table, Value *values, int value_amount);
+  /**
+   * @brief 构造函数，初始化更新语句所需的成员变量
+   * @param fields 要更新的字段
+   * @param values 每个字段的新值，已经转换成了字段的类型
+   */
+  UpdateStmt(Table *table, std::vector<const FieldMeta *> fields, std::vector<Value> values, FilterStmt *filter_stmt);
+  ~UpdateStmt() override;
+
+  StmtType type() const override { return StmtType::UPDATE; }
 
 public:
   // 静态方法，用于创建UpdateStmt对象
@@ -39,15 +48,19 @@ public:
   // 访问器方法，获取更新语句涉及的表对象
   Table *table() const { return table_; }
 
+  // 访问器方法，获取要更新的字段
+  const std::vector<const FieldMeta *> &fields() const { return fields_; }
+
   // 访问器方法，获取更新语句中要设置的新值
-  Value *values() const { return values_; }
+  const std::vector<Value> &values() const { return values_; }
 
-  // 访问器方法，获取新值的数量
-  int value_amount() const { return value_amount_; }
+  // 访问器方法，获取过滤条件
+  FilterStmt *filter_stmt() const { return filter_stmt_; }
 
 private:
   // 成员变量
-  Table *table_        = nullptr;  // 指向更新语句涉及的表对象
-  Value *values_       = nullptr;  // 指向更新语句中要设置的新值数组
-  int value_amount_    = 0;        // 新值的数量
+  Table                         *table_       = nullptr;  // 指向更新语句涉及的表对象
+  std::vector<const FieldMeta *> fields_;                 // 要更新的字段
+  std::vector<Value>             values_;                 // 每个字段的新值
+  FilterStmt                    *filter_stmt_ = nullptr;  // 过滤条件
 };
@@ -31,6 +31,7 @@ string BufferPoolLogEntry::to_string() const
   return string("buffer_pool_id=") + std::to_string(buffer_pool_id) +
          // 将page_num转换为字符串并拼接
          ", page_num=" + std::to_string(page_num) +
+         ", value=" + std::to_string(value) +
          // 将operation_type转换为字符串并拼接，这里通过BufferPoolOperation类型来获取操作类型的字符串表示
          ", operation_type=" + BufferPoolOperation(operation_type).to_string();
 }
@@ -58,7 +59,7 @@ BufferPoolLogHandler::BufferPoolLogHandler(DiskBufferPool &buffer_pool, LogHandl
  */
 RC BufferPoolLogHandler::allocate_page(PageNum page_num, LSN &lsn)
 {
-  return append_log(BufferPoolOperation::Type::ALLOCATE, page_num, lsn);
+  return append_log(BufferPoolOperation::Type::ALLOCATE, page_num, 0 /*value*/, lsn);
 }
 
 /**
@@ -75,7 +76,17 @@ RC BufferPoolLogHandler::allocate_page(PageNum page_num, LSN &lsn)
 RC BufferPoolLogHandler::deallocate_page(PageNum page_num, LSN &lsn)
 {
   // Appends a deallocation log entry, recording the details of the deallocation operation.
-  return append_log(BufferPoolOperation::Type::DEALLOCATE, page_num, lsn);
+  return append_log(BufferPoolOperation::Type::DEALLOCATE, page_num, 0 /*value*/, lsn);
+}
+
+RC BufferPoolLogHandler::allocate_fsm_page(PageNum page_num, int32_t slot, LSN &lsn)
+{
+  return append_log(BufferPoolOperation::Type::ALLOCATE_FSM, page_num, slot, lsn);
+}
+
+RC BufferPoolLogHandler::set_free_space_level(PageNum page_num, int32_t level, LSN &lsn)
+{
+  return append_log(BufferPoolOperation::Type::SET_FREE_SPACE, page_num, level, lsn);
 }
 
 /**
@@ -107,12 +118,13 @@ RC BufferPoolLogHandler::flush_page(Page &page)
  * 它首先创建一个BufferPoolLogEntry对象，填充必要的信息，包括缓冲池ID、页面编号和操作类型
  * 然后调用log_handler_的append方法将日志条目追加到日志中
  */
-RC BufferPoolLogHandler::append_log(BufferPoolOperation::Type type, PageNum page_num, LSN &lsn)
+RC BufferPoolLogHandler::append_log(BufferPoolOperation::Type type, PageNum page_num, int32_t value, LSN &lsn)
 {
   // 创建日志条目对象并填充必要信息
   BufferPoolLogEntry log;
   log.buffer_pool_id = buffer_pool_.id();
   log.page_num = page_num;
+  log.value = value;
   log.operation_type = BufferPoolOperation(type).type_id();
 
   // 调用日志处理器的append方法，将日志条目追加到日志中
@@ -170,6 +182,12 @@ RC BufferPoolLogReplayer::replay(const LogEntry &entry)
     case BufferPoolOperation::Type::DEALLOCATE:
       // 重放释放页面的操作
       return buffer_pool->redo_deallocate_page(entry.lsn(), log->page_num);
+    case BufferPoolOperation::Type::ALLOCATE_FSM:
+      // 重放分配空闲空间映射页面的操作
+      return buffer_pool->redo_allocate_fsm_page(entry.lsn(), log->page_num, log->value);
+    case BufferPoolOperation::Type::SET_FREE_SPACE:
+      // 重放设置空闲空间等级的操作
+      return buffer_pool->redo_set_free_space_level(entry.lsn(), log->page_num, log->value);
     default:
       // 如果操作类型未知，记录错误并返回内部错误状态码
       LOG_ERROR("unknown buffer pool operation. operation=%s", operation.to_string().c_str());
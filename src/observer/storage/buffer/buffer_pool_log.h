@@ -33,8 +33,10 @@ class BufferPoolOperation
 public:
   enum class Type : int32_t
   {
-    ALLOCATE,   /// 分配页面
-    DEALLOCATE  /// 释放页面
+    ALLOCATE,         /// 分配页面
+    DEALLOCATE,       /// 释放页面
+    ALLOCATE_FSM,     /// 分配空闲空间映射页面
+    SET_FREE_SPACE    /// 设置页面的空闲空间等级
   };
 
 public:
@@ -51,6 +53,8 @@ public:
     switch (type_) {
       case Type::ALLOCATE: return ret + "ALLOCATE";
       case Type::DEALLOCATE: return ret + "DEALLOCATE";
+      case Type::ALLOCATE_FSM: return ret + "ALLOCATE_FSM";
+      case Type::SET_FREE_SPACE: return ret + "SET_FREE_SPACE";
       default: return ret + "UNKNOWN";
     }
   }
@@ -68,6 +72,7 @@ struct BufferPoolLogEntry
   int32_t buffer_pool_id;  /// buffer pool id
   int32_t operation_type;  /// operation type
   PageNum page_num;        /// page number
+  int32_t value;           /// ALLOCATE_FSM 是映射页面的序号，SET_FREE_SPACE 是空闲空间等级
 
   string to_string() const;
 };
@@ -97,6 +102,17 @@ public:
    */
   RC deallocate_page(PageNum page_num, LSN &lsn);
 
+  /**
+   * @brief 分配一个空闲空间映射页面
+   * @param slot 文件头中记录映射页面的位置
+   */
+  RC allocate_fsm_page(PageNum page_num, int32_t slot, LSN &lsn);
+
+  /**
+   * @brief 设置页面的空闲空间等级
+   */
+  RC set_free_space_level(PageNum page_num, int32_t level, LSN &lsn);
+
   /**
    * @brief 刷新页面到磁盘之前，需要保证页面对应的日志也已经刷新到磁盘
    * @details 如果页面刷新到磁盘了，但是日志很落后，在重启恢复时，就会出现异常，无法让所有的页面都恢复到一致的状态。
@@ -104,7 +120,7 @@ public:
   RC flush_page(Page &page);
 
 private:
-  RC append_log(BufferPoolOperation::Type type, PageNum page_num, LSN &lsn);
+  RC append_log(BufferPoolOperation::Type type, PageNum page_num, int32_t value, LSN &lsn);
 
 private:
   DiskBufferPool &buffer_pool_;
@@ -27,6 +27,22 @@ using namespace common;
 
 static const int MEM_POOL_ITEM_NUM = 20;
 
+/// 空闲空间映射页面中第 index 个页面的等级
+static int get_fsm_level(const char *data, int index)
+{
+  constexpr int entries_per_byte = 8 / FSM_BITS_PER_PAGE;
+  const int     shift            = (index % entries_per_byte) * FSM_BITS_PER_PAGE;
+  return (static_cast<uint8_t>(data[index / entries_per_byte]) >> shift) & FSM_MAX_LEVEL;
+}
+
+static void set_fsm_level(char *data, int index, int level)
+{
+  constexpr int entries_per_byte = 8 / FSM_BITS_PER_PAGE;
+  const int     shift            = (index % entries_per_byte) * FSM_BITS_PER_PAGE;
+  uint8_t      &byte             = reinterpret_cast<uint8_t &>(data[index / entries_per_byte]);
+  byte = static_cast<uint8_t>((byte & ~(FSM_MAX_LEVEL << shift)) | (level << shift));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -370,6 +386,7 @@ BufferPoolIterator::~BufferPoolIterator() {}
 RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
 {
   // 初始化位图，bitmap_用于跟踪页面的分配情况
+  buffer_pool_ = &bp;
   bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
   
   // 根据start_page参数设置当前页面数的初始值
@@ -391,7 +408,7 @@ RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
  *
  * @return 如果还有下一个元素，则返回true；否则返回false。
  */
-bool BufferPoolIterator::has_next() { return bitmap_.next_setted_bit(current_page_num_ + 1) != -1; }
+bool BufferPoolIterator::has_next() { return next_page(current_page_num_ + 1) != -1; }
 
 /**
  * @brief 获取下一个页面编号
@@ -405,13 +422,23 @@ bool BufferPoolIterator::has_next() { return bitmap_.next_setted_bit(current_pag
 PageNum BufferPoolIterator::next()
 {
   // 查找当前页面之后的下一个有效页面
-  PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
-  if (next_page != -1) {
+  PageNum page_num = next_page(current_page_num_ + 1);
+  if (page_num != -1) {
     // 更新当前页面编号为下一个有效页面的编号
-    current_page_num_ = next_page;
+    current_page_num_ = page_num;
   }
   // 返回下一个有效页面的编号，如果没有找到，则返回-1
-  return next_page;
+  return page_num;
+}
+
+PageNum BufferPoolIterator::next_page(PageNum start)
+{
+  // 空闲空间映射页面不是使用者的数据页面
+  PageNum page_num = bitmap_.next_setted_bit(start);
+  while (page_num != -1 && buffer_pool_->is_free_space_map_page(page_num)) {
+    page_num = bitmap_.next_setted_bit(page_num + 1);
+  }
+  return page_num;
 }
 
 // 重置BufferPoolIterator的状态，使其能够从头开始遍历
@@ -506,6 +533,12 @@ RC DiskBufferPool::open_file(const char *file_name)
   // 获取文件头指针
   file_header_ = (BPFileHeader *)hdr_frame_->data();
 
+  rc = load_free_space_map();
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to load free space map of %s. rc=%s", file_name, strrc(rc));
+    return rc;
+  }
+
   // 打开文件成功，记录信息日志，并返回成功
   LOG_INFO("Successfully open %s. file_desc=%d, hdr_frame=%p, file header=%s",
            file_name, file_desc_, hdr_frame_, file_header_->to_string().c_str());
@@ -523,6 +556,14 @@ RC DiskBufferPool::close_file()
 
   // 解除对头块的固定，使其可以被写入或替换
   hdr_frame_->unpin();
+  for (Frame *&fsm_frame : fsm_frames_) {
+    if (fsm_frame != nullptr) {
+      fsm_frame->unpin();
+      fsm_frame = nullptr;
+    }
+  }
+  fsm_search_bits_.clear();
+  fsm_search_start_ = 0;
 
   // TODO: 理论上是在回放时回滚未提交事务，但目前没有undo log，因此不下刷数据page，只通过redo log回放
   // 尝试清除所有页面，如果失败，则记录错误并返回
@@ -576,8 +617,10 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
     // If the page is already in the buffer pool, update its access time and return the frame
     used_match_frame->access();
     *frame = used_match_frame;
+    BufferPoolStat::thread_local_stat().hit_count++;
     return RC::SUCCESS;
   }
+  BufferPoolStat::thread_local_stat().miss_count++;
 
   // Lock the buffer pool to ensure thread safety during frame allocation and page loading
   scoped_lock lock_guard(lock_);  // Directly add a global lock, which can be optimized by using a finer-grained lock based on the accessed page to improve parallelism
@@ -613,7 +656,9 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
 }
 
 // Allocate a new page in the buffer pool
-RC DiskBufferPool::allocate_page(Frame **frame)
+RC DiskBufferPool::allocate_page(Frame **frame) { return allocate_page(frame, -1 /*fsm_slot*/); }
+
+RC DiskBufferPool::allocate_page(Frame **frame, int fsm_slot)
 {
   RC rc = RC::SUCCESS;
 
@@ -635,7 +680,12 @@ RC DiskBufferPool::allocate_page(Frame **frame)
         hdr_frame_->mark_dirty();
         LSN lsn = 0;
         // Log the allocation operation
-        rc = log_handler_.allocate_page(i, lsn);
+        if (fsm_slot >= 0) {
+          file_header_->fsm_pages()[fsm_slot] = i;
+          rc = log_handler_.allocate_fsm_page(i, fsm_slot, lsn);
+        } else {
+          rc = log_handler_.allocate_page(i, lsn);
+        }
         if (OB_FAIL(rc)) {
           LOG_ERROR("Failed to log allocate page %d, rc=%s", i, strrc(rc));
           // 忽略了错误
@@ -660,7 +710,12 @@ RC DiskBufferPool::allocate_page(Frame **frame)
 
   LSN lsn = 0;
   // Log the allocation operation for new pages
-  rc = log_handler_.allocate_page(file_header_->page_count, lsn);
+  if (fsm_slot >= 0) {
+    file_header_->fsm_pages()[fsm_slot] = file_header_->page_count;
+    rc = log_handler_.allocate_fsm_page(file_header_->page_count, fsm_slot, lsn);
+  } else {
+    rc = log_handler_.allocate_page(file_header_->page_count, lsn);
+  }
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to log allocate page %d, rc=%s", file_header_->page_count, strrc(rc));
     // 忽略了错误
@@ -672,6 +727,9 @@ RC DiskBufferPool::allocate_page(Frame **frame)
   Frame  *allocated_frame = nullptr;
   if ((rc = allocate_frame(page_num, &allocated_frame)) != RC::SUCCESS) {
     LOG_ERROR("Failed to allocate frame %s, due to no free page.", file_name_.c_str());
+    if (fsm_slot >= 0) {
+      file_header_->fsm_pages()[fsm_slot] = 0;
+    }
     lock_.unlock();
     return rc;
   }
@@ -885,10 +943,12 @@ RC DiskBufferPool::check_all_pages_unpinned()
     // 先取消钉住状态
     frame->unpin();
     // 检查BP_HEADER_PAGE的钉住计数是否超过1
-    if (frame->page_num() == BP_HEADER_PAGE && frame->pin_count() > 1) {
+    // 文件头和空闲空间映射页面一直是固定在内存中的
+    const bool always_pinned = frame->page_num() == BP_HEADER_PAGE || is_free_space_map_page(frame->page_num());
+    if (always_pinned && frame->pin_count() > 1) {
       LOG_WARN("This page has been pinned. id=%d, pageNum:%d, pin count=%d",
           id(), frame->page_num(), frame->pin_count());
-    } else if (frame->page_num() != BP_HEADER_PAGE && frame->pin_count() > 0) {
+    } else if (!always_pinned && frame->pin_count() > 0) {
       // 检查其他页面的钉住计数是否超过0
       LOG_WARN("This page has been pinned. id=%d, pageNum:%d, pin count=%d",
           id(), frame->page_num(), frame->pin_count());
@@ -1152,6 +1212,258 @@ RC DiskBufferPool::redo_deallocate_page(LSN lsn, PageNum page_num)
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::create_free_space_map()
+{
+  scoped_lock lock_guard(fsm_lock_);
+  Frame      *frame = nullptr;
+  return get_fsm_frame(BP_HEADER_PAGE, true /*create*/, frame);
+}
+
+int DiskBufferPool::free_space_level(PageNum page_num)
+{
+  if (page_num <= BP_HEADER_PAGE || page_num >= BPFileHeader::MAX_PAGE_NUM) {
+    return 0;
+  }
+
+  scoped_lock lock_guard(fsm_lock_);
+  Frame      *frame = nullptr;
+  get_fsm_frame(page_num, false /*create*/, frame);
+  return frame == nullptr ? 0 : get_fsm_level(frame->data(), page_num % FSM_ENTRIES_PER_PAGE);
+}
+
+RC DiskBufferPool::set_free_space_level(PageNum page_num, int level)
+{
+  if (page_num <= BP_HEADER_PAGE || page_num >= BPFileHeader::MAX_PAGE_NUM || level < 0 || level > FSM_MAX_LEVEL) {
+    LOG_WARN("invalid free space level. file=%s, page num=%d, level=%d", file_name_.c_str(), page_num, level);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  scoped_lock lock_guard(fsm_lock_);
+
+  // 等级是 0 时不需要为它分配映射页面
+  Frame *frame = nullptr;
+  RC     rc    = get_fsm_frame(page_num, level > 0 /*create*/, frame);
+  if (OB_FAIL(rc) || frame == nullptr) {
+    return rc;
+  }
+
+  const int index = page_num % FSM_ENTRIES_PER_PAGE;
+  if (get_fsm_level(frame->data(), index) == level) {
+    return RC::SUCCESS;
+  }
+
+  LSN lsn = 0;
+  rc      = log_handler_.set_free_space_level(page_num, level, lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log free space level. file=%s, page num=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+    return rc;
+  }
+
+  set_fsm_level(frame->data(), index, level);
+  frame->set_lsn(lsn);
+  frame->mark_dirty();
+
+  Bitmap search_bitmap(fsm_search_bits_.data(), BPFileHeader::MAX_PAGE_NUM);
+  if (level > 0) {
+    search_bitmap.set_bit(page_num);
+    fsm_search_start_ = std::min(fsm_search_start_, page_num);
+  } else {
+    search_bitmap.clear_bit(page_num);
+  }
+  return RC::SUCCESS;
+}
+
+PageNum DiskBufferPool::find_free_space_page(PageNum start)
+{
+  scoped_lock lock_guard(fsm_lock_);
+  const PageNum search_start = std::max(start, fsm_search_start_);
+  if (fsm_search_bits_.empty() || search_start >= BPFileHeader::MAX_PAGE_NUM) {
+    return BP_INVALID_PAGE_NUM;
+  }
+
+  // 优先使用页号小的页面
+  Bitmap  search_bitmap(fsm_search_bits_.data(), BPFileHeader::MAX_PAGE_NUM);
+  PageNum page_num = search_bitmap.next_setted_bit(search_start);
+  // 游标之前的页面都没有空闲空间，只有从游标开始找的时候才能移动游标
+  if (start <= fsm_search_start_) {
+    fsm_search_start_ = (page_num == -1) ? BPFileHeader::MAX_PAGE_NUM : page_num;
+  }
+  return page_num == -1 ? BP_INVALID_PAGE_NUM : page_num;
+}
+
+bool DiskBufferPool::is_free_space_map_page(PageNum page_num) const
+{
+  const PageNum *fsm_pages = file_header_->fsm_pages();
+  for (int i = 0; i < BPFileHeader::FSM_PAGE_NUM; i++) {
+    if (fsm_pages[i] != 0 && fsm_pages[i] == page_num) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int DiskBufferPool::free_space_map_page_count() const
+{
+  const PageNum *fsm_pages = file_header_->fsm_pages();
+  int            count     = 0;
+  for (int i = 0; i < BPFileHeader::FSM_PAGE_NUM; i++) {
+    if (fsm_pages[i] != 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+RC DiskBufferPool::load_free_space_map()
+{
+  const PageNum *fsm_pages = file_header_->fsm_pages();
+  for (int slot = 0; slot < BPFileHeader::FSM_PAGE_NUM; slot++) {
+    if (fsm_pages[slot] == 0) {
+      continue;
+    }
+
+    Frame *frame = nullptr;
+    RC     rc    = get_this_page(fsm_pages[slot], &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to load free space map page. file=%s, slot=%d, page num=%d, rc=%s",
+               file_name_.c_str(), slot, fsm_pages[slot], strrc(rc));
+      return rc;
+    }
+    attach_fsm_page(slot, frame);
+  }
+
+  LOG_INFO("load free space map done. file=%s, fsm pages=%d", file_name_.c_str(), free_space_map_page_count());
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::attach_fsm_page(int slot, Frame *frame)
+{
+  if (fsm_search_bits_.empty()) {
+    fsm_search_bits_.resize(BPFileHeader::MAX_PAGE_NUM / 8 + 1, 0);
+  }
+
+  // get_this_page 时已经 pin 住了，关闭文件时再 unpin
+  fsm_frames_[slot] = frame;
+
+  Bitmap        search_bitmap(fsm_search_bits_.data(), BPFileHeader::MAX_PAGE_NUM);
+  const char   *data       = frame->data();
+  const PageNum first_page = slot * FSM_ENTRIES_PER_PAGE;
+  for (int i = 0; i < FSM_ENTRIES_PER_PAGE && first_page + i < BPFileHeader::MAX_PAGE_NUM; i++) {
+    if (get_fsm_level(data, i) > 0) {
+      search_bitmap.set_bit(first_page + i);
+    }
+  }
+  fsm_search_start_ = 0;
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::get_fsm_frame(PageNum page_num, bool create, Frame *&frame)
+{
+  frame          = nullptr;
+  const int slot = page_num / FSM_ENTRIES_PER_PAGE;
+  if (slot >= BPFileHeader::FSM_PAGE_NUM) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (fsm_frames_[slot] != nullptr || !create) {
+    frame = fsm_frames_[slot];
+    return RC::SUCCESS;
+  }
+
+  Frame *new_frame = nullptr;
+  RC     rc        = allocate_page(&new_frame, slot);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate free space map page. file=%s, slot=%d, rc=%s", file_name_.c_str(), slot, strrc(rc));
+    return rc;
+  }
+
+  // 可能是以前释放的页面，里面有旧的数据
+  memset(new_frame->data(), 0, BP_PAGE_DATA_SIZE);
+  new_frame->set_lsn(hdr_frame_->lsn());
+  new_frame->mark_dirty();
+  attach_fsm_page(slot, new_frame);
+  frame = new_frame;
+  LOG_INFO("allocate free space map page. file=%s, slot=%d, page num=%d", file_name_.c_str(), slot, new_frame->page_num());
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::redo_allocate_fsm_page(LSN lsn, PageNum page_num, int slot)
+{
+  if (slot < 0 || slot >= BPFileHeader::FSM_PAGE_NUM) {
+    LOG_WARN("invalid free space map slot. file=%s, slot=%d", file_name_.c_str(), slot);
+    return RC::INTERNAL;
+  }
+
+  // 文件头中已经有了这个映射页面，打开文件时已经加载过了
+  if (hdr_frame_->lsn() >= lsn) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = redo_allocate_page(lsn, page_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  file_header_->fsm_pages()[slot] = page_num;
+  hdr_frame_->set_lsn(lsn);
+  hdr_frame_->mark_dirty();
+
+  Frame *frame = nullptr;
+  rc           = get_this_page(page_num, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get free space map page. file=%s, page num=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+    return rc;
+  }
+
+  if (frame->lsn() < lsn) {
+    memset(frame->data(), 0, BP_PAGE_DATA_SIZE);
+    frame->set_lsn(lsn);
+    frame->mark_dirty();
+  }
+
+  scoped_lock lock_guard(fsm_lock_);
+  if (fsm_frames_[slot] != nullptr) {
+    frame->unpin();
+    return RC::SUCCESS;
+  }
+  LOG_TRACE("[redo] allocate free space map page. file=%s, slot=%d, pageNum=%d", file_name_.c_str(), slot, page_num);
+  return attach_fsm_page(slot, frame);
+}
+
+RC DiskBufferPool::redo_set_free_space_level(LSN lsn, PageNum page_num, int level)
+{
+  if (page_num <= BP_HEADER_PAGE || page_num >= BPFileHeader::MAX_PAGE_NUM || level < 0 || level > FSM_MAX_LEVEL) {
+    LOG_WARN("invalid free space level. file=%s, page num=%d, level=%d", file_name_.c_str(), page_num, level);
+    return RC::INTERNAL;
+  }
+
+  scoped_lock lock_guard(fsm_lock_);
+  Frame      *frame = nullptr;
+  get_fsm_frame(page_num, false /*create*/, frame);
+  if (frame == nullptr) {
+    // 映射只是提示，缺少时不影响数据的正确性
+    LOG_WARN("free space map page not found. file=%s, page num=%d", file_name_.c_str(), page_num);
+    return RC::SUCCESS;
+  }
+
+  if (frame->lsn() >= lsn) {
+    return RC::SUCCESS;
+  }
+
+  set_fsm_level(frame->data(), page_num % FSM_ENTRIES_PER_PAGE, level);
+  frame->set_lsn(lsn);
+  frame->mark_dirty();
+
+  Bitmap search_bitmap(fsm_search_bits_.data(), BPFileHeader::MAX_PAGE_NUM);
+  if (level > 0) {
+    search_bitmap.set_bit(page_num);
+    fsm_search_start_ = std::min(fsm_search_start_, page_num);
+  } else {
+    search_bitmap.clear_bit(page_num);
+  }
+  return RC::SUCCESS;
+}
+
 /**
  * 分配一个帧并将其绑定到指定的页面编号
  * 如果没有可用的帧，尝试通过 purge 操作释放帧
@@ -1273,6 +1585,14 @@ RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
 
   // 从文件中读取页面数据。
   int ret = readn(file_desc_, &page, BP_PAGE_SIZE);
+  BufferPoolStat::thread_local_stat().read_count++;
+
+  // 已经分配但还没有刷过盘的页面在文件中不存在，重做日志时会遇到，当作一个空页面
+  if (ret == -1 && file_header_ != nullptr && page_num < file_header_->page_count) {
+    LOG_INFO("page is not on disk yet, use an empty page. file=%s, page num=%d", file_name_.c_str(), page_num);
+    memset(&page, 0, sizeof(page));
+    ret = 0;
+  }
   
   // 如果读取失败，记录错误日志并返回IOERR_READ错误。
   if (ret != 0) {
@@ -30,6 +30,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/mutex.h"
 #include "common/lang/memory.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
 #include "common/mm/mem_pool.h"
 #include "common/rc.h"
 #include "common/types.h"
@@ -68,14 +69,40 @@ struct BPFileHeader
   int32_t allocated_pages;  //! 已经分配了多少个页面
   char    bitmap[0];        //! 页面分配位图, 第0个页面(就是当前页面)，总是1
 
+  /**
+   * 空闲空间映射页面的最大个数。它们的页号放在文件头页面的最后，见 fsm_pages
+   */
+  static const int FSM_PAGE_NUM = 4;
+
   /**
    * 能够分配的最大的页面个数，即bitmap的字节数 乘以8
    */
-  static const int MAX_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(page_count) - sizeof(allocated_pages)) * 8;
+  static const int MAX_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(buffer_pool_id) - sizeof(page_count) -
+                                      sizeof(allocated_pages) - FSM_PAGE_NUM * sizeof(PageNum)) * 8;
+
+  /**
+   * @brief 空闲空间映射页面的页号，0 表示还没有分配
+   * @details 以前的文件在这个位置上是位图的最后几个字节，页面没有那么多时都是 0
+   */
+  PageNum *fsm_pages()
+  {
+    return reinterpret_cast<PageNum *>(reinterpret_cast<char *>(this) + BP_PAGE_DATA_SIZE) - FSM_PAGE_NUM;
+  }
+  const PageNum *fsm_pages() const { return const_cast<BPFileHeader *>(this)->fsm_pages(); }
 
   string to_string() const;
 };
 
+/// 空闲空间映射中每个页面使用的比特数
+static constexpr int FSM_BITS_PER_PAGE = 4;
+/// 空闲空间的最高等级，0 表示没有空闲空间
+static constexpr int FSM_MAX_LEVEL = (1 << FSM_BITS_PER_PAGE) - 1;
+/// 一个空闲空间映射页面能够记录的页面个数
+static constexpr int FSM_ENTRIES_PER_PAGE = BP_PAGE_DATA_SIZE * 8 / FSM_BITS_PER_PAGE;
+
+static_assert(BPFileHeader::FSM_PAGE_NUM * FSM_ENTRIES_PER_PAGE >= BPFileHeader::MAX_PAGE_NUM,
+    "free space map pages are not enough to cover all pages");
+
 /**
  * @brief 管理页面Frame
  * @ingroup BufferPool
@@ -175,8 +202,32 @@ public:
   RC      reset();
 
 private:
-  common::Bitmap bitmap_;
-  PageNum        current_page_num_ = -1;
+  /// 从 start 开始的下一个页面，跳过空闲空间映射页面
+  PageNum next_page(PageNum start);
+
+private:
+  DiskBufferPool *buffer_pool_ = nullptr;
+  common::Bitmap  bitmap_;
+  PageNum         current_page_num_ = -1;
+};
+
+/**
+ * @brief 当前线程访问缓冲池页面的计数
+ * @ingroup BufferPool
+ * @details 计数只在当前线程上累加，不需要同步。EXPLAIN ANALYZE 在调用每个算子的前后各读取一次，
+ * 两次之间的差值就是这个算子(包括它的子算子)访问的页面。
+ */
+struct BufferPoolStat
+{
+  uint64_t hit_count  = 0;  ///< 页面已经在内存中
+  uint64_t miss_count = 0;  ///< 页面不在内存中，需要分配新的页帧
+  uint64_t read_count = 0;  ///< 从磁盘文件中读取的页面
+
+  static BufferPoolStat &thread_local_stat()
+  {
+    static thread_local BufferPoolStat stat;
+    return stat;
+  }
 };
 
 /**
@@ -268,11 +319,54 @@ public:
   RC redo_allocate_page(LSN lsn, PageNum page_num);
   RC redo_deallocate_page(LSN lsn, PageNum page_num);
 
+  /**
+   * @brief 空闲空间映射(free space map)是否已经创建
+   * @details 空闲空间映射用 FSM_BITS_PER_PAGE 个比特记录每个页面的空闲空间等级，0 表示没有空闲空间，
+   * 其它等级的含义由使用者决定。映射保存在文件中专门的页面上，页号记录在文件头中，修改时记录日志，
+   * 打开文件时只需要读取这几个页面。BufferPoolIterator 会跳过这些页面。
+   * 映射只是一个提示，使用者拿到页面后仍然要检查页面是否真的有空间。
+   */
+  bool has_free_space_map() const { return file_header_->fsm_pages()[0] != 0; }
+
+  /**
+   * @brief 创建空闲空间映射，分配第一个映射页面
+   * @details 后面的映射页面在第一次记录它们覆盖的页面时才分配
+   */
+  RC create_free_space_map();
+
+  /// 页面的空闲空间等级，没有记录的页面是 0
+  int free_space_level(PageNum page_num);
+
+  /**
+   * @brief 设置页面的空闲空间等级
+   * @details 等级没有变化时什么都不做，所以不需要担心频繁调用会产生大量日志
+   */
+  RC set_free_space_level(PageNum page_num, int level);
+
+  /**
+   * @brief 找一个空闲空间等级大于 0 的页面
+   * @param start 从这个页面开始往后找。并发插入时调用者可以跳过其它线程正在使用的页面
+   * @return 没有时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum find_free_space_page(PageNum start = 0);
+
+  /// 是否是空闲空间映射页面
+  bool is_free_space_map_page(PageNum page_num) const;
+
+  /// 已经分配的空闲空间映射页面的个数
+  int free_space_map_page_count() const;
+
+  RC redo_allocate_fsm_page(LSN lsn, PageNum page_num, int slot);
+  RC redo_set_free_space_level(LSN lsn, PageNum page_num, int level);
+
 public:
   int32_t id() const { return buffer_pool_id_; }
 
   const char *filename() const { return file_name_.c_str(); }
 
+  /// 已经分配的页面个数，包含文件头页面
+  int32_t allocated_pages() const { return file_header_->allocated_pages; }
+
 protected:
   RC allocate_frame(PageNum page_num, Frame **buf);
 
@@ -292,6 +386,27 @@ protected:
    */
   RC flush_page_internal(Frame &frame);
 
+  /**
+   * @brief 分配一个页面
+   * @param fsm_slot 不小于 0 时表示分配的是第几个空闲空间映射页面，与页面分配记录在同一条日志中
+   */
+  RC allocate_page(Frame **frame, int fsm_slot);
+
+  /**
+   * @brief 打开文件时加载已有的空闲空间映射页面
+   */
+  RC load_free_space_map();
+
+  /**
+   * @brief 把空闲空间映射页面固定在内存中，并把其中等级大于 0 的页面记录到查找位图中
+   */
+  RC attach_fsm_page(int slot, Frame *frame);
+
+  /**
+   * @brief 获取记录 page_num 的空闲空间映射页面，需要时分配
+   */
+  RC get_fsm_frame(PageNum page_num, bool create, Frame *&frame);
+
 private:
   BufferPoolManager   &bp_manager_;     /// BufferPool 管理器
   BPFrameManager      &frame_manager_;  /// Frame 管理器
@@ -310,6 +425,11 @@ private:
   common::Mutex lock_;
   common::Mutex wr_lock_;
 
+  Frame       *fsm_frames_[BPFileHeader::FSM_PAGE_NUM] = {};  /// 空闲空间映射页面，加载后一直固定在内存中
+  vector<char> fsm_search_bits_;       /// 空闲空间等级大于 0 的页面，用于快速查找
+  PageNum      fsm_search_start_ = 0;  /// 查找的起始位置，它之前的页面都没有空闲空间
+  common::Mutex fsm_lock_;
+
 private:
   friend class BufferPoolIterator;
 };
@@ -20,6 +20,7 @@ IntegratedLogReplayer::IntegratedLogReplayer(BufferPoolManager &bpm)
     : buffer_pool_log_replayer_(bpm), // 初始化缓冲池日志重放器
       record_log_replayer_(bpm), // 初始化记录管理日志重放器
       bplus_tree_log_replayer_(bpm), // 初始化 B+ 树日志重放器
+      hash_index_log_replayer_(bpm), // 初始化哈希索引日志重放器
       trx_log_replayer_(nullptr) // 初始化事务日志重放器为 nullptr
 {}
 
@@ -28,6 +29,7 @@ IntegratedLogReplayer::IntegratedLogReplayer(BufferPoolManager &bpm, unique_ptr<
     : buffer_pool_log_replayer_(bpm), // 初始化缓冲池日志重放器
       record_log_replayer_(bpm), // 初始化记录管理日志重放器
       bplus_tree_log_replayer_(bpm), // 初始化 B+ 树日志重放器
+      hash_index_log_replayer_(bpm), // 初始化哈希索引日志重放器
       trx_log_replayer_(std::move(trx_log_replayer)) // 移动构造事务日志重放器
 {}
 
@@ -40,6 +42,7 @@ RC IntegratedLogReplayer::replay(const LogEntry &entry)
     case LogModule::Id::RECORD_MANAGER: return record_log_replayer_.replay(entry); // 记录管理重放
     case LogModule::Id::BPLUS_TREE: return bplus_tree_log_replayer_.replay(entry); // B+ 树重放
     case LogModule::Id::TRANSACTION: return trx_log_replayer_->replay(entry); // 事务重放
+    case LogModule::Id::HASH_INDEX: return hash_index_log_replayer_.replay(entry); // 哈希索引重放
     default: return RC::INVALID_ARGUMENT; // 无效参数
   }
 }
@@ -66,6 +69,12 @@ RC IntegratedLogReplayer::on_done()
     return rc;
   }
 
+  rc = hash_index_log_replayer_.on_done();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to do hash index log replay. rc=%s", strrc(rc)); // 记录哈希索引重放失败信息
+    return rc;
+  }
+
   rc = trx_log_replayer_->on_done();
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to do mvcc trx log replay. rc=%s", strrc(rc)); // 记录事务重放失败信息
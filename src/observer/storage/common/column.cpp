@@ -8,6 +8,7 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#include "common/lang/algorithm.h"
 #include "common/log/log.h"
 #include "storage/common/column.h"
 
@@ -78,13 +79,36 @@ void Column::init(const Value &value)
   column_type_ = Type::CONSTANT_COLUMN; // 设置列类型为常量列
 }
 
+// 初始化为变长的列，数据空间先按照平均每个值 16 字节分配
+void Column::init_var_len(AttrType attr_type, int attr_len, size_t size)
+{
+  reset();
+  byte_capacity_ = static_cast<int>(size) * min(attr_len, 16);
+  data_          = new char[byte_capacity_];
+  offsets_       = new uint32_t[size + 1];
+  offsets_[0]    = 0;
+  count_         = 0;
+  capacity_      = size;
+  own_           = true;
+  attr_type_     = attr_type;
+  attr_len_      = attr_len;
+  column_type_   = Type::NORMAL_COLUMN;
+  var_len_       = true;
+}
+
 // 重置列，释放内存
 void Column::reset()
 {
   if (data_ != nullptr && own_) {
     delete[] data_; // 释放内存
   }
+  if (offsets_ != nullptr && own_) {
+    delete[] offsets_;
+  }
   data_ = nullptr; // 设置数据为空
+  offsets_       = nullptr;
+  var_len_       = false;
+  byte_capacity_ = 0;
   count_       = 0; // 重置计数
   capacity_    = 0; // 重置容量
   own_         = false; // 设置为不拥有内存
@@ -107,17 +131,62 @@ RC Column::append(char *data, int count)
     return RC::INTERNAL;
   }
 
+  if (var_len_) {
+    // 定长的值只保留实际的内容
+    for (int i = 0; i < count; i++) {
+      const char *value = data + i * attr_len_;
+      RC          rc    = append_var(value, static_cast<int>(strnlen(value, attr_len_)));
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+    return RC::SUCCESS;
+  }
+
   memcpy(data_ + count_ * attr_len_, data, count * attr_len_); // 拷贝数据
   count_ += count; // 更新计数
   return RC::SUCCESS; // 返回成功
 }
 
+// 向变长的列追加一个值，数据空间不够时按两倍扩展
+RC Column::append_var(const char *data, int len)
+{
+  if (!own_ || !var_len_) {
+    LOG_WARN("append var-length data to non-owned or fixed-length column");
+    return RC::INTERNAL;
+  }
+  if (count_ >= capacity_ || len > attr_len_) {
+    LOG_WARN("append data to full column or value is too long. len=%d, attr_len=%d", len, attr_len_);
+    return RC::INTERNAL;
+  }
+
+  const uint32_t start = offsets_[count_];
+  if (static_cast<int>(start) + len > byte_capacity_) {
+    int new_capacity = max(byte_capacity_ * 2, static_cast<int>(start) + len);
+    char *new_data   = new char[new_capacity];
+    memcpy(new_data, data_, start);
+    delete[] data_;
+    data_          = new_data;
+    byte_capacity_ = new_capacity;
+  }
+
+  memcpy(data_ + start, data, len);
+  count_++;
+  offsets_[count_] = start + len;
+  return RC::SUCCESS;
+}
+
 // 获取指定索引的值
 Value Column::get_value(int index) const
 {
   if (index >= count_ || index < 0) {
     return Value(); // 如果索引无效，返回默认值
   }
+  if (var_len_) {
+    const int len = static_cast<int>(offsets_[index + 1] - offsets_[index]);
+    // 长度为 0 时 Value 会按照 C 字符串计算长度，空字符串单独处理
+    return len == 0 ? Value("") : Value(attr_type_, &data_[offsets_[index]], len);
+  }
   return Value(attr_type_, &data_[index * attr_len_], attr_len_); // 返回指定索引的值
 }
 
@@ -130,6 +199,8 @@ void Column::reference(const Column &column)
   reset(); // 重置当前列
 
   this->data_     = column.data(); // 引用数据
+  this->offsets_  = const_cast<uint32_t *>(column.offsets());
+  this->var_len_  = column.is_var_len();
   this->capacity_ = column.capacity(); // 设置容量
   this->count_    = column.count(); // 设置计数
   this->own_      = false; // 设置为不拥有内存
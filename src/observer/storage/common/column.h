@@ -16,8 +16,9 @@ See the Mulan PSL v2 for more details. */
 
 /**
  * @brief A column contains multiple values in contiguous memory with a specified type.
+ * @details 默认每个值都占 attr_len 个字节。变长模式下（init_var_len）值紧挨着存放，
+ * 第 i 个值位于 [offsets[i], offsets[i+1])，字符串只保存实际的内容。
  */
-// TODO: `Column` currently only support fixed-length type.
 class Column
 {
 public:
@@ -38,6 +39,13 @@ public:
   void init(AttrType attr_type, int attr_len, size_t size = DEFAULT_CAPACITY);
   void init(const Value &value);
 
+  /**
+   * @brief 初始化为变长的列
+   * @param attr_len 每个值的最大长度
+   * @param size     最多存放多少个值，数据的空间不够时会自动扩展
+   */
+  void init_var_len(AttrType attr_type, int attr_len, size_t size = DEFAULT_CAPACITY);
+
   virtual ~Column() { reset(); }
 
   void reset();
@@ -51,6 +59,12 @@ public:
    */
   RC append(char *data, int count);
 
+  /**
+   * @brief 向变长的列追加一个值
+   * @param len 值的实际长度，不能超过 attr_len
+   */
+  RC append_var(const char *data, int len);
+
   /**
    * @brief 获取 index 位置的列值
    */
@@ -59,7 +73,7 @@ public:
   /**
    * @brief 获取列数据的实际大小（字节）
    */
-  int data_len() const { return count_ * attr_len_; }
+  int data_len() const { return var_len_ ? static_cast<int>(offsets_[count_]) : count_ * attr_len_; }
 
   char *data() const { return data_; }
 
@@ -68,6 +82,16 @@ public:
    */
   void reset_data() { count_ = 0; }
 
+  /**
+   * @brief 是否是变长的列
+   */
+  bool is_var_len() const { return var_len_; }
+
+  /**
+   * @brief 变长的列中每个值的起始位置，共 count() + 1 个
+   */
+  const uint32_t *offsets() const { return offsets_; }
+
   /**
    * @brief 引用另一个 Column
    */
@@ -98,4 +122,10 @@ private:
   int attr_len_ = -1;
   /// 列类型
   Type column_type_ = Type::NORMAL_COLUMN;
+  /// 是否是变长的列
+  bool var_len_ = false;
+  /// 变长的列中每个值的起始位置，capacity_ + 1 个
+  uint32_t *offsets_ = nullptr;
+  /// 变长的列中 data_ 的大小
+  int byte_capacity_ = 0;
 };
\ No newline at end of file
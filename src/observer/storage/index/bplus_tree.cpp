@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include <span>
 
 #include "storage/index/bplus_tree.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/lower_bound.h"
 #include "common/log/log.h"
 #include "common/global_context.h"
@@ -37,12 +38,28 @@ int calc_internal_page_capacity(int attr_length) {
   return capacity;
 }
 
-int calc_leaf_page_capacity(int attr_length) {
-  int item_size = attr_length + sizeof(RID) + sizeof(RID); // 计算每个条目的大小
-  int capacity  = ((int)BP_PAGE_DATA_SIZE - LeafIndexNode::HEADER_SIZE) / item_size; // 计算叶子页的容量
+/**
+ * @brief 叶子页面最多可以存放的元素个数
+ * @details 元素去掉末尾补齐的0并且做前缀压缩，value 通常也不单独保存，按照最短的元素计算。
+ * 实际能放多少个由剩余空间决定。
+ */
+int calc_leaf_page_capacity()
+{
+  // slot + 后缀长度 + RID
+  const int item_size = sizeof(uint16_t) + sizeof(uint16_t) + sizeof(RID);
+  const int capacity  = ((int)BP_PAGE_DATA_SIZE - LeafIndexNode::HEADER_SIZE) / item_size; // 计算叶子页的容量
   return capacity;
 }
 
+/**
+ * @brief 叶子页面是否至少能放下3个最长的元素
+ * @details 页面放不下新元素时要分裂，分裂后新元素必须能放到其中一个页面中
+ */
+bool leaf_page_fit_max_items(int attr_length) {
+  const int item_size = sizeof(uint16_t) + sizeof(uint16_t) + attr_length + sizeof(RID) + sizeof(RID);
+  return LeafIndexNode::HEADER_SIZE + 3 * item_size <= (int)BP_PAGE_DATA_SIZE;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 IndexNodeHandler::IndexNodeHandler(BplusTreeMiniTransaction &mtr, const IndexFileHeader &header, Frame *frame)
     : mtr_(mtr), header_(header), frame_(frame), node_((IndexNode *)frame->data()) // 初始化构造函数
@@ -97,7 +114,24 @@ RC IndexNodeHandler::set_parent_page_num(PageNum page_num) {
  * @return true 需要分裂或合并；
  *         false 不需要分裂或合并
  */
+void IndexNodeHandler::page_image(span<const char> &image, span<const char> &tail) const
+{
+  image = span<const char>(frame_->data(), BP_PAGE_DATA_SIZE);
+  tail  = span<const char>();
+}
+
 bool IndexNodeHandler::is_safe(BplusTreeOperationType op, bool is_root_node) {
+  if (is_leaf() && op != BplusTreeOperationType::READ && !(op == BplusTreeOperationType::DELETE && is_root_node)) {
+    // 叶子节点的元素是变长的，按照最长的元素估算，并假设插入后公共前缀没有了
+    LeafIndexNodeHandler leaf_node(mtr_, header_, frame_);
+    const int max_item_bytes = sizeof(uint16_t) + sizeof(uint16_t) + header_.attr_length + sizeof(RID) + sizeof(RID);
+    if (op == BplusTreeOperationType::INSERT) {
+      return size() < max_size() &&
+             leaf_node.used_bytes() + size() * leaf_node.prefix_length() + max_item_bytes <= BP_PAGE_DATA_SIZE;
+    }
+    return size() - 1 >= min_size() || leaf_node.used_bytes() - max_item_bytes >= BP_PAGE_DATA_SIZE / 2;
+  }
+
   switch (op) {
     case BplusTreeOperationType::READ: {
       return true; // 读取操作始终安全
@@ -173,6 +207,50 @@ RC IndexNodeHandler::recover_remove_items(int index, int num) {
 }
 
 /////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+constexpr int LEAF_SLOT_SIZE        = static_cast<int>(sizeof(uint16_t));  // 每个slot的大小
+constexpr int LEAF_ITEM_HEADER_SIZE = static_cast<int>(sizeof(uint16_t));  // 元素中记录后缀长度的部分
+
+// 后缀长度的最高位表示value与key中RID部分相同，没有单独保存。索引中的value就是key后面的RID，通常都是这种情况
+constexpr uint16_t LEAF_VALUE_OMITTED  = 0x8000;
+constexpr uint16_t LEAF_SUFFIX_MASK    = 0x7FFF;
+
+static_assert(sizeof(LeafIndexNode) == LeafIndexNode::HEADER_SIZE, "invalid leaf index node header size");
+static_assert(BP_PAGE_DATA_SIZE <= UINT16_MAX, "leaf slot cannot address the whole page");
+
+/// 去掉末尾补齐的0之后的长度
+int trimmed_length(const char *data, int length)
+{
+  while (length > 0 && data[length - 1] == 0) {
+    length--;
+  }
+  return length;
+}
+
+/// 两段数据在前 length 个字节中相同部分的长度
+int common_prefix_length(const char *data1, const char *data2, int length)
+{
+  int i = 0;
+  while (i < length && data1[i] == data2[i]) {
+    i++;
+  }
+  return i;
+}
+
+uint16_t item_header_of(const char *item_data)
+{
+  uint16_t header = 0;
+  memcpy(&header, item_data, sizeof(header));
+  return header;
+}
+
+uint16_t suffix_length_of(const char *item_data) { return item_header_of(item_data) & LEAF_SUFFIX_MASK; }
+
+bool value_omitted(const char *item_data) { return (item_header_of(item_data) & LEAF_VALUE_OMITTED) != 0; }
+
+}  // namespace
+
 LeafIndexNodeHandler::LeafIndexNodeHandler(BplusTreeMiniTransaction &mtr, const IndexFileHeader &header, Frame *frame)
     : IndexNodeHandler(mtr, header, frame), leaf_node_((LeafIndexNode *)frame->data()) // 初始化构造函数
 {}
@@ -184,7 +262,9 @@ RC LeafIndexNodeHandler::init_empty() {
     return rc;
   }
   IndexNodeHandler::init_empty(true/*leaf*/); // 初始化为空叶子节点
-  leaf_node_->next_brother = BP_INVALID_PAGE_NUM; // 设置下一个兄弟节点为无效
+  leaf_node_->next_brother  = BP_INVALID_PAGE_NUM; // 设置下一个兄弟节点为无效
+  leaf_node_->prefix_length = 0;
+  leaf_node_->heap_offset   = BP_PAGE_DATA_SIZE;
   return RC::SUCCESS;
 }
 
@@ -203,21 +283,50 @@ PageNum LeafIndexNodeHandler::next_page() const { return leaf_node_->next_brothe
 
 char *LeafIndexNodeHandler::key_at(int index) {
   assert(index >= 0 && index < size()); // 检查索引有效性
-  return __key_at(index); // 返回指定索引的键
+  if (key_buffer_.empty()) {
+    key_buffer_.resize(key_size());
+  }
+  decode_key(index, key_buffer_.data()); // 解码指定索引的键
+  return key_buffer_.data();
 }
 
 char *LeafIndexNodeHandler::value_at(int index) {
   assert(index >= 0 && index < size()); // 检查索引有效性
-  return __value_at(index); // 返回指定索引的值
+  return const_cast<char *>(value_data(index)); // value 没有压缩，直接返回页面中的位置
+}
+
+const char *LeafIndexNodeHandler::value_data(int index) const
+{
+  // 没有单独保存的value与key中attr后面的部分相同
+  const char *data = item_data(index);
+  const char *tail = data + LEAF_ITEM_HEADER_SIZE + suffix_length_of(data);
+  return value_omitted(data) ? tail : tail + key_size() - header_.attr_length;
 }
 
 int LeafIndexNodeHandler::lookup(const KeyComparator &comparator, const char *key, bool *found /* = nullptr */) const
 {
-  const int size = this->size(); // 获取当前节点的条目数量
-  common::BinaryIterator<char> iter_begin(item_size(), __key_at(0)); // 创建迭代器，指向第一个条目
-  common::BinaryIterator<char> iter_end(item_size(), __key_at(size)); // 创建迭代器，指向最后一个条目
-  common::BinaryIterator<char> iter = lower_bound(iter_begin, iter_end, key, comparator, found); // 查找键的位置
-  return iter - iter_begin; // 返回键的位置索引
+  // 元素是压缩过的，每次比较前先解码出完整的键值
+  vector<char> item_key(key_size());
+  int          left  = 0;
+  int          right = this->size();
+  while (left < right) {
+    const int mid = left + (right - left) / 2;
+    decode_key(mid, item_key.data());
+    if (comparator(item_key.data(), key) < 0) {
+      left = mid + 1;
+    } else {
+      right = mid;
+    }
+  }
+
+  if (found != nullptr) {
+    *found = false;
+    if (left < this->size()) {
+      decode_key(left, item_key.data());
+      *found = (comparator(item_key.data(), key) == 0);
+    }
+  }
+  return left; // 返回键的位置索引
 }
 
 RC LeafIndexNodeHandler::insert(int index, const char *key, const char *value)
@@ -240,7 +349,9 @@ RC LeafIndexNodeHandler::remove(int index)
 {
   assert(index >= 0 && index < size()); // 检查索引有效性
 
-  RC rc = mtr_.logger().node_remove_items(*this, index, span<const char>(__item_at(index), item_size()), 1); // 记录删除操作
+  vector<char> item;
+  copy_items(index, 1, item);
+  RC rc = mtr_.logger().node_remove_items(*this, index, item, 1); // 记录删除操作
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log remove item. rc=%s", strrc(rc));
     return rc;
@@ -261,34 +372,48 @@ int LeafIndexNodeHandler::remove(const char *key, const KeyComparator &comparato
   return 0; // 未找到，返回0
 }
 
-RC LeafIndexNodeHandler::move_half_to(LeafIndexNodeHandler &other)
+RC LeafIndexNodeHandler::move_half_to(LeafIndexNodeHandler &other, int move_index /* = -1 */)
 {
   const int size = this->size(); // 获取当前节点的条目数量
-  const int move_index = size / 2; // 计算移动开始的索引
+  if (move_index < 0) {
+    move_index = size / 2; // 计算移动开始的索引
+  }
   const int move_item_num = size - move_index; // 计算移动的条目数量
+  if (move_item_num <= 0) {
+    return RC::SUCCESS;
+  }
 
-  other.append(__item_at(move_index), move_item_num); // 将后半部分条目移动到另一个节点
+  vector<char> items;
+  copy_items(move_index, move_item_num, items);
+  RC rc = other.append(items.data(), move_item_num); // 将后半部分条目移动到另一个节点
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to copy item to new node. rc=%s", strrc(rc));
+    return rc;
+  }
 
-  RC rc = mtr_.logger().node_remove_items(*this, move_index, span<const char>(__item_at(move_index), move_item_num * item_size()), move_item_num); // 记录缩小操作
+  rc = mtr_.logger().node_remove_items(*this, move_index, items, move_item_num); // 记录缩小操作
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log shrink leaf node. rc=%s", strrc(rc));
     return rc;
   }
 
-  recover_remove_items(move_index, move_item_num); // 更新当前节点的条目
-  return RC::SUCCESS;
+  return recover_remove_items(move_index, move_item_num); // 更新当前节点的条目
 }
 
 RC LeafIndexNodeHandler::move_first_to_end(LeafIndexNodeHandler &other)
 {
-  other.append(__item_at(0)); // 将第一个条目移动到另一个节点的末尾
+  vector<char> item;
+  copy_items(0, 1, item);
+  other.append(item.data()); // 将第一个条目移动到另一个节点的末尾
 
   return this->remove(0); // 从当前节点删除第一个条目
 }
 
 RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other)
 {
-  other.preappend(__item_at(size() - 1)); // 将最后一个条目移动到另一个节点的开头
+  vector<char> item;
+  copy_items(size() - 1, 1, item);
+  other.preappend(item.data()); // 将最后一个条目移动到另一个节点的开头
 
   this->remove(size() - 1); // 从当前节点删除最后一个条目
   return RC::SUCCESS;
@@ -299,16 +424,16 @@ RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other)
  */
 RC LeafIndexNodeHandler::move_to(LeafIndexNodeHandler &other)
 {
-  other.append(__item_at(0), this->size()); // 将当前节点的所有条目添加到另一个节点
+  vector<char> items;
+  copy_items(0, this->size(), items);
+  other.append(items.data(), this->size()); // 将当前节点的所有条目添加到另一个节点
   other.set_next_page(this->next_page()); // 设置另一个节点的下一个页面为当前节点的下一个页面
 
-  RC rc = mtr_.logger().node_remove_items(*this, 0, span<const char>(__item_at(0), this->size() * item_size()), this->size()); // 记录缩小操作
+  RC rc = mtr_.logger().node_remove_items(*this, 0, items, this->size()); // 记录缩小操作
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log shrink leaf node. rc=%s", strrc(rc));
   }
-  this->increase_size(-this->size()); // 更新当前节点的条目数
-
-  return RC::SUCCESS;
+  return recover_remove_items(0, this->size()); // 更新当前节点的条目数
 }
 
 // 将一些数据追加到当前节点的最右边
@@ -333,15 +458,301 @@ RC LeafIndexNodeHandler::preappend(const char *item)
   return insert(0, item, item + key_size()); // 将条目插入到当前节点的开头
 }
 
-char *LeafIndexNodeHandler::__item_at(int index) const { return leaf_node_->array + (index * item_size()); } // 获取指定索引的条目
+int LeafIndexNodeHandler::used_bytes() const
+{
+  return BP_PAGE_DATA_SIZE - (leaf_node_->heap_offset - LeafIndexNode::HEADER_SIZE - size() * LEAF_SLOT_SIZE);
+}
+
+int LeafIndexNodeHandler::encoded_size(int index) const
+{
+  const char *data = item_data(index);
+  return LEAF_SLOT_SIZE + LEAF_ITEM_HEADER_SIZE + suffix_length_of(data) + tail_size(value_omitted(data));
+}
+
+int LeafIndexNodeHandler::common_prefix_with(const char *key) const
+{
+  return common_prefix_length(prefix_data(), key, leaf_node_->prefix_length);
+}
+
+void LeafIndexNodeHandler::decode_key(int index, char *key) const
+{
+  const int   attr_length   = header_.attr_length;
+  const int   prefix_length = leaf_node_->prefix_length;
+  const char *data          = item_data(index);
+  const int   suffix_length = suffix_length_of(data);
+
+  memcpy(key, prefix_data(), prefix_length);
+  memcpy(key + prefix_length, data + LEAF_ITEM_HEADER_SIZE, suffix_length);
+  memset(key + prefix_length + suffix_length, 0, attr_length - prefix_length - suffix_length);
+  memcpy(key + attr_length, data + LEAF_ITEM_HEADER_SIZE + suffix_length, key_size() - attr_length);
+}
+
+void LeafIndexNodeHandler::decode_item(int index, char *item) const
+{
+  decode_key(index, item);
+  memcpy(item + key_size(), value_data(index), value_size());
+}
+
+bool LeafIndexNodeHandler::can_omit_value(const char *item) const
+{
+  const int tail_key_size = key_size() - header_.attr_length;
+  return value_size() == tail_key_size && 0 == memcmp(item + header_.attr_length, item + key_size(), value_size());
+}
+
+void LeafIndexNodeHandler::copy_items(int index, int num, vector<char> &items) const
+{
+  const int item_size = this->item_size();
+  items.resize(static_cast<size_t>(num) * item_size);
+  for (int i = 0; i < num; i++) {
+    decode_item(index + i, items.data() + static_cast<size_t>(i) * item_size);
+  }
+}
+
+int LeafIndexNodeHandler::encode_item(const char *item)
+{
+  const int attr_length   = header_.attr_length;
+  const int prefix_length = leaf_node_->prefix_length;
+  const int suffix_length = trimmed_length(item + prefix_length, attr_length - prefix_length);
+  const bool omit_value   = can_omit_value(item);
+  const int encoded_size  = LEAF_ITEM_HEADER_SIZE + suffix_length + tail_size(omit_value);
+
+  ASSERT(leaf_node_->heap_offset - encoded_size >= LeafIndexNode::HEADER_SIZE + (size() + 1) * LEAF_SLOT_SIZE,
+         "no enough space in leaf page. page=%d, used=%d, item size=%d", page_num(), used_bytes(), encoded_size);
+
+  leaf_node_->heap_offset -= encoded_size;
+  char          *data   = frame_->data() + leaf_node_->heap_offset;
+  const uint16_t header = static_cast<uint16_t>(suffix_length) | (omit_value ? LEAF_VALUE_OMITTED : 0);
+  memcpy(data, &header, sizeof(header));
+  memcpy(data + LEAF_ITEM_HEADER_SIZE, item + prefix_length, suffix_length);
+  memcpy(data + LEAF_ITEM_HEADER_SIZE + suffix_length, item + attr_length, tail_size(omit_value));
+  return leaf_node_->heap_offset;
+}
+
+void LeafIndexNodeHandler::rebuild(const char *items, int num)
+{
+  const int attr_length = header_.attr_length;
+  const int item_size   = this->item_size();
+
+  // 有序数据的公共前缀就是第一个和其它每个元素公共前缀的最小值
+  int prefix_length = num > 0 ? attr_length : 0;
+  for (int i = 1; i < num && prefix_length > 0; i++) {
+    prefix_length = common_prefix_length(items, items + static_cast<size_t>(i) * item_size, prefix_length);
+  }
+
+  leaf_node_->key_num       = 0;
+  leaf_node_->prefix_length = static_cast<uint16_t>(prefix_length);
+  leaf_node_->heap_offset   = static_cast<uint16_t>(BP_PAGE_DATA_SIZE - prefix_length);
+  if (prefix_length > 0) {
+    memcpy(frame_->data() + leaf_node_->heap_offset, items, prefix_length);
+  }
+
+  for (int i = 0; i < num; i++) {
+    const int offset          = encode_item(items + static_cast<size_t>(i) * item_size);
+    leaf_node_->slots[i]      = static_cast<uint16_t>(offset);
+    leaf_node_->key_num       = i + 1;
+  }
+}
+
+RC LeafIndexNodeHandler::recover_insert_items(int index, const char *items, int num)
+{
+  const int size = this->size();
+  if (num == 1 && size > 0 && common_prefix_with(items) == leaf_node_->prefix_length) {
+    // 常见的情况：插入一个与公共前缀相同的元素，直接放到堆区
+    const int offset = encode_item(items);
+    memmove(&leaf_node_->slots[index + 1], &leaf_node_->slots[index], (size - index) * LEAF_SLOT_SIZE);
+    leaf_node_->slots[index] = static_cast<uint16_t>(offset);
+    increase_size(1);
+    return RC::SUCCESS;
+  }
+
+  // 公共前缀变短或者一次插入多个元素，重新构建整个页面
+  const size_t item_size = this->item_size();
+  vector<char> all_items;
+  copy_items(0, size, all_items);
+  all_items.insert(all_items.begin() + index * item_size, items, items + num * item_size);
+  rebuild(all_items.data(), size + num);
+  return RC::SUCCESS;
+}
+
+RC LeafIndexNodeHandler::recover_remove_items(int index, int num)
+{
+  const int size = this->size();
+  if (num == 1 && size > 1) {
+    // 删除一个元素，把它前面的堆区数据向后移动，覆盖掉这个元素
+    const int offset       = leaf_node_->slots[index];
+    const int encoded_size = this->encoded_size(index) - LEAF_SLOT_SIZE;
+    const int heap_offset  = leaf_node_->heap_offset;
+    char     *data         = frame_->data();
+    memmove(data + heap_offset + encoded_size, data + heap_offset, offset - heap_offset);
+    for (int i = 0; i < size; i++) {
+      if (leaf_node_->slots[i] < offset) {
+        leaf_node_->slots[i] += encoded_size;
+      }
+    }
+    leaf_node_->heap_offset += encoded_size;
+    memmove(&leaf_node_->slots[index], &leaf_node_->slots[index + 1], (size - index - 1) * LEAF_SLOT_SIZE);
+    increase_size(-1);
+    return RC::SUCCESS;
+  }
+
+  // 一次删除多个元素通常是分裂或合并，重新构建页面，剩下的元素可能有更长的公共前缀
+  const size_t item_size = this->item_size();
+  vector<char> all_items;
+  copy_items(0, size, all_items);
+  all_items.erase(all_items.begin() + index * item_size, all_items.begin() + (index + num) * item_size);
+  rebuild(all_items.data(), size - num);
+  return RC::SUCCESS;
+}
+
+bool LeafIndexNodeHandler::has_room_for(const char *key) const
+{
+  const int size = this->size();
+  if (size >= max_size()) {
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+
+  // 公共前缀变短时，每个元素最多变长缩短的长度，前缀本身占用的空间会减少
+  const int attr_length   = header_.attr_length;
+  const int prefix_length = leaf_node_->prefix_length;
+  const int new_prefix    = common_prefix_with(key);
+  const int shrink        = prefix_length - new_prefix;
+  const int item_bytes =
+      LEAF_SLOT_SIZE + LEAF_ITEM_HEADER_SIZE + trimmed_length(key + new_prefix, attr_length - new_prefix) + tail_size();
+  return used_bytes() + size * shrink - shrink + item_bytes <= BP_PAGE_DATA_SIZE;
+}
+
+int LeafIndexNodeHandler::split_position(int insert_position, const char *key, bool &insert_left) const
+{
+  const int    attr_length = header_.attr_length;
+  const int    max_size    = this->max_size();
+  const int    total       = this->size() + 1;
+  const size_t item_size   = this->item_size();
+
+  // 把新的键值放到对应的位置上，后面按照 total 个元素计算每种分裂方式下两边页面的大小
+  vector<char> items;
+  copy_items(0, this->size(), items);
+  vector<char> new_item(item_size, 0);
+  memcpy(new_item.data(), key, key_size());
+  items.insert(items.begin() + insert_position * item_size, new_item.begin(), new_item.end());
+  auto item = [&](int i) { return items.data() + i * item_size; };
+
+  // 新元素的value还不知道，按照单独保存value计算
+  vector<int> lengths(total);
+  vector<int> tails(total);
+  for (int i = 0; i < total; i++) {
+    lengths[i] = trimmed_length(item(i), attr_length);
+    tails[i]   = tail_size(i != insert_position && can_omit_value(item(i)));
+  }
+
+  // left_prefix[s] 是前 s 个元素的公共前缀，right_prefix[s] 是从 s 开始的元素的公共前缀
+  vector<int> left_prefix(total + 1, attr_length);
+  vector<int> right_prefix(total + 1, attr_length);
+  for (int s = 2; s <= total; s++) {
+    left_prefix[s] = common_prefix_length(item(0), item(s - 1), left_prefix[s - 1]);
+  }
+  for (int s = total - 2; s >= 0; s--) {
+    right_prefix[s] = common_prefix_length(item(total - 1), item(s), right_prefix[s + 1]);
+  }
+
+  auto range_bytes = [&](int begin, int end, int prefix_length) {
+    int bytes = LeafIndexNode::HEADER_SIZE + prefix_length;
+    for (int i = begin; i < end; i++) {
+      bytes += LEAF_SLOT_SIZE + LEAF_ITEM_HEADER_SIZE + std::max(0, lengths[i] - prefix_length) + tails[i];
+    }
+    return bytes;
+  };
+
+  // 左边页面放前 s 个元素，右边页面放剩下的
+  auto balance = [&](int s) {
+    if (s <= 0 || s >= total || s > max_size || total - s > max_size) {
+      return -1;
+    }
+    const int left_bytes  = range_bytes(0, s, left_prefix[s]);
+    const int right_bytes = range_bytes(s, total, right_prefix[s]);
+    if (left_bytes > BP_PAGE_DATA_SIZE || right_bytes > BP_PAGE_DATA_SIZE) {
+      return -1;
+    }
+    return std::abs(left_bytes - right_bytes);
+  };
+
+  int split = -1;
+  if (this->size() >= max_size) {
+    // 元素个数达到上限，与定长的情况一样从中间分裂
+    const int half = this->size() / 2;
+    const int s    = half + (insert_position < half ? 1 : 0);
+    if (balance(s) >= 0) {
+      split = s;
+    }
+  }
+
+  if (split < 0) {
+    // 变长元素按照数据量平均分配
+    int best_diff = -1;
+    for (int s = 1; s < total; s++) {
+      const int diff = balance(s);
+      if (diff >= 0 && (best_diff < 0 || diff < best_diff)) {
+        best_diff = diff;
+        split     = s;
+      }
+    }
+  }
+
+  if (split < 0) {
+    return -1;
+  }
+
+  insert_left = insert_position < split;
+  return insert_left ? split - 1 : split;
+}
+
+void LeafIndexNodeHandler::page_image(span<const char> &image, span<const char> &tail) const
+{
+  image = span<const char>(frame_->data(), LeafIndexNode::HEADER_SIZE + size() * LEAF_SLOT_SIZE);
+  tail  = span<const char>(frame_->data() + leaf_node_->heap_offset, BP_PAGE_DATA_SIZE - leaf_node_->heap_offset);
+}
+
+bool LeafIndexNodeHandler::is_underflow() const
+{
+  return size() < min_size() && used_bytes() < BP_PAGE_DATA_SIZE / 2;
+}
+
+bool LeafIndexNodeHandler::can_merge(const LeafIndexNodeHandler &other) const
+{
+  if (size() + other.size() > max_size()) {
+    return false;
+  }
+
+  // 合并后的公共前缀不会比两个页面公共前缀相同的部分更短
+  int prefix_length = 0;
+  if (size() == 0) {
+    prefix_length = other.prefix_length();
+  } else if (other.size() == 0) {
+    prefix_length = this->prefix_length();
+  } else {
+    prefix_length = common_prefix_length(
+        prefix_data(), other.prefix_data(), std::min(this->prefix_length(), other.prefix_length()));
+  }
+
+  auto content_bytes = [prefix_length](const LeafIndexNodeHandler &node) {
+    return node.used_bytes() - LeafIndexNode::HEADER_SIZE - node.prefix_length() +
+           node.size() * (node.prefix_length() - prefix_length);
+  };
+  return LeafIndexNode::HEADER_SIZE + prefix_length + content_bytes(*this) + content_bytes(other) <= BP_PAGE_DATA_SIZE;
+}
 
 string to_string(const LeafIndexNodeHandler &handler, const KeyPrinter &printer)
 {
   stringstream ss;
-  ss << to_string((const IndexNodeHandler &)handler) << ",next page:" << handler.next_page(); // 转换为字符串，包含下一页信息
-  ss << ",values=[" << printer(handler.__key_at(0)); // 添加第一个键
-  for (int i = 1; i < handler.size(); i++) {
-    ss << "," << printer(handler.__key_at(i)); // 添加其余的键
+  ss << to_string((const IndexNodeHandler &)handler) << ",next page:" << handler.next_page() // 转换为字符串，包含下一页信息
+     << ",prefix length:" << handler.prefix_length() << ",used bytes:" << handler.used_bytes();
+  vector<char> key(handler.key_size());
+  ss << ",values=[";
+  for (int i = 0; i < handler.size(); i++) {
+    handler.decode_key(i, key.data());
+    ss << (i == 0 ? "" : ",") << printer(key.data()); // 添加每个键
   }
   ss << "]";
   return ss.str(); // 返回构造的字符串
@@ -354,9 +765,20 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
     return false; // 父类无效，返回false
   }
 
-  const int node_size = size(); // 获取当前节点大小
+  if (LeafIndexNode::HEADER_SIZE + size() * LEAF_SLOT_SIZE > leaf_node_->heap_offset ||
+      leaf_node_->heap_offset + leaf_node_->prefix_length > BP_PAGE_DATA_SIZE) {
+    LOG_WARN("invalid leaf page layout. page num=%d, size=%d, heap offset=%d, prefix length=%d",
+             page_num(), size(), leaf_node_->heap_offset, leaf_node_->prefix_length);
+    return false;
+  }
+
+  const int    node_size = size(); // 获取当前节点大小
+  vector<char> prev_key(key_size());
+  vector<char> key(key_size());
   for (int i = 1; i < node_size; i++) {
-    if (comparator(__key_at(i - 1), __key_at(i)) >= 0) {
+    decode_key(i - 1, prev_key.data());
+    decode_key(i, key.data());
+    if (comparator(prev_key.data(), key.data()) >= 0) {
       LOG_WARN("page number = %d, invalid key order. id1=%d,id2=%d, this=%s",
                page_num(), i - 1, i, to_string(*this).c_str());
       return false; // 检查键的顺序是否有效
@@ -385,7 +807,8 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
   }
 
   if (0 != index_in_parent) {
-    int cmp_result = comparator(__key_at(0), parent_node.key_at(index_in_parent)); // 比较当前节点的第一个键与父节点中的键
+    decode_key(0, key.data());
+    int cmp_result = comparator(key.data(), parent_node.key_at(index_in_parent)); // 比较当前节点的第一个键与父节点中的键
     if (cmp_result < 0) {
       LOG_WARN("invalid leaf node. first item should be greater than or equal to parent item. "
                "this page num=%d, parent page num=%d, index in parent=%d",
@@ -396,7 +819,8 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
   }
 
   if (index_in_parent < parent_node.size() - 1) {
-    int cmp_result = comparator(__key_at(size() - 1), parent_node.key_at(index_in_parent + 1)); // 比较当前节点的最后一个键与父节点中的下一个键
+    decode_key(size() - 1, key.data());
+    int cmp_result = comparator(key.data(), parent_node.key_at(index_in_parent + 1)); // 比较当前节点的最后一个键与父节点中的下一个键
     if (cmp_result >= 0) {
       LOG_WARN("invalid leaf node. last item should be less than the item at the first after item in parent."
                "this page num=%d, parent page num=%d, parent item to compare=%d",
@@ -480,10 +904,12 @@ RC InternalIndexNodeHandler::insert(const char *key, PageNum page_num, const Key
 /**
  * @brief 将一半的条目移动到另一个节点
  */
-RC InternalIndexNodeHandler::move_half_to(InternalIndexNodeHandler &other)
+RC InternalIndexNodeHandler::move_half_to(InternalIndexNodeHandler &other, int move_index /* = -1 */)
 {
   const int size = this->size(); // 获取当前节点的条目数量
-  const int move_index = size / 2; // 计算移动开始的索引
+  if (move_index < 0) {
+    move_index = size / 2; // 计算移动开始的索引
+  }
   const int move_num = size - move_index; // 计算移动的条目数量
   RC rc = other.append(this->__item_at(move_index), size - move_index); // 将后半部分条目移动到另一个节点
   if (OB_FAIL(rc)) {
@@ -673,6 +1099,12 @@ int InternalIndexNodeHandler::value_size() const { return sizeof(PageNum); } //
 
 int InternalIndexNodeHandler::item_size() const { return key_size() + this->value_size(); } // 返回项的大小
 
+void InternalIndexNodeHandler::page_image(span<const char> &image, span<const char> &tail) const
+{
+  image = span<const char>(frame_->data(), InternalIndexNode::HEADER_SIZE + size() * item_size());
+  tail  = span<const char>();
+}
+
 bool InternalIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferPool *bp) const
 {
   bool result = IndexNodeHandler::validate(); // 验证父类的有效性
@@ -831,7 +1263,11 @@ RC BplusTreeHandler::create(LogHandler &log_handler,
     internal_max_size = calc_internal_page_capacity(attr_length); // 计算内部页面容量
   }
   if (leaf_max_size < 0) {
-    leaf_max_size = calc_leaf_page_capacity(attr_length); // 计算叶子页面容量
+    leaf_max_size = calc_leaf_page_capacity(); // 计算叶子页面容量
+  }
+  if (!leaf_page_fit_max_items(attr_length)) {
+    LOG_WARN("attr length is too large for bplus tree. attr length=%d", attr_length);
+    return RC::INVALID_ARGUMENT;
   }
 
   log_handler_      = &log_handler; // 设置日志处理器
@@ -1274,15 +1710,22 @@ RC BplusTreeHandler::insert_entry_into_leaf_node(BplusTreeMiniTransaction &mtr,
     return RC::RECORD_DUPLICATE_KEY; // 返回重复键错误
   }
 
-  if (leaf_node.size() < leaf_node.max_size()) { // 如果叶子节点未满
+  if (leaf_node.has_room_for(key)) { // 如果叶子节点放得下
     leaf_node.insert(insert_position, key, (const char *)rid); // 插入新条目
     frame->mark_dirty(); // 标记页面为脏
     // disk_buffer_pool_->unpin_page(frame); // 取消固定页面由latch memo处理
     return RC::SUCCESS; // 返回成功
   }
 
+  bool      insert_left = false;
+  const int move_index  = leaf_node.split_position(insert_position, key, insert_left); // 计算分裂的位置
+  if (move_index < 0) {
+    LOG_WARN("failed to find split position of leaf node. page num=%d", frame->page_num());
+    return RC::INTERNAL;
+  }
+
   Frame *new_frame = nullptr; // 创建新页面
-  RC     rc        = split<LeafIndexNodeHandler>(mtr, frame, new_frame); // 分裂叶子节点
+  RC     rc        = split<LeafIndexNodeHandler>(mtr, frame, new_frame, move_index); // 分裂叶子节点
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to split leaf node. rc=%d:%s", rc, strrc(rc)); // 记录警告
     return rc; // 返回错误
@@ -1293,7 +1736,7 @@ RC BplusTreeHandler::insert_entry_into_leaf_node(BplusTreeMiniTransaction &mtr,
   new_index_node.set_parent_page_num(leaf_node.parent_page_num()); // 设置新节点的父页面编号
   leaf_node.set_next_page(new_frame->page_num()); // 设置当前节点的下一页面为新节点
 
-  if (insert_position < leaf_node.size()) { // 如果插入位置在当前叶子节点中
+  if (insert_left) { // 如果插入位置在当前叶子节点中
     leaf_node.insert(insert_position, key, (const char *)rid); // 在当前叶子节点插入
   } else { // 否则在新叶子节点中插入
     new_index_node.insert(insert_position - leaf_node.size(), key, (const char *)rid);
@@ -1404,7 +1847,7 @@ RC BplusTreeHandler::insert_entry_into_parent(BplusTreeMiniTransaction &mtr, Fra
  * split one full node into two
  */
 template <typename IndexNodeHandlerType>
-RC BplusTreeHandler::split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame)
+RC BplusTreeHandler::split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame, int move_index /* = -1 */)
 {
   IndexNodeHandlerType old_node(mtr, file_header_, frame); // 创建旧节点处理器
 
@@ -1421,7 +1864,14 @@ RC BplusTreeHandler::split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&
   new_node.init_empty(); // 初始化新节点
   new_node.set_parent_page_num(old_node.parent_page_num()); // 设置新节点的父节点页号
 
-  old_node.move_half_to(new_node); // 将旧节点的一半数据移动到新节点
+  old_node.move_half_to(new_node, move_index); // 将旧节点的一半数据移动到新节点
+
+  // 新节点的日志通常有半个页面那么多，换成整页日志
+  rc = mtr.logger().replace_with_page_image(new_node);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log page image of new node. rc=%s", strrc(rc));
+    return rc;
+  }
 
   frame->mark_dirty(); // 标记旧节点为脏
   new_frame->mark_dirty(); // 标记新节点为脏
@@ -1570,6 +2020,150 @@ RC BplusTreeHandler::get_entry(const char *user_key, int key_len, list<RID> &rid
   return rc; // 返回结果
 }
 
+RC BplusTreeHandler::get_entries(span<const char *const> user_keys, vector<pair<int, RID>> &entries)
+{
+  const int             attr_length     = file_header_.attr_length;
+  const AttrComparator &attr_comparator = key_comparator_.attr_comparator();
+
+  // 调用方通常已经排好序了，这时不需要再排一次
+  vector<int> order(user_keys.size());
+  for (int i = 0; i < static_cast<int>(order.size()); i++) {
+    order[i] = i;
+  }
+  auto key_less = [&](int left, int right) { return attr_comparator(user_keys[left], user_keys[right]) < 0; };
+  if (!is_sorted(order.begin(), order.end(), key_less)) {
+    stable_sort(order.begin(), order.end(), key_less);
+  }
+
+  BplusTreeMiniTransaction mtr(*this);
+
+  vector<char> key(file_header_.key_length);
+  Frame       *frame = nullptr;  // 当前持有的叶子节点，查找下一个键值时会先看这个节点
+  int          index = 0;
+  RC           rc    = RC::SUCCESS;
+
+  const char *last_user_key = nullptr;
+  size_t      last_begin    = 0;  // 上一个键值的查找结果在entries中的起始位置
+  for (int key_index : order) {
+    const char *user_key = user_keys[key_index];
+
+    // 重复的键值直接复制上一个键值的结果。当前位置已经在上一个键值的数据之后，不能再从这里查找
+    if (last_user_key != nullptr && attr_comparator(last_user_key, user_key) == 0) {
+      const size_t last_end = entries.size();
+      for (size_t i = last_begin; i < last_end; i++) {
+        entries.emplace_back(key_index, entries[i].second);
+      }
+      last_begin = last_end;
+      continue;
+    }
+    last_user_key = user_key;
+    last_begin    = entries.size();
+
+    memcpy(key.data(), user_key, attr_length);
+    memcpy(key.data() + attr_length, RID::min(), sizeof(RID));
+
+    rc = seek_leaf(mtr, key.data(), false /*want_greater*/, frame, index);
+    if (rc == RC::EMPTY) {
+      return RC::SUCCESS;
+    } else if (OB_FAIL(rc)) {
+      LOG_WARN("failed to seek leaf. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    while (true) {
+      LeafIndexNodeHandler leaf(mtr, file_header_, frame);
+      const int            size = leaf.size();
+      for (; index < size && attr_comparator(leaf.key_at(index), user_key) == 0; index++) {
+        entries.emplace_back(key_index, *reinterpret_cast<const RID *>(leaf.value_at(index)));
+      }
+
+      if (index < size || leaf.next_page() == BP_INVALID_PAGE_NUM) {
+        break;
+      }
+
+      // 相同的键值可能延续到右边的叶子节点，从当前节点的最后一个元素之后继续找
+      memcpy(key.data(), leaf.key_at(size - 1), file_header_.key_length);
+      rc = seek_leaf(mtr, key.data(), true /*want_greater*/, frame, index);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to seek next leaf. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC BplusTreeHandler::seek_leaf(
+    BplusTreeMiniTransaction &mtr, const char *key, bool want_greater, Frame *&frame, int &index)
+{
+  LatchMemo &latch_memo = mtr.latch_memo();
+
+  // 判断第一个不小于(或大于)key的元素是否在这个叶子节点中。如果这个节点是最后一个叶子节点，也不需要再找了
+  auto seek_in_leaf = [&](Frame *leaf_frame) {
+    LeafIndexNodeHandler leaf(mtr, file_header_, leaf_frame);
+    const int            size = leaf.size();
+    if (size > 0) {
+      const int result = key_comparator_(key, leaf.key_at(size - 1));
+      if (result < 0 || (result == 0 && !want_greater)) {
+        bool found = false;
+        index      = leaf.lookup(key_comparator_, key, &found);
+        if (found && want_greater) {
+          index++;
+        }
+        return true;
+      }
+    }
+
+    if (leaf.next_page() == BP_INVALID_PAGE_NUM) {
+      index = size;
+      return true;
+    }
+    return false;
+  };
+
+  if (frame != nullptr) {
+    if (seek_in_leaf(frame)) {
+      return RC::SUCCESS;
+    }
+
+    // 键值比较密集时，大多数情况下都可以在右边的兄弟节点中找到
+    LeafIndexNodeHandler leaf(mtr, file_header_, frame);
+    const PageNum        next_page_num = leaf.next_page();
+    const int            memo_point    = latch_memo.memo_point();
+    Frame               *next_frame    = nullptr;
+    RC                   rc            = latch_memo.get_page(next_page_num, next_frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get next page. page num=%d, rc=%s", next_page_num, strrc(rc));
+      return rc;
+    }
+
+    // 与扫描器一样，从左向右加锁的顺序与插入删除的顺序不同，直接加锁可能会死锁。加不上锁就从根节点重新查找
+    if (latch_memo.try_slatch(next_frame)) {
+      latch_memo.release_to(memo_point);
+      frame = next_frame;
+      if (seek_in_leaf(frame)) {
+        return RC::SUCCESS;
+      }
+    }
+  }
+
+  latch_memo.release();
+  frame = nullptr;
+
+  RC rc = find_leaf(mtr, BplusTreeOperationType::READ, key, frame);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LeafIndexNodeHandler leaf(mtr, file_header_, frame);
+  bool                 found = false;
+  index                      = leaf.lookup(key_comparator_, key, &found);
+  if (found && want_greater) {
+    index++;
+  }
+  return RC::SUCCESS;
+}
+
 RC BplusTreeHandler::adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame)
 {
   LatchMemo &latch_memo = mtr.latch_memo(); // 获取锁记忆
@@ -1616,7 +2210,7 @@ RC BplusTreeHandler::coalesce_or_redistribute(BplusTreeMiniTransaction &mtr, Fra
   LatchMemo &latch_memo = mtr.latch_memo();
 
   IndexNodeHandlerType index_node(mtr, file_header_, frame);
-  if (index_node.size() >= index_node.min_size()) {
+  if (!index_node.is_underflow()) {
     return RC::SUCCESS;
   }
 
@@ -1666,7 +2260,7 @@ RC BplusTreeHandler::coalesce_or_redistribute(BplusTreeMiniTransaction &mtr, Fra
   latch_memo.xlatch(neighbor_frame);
 
   IndexNodeHandlerType neighbor_node(mtr, file_header_, neighbor_frame);
-  if (index_node.size() + neighbor_node.size() > index_node.max_size()) {
+  if (!index_node.can_merge(neighbor_node)) {
     rc = redistribute<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
   } else {
     rc = coalesce<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
@@ -1739,7 +2333,14 @@ RC BplusTreeHandler::redistribute(BplusTreeMiniTransaction &mtr, Frame *neighbor
   InternalIndexNodeHandler parent_node(mtr, file_header_, parent_frame);
   IndexNodeHandlerType     neighbor_node(mtr, file_header_, neighbor_frame);
   IndexNodeHandlerType     node(mtr, file_header_, frame);
-  if (neighbor_node.size() < node.size()) {
+  if constexpr (std::is_same_v<IndexNodeHandlerType, LeafIndexNodeHandler>) {
+    // 叶子节点的元素是变长的，元素个数少的节点数据量不一定少，移动过来的元素也可能放不下。
+    // 放不下时保持不变，节点中的数据少一些并不影响正确性
+    const char *key = (index == 0) ? neighbor_node.key_at(0) : neighbor_node.key_at(neighbor_node.size() - 1);
+    if (!node.has_room_for(key)) {
+      return RC::SUCCESS;
+    }
+  } else if (neighbor_node.size() < node.size()) {
     LOG_ERROR("got invalid nodes. neighbor node size %d, this node size %d", neighbor_node.size(), node.size());
   }
   if (index == 0) {
@@ -1779,7 +2380,7 @@ RC BplusTreeHandler::delete_entry_internal(BplusTreeMiniTransaction &mtr, Frame
 
   leaf_frame->mark_dirty();
 
-  if (leaf_index_node.size() >= leaf_index_node.min_size()) {
+  if (!leaf_index_node.is_underflow()) {
     return RC::SUCCESS;
   }
 
@@ -23,6 +23,9 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/memory.h"
 #include "common/lang/sstream.h"
 #include "common/lang/functional.h"
+#include "common/lang/span.h"
+#include "common/lang/utility.h"
+#include "common/lang/vector.h"
 #include "common/log/log.h"
 #include "sql/parser/parse_defs.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -217,23 +220,30 @@ struct IndexNode
  * @ingroup BPlusTree
  * @code
  * storage format:
- * | common header | prev page id | next page id |
- * | key0, rid0 | key1, rid1 | ... | keyn, ridn |
+ * | common header | next page id | prefix length | heap offset |
+ * | slot0 | slot1 | ... | slotn | free space |
+ * | item(n) ... item(0) (堆区，从后向前分配) | prefix |
+ * item: | suffix length | key suffix | rid(key) | rid(value) |
  * @endcode
  * the key is in format: the key value of record and rid.
  * so the key in leaf page must be unique.
  * the value is rid.
+ * 叶子节点的元素是变长的。页面中所有键值的属性部分共同的前缀只在页面末尾保存一份，
+ * 每个元素只保存剩余的部分并去掉末尾补齐的0。slot 按照键值顺序记录每个元素在页面中的偏移。
+ * value 与 key 中的 rid 相同时不单独保存，用 suffix length 的最高位标记。
  * can you implenment a cluster index ?
  */
 struct LeafIndexNode : public IndexNode
 {
-  static constexpr int HEADER_SIZE = IndexNode::HEADER_SIZE + 4;
+  static constexpr int HEADER_SIZE = IndexNode::HEADER_SIZE + 8;
 
-  PageNum next_brother;
+  PageNum  next_brother;
+  uint16_t prefix_length;  ///< 键值公共前缀的长度，前缀保存在页面的末尾
+  uint16_t heap_offset;    ///< 堆区的起始位置，元素从页面末尾向前分配
   /**
-   * leaf can store order keys and rids at most
+   * slot 数组，每个 slot 是元素在页面中的偏移
    */
-  char array[0];
+  uint16_t slots[0];
 };
 
 /**
@@ -306,10 +316,17 @@ public:
 
   Frame *frame() const { return frame_; }
 
+  /**
+   * @brief 页面中有效数据所在的位置，记录整页日志时只需要记录这部分
+   * @param[out] image 从页面开头算起的一段数据
+   * @param[out] tail 到页面末尾结束的一段数据，可能为空
+   */
+  virtual void page_image(span<const char> &image, span<const char> &tail) const;
+
   friend string to_string(const IndexNodeHandler &handler);
 
-  RC recover_insert_items(int index, const char *items, int num);
-  RC recover_remove_items(int index, int num);
+  virtual RC recover_insert_items(int index, const char *items, int num);
+  virtual RC recover_remove_items(int index, int num);
 
 protected:
   /**
@@ -331,6 +348,8 @@ protected:
 /**
  * @brief 叶子节点的操作
  * @ingroup BPlusTree
+ * @details 叶子节点中的元素是压缩过的，不能直接访问页面中的键值。日志和接口中使用的元素仍然是完整的
+ * key + value，长度是 item_size()，读写页面时再编码解码。
  */
 class LeafIndexNodeHandler final : public IndexNodeHandler
 {
@@ -342,6 +361,10 @@ public:
   RC      set_next_page(PageNum page_num);
   PageNum next_page() const;
 
+  /**
+   * @brief 获取指定位置的完整键值
+   * @details 键值是解码到当前对象的缓存中的，下次调用 key_at 之前有效
+   */
   char *key_at(int index);
   char *value_at(int index);
 
@@ -354,7 +377,11 @@ public:
   RC  insert(int index, const char *key, const char *value);
   RC  remove(int index);
   int remove(const char *key, const KeyComparator &comparator);
-  RC  move_half_to(LeafIndexNodeHandler &other);
+  /**
+   * @brief 把从 move_index 开始的元素移动到 other
+   * @param move_index 为负数时移动后一半的数据
+   */
+  RC  move_half_to(LeafIndexNodeHandler &other, int move_index = -1);
   RC  move_first_to_end(LeafIndexNodeHandler &other);
   RC  move_last_to_front(LeafIndexNodeHandler &other);
   /**
@@ -362,19 +389,79 @@ public:
    */
   RC move_to(LeafIndexNodeHandler &other);
 
+  /**
+   * @brief 插入指定的键值后页面是否还能放得下
+   * @details 键值的前缀与页面的公共前缀不同时，页面中所有的元素都会变长
+   */
+  bool has_room_for(const char *key) const;
+
+  /**
+   * @brief 当前页面放不下新的键值时，计算分裂的位置
+   * @details 尽量让两个页面的数据量相同，同时保证新的键值插入后两个页面都能放得下
+   * @param insert_position 新键值的插入位置
+   * @param key 新的键值
+   * @param[out] insert_left 新的键值应该插入到左边的页面还是右边的页面
+   * @return 分裂后留在当前页面的元素个数，找不到合适的位置时返回-1
+   */
+  int split_position(int insert_position, const char *key, bool &insert_left) const;
+
+  /// @brief 删除数据后当前页面的数据是否太少，需要合并或重新分配
+  bool is_underflow() const;
+  /// @brief 两个页面的数据是否可以合并到一个页面中
+  bool can_merge(const LeafIndexNodeHandler &other) const;
+  /// @brief 页面中已经使用的空间，包括页头
+  int  used_bytes() const;
+  /// @brief 公共前缀的长度
+  int  prefix_length() const { return leaf_node_->prefix_length; }
+
   bool validate(const KeyComparator &comparator, DiskBufferPool *bp) const;
 
+  RC recover_insert_items(int index, const char *items, int num) override;
+  RC recover_remove_items(int index, int num) override;
+
+  /// @brief 页头和 slot 数组在页面开头，堆区和公共前缀在页面末尾
+  void page_image(span<const char> &image, span<const char> &tail) const override;
+
+  /**
+   * @brief 从 index 开始复制 num 个完整的元素
+   */
+  void copy_items(int index, int num, vector<char> &items) const;
+
   friend string to_string(const LeafIndexNodeHandler &handler, const KeyPrinter &printer);
 
 protected:
-  char *__item_at(int index) const override;
-
   RC append(const char *items, int num);
   RC append(const char *item);
   RC preappend(const char *item);
 
 private:
-  LeafIndexNode *leaf_node_ = nullptr;
+  /// @brief 元素在页面中的起始位置
+  const char *item_data(int index) const { return frame_->data() + leaf_node_->slots[index]; }
+  const char *prefix_data() const { return frame_->data() + BP_PAGE_DATA_SIZE - leaf_node_->prefix_length; }
+  const char *value_data(int index) const;
+  /// @brief 页面中一个编码后的元素占用的空间，包括 slot
+  int         encoded_size(int index) const;
+  /// @brief 把页面中的元素解码成完整的 key
+  void        decode_key(int index, char *key) const;
+  /// @brief 把页面中的元素解码成完整的 key + value
+  void        decode_item(int index, char *item) const;
+  /// @brief 元素中 RID 和 value 的长度，这部分不压缩。value 与 key 中的 RID 相同时不单独保存
+  int         tail_size(bool value_omitted = false) const
+  {
+    return key_size() - header_.attr_length + (value_omitted ? 0 : value_size());
+  }
+  /// @brief 元素的 value 是否与 key 中 attr 后面的部分相同
+  bool        can_omit_value(const char *item) const;
+  /// @brief 键值与当前页面公共前缀相同部分的长度
+  int         common_prefix_with(const char *key) const;
+  /// @brief 在页面的堆区中写入一个元素，不修改 slot
+  int         encode_item(const char *item);
+  /// @brief 使用给定的元素重新构建整个页面，会重新计算公共前缀
+  void        rebuild(const char *items, int num);
+
+private:
+  LeafIndexNode       *leaf_node_ = nullptr;
+  mutable vector<char> key_buffer_;
 };
 
 /**
@@ -420,10 +507,20 @@ public:
   RC move_to(InternalIndexNodeHandler &other);
   RC move_first_to_end(InternalIndexNodeHandler &other);
   RC move_last_to_front(InternalIndexNodeHandler &other);
-  RC move_half_to(InternalIndexNodeHandler &other);
+  /**
+   * @brief 把从 move_index 开始的元素移动到 other
+   * @param move_index 为负数时移动后一半的数据
+   */
+  RC move_half_to(InternalIndexNodeHandler &other, int move_index = -1);
+
+  bool is_underflow() const { return size() < min_size(); }
+  bool can_merge(const InternalIndexNodeHandler &other) const { return size() + other.size() <= max_size(); }
 
   bool validate(const KeyComparator &comparator, DiskBufferPool *bp) const;
 
+  /// @brief 元素从页头之后连续存放，只有开头一段
+  void page_image(span<const char> &image, span<const char> &tail) const override;
+
   friend string to_string(const InternalIndexNodeHandler &handler, const KeyPrinter &printer);
 
 private:
@@ -502,6 +599,16 @@ public:
    */
   RC get_entry(const char *user_key, int key_len, list<RID> &rids);
 
+  /**
+   * @brief 批量查找多个键值对应的record
+   * @details 按照键值从小到大的顺序查找。下一个键值没有超出当前叶子节点的最大键值时，直接在当前叶子节点中查找；
+   * 超出时先看右边的兄弟节点，还不在兄弟节点中才从根节点重新查找。
+   * 这样一批键值可以共用从根节点向下查找时的加锁和页面访问，适合索引嵌套循环连接和IN列表这类场景。
+   * @param user_keys 要查找的键值，每个键值的内存大小与attr_length一致。最好已经排好序，否则会先排序
+   * @param[out] entries 查找结果，first是键值在user_keys中的下标，second是记录的位置。结果按照键值从小到大排列
+   */
+  RC get_entries(span<const char *const> user_keys, vector<pair<int, RID>> &entries);
+
   RC sync();
 
   /**
@@ -559,6 +666,15 @@ protected:
    */
   RC left_most_page(BplusTreeMiniTransaction &mtr, Frame *&frame);
 
+  /**
+   * @brief 批量查找时定位到第一个不小于(或大于)key的位置
+   * @details frame 不为空时表示当前持有的叶子节点，会先在当前节点和它右边的兄弟节点中查找，找不到再从根节点查找。
+   * @param want_greater 为true时定位到第一个大于key的位置
+   * @param[in,out] frame 当前持有的叶子节点
+   * @param[out] index 找到的位置，可能等于叶子节点的大小
+   */
+  RC seek_leaf(BplusTreeMiniTransaction &mtr, const char *key, bool want_greater, Frame *&frame, int &index);
+
   /**
    * @brief 查找指定的叶子节点
    * @param op 当前想要执行的操作。操作类型不同会在查找的过程中加不同类型的锁
@@ -584,7 +700,7 @@ protected:
    * @details 当节点中的键值对超过最大值时，需要拆分节点
    */
   template <typename IndexNodeHandlerType>
-  RC split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame);
+  RC split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame, int move_index = -1);
 
   /**
    * @brief 合并或重新分配
@@ -653,6 +769,7 @@ protected:
 private:
   friend class BplusTreeScanner;
   friend class BplusTreeTester;
+  friend class BplusTreeBulkLoader;
 };
 
 /**
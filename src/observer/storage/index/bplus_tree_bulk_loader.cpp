@@ -0,0 +1,533 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "storage/index/bplus_tree_bulk_loader.h"
+#include "common/io/io.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+
+using namespace common;
+
+/// 归并时每个run每次从文件中读取多少个元素
+static constexpr int RUN_BUFFER_ITEMS = 4096;
+
+///////////////////////////////////////////////////////////////////////////////
+// BplusTreeEntrySorter
+BplusTreeEntrySorter::BplusTreeEntrySorter(
+    AttrType attr_type, int attr_length, const string &spill_file_prefix, int64_t memory_limit)
+    : attr_length_(attr_length),
+      key_length_(attr_length + static_cast<int>(sizeof(RID))),
+      spill_file_prefix_(spill_file_prefix),
+      memory_limit_(memory_limit)
+{
+  key_comparator_.init(attr_type, attr_length);
+}
+
+BplusTreeEntrySorter::~BplusTreeEntrySorter()
+{
+  for (Run &run : runs_) {
+    if (run.fd >= 0) {
+      ::close(run.fd);
+    }
+  }
+  for (const string &file : run_files_) {
+    ::unlink(file.c_str());
+  }
+}
+
+RC BplusTreeEntrySorter::add(const char *user_key, const RID &rid)
+{
+  ASSERT(!sorted_, "cannot add entry after sorted");
+
+  if (!memory_.empty() && static_cast<int64_t>(memory_.size()) + key_length_ > memory_limit_) {
+    RC rc = spill();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  memory_.insert(memory_.end(), user_key, user_key + attr_length_);
+  const char *rid_data = reinterpret_cast<const char *>(&rid);
+  memory_.insert(memory_.end(), rid_data, rid_data + sizeof(RID));
+  count_++;
+  return RC::SUCCESS;
+}
+
+void BplusTreeEntrySorter::sort_memory()
+{
+  const int64_t item_num = static_cast<int64_t>(memory_.size()) / key_length_;
+  sorted_offsets_.resize(item_num);
+  for (int64_t i = 0; i < item_num; i++) {
+    sorted_offsets_[i] = i * key_length_;
+  }
+
+  const char *data = memory_.data();
+  std::sort(sorted_offsets_.begin(), sorted_offsets_.end(), [this, data](int64_t left, int64_t right) {
+    return key_comparator_(data + left, data + right) < 0;
+  });
+  memory_position_ = 0;
+}
+
+RC BplusTreeEntrySorter::spill()
+{
+  sort_memory();
+
+  string file_name = spill_file_prefix_ + ".sort." + std::to_string(run_files_.size());
+  int    fd        = ::open(file_name.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0600);
+  if (fd < 0) {
+    LOG_WARN("failed to create sort file. file=%s, errno=%d:%s", file_name.c_str(), errno, strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  run_files_.push_back(file_name);
+
+  // 按照排好的顺序拷贝到连续的缓冲区中，攒够一批再写文件
+  vector<char> write_buffer;
+  write_buffer.reserve(static_cast<size_t>(RUN_BUFFER_ITEMS) * key_length_);
+  for (int64_t offset : sorted_offsets_) {
+    write_buffer.insert(write_buffer.end(), memory_.data() + offset, memory_.data() + offset + key_length_);
+    if (write_buffer.size() >= static_cast<size_t>(RUN_BUFFER_ITEMS) * key_length_) {
+      if (writen(fd, write_buffer.data(), static_cast<int>(write_buffer.size())) != 0) {
+        LOG_WARN("failed to write sort file. file=%s, errno=%d:%s", file_name.c_str(), errno, strerror(errno));
+        ::close(fd);
+        return RC::IOERR_WRITE;
+      }
+      write_buffer.clear();
+    }
+  }
+  if (!write_buffer.empty() && writen(fd, write_buffer.data(), static_cast<int>(write_buffer.size())) != 0) {
+    LOG_WARN("failed to write sort file. file=%s, errno=%d:%s", file_name.c_str(), errno, strerror(errno));
+    ::close(fd);
+    return RC::IOERR_WRITE;
+  }
+
+  Run run;
+  run.fd     = fd;
+  run.remain = static_cast<int64_t>(sorted_offsets_.size());
+  runs_.push_back(std::move(run));
+
+  LOG_DEBUG("spill a sorted run. file=%s, items=%ld", file_name.c_str(), runs_.back().remain);
+
+  memory_.clear();
+  sorted_offsets_.clear();
+  return RC::SUCCESS;
+}
+
+RC BplusTreeEntrySorter::fill_run(Run &run)
+{
+  const int item_num = static_cast<int>(std::min(run.remain, static_cast<int64_t>(RUN_BUFFER_ITEMS)));
+  run.position       = 0;
+  run.buffer_items   = item_num;
+  if (item_num == 0) {
+    return RC::SUCCESS;
+  }
+
+  run.buffer.resize(static_cast<size_t>(item_num) * key_length_);
+  if (readn(run.fd, run.buffer.data(), static_cast<int>(run.buffer.size())) != 0) {
+    LOG_WARN("failed to read sort file. errno=%d:%s", errno, strerror(errno));
+    return RC::IOERR_READ;
+  }
+  run.remain -= item_num;
+  return RC::SUCCESS;
+}
+
+RC BplusTreeEntrySorter::sort()
+{
+  sorted_ = true;
+  if (runs_.empty()) {
+    sort_memory();
+    return RC::SUCCESS;
+  }
+
+  // 数据已经写到文件中了，剩余的数据也写下去，统一做多路归并
+  RC rc = RC::SUCCESS;
+  if (!memory_.empty()) {
+    rc = spill();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  memory_.shrink_to_fit();
+
+  for (int i = 0; i < static_cast<int>(runs_.size()); i++) {
+    Run &run = runs_[i];
+    if (::lseek(run.fd, 0, SEEK_SET) < 0) {
+      LOG_WARN("failed to seek sort file. errno=%d:%s", errno, strerror(errno));
+      return RC::IOERR_SEEK;
+    }
+    rc = fill_run(run);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (run.buffer_items > 0) {
+      heap_.push_back(i);
+    }
+  }
+
+  auto greater = [this](int left, int right) {
+    return key_comparator_(run_current(runs_[left]), run_current(runs_[right])) > 0;
+  };
+  std::make_heap(heap_.begin(), heap_.end(), greater);
+  LOG_INFO("begin to merge sorted runs. runs=%d, items=%ld", static_cast<int>(runs_.size()), count_);
+  return RC::SUCCESS;
+}
+
+RC BplusTreeEntrySorter::next(const char *&key)
+{
+  ASSERT(sorted_, "should sort before fetching entries");
+
+  if (runs_.empty()) {
+    if (memory_position_ >= sorted_offsets_.size()) {
+      return RC::RECORD_EOF;
+    }
+    key = memory_.data() + sorted_offsets_[memory_position_++];
+    return RC::SUCCESS;
+  }
+
+  auto greater = [this](int left, int right) {
+    return key_comparator_(run_current(runs_[left]), run_current(runs_[right])) > 0;
+  };
+
+  // 上次返回的数据可能还在被使用，所以直到这次调用时才移动对应的run
+  if (last_run_ >= 0) {
+    Run &run = runs_[last_run_];
+    run.position++;
+    if (run.position >= run.buffer_items) {
+      RC rc = fill_run(run);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+    if (run.buffer_items > 0) {
+      heap_.push_back(last_run_);
+      std::push_heap(heap_.begin(), heap_.end(), greater);
+    }
+    last_run_ = -1;
+  }
+
+  if (heap_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  std::pop_heap(heap_.begin(), heap_.end(), greater);
+  last_run_ = heap_.back();
+  heap_.pop_back();
+  key = run_current(runs_[last_run_]);
+  return RC::SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// BplusTreeBulkLoader
+BplusTreeBulkLoader::BplusTreeBulkLoader(BplusTreeHandler &tree_handler, float fill_factor)
+    : tree_handler_(tree_handler), mtr_(tree_handler)
+{
+  if (fill_factor > 0 && fill_factor <= 1) {
+    fill_factor_ = fill_factor;
+  } else {
+    LOG_WARN("invalid fill factor %f, use default %f", fill_factor, DEFAULT_INDEX_FILL_FACTOR);
+  }
+}
+
+BplusTreeBulkLoader::~BplusTreeBulkLoader()
+{
+  // 中途失败时，把还没有写完的页面释放掉
+  for (Level &level : levels_) {
+    if (level.frame != nullptr) {
+      tree_handler_.buffer_pool().unpin_page(level.frame);
+      level.frame = nullptr;
+    }
+  }
+}
+
+void BplusTreeBulkLoader::plan_internal_levels(int64_t leaf_page_count)
+{
+  const IndexFileHeader &header = tree_handler_.file_header();
+
+  levels_.resize(1);
+  levels_[0].page_count = leaf_page_count;
+
+  int64_t item_count = leaf_page_count;
+  while (item_count > 1) {
+    const int max_size = header.internal_max_size;
+    const int capacity = std::min(max_size, std::max(2, static_cast<int>(max_size * fill_factor_)));  // 内部节点至少要有两个孩子
+
+    Level level;
+    level.item_count = item_count;
+    level.page_count = (item_count + capacity - 1) / capacity;
+    levels_.push_back(level);
+    item_count = level.page_count;
+  }
+}
+
+int BplusTreeBulkLoader::page_target(const Level &level) const
+{
+  // 平均分配到每个页面上，余数分给前面的页面
+  const int64_t base  = level.item_count / level.page_count;
+  const int64_t extra = level.item_count % level.page_count;
+  return static_cast<int>(base + (level.page_index < extra ? 1 : 0));
+}
+
+RC BplusTreeBulkLoader::allocate_node(int level, Frame *&frame)
+{
+  RC rc = tree_handler_.buffer_pool().allocate_page(&frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate page while bulk loading. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 页面内容最后会以整页的方式记录日志，所以这里直接初始化，不使用会记录日志的 init_empty
+  IndexNode *node = reinterpret_cast<IndexNode *>(frame->data());
+  node->is_leaf   = (level == 0);
+  node->key_num   = 0;
+  node->parent    = BP_INVALID_PAGE_NUM;
+  if (node->is_leaf) {
+    LeafIndexNode *leaf_node  = reinterpret_cast<LeafIndexNode *>(node);
+    leaf_node->next_brother   = BP_INVALID_PAGE_NUM;
+    leaf_node->prefix_length  = 0;
+    leaf_node->heap_offset    = BP_PAGE_DATA_SIZE;
+  }
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::append_leaf(const char *key)
+{
+  const IndexFileHeader &header = tree_handler_.file_header();
+
+  RC     rc   = RC::SUCCESS;
+  Level &leaf = levels_[0];
+  if (leaf.frame == nullptr) {
+    rc = allocate_node(0, leaf.frame);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  // 按照填充因子控制每个页面的元素个数和数据量，放不下时换一个新页面
+  const int count_limit = std::max(1, static_cast<int>(header.leaf_max_size * fill_factor_));
+  const int bytes_limit = static_cast<int>(BP_PAGE_DATA_SIZE * fill_factor_);
+  {
+    LeafIndexNodeHandler node(mtr_, header, leaf.frame);
+    if (node.size() > 0 && (node.size() >= count_limit || node.used_bytes() >= bytes_limit || !node.has_room_for(key))) {
+      // 先分配下一个叶子页面，这样当前页面的兄弟指针在记录日志前就是完整的
+      Frame *next_frame = nullptr;
+      rc                = allocate_node(0, next_frame);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      reinterpret_cast<LeafIndexNode *>(leaf.frame->data())->next_brother = next_frame->page_num();
+
+      rc = finish_leaf(next_frame);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+  }
+
+  // 叶子节点的元素是 key + RID，而key本身就是属性值 + RID
+  memcpy(item_buffer_.data(), key, header.key_length);
+  memcpy(item_buffer_.data() + header.key_length, key + header.attr_length, sizeof(RID));
+
+  LeafIndexNodeHandler node(mtr_, header, leaf.frame);
+  return node.recover_insert_items(node.size(), item_buffer_.data(), 1);
+}
+
+RC BplusTreeBulkLoader::finish_leaf(Frame *next_frame)
+{
+  const IndexFileHeader &header = tree_handler_.file_header();
+
+  Level &leaf = levels_[0];
+  Frame *frame = leaf.frame;
+
+  // 叶子页面中的键值是压缩过的，需要复制出来
+  LeafIndexNodeHandler node(mtr_, header, frame);
+  const char          *first_key = node.key_at(0);
+  leaf_first_keys_.insert(leaf_first_keys_.end(), first_key, first_key + header.key_length);
+  leaf_pages_.push_back(frame->page_num());
+
+  frame->mark_dirty();
+  tree_handler_.buffer_pool().unpin_page(frame);
+  leaf.frame = next_frame;
+  leaf.page_index++;
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::build_internal_levels()
+{
+  const IndexFileHeader &header = tree_handler_.file_header();
+
+  plan_internal_levels(static_cast<int64_t>(leaf_pages_.size()));
+
+  RC rc = RC::SUCCESS;
+  for (size_t i = 0; i < leaf_pages_.size(); i++) {
+    PageNum parent_page_num = BP_INVALID_PAGE_NUM;
+    if (levels_.size() > 1) {
+      rc = append_internal(1, leaf_first_keys_.data() + i * header.key_length, leaf_pages_[i], parent_page_num);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    } else {
+      root_page_num_ = leaf_pages_[i];
+    }
+
+    Frame *frame = nullptr;
+    rc           = tree_handler_.buffer_pool().get_this_page(leaf_pages_[i], &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get leaf page while bulk loading. page=%d, rc=%s", leaf_pages_[i], strrc(rc));
+      return rc;
+    }
+
+    LeafIndexNodeHandler node(mtr_, header, frame);
+    rc = log_page_image(node, parent_page_num);
+    tree_handler_.buffer_pool().unpin_page(frame);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::append_internal(int level, const char *key, PageNum child_page_num, PageNum &parent_page_num)
+{
+  const IndexFileHeader &header = tree_handler_.file_header();
+
+  RC     rc       = RC::SUCCESS;
+  Level &internal = levels_[level];
+  if (internal.frame == nullptr) {
+    rc = allocate_node(level, internal.frame);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  memcpy(item_buffer_.data(), key, header.key_length);
+  memcpy(item_buffer_.data() + header.key_length, &child_page_num, sizeof(child_page_num));
+
+  InternalIndexNodeHandler node(mtr_, header, internal.frame);
+  node.recover_insert_items(node.size(), item_buffer_.data(), 1);
+  parent_page_num = internal.frame->page_num();
+
+  if (node.size() >= page_target(internal)) {
+    rc = finish_page(level);
+  }
+  return rc;
+}
+
+RC BplusTreeBulkLoader::finish_page(int level)
+{
+  const IndexFileHeader &header = tree_handler_.file_header();
+
+  RC     rc    = RC::SUCCESS;
+  Level &lv    = levels_[level];
+  Frame *frame = lv.frame;
+
+  InternalIndexNodeHandler node(mtr_, header, frame);
+  PageNum                  parent_page_num = BP_INVALID_PAGE_NUM;
+  if (level + 1 < static_cast<int>(levels_.size())) {
+    rc = append_internal(level + 1, node.key_at(0), frame->page_num(), parent_page_num);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  } else {
+    root_page_num_ = frame->page_num();
+  }
+
+  rc = log_page_image(node, parent_page_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  tree_handler_.buffer_pool().unpin_page(frame);
+  lv.frame = nullptr;
+  lv.page_index++;
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::log_page_image(IndexNodeHandler &node, PageNum parent_page_num)
+{
+  Frame *frame = node.frame();
+  reinterpret_cast<IndexNode *>(frame->data())->parent = parent_page_num;
+
+  RC rc = mtr_.logger().node_page_image(node);
+  if (OB_SUCC(rc)) {
+    rc = mtr_.commit();
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log page image while bulk loading. page=%d, rc=%s", frame->page_num(), strrc(rc));
+    return rc;
+  }
+
+  frame->mark_dirty();
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::load(BplusTreeEntrySorter &sorter)
+{
+  const IndexFileHeader &header = tree_handler_.file_header();
+  if (!tree_handler_.is_empty()) {
+    LOG_WARN("cannot bulk load a non-empty tree. root page=%d", header.root_page);
+    return RC::INTERNAL;
+  }
+
+  if (sorter.key_length() != header.key_length) {
+    LOG_WARN("key length mismatch. sorter=%d, tree=%d", sorter.key_length(), header.key_length);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (sorter.count() == 0) {
+    return RC::SUCCESS;
+  }
+
+  levels_.resize(1);
+  item_buffer_.resize(header.key_length + sizeof(RID));
+
+  RC          rc  = RC::SUCCESS;
+  const char *key = nullptr;
+  while (OB_SUCC(rc = sorter.next(key))) {
+    rc = append_leaf(key);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to append entry while bulk loading. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to fetch sorted entry. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = finish_leaf(nullptr);
+  if (OB_SUCC(rc)) {
+    rc = build_internal_levels();
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to build internal levels while bulk loading. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  for (const Level &level : levels_) {
+    if (level.frame != nullptr || level.page_index != level.page_count) {
+      LOG_ERROR("bulk load finished with unfinished pages. page index=%ld, page count=%ld",
+                level.page_index, level.page_count);
+      return RC::INTERNAL;
+    }
+  }
+
+  rc = RC::SUCCESS;
+  {
+    BplusTreeMiniTransaction mtr(tree_handler_, &rc);
+    tree_handler_.update_root_page_num_locked(mtr, root_page_num_);
+  }
+
+  LOG_INFO("bulk load b+tree done. entries=%ld, levels=%d, leaf pages=%ld, root page=%d",
+           sorter.count(), static_cast<int>(levels_.size()), levels_[0].page_count, root_page_num_);
+  return rc;
+}
@@ -0,0 +1,163 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/rc.h"
+#include "common/types.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "storage/index/bplus_tree.h"
+
+/**
+ * @brief B+树批量构建时使用的外部排序
+ * @ingroup BPlusTree
+ * @details 收集 (key, RID) 并按照B+树的键值顺序排序。数据量超过内存限制时，把当前内存中的数据排好序
+ * 写到临时文件中(一个run)，最后对所有run做多路归并。
+ * 排序后的每个元素与B+树中的key格式相同：属性值 + RID，长度是 attr_length + sizeof(RID)。
+ */
+class BplusTreeEntrySorter
+{
+public:
+  /**
+   * @param attr_type 属性类型
+   * @param attr_length 属性长度
+   * @param spill_file_prefix 临时文件的前缀，临时文件名是前缀加上run的编号
+   * @param memory_limit 内存中最多缓存多少字节的数据
+   */
+  BplusTreeEntrySorter(
+      AttrType attr_type, int attr_length, const string &spill_file_prefix, int64_t memory_limit = 64 * 1024 * 1024);
+  ~BplusTreeEntrySorter();
+
+  /**
+   * @brief 添加一条数据
+   * @details 只能在 sort 之前调用
+   */
+  RC add(const char *user_key, const RID &rid);
+
+  /**
+   * @brief 输入结束，开始排序
+   * @details 如果有数据写到了临时文件，在这里准备多路归并
+   */
+  RC sort();
+
+  /**
+   * @brief 按顺序获取下一条数据
+   * @param[out] key 返回的数据在下次调用 next 之前有效
+   * @return 没有更多数据时返回 RECORD_EOF
+   */
+  RC next(const char *&key);
+
+  /// @brief 一共有多少条数据
+  int64_t count() const { return count_; }
+  int     key_length() const { return key_length_; }
+
+private:
+  /**
+   * @brief 一个写到临时文件中的有序run
+   */
+  struct Run
+  {
+    int          fd     = -1;
+    int64_t      remain = 0;  ///< 文件中还没有读到内存的元素个数
+    vector<char> buffer;
+    int          buffer_items = 0;  ///< buffer 中有效元素个数
+    int          position     = 0;  ///< 当前元素在 buffer 中的位置
+  };
+
+  /// @brief 对内存中的数据排序，排序结果记录在 sorted_offsets_ 中
+  void sort_memory();
+  /// @brief 将内存中的数据排好序后写到临时文件
+  RC spill();
+  /// @brief 从临时文件中读取下一批数据
+  RC fill_run(Run &run);
+
+  const char *run_current(const Run &run) const { return run.buffer.data() + run.position * key_length_; }
+
+private:
+  KeyComparator key_comparator_;
+  int           attr_length_ = 0;
+  int           key_length_  = 0;
+  string        spill_file_prefix_;
+  int64_t       memory_limit_ = 0;
+  int64_t       count_        = 0;
+  bool          sorted_       = false;
+
+  vector<char>    memory_;          ///< 内存中缓存的数据
+  vector<int64_t> sorted_offsets_;  ///< 内存中数据排序后的偏移
+  size_t          memory_position_ = 0;
+
+  vector<string> run_files_;
+  vector<Run>    runs_;
+  vector<int>    heap_;  ///< 多路归并使用的小顶堆，元素是 runs_ 的下标
+  int            last_run_ = -1;  ///< 上次 next 返回的数据所属的run，下次 next 时再前进
+};
+
+/**
+ * @brief 自底向上批量构建B+树
+ * @ingroup BPlusTree
+ * @details 数据已经有序，所以可以从左到右依次写满叶子页面。叶子页面中的元素是变长的，一个页面能放多少个元素
+ * 要写的时候才知道，所以先写完所有的叶子页面，记下每个页面的第一个键值，再根据叶子页面的个数计算上面每一层
+ * 需要多少个页面，每个页面放多少个元素，同一层内部节点的大小是均匀的，不会出现最后一个页面特别空的情况。
+ * 每个页面写完后记录一条整页日志，而不是每插入一个元素记录一条日志，也不需要从根节点开始查找和加锁。
+ * 叶子页面要等到知道父节点以后再记录日志。
+ * 只能在空树上使用，构建过程中这棵树不能被其它线程访问。
+ */
+class BplusTreeBulkLoader
+{
+public:
+  /**
+   * @param fill_factor 页面填充因子，取值范围 (0, 1]，非法值会使用 DEFAULT_INDEX_FILL_FACTOR
+   */
+  BplusTreeBulkLoader(BplusTreeHandler &tree_handler, float fill_factor = DEFAULT_INDEX_FILL_FACTOR);
+  ~BplusTreeBulkLoader();
+
+  /**
+   * @brief 使用排好序的数据构建B+树
+   * @param sorter 已经调用过 sort 的排序器
+   */
+  RC load(BplusTreeEntrySorter &sorter);
+
+private:
+  struct Level
+  {
+    Frame  *frame      = nullptr;  ///< 当前正在填充的页面
+    int64_t item_count = 0;        ///< 这一层一共有多少个元素
+    int64_t page_count = 0;        ///< 这一层一共有多少个页面
+    int64_t page_index = 0;        ///< 当前页面是这一层的第几个
+  };
+
+  /// @brief 根据叶子页面的个数计算每一层内部节点的页面个数
+  void plan_internal_levels(int64_t leaf_page_count);
+  /// @brief 当前页面应该放多少个元素
+  int page_target(const Level &level) const;
+
+  RC allocate_node(int level, Frame *&frame);
+  RC append_leaf(const char *key);
+  /// @brief 当前叶子页面已经写满，记下它的第一个键值后释放页面，日志在 build_internal_levels 中记录
+  RC finish_leaf(Frame *next_frame);
+  /// @brief 把所有叶子页面交给上一层，并设置叶子页面的父节点
+  RC build_internal_levels();
+  RC append_internal(int level, const char *key, PageNum child_page_num, PageNum &parent_page_num);
+  /// @brief 当前页面已经写满，设置父节点，记录整页日志并释放页面
+  RC finish_page(int level);
+  /// @brief 设置页面的父节点，记录整页日志
+  RC log_page_image(IndexNodeHandler &node, PageNum parent_page_num);
+
+private:
+  BplusTreeHandler        &tree_handler_;
+  BplusTreeMiniTransaction mtr_;
+  float                    fill_factor_    = DEFAULT_INDEX_FILL_FACTOR;
+  vector<Level>            levels_;
+  PageNum                  root_page_num_  = BP_INVALID_PAGE_NUM;
+  vector<char>             item_buffer_;
+  vector<char>             leaf_first_keys_;  ///< 每个叶子页面的第一个键值
+  vector<PageNum>          leaf_pages_;       ///< 按顺序记录的叶子页面
+};
@@ -41,8 +41,9 @@ RC BplusTreeIndex::create(Table *table, const char *file_name, const IndexMeta &
     return rc; // 返回创建索引处理器失败的错误
   }
 
-  inited_ = true; // 标记索引已初始化
-  table_  = table; // 关联表
+  inited_    = true; // 标记索引已初始化
+  table_     = table; // 关联表
+  file_name_ = file_name;
   LOG_INFO("Successfully create index, file_name:%s, index:%s, field:%s",
     file_name, index_meta.name(), index_meta.field());
   return RC::SUCCESS; // 返回成功
@@ -101,6 +102,44 @@ RC BplusTreeIndex::delete_entry(const char *record, const RID *rid)
   return index_handler_.delete_entry(record + field_meta_.offset(), rid); // 删除操作
 }
 
+// 批量构建索引
+RC BplusTreeIndex::bulk_load(RecordFileScanner &scanner, float fill_factor)
+{
+  const IndexFileHeader &header = index_handler_.file_header();
+  BplusTreeEntrySorter   sorter(header.attr_type, header.attr_length, file_name_);
+
+  RC     rc = RC::SUCCESS;
+  Record record;
+  while (OB_SUCC(rc = scanner.next(record))) {
+    rc = sorter.add(record.data() + field_meta_.offset(), record.rid());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to add entry to sorter. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to scan records while bulk loading index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  rc = sorter.sort(); // 排序，数据量大时会使用临时文件做外部排序
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sort index entries. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  BplusTreeBulkLoader loader(index_handler_, fill_factor);
+  rc = loader.load(sorter); // 自底向上构建B+树
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to bulk load index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("bulk load index done. index=%s, entries=%ld, fill factor=%f",
+      index_meta_.name(), sorter.count(), fill_factor);
+  return RC::SUCCESS;
+}
+
 // 创建索引扫描器
 IndexScanner *BplusTreeIndex::create_scanner(
     const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len, bool right_inclusive)
@@ -115,6 +154,31 @@ IndexScanner *BplusTreeIndex::create_scanner(
   return index_scanner; // 返回创建的扫描器
 }
 
+// 批量查找多个键值
+RC BplusTreeIndex::get_entries(span<const char *const> keys, int key_len, vector<pair<int, RID>> &entries)
+{
+  const int attr_length = field_meta_.len();
+  if (key_len == attr_length) {
+    return index_handler_.get_entries(keys, entries);
+  }
+
+  // 字符串的长度与字段长度不一致时，补齐成字段的长度
+  vector<char>         fixed_keys;
+  vector<const char *> fixed_key_ptrs;
+  vector<int>          key_indexes;
+  RC                   rc = fix_key_length(keys, key_len, fixed_keys, fixed_key_ptrs, key_indexes);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const size_t first = entries.size();
+  rc                 = index_handler_.get_entries(fixed_key_ptrs, entries);
+  for (size_t i = first; i < entries.size(); i++) {
+    entries[i].first = key_indexes[entries[i].first];
+  }
+  return rc;
+}
+
 // 同步索引
 RC BplusTreeIndex::sync() { return index_handler_.sync(); }
 
@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "storage/index/bplus_tree.h"
+#include "storage/index/bplus_tree_bulk_loader.h"
 #include "storage/index/index.h"
 
 /**
@@ -34,17 +35,33 @@ public:
   RC insert_entry(const char *record, const RID *rid) override;
   RC delete_entry(const char *record, const RID *rid) override;
 
+  /**
+   * @brief 使用表中已有的数据批量构建索引
+   * @details 扫描全表，对 (key, RID) 做外部排序后自底向上构建B+树，只能在刚创建的空索引上调用。
+   * 比逐条调用 insert_entry 少了每次从根节点查找、加锁和逐条记录日志的开销。
+   * @param scanner 已经打开的表扫描器
+   * @param fill_factor 页面填充因子
+   */
+  RC bulk_load(RecordFileScanner &scanner, float fill_factor);
+
   /**
    * 扫描指定范围的数据
    */
   IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
       int right_len, bool right_inclusive) override;
 
+  /**
+   * @brief 批量查找多个键值
+   * @details 在B+树上按照键值顺序一次遍历完成，不需要每个键值都从根节点开始查找
+   */
+  RC get_entries(span<const char *const> keys, int key_len, vector<pair<int, RID>> &entries) override;
+
   RC sync() override;
 
 private:
   bool             inited_ = false;
   Table           *table_  = nullptr;
+  string           file_name_;  ///< 索引文件名，批量构建时排序的临时文件放在它旁边
   BplusTreeHandler index_handler_;
 };
 
@@ -99,6 +99,39 @@ RC BplusTreeLogger::set_parent_page(IndexNodeHandler &node_handler, PageNum page
   return append_log_entry(make_unique<SetParentPageLogEntryHandler>(node_handler.frame(), page_num, old_page_num));
 }
 
+RC BplusTreeLogger::node_page_image(IndexNodeHandler &node_handler)
+{
+  // 记录整个页面的内容
+  span<const char> image;
+  span<const char> tail;
+  node_handler.page_image(image, tail);
+  return append_log_entry(make_unique<PageImageLogEntryHandler>(node_handler.frame(), image, tail));
+}
+
+RC BplusTreeLogger::replace_with_page_image(IndexNodeHandler &node_handler)
+{
+  if (!need_log_) {
+    return RC::SUCCESS;
+  }
+
+  // 统计这个页面已经记录的日志有多大
+  Frame     *frame = node_handler.frame();
+  Serializer buffer;
+  for (auto &entry : entries_) {
+    if (entry->frame() == frame) {
+      entry->serialize(buffer);
+    }
+  }
+  if (buffer.size() <= BP_PAGE_DATA_SIZE / 2) {
+    return RC::SUCCESS;
+  }
+
+  // 整页日志记录的是页面当前的状态，这个页面之前的日志都不再需要
+  auto iter = std::remove_if(entries_.begin(), entries_.end(), [frame](auto &entry) { return entry->frame() == frame; });
+  entries_.erase(iter, entries_.end());
+  return node_page_image(node_handler);
+}
+
 RC BplusTreeLogger::append_log_entry(unique_ptr<bplus_tree::LogEntryHandler> entry)
 {
   // 添加日志条目
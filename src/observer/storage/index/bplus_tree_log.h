@@ -127,6 +127,20 @@ public:
    */
   RC set_parent_page(IndexNodeHandler &node_handler, PageNum page_num, PageNum old_page_num);
 
+  /**
+   * @brief 记录某个页面的完整内容
+   * @details 用于批量构建B+树。新页面一次性写满后记录一条整页日志，代替逐条插入的日志。
+   * 只记录页面中有效数据的部分，参考 IndexNodeHandler::page_image
+   */
+  RC node_page_image(IndexNodeHandler &node_handler);
+
+  /**
+   * @brief 页面在当前操作中的日志太多时，用一条整页日志代替
+   * @details 用于分裂出来的新页面。新页面的内容都是在当前操作中写入的，逐条记录的日志超过半个页面时，
+   * 记录整页内容更省空间。新页面在操作之前没有被引用过，被代替的日志回滚时也不需要执行。
+   */
+  RC replace_with_page_image(IndexNodeHandler &node_handler);
+
   /**
    * @brief 提交。表示整个操作成功
    */
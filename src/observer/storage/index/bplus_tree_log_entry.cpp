@@ -34,6 +34,7 @@ string LogOperation::to_string() const
     case Type::INTERNAL_UPDATE_KEY: ss << "INTERNAL_UPDATE_KEY"; break;
     case Type::NODE_INSERT: ss << "NODE_INSERT"; break;
     case Type::NODE_REMOVE: ss << "NODE_REMOVE"; break;
+    case Type::PAGE_IMAGE: ss << "PAGE_IMAGE"; break;
     default: ss << "INVALID"; break;
   }
   return ss.str();
@@ -172,6 +173,10 @@ RC LogEntryHandler::from_buffer(
       rc = NormalOperationLogEntryHandler::deserialize(frame, operation, buffer, handler);
     } break;
 
+    case LogOperation::Type::PAGE_IMAGE: {
+      rc = PageImageLogEntryHandler::deserialize(frame, buffer, handler);
+    } break;
+
     default: {
       LOG_ERROR("unknown log operation. operation=%d:%s", operation.index(), operation.to_string().c_str());
       return RC::INTERNAL;
@@ -284,10 +289,14 @@ NormalOperationLogEntryHandler::NormalOperationLogEntryHandler(
 
 RC NormalOperationLogEntryHandler::serialize_body(Serializer &buffer) const
 {
+  // 重做删除操作时只需要位置和个数，删除的数据只在回滚时使用，回滚时日志还在内存中，不需要写下去
+  const bool serialize_items = operation_type().type() != LogOperation::Type::NODE_REMOVE;
+
   int     ret        = 0;
-  int32_t item_bytes = static_cast<int32_t>(items_.size());
+  int32_t item_bytes = serialize_items ? static_cast<int32_t>(items_.size()) : 0;
   if ((ret = buffer.write_int32(index_)) < 0 || (ret = buffer.write_int32(item_num_) < 0) ||
-      (ret = buffer.write_int32(item_bytes) < 0) || (ret = buffer.write(items_) < 0)) {
+      (ret = buffer.write_int32(item_bytes) < 0) ||
+      (serialize_items && (ret = buffer.write(items_) < 0))) {
     return RC::INTERNAL;
   }
 
@@ -328,7 +337,10 @@ RC NormalOperationLogEntryHandler::rollback(BplusTreeMiniTransaction &mtr, Bplus
   if (nullptr == frame()) {
     return RC::INTERNAL;
   }
-  IndexNodeHandler node_handler(mtr, tree_handler.file_header(), frame());
+  InternalIndexNodeHandler internal_node(mtr, tree_handler.file_header(), frame());
+  LeafIndexNodeHandler     leaf_node(mtr, tree_handler.file_header(), frame());
+  IndexNodeHandler        &node_handler = leaf_node.is_leaf() ? static_cast<IndexNodeHandler &>(leaf_node)
+                                                              : static_cast<IndexNodeHandler &>(internal_node);
   if (operation_type().type() == LogOperation::Type::NODE_INSERT) {
     return node_handler.recover_remove_items(index_, item_num_);
   } else {  // should be NODE_REMOVE
@@ -605,4 +617,67 @@ RC UpdateRootPageLogEntryHandler::redo(BplusTreeMiniTransaction &mtr, BplusTreeH
   return tree_handler.recover_update_root_page(mtr, root_page_num_);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// PageImageLogEntryHandler
+PageImageLogEntryHandler::PageImageLogEntryHandler(Frame *frame, span<const char> image, span<const char> tail)
+    : NodeLogEntryHandler(LogOperation::Type::PAGE_IMAGE, frame),
+      image_(image.begin(), image.end()),
+      tail_(tail.begin(), tail.end())
+{}
+
+RC PageImageLogEntryHandler::serialize_body(Serializer &buffer) const
+{
+  int ret = 0;
+  if ((ret = buffer.write_int32(static_cast<int32_t>(image_.size()))) < 0 || (ret = buffer.write(image_)) < 0 ||
+      (ret = buffer.write_int32(static_cast<int32_t>(tail_.size()))) < 0 || (ret = buffer.write(tail_)) < 0) {
+    return RC::INTERNAL;
+  }
+  return RC::SUCCESS;
+}
+
+string PageImageLogEntryHandler::to_string() const
+{
+  stringstream ss;
+  ss << LogEntryHandler::to_string() << ", image_bytes=" << image_.size() << ", tail_bytes=" << tail_.size();
+  return ss.str();
+}
+
+RC PageImageLogEntryHandler::deserialize(Frame *frame, Deserializer &buffer, unique_ptr<LogEntryHandler> &handler)
+{
+  int     ret         = 0;
+  int32_t image_bytes = -1;
+  if ((ret = buffer.read_int32(image_bytes)) < 0 || image_bytes < 0 || image_bytes > BP_PAGE_DATA_SIZE) {
+    return RC::INTERNAL;
+  }
+
+  vector<char> image(image_bytes);
+  if ((ret = buffer.read(image)) < 0) {
+    return RC::INTERNAL;
+  }
+
+  int32_t tail_bytes = -1;
+  if ((ret = buffer.read_int32(tail_bytes)) < 0 || tail_bytes < 0 || image_bytes + tail_bytes > BP_PAGE_DATA_SIZE) {
+    return RC::INTERNAL;
+  }
+
+  vector<char> tail(tail_bytes);
+  if ((ret = buffer.read(tail)) < 0) {
+    return RC::INTERNAL;
+  }
+
+  handler = make_unique<PageImageLogEntryHandler>(frame, image, tail);
+  return RC::SUCCESS;
+}
+
+RC PageImageLogEntryHandler::redo(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler)
+{
+  if (nullptr == frame()) {
+    return RC::INTERNAL;
+  }
+  memcpy(frame()->data(), image_.data(), image_.size());
+  memcpy(frame()->data() + BP_PAGE_DATA_SIZE - tail_.size(), tail_.data(), tail_.size());
+  frame()->mark_dirty();
+  return RC::SUCCESS;
+}
+
 }  // namespace bplus_tree
@@ -50,6 +50,7 @@ public:
     INTERNAL_UPDATE_KEY,       /// 更新内部节点的key
     NODE_INSERT,               /// 在节点中间(也可能是末尾)插入一些元素
     NODE_REMOVE,               /// 在节点中间(也可能是末尾)删除一些元素
+    PAGE_IMAGE,                /// 整个页面的内容，批量构建B+树时使用
 
     MAX_TYPE,
   };
@@ -376,4 +377,35 @@ private:
   vector<char> old_key_;
 };
 
+/**
+ * @brief 整页镜像日志处理类
+ * @ingroup CLog
+ * @details 批量构建B+树或者分裂出新页面时，页面是新分配并一次性写满的，记录整页内容比逐条记录插入日志更省空间，
+ * 重做时也只需要内存拷贝。这类页面在之前没有任何内容，所以回滚时不需要做任何事情。
+ * 页面中间的空闲空间不需要记录，镜像分成两段：从页面开头算起的 image 和到页面末尾结束的 tail。
+ */
+class PageImageLogEntryHandler : public NodeLogEntryHandler
+{
+public:
+  PageImageLogEntryHandler(Frame *frame, span<const char> image, span<const char> tail = {});
+  virtual ~PageImageLogEntryHandler() = default;
+
+  RC serialize_body(common::Serializer &buffer) const override;
+  RC rollback(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler) override { return RC::SUCCESS; }
+  RC redo(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler) override;
+
+  string to_string() const override;
+
+  static RC deserialize(Frame *frame, common::Deserializer &buffer, unique_ptr<LogEntryHandler> &handler);
+
+  const char *image() const { return image_.data(); }
+  int32_t     image_bytes() const { return static_cast<int32_t>(image_.size()); }
+  const char *tail() const { return tail_.data(); }
+  int32_t     tail_bytes() const { return static_cast<int32_t>(tail_.size()); }
+
+private:
+  vector<char> image_;
+  vector<char> tail_;
+};
+
 }  // namespace bplus_tree
@@ -0,0 +1,149 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/index/hash_index.h"
+#include "common/log/log.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+
+// 哈希索引析构函数
+HashIndex::~HashIndex() noexcept { close(); }
+
+// 创建哈希索引
+RC HashIndex::create(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta)
+{
+  if (inited_) {
+    LOG_WARN("Failed to create index due to the index has been created before. file_name:%s, index:%s, field:%s",
+        file_name, index_meta.name(), index_meta.field());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, field_meta);
+
+  BufferPoolManager &bpm = table->db()->buffer_pool_manager();
+  RC rc = index_handler_.create(table->db()->log_handler(), bpm, file_name, field_meta.type(), field_meta.len());
+  if (RC::SUCCESS != rc) {
+    LOG_WARN("Failed to create hash index handler, file_name:%s, index:%s, field:%s, rc:%s",
+        file_name, index_meta.name(), index_meta.field(), strrc(rc));
+    return rc;
+  }
+
+  inited_ = true;
+  table_  = table;
+  LOG_INFO("Successfully create hash index, file_name:%s, index:%s, field:%s",
+    file_name, index_meta.name(), index_meta.field());
+  return RC::SUCCESS;
+}
+
+// 打开哈希索引
+RC HashIndex::open(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta)
+{
+  if (inited_) {
+    LOG_WARN("Failed to open index due to the index has been initedd before. file_name:%s, index:%s, field:%s",
+        file_name, index_meta.name(), index_meta.field());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, field_meta);
+
+  BufferPoolManager &bpm = table->db()->buffer_pool_manager();
+  RC rc = index_handler_.open(table->db()->log_handler(), bpm, file_name);
+  if (RC::SUCCESS != rc) {
+    LOG_WARN("Failed to open hash index handler, file_name:%s, index:%s, field:%s, rc:%s",
+        file_name, index_meta.name(), index_meta.field(), strrc(rc));
+    return rc;
+  }
+
+  inited_ = true;
+  table_  = table;
+  LOG_INFO("Successfully open hash index, file_name:%s, index:%s, field:%s",
+    file_name, index_meta.name(), index_meta.field());
+  return RC::SUCCESS;
+}
+
+// 关闭哈希索引
+RC HashIndex::close()
+{
+  if (inited_) {
+    LOG_INFO("Begin to close hash index, index:%s, field:%s", index_meta_.name(), index_meta_.field());
+    index_handler_.close();
+    inited_ = false;
+  }
+  return RC::SUCCESS;
+}
+
+RC HashIndex::insert_entry(const char *record, const RID *rid)
+{
+  return index_handler_.insert_entry(record + field_meta_.offset(), rid);
+}
+
+RC HashIndex::delete_entry(const char *record, const RID *rid)
+{
+  return index_handler_.delete_entry(record + field_meta_.offset(), rid);
+}
+
+RC HashIndex::build(RecordFileScanner &scanner)
+{
+  RC     rc = RC::SUCCESS;
+  Record record;
+  while (OB_SUCC(rc = scanner.next(record))) {
+    rc = insert_entry(record.data(), &record.rid());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert entry into hash index. index=%s, rid=%s, rc=%s",
+          index_meta_.name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to scan records while building hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("build hash index done. index=%s, entries=%ld", index_meta_.name(), index_handler_.entry_count());
+  return RC::SUCCESS;
+}
+
+IndexScanner *HashIndex::create_scanner(
+    const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len, bool right_inclusive)
+{
+  if (left_key == nullptr || right_key == nullptr || !left_inclusive || !right_inclusive || left_len != right_len ||
+      0 != memcmp(left_key, right_key, left_len)) {
+    LOG_WARN("hash index only supports equality lookup. index=%s", index_meta_.name());
+    return nullptr;
+  }
+
+  const char *keys[] = {left_key};
+  return create_multi_key_scanner(keys, left_len);
+}
+
+RC HashIndex::get_entries(span<const char *const> keys, int key_len, vector<pair<int, RID>> &entries)
+{
+  if (key_len == field_meta_.len()) {
+    return index_handler_.get_entries(keys, entries);
+  }
+
+  // 字符串的长度与字段长度不一致时，补齐成字段的长度
+  vector<char>         fixed_keys;
+  vector<const char *> fixed_key_ptrs;
+  vector<int>          key_indexes;
+  RC                   rc = fix_key_length(keys, key_len, fixed_keys, fixed_key_ptrs, key_indexes);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const size_t first = entries.size();
+  rc                 = index_handler_.get_entries(fixed_key_ptrs, entries);
+  for (size_t i = first; i < entries.size(); i++) {
+    entries[i].first = key_indexes[entries[i].first];
+  }
+  return rc;
+}
+
+RC HashIndex::sync() { return index_handler_.sync(); }
@@ -0,0 +1,56 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "storage/index/hash_index_handler.h"
+#include "storage/index/index.h"
+
+/**
+ * @brief 哈希索引
+ * @ingroup Index
+ * @details 只支持等值查询，范围查询需要使用B+树索引
+ */
+class HashIndex : public Index
+{
+public:
+  HashIndex() = default;
+  virtual ~HashIndex() noexcept;
+
+  RC create(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta);
+  RC open(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta);
+  RC close();
+
+  RC insert_entry(const char *record, const RID *rid) override;
+  RC delete_entry(const char *record, const RID *rid) override;
+
+  /**
+   * @brief 使用表中已有的数据构建索引
+   * @details 哈希索引不需要排序，逐条插入
+   */
+  RC build(RecordFileScanner &scanner);
+
+  /**
+   * @brief 创建扫描器
+   * @details 只支持左右边界相同并且都包含边界的等值查询，其它情况返回nullptr
+   */
+  IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
+      int right_len, bool right_inclusive) override;
+
+  //! @copydoc Index::get_entries
+  RC get_entries(span<const char *const> keys, int key_len, vector<pair<int, RID>> &entries) override;
+
+  RC sync() override;
+
+private:
+  bool             inited_ = false;
+  Table           *table_  = nullptr;
+  HashIndexHandler index_handler_;
+};
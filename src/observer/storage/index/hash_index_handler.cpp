@@ -0,0 +1,815 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stddef.h>
+
+#include "storage/index/hash_index_handler.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/defer.h"
+#include "common/lang/sstream.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/frame.h"
+#include "storage/index/hash_index_log.h"
+
+using namespace common;
+
+namespace {
+
+/// 一个目录页能记录多少个桶
+constexpr int DIRECTORY_PAGE_CAPACITY = BP_PAGE_DATA_SIZE / sizeof(PageNum);
+
+/**
+ * @brief 访问桶页面中数据的辅助类
+ * @details 页面格式：HashBucketHeader | hashes[capacity] | entries[capacity]
+ */
+class BucketPage
+{
+public:
+  BucketPage(Frame *frame, const HashIndexFileHeader &header)
+      : frame_(frame), data_(frame->data()), capacity_(header.bucket_capacity), entry_length_(header.entry_length)
+  {}
+
+  Frame *frame() const { return frame_; }
+
+  const HashBucketHeader &header() const { return *reinterpret_cast<const HashBucketHeader *>(data_); }
+  int                     size() const { return header().size; }
+  PageNum                 overflow_page() const { return header().overflow_page; }
+
+  const uint32_t *hashes() const { return reinterpret_cast<const uint32_t *>(data_ + sizeof(HashBucketHeader)); }
+  const char     *entry(int index) const { return data_ + entry_offset(index); }
+
+  int hash_offset(int index) const { return sizeof(HashBucketHeader) + index * sizeof(uint32_t); }
+  int entry_offset(int index) const
+  {
+    return sizeof(HashBucketHeader) + capacity_ * sizeof(uint32_t) + index * entry_length_;
+  }
+
+  /// 从 start 开始查找下一个哈希值相同的条目，没有时返回 size()
+  int find_hash(uint32_t hash_value, int start) const
+  {
+    const uint32_t *page_hashes = hashes();
+    const int       page_size   = size();
+    for (int i = start; i < page_size; i++) {
+      if (page_hashes[i] == hash_value) {
+        return i;
+      }
+    }
+    return page_size;
+  }
+
+private:
+  Frame *frame_;
+  char  *data_;
+  int    capacity_;
+  int    entry_length_;
+};
+
+}  // namespace
+
+string HashIndexFileHeader::to_string() const
+{
+  stringstream ss;
+  ss << "attr_length:" << attr_length << ",entry_length:" << entry_length
+     << ",attr_type:" << attr_type_to_string(attr_type) << ",bucket_capacity:" << bucket_capacity
+     << ",level:" << level << ",next_split:" << next_split << ",bucket_count:" << bucket_count
+     << ",directory_page_count:" << directory_page_count << ",entry_count:" << entry_count;
+  return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+HashIndexHandler::~HashIndexHandler() { close(); }
+
+RC HashIndexHandler::create(
+    LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name, AttrType attr_type, int attr_length)
+{
+  RC rc = bpm.create_file(file_name);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to create file. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  DiskBufferPool *bp = nullptr;
+
+  rc = bpm.open_file(log_handler, file_name, bp);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to open file. file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  rc = this->create(log_handler, *bp, attr_type, attr_length);
+  if (OB_FAIL(rc)) {
+    bpm.close_file(file_name);
+    return rc;
+  }
+
+  LOG_INFO("Successfully create hash index file %s.", file_name);
+  return rc;
+}
+
+RC HashIndexHandler::create(LogHandler &log_handler, DiskBufferPool &buffer_pool, AttrType attr_type, int attr_length)
+{
+  const int entry_length    = attr_length + static_cast<int>(sizeof(RID));
+  const int bucket_capacity = static_cast<int>(
+      (BP_PAGE_DATA_SIZE - sizeof(HashBucketHeader)) / (sizeof(uint32_t) + entry_length));
+  if (attr_length <= 0 || bucket_capacity < 2) {
+    LOG_WARN("invalid attr length for hash index. attr length=%d", attr_length);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Frame *header_frame = nullptr;
+  RC     rc           = buffer_pool.allocate_page(&header_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate header page for hash index. rc=%s", strrc(rc));
+    return rc;
+  }
+  DEFER(buffer_pool.unpin_page(header_frame));
+
+  if (header_frame->page_num() != HEADER_PAGE_NUM) {
+    LOG_WARN("header page num should be %d but got %d. is it a new file", HEADER_PAGE_NUM, header_frame->page_num());
+    return RC::INTERNAL;
+  }
+
+  Frame *directory_frame = nullptr;
+  rc                     = buffer_pool.allocate_page(&directory_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate directory page for hash index. rc=%s", strrc(rc));
+    return rc;
+  }
+  DEFER(buffer_pool.unpin_page(directory_frame));
+
+  auto directory = reinterpret_cast<PageNum *>(directory_frame->data());
+  for (int i = 0; i < INITIAL_BUCKET_COUNT; i++) {
+    Frame *bucket_frame = nullptr;
+    rc                  = buffer_pool.allocate_page(&bucket_frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate bucket page for hash index. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    auto bucket_header           = reinterpret_cast<HashBucketHeader *>(bucket_frame->data());
+    bucket_header->size          = 0;
+    bucket_header->overflow_page = BP_INVALID_PAGE_NUM;
+    bucket_frame->mark_dirty();
+    directory[i] = bucket_frame->page_num();
+    buffer_pool.unpin_page(bucket_frame);
+  }
+  directory_frame->mark_dirty();
+
+  auto header                  = reinterpret_cast<HashIndexFileHeader *>(header_frame->data());
+  header->attr_length          = attr_length;
+  header->entry_length         = entry_length;
+  header->attr_type            = attr_type;
+  header->bucket_capacity      = bucket_capacity;
+  header->level                = 0;
+  header->next_split           = 0;
+  header->bucket_count         = INITIAL_BUCKET_COUNT;
+  header->directory_page_count = 1;
+  header->entry_count          = 0;
+  header->directory_pages[0]   = directory_frame->page_num();
+  header_frame->mark_dirty();
+
+  log_handler_      = &log_handler;
+  disk_buffer_pool_ = &buffer_pool;
+
+  // 与B+树相同，新文件的元数据页面不记录日志，直接刷到磁盘。之后的修改都记录日志
+  rc = buffer_pool.flush_all_pages();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sync hash index header. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  memcpy(&file_header_, header, sizeof(file_header_));
+  directory_pages_.assign(1, directory_frame->page_num());
+  bucket_pages_.assign(directory, directory + INITIAL_BUCKET_COUNT);
+  entry_count_.store(0);
+  loaded_.store(true);
+
+  LOG_INFO("Successfully create hash index. header=%s", file_header_.to_string().c_str());
+  return RC::SUCCESS;
+}
+
+RC HashIndexHandler::open(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_WARN("%s has been opened before index.open.", file_name);
+    return RC::RECORD_OPENNED;
+  }
+
+  DiskBufferPool *disk_buffer_pool = nullptr;
+
+  RC rc = bpm.open_file(log_handler, file_name, disk_buffer_pool);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to open file name=%s, rc=%d:%s", file_name, rc, strrc(rc));
+    return rc;
+  }
+
+  rc = this->open(log_handler, *disk_buffer_pool);
+  if (OB_SUCC(rc)) {
+    LOG_INFO("open hash index success. filename=%s", file_name);
+  }
+  return rc;
+}
+
+RC HashIndexHandler::open(LogHandler &log_handler, DiskBufferPool &buffer_pool)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_WARN("hash index has been opened before index.open.");
+    return RC::RECORD_OPENNED;
+  }
+
+  // 键值的类型和长度不会再变化，可以先读出来
+  Frame *frame = nullptr;
+  RC     rc    = buffer_pool.get_this_page(HEADER_PAGE_NUM, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to get header page, rc=%s", strrc(rc));
+    return rc;
+  }
+  memcpy(&file_header_, frame->data(), sizeof(file_header_));
+  buffer_pool.unpin_page(frame);
+
+  log_handler_      = &log_handler;
+  disk_buffer_pool_ = &buffer_pool;
+  loaded_.store(false);
+  return RC::SUCCESS;
+}
+
+RC HashIndexHandler::close()
+{
+  if (disk_buffer_pool_ != nullptr) {
+    disk_buffer_pool_->close_file();
+  }
+
+  disk_buffer_pool_ = nullptr;
+  log_handler_      = nullptr;
+  directory_pages_.clear();
+  bucket_pages_.clear();
+  loaded_.store(false);
+  return RC::SUCCESS;
+}
+
+RC HashIndexHandler::sync()
+{
+  if (loaded_.load()) {
+    lock_.lock();
+    DEFER(lock_.unlock());
+
+    // 条目数量变化太频繁，不记录日志，只在这里写回
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(HEADER_PAGE_NUM, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get header page of hash index. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    file_header_.entry_count = entry_count_.load();
+    frame->write_latch();
+    reinterpret_cast<HashIndexFileHeader *>(frame->data())->entry_count = file_header_.entry_count;
+    frame->mark_dirty();
+    frame->write_unlatch();
+    disk_buffer_pool_->unpin_page(frame);
+  }
+  return disk_buffer_pool_->flush_all_pages();
+}
+
+RC HashIndexHandler::load_directory()
+{
+  Frame *header_frame = nullptr;
+  RC     rc           = disk_buffer_pool_->get_this_page(HEADER_PAGE_NUM, &header_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get header page of hash index. rc=%s", strrc(rc));
+    return rc;
+  }
+  DEFER(disk_buffer_pool_->unpin_page(header_frame));
+
+  auto header = reinterpret_cast<const HashIndexFileHeader *>(header_frame->data());
+  memcpy(&file_header_, header, sizeof(file_header_));
+  directory_pages_.assign(header->directory_pages, header->directory_pages + header->directory_page_count);
+
+  bucket_pages_.resize(file_header_.bucket_count);
+  for (int i = 0; i < file_header_.directory_page_count; i++) {
+    Frame *frame = nullptr;
+    rc           = disk_buffer_pool_->get_this_page(directory_pages_[i], &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get directory page of hash index. page num=%d, rc=%s", directory_pages_[i], strrc(rc));
+      return rc;
+    }
+
+    const int first = i * DIRECTORY_PAGE_CAPACITY;
+    const int count = std::min(DIRECTORY_PAGE_CAPACITY, file_header_.bucket_count - first);
+    auto      pages = reinterpret_cast<const PageNum *>(frame->data());
+    std::copy(pages, pages + count, bucket_pages_.begin() + first);
+    disk_buffer_pool_->unpin_page(frame);
+  }
+
+  entry_count_.store(file_header_.entry_count);
+  LOG_INFO("hash index directory loaded. header=%s", file_header_.to_string().c_str());
+  return RC::SUCCESS;
+}
+
+RC HashIndexHandler::prepare()
+{
+  if (disk_buffer_pool_ == nullptr) {
+    return RC::FILE_NOT_OPENED;
+  }
+
+  if (loaded_.load(std::memory_order_acquire)) {
+    return RC::SUCCESS;
+  }
+
+  lock_.lock();
+  DEFER(lock_.unlock());
+  RC rc = RC::SUCCESS;
+  if (!loaded_.load()) {
+    rc = load_directory();
+    if (OB_SUCC(rc)) {
+      loaded_.store(true, std::memory_order_release);
+    }
+  }
+  return rc;
+}
+
+uint32_t HashIndexHandler::hash(const char *key) const
+{
+  int   length = file_header_.attr_length;
+  float float_value;
+  if (file_header_.attr_type == AttrType::CHARS) {
+    length = static_cast<int>(strnlen(key, length));
+  } else if (file_header_.attr_type == AttrType::FLOATS) {
+    memcpy(&float_value, key, sizeof(float_value));
+    if (float_value == 0) {
+      float_value = 0;  // -0.0 与 0.0 相等
+      key         = reinterpret_cast<const char *>(&float_value);
+    }
+  }
+
+  // FNV-1a，再做一次 murmur3 的 fmix64 让低位分布更均匀，桶的地址使用的是低位
+  uint64_t h = 14695981039346656037ULL;
+  for (int i = 0; i < length; i++) {
+    h ^= static_cast<uint8_t>(key[i]);
+    h *= 1099511628211ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<uint32_t>(h);
+}
+
+bool HashIndexHandler::key_equal(const char *key1, const char *key2) const
+{
+  switch (file_header_.attr_type) {
+    case AttrType::CHARS: return 0 == strncmp(key1, key2, file_header_.attr_length);
+    case AttrType::FLOATS: {
+      float v1, v2;
+      memcpy(&v1, key1, sizeof(v1));
+      memcpy(&v2, key2, sizeof(v2));
+      return v1 == v2;
+    }
+    default: return 0 == memcmp(key1, key2, file_header_.attr_length);
+  }
+}
+
+int HashIndexHandler::bucket_index(uint32_t hash_value) const
+{
+  const uint32_t round_buckets = static_cast<uint32_t>(INITIAL_BUCKET_COUNT) << file_header_.level;
+  uint32_t       index         = hash_value & (round_buckets - 1);
+  if (index < static_cast<uint32_t>(file_header_.next_split)) {
+    index = hash_value & ((round_buckets << 1) - 1);
+  }
+  return static_cast<int>(index);
+}
+
+int HashIndexHandler::max_bucket_count() const
+{
+  const int max_directory_pages =
+      static_cast<int>((BP_PAGE_DATA_SIZE - sizeof(HashIndexFileHeader)) / sizeof(PageNum));
+  return max_directory_pages * DIRECTORY_PAGE_CAPACITY;
+}
+
+bool HashIndexHandler::need_split() const
+{
+  return entry_count_.load() > file_header_.bucket_count * file_header_.bucket_capacity * MAX_LOAD_FACTOR &&
+         file_header_.bucket_count < max_bucket_count();
+}
+
+RC HashIndexHandler::insert_entry(const char *user_key, const RID *rid)
+{
+  RC rc = prepare();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const uint32_t hash_value = hash(user_key);
+  {
+    lock_.lock_shared();
+    DEFER(lock_.unlock_shared());
+
+    Frame *primary_frame = nullptr;
+    rc                   = disk_buffer_pool_->get_this_page(bucket_pages_[bucket_index(hash_value)], &primary_frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get bucket page. rc=%s", strrc(rc));
+      return rc;
+    }
+    primary_frame->write_latch();
+
+    // 释放页面要在日志提交之后
+    vector<Frame *> frames{primary_frame};
+    DEFER(primary_frame->write_unlatch(); for (Frame *frame : frames) { disk_buffer_pool_->unpin_page(frame); });
+
+    HashIndexLogger logger(*log_handler_, disk_buffer_pool_->id());
+    Frame          *target_frame = nullptr;
+    for (Frame *frame = primary_frame; frame != nullptr;) {
+      BucketPage page(frame, file_header_);
+      for (int i = page.find_hash(hash_value, 0); i < page.size(); i = page.find_hash(hash_value, i + 1)) {
+        const char *entry = page.entry(i);
+        if (key_equal(entry, user_key) && 0 == memcmp(entry + file_header_.attr_length, rid, sizeof(RID))) {
+          return RC::RECORD_DUPLICATE_KEY;
+        }
+      }
+
+      if (target_frame == nullptr && page.size() < file_header_.bucket_capacity) {
+        target_frame = frame;
+      }
+
+      if (page.overflow_page() == BP_INVALID_PAGE_NUM) {
+        break;
+      }
+
+      Frame *next_frame = nullptr;
+      rc                = disk_buffer_pool_->get_this_page(page.overflow_page(), &next_frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get overflow page. page num=%d, rc=%s", page.overflow_page(), strrc(rc));
+        return rc;
+      }
+      frames.push_back(next_frame);
+      frame = next_frame;
+    }
+
+    if (target_frame == nullptr) {
+      // 所有页面都满了，在链表的最后增加一个溢出页面
+      rc = disk_buffer_pool_->allocate_page(&target_frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to allocate overflow page. rc=%s", strrc(rc));
+        return rc;
+      }
+      frames.push_back(target_frame);
+
+      HashBucketHeader bucket_header{0, BP_INVALID_PAGE_NUM};
+      logger.write(target_frame, 0, &bucket_header, sizeof(bucket_header));
+
+      PageNum overflow_page = target_frame->page_num();
+      logger.write(frames[frames.size() - 2], offsetof(HashBucketHeader, overflow_page), &overflow_page,
+          sizeof(overflow_page));
+    }
+
+    BucketPage page(target_frame, file_header_);
+    const int  index = page.size();
+    vector<char> entry(file_header_.entry_length);
+    memcpy(entry.data(), user_key, file_header_.attr_length);
+    memcpy(entry.data() + file_header_.attr_length, rid, sizeof(RID));
+
+    const int32_t new_size = index + 1;
+    logger.write(target_frame, page.hash_offset(index), &hash_value, sizeof(hash_value));
+    logger.write(target_frame, page.entry_offset(index), entry.data(), file_header_.entry_length);
+    logger.write(target_frame, offsetof(HashBucketHeader, size), &new_size, sizeof(new_size));
+
+    rc = logger.commit();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to commit hash index log. rc=%s", strrc(rc));
+      return rc;
+    }
+    entry_count_++;
+  }
+
+  if (need_split()) {
+    lock_.lock();
+    DEFER(lock_.unlock());
+    if (need_split()) {
+      rc = split_bucket();
+      if (OB_FAIL(rc)) {
+        // 分裂失败不影响已经插入的数据，之后的插入会再次尝试
+        LOG_WARN("failed to split hash bucket. rc=%s", strrc(rc));
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC HashIndexHandler::delete_entry(const char *user_key, const RID *rid)
+{
+  RC rc = prepare();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const uint32_t hash_value = hash(user_key);
+
+  lock_.lock_shared();
+  DEFER(lock_.unlock_shared());
+
+  Frame *primary_frame = nullptr;
+  rc                   = disk_buffer_pool_->get_this_page(bucket_pages_[bucket_index(hash_value)], &primary_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get bucket page. rc=%s", strrc(rc));
+    return rc;
+  }
+  primary_frame->write_latch();
+
+  vector<Frame *> frames{primary_frame};
+  DEFER(primary_frame->write_unlatch(); for (Frame *frame : frames) { disk_buffer_pool_->unpin_page(frame); });
+
+  for (Frame *frame = primary_frame; frame != nullptr;) {
+    BucketPage page(frame, file_header_);
+    for (int i = page.find_hash(hash_value, 0); i < page.size(); i = page.find_hash(hash_value, i + 1)) {
+      const char *entry = page.entry(i);
+      if (!key_equal(entry, user_key) || 0 != memcmp(entry + file_header_.attr_length, rid, sizeof(RID))) {
+        continue;
+      }
+
+      // 用页面中最后一个条目填补空位
+      HashIndexLogger logger(*log_handler_, disk_buffer_pool_->id());
+      const int       last = page.size() - 1;
+      if (i != last) {
+        logger.write(frame, page.hash_offset(i), &page.hashes()[last], sizeof(uint32_t));
+        logger.write(frame, page.entry_offset(i), page.entry(last), file_header_.entry_length);
+      }
+      const int32_t new_size = last;
+      logger.write(frame, offsetof(HashBucketHeader, size), &new_size, sizeof(new_size));
+
+      rc = logger.commit();
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to commit hash index log. rc=%s", strrc(rc));
+        return rc;
+      }
+      entry_count_--;
+      return RC::SUCCESS;
+    }
+
+    if (page.overflow_page() == BP_INVALID_PAGE_NUM) {
+      break;
+    }
+
+    Frame *next_frame = nullptr;
+    rc                = disk_buffer_pool_->get_this_page(page.overflow_page(), &next_frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page num=%d, rc=%s", page.overflow_page(), strrc(rc));
+      return rc;
+    }
+    frames.push_back(next_frame);
+    frame = next_frame;
+  }
+  return RC::RECORD_INVALID_KEY;
+}
+
+RC HashIndexHandler::lookup(const char *key, uint32_t hash_value, int key_index, vector<pair<int, RID>> &entries)
+{
+  Frame *primary_frame = nullptr;
+  RC     rc            = disk_buffer_pool_->get_this_page(bucket_pages_[bucket_index(hash_value)], &primary_frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get bucket page. rc=%s", strrc(rc));
+    return rc;
+  }
+  primary_frame->read_latch();
+  DEFER(primary_frame->read_unlatch(); disk_buffer_pool_->unpin_page(primary_frame));
+
+  Frame *frame = primary_frame;
+  while (true) {
+    BucketPage page(frame, file_header_);
+    for (int i = page.find_hash(hash_value, 0); i < page.size(); i = page.find_hash(hash_value, i + 1)) {
+      const char *entry = page.entry(i);
+      if (key_equal(entry, key)) {
+        RID rid;
+        memcpy(&rid, entry + file_header_.attr_length, sizeof(RID));
+        entries.emplace_back(key_index, rid);
+      }
+    }
+
+    const PageNum overflow_page = page.overflow_page();
+    if (frame != primary_frame) {
+      disk_buffer_pool_->unpin_page(frame);
+    }
+    if (overflow_page == BP_INVALID_PAGE_NUM) {
+      break;
+    }
+
+    rc = disk_buffer_pool_->get_this_page(overflow_page, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page num=%d, rc=%s", overflow_page, strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC HashIndexHandler::get_entry(const char *user_key, vector<RID> &rids)
+{
+  RC rc = prepare();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  lock_.lock_shared();
+  DEFER(lock_.unlock_shared());
+
+  vector<pair<int, RID>> entries;
+  rc = lookup(user_key, hash(user_key), 0, entries);
+  for (auto &entry : entries) {
+    rids.push_back(entry.second);
+  }
+  return rc;
+}
+
+RC HashIndexHandler::get_entries(span<const char *const> user_keys, vector<pair<int, RID>> &entries)
+{
+  RC rc = prepare();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  lock_.lock_shared();
+  DEFER(lock_.unlock_shared());
+
+  for (int i = 0; OB_SUCC(rc) && i < static_cast<int>(user_keys.size()); i++) {
+    rc = lookup(user_keys[i], hash(user_keys[i]), i, entries);
+  }
+  return rc;
+}
+
+RC HashIndexHandler::write_bucket_chain(HashIndexLogger &logger, vector<Frame *> &chain,
+    span<const uint32_t> hashes, const char *entries, vector<Frame *> &pinned_frames)
+{
+  const int capacity   = file_header_.bucket_capacity;
+  const int total      = static_cast<int>(hashes.size());
+  const int page_count = std::max(1, (total + capacity - 1) / capacity);
+
+  // 页面不够时分配新的溢出页面，多余的页面由调用者释放
+  while (static_cast<int>(chain.size()) < page_count) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->allocate_page(&frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate overflow page. rc=%s", strrc(rc));
+      return rc;
+    }
+    pinned_frames.push_back(frame);
+    chain.push_back(frame);
+  }
+
+  for (int i = 0; i < page_count; i++) {
+    BucketPage page(chain[i], file_header_);
+    const int  first = i * capacity;
+    const int  count = std::min(capacity, total - first);
+    if (count > 0) {
+      logger.write(chain[i], page.hash_offset(0), hashes.data() + first, count * sizeof(uint32_t));
+      logger.write(chain[i], page.entry_offset(0), entries + first * file_header_.entry_length,
+          count * file_header_.entry_length);
+    }
+
+    HashBucketHeader bucket_header{count, i + 1 < page_count ? chain[i + 1]->page_num() : BP_INVALID_PAGE_NUM};
+    logger.write(chain[i], 0, &bucket_header, sizeof(bucket_header));
+  }
+  return RC::SUCCESS;
+}
+
+RC HashIndexHandler::split_bucket()
+{
+  const int old_index = file_header_.next_split;
+  const int new_index = file_header_.bucket_count;
+
+  vector<PageNum> free_pages;  // 分裂后不再使用的溢出页面，日志提交之后再释放
+  {
+    vector<Frame *> pinned_frames;
+    DEFER(for (Frame *frame : pinned_frames) { disk_buffer_pool_->unpin_page(frame); });
+
+    HashIndexLogger logger(*log_handler_, disk_buffer_pool_->id());
+
+    Frame *header_frame = nullptr;
+    RC     rc           = disk_buffer_pool_->get_this_page(HEADER_PAGE_NUM, &header_frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get header page of hash index. rc=%s", strrc(rc));
+      return rc;
+    }
+    pinned_frames.push_back(header_frame);
+
+    // 新桶的目录项可能在一个新的目录页中
+    HashIndexFileHeader new_header      = file_header_;
+    vector<PageNum>     directory_pages = directory_pages_;
+    const int           directory_index = new_index / DIRECTORY_PAGE_CAPACITY;
+    Frame              *directory_frame = nullptr;
+    if (directory_index == static_cast<int>(directory_pages.size())) {
+      rc = disk_buffer_pool_->allocate_page(&directory_frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to allocate directory page. rc=%s", strrc(rc));
+        return rc;
+      }
+      pinned_frames.push_back(directory_frame);
+
+      const PageNum directory_page = directory_frame->page_num();
+      directory_pages.push_back(directory_page);
+      new_header.directory_page_count++;
+      logger.write(header_frame,
+          offsetof(HashIndexFileHeader, directory_pages) + directory_index * sizeof(PageNum),
+          &directory_page,
+          sizeof(directory_page));
+    } else {
+      rc = disk_buffer_pool_->get_this_page(directory_pages[directory_index], &directory_frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get directory page. page num=%d, rc=%s", directory_pages[directory_index], strrc(rc));
+        return rc;
+      }
+      pinned_frames.push_back(directory_frame);
+    }
+
+    // 读出旧桶中的所有条目，按照多一位的哈希值分成两部分
+    vector<Frame *> old_chain;
+    for (PageNum page_num = bucket_pages_[old_index]; page_num != BP_INVALID_PAGE_NUM;) {
+      Frame *frame = nullptr;
+      rc           = disk_buffer_pool_->get_this_page(page_num, &frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get bucket page. page num=%d, rc=%s", page_num, strrc(rc));
+        return rc;
+      }
+      pinned_frames.push_back(frame);
+      old_chain.push_back(frame);
+      page_num = BucketPage(frame, file_header_).overflow_page();
+    }
+
+    const uint32_t   split_mask = (static_cast<uint32_t>(INITIAL_BUCKET_COUNT) << (file_header_.level + 1)) - 1;
+    const int        entry_length = file_header_.entry_length;
+    vector<uint32_t> stay_hashes, move_hashes;
+    vector<char>     stay_entries, move_entries;
+    for (Frame *frame : old_chain) {
+      BucketPage page(frame, file_header_);
+      for (int i = 0; i < page.size(); i++) {
+        const uint32_t hash_value = page.hashes()[i];
+        const char    *entry      = page.entry(i);
+        if ((hash_value & split_mask) == static_cast<uint32_t>(old_index)) {
+          stay_hashes.push_back(hash_value);
+          stay_entries.insert(stay_entries.end(), entry, entry + entry_length);
+        } else {
+          move_hashes.push_back(hash_value);
+          move_entries.insert(move_entries.end(), entry, entry + entry_length);
+        }
+      }
+    }
+
+    vector<Frame *> new_chain;
+    rc = write_bucket_chain(logger, new_chain, move_hashes, move_entries.data(), pinned_frames);
+    if (OB_SUCC(rc)) {
+      rc = write_bucket_chain(logger, old_chain, stay_hashes, stay_entries.data(), pinned_frames);
+    }
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    const int used_pages = std::max<int>(1, (stay_hashes.size() + file_header_.bucket_capacity - 1) /
+                                                file_header_.bucket_capacity);
+    for (int i = used_pages; i < static_cast<int>(old_chain.size()); i++) {
+      free_pages.push_back(old_chain[i]->page_num());
+    }
+
+    const PageNum new_bucket_page = new_chain[0]->page_num();
+    logger.write(directory_frame,
+        (new_index % DIRECTORY_PAGE_CAPACITY) * sizeof(PageNum),
+        &new_bucket_page,
+        sizeof(new_bucket_page));
+
+    new_header.bucket_count++;
+    new_header.next_split++;
+    if (new_header.next_split == (INITIAL_BUCKET_COUNT << new_header.level)) {
+      new_header.level++;
+      new_header.next_split = 0;
+    }
+    new_header.entry_count = entry_count_.load();
+    logger.write(header_frame, 0, &new_header, sizeof(new_header));
+
+    rc = logger.commit();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to commit hash index log. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    file_header_ = new_header;
+    directory_pages_.swap(directory_pages);
+    bucket_pages_.push_back(new_bucket_page);
+  }
+
+  for (PageNum page_num : free_pages) {
+    RC rc = disk_buffer_pool_->dispose_page(page_num);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to dispose overflow page. page num=%d, rc=%s", page_num, strrc(rc));
+    }
+  }
+
+  LOG_DEBUG("hash bucket split. old bucket=%d, new bucket=%d, header=%s",
+      old_index, new_index, file_header_.to_string().c_str());
+  return RC::SUCCESS;
+}
@@ -0,0 +1,176 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/rc.h"
+#include "common/types.h"
+#include "common/lang/atomic.h"
+#include "common/lang/mutex.h"
+#include "common/lang/span.h"
+#include "common/lang/string.h"
+#include "common/lang/utility.h"
+#include "common/lang/vector.h"
+#include "common/type/attr_type.h"
+#include "storage/record/record.h"
+
+class LogHandler;
+class BufferPoolManager;
+class DiskBufferPool;
+class Frame;
+class HashIndexLogger;
+
+/**
+ * @brief 哈希索引文件的头页
+ * @ingroup Index
+ * @details 头页后面记录了目录页的编号，目录页中按照桶的编号依次记录每个桶的第一个页面编号。
+ * 条目数量只在分裂桶和同步时写回头页，异常重启后可能不准确，它只用来决定什么时候分裂。
+ */
+struct HashIndexFileHeader
+{
+  int32_t  attr_length;           ///< 键值的长度
+  int32_t  entry_length;          ///< 条目的长度，即键值加上RID
+  AttrType attr_type;             ///< 键值的类型
+  int32_t  bucket_capacity;       ///< 每个桶页面能存放的条目数
+  int32_t  level;                 ///< 当前轮次，桶的个数从 INITIAL_BUCKET_COUNT << level 开始翻倍
+  int32_t  next_split;            ///< 下一个要分裂的桶
+  int32_t  bucket_count;          ///< 桶的个数
+  int32_t  directory_page_count;  ///< 目录页的个数
+  int64_t  entry_count;           ///< 条目的个数
+  PageNum  directory_pages[0];    ///< 目录页的编号
+
+  string to_string() const;
+};
+
+/**
+ * @brief 哈希桶页面的头部
+ * @ingroup Index
+ * @details 头部后面先是所有条目的哈希值，然后才是条目本身。查找时先顺序比较连续存放的哈希值，
+ * 只有哈希值相同才比较键值。桶满了以后通过 overflow_page 链接溢出页面，溢出页面的格式相同。
+ */
+struct HashBucketHeader
+{
+  int32_t size;           ///< 页面中条目的个数
+  PageNum overflow_page;  ///< 下一个溢出页面，没有时是 BP_INVALID_PAGE_NUM
+};
+
+/**
+ * @brief 线性哈希实现的哈希索引
+ * @ingroup Index
+ * @details 桶的个数从 INITIAL_BUCKET_COUNT 开始，条目数超过装载因子后按顺序分裂一个桶，
+ * 每次只需要重新分布一个桶的数据，不会因为扩容导致某次插入特别慢。
+ * 第 i 个桶的地址是 hash & (INITIAL_BUCKET_COUNT << level) - 1，如果小于 next_split，说明这个桶在本轮已经分裂过，
+ * 需要再多用一位哈希值。
+ *
+ * 并发控制：查找、插入和删除持有共享锁，桶的主页面上的页面锁保护整个溢出链；分裂需要修改目录，持有排它锁。
+ * 所有的修改都通过 HashIndexLogger 记录物理日志。
+ *
+ * 哈希值在不同的进程之间要保持一致，所以没有使用 std::hash。字符串按照C字符串比较，浮点数按照二进制比较，
+ * 因此浮点数的等值查找不像B+树那样允许误差。
+ */
+class HashIndexHandler
+{
+public:
+  HashIndexHandler() = default;
+  ~HashIndexHandler();
+
+  /**
+   * @brief 创建一个新的哈希索引文件
+   * @param log_handler 记录日志
+   * @param bpm 缓冲池管理器
+   * @param file_name 文件名
+   * @param attr_type 键值的类型
+   * @param attr_length 键值的长度
+   */
+  RC create(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name, AttrType attr_type,
+      int attr_length);
+  RC create(LogHandler &log_handler, DiskBufferPool &buffer_pool, AttrType attr_type, int attr_length);
+
+  /**
+   * @brief 打开一个已经存在的哈希索引文件
+   * @details 目录在第一次访问时才加载到内存中，因为打开表的时候还没有重做日志，这时目录可能不是最新的
+   */
+  RC open(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name);
+  RC open(LogHandler &log_handler, DiskBufferPool &buffer_pool);
+
+  RC close();
+
+  /**
+   * @brief 将头页写回并刷新所有页面
+   */
+  RC sync();
+
+  /**
+   * @brief 插入一个条目
+   * @details 键值和RID完全相同的条目已经存在时返回 RECORD_DUPLICATE_KEY
+   */
+  RC insert_entry(const char *user_key, const RID *rid);
+
+  /**
+   * @brief 删除一个条目
+   * @details 条目不存在时返回 RECORD_INVALID_KEY
+   */
+  RC delete_entry(const char *user_key, const RID *rid);
+
+  /**
+   * @brief 查找某个键值对应的所有条目
+   */
+  RC get_entry(const char *user_key, vector<RID> &rids);
+
+  /**
+   * @brief 批量查找多个键值，只加一次锁
+   * @param[out] entries first是键值在user_keys中的下标，second是记录的位置
+   */
+  RC get_entries(span<const char *const> user_keys, vector<pair<int, RID>> &entries);
+
+  const HashIndexFileHeader &file_header() const { return file_header_; }
+
+  int64_t entry_count() const { return entry_count_.load(); }
+
+  DiskBufferPool &buffer_pool() const { return *disk_buffer_pool_; }
+
+public:
+  static constexpr PageNum HEADER_PAGE_NUM      = 1;     ///< 头页的编号
+  static constexpr int     INITIAL_BUCKET_COUNT = 4;     ///< 初始桶的个数
+  static constexpr double  MAX_LOAD_FACTOR      = 0.75;  ///< 平均每个桶页面的条目数超过这个比例时分裂
+
+private:
+  uint32_t hash(const char *key) const;
+  bool     key_equal(const char *key1, const char *key2) const;
+  int      bucket_index(uint32_t hash_value) const;
+  int      max_bucket_count() const;
+
+  RC load_directory();
+  RC prepare();
+  RC lookup(const char *key, uint32_t hash_value, int key_index, vector<pair<int, RID>> &entries);
+
+  /**
+   * @brief 将一个桶分裂成两个
+   * @details 调用者需要持有排它锁
+   */
+  RC split_bucket();
+  RC write_bucket_chain(HashIndexLogger &logger, vector<Frame *> &chain, span<const uint32_t> hashes,
+      const char *entries, vector<Frame *> &pinned_frames);
+  bool need_split() const;
+
+private:
+  LogHandler     *log_handler_      = nullptr;
+  DiskBufferPool *disk_buffer_pool_ = nullptr;
+
+  HashIndexFileHeader file_header_;
+  vector<PageNum>     directory_pages_;  ///< 目录页的编号
+  vector<PageNum>     bucket_pages_;     ///< 每个桶第一个页面的编号
+  atomic<int64_t>     entry_count_{0};
+  atomic<bool>        loaded_{false};  ///< 目录是否已经加载到内存中
+
+  common::SharedMutex lock_;
+};
@@ -0,0 +1,163 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/index/hash_index_log.h"
+#include "common/log/log.h"
+#include "common/lang/sstream.h"
+#include "common/lang/unordered_map.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/frame.h"
+#include "storage/clog/log_entry.h"
+#include "storage/clog/log_handler.h"
+
+const int32_t HashIndexLogHeader::SIZE = sizeof(HashIndexLogHeader);
+const int32_t HashIndexLogWrite::SIZE  = sizeof(HashIndexLogWrite);
+
+string HashIndexLogHeader::to_string() const
+{
+  stringstream ss;
+  ss << "buffer_pool_id:" << buffer_pool_id << ", write_count:" << write_count;
+  return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+HashIndexLogger::HashIndexLogger(LogHandler &log_handler, int32_t buffer_pool_id)
+    : log_handler_(log_handler), buffer_pool_id_(buffer_pool_id)
+{}
+
+void HashIndexLogger::write(Frame *frame, int offset, const void *data, int length)
+{
+  const size_t pos = buffer_.size();
+  buffer_.resize(pos + HashIndexLogWrite::SIZE + length);
+
+  auto log_write      = reinterpret_cast<HashIndexLogWrite *>(buffer_.data() + pos);
+  log_write->page_num = frame->page_num();
+  log_write->offset   = offset;
+  log_write->length   = length;
+  memcpy(log_write->data, data, length);
+  write_count_++;
+
+  // data 可能指向页面自己的数据，比如在页面内部移动条目，所以从日志中复制
+  memcpy(frame->data() + offset, log_write->data, length);
+  frame->mark_dirty();
+
+  if (frames_.empty() || frames_.back() != frame) {
+    frames_.push_back(frame);
+  }
+}
+
+RC HashIndexLogger::commit()
+{
+  if (write_count_ == 0) {
+    return RC::SUCCESS;
+  }
+
+  vector<char> payload(HashIndexLogHeader::SIZE + buffer_.size());
+  auto header            = reinterpret_cast<HashIndexLogHeader *>(payload.data());
+  header->buffer_pool_id = buffer_pool_id_;
+  header->write_count    = write_count_;
+  memcpy(payload.data() + HashIndexLogHeader::SIZE, buffer_.data(), buffer_.size());
+
+  LSN lsn = 0;
+  RC  rc  = log_handler_.append(lsn, LogModule::Id::HASH_INDEX, std::move(payload));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to append hash index log. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (lsn > 0) {
+    for (Frame *frame : frames_) {
+      frame->set_lsn(lsn);
+    }
+  }
+
+  write_count_ = 0;
+  buffer_.clear();
+  frames_.clear();
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+HashIndexLogReplayer::HashIndexLogReplayer(BufferPoolManager &bpm) : bpm_(bpm) {}
+
+RC HashIndexLogReplayer::replay(const LogEntry &entry)
+{
+  LOG_TRACE("replaying hash index log: %s", entry.to_string().c_str());
+
+  if (entry.module().id() != LogModule::Id::HASH_INDEX) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (entry.payload_size() < HashIndexLogHeader::SIZE) {
+    LOG_WARN("invalid log entry. payload size: %d is less than hash index log header size %d",
+             entry.payload_size(), HashIndexLogHeader::SIZE);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  auto header = reinterpret_cast<const HashIndexLogHeader *>(entry.data());
+
+  DiskBufferPool *buffer_pool = nullptr;
+  RC              rc          = bpm_.get_buffer_pool(header->buffer_pool_id, buffer_pool);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("fail to get buffer pool. buffer pool id=%d, rc=%s", header->buffer_pool_id, strrc(rc));
+    return rc;
+  }
+
+  // 同一个页面可能被修改多次，以第一次访问时页面的LSN为准判断是否需要重做
+  unordered_map<PageNum, Frame *> redo_frames;
+  vector<Frame *>                 pinned_frames;
+
+  const char *pos = entry.data() + HashIndexLogHeader::SIZE;
+  const char *end = entry.data() + entry.payload_size();
+  for (int i = 0; OB_SUCC(rc) && i < header->write_count; i++) {
+    auto log_write = reinterpret_cast<const HashIndexLogWrite *>(pos);
+    if (pos + HashIndexLogWrite::SIZE > end || pos + HashIndexLogWrite::SIZE + log_write->length > end ||
+        log_write->offset < 0 || log_write->offset + log_write->length > BP_PAGE_DATA_SIZE) {
+      LOG_WARN("invalid hash index log. header=%s, index=%d", header->to_string().c_str(), i);
+      rc = RC::INVALID_ARGUMENT;
+      break;
+    }
+    pos += HashIndexLogWrite::SIZE + log_write->length;
+
+    auto iter = redo_frames.find(log_write->page_num);
+    if (iter == redo_frames.end()) {
+      Frame *frame = nullptr;
+      rc           = buffer_pool->get_this_page(log_write->page_num, &frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("fail to get this page. page num=%d, rc=%s", log_write->page_num, strrc(rc));
+        break;
+      }
+      pinned_frames.push_back(frame);
+
+      if (frame->lsn() >= entry.lsn()) {
+        LOG_TRACE("page %d has been written, skip replaying. frame lsn %ld, log lsn %ld",
+                  log_write->page_num, frame->lsn(), entry.lsn());
+        frame = nullptr;
+      }
+      iter = redo_frames.emplace(log_write->page_num, frame).first;
+    }
+
+    Frame *frame = iter->second;
+    if (frame != nullptr) {
+      memcpy(frame->data() + log_write->offset, log_write->data, log_write->length);
+      frame->mark_dirty();
+    }
+  }
+
+  for (auto &[page_num, frame] : redo_frames) {
+    if (OB_SUCC(rc) && frame != nullptr) {
+      frame->set_lsn(entry.lsn());
+    }
+  }
+  for (Frame *frame : pinned_frames) {
+    buffer_pool->unpin_page(frame);
+  }
+  return rc;
+}
@@ -0,0 +1,107 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/types.h"
+#include "common/rc.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "storage/clog/log_replayer.h"
+
+class LogHandler;
+class Frame;
+class BufferPoolManager;
+
+/**
+ * @brief 哈希索引日志的头部
+ * @ingroup CLog
+ * @details 一条日志包含一次操作对若干个页面的修改，头部后面紧跟着 write_count 个 HashIndexLogWrite
+ */
+struct HashIndexLogHeader
+{
+  int32_t buffer_pool_id;  ///< 索引文件对应的缓冲池
+  int32_t write_count;     ///< 修改的次数
+
+  string to_string() const;
+
+  static const int32_t SIZE;
+};
+
+/**
+ * @brief 对某个页面的一次修改，即从 offset 开始写入 length 字节的数据
+ * @ingroup CLog
+ */
+struct HashIndexLogWrite
+{
+  PageNum page_num;
+  int32_t offset;
+  int32_t length;
+  char    data[0];
+
+  static const int32_t SIZE;
+};
+
+/**
+ * @brief 哈希索引的日志记录器
+ * @ingroup CLog
+ * @details 哈希索引的修改都很简单，就是在桶页面中写入、覆盖一段数据，或者修改文件头和目录页面，
+ * 因此直接记录物理日志，重做时也不需要打开索引。
+ * 一次插入、删除或分裂桶的所有修改先记录在内存中，操作完成后调用 commit 生成一条日志，
+ * 这样一次分裂涉及的多个页面要么都能重做，要么都不重做。
+ * 调用者负责对页面加锁，并且在 commit 之前不能释放页面，防止页面在日志落地之前被刷到磁盘。
+ */
+class HashIndexLogger final
+{
+public:
+  HashIndexLogger(LogHandler &log_handler, int32_t buffer_pool_id);
+  ~HashIndexLogger() = default;
+
+  /**
+   * @brief 修改页面的内容并记录日志
+   * @param frame 页帧
+   * @param offset 在页面数据中的偏移量
+   * @param data 写入的数据
+   * @param length 数据的长度
+   */
+  void write(Frame *frame, int offset, const void *data, int length);
+
+  /**
+   * @brief 将记录的修改生成一条日志，并更新相关页面的LSN
+   */
+  RC commit();
+
+private:
+  LogHandler     &log_handler_;
+  int32_t         buffer_pool_id_ = -1;
+  int32_t         write_count_    = 0;
+  vector<char>    buffer_;  ///< 不包含日志头的修改记录
+  vector<Frame *> frames_;  ///< 修改过的页面，提交后设置LSN
+};
+
+/**
+ * @brief 哈希索引的日志重放器
+ * @ingroup CLog
+ * @details 只重做页面LSN比日志LSN小的页面
+ */
+class HashIndexLogReplayer final : public LogReplayer
+{
+public:
+  HashIndexLogReplayer(BufferPoolManager &bpm);
+  virtual ~HashIndexLogReplayer() = default;
+
+  //! @copydoc LogReplayer::replay
+  RC replay(const LogEntry &entry) override;
+
+private:
+  BufferPoolManager &bpm_;
+};
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/index/index.h"
+#include "common/log/log.h"
 
 /**
  * 初始化索引对象
@@ -30,3 +31,92 @@ RC Index::init(const IndexMeta &index_meta, const FieldMeta &field_meta)
   field_meta_ = field_meta;
   return RC::SUCCESS;
 }
+
+RC Index::fix_key_length(span<const char *const> keys, int key_len, vector<char> &fixed_keys,
+    vector<const char *> &fixed_key_ptrs, vector<int> &key_indexes) const
+{
+  const int attr_length = field_meta_.len();
+  if (field_meta_.type() != AttrType::CHARS) {
+    LOG_WARN("invalid key length. index=%s, key len=%d, attr len=%d", index_meta_.name(), key_len, attr_length);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  fixed_keys.assign(keys.size() * attr_length, 0);
+  for (int i = 0; i < static_cast<int>(keys.size()); i++) {
+    const int len = static_cast<int>(strnlen(keys[i], key_len));
+    if (len > attr_length) {
+      continue;
+    }
+
+    char *fixed_key = fixed_keys.data() + key_indexes.size() * attr_length;
+    memcpy(fixed_key, keys[i], len);
+    fixed_key_ptrs.push_back(fixed_key);
+    key_indexes.push_back(i);
+  }
+  return RC::SUCCESS;
+}
+
+RC Index::get_entries(span<const char *const> keys, int key_len, vector<pair<int, RID>> &entries)
+{
+  for (int i = 0; i < static_cast<int>(keys.size()); i++) {
+    IndexScanner *scanner = create_scanner(keys[i], key_len, true /*left_inclusive*/, keys[i], key_len, true);
+    if (nullptr == scanner) {
+      LOG_WARN("failed to create index scanner. index=%s", index_meta_.name());
+      return RC::INTERNAL;
+    }
+
+    RC  rc = RC::SUCCESS;
+    RID rid;
+    while (OB_SUCC(rc = scanner->next_entry(&rid))) {
+      entries.emplace_back(i, rid);
+    }
+    scanner->destroy();
+
+    if (rc != RC::RECORD_EOF) {
+      LOG_WARN("failed to scan index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC Index::probe(const Column &keys, vector<pair<int, RID>> &entries)
+{
+  if (keys.attr_type() != field_meta_.type()) {
+    LOG_WARN("key column type mismatch. index=%s, column type=%s, field type=%s",
+        index_meta_.name(), attr_type_to_string(keys.attr_type()), attr_type_to_string(field_meta_.type()));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  vector<const char *> key_ptrs(keys.count());
+  for (int i = 0; i < keys.count(); i++) {
+    key_ptrs[i] = keys.data() + i * keys.attr_len();
+  }
+  return get_entries(key_ptrs, keys.attr_len(), entries);
+}
+
+IndexScanner *Index::create_multi_key_scanner(span<const char *const> keys, int key_len)
+{
+  vector<pair<int, RID>> entries;
+  RC                     rc = get_entries(keys, key_len, entries);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get entries. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return nullptr;
+  }
+  return new MultiKeyIndexScanner(std::move(entries));
+}
+
+RC MultiKeyIndexScanner::next_entry(RID *rid)
+{
+  if (position_ >= entries_.size()) {
+    return RC::RECORD_EOF;
+  }
+  *rid = entries_[position_++].second;
+  return RC::SUCCESS;
+}
+
+RC MultiKeyIndexScanner::destroy()
+{
+  delete this;
+  return RC::SUCCESS;
+}
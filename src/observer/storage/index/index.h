@@ -18,6 +18,10 @@ See the Mulan PSL v2 for more details. */
 #include <vector>
 
 #include "common/rc.h"
+#include "common/lang/span.h"
+#include "common/lang/utility.h"
+#include "common/lang/vector.h"
+#include "storage/common/column.h"
 #include "storage/field/field_meta.h"
 #include "storage/index/index_meta.h"
 #include "storage/record/record_manager.h"
@@ -74,6 +78,28 @@ public:
   virtual IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
       int right_len, bool right_inclusive) = 0;
 
+  /**
+   * @brief 批量查找多个键值
+   * @details 默认实现是每个键值创建一个扫描器做等值查找。有序的索引可以一次遍历完成所有查找。
+   * @param keys 要查找的键值，最好已经按照从小到大排好序
+   * @param key_len 每个键值的长度
+   * @param[out] entries first是键值在keys中的下标，second是记录的位置
+   */
+  virtual RC get_entries(span<const char *const> keys, int key_len, vector<pair<int, RID>> &entries);
+
+  /**
+   * @brief 使用一列数据批量查找，向量化算子或者连接算子可以一次探测一个Chunk中的所有键值
+   * @param keys 键值列，类型需要与索引字段相同
+   * @param[out] entries first是键值在这一列中的行号，second是记录的位置
+   */
+  RC probe(const Column &keys, vector<pair<int, RID>> &entries);
+
+  /**
+   * @brief 创建一个查找多个键值的扫描器，比如 IN 列表
+   * @details 扫描器按照键值从小到大返回数据
+   */
+  IndexScanner *create_multi_key_scanner(span<const char *const> keys, int key_len);
+
   /**
    * @brief 同步索引数据到磁盘
    *
@@ -83,6 +109,16 @@ public:
 protected:
   RC init(const IndexMeta &index_meta, const FieldMeta &field_meta);
 
+  /**
+   * @brief 把字符串键值补齐成字段的长度，查询条件中的字符串常量长度通常与字段长度不同
+   * @details 超出字段长度的字符串不可能与字段中的值相等，直接跳过
+   * @param[out] fixed_keys 补齐后的键值数据
+   * @param[out] fixed_key_ptrs 补齐后的键值
+   * @param[out] key_indexes 补齐后的每个键值在keys中的下标
+   */
+  RC fix_key_length(span<const char *const> keys, int key_len, vector<char> &fixed_keys,
+      vector<const char *> &fixed_key_ptrs, vector<int> &key_indexes) const;
+
 protected:
   IndexMeta index_meta_;  ///< 索引的元数据
   FieldMeta field_meta_;  ///< 当前实现仅考虑一个字段的索引
@@ -105,3 +141,22 @@ public:
   virtual RC next_entry(RID *rid) = 0;
   virtual RC destroy()            = 0;
 };
+
+/**
+ * @brief 多个键值的扫描器
+ * @ingroup Index
+ * @details 创建时已经通过 Index::get_entries 查找出了所有的数据，这里只是依次返回
+ */
+class MultiKeyIndexScanner : public IndexScanner
+{
+public:
+  explicit MultiKeyIndexScanner(vector<pair<int, RID>> &&entries) : entries_(std::move(entries)) {}
+  ~MultiKeyIndexScanner() override = default;
+
+  RC next_entry(RID *rid) override;
+  RC destroy() override;
+
+private:
+  vector<pair<int, RID>> entries_;
+  size_t                 position_ = 0;
+};
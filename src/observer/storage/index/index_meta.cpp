@@ -21,8 +21,9 @@ See the Mulan PSL v2 for more details. */
 
 const static Json::StaticString FIELD_NAME("name"); // 字段名称
 const static Json::StaticString FIELD_FIELD_NAME("field_name"); // 字段字段名
+const static Json::StaticString FIELD_TYPE("type"); // 索引类型
 
-RC IndexMeta::init(const char *name, const FieldMeta &field)
+RC IndexMeta::init(const char *name, const FieldMeta &field, IndexType type)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Failed to init index, name is empty."); // 初始化索引失败，名称为空
@@ -31,6 +32,7 @@ RC IndexMeta::init(const char *name, const FieldMeta &field)
 
   name_  = name; // 设置索引名称
   field_ = field.name(); // 设置字段名
+  type_  = type; // 设置索引类型
   return RC::SUCCESS; // 返回成功
 }
 
@@ -38,6 +40,7 @@ void IndexMeta::to_json(Json::Value &json_value) const
 {
   json_value[FIELD_NAME]       = name_; // 将索引名称写入JSON
   json_value[FIELD_FIELD_NAME] = field_; // 将字段名写入JSON
+  json_value[FIELD_TYPE]       = static_cast<int>(type_); // 将索引类型写入JSON
 }
 
 RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, IndexMeta &index)
@@ -61,11 +64,27 @@ RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, I
     return RC::SCHEMA_FIELD_MISSING; // 返回字段缺失错误
   }
 
-  return index.init(name_value.asCString(), *field); // 初始化索引
+  // 没有类型字段的是旧版本的元数据，那时只有B+树索引
+  IndexType type = IndexType::BPLUS_TREE;
+  const Json::Value &type_value = json_value[FIELD_TYPE]; // 获取索引类型
+  if (!type_value.isNull()) {
+    if (!type_value.isInt() || type_value.asInt() <= static_cast<int>(IndexType::UNKNOWN_TYPE) ||
+        type_value.asInt() > static_cast<int>(IndexType::HASH)) {
+      LOG_ERROR("Invalid type of index [%s]. json value=%s",
+          name_value.asCString(), type_value.toStyledString().c_str()); // 索引类型不合法
+      return RC::INTERNAL; // 返回内部错误
+    }
+    type = static_cast<IndexType>(type_value.asInt());
+  }
+
+  return index.init(name_value.asCString(), *field, type); // 初始化索引
 }
 
 const char *IndexMeta::name() const { return name_.c_str(); } // 返回索引名称
 
 const char *IndexMeta::field() const { return field_.c_str(); } // 返回字段名称
 
-void IndexMeta::desc(ostream &os) const { os << "index name=" << name_ << ", field=" << field_; } // 描述索引
+void IndexMeta::desc(ostream &os) const
+{
+  os << "index name=" << name_ << ", field=" << field_ << ", type=" << (type_ == IndexType::HASH ? "HASH" : "BTREE");
+} // 描述索引
@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/rc.h"
+#include "common/types.h"
 #include "common/lang/string.h"
 
 class TableMeta;
@@ -28,18 +29,19 @@ class Value;
  * @brief 描述一个索引
  * @ingroup Index
  * @details 一个索引包含了表的哪些字段，索引的名称等。
- * 如果以后实现了多种类型的索引，还需要记录索引的类型，对应类型的一些元数据等
+ * 索引类型决定了打开表时使用哪种索引实现，旧的元数据中没有记录类型，按照B+树处理。
  */
 class IndexMeta
 {
 public:
   IndexMeta() = default;
 
-  RC init(const char *name, const FieldMeta &field);
+  RC init(const char *name, const FieldMeta &field, IndexType type = IndexType::BPLUS_TREE);
 
 public:
   const char *name() const;
   const char *field() const;
+  IndexType   type() const { return type_; }
 
   void desc(ostream &os) const;
 
@@ -50,4 +52,5 @@ public:
 protected:
   string name_;   // index's name
   string field_;  // field's name
+  IndexType type_ = IndexType::BPLUS_TREE;  // index's type
 };
@@ -0,0 +1,415 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/record/pax_minipage.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/string.h"
+#include "common/lang/string_view.h"
+#include "common/lang/unordered_map.h"
+#include "common/log/log.h"
+
+/// 打包的数据后面多留的字节数
+static constexpr int PACK_PADDING = sizeof(uint64_t);
+
+/// 表示 value 需要的位数
+static int bit_width(uint32_t value) { return value == 0 ? 0 : 32 - __builtin_clz(value); }
+
+static int packed_size(int count, int width) { return (count * width + 7) / 8 + PACK_PADDING; }
+
+static int32_t read_int32(const char *data)
+{
+  int32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+static void append_int32(vector<char> &out, int32_t value)
+{
+  const char *data = reinterpret_cast<const char *>(&value);
+  out.insert(out.end(), data, data + sizeof(value));
+}
+
+/// 把 code_of(0) ... code_of(count - 1) 按照 width 位打包追加到 out 中
+template <typename Getter>
+static void append_packed(vector<char> &out, int count, int width, Getter code_of)
+{
+  const size_t start = out.size();
+  out.resize(start + packed_size(count, width), 0);
+  if (width == 0) {
+    return;
+  }
+
+  char *packed = out.data() + start;
+  for (int i = 0; i < count; i++) {
+    const int64_t bit = static_cast<int64_t>(i) * width;
+    uint64_t      word;
+    memcpy(&word, packed + (bit >> 3), sizeof(word));
+    word |= static_cast<uint64_t>(code_of(i)) << (bit & 7);
+    memcpy(packed + (bit >> 3), &word, sizeof(word));
+  }
+}
+
+static bool compare_result(CompOp comp, int cmp)
+{
+  switch (comp) {
+    case EQUAL_TO: return cmp == 0;
+    case LESS_EQUAL: return cmp <= 0;
+    case NOT_EQUAL: return cmp != 0;
+    case LESS_THAN: return cmp < 0;
+    case GREAT_EQUAL: return cmp >= 0;
+    case GREAT_THAN: return cmp > 0;
+    default: return false;
+  }
+}
+
+const char *mini_page_encoding_name(MiniPageEncoding encoding)
+{
+  switch (encoding) {
+    case MiniPageEncoding::RAW: return "RAW";
+    case MiniPageEncoding::FOR: return "FOR";
+    case MiniPageEncoding::DICT: return "DICT";
+    case MiniPageEncoding::RLE: return "RLE";
+  }
+  return "UNKNOWN";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MiniPageEncoding MiniPageWriter::encode(
+    AttrType attr_type, int len, const char *values, int count, bool compress, vector<char> &out)
+{
+  MiniPageEncoding best      = MiniPageEncoding::RAW;
+  int              best_size = count * len;
+
+  int32_t     base  = 0;
+  int         width = 0;
+  vector<int> codes;
+  vector<int> dict_rows;
+  if (compress && count > 0) {
+    int size = rle_size(len, values, count);
+    if (size < best_size) {
+      best      = MiniPageEncoding::RLE;
+      best_size = size;
+    }
+
+    if (attr_type == AttrType::INTS && len == sizeof(int32_t)) {
+      size = for_size(values, count, base, width);
+      if (size < best_size) {
+        best      = MiniPageEncoding::FOR;
+        best_size = size;
+      }
+    } else if (attr_type == AttrType::CHARS) {
+      size = dict_size(len, values, count, codes, dict_rows);
+      if (size > 0 && size < best_size) {
+        best      = MiniPageEncoding::DICT;
+        best_size = size;
+      }
+    }
+  }
+
+  switch (best) {
+    case MiniPageEncoding::RAW: out.insert(out.end(), values, values + count * len); break;
+    case MiniPageEncoding::FOR: write_for(values, count, base, width, out); break;
+    case MiniPageEncoding::DICT: write_dict(len, values, codes, dict_rows, out); break;
+    case MiniPageEncoding::RLE: write_rle(len, values, count, out); break;
+  }
+  return best;
+}
+
+int MiniPageWriter::rle_size(int len, const char *values, int count)
+{
+  int runs = 1;
+  for (int i = 1; i < count; i++) {
+    if (memcmp(values + i * len, values + (i - 1) * len, len) != 0) {
+      runs++;
+    }
+  }
+  return static_cast<int>(sizeof(int32_t)) + runs * static_cast<int>(sizeof(uint16_t) + len);
+}
+
+int MiniPageWriter::for_size(const char *values, int count, int32_t &base, int &width)
+{
+  int32_t min_value = read_int32(values);
+  int32_t max_value = min_value;
+  for (int i = 1; i < count; i++) {
+    const int32_t value = read_int32(values + i * sizeof(int32_t));
+    min_value           = min(min_value, value);
+    max_value           = max(max_value, value);
+  }
+
+  base  = min_value;
+  width = bit_width(static_cast<uint32_t>(static_cast<int64_t>(max_value) - min_value));
+  return static_cast<int>(sizeof(int32_t) * 2) + packed_size(count, width);
+}
+
+int MiniPageWriter::dict_size(int len, const char *values, int count, vector<int> &codes, vector<int> &dict_rows)
+{
+  unordered_map<string_view, int> dict;
+  codes.resize(count);
+  for (int i = 0; i < count; i++) {
+    auto [iter, inserted] = dict.emplace(string_view(values + i * len, len), static_cast<int>(dict_rows.size()));
+    if (inserted) {
+      if (static_cast<int>(dict_rows.size()) >= MAX_DICT_SIZE) {
+        return -1;
+      }
+      dict_rows.push_back(i);
+    }
+    codes[i] = iter->second;
+  }
+
+  const int dict_num = static_cast<int>(dict_rows.size());
+  const int width    = bit_width(static_cast<uint32_t>(dict_num - 1));
+  return static_cast<int>(sizeof(int32_t) * 2) + dict_num * len + packed_size(count, width);
+}
+
+void MiniPageWriter::write_rle(int len, const char *values, int count, vector<char> &out)
+{
+  vector<uint16_t> run_ends;
+  vector<int>      run_rows;  // 每个游程第一行
+  run_rows.push_back(0);
+  for (int i = 1; i < count; i++) {
+    if (memcmp(values + i * len, values + (i - 1) * len, len) != 0) {
+      run_ends.push_back(static_cast<uint16_t>(i));
+      run_rows.push_back(i);
+    }
+  }
+  run_ends.push_back(static_cast<uint16_t>(count));
+
+  append_int32(out, static_cast<int32_t>(run_ends.size()));
+  const char *ends = reinterpret_cast<const char *>(run_ends.data());
+  out.insert(out.end(), ends, ends + run_ends.size() * sizeof(uint16_t));
+  for (int row : run_rows) {
+    out.insert(out.end(), values + row * len, values + (row + 1) * len);
+  }
+}
+
+void MiniPageWriter::write_for(const char *values, int count, int32_t base, int width, vector<char> &out)
+{
+  append_int32(out, base);
+  append_int32(out, width);
+  append_packed(out, count, width, [values, base](int i) {
+    return static_cast<uint32_t>(static_cast<int64_t>(read_int32(values + i * sizeof(int32_t))) - base);
+  });
+}
+
+void MiniPageWriter::write_dict(
+    int len, const char *values, const vector<int> &codes, const vector<int> &dict_rows, vector<char> &out)
+{
+  const int dict_num = static_cast<int>(dict_rows.size());
+  const int width    = bit_width(static_cast<uint32_t>(dict_num - 1));
+  append_int32(out, dict_num);
+  append_int32(out, width);
+  for (int row : dict_rows) {
+    out.insert(out.end(), values + row * len, values + (row + 1) * len);
+  }
+  append_packed(out, static_cast<int>(codes.size()), width, [&codes](int i) { return static_cast<uint32_t>(codes[i]); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MiniPageReader::MiniPageReader(MiniPageEncoding encoding, AttrType attr_type, int len, const char *data, int count)
+    : encoding_(encoding), attr_type_(attr_type), len_(len), data_(data), count_(count)
+{
+  switch (encoding_) {
+    case MiniPageEncoding::RAW: break;
+    case MiniPageEncoding::FOR: {
+      base_   = read_int32(data);
+      width_  = read_int32(data + sizeof(int32_t));
+      packed_ = data + sizeof(int32_t) * 2;
+    } break;
+    case MiniPageEncoding::DICT: {
+      run_count_ = read_int32(data);
+      width_     = read_int32(data + sizeof(int32_t));
+      values_    = data + sizeof(int32_t) * 2;
+      packed_    = values_ + run_count_ * len_;
+    } break;
+    case MiniPageEncoding::RLE: {
+      run_count_ = read_int32(data);
+      run_ends_  = data + sizeof(int32_t);
+      values_    = run_ends_ + run_count_ * sizeof(uint16_t);
+    } break;
+  }
+}
+
+uint32_t MiniPageReader::unpack(const char *packed, int index) const
+{
+  if (width_ == 0) {
+    return 0;
+  }
+  const int64_t bit = static_cast<int64_t>(index) * width_;
+  uint64_t      word;
+  memcpy(&word, packed + (bit >> 3), sizeof(word));
+  return static_cast<uint32_t>((word >> (bit & 7)) & ((uint64_t(1) << width_) - 1));
+}
+
+int MiniPageReader::run_end(int run) const
+{
+  uint16_t end;
+  memcpy(&end, run_ends_ + run * sizeof(uint16_t), sizeof(end));
+  return end;
+}
+
+int MiniPageReader::find_run(int row) const
+{
+  int low = 0, high = run_count_ - 1;
+  while (low < high) {
+    const int mid = (low + high) / 2;
+    if (run_end(mid) <= row) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+const char *MiniPageReader::value(int row, char *buffer) const
+{
+  switch (encoding_) {
+    case MiniPageEncoding::RAW: return data_ + row * len_;
+    case MiniPageEncoding::FOR: {
+      const int32_t value = static_cast<int32_t>(static_cast<int64_t>(base_) + unpack(packed_, row));
+      memcpy(buffer, &value, sizeof(value));
+      return buffer;
+    }
+    case MiniPageEncoding::DICT: return values_ + unpack(packed_, row) * len_;
+    case MiniPageEncoding::RLE: return values_ + find_run(row) * len_;
+  }
+  return nullptr;
+}
+
+void MiniPageReader::decode(int begin, int end, char *out) const
+{
+  switch (encoding_) {
+    case MiniPageEncoding::RAW: {
+      memcpy(out, data_ + begin * len_, (end - begin) * len_);
+    } break;
+    case MiniPageEncoding::FOR: {
+      for (int row = begin; row < end; row++, out += sizeof(int32_t)) {
+        const int32_t value = static_cast<int32_t>(static_cast<int64_t>(base_) + unpack(packed_, row));
+        memcpy(out, &value, sizeof(value));
+      }
+    } break;
+    case MiniPageEncoding::DICT: {
+      for (int row = begin; row < end; row++, out += len_) {
+        memcpy(out, values_ + unpack(packed_, row) * len_, len_);
+      }
+    } break;
+    case MiniPageEncoding::RLE: {
+      for (int run = find_run(begin), row = begin; row < end; run++) {
+        const int run_stop = min(run_end(run), end);
+        for (; row < run_stop; row++, out += len_) {
+          memcpy(out, values_ + run * len_, len_);
+        }
+      }
+    } break;
+  }
+}
+
+void MiniPageReader::decode_rows(const int *rows, int row_num, char *out) const
+{
+  if (encoding_ != MiniPageEncoding::RLE) {
+    char buffer[sizeof(int32_t)];
+    for (int i = 0; i < row_num; i++, out += len_) {
+      memcpy(out, value(rows[i], buffer), len_);
+    }
+    return;
+  }
+
+  // 行号是升序的，游程也只需要向后找
+  int run = 0;
+  for (int i = 0; i < row_num; i++, out += len_) {
+    while (run_end(run) <= rows[i]) {
+      run++;
+    }
+    memcpy(out, values_ + run * len_, len_);
+  }
+}
+
+bool MiniPageReader::match(const char *data, CompOp comp, const Value &value) const
+{
+  int cmp = 0;
+  if (attr_type_ == AttrType::INTS && value.attr_type() == AttrType::INTS) {
+    const int32_t left  = read_int32(data);
+    const int32_t right = value.get_int();
+    cmp                 = left < right ? -1 : (left > right ? 1 : 0);
+  } else {
+    Value left(attr_type_, const_cast<char *>(data), len_);
+    cmp = left.compare(value);
+  }
+  return compare_result(comp, cmp);
+}
+
+void MiniPageReader::filter(CompOp comp, const Value &value, uint8_t *select) const
+{
+  switch (encoding_) {
+    case MiniPageEncoding::RAW: {
+      for (int row = 0; row < count_; row++) {
+        if (select[row] != 0 && !match(data_ + row * len_, comp, value)) {
+          select[row] = 0;
+        }
+      }
+    } break;
+
+    case MiniPageEncoding::FOR: {
+      if (value.attr_type() != AttrType::INTS) {
+        char buffer[sizeof(int32_t)];
+        for (int row = 0; row < count_; row++) {
+          if (select[row] != 0 && !match(this->value(row, buffer), comp, value)) {
+            select[row] = 0;
+          }
+        }
+        break;
+      }
+
+      // 常量减去基准值后直接与打包的值比较。超出打包的值的范围时，所有行的比较结果都一样
+      const int64_t target   = static_cast<int64_t>(value.get_int()) - base_;
+      const int64_t max_code = (int64_t(1) << width_) - 1;
+      if (target < 0 || target > max_code) {
+        if (!compare_result(comp, target < 0 ? 1 : -1)) {
+          memset(select, 0, count_);
+        }
+        break;
+      }
+      for (int row = 0; row < count_; row++) {
+        const int64_t code = unpack(packed_, row);
+        if (!compare_result(comp, code < target ? -1 : (code > target ? 1 : 0))) {
+          select[row] = 0;
+        }
+      }
+    } break;
+
+    case MiniPageEncoding::DICT: {
+      vector<uint8_t> matches(run_count_);
+      bool            any_match = false;
+      for (int i = 0; i < run_count_; i++) {
+        matches[i] = match(values_ + i * len_, comp, value) ? 1 : 0;
+        any_match  = any_match || matches[i] != 0;
+      }
+      if (!any_match) {
+        memset(select, 0, count_);
+        break;
+      }
+      for (int row = 0; row < count_; row++) {
+        select[row] &= matches[unpack(packed_, row)];
+      }
+    } break;
+
+    case MiniPageEncoding::RLE: {
+      for (int run = 0, begin = 0; run < run_count_; run++) {
+        const int end = run_end(run);
+        if (!match(values_ + run * len_, comp, value)) {
+          memset(select + begin, 0, end - begin);
+        }
+        begin = end;
+      }
+    } break;
+  }
+}
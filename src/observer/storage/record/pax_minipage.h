@@ -0,0 +1,120 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/vector.h"
+#include "common/type/attr_type.h"
+#include "common/value.h"
+#include "sql/parser/parse_defs.h"
+
+/**
+ * @brief PAX 页面中一列数据(minipage)的编码方式
+ * @ingroup RecordManager
+ * @details 所有编码都是定长值的编码，编码后的数据中没有对齐，读取时都使用 memcpy。
+ * - RAW：不编码，count * len 个字节
+ * - FOR：frame-of-reference + bit-packing，只用于 INTS。| base(int32) | width(int32) | 按 width 位打包的 value - base |
+ * - DICT：字典编码，只用于 CHARS。| dict_size(int32) | width(int32) | dict_size 个值 | 按 width 位打包的字典下标 |
+ * - RLE：游程编码。| run_count(int32) | 每个游程结束的行号(uint16) | 每个游程的值 |
+ * 打包的数据后面多留 8 个字节，解包时总是读取 8 个字节，不需要判断边界。
+ */
+enum class MiniPageEncoding : int32_t
+{
+  RAW,
+  FOR,
+  DICT,
+  RLE,
+};
+
+const char *mini_page_encoding_name(MiniPageEncoding encoding);
+
+/**
+ * @brief 把一列定长的值编码成 minipage
+ * @ingroup RecordManager
+ */
+class MiniPageWriter
+{
+public:
+  /// 字典最多的值的个数，超过时不使用字典编码
+  static constexpr int MAX_DICT_SIZE = 4096;
+
+  /**
+   * @brief 选择编码后最小的方式，编码的结果追加到 out 中
+   * @param values   连续存放的 count 个值，每个值 len 个字节
+   * @param compress 为 false 时不编码，直接拷贝
+   */
+  static MiniPageEncoding encode(
+      AttrType attr_type, int len, const char *values, int count, bool compress, vector<char> &out);
+
+private:
+  static int  rle_size(int len, const char *values, int count);
+  static int  for_size(const char *values, int count, int32_t &base, int &width);
+  static int  dict_size(int len, const char *values, int count, vector<int> &codes, vector<int> &dict_rows);
+  static void write_rle(int len, const char *values, int count, vector<char> &out);
+  static void write_for(const char *values, int count, int32_t base, int width, vector<char> &out);
+  static void write_dict(
+      int len, const char *values, const vector<int> &codes, const vector<int> &dict_rows, vector<char> &out);
+};
+
+/**
+ * @brief 读取一个 minipage
+ * @ingroup RecordManager
+ * @details 只引用页面中的数据，不拷贝。页面被释放之后不能再使用
+ */
+class MiniPageReader
+{
+public:
+  MiniPageReader(MiniPageEncoding encoding, AttrType attr_type, int len, const char *data, int count);
+
+  /**
+   * @brief 第 row 个值
+   * @details RAW 和 RLE 直接返回页面中的地址，其它编码解码到 buffer 中，buffer 至少有 len 个字节
+   */
+  const char *value(int row, char *buffer) const;
+
+  /// 把 [begin, end) 行解码到 out 中
+  void decode(int begin, int end, char *out) const;
+
+  /// 把 rows 中的行依次解码到 out 中，rows 需要按照升序排列
+  void decode_rows(const int *rows, int row_num, char *out) const;
+
+  /**
+   * @brief 在编码后的数据上判断每一行是否满足 `值 comp value`，不满足的行把 select 置为 0
+   * @details FOR 把常量转换成与打包的值比较，DICT 对每个字典值只比较一次，RLE 对每个游程只比较一次
+   * @param select 按行号索引，至少有 count 个元素
+   */
+  void filter(CompOp comp, const Value &value, uint8_t *select) const;
+
+private:
+  uint32_t unpack(const char *packed, int index) const;
+
+  /// 第 run 个游程结束的行号(不包含)
+  int run_end(int run) const;
+
+  /// 第 row 行所在的游程
+  int find_run(int row) const;
+
+  /// 一个值与常量比较的结果是否满足条件
+  bool match(const char *data, CompOp comp, const Value &value) const;
+
+private:
+  MiniPageEncoding encoding_;
+  AttrType         attr_type_;
+  int              len_;
+  const char      *data_;
+  int              count_;
+
+  int32_t         base_      = 0;  ///< FOR 的基准值
+  int             width_     = 0;  ///< FOR 和 DICT 中每个打包的值的位数
+  int             run_count_ = 0;  ///< RLE 的游程个数或者 DICT 中字典的大小
+  const char     *packed_    = nullptr;
+  const char     *values_    = nullptr;  ///< DICT 的字典或者 RLE 每个游程的值
+  const char     *run_ends_  = nullptr;  ///< RLE 每个游程结束的行号，没有对齐，通过 memcpy 读取
+};
@@ -37,6 +37,9 @@ string RecordOperation::to_string() const
     case Type::INSERT: return ret + "INSERT"; // 插入操作
     case Type::DELETE: return ret + "DELETE"; // 删除操作
     case Type::UPDATE: return ret + "UPDATE"; // 更新操作
+    case Type::INSERT_BATCH: return ret + "INSERT_BATCH"; // 批量插入操作
+    case Type::PUT_VAR: return ret + "PUT_VAR"; // 变长记录的插入或更新操作
+    case Type::OVERFLOW_PAGE: return ret + "OVERFLOW_PAGE"; // 写入溢出页面
     default: return ret + "UNKNOWN"; // 未知操作
   }
 }
@@ -58,9 +61,15 @@ string RecordLogHeader::to_string() const
     } break;
     case RecordOperation::Type::INSERT:
     case RecordOperation::Type::DELETE:
-    case RecordOperation::Type::UPDATE: {
+    case RecordOperation::Type::UPDATE:
+    case RecordOperation::Type::PUT_VAR: {
       ss << ", slot_num:" << slot_num; // 插槽编号
     } break;
+    case RecordOperation::Type::INSERT_BATCH: {
+      ss << ", record_num:" << record_num; // 记录条数
+    } break;
+    case RecordOperation::Type::OVERFLOW_PAGE: {
+    } break;
     default: {
       ss << ", unknown operation type"; // 未知操作类型
     } break;
@@ -129,6 +138,35 @@ RC RecordLogHandler::insert_record(Frame *frame, const RID &rid, const char *rec
   return rc; // 返回操作结果
 }
 
+RC RecordLogHandler::insert_records(Frame *frame, span<const RID> rids, const char *const *records)
+{
+  const int record_num       = static_cast<int>(rids.size());
+  const int log_payload_size = RecordLogHeader::SIZE + record_num * (sizeof(SlotNum) + record_size_); // 计算日志负载大小
+  vector<char> log_payload(log_payload_size); // 创建日志负载向量
+  RecordLogHeader *header = reinterpret_cast<RecordLogHeader *>(log_payload.data()); // 获取日志头指针
+  header->buffer_pool_id  = buffer_pool_id_; // 设置缓冲池 ID
+  header->operation_type  = RecordOperation(RecordOperation::Type::INSERT_BATCH).type_id(); // 设置操作类型
+  header->page_num        = rids[0].page_num; // 设置页面编号
+  header->record_num      = record_num; // 设置记录条数
+  header->storage_format  = static_cast<int>(storage_format_); // 设置存储格式
+
+  // 先是所有的槽位，然后是所有的记录数据
+  SlotNum *slots = reinterpret_cast<SlotNum *>(log_payload.data() + RecordLogHeader::SIZE);
+  char    *data  = log_payload.data() + RecordLogHeader::SIZE + record_num * sizeof(SlotNum);
+  for (int i = 0; i < record_num; i++) {
+    ASSERT(rids[i].page_num == header->page_num, "records of a batch insert log should be in the same page");
+    slots[i] = rids[i].slot_num;
+    memcpy(data + i * record_size_, records[i], record_size_); // 复制记录数据
+  }
+
+  LSN lsn = 0; // 初始化日志序列号
+  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload)); // 追加日志
+  if (OB_SUCC(rc) && lsn > 0) {
+    frame->set_lsn(lsn); // 设置帧的 LSN
+  }
+  return rc; // 返回操作结果
+}
+
 RC RecordLogHandler::update_record(Frame *frame, const RID &rid, const char *record)
 {
   const int log_payload_size = RecordLogHeader::SIZE + record_size_; // 计算日志负载大小
@@ -149,6 +187,56 @@ RC RecordLogHandler::update_record(Frame *frame, const RID &rid, const char *rec
   return rc; // 返回操作结果
 }
 
+RC RecordLogHandler::put_var_record(Frame *frame, const RID &rid, span<const char> payload, bool overflow)
+{
+  // 数据是 [长度][是否溢出][编码后的记录]
+  const int    log_payload_size = RecordLogHeader::SIZE + 2 * sizeof(int32_t) + payload.size();
+  vector<char> log_payload(log_payload_size);
+  RecordLogHeader *header = reinterpret_cast<RecordLogHeader *>(log_payload.data());
+  header->buffer_pool_id  = buffer_pool_id_;
+  header->operation_type  = RecordOperation(RecordOperation::Type::PUT_VAR).type_id();
+  header->page_num        = rid.page_num;
+  header->slot_num        = rid.slot_num;
+  header->storage_format  = static_cast<int>(storage_format_);
+
+  const int32_t len          = static_cast<int32_t>(payload.size());
+  const int32_t has_overflow = overflow ? 1 : 0;
+  char         *data         = log_payload.data() + RecordLogHeader::SIZE;
+  memcpy(data, &len, sizeof(len));
+  memcpy(data + sizeof(len), &has_overflow, sizeof(has_overflow));
+  memcpy(data + 2 * sizeof(int32_t), payload.data(), payload.size());
+
+  LSN lsn = 0;
+  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
+  if (OB_SUCC(rc) && lsn > 0) {
+    frame->set_lsn(lsn);
+  }
+  return rc;
+}
+
+RC RecordLogHandler::overflow_page(Frame *frame, span<const char> data)
+{
+  // 数据是 [长度][页面数据]
+  const int    log_payload_size = RecordLogHeader::SIZE + sizeof(int32_t) + data.size();
+  vector<char> log_payload(log_payload_size);
+  RecordLogHeader *header = reinterpret_cast<RecordLogHeader *>(log_payload.data());
+  header->buffer_pool_id  = buffer_pool_id_;
+  header->operation_type  = RecordOperation(RecordOperation::Type::OVERFLOW_PAGE).type_id();
+  header->page_num        = frame->page_num();
+  header->storage_format  = static_cast<int>(storage_format_);
+
+  const int32_t len = static_cast<int32_t>(data.size());
+  memcpy(log_payload.data() + RecordLogHeader::SIZE, &len, sizeof(len));
+  memcpy(log_payload.data() + RecordLogHeader::SIZE + sizeof(len), data.data(), data.size());
+
+  LSN lsn = 0;
+  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
+  if (OB_SUCC(rc) && lsn > 0) {
+    frame->set_lsn(lsn);
+  }
+  return rc;
+}
+
 RC RecordLogHandler::delete_record(Frame *frame, const RID &rid)
 {
   RecordLogHeader header; // 创建日志头
@@ -220,12 +308,21 @@ RC RecordLogReplayer::replay(const LogEntry &entry)
     case RecordOperation::Type::INSERT: {
       rc = replay_insert(*buffer_pool, *log_header); // 重放插入操作
     } break;
+    case RecordOperation::Type::INSERT_BATCH: {
+      rc = replay_insert_batch(*buffer_pool, *log_header); // 重放批量插入操作
+    } break;
     case RecordOperation::Type::DELETE: {
       rc = replay_delete(*buffer_pool, *log_header); // 重放删除操作
     } break;
     case RecordOperation::Type::UPDATE: {
       rc = replay_update(*buffer_pool, *log_header); // 重放更新操作
     } break;
+    case RecordOperation::Type::PUT_VAR: {
+      rc = replay_put_var(*buffer_pool, *log_header); // 重放变长记录的插入或更新操作
+    } break;
+    case RecordOperation::Type::OVERFLOW_PAGE: {
+      rc = replay_overflow_page(*frame, *log_header); // 重放溢出页面
+    } break;
     default: {
       LOG_WARN("unknown record operation type: %d", log_header->operation_type); // 未知操作类型处理
       return RC::INVALID_ARGUMENT;
@@ -285,6 +382,34 @@ RC RecordLogReplayer::replay_insert(DiskBufferPool &buffer_pool, const RecordLog
   return rc; // 返回操作结果
 }
 
+RC RecordLogReplayer::replay_insert_batch(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header)
+{
+  VacuousLogHandler             vacuous_log_handler; // 创建一个无效日志处理器
+  unique_ptr<RecordPageHandler> record_page_handler(
+      RecordPageHandler::create(StorageFormat(log_header.storage_format))); // 创建记录页面处理器
+
+  RC rc = record_page_handler->init(buffer_pool, vacuous_log_handler, log_header.page_num, ReadWriteMode::READ_WRITE); // 初始化页面
+  if (OB_FAIL(rc)) {
+    LOG_WARN("fail to init record page handler. page num=%d, rc=%s", log_header.page_num, strrc(rc)); // 错误处理
+    return rc;
+  }
+
+  // 日志中记录了每条记录的槽位，直接恢复到原来的位置
+  const int      record_num  = log_header.record_num;
+  const int      record_size = record_page_handler->record_size();
+  const SlotNum *slots       = reinterpret_cast<const SlotNum *>(log_header.data);
+  const char    *data        = log_header.data + record_num * sizeof(SlotNum);
+  for (int i = 0; i < record_num && OB_SUCC(rc); i++) {
+    rc = record_page_handler->recover_insert_record(data + i * record_size, RID(log_header.page_num, slots[i]));
+    if (OB_FAIL(rc)) {
+      LOG_WARN("fail to recover insert record. page num=%d, slot num=%d, rc=%s", 
+               log_header.page_num, slots[i], strrc(rc)); // 错误处理
+    }
+  }
+
+  return rc; // 返回操作结果
+}
+
 RC RecordLogReplayer::replay_delete(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header)
 {
   VacuousLogHandler             vacuous_log_handler; // 创建一个无效日志处理器
@@ -298,7 +423,12 @@ RC RecordLogReplayer::replay_delete(DiskBufferPool &buffer_pool, const RecordLog
   }
 
   RID rid(log_header.page_num, log_header.slot_num); // 创建记录 ID
-  rc = record_page_handler->delete_record(&rid); // 删除记录
+  if (StorageFormat(log_header.storage_format) == StorageFormat::VAR_ROW_FORMAT) {
+    // 溢出页面的释放由 buffer pool 的日志重放，这里只删除页面中的记录
+    rc = static_cast<VarRecordPageHandler *>(record_page_handler.get())->recover_delete_record(rid);
+  } else {
+    rc = record_page_handler->delete_record(&rid); // 删除记录
+  }
   if (OB_FAIL(rc)) {
     LOG_WARN("fail to recover delete record. page num=%d, slot num=%d, rc=%s", 
              log_header.page_num, log_header.slot_num, strrc(rc)); // 错误处理
@@ -329,3 +459,36 @@ RC RecordLogReplayer::replay_update(DiskBufferPool &buffer_pool, const RecordLog
 
   return rc; // 返回操作结果
 }
+
+RC RecordLogReplayer::replay_put_var(DiskBufferPool &buffer_pool, const RecordLogHeader &header)
+{
+  VacuousLogHandler    vacuous_log_handler;
+  VarRecordPageHandler record_page_handler;
+
+  RC rc = record_page_handler.init(buffer_pool, vacuous_log_handler, header.page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("fail to init record page handler. page num=%d, rc=%s", header.page_num, strrc(rc));
+    return rc;
+  }
+
+  int32_t len      = 0;
+  int32_t overflow = 0;
+  memcpy(&len, header.data, sizeof(len));
+  memcpy(&overflow, header.data + sizeof(len), sizeof(overflow));
+
+  RID rid(header.page_num, header.slot_num);
+  rc = record_page_handler.recover_put_record(
+      rid, span<const char>(header.data + 2 * sizeof(int32_t), len), overflow != 0);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("fail to recover put var record. page num=%d, slot num=%d, rc=%s", header.page_num, header.slot_num, strrc(rc));
+    return rc;
+  }
+  return rc;
+}
+
+RC RecordLogReplayer::replay_overflow_page(Frame &frame, const RecordLogHeader &header)
+{
+  int32_t len = 0;
+  memcpy(&len, header.data, sizeof(len));
+  return VarRecordPageHandler::recover_overflow_page(frame, span<const char>(header.data + sizeof(len), len));
+}
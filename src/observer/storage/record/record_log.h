@@ -41,7 +41,10 @@ public:
     INIT_PAGE,  /// 初始化空页面
     INSERT,     /// 插入一条记录
     DELETE,     /// 删除一条记录
-    UPDATE      /// 更新一条记录
+    UPDATE,     /// 更新一条记录
+    INSERT_BATCH,  /// 在一个页面中插入多条记录
+    PUT_VAR,       /// 变长行存页面中插入或者更新一条记录，记录的是编码后的数据
+    OVERFLOW_PAGE  /// 写入一个溢出页面
   };
 
 public:
@@ -69,6 +72,7 @@ struct RecordLogHeader
   {
     SlotNum slot_num;
     int32_t record_size;
+    int32_t record_num;  ///< INSERT_BATCH 中记录的条数
   };
 
   char data[0];
@@ -109,6 +113,15 @@ public:
    */
   RC insert_record(Frame *frame, const RID &rid, const char *record);
 
+  /**
+   * @brief 在同一个页面中插入多条记录，只写一条日志
+   * @details 日志的内容是所有记录的槽位，然后是所有记录的数据
+   * @param frame   页帧
+   * @param rids    所有记录的位置，必须在同一个页面上
+   * @param records 所有记录的内容，与 rids 一一对应
+   */
+  RC insert_records(Frame *frame, span<const RID> rids, const char *const *records);
+
   /**
    * @brief 删除一条记录
    * @param frame 页帧
@@ -125,6 +138,24 @@ public:
    */
   RC update_record(Frame *frame, const RID &rid, const char *record);
 
+  /**
+   * @brief 变长行存页面中插入或者更新一条记录
+   * @details 日志的内容是编码后记录的长度、是否有溢出页面，然后是编码后的数据
+   * @param frame    页帧
+   * @param rid      记录的位置
+   * @param payload  编码后的记录
+   * @param overflow 记录的字符串字段是否放在溢出页面中
+   */
+  RC put_var_record(Frame *frame, const RID &rid, span<const char> payload, bool overflow);
+
+  /**
+   * @brief 写入一个溢出页面
+   * @details 溢出页面只写一次，直接记录页面中的有效数据
+   * @param frame 溢出页面的页帧
+   * @param data  页面中从页头开始的有效数据
+   */
+  RC overflow_page(Frame *frame, span<const char> data);
+
 private:
   LogHandler   *log_handler_    = nullptr;
   int32_t       buffer_pool_id_ = -1;
@@ -147,8 +178,11 @@ public:
 private:
   RC replay_init_page(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_insert(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
+  RC replay_insert_batch(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_delete(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_update(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
+  RC replay_put_var(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
+  RC replay_overflow_page(Frame &frame, const RecordLogHeader &log_header);
 
 private:
   BufferPoolManager &bpm_;
@@ -12,10 +12,12 @@ See the Mulan PSL v2 for more details. */
 // Created by Meiyi & Longda on 2021/4/13.
 //
 #include "storage/record/record_manager.h"
+#include "common/lang/algorithm.h"
 #include "common/log/log.h"
 #include "storage/common/condition_filter.h"
 #include "storage/trx/trx.h"
 #include "storage/clog/log_handler.h"
+#include "storage/clog/vacuous_log_handler.h"
 
 using namespace common;
 
@@ -25,6 +27,8 @@ static constexpr int PAGE_HEADER_SIZE = (sizeof(PageHeader));
 RecordPageHandler *RecordPageHandler::create(StorageFormat format) {
   if (format == StorageFormat::ROW_FORMAT) {
     return new RowRecordPageHandler(); // 返回行格式处理器
+  } else if (format == StorageFormat::VAR_ROW_FORMAT) {
+    return new VarRecordPageHandler(); // 返回变长行格式处理器
   } else {
     return new PaxRecordPageHandler(); // 返回列格式处理器
   }
@@ -310,6 +314,38 @@ RC RowRecordPageHandler::insert_record(const char *data, RID *rid) {
   return RC::SUCCESS; // 返回成功
 }
 
+RC RowRecordPageHandler::insert_records(const char *const *datas, int count, RID *rids, int &inserted)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot insert record into page while the page is readonly");
+
+  inserted = 0;
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = -1;
+  while (inserted < count && page_header_->record_num < page_header_->record_capacity) {
+    index = bitmap.next_unsetted_bit(index + 1);
+    bitmap.set_bit(index);
+    page_header_->record_num++;
+
+    memcpy(get_record_data(index), datas[inserted], page_header_->record_real_size);
+    rids[inserted] = RID(get_page_num(), index);
+    inserted++;
+  }
+
+  if (inserted == 0) {
+    return RC::SUCCESS;
+  }
+
+  // 这个页面上插入的所有记录只写一条日志
+  RC rc = log_handler_.insert_records(frame_, span<const RID>(rids, inserted), datas);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert records. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // 与 insert_record 一样忽略错误
+  }
+
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
 RC RowRecordPageHandler::recover_insert_record(const char *data, const RID &rid)
 {
   // 检查槽位号是否超出记录容量
@@ -358,135 +394,1627 @@ RC RowRecordPageHandler::delete_record(const RID *rid)
   }
 }
 
-RC RowRecordPageHandler::update_record(const RID &rid, const char *data)
+RC RowRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot delete record from page while the page is readonly"); // 确保不是只读模式
+
+  // 检查槽位号是否超出记录容量
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::INVALID_ARGUMENT; // 返回无效参数
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (bitmap.get_bit(rid.slot_num)) { // 检查槽位是否已被使用
+    frame_->mark_dirty(); // 标记页面为脏
+
+    char *record_data = get_record_data(rid.slot_num); // 获取记录数据
+    if (record_data != data) { // 如果新数据与旧数据不同
+      memcpy(record_data, data, page_header_->record_real_size); // 复制新数据
+    }
+
+    RC rc = log_handler_.update_record(frame_, rid, data); // 记录更新操作
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s", 
+                disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+      // return rc; // 忽略错误
+    }
+
+    return RC::SUCCESS; // 返回成功
+  } else {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST; // 返回记录不存在
+  }
+}
+
+RC RowRecordPageHandler::get_record(const RID &rid, Record &record)
+{
+  // 检查槽位号是否超出记录容量
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID; // 返回无效RID
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) { // 检查槽位是否已被使用
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST; // 返回记录不存在
+  }
+
+  record.set_rid(rid); // 设置记录的RID
+  record.set_data(get_record_data(rid.slot_num), page_header_->record_real_size); // 设置记录数据
+  return RC::SUCCESS; // 返回成功
+}
+
+RC RowRecordPageHandler::get_chunk(Chunk &chunk, const uint8_t *visible)
+{
+  if (table_meta_ == nullptr) {
+    LOG_WARN("cannot get chunk from row page without table meta. page_num=%d", frame_->page_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 每一列在记录中的位置
+  vector<const FieldMeta *> fields(chunk.column_num());
+  for (int i = 0; i < chunk.column_num(); i++) {
+    fields[i] = table_meta_->field(chunk.column_ids(i));
+    if (fields[i] == nullptr) {
+      LOG_WARN("no such field in table. table=%s, field id=%d", table_meta_->name(), chunk.column_ids(i));
+      return RC::SCHEMA_FIELD_NOT_EXIST;
+    }
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  for (int slot_num = bitmap.next_setted_bit(0); slot_num != -1; slot_num = bitmap.next_setted_bit(slot_num + 1)) {
+    if (visible != nullptr && visible[slot_num] == 0) {
+      continue;
+    }
+    char *record_data = get_record_data(slot_num);
+    for (int i = 0; i < chunk.column_num(); i++) {
+      RC rc = chunk.column(i).append_one(record_data + fields[i]->offset());
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append field to column. page_num=%d, slot_num=%d, rc=%s",
+                 frame_->page_num(), slot_num, strrc(rc));
+        return rc;
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC RowRecordPageHandler::read_int_field(const FieldMeta &field, int32_t *values)
+{
+  // 记录是定长的，同一个字段在各条记录中的间隔是固定的
+  const char *data        = get_record_data(0) + field.offset();
+  const int   record_size = page_header_->record_size;
+  for (int slot_num = 0; slot_num < page_header_->record_capacity; slot_num++, data += record_size) {
+    memcpy(&values[slot_num], data, sizeof(int32_t));
+  }
+  return RC::SUCCESS;
+}
+
+PageNum RecordPageHandler::get_page_num() const
+{
+  if (nullptr == page_header_) {
+    return (PageNum)(-1); // 如果页面头为空，返回-1
+  }
+  return frame_->page_num(); // 返回页面号
+}
+
+bool RecordPageHandler::is_full() const { 
+  return page_header_->record_num >= page_header_->record_capacity; // 判断页面是否已满 
+}
+
+int RecordPageHandler::free_space_level() const
+{
+  const int capacity   = page_header_->record_capacity;
+  const int free_slots = capacity - page_header_->record_num;
+  if (free_slots <= 0) {
+    return 0;
+  }
+  // 向上取整，只要还有一个空闲位置，等级就不是 0
+  return (free_slots * FSM_MAX_LEVEL + capacity - 1) / capacity;
+}
+
+RC RecordPageHandler::insert_records(const char *const *datas, int count, RID *rids, int &inserted)
+{
+  inserted = 0;
+  while (inserted < count && !is_full()) {
+    RC rc = insert_record(datas[inserted], &rids[inserted]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    inserted++;
+  }
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::init_empty_page(
+    DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size, TableMeta *table_meta)
+{
+  if (table_meta == nullptr) {
+    LOG_WARN("cannot init pax page without table meta. page_num=%d", page_num);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
+  }
+
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+
+  // 事务字段在最前面，会被原地修改，不编码
+  vector<PaxColumn> pax_columns;
+  for (const FieldMeta &field : *table_meta->field_metas()) {
+    PaxColumn column;
+    column.len       = static_cast<int16_t>(field.len());
+    column.attr_type = static_cast<uint8_t>(field.type());
+    column.flags     = static_cast<int>(pax_columns.size()) < table_meta->sys_field_num() ? COLUMN_KEEP_RAW : 0;
+    pax_columns.push_back(column);
+  }
+
+  rc = init_pax_page(record_size, static_cast<int>(pax_columns.size()), pax_columns.data());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = log_handler_.init_new_page(
+      frame_, page_num, span((const char *)pax_columns.data(), pax_columns.size() * sizeof(PaxColumn)));
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page: write log failed. page_num:record_size %d:%d. rc=%s",
+              page_num, record_size, strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num,
+    int record_size, int col_num, const char *col_idx_data)
+{
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
+  }
+
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+  return init_pax_page(record_size, col_num, reinterpret_cast<const PaxColumn *>(col_idx_data));
+}
+
+RC PaxRecordPageHandler::init_pax_page(int record_size, int col_num, const PaxColumn *pax_columns)
+{
+  int total_len = 0;
+  for (int i = 0; i < col_num; i++) {
+    total_len += pax_columns[i].len;
+  }
+  if (col_num <= 0 || total_len != record_size) {
+    LOG_ERROR("columns do not match the record. record_size=%d, column_num=%d, total_len=%d",
+              record_size, col_num, total_len);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 按照不压缩时的容量计算槽位个数，放大 MAX_COMPRESSION_RATIO 倍，但是不超过 MAX_RECORD_CAPACITY
+  const int fixed_size = col_num * (sizeof(PaxColumn) + sizeof(MiniPage)) + sizeof(PaxPageHeader) + 8 /*对齐*/;
+  const int base_capacity = page_record_capacity(BP_PAGE_DATA_SIZE, record_size, fixed_size);
+  if (base_capacity <= 0) {
+    LOG_ERROR("record is too large for pax page. record_size=%d, column_num=%d", record_size, col_num);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  page_header_->record_num       = 0;
+  page_header_->column_num       = col_num;
+  page_header_->record_real_size = record_size;
+  page_header_->record_size      = record_size;
+  page_header_->record_capacity =
+      min(base_capacity * MAX_COMPRESSION_RATIO, max(base_capacity, MAX_RECORD_CAPACITY));
+  page_header_->col_idx_offset = align8(PAGE_HEADER_SIZE + page_bitmap_size(page_header_->record_capacity));
+  page_header_->data_offset    = align8(page_header_->col_idx_offset + col_num * sizeof(PaxColumn) +
+                                     sizeof(PaxPageHeader) + col_num * sizeof(MiniPage));
+
+  bitmap_ = frame_->data() + PAGE_HEADER_SIZE;
+  memcpy(columns(), pax_columns, col_num * sizeof(PaxColumn));
+  reset_page();
+  return RC::SUCCESS;
+}
+
+PaxRecordPageHandler::PaxColumn *PaxRecordPageHandler::columns() const
+{
+  return reinterpret_cast<PaxColumn *>(frame_->data() + page_header_->col_idx_offset);
+}
+
+PaxRecordPageHandler::PaxPageHeader *PaxRecordPageHandler::pax_header() const
+{
+  return reinterpret_cast<PaxPageHeader *>(columns() + page_header_->column_num);
+}
+
+PaxRecordPageHandler::MiniPage *PaxRecordPageHandler::mini_pages() const
+{
+  return reinterpret_cast<MiniPage *>(pax_header() + 1);
+}
+
+int PaxRecordPageHandler::column_offset(int col_id) const
+{
+  const PaxColumn *pax_columns = columns();
+  int              offset      = 0;
+  for (int i = 0; i < col_id; i++) {
+    offset += pax_columns[i].len;
+  }
+  return offset;
+}
+
+char *PaxRecordPageHandler::raw_value(int col_id, int row) const
+{
+  const PaxPageHeader *header = pax_header();
+  return frame_->data() + header->raw_start + header->raw_capacity * column_offset(col_id) +
+         (row - header->sealed_rows) * columns()[col_id].len;
+}
+
+MiniPageReader PaxRecordPageHandler::sealed_reader(int col_id) const
+{
+  const PaxColumn &column    = columns()[col_id];
+  const MiniPage  &mini_page = mini_pages()[col_id];
+  return MiniPageReader(static_cast<MiniPageEncoding>(mini_page.encoding),
+      static_cast<AttrType>(column.attr_type),
+      column.len,
+      frame_->data() + mini_page.offset,
+      pax_header()->sealed_rows);
+}
+
+const char *PaxRecordPageHandler::field_value(int col_id, int row, char *buffer) const
+{
+  if (row < pax_header()->sealed_rows) {
+    return sealed_reader(col_id).value(row, buffer);
+  }
+  return raw_value(col_id, row);
+}
+
+void PaxRecordPageHandler::reset_page()
+{
+  PaxPageHeader *header = pax_header();
+  header->row_count     = 0;
+  header->sealed_rows   = 0;
+  header->raw_start     = page_header_->data_offset;
+  header->raw_capacity  = min(page_header_->record_capacity,
+      (BP_PAGE_DATA_SIZE - page_header_->data_offset) / page_header_->record_real_size);
+  // 不压缩也能放下所有槽位时不需要封存
+  header->flags = header->raw_capacity >= page_header_->record_capacity ? PAGE_SEAL_DONE : 0;
+
+  page_header_->record_num = 0;
+  memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
+  frame_->mark_dirty();
+}
+
+SlotNum PaxRecordPageHandler::append_row(const char *data)
+{
+  PaxPageHeader   *header      = pax_header();
+  const PaxColumn *pax_columns = columns();
+  const SlotNum    slot_num    = header->row_count;
+  for (int i = 0, offset = 0; i < page_header_->column_num; offset += pax_columns[i].len, i++) {
+    memcpy(raw_value(i, slot_num), data + offset, pax_columns[i].len);
+  }
+  header->row_count++;
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  bitmap.set_bit(slot_num);
+  page_header_->record_num++;
+
+  // 未编码区满了就封存，为后面的记录腾出空间
+  if (header->row_count - header->sealed_rows >= header->raw_capacity && !(header->flags & PAGE_SEAL_DONE) &&
+      header->row_count < page_header_->record_capacity) {
+    seal();
+  }
+
+  frame_->mark_dirty();
+  return slot_num;
+}
+
+void PaxRecordPageHandler::decode_page(vector<char> &pax_columns) const
+{
+  const PaxPageHeader *header = pax_header();
+  const int            rows   = header->row_count;
+  pax_columns.resize(static_cast<size_t>(rows) * page_header_->record_real_size);
+
+  for (int i = 0; i < page_header_->column_num; i++) {
+    const int len = columns()[i].len;
+    char     *out = pax_columns.data() + static_cast<size_t>(rows) * column_offset(i);
+    if (header->sealed_rows > 0) {
+      sealed_reader(i).decode(0, header->sealed_rows, out);
+    }
+    memcpy(out + header->sealed_rows * len, raw_value(i, header->sealed_rows), (rows - header->sealed_rows) * len);
+  }
+}
+
+RC PaxRecordPageHandler::encode_page(const vector<char> &pax_columns)
+{
+  PaxPageHeader   *header = pax_header();
+  const PaxColumn *cols   = columns();
+  const int        rows   = header->row_count;
+  const int        col_num = page_header_->column_num;
+
+  vector<MiniPage> pages(col_num);
+  encode_buffer_.clear();
+  for (int i = 0; i < col_num; i++) {
+    const int offset   = static_cast<int>(encode_buffer_.size());
+    MiniPageEncoding encoding = MiniPageWriter::encode(static_cast<AttrType>(cols[i].attr_type),
+        cols[i].len,
+        pax_columns.data() + static_cast<size_t>(rows) * column_offset(i),
+        rows,
+        !(cols[i].flags & COLUMN_KEEP_RAW),
+        encode_buffer_);
+
+    pages[i].encoding = static_cast<int32_t>(encoding);
+    pages[i].offset   = page_header_->data_offset + offset;
+    pages[i].size     = static_cast<int>(encode_buffer_.size()) - offset;
+  }
+
+  const int raw_start = align8(page_header_->data_offset + static_cast<int>(encode_buffer_.size()));
+  if (raw_start > BP_PAGE_DATA_SIZE) {
+    LOG_DEBUG("encoded data exceeds the page. page_num=%d, rows=%d, encoded size=%d",
+              frame_->page_num(), rows, static_cast<int>(encode_buffer_.size()));
+    return RC::RECORD_NOMEM;
+  }
+
+  memcpy(frame_->data() + page_header_->data_offset, encode_buffer_.data(), encode_buffer_.size());
+  memcpy(mini_pages(), pages.data(), col_num * sizeof(MiniPage));
+  header->sealed_rows  = rows;
+  header->raw_start    = raw_start;
+  header->raw_capacity = min(page_header_->record_capacity - rows,
+      (BP_PAGE_DATA_SIZE - raw_start) / page_header_->record_real_size);
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+void PaxRecordPageHandler::seal()
+{
+  PaxPageHeader *header = pax_header();
+  decode_page(column_buffer_);
+  RC rc = encode_page(column_buffer_);
+  if (OB_FAIL(rc)) {
+    header->flags |= PAGE_SEAL_DONE;
+    return;
+  }
+
+  if (header->raw_capacity < max(1, header->row_count / MIN_SEAL_GAIN)) {
+    header->flags |= PAGE_SEAL_DONE;
+  }
+  LOG_TRACE("seal pax page. page_num=%d, rows=%d, raw_start=%d, raw_capacity=%d",
+            frame_->page_num(), header->row_count, header->raw_start, header->raw_capacity);
+}
+
+RC PaxRecordPageHandler::insert_record(const char *data, RID *rid)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot insert record into page while the page is readonly");
+
+  if (is_full()) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  // 先写日志再追加，追加时可能会封存页面，回放时重做插入也会在同样的位置封存
+  const SlotNum slot_num = pax_header()->row_count;
+  RC            rc       = log_handler_.insert_record(frame_, RID(get_page_num(), slot_num), data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s",
+              disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // 忽略错误
+  }
+
+  append_row(data);
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = slot_num;
+  }
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::recover_insert_record(const char *data, const RID &rid)
+{
+  if (rid.slot_num != pax_header()->row_count || is_full()) {
+    LOG_WARN("slot_num illegal, slot_num(%d) should be the next row(%d) of a page not full.",
+             rid.slot_num, pax_header()->row_count);
+    return RC::RECORD_INVALID_RID;
+  }
+
+  append_row(data);
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::delete_record(const RID *rid)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot delete record from page while the page is readonly"); // 确保不是只读模式
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (bitmap.get_bit(rid->slot_num)) { // 检查槽位是否已被使用
+    bitmap.clear_bit(rid->slot_num); // 清除槽位
+    page_header_->record_num--; // 更新记录数量
+    frame_->mark_dirty(); // 标记页面为脏
+
+    // 槽位不会重复使用，记录都删除以后整个页面重新开始
+    if (page_header_->record_num == 0) {
+      reset_page();
+    }
+
+    RC rc = log_handler_.delete_record(frame_, *rid); // 记录删除操作
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to delete record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+      // return rc; // 忽略错误
+    }
+
+    return RC::SUCCESS; // 返回成功
+  } else {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST; // 返回记录不存在
+  }
+}
+
+RC PaxRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot update record in page while the page is readonly");
+
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  const PaxPageHeader *header      = pax_header();
+  const PaxColumn     *pax_columns = columns();
+  const int            col_num     = page_header_->column_num;
+  if (rid.slot_num >= header->sealed_rows) {
+    for (int i = 0, offset = 0; i < col_num; offset += pax_columns[i].len, i++) {
+      memcpy(raw_value(i, rid.slot_num), data + offset, pax_columns[i].len);
+    }
+  } else {
+    // 编码过的字段值没有变化时，只需要修改不编码的列，比如事务字段
+    bool         recode = false;
+    vector<char> buffer(page_header_->record_real_size);
+    for (int i = 0, offset = 0; i < col_num && !recode; offset += pax_columns[i].len, i++) {
+      if (mini_pages()[i].encoding != static_cast<int32_t>(MiniPageEncoding::RAW)) {
+        const char *old_value = field_value(i, rid.slot_num, buffer.data());
+        recode                = memcmp(old_value, data + offset, pax_columns[i].len) != 0;
+      }
+    }
+
+    if (recode) {
+      decode_page(column_buffer_);
+      for (int i = 0, offset = 0; i < col_num; offset += pax_columns[i].len, i++) {
+        memcpy(column_buffer_.data() + static_cast<size_t>(header->row_count) * offset +
+                   rid.slot_num * pax_columns[i].len,
+            data + offset,
+            pax_columns[i].len);
+      }
+      RC rc = encode_page(column_buffer_);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("no space to encode the updated record. page_num=%d, slot_num=%d", frame_->page_num(), rid.slot_num);
+        return rc;
+      }
+    } else {
+      for (int i = 0, offset = 0; i < col_num; offset += pax_columns[i].len, i++) {
+        const MiniPage &mini_page = mini_pages()[i];
+        if (mini_page.encoding == static_cast<int32_t>(MiniPageEncoding::RAW)) {
+          memcpy(frame_->data() + mini_page.offset + rid.slot_num * pax_columns[i].len,
+              data + offset,
+              pax_columns[i].len);
+        }
+      }
+    }
+  }
+  frame_->mark_dirty();
+
+  RC rc = log_handler_.update_record(frame_, rid, data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s", 
+              disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // 忽略错误
+  }
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::get_record(const RID &rid, Record &record)
+{
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  record_buffer_.resize(page_header_->record_real_size);
+  const PaxColumn *pax_columns = columns();
+  for (int i = 0, offset = 0; i < page_header_->column_num; offset += pax_columns[i].len, i++) {
+    char       *field = record_buffer_.data() + offset;
+    const char *value = field_value(i, rid.slot_num, field);
+    if (value != field) {
+      memcpy(field, value, pax_columns[i].len);
+    }
+  }
+
+  record.set_rid(rid);
+  record.set_data(record_buffer_.data(), page_header_->record_real_size);
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::get_chunk(Chunk &chunk, const uint8_t *visible)
+{
+  const PaxPageHeader *header = pax_header();
+
+  // 要拷贝的行，前面 sealed_num 个在编码区中
+  rows_.clear();
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  for (int slot_num = bitmap.next_setted_bit(0); slot_num != -1; slot_num = bitmap.next_setted_bit(slot_num + 1)) {
+    if (visible == nullptr || visible[slot_num] != 0) {
+      rows_.push_back(slot_num);
+    }
+  }
+  const int row_num    = static_cast<int>(rows_.size());
+  const int sealed_num = static_cast<int>(lower_bound(rows_.begin(), rows_.end(), header->sealed_rows) - rows_.begin());
+  if (row_num == 0) {
+    return RC::SUCCESS;
+  }
+
+  for (int i = 0; i < chunk.column_num(); i++) {
+    const int col_id = chunk.column_ids(i);
+    if (col_id < 0 || col_id >= page_header_->column_num) {
+      LOG_WARN("no such column in pax page. page_num=%d, column id=%d", frame_->page_num(), col_id);
+      return RC::SCHEMA_FIELD_NOT_EXIST;
+    }
+
+    Column   &column = chunk.column(i);
+    const int len    = columns()[col_id].len;
+    if (column.attr_len() != len) {
+      LOG_WARN("column length mismatch. page_num=%d, column id=%d, page len=%d, column len=%d",
+               frame_->page_num(), col_id, len, column.attr_len());
+      return RC::INVALID_ARGUMENT;
+    }
+
+    // 变长的列只追加字符串实际的内容
+    if (column.is_var_len()) {
+      vector<char> buffer(len);
+      for (int row : rows_) {
+        const char *value = field_value(col_id, row, buffer.data());
+        RC          rc    = column.append_var(value, static_cast<int>(strnlen(value, len)));
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to append field to column. page_num=%d, slot_num=%d, rc=%s",
+                   frame_->page_num(), row, strrc(rc));
+          return rc;
+        }
+      }
+      continue;
+    }
+
+    if (column.count() + row_num > column.capacity()) {
+      LOG_WARN("append data to full column. page_num=%d, count=%d, rows=%d, capacity=%d",
+               frame_->page_num(), column.count(), row_num, column.capacity());
+      return RC::INTERNAL;
+    }
+
+    // 编码的数据直接解码到 Column 的内存中
+    char *out = column.data() + static_cast<size_t>(column.count()) * len;
+    if (sealed_num == header->sealed_rows) {
+      sealed_reader(col_id).decode(0, sealed_num, out);
+    } else if (sealed_num > 0) {
+      sealed_reader(col_id).decode_rows(rows_.data(), sealed_num, out);
+    }
+    for (int j = sealed_num; j < row_num; j++) {
+      memcpy(out + j * len, raw_value(col_id, rows_[j]), len);
+    }
+    column.set_count(column.count() + row_num);
+  }
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::read_int_field(const FieldMeta &field, int32_t *values)
+{
+  int col_id = 0;
+  while (col_id < page_header_->column_num && column_offset(col_id) != field.offset()) {
+    col_id++;
+  }
+  if (col_id == page_header_->column_num || columns()[col_id].len != sizeof(int32_t)) {
+    LOG_WARN("field is not an int column of the page. field=%s, page_num=%d", field.name(), frame_->page_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const PaxPageHeader *header = pax_header();
+  if (header->sealed_rows > 0) {
+    sealed_reader(col_id).decode(0, header->sealed_rows, reinterpret_cast<char *>(values));
+  }
+  memcpy(values + header->sealed_rows,
+      raw_value(col_id, header->sealed_rows),
+      (header->row_count - header->sealed_rows) * sizeof(int32_t));
+  memset(values + header->row_count, 0, (page_header_->record_capacity - header->row_count) * sizeof(int32_t));
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::filter_column(const ColumnPredicate &predicate, uint8_t *select)
+{
+  const int col_id = predicate.column_id;
+  if (col_id < 0 || col_id >= page_header_->column_num) {
+    LOG_WARN("no such column in pax page. page_num=%d, column id=%d", frame_->page_num(), col_id);
+    return RC::SCHEMA_FIELD_NOT_EXIST;
+  }
+
+  const PaxPageHeader *header = pax_header();
+  const PaxColumn     &column = columns()[col_id];
+  if (header->sealed_rows > 0) {
+    sealed_reader(col_id).filter(predicate.comp, predicate.value, select);
+  }
+  MiniPageReader raw_reader(MiniPageEncoding::RAW,
+      static_cast<AttrType>(column.attr_type),
+      column.len,
+      raw_value(col_id, header->sealed_rows),
+      header->row_count - header->sealed_rows);
+  raw_reader.filter(predicate.comp, predicate.value, select + header->sealed_rows);
+  return RC::SUCCESS;
+}
+
+bool PaxRecordPageHandler::is_full() const
+{
+  const PaxPageHeader *header = pax_header();
+  return header->row_count >= page_header_->record_capacity ||
+         header->row_count - header->sealed_rows >= header->raw_capacity;
+}
+
+int PaxRecordPageHandler::free_space_level() const
+{
+  if (is_full()) {
+    return 0;
+  }
+
+  const PaxPageHeader *header   = pax_header();
+  const int            capacity = header->raw_capacity;
+  const int            free_num = capacity - (header->row_count - header->sealed_rows);
+  return (free_num * FSM_MAX_LEVEL + capacity - 1) / capacity;
+}
+
+int PaxRecordPageHandler::row_count() const { return pax_header()->row_count; }
+
+int PaxRecordPageHandler::sealed_row_count() const { return pax_header()->sealed_rows; }
+
+int PaxRecordPageHandler::data_size() const
+{
+  const PaxPageHeader *header = pax_header();
+  return header->raw_start - page_header_->data_offset +
+         (header->row_count - header->sealed_rows) * page_header_->record_real_size;
+}
+
+MiniPageEncoding PaxRecordPageHandler::column_encoding(int col_id) const
+{
+  if (pax_header()->sealed_rows == 0) {
+    return MiniPageEncoding::RAW;
+  }
+  return static_cast<MiniPageEncoding>(mini_pages()[col_id].encoding);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RC VarRecordPageHandler::init_empty_page(
+    DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size, TableMeta *table_meta)
+{
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
+  }
+
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+
+  // 字符串列的长度记为负数，没有表的元数据时整条记录当作一个定长的列
+  vector<int> column_lens;
+  if (table_meta != nullptr) {
+    for (const FieldMeta &field : *table_meta->field_metas()) {
+      column_lens.push_back(field.type() == AttrType::CHARS ? -field.len() : field.len());
+    }
+  } else {
+    column_lens.push_back(record_size);
+  }
+
+  rc = init_var_page(record_size, static_cast<int>(column_lens.size()), column_lens.data());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = log_handler_.init_new_page(
+      frame_, page_num, span((const char *)column_lens.data(), column_lens.size() * sizeof(int)));
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page: write log failed. page_num:record_size %d:%d. rc=%s",
+              page_num, record_size, strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num,
+    int record_size, int col_num, const char *col_idx_data)
+{
+  RC rc = init(buffer_pool, log_handler, page_num, ReadWriteMode::READ_WRITE);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init empty page page_num:record_size %d:%d. rc=%s", page_num, record_size, strrc(rc));
+    return rc;
+  }
+
+  (void)log_handler_.init(log_handler, buffer_pool.id(), record_size, storage_format_);
+  return init_var_page(record_size, col_num, reinterpret_cast<const int *>(col_idx_data));
+}
+
+RC VarRecordPageHandler::init_var_page(int record_size, int col_num, const int *col_lens)
+{
+  int fixed_size = 0;
+  int var_num    = 0;
+  for (int i = 0; i < col_num; i++) {
+    if (col_lens[i] >= 0) {
+      fixed_size += col_lens[i];
+    } else {
+      var_num++;
+    }
+  }
+
+  // 按照最短的记录计算槽位个数，槽位目录按需增长，不会预先占用空间
+  const int min_payload_size = max(1, fixed_size + var_num * static_cast<int>(sizeof(uint16_t)));
+  const int other_size       = col_num * sizeof(int) + sizeof(VarPageHeader) + 8 /*对齐*/;
+
+  page_header_->record_num       = 0;
+  page_header_->column_num       = col_num;
+  page_header_->record_real_size = record_size;
+  page_header_->record_size      = align8(record_size);
+  page_header_->record_capacity =
+      page_record_capacity(BP_PAGE_DATA_SIZE, min_payload_size + sizeof(Slot), other_size);
+  page_header_->col_idx_offset = align8(PAGE_HEADER_SIZE + page_bitmap_size(page_header_->record_capacity));
+  page_header_->data_offset    = page_header_->col_idx_offset + col_num * sizeof(int) + sizeof(VarPageHeader);
+  if (page_header_->record_capacity <= 0 || page_header_->data_offset >= BP_PAGE_DATA_SIZE) {
+    LOG_ERROR("record is too large for var row page. record_size=%d, column_num=%d", record_size, col_num);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  bitmap_ = frame_->data() + PAGE_HEADER_SIZE;
+  memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
+  memcpy(frame_->data() + page_header_->col_idx_offset, col_lens, col_num * sizeof(int));
+
+  VarPageHeader *header  = var_header();
+  header->data_start     = BP_PAGE_DATA_SIZE;
+  header->fragment_size  = 0;
+  header->fixed_size     = fixed_size;
+  header->var_column_num = var_num;
+  header->slot_count     = 0;
+
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+const int *VarRecordPageHandler::column_lens() const
+{
+  return reinterpret_cast<const int *>(frame_->data() + page_header_->col_idx_offset);
+}
+
+VarRecordPageHandler::VarPageHeader *VarRecordPageHandler::var_header() const
+{
+  return reinterpret_cast<VarPageHeader *>(
+      frame_->data() + page_header_->col_idx_offset + page_header_->column_num * sizeof(int));
+}
+
+VarRecordPageHandler::Slot *VarRecordPageHandler::slots() const
+{
+  return reinterpret_cast<Slot *>(frame_->data() + page_header_->data_offset);
+}
+
+int VarRecordPageHandler::slots_end() const
+{
+  return page_header_->data_offset + var_header()->slot_count * sizeof(Slot);
+}
+
+int VarRecordPageHandler::inline_limit() const
+{
+  return max(MAX_INLINE_SIZE, var_header()->fixed_size + static_cast<int>(sizeof(OverflowRef)));
+}
+
+int VarRecordPageHandler::max_payload_size() const
+{
+  const VarPageHeader *header   = var_header();
+  const int           *col_lens = column_lens();
+  int                  max_size = header->fixed_size;
+  for (int i = 0; i < page_header_->column_num; i++) {
+    if (col_lens[i] < 0) {
+      max_size += sizeof(uint16_t) - col_lens[i];
+    }
+  }
+  return min(max_size, inline_limit());
+}
+
+int VarRecordPageHandler::free_space() const
+{
+  const VarPageHeader *header = var_header();
+  return header->data_start - slots_end() + header->fragment_size;
+}
+
+int VarRecordPageHandler::used_space() const
+{
+  const VarPageHeader *header = var_header();
+  return BP_PAGE_DATA_SIZE - header->data_start - header->fragment_size;
+}
+
+bool VarRecordPageHandler::is_full() const
+{
+  // 溢出页面的容量是 0，也当作满的页面
+  if (page_header_->record_num >= page_header_->record_capacity) {
+    return true;
+  }
+  return free_space() < max_payload_size() + static_cast<int>(sizeof(Slot));
+}
+
+int VarRecordPageHandler::free_space_level() const
+{
+  if (is_full()) {
+    return 0;
+  }
+
+  const int capacity   = page_header_->record_capacity;
+  const int free_slots = capacity - page_header_->record_num;
+  const int slot_level = (free_slots * FSM_MAX_LEVEL + capacity - 1) / capacity;
+
+  // 减去一条最长的记录之后剩余的空间，没有满的页面等级至少是 1
+  const int usable     = free_space() - max_payload_size() - static_cast<int>(sizeof(Slot));
+  const int total      = BP_PAGE_DATA_SIZE - page_header_->data_offset;
+  const int byte_level = 1 + usable * (FSM_MAX_LEVEL - 1) / total;
+  return min(slot_level, byte_level);
+}
+
+void VarRecordPageHandler::encode(const char *data, bool &overflow)
+{
+  const VarPageHeader *header   = var_header();
+  const int           *col_lens = column_lens();
+  const int            var_num  = header->var_column_num;
+
+  // 字符串部分先是每个字段的长度，然后是所有字段的内容
+  payload_.resize(header->fixed_size);
+  var_part_.resize(var_num * sizeof(uint16_t));
+  int fixed_pos = 0;
+  int var_index = 0;
+  for (int i = 0; i < page_header_->column_num; i++) {
+    const int len = col_lens[i];
+    if (len >= 0) {
+      memcpy(payload_.data() + fixed_pos, data, len);
+      fixed_pos += len;
+      data += len;
+    } else {
+      const uint16_t value_len = static_cast<uint16_t>(strnlen(data, -len));
+      memcpy(var_part_.data() + var_index * sizeof(uint16_t), &value_len, sizeof(value_len));
+      var_part_.insert(var_part_.end(), data, data + value_len);
+      var_index++;
+      data += -len;
+    }
+  }
+
+  overflow = var_num > 0 && static_cast<int>(payload_.size() + var_part_.size()) > inline_limit();
+  if (overflow) {
+    // 溢出页面的位置在写入溢出页面之后填写
+    payload_.resize(header->fixed_size + sizeof(OverflowRef));
+  } else {
+    payload_.insert(payload_.end(), var_part_.begin(), var_part_.end());
+  }
+}
+
+RC VarRecordPageHandler::decode(const Slot &slot, char *buffer)
+{
+  const VarPageHeader *header   = var_header();
+  const int           *col_lens = column_lens();
+  const char          *payload  = frame_->data() + slot.offset;
+
+  const char *var_part = payload + header->fixed_size;
+  if (slot.length & OVERFLOW_FLAG) {
+    OverflowRef ref;
+    memcpy(&ref, var_part, sizeof(ref));
+    RC rc = read_overflow(ref, overflow_data_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    var_part = overflow_data_.data();
+  }
+
+  const char *var_data  = var_part + header->var_column_num * sizeof(uint16_t);
+  int         var_index = 0;
+  for (int i = 0; i < page_header_->column_num; i++) {
+    const int len = col_lens[i];
+    if (len >= 0) {
+      memcpy(buffer, payload, len);
+      payload += len;
+      buffer += len;
+    } else {
+      uint16_t value_len = 0;
+      memcpy(&value_len, var_part + var_index * sizeof(uint16_t), sizeof(value_len));
+      memcpy(buffer, var_data, value_len);
+      memset(buffer + value_len, 0, -len - value_len);
+      var_data += value_len;
+      buffer += -len;
+      var_index++;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::allocate_space(int size, bool new_slot, uint16_t &offset)
+{
+  VarPageHeader *header = var_header();
+  const int      need   = size + (new_slot ? static_cast<int>(sizeof(Slot)) : 0);
+  if (free_space() < need) {
+    return RC::RECORD_NOMEM;
+  }
+  if (header->data_start - slots_end() < need) {
+    compact();
+  }
+
+  header->data_start -= size;
+  offset = static_cast<uint16_t>(header->data_start);
+  return RC::SUCCESS;
+}
+
+void VarRecordPageHandler::compact()
+{
+  VarPageHeader *header = var_header();
+  Slot          *slot   = slots();
+  char          *data   = frame_->data();
+
+  // 记录可能互相重叠地移动，先复制出来
+  vector<char> copy(data + header->data_start, data + BP_PAGE_DATA_SIZE);
+  int          data_start = BP_PAGE_DATA_SIZE;
+  Bitmap       bitmap(bitmap_, page_header_->record_capacity);
+  for (int i = 0; i < header->slot_count; i++) {
+    const int len = slot[i].length & ~OVERFLOW_FLAG;
+    if (!bitmap.get_bit(i) || len == 0) {
+      continue;
+    }
+    data_start -= len;
+    memcpy(data + data_start, copy.data() + (slot[i].offset - header->data_start), len);
+    slot[i].offset = static_cast<uint16_t>(data_start);
+  }
+
+  header->data_start    = data_start;
+  header->fragment_size = 0;
+  frame_->mark_dirty();
+}
+
+RC VarRecordPageHandler::put_payload(SlotNum slot_num, span<const char> payload, bool overflow)
+{
+  VarPageHeader *header   = var_header();
+  const bool     new_slot = slot_num >= header->slot_count;
+  uint16_t       offset   = 0;
+  RC             rc       = allocate_space(static_cast<int>(payload.size()), new_slot, offset);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (new_slot) {
+    // 中间跳过的槽位没有记录，长度是 0
+    for (int i = header->slot_count; i < slot_num; i++) {
+      slots()[i] = Slot{0, 0};
+    }
+    header->slot_count = slot_num + 1;
+  }
+
+  memcpy(frame_->data() + offset, payload.data(), payload.size());
+  slots()[slot_num] = Slot{offset, static_cast<uint16_t>(payload.size() | (overflow ? OVERFLOW_FLAG : 0))};
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  bitmap.set_bit(slot_num);
+  page_header_->record_num++;
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::write_overflow(const char *data, int len, PageNum &first_page)
+{
+  // 从后向前写，每个页面写入时就知道下一个页面的编号
+  const int page_count = (len + OVERFLOW_DATA_SIZE - 1) / OVERFLOW_DATA_SIZE;
+  PageNum   next_page  = BP_INVALID_PAGE_NUM;
+  for (int i = page_count - 1; i >= 0; i--) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->allocate_page(&frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate overflow page. rc=%s", strrc(rc));
+      if (next_page != BP_INVALID_PAGE_NUM) {
+        free_overflow(next_page);
+      }
+      return rc;
+    }
+
+    const int data_len = min(OVERFLOW_DATA_SIZE, len - i * OVERFLOW_DATA_SIZE);
+    char     *page     = frame->data();
+    memset(page, 0, PAGE_HEADER_SIZE);
+    PageHeader *page_header     = reinterpret_cast<PageHeader *>(page);
+    page_header->col_idx_offset = PAGE_HEADER_SIZE;
+    page_header->data_offset    = PAGE_HEADER_SIZE;
+
+    OverflowPageHeader overflow_header{next_page, data_len};
+    memcpy(page + PAGE_HEADER_SIZE, &overflow_header, sizeof(overflow_header));
+    memcpy(page + PAGE_HEADER_SIZE + sizeof(overflow_header), data + i * OVERFLOW_DATA_SIZE, data_len);
+    frame->mark_dirty();
+
+    rc = log_handler_.overflow_page(frame, span<const char>(page, PAGE_HEADER_SIZE + sizeof(overflow_header) + data_len));
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to log overflow page. page_num=%d, rc=%s", frame->page_num(), strrc(rc));
+      // 与其它写日志的地方一样忽略错误
+    }
+
+    next_page = frame->page_num();
+    disk_buffer_pool_->unpin_page(frame);
+  }
+
+  first_page = next_page;
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::read_overflow(const OverflowRef &ref, vector<char> &data)
+{
+  data.resize(ref.length);
+  int     pos      = 0;
+  PageNum page_num = ref.first_page;
+  while (page_num != BP_INVALID_PAGE_NUM && pos < ref.length) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    OverflowPageHeader header;
+    memcpy(&header, frame->data() + PAGE_HEADER_SIZE, sizeof(header));
+    const int len = min(header.data_len, ref.length - pos);
+    memcpy(data.data() + pos, frame->data() + PAGE_HEADER_SIZE + sizeof(header), len);
+    pos += len;
+    page_num = header.next_page;
+    disk_buffer_pool_->unpin_page(frame);
+  }
+
+  if (pos != ref.length) {
+    LOG_ERROR("overflow pages are broken. first page=%d, length=%d, read=%d", ref.first_page, ref.length, pos);
+    return RC::IOERR_READ;
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::free_overflow(PageNum first_page)
+{
+  PageNum page_num = first_page;
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    OverflowPageHeader header;
+    memcpy(&header, frame->data() + PAGE_HEADER_SIZE, sizeof(header));
+    disk_buffer_pool_->unpin_page(frame);
+
+    // 释放页面时页面不能被引用
+    rc = disk_buffer_pool_->dispose_page(page_num);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to dispose overflow page. page_num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+    page_num = header.next_page;
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::insert_record(const char *data, RID *rid)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot insert record into page while the page is readonly");
+
+  if (page_header_->record_num >= page_header_->record_capacity) {
+    return RC::RECORD_NOMEM;
+  }
+
+  Bitmap        bitmap(bitmap_, page_header_->record_capacity);
+  const SlotNum slot_num = bitmap.next_unsetted_bit(0);
+  const bool    new_slot = slot_num >= var_header()->slot_count;
+
+  bool overflow = false;
+  encode(data, overflow);
+  // 先确认页面放得下再写溢出页面
+  if (free_space() < static_cast<int>(payload_.size() + (new_slot ? sizeof(Slot) : 0))) {
+    return RC::RECORD_NOMEM;
+  }
+
+  if (overflow) {
+    OverflowRef ref{BP_INVALID_PAGE_NUM, static_cast<int32_t>(var_part_.size())};
+    RC          rc = write_overflow(var_part_.data(), ref.length, ref.first_page);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    memcpy(payload_.data() + var_header()->fixed_size, &ref, sizeof(ref));
+  }
+
+  RC rc = put_payload(slot_num, payload_, overflow);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const RID new_rid(get_page_num(), slot_num);
+  rc = log_handler_.put_var_record(frame_, new_rid, payload_, overflow);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // 与行存一样忽略错误
+  }
+
+  if (rid) {
+    *rid = new_rid;
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::insert_records(const char *const *datas, int count, RID *rids, int &inserted)
+{
+  // 按照记录实际的长度插入，直到放不下下一条记录
+  inserted = 0;
+  while (inserted < count) {
+    RC rc = insert_record(datas[inserted], &rids[inserted]);
+    if (rc == RC::RECORD_NOMEM) {
+      break;
+    }
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    inserted++;
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::delete_record(const RID *rid)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot delete record from page while the page is readonly");
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (rid->slot_num >= page_header_->record_capacity || !bitmap.get_bit(rid->slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  const Slot &slot = slots()[rid->slot_num];
+  if (slot.length & OVERFLOW_FLAG) {
+    OverflowRef ref;
+    memcpy(&ref, frame_->data() + slot.offset + var_header()->fixed_size, sizeof(ref));
+    RC rc = free_overflow(ref.first_page);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to free overflow pages of record. rid=%s, rc=%s", rid->to_string().c_str(), strrc(rc));
+      // 溢出页面没有释放只是浪费了空间，继续删除记录
+    }
+  }
+
+  RC rc = recover_delete_record(*rid);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = log_handler_.delete_record(frame_, *rid);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to delete record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // 与行存一样忽略错误
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot update record in page while the page is readonly");
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (rid.slot_num >= page_header_->record_capacity || !bitmap.get_bit(rid.slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  VarPageHeader *header       = var_header();
+  Slot          &slot         = slots()[rid.slot_num];
+  const bool     old_overflow = (slot.length & OVERFLOW_FLAG) != 0;
+  const int      old_len      = slot.length & ~OVERFLOW_FLAG;
+  OverflowRef    old_ref{BP_INVALID_PAGE_NUM, 0};
+  if (old_overflow) {
+    memcpy(&old_ref, frame_->data() + slot.offset + header->fixed_size, sizeof(old_ref));
+  }
+
+  bool overflow = false;
+  encode(data, overflow);
+
+  // 只修改了定长的字段时，比如删除记录时设置事务字段，沿用原来的溢出页面
+  bool keep_overflow = false;
+  if (overflow && old_overflow && old_ref.length == static_cast<int>(var_part_.size())) {
+    RC rc = read_overflow(old_ref, overflow_data_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    keep_overflow = memcmp(overflow_data_.data(), var_part_.data(), var_part_.size()) == 0;
+  }
+
+  const int new_len = static_cast<int>(payload_.size());
+  if (new_len > old_len && free_space() + old_len < new_len) {
+    return RC::RECORD_NOMEM;
+  }
+
+  if (keep_overflow) {
+    memcpy(payload_.data() + header->fixed_size, &old_ref, sizeof(old_ref));
+  } else if (overflow) {
+    OverflowRef ref{BP_INVALID_PAGE_NUM, static_cast<int32_t>(var_part_.size())};
+    RC          rc = write_overflow(var_part_.data(), ref.length, ref.first_page);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    memcpy(payload_.data() + header->fixed_size, &ref, sizeof(ref));
+  }
+
+  if (new_len <= old_len) {
+    // 变短了就在原来的位置上修改，多出来的空间留给整理页面时回收
+    memcpy(frame_->data() + slot.offset, payload_.data(), new_len);
+    header->fragment_size += old_len - new_len;
+  } else {
+    // 原来的空间先算作空洞，这样整理页面时可以回收
+    header->fragment_size += old_len;
+    slot.length = 0;
+    uint16_t offset = 0;
+    RC       rc     = allocate_space(new_len, false /*new_slot*/, offset);
+    ASSERT(OB_SUCC(rc), "space has been checked before");
+    memcpy(frame_->data() + offset, payload_.data(), new_len);
+    slot.offset = offset;
+  }
+  slot.length = static_cast<uint16_t>(new_len | (overflow ? OVERFLOW_FLAG : 0));
+  frame_->mark_dirty();
+
+  if (old_overflow && !keep_overflow) {
+    RC rc = free_overflow(old_ref.first_page);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to free overflow pages of record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+    }
+  }
+
+  RC rc = log_handler_.put_var_record(frame_, rid, payload_, overflow);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // 与行存一样忽略错误
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::get_record(const RID &rid, Record &record)
+{
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  record_buffer_.resize(page_header_->record_real_size);
+  RC rc = decode(slots()[rid.slot_num], record_buffer_.data());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  record.set_rid(rid);
+  record.set_data(record_buffer_.data(), page_header_->record_real_size);
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::get_chunk(Chunk &chunk, const uint8_t *visible)
+{
+  if (table_meta_ == nullptr) {
+    LOG_WARN("cannot get chunk from var row page without table meta. page_num=%d", frame_->page_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  vector<const FieldMeta *> fields(chunk.column_num());
+  for (int i = 0; i < chunk.column_num(); i++) {
+    fields[i] = table_meta_->field(chunk.column_ids(i));
+    if (fields[i] == nullptr) {
+      LOG_WARN("no such field in table. table=%s, field id=%d", table_meta_->name(), chunk.column_ids(i));
+      return RC::SCHEMA_FIELD_NOT_EXIST;
+    }
+  }
+
+  record_buffer_.resize(page_header_->record_real_size);
+  char  *record_data = record_buffer_.data();
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  for (int slot_num = bitmap.next_setted_bit(0); slot_num != -1; slot_num = bitmap.next_setted_bit(slot_num + 1)) {
+    if (visible != nullptr && visible[slot_num] == 0) {
+      continue;
+    }
+    RC rc = decode(slots()[slot_num], record_data);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    // 变长的列只追加字符串实际的内容，定长的列与行存一样
+    for (int i = 0; i < chunk.column_num(); i++) {
+      Column     &column = chunk.column(i);
+      const char *field  = record_data + fields[i]->offset();
+      if (column.is_var_len()) {
+        rc = column.append_var(field, static_cast<int>(strnlen(field, fields[i]->len())));
+      } else {
+        rc = column.append_one(const_cast<char *>(field));
+      }
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append field to column. page_num=%d, slot_num=%d, rc=%s",
+                 frame_->page_num(), slot_num, strrc(rc));
+        return rc;
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::read_int_field(const FieldMeta &field, int32_t *values)
+{
+  // 溢出页面中没有记录
+  if (page_header_->record_capacity == 0) {
+    return RC::SUCCESS;
+  }
+
+  // 定长字段在页面中紧挨着存放，找到字段在编码后的记录中的位置
+  const int *col_lens   = column_lens();
+  int        offset     = 0;
+  int        fixed_pos  = 0;
+  bool       found      = false;
+  for (int i = 0; i < page_header_->column_num && !found; i++) {
+    if (offset == field.offset() && col_lens[i] >= 0) {
+      found = true;
+      break;
+    }
+    offset += abs(col_lens[i]);
+    fixed_pos += max(col_lens[i], 0);
+  }
+  if (!found) {
+    LOG_WARN("field is not a fixed length field of the page. field=%s, page_num=%d", field.name(), frame_->page_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const Slot *slot      = slots();
+  const int   slot_count = var_header()->slot_count;
+  Bitmap      bitmap(bitmap_, page_header_->record_capacity);
+  for (int slot_num = 0; slot_num < page_header_->record_capacity; slot_num++) {
+    if (slot_num < slot_count && bitmap.get_bit(slot_num)) {
+      memcpy(&values[slot_num], frame_->data() + slot[slot_num].offset + fixed_pos, sizeof(int32_t));
+    } else {
+      values[slot_num] = 0;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC VarRecordPageHandler::recover_put_record(const RID &rid, span<const char> payload, bool overflow)
 {
-  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot delete record from page while the page is readonly"); // 确保不是只读模式
-
-  // 检查槽位号是否超出记录容量
   if (rid.slot_num >= page_header_->record_capacity) {
-    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
-              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
-    return RC::INVALID_ARGUMENT; // 返回无效参数
+    LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
+    return RC::RECORD_INVALID_RID;
   }
 
+  // 修改记录时先删除原来的数据，溢出页面由 buffer pool 的日志恢复
   Bitmap bitmap(bitmap_, page_header_->record_capacity);
-  if (bitmap.get_bit(rid.slot_num)) { // 检查槽位是否已被使用
-    frame_->mark_dirty(); // 标记页面为脏
-
-    char *record_data = get_record_data(rid.slot_num); // 获取记录数据
-    if (record_data != data) { // 如果新数据与旧数据不同
-      memcpy(record_data, data, page_header_->record_real_size); // 复制新数据
-    }
-
-    RC rc = log_handler_.update_record(frame_, rid, data); // 记录更新操作
+  if (bitmap.get_bit(rid.slot_num)) {
+    RC rc = recover_delete_record(rid);
     if (OB_FAIL(rc)) {
-      LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s", 
-                disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
-      // return rc; // 忽略错误
+      return rc;
     }
+  }
+  return put_payload(rid.slot_num, payload, overflow);
+}
 
-    return RC::SUCCESS; // 返回成功
-  } else {
-    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
-    return RC::RECORD_NOT_EXIST; // 返回记录不存在
+RC VarRecordPageHandler::recover_delete_record(const RID &rid)
+{
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (rid.slot_num >= page_header_->record_capacity || !bitmap.get_bit(rid.slot_num)) {
+    return RC::RECORD_NOT_EXIST;
   }
+
+  Slot &slot = slots()[rid.slot_num];
+  var_header()->fragment_size += slot.length & ~OVERFLOW_FLAG;
+  slot.length = 0;
+  bitmap.clear_bit(rid.slot_num);
+  page_header_->record_num--;
+  frame_->mark_dirty();
+  return RC::SUCCESS;
 }
 
-RC RowRecordPageHandler::get_record(const RID &rid, Record &record)
+RC VarRecordPageHandler::recover_overflow_page(Frame &frame, span<const char> data)
 {
-  // 检查槽位号是否超出记录容量
-  if (rid.slot_num >= page_header_->record_capacity) {
-    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
-              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
-    return RC::RECORD_INVALID_RID; // 返回无效RID
+  if (data.size() > static_cast<size_t>(BP_PAGE_DATA_SIZE)) {
+    LOG_WARN("invalid overflow page data. size=%d", static_cast<int>(data.size()));
+    return RC::INVALID_ARGUMENT;
   }
+  memcpy(frame.data(), data.data(), data.size());
+  frame.mark_dirty();
+  return RC::SUCCESS;
+}
 
-  Bitmap bitmap(bitmap_, page_header_->record_capacity);
-  if (!bitmap.get_bit(rid.slot_num)) { // 检查槽位是否已被使用
-    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
-    return RC::RECORD_NOT_EXIST; // 返回记录不存在
+////////////////////////////////////////////////////////////////////////////////
+
+void ZoneMap::init(const TableMeta *table_meta)
+{
+  clear();
+  if (table_meta == nullptr) {
+    return;
   }
 
-  record.set_rid(rid); // 设置记录的RID
-  record.set_data(get_record_data(rid.slot_num), page_header_->record_real_size); // 设置记录数据
-  return RC::SUCCESS; // 返回成功
+  // 事务字段会被频繁修改，也不会出现在查询条件中，不需要记录范围
+  const int field_num = table_meta->field_num();
+  column_index_.assign(field_num, -1);
+  for (int i = table_meta->sys_field_num(); i < field_num; i++) {
+    const FieldMeta *field = table_meta->field(i);
+    if (field->type() == AttrType::INTS || field->type() == AttrType::FLOATS || field->type() == AttrType::CHARS) {
+      column_index_[i] = static_cast<int>(zone_columns_.size());
+      zone_columns_.push_back(field);
+    }
+  }
 }
 
-PageNum RecordPageHandler::get_page_num() const
+void ZoneMap::clear()
 {
-  if (nullptr == page_header_) {
-    return (PageNum)(-1); // 如果页面头为空，返回-1
-  }
-  return frame_->page_num(); // 返回页面号
+  unique_lock guard(lock_);
+  zone_columns_.clear();
+  column_index_.clear();
+  pages_.clear();
 }
 
-bool RecordPageHandler::is_full() const { 
-  return page_header_->record_num >= page_header_->record_capacity; // 判断页面是否已满 
+bool ZoneMap::has_zone(PageNum page_num) const
+{
+  shared_lock guard(lock_);
+  return page_num >= 0 && page_num < static_cast<PageNum>(pages_.size()) && pages_[page_num].valid;
 }
 
-RC PaxRecordPageHandler::insert_record(const char *data, RID *rid)
+bool ZoneMap::may_match(PageNum page_num, const vector<ColumnPredicate> &predicates) const
+{
+  if (!enabled() || predicates.empty()) {
+    return true;
+  }
+
+  shared_lock guard(lock_);
+  if (page_num < 0 || page_num >= static_cast<PageNum>(pages_.size()) || !pages_[page_num].valid) {
+    return true;
+  }
+
+  const PageZone &zone = pages_[page_num];
+  if (zone.empty) {
+    return false;
+  }
+  for (const ColumnPredicate &predicate : predicates) {
+    if (predicate.column_id < 0 || predicate.column_id >= static_cast<int>(column_index_.size())) {
+      continue;
+    }
+    const int index = column_index_[predicate.column_id];
+    if (index >= 0 && !column_may_match(zone.columns[index], predicate.comp, predicate.value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ZoneMap::column_may_match(const ColumnZone &zone, CompOp comp, const Value &value)
 {
-  // your code here
-  exit(-1); // 暂未实现
+  // 类型不同时比较的结果不可靠，不跳过页面
+  if (value.attr_type() != zone.min.attr_type()) {
+    return true;
+  }
+
+  switch (comp) {
+    case EQUAL_TO: return zone.min.compare(value) <= 0 && zone.max.compare(value) >= 0;
+    case NOT_EQUAL: return zone.min.compare(value) != 0 || zone.max.compare(value) != 0;
+    case LESS_THAN: return zone.min.compare(value) < 0;
+    case LESS_EQUAL: return zone.min.compare(value) <= 0;
+    case GREAT_THAN: return zone.max.compare(value) > 0;
+    case GREAT_EQUAL: return zone.max.compare(value) >= 0;
+    default: return true;
+  }
 }
 
-RC PaxRecordPageHandler::delete_record(const RID *rid)
+RC ZoneMap::build_zone(RecordPageHandler &record_page_handler)
 {
-  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
-         "cannot delete record from page while the page is readonly"); // 确保不是只读模式
+  if (!enabled()) {
+    return RC::SUCCESS;
+  }
 
-  Bitmap bitmap(bitmap_, page_header_->record_capacity);
-  if (bitmap.get_bit(rid->slot_num)) { // 检查槽位是否已被使用
-    bitmap.clear_bit(rid->slot_num); // 清除槽位
-    page_header_->record_num--; // 更新记录数量
-    frame_->mark_dirty(); // 标记页面为脏
+  PageZone zone;
+  zone.valid = true;
 
-    RC rc = log_handler_.delete_record(frame_, *rid); // 记录删除操作
+  RecordPageIterator iterator;
+  iterator.init(&record_page_handler);
+  Record record;
+  while (iterator.has_next()) {
+    RC rc = iterator.next(record);
     if (OB_FAIL(rc)) {
-      LOG_ERROR("Failed to delete record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
-      // return rc; // 忽略错误
+      LOG_WARN("failed to read record while building zone. page num=%d, rc=%s",
+               record_page_handler.get_page_num(), strrc(rc));
+      return rc;
     }
+    merge_record(zone, record.data());
+  }
 
-    return RC::SUCCESS; // 返回成功
-  } else {
-    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
-    return RC::RECORD_NOT_EXIST; // 返回记录不存在
+  const PageNum page_num = record_page_handler.get_page_num();
+  unique_lock   guard(lock_);
+  if (page_num >= static_cast<PageNum>(pages_.size())) {
+    pages_.resize(page_num + 1);
   }
+  pages_[page_num] = std::move(zone);
+  return RC::SUCCESS;
 }
 
-RC PaxRecordPageHandler::get_record(const RID &rid, Record &record)
+void ZoneMap::reset_zone(PageNum page_num)
 {
-  // your code here
-  exit(-1); // 暂未实现
+  if (!enabled()) {
+    return;
+  }
+
+  unique_lock guard(lock_);
+  if (page_num >= static_cast<PageNum>(pages_.size())) {
+    pages_.resize(page_num + 1);
+  }
+  PageZone &zone = pages_[page_num];
+  zone.valid     = true;
+  zone.empty     = true;
+  zone.columns.clear();
 }
 
-// TODO: 指定需要的列ID，目前获取所有列
-RC PaxRecordPageHandler::get_chunk(Chunk &chunk)
+void ZoneMap::add_record(PageNum page_num, const char *data)
 {
-  // your code here
-  exit(-1); // 暂未实现
+  if (!enabled()) {
+    return;
+  }
+
+  unique_lock guard(lock_);
+  if (page_num < static_cast<PageNum>(pages_.size()) && pages_[page_num].valid) {
+    merge_record(pages_[page_num], data);
+  }
 }
 
-char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id)
+void ZoneMap::remove_record(RecordPageHandler &record_page_handler)
 {
-  int *col_idx = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
-  if (col_id == 0) {
-    return frame_->data() + page_header_->data_offset + (get_field_len(col_id) * slot_num); // 获取字段数据
-  } else {
-    return frame_->data() + page_header_->data_offset + col_idx[col_id - 1] + (get_field_len(col_id) * slot_num); // 获取字段数据
+  if (record_page_handler.record_num() == 0) {
+    reset_zone(record_page_handler.get_page_num());
   }
 }
 
-int PaxRecordPageHandler::get_field_len(int col_id)
+void ZoneMap::invalidate(PageNum page_num)
 {
-  int *col_idx = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
-  if (col_id == 0) {
-    return col_idx[col_id] / page_header_->record_capacity; // 计算字段长度
-  } else {
-    return (col_idx[col_id] - col_idx[col_id - 1]) / page_header_->record_capacity; // 计算字段长度
+  unique_lock guard(lock_);
+  if (page_num < static_cast<PageNum>(pages_.size())) {
+    pages_[page_num].valid = false;
   }
 }
 
+void ZoneMap::merge_record(PageZone &zone, const char *data) const
+{
+  const bool first = zone.empty;
+  zone.empty       = false;
+  zone.columns.resize(zone_columns_.size());
+  for (size_t i = 0; i < zone_columns_.size(); i++) {
+    const FieldMeta *field = zone_columns_[i];
+    Value            value(field->type(), const_cast<char *>(data + field->offset()), field->len());
+    ColumnZone      &column = zone.columns[i];
+    if (first || value.compare(column.min) < 0) {
+      column.min = value;
+    }
+    if (first || value.compare(column.max) > 0) {
+      column.max = value;
+    }
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -504,36 +2032,57 @@ RC RecordFileHandler::init(DiskBufferPool &buffer_pool, LogHandler &log_handler,
   disk_buffer_pool_ = &buffer_pool;
   log_handler_      = &log_handler;
   table_meta_       = table_meta;
+  zone_map_.init(table_meta);
+
+  for (InsertSlot &slot : insert_slots_) {
+    slot.page_handler.reset(RecordPageHandler::create(storage_format_));
+  }
 
-  RC rc = init_free_pages(); // 初始化空闲页面
+  // 空闲空间映射在打开 buffer pool 时就加载了，以前的文件还没有映射时才需要扫描所有页面
+  RC rc = RC::SUCCESS;
+  if (!disk_buffer_pool_->has_free_space_map()) {
+    rc = build_free_space_map();
+  }
 
   LOG_INFO("open record file handle done. rc=%s", strrc(rc)); // 记录打开日志
-  return RC::SUCCESS; // 返回成功
+  return rc;
 }
 
 void RecordFileHandler::close()
 {
   // 关闭记录文件处理器
   if (disk_buffer_pool_ != nullptr) {
-    free_pages_.clear(); // 清空空闲页面列表
+    // 页面处理器在每次插入之后都会清理，这里只需要放弃占用的页面
+    for (InsertSlot &slot : insert_slots_) {
+      slot.page_num = BP_INVALID_PAGE_NUM;
+      slot.page_handler.reset();
+    }
+    claimed_pages_.clear();
+    zone_map_.clear();
+
     disk_buffer_pool_ = nullptr; // 释放指针
     log_handler_      = nullptr;
     table_meta_       = nullptr;
   }
 }
 
-RC RecordFileHandler::init_free_pages()
+RC RecordFileHandler::build_free_space_map()
 {
-  // 遍历当前文件的所有页面，找到没有满的页面
-  // 这个效率很低，会降低启动速度
+  // 遍历当前文件的所有页面，记录每个页面的空闲空间等级
+  // 每个文件只会做一次，之后打开文件时只需要读取映射页面
   // NOTE: 由于是初始化时的动作，所以不需要加锁控制并发
 
-  RC rc = RC::SUCCESS;
+  RC rc = disk_buffer_pool_->create_free_space_map();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create free space map. rc=%s", strrc(rc));
+    return rc;
+  }
 
   BufferPoolIterator bp_iterator;
   bp_iterator.init(*disk_buffer_pool_, 1); // 初始化缓冲池迭代器
   unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
   PageNum current_page_num = 0;
+  int     free_page_num    = 0;
 
   // 遍历缓冲池中的页面
   while (bp_iterator.has_next()) {
@@ -545,78 +2094,186 @@ RC RecordFileHandler::init_free_pages()
       return rc; // 初始化失败，返回错误码
     }
 
-    // 如果页面未满，将其添加到空闲页面列表
+    // 记录页面的空闲空间等级
     if (!record_page_handler->is_full()) {
-      free_pages_.insert(current_page_num);
+      free_page_num++;
+      update_free_space(*record_page_handler);
     }
     record_page_handler->cleanup(); // 清理页面处理器
   }
-  LOG_INFO("record file handler init free pages done. free page num=%d, rc=%s", free_pages_.size(), strrc(rc));
+  LOG_INFO("record file handler build free space map done. free page num=%d, rc=%s", free_page_num, strrc(rc));
   return rc; // 返回成功
 }
 
+void RecordFileHandler::update_free_space(RecordPageHandler &record_page_handler)
+{
+  // 空闲空间映射只是一个提示，更新失败时页面的空间可能用不上，但不会影响数据的正确性
+  const PageNum page_num = record_page_handler.get_page_num();
+  RC            rc       = disk_buffer_pool_->set_free_space_level(page_num, record_page_handler.free_space_level());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to update free space level. page num=%d, rc=%s", page_num, strrc(rc));
+  }
+}
+
+RecordFileHandler::InsertSlot &RecordFileHandler::insert_slot()
+{
+  // 按照线程第一次插入的顺序编号，线程数不超过槽位数时每个线程都有自己的槽位
+  static atomic<int> next_thread_index{0};
+  thread_local const int thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+  return insert_slots_[thread_index % INSERT_SLOT_NUM];
+}
+
 RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
+{
+  InsertSlot &slot = insert_slot();
+  scoped_lock slot_guard(slot.lock);
+
+  RecordPageHandler &record_page_handler = *slot.page_handler;
+  RC                 ret                 = open_free_page(slot, record_size, *log_handler_);
+  if (OB_FAIL(ret)) {
+    return ret;
+  }
+
+  // 找到空闲位置，插入记录
+  ret = record_page_handler.insert_record(data, rid);
+  if (OB_SUCC(ret)) {
+    inserted_record_count_.fetch_add(1, std::memory_order_relaxed);
+    update_free_space(record_page_handler);
+    zone_map_.add_record(rid->page_num, data);
+  }
+  record_page_handler.cleanup();
+  return ret;
+}
+
+RC RecordFileHandler::insert_records(
+    const vector<const char *> &datas, int record_size, vector<RID> &rids, bool logging)
 {
   RC ret = RC::SUCCESS;
 
-  unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
-  bool page_found = false; // 标记是否找到合适的页面
-  PageNum current_page_num = 0;
+  VacuousLogHandler vacuous_log_handler;
+  LogHandler       &log_handler = logging ? *log_handler_ : vacuous_log_handler;
+
+  rids.resize(datas.size());
+  const int total = static_cast<int>(datas.size());
+  int       pos   = 0;
+
+  // 回滚时删除记录不需要占用槽位，所以槽位的锁只在插入时持有
+  {
+    InsertSlot        &slot = insert_slot();
+    scoped_lock        slot_guard(slot.lock);
+    RecordPageHandler &record_page_handler = *slot.page_handler;
+    while (pos < total) {
+      ret = open_free_page(slot, record_size, log_handler);
+      if (OB_FAIL(ret)) {
+        break;
+      }
+
+      // 页面只加载、加锁一次，放得下多少就插入多少
+      int inserted = 0;
+      ret = record_page_handler.insert_records(datas.data() + pos, total - pos, rids.data() + pos, inserted);
+      if (inserted > 0) {
+        update_free_space(record_page_handler);
+        for (int i = pos; i < pos + inserted; i++) {
+          zone_map_.add_record(rids[i].page_num, datas[i]);
+        }
+      }
+      pos += inserted;
+      const PageNum page_num = record_page_handler.get_page_num();
+      record_page_handler.cleanup();
+      if (OB_FAIL(ret)) {
+        LOG_WARN("failed to insert records into page. page num=%d, rc=%s", page_num, strrc(ret));
+        break;
+      }
+    }
+  }
 
-  // 当前要访问free_pages对象，所以需要加锁
-  lock_.lock(); // 加锁以保证线程安全
+  inserted_record_count_.fetch_add(pos, std::memory_order_relaxed);
+
+  if (OB_FAIL(ret)) {
+    // 删除已经插入的记录，保证要么都插入，要么都不插入
+    for (int i = 0; i < pos; i++) {
+      RC rc = delete_record(&rids[i], log_handler);
+      if (OB_FAIL(rc)) {
+        LOG_ERROR("failed to delete record while rollback batch insert. rid=%s, rc=%s",
+                  rids[i].to_string().c_str(), strrc(rc));
+      }
+    }
+    rids.clear();
+  }
+  return ret;
+}
 
-  // 找到没有填满的页面
-  while (!free_pages_.empty()) {
-    current_page_num = *free_pages_.begin(); // 获取第一个空闲页面
+RC RecordFileHandler::open_free_page(InsertSlot &slot, int record_size, LogHandler &log_handler)
+{
+  RC                 ret                 = RC::SUCCESS;
+  RecordPageHandler &record_page_handler = *slot.page_handler;
 
-    ret = record_page_handler->init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_WRITE);
+  // 优先使用槽位当前的目标页面，满了再从空闲空间映射中找一个其它槽位没有占用的页面
+  while (slot.page_num != BP_INVALID_PAGE_NUM || (slot.page_num = claim_free_page()) != BP_INVALID_PAGE_NUM) {
+    ret = record_page_handler.init(*disk_buffer_pool_, log_handler, slot.page_num, ReadWriteMode::READ_WRITE);
     if (OB_FAIL(ret)) {
-      lock_.unlock(); // 解锁
-      LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
+      LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", slot.page_num, ret, strrc(ret));
+      release_insert_page(slot);
       return ret; // 初始化失败，返回错误码
     }
 
-    if (!record_page_handler->is_full()) { // 检查页面是否未满
-      page_found = true; // 标记已找到合适页面
-      break; // 退出循环
+    if (!record_page_handler.is_full()) { // 检查页面是否未满
+      return RC::SUCCESS;
     }
-    record_page_handler->cleanup(); // 清理页面处理器
-    free_pages_.erase(free_pages_.begin()); // 移除已检查的页面
+    // 页面填满了，或者映射中的等级已经过时了，比如刚刚有其它的插入路径填满了这个页面
+    update_free_space(record_page_handler);
+    record_page_handler.cleanup(); // 清理页面处理器
+    release_insert_page(slot);
   }
-  lock_.unlock(); // 解锁
 
   // 找不到就分配一个新的页面
-  if (!page_found) {
-    Frame *frame = nullptr;
-    // 分配新页面
-    if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
-      LOG_ERROR("Failed to allocate page while inserting record. ret:%d", ret);
-      return ret; // 分配失败，返回错误码
-    }
+  Frame *frame = nullptr;
+  if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
+    LOG_ERROR("Failed to allocate page while inserting record. ret:%d", ret);
+    return ret; // 分配失败，返回错误码
+  }
 
-    current_page_num = frame->page_num(); // 获取新页面号
+  const PageNum current_page_num = frame->page_num(); // 获取新页面号
 
-    // 初始化空页面
-    ret = record_page_handler->init_empty_page(
-        *disk_buffer_pool_, *log_handler_, current_page_num, record_size, table_meta_);
-    if (OB_FAIL(ret)) {
-      frame->unpin(); // 释放页面
-      LOG_ERROR("Failed to init empty page. ret:%d", ret);
-      return ret; // 初始化失败，返回错误码
-    }
+  // 初始化空页面
+  ret = record_page_handler.init_empty_page(
+      *disk_buffer_pool_, log_handler, current_page_num, record_size, table_meta_);
+  // 手动释放一个页面引用
+  frame->unpin();
+  if (OB_FAIL(ret)) {
+    LOG_ERROR("Failed to init empty page. ret:%d", ret);
+    return ret; // 初始化失败，返回错误码
+  }
 
-    // 手动释放一个页面引用
-    frame->unpin();
+  // 新页面上的记录都会经过这里插入，从空范围开始就可以一直维护它的区域映射
+  zone_map_.reset_zone(current_page_num);
+
+  // 新页面还没有插入记录，不在空闲空间映射中，其它槽位找不到它。插入记录之后再更新它的等级
+  scoped_lock claim_guard(claim_lock_);
+  claimed_pages_.insert(current_page_num);
+  slot.page_num = current_page_num;
+  return RC::SUCCESS;
+}
 
-    // 加锁顺序不会出现死锁
-    lock_.lock();
-    free_pages_.insert(current_page_num); // 将新页面加入空闲页面列表
-    lock_.unlock();
+PageNum RecordFileHandler::claim_free_page()
+{
+  scoped_lock claim_guard(claim_lock_);
+  // 被占用的页面最多只有槽位数那么多个，跳过它们的代价是固定的
+  PageNum page_num = disk_buffer_pool_->find_free_space_page();
+  while (page_num != BP_INVALID_PAGE_NUM && claimed_pages_.count(page_num) > 0) {
+    page_num = disk_buffer_pool_->find_free_space_page(page_num + 1);
+  }
+  if (page_num != BP_INVALID_PAGE_NUM) {
+    claimed_pages_.insert(page_num);
   }
+  return page_num;
+}
 
-  // 找到空闲位置，插入记录
-  return record_page_handler->insert_record(data, rid);
+void RecordFileHandler::release_insert_page(InsertSlot &slot)
+{
+  scoped_lock claim_guard(claim_lock_);
+  claimed_pages_.erase(slot.page_num);
+  slot.page_num = BP_INVALID_PAGE_NUM;
 }
 
 RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
@@ -632,35 +2289,34 @@ RC RecordFileHandler::recover_insert_record(const char *data, int record_size, c
     return ret; // 初始化失败，返回错误码
   }
 
-  // 恢复插入记录
+  // 恢复插入记录。恢复时的插入不需要维护区域映射，让页面的范围在下次扫描时重新计算
+  zone_map_.invalidate(rid.page_num);
   return record_page_handler->recover_insert_record(data, rid);
 }
 
-RC RecordFileHandler::delete_record(const RID *rid)
+RC RecordFileHandler::delete_record(const RID *rid) { return delete_record(rid, *log_handler_); }
+
+RC RecordFileHandler::delete_record(const RID *rid, LogHandler &log_handler)
 {
   RC rc = RC::SUCCESS;
 
   unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
 
   // 初始化页面处理器
-  rc = record_page_handler->init(*disk_buffer_pool_, *log_handler_, rid->page_num, ReadWriteMode::READ_WRITE);
+  rc = record_page_handler->init(*disk_buffer_pool_, log_handler, rid->page_num, ReadWriteMode::READ_WRITE);
   if (OB_FAIL(rc)) {
     LOG_ERROR("Failed to init record page handler.page number=%d. rc=%s", rid->page_num, strrc(rc));
     return rc; // 初始化失败，返回错误码
   }
 
   rc = record_page_handler->delete_record(rid); // 删除记录
-  // 注意要清理掉资源，否则会与insert_record中的加锁顺序冲突而可能出现死锁
-  // delete record的加锁逻辑是拿到页面锁，删除指定记录，然后加上和释放record manager锁
-  // insert record是加上record manager锁，然后拿到指定页面锁再释放record manager锁
-  record_page_handler->cleanup(); // 清理页面处理器
   if (OB_SUCC(rc)) {
-    // 因为这里已经释放了页面锁，可能其他线程已将该页面填满
-    lock_.lock();
-    free_pages_.insert(rid->page_num); // 将页面加入空闲页面列表
-    LOG_TRACE("add free page %d to free page list", rid->page_num);
-    lock_.unlock();
+    deleted_record_count_.fetch_add(1, std::memory_order_relaxed);
+    // 持有页面锁时更新空闲空间映射，与其它线程对这个页面的更新不会乱序
+    update_free_space(*record_page_handler);
+    zone_map_.remove_record(*record_page_handler);
   }
+  record_page_handler->cleanup(); // 清理页面处理器
   return rc; // 返回结果
 }
 
@@ -718,12 +2374,56 @@ RC RecordFileHandler::visit_record(const RID &rid, function<bool(Record &)> upda
   bool updated = updater(record);
   if (updated) {
     rc = page_handler->update_record(rid, record.data());
+    if (OB_SUCC(rc)) {
+      zone_map_.add_record(rid.page_num, record.data());
+    }
   }
   return rc;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void PageVisibilityFilter::init(Table *table, Trx *trx)
+{
+  trx_             = nullptr;
+  begin_xid_field_ = nullptr;
+  end_xid_field_   = nullptr;
+  if (table == nullptr || trx == nullptr) {
+    return;
+  }
+
+  // 没有使用 MVCC 时表上没有事务字段，所有记录都可见
+  span<const FieldMeta> trx_fields = table->table_meta().trx_fields();
+  if (trx_fields.size() < 2) {
+    return;
+  }
+
+  trx_             = trx;
+  begin_xid_field_ = &trx_fields[0];
+  end_xid_field_   = &trx_fields[1];
+}
+
+RC PageVisibilityFilter::filter_page(RecordPageHandler &record_page_handler)
+{
+  const int capacity = record_page_handler.record_capacity();
+  begin_xids_.resize(capacity);
+  end_xids_.resize(capacity);
+  visible_.assign(capacity, 1);
+
+  RC rc = record_page_handler.read_int_field(*begin_xid_field_, begin_xids_.data());
+  if (OB_SUCC(rc)) {
+    rc = record_page_handler.read_int_field(*end_xid_field_, end_xids_.data());
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  trx_->filter_visible_records(begin_xids_.data(), end_xids_.data(), capacity, visible_.data());
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 RecordFileScanner::~RecordFileScanner() { close_scan(); } // 析构函数，关闭扫描
 
 RC RecordFileScanner::open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, LogHandler &log_handler,
@@ -738,6 +2438,17 @@ RC RecordFileScanner::open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *
   log_handler_      = &log_handler;
   rw_mode_          = mode;
 
+  sample_ratio_       = 1.0;
+  scanned_page_count_ = 0;
+  skipped_page_count_ = 0;
+  zone_map_           = (table != nullptr && table->record_handler() != nullptr) ? &table->record_handler()->zone_map()
+                                                                                 : nullptr;
+  zone_predicates_.clear();
+
+  // 读写扫描时需要逐条检查访问冲突，不能批量判断
+  visibility_filter_.init(mode == ReadWriteMode::READ_ONLY ? table : nullptr, trx);
+  page_filtered_ = false;
+
   // 初始化缓冲池迭代器
   RC rc = bp_iterator_.init(buffer_pool, 1);
   if (rc != RC::SUCCESS) {
@@ -749,6 +2460,8 @@ RC RecordFileScanner::open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *
   // 根据表的存储格式选择记录页面处理器
   if (table == nullptr || table->table_meta().storage_format() == StorageFormat::ROW_FORMAT) {
     record_page_handler_ = new RowRecordPageHandler(); // 行格式处理器
+  } else if (table->table_meta().storage_format() == StorageFormat::VAR_ROW_FORMAT) {
+    record_page_handler_ = new VarRecordPageHandler(&table->table_meta()); // 变长行格式处理器
   } else {
     record_page_handler_ = new PaxRecordPageHandler(); // 列格式处理器
   }
@@ -777,6 +2490,18 @@ RC RecordFileScanner::fetch_next_record()
   // 上一个页面遍历完，或者还没有开始遍历某个页面
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next(); // 获取下一个页面号
+    if (sample_ratio_ < 1.0 && std::generate_canonical<double, 32>(sample_random_) >= sample_ratio_) {
+      skipped_page_count_++; // 没有被采样到的页面不读取
+      continue;
+    }
+    // 页面的取值范围与条件不相交，不需要加载页面
+    const bool use_zone_map = zone_map_ != nullptr && !zone_predicates_.empty();
+    if (use_zone_map && !zone_map_->may_match(page_num, zone_predicates_)) {
+      skipped_page_count_++;
+      continue;
+    }
+    scanned_page_count_++;
+
     record_page_handler_->cleanup(); // 清理页面处理器
     rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_); // 初始化页面处理器
     if (OB_FAIL(rc)) {
@@ -784,6 +2509,26 @@ RC RecordFileScanner::fetch_next_record()
       return rc; // 初始化失败，返回错误码
     }
 
+    // 第一次带条件访问这个页面，计算它的范围，之后的扫描就可以跳过它了
+    if (use_zone_map && !zone_map_->has_zone(page_num)) {
+      rc = zone_map_->build_zone(*record_page_handler_);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    // 一次判断整个页面上记录的可见性，页面格式不支持时再逐条判断
+    page_filtered_ = false;
+    if (visibility_filter_.enabled()) {
+      rc = visibility_filter_.filter_page(*record_page_handler_);
+      if (OB_SUCC(rc)) {
+        page_filtered_ = true;
+      } else if (rc != RC::UNIMPLEMENTED) {
+        LOG_WARN("failed to filter visible records in page. page_num=%d, rc=%s", page_num, strrc(rc));
+        return rc;
+      }
+    }
+
     record_page_iterator_.init(record_page_handler_); // 初始化记录页面迭代器
     rc = fetch_next_record_in_page(); // 尝试获取下一条记录
     if (rc == RC::SUCCESS || rc != RC::RECORD_EOF) {
@@ -811,13 +2556,18 @@ RC RecordFileScanner::fetch_next_record_in_page()
       return rc; // 获取记录失败，返回错误码
     }
 
+    // 页面上记录的可见性已经判断过了，不可见的记录不需要再做条件过滤
+    if (page_filtered_ && !visibility_filter_.is_visible(next_record_.rid().slot_num)) {
+      continue;
+    }
+
     // 如果有过滤条件，则应用过滤
     if (condition_filter_ != nullptr && !condition_filter_->filter(next_record_)) {
       continue; // 过滤掉不符合条件的记录
     }
 
     // 如果是某个事务上遍历数据，还要看看事务访问是否有冲突
-    if (trx_ == nullptr) {
+    if (trx_ == nullptr || page_filtered_) {
       return rc; // 如果没有事务，直接返回
     }
 
@@ -854,6 +2604,12 @@ RC RecordFileScanner::close_scan()
   return RC::SUCCESS; // 返回成功状态
 }
 
+void RecordFileScanner::set_page_sample(double ratio, uint32_t seed)
+{
+  sample_ratio_ = std::clamp(ratio, 0.0, 1.0);
+  sample_random_.seed(seed);
+}
+
 RC RecordFileScanner::next(Record &record)
 {
   RC rc = fetch_next_record(); // 获取下一条记录
@@ -871,7 +2627,11 @@ RC RecordFileScanner::update_current(const Record &record)
     return RC::INVALID_ARGUMENT; // 如果记录ID不匹配，返回无效参数
   }
 
-  return record_page_handler_->update_record(record.rid(), record.data()); // 更新当前记录
+  RC rc = record_page_handler_->update_record(record.rid(), record.data()); // 更新当前记录
+  if (OB_SUCC(rc) && zone_map_ != nullptr) {
+    zone_map_->add_record(record.rid().page_num, record.data());
+  }
+  return rc;
 }
 
 ChunkFileScanner::~ChunkFileScanner() { close_scan(); } // 析构函数，关闭扫描
@@ -883,16 +2643,21 @@ RC ChunkFileScanner::close_scan()
   }
 
   if (record_page_handler_ != nullptr) {
-    record_page_handler_->cleanup(); // 清理页面处理器
+    cleanup_page(); // 释放当前页面
     delete record_page_handler_; // 删除处理器对象
     record_page_handler_ = nullptr; // 清空指针
   }
 
+  predicates_.clear();
+  zone_predicates_.clear();
+  morsel_iterator_ = nullptr;
+  morsel_pages_.clear();
+  morsel_pos_ = 0;
   return RC::SUCCESS; // 返回成功状态
 }
 
 RC ChunkFileScanner::open_scan_chunk(
-    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode)
+    Table *table, DiskBufferPool &buffer_pool, Trx *trx, LogHandler &log_handler, ReadWriteMode mode)
 {
   close_scan(); // 关闭之前的扫描
 
@@ -901,6 +2666,12 @@ RC ChunkFileScanner::open_scan_chunk(
   disk_buffer_pool_ = &buffer_pool;
   log_handler_      = &log_handler;
   rw_mode_          = mode;
+  visibility_filter_.init(table, trx);
+
+  zone_map_           = (table != nullptr && table->record_handler() != nullptr) ? &table->record_handler()->zone_map()
+                                                                                 : nullptr;
+  scanned_page_count_ = 0;
+  skipped_page_count_ = 0;
 
   // 初始化缓冲池迭代器
   RC rc = bp_iterator_.init(buffer_pool, 1);
@@ -909,9 +2680,11 @@ RC ChunkFileScanner::open_scan_chunk(
     return rc; // 返回初始化失败的状态
   }
 
-  // 根据表的存储格式选择记录页面处理器
+  // 根据表的存储格式选择记录页面处理器，行格式需要根据表的元数据找到每一列的位置
   if (table == nullptr || table->table_meta().storage_format() == StorageFormat::ROW_FORMAT) {
-    record_page_handler_ = new RowRecordPageHandler(); // 行格式处理器
+    record_page_handler_ = new RowRecordPageHandler(table == nullptr ? nullptr : &table->table_meta());
+  } else if (table->table_meta().storage_format() == StorageFormat::VAR_ROW_FORMAT) {
+    record_page_handler_ = new VarRecordPageHandler(&table->table_meta());
   } else {
     record_page_handler_ = new PaxRecordPageHandler(); // 列格式处理器
   }
@@ -921,18 +2694,66 @@ RC ChunkFileScanner::open_scan_chunk(
 
 RC ChunkFileScanner::next_chunk(Chunk &chunk)
 {
-  RC rc = RC::SUCCESS;
+  RC      rc       = RC::SUCCESS;
+  PageNum page_num = BP_INVALID_PAGE_NUM;
+
+  while (next_page(page_num)) {
+    cleanup_page(); // 释放上一个页面
+    if (skip_page(page_num)) {
+      skipped_page_count_++;
+      continue;
+    }
+    scanned_page_count_++;
 
-  while (bp_iterator_.has_next()) {
-    PageNum page_num = bp_iterator_.next(); // 获取下一个页面号
-    record_page_handler_->cleanup(); // 清理页面处理器
-    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_); // 初始化页面处理器
+    if (morsel_iterator_ != nullptr) {
+      rc = morsel_iterator_->open_page(*record_page_handler_, page_num, rw_mode_);
+    } else {
+      rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_); // 初始化页面处理器
+    }
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc; // 初始化失败，返回错误码
     }
-    rc = record_page_handler_->get_chunk(chunk); // 获取数据块
+
+    // 第一次带条件访问这个页面，计算它的范围
+    const bool has_predicates = !predicates_.empty() || !zone_predicates_.empty();
+    if (zone_map_ != nullptr && has_predicates && !zone_map_->has_zone(page_num)) {
+      rc = zone_map_->build_zone(*record_page_handler_);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+    const uint8_t *visible = nullptr;
+    if (visibility_filter_.enabled()) {
+      rc = visibility_filter_.filter_page(*record_page_handler_);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to filter visible records in page. page_num=%d, rc=%s", page_num, strrc(rc));
+        return rc;
+      }
+      visible = visibility_filter_.visible();
+    }
+    if (!predicates_.empty()) {
+      const int capacity = record_page_handler_->record_capacity();
+      if (visible != nullptr) {
+        select_.assign(visible, visible + capacity);
+      } else {
+        select_.assign(capacity, 1);
+      }
+      for (const ColumnPredicate &predicate : predicates_) {
+        rc = record_page_handler_->filter_column(predicate, select_.data());
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to filter records in page. page_num=%d, column id=%d, rc=%s",
+                   page_num, predicate.column_id, strrc(rc));
+          return rc;
+        }
+      }
+      visible = select_.data();
+    }
+    rc = record_page_handler_->get_chunk(chunk, visible); // 获取数据块
     if (rc == RC::SUCCESS) {
+      if (chunk.rows() == 0 && chunk.column_num() > 0) {
+        continue;  // 页面上的记录都删除了
+      }
       return rc; // 返回成功状态
     } else if (rc == RC::RECORD_EOF) {
       break; // 数据块已遍历完
@@ -942,7 +2763,82 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
     }
   }
 
-  record_page_handler_->cleanup(); // 清理页面处理器
+  cleanup_page(); // 释放最后一个页面
   return RC::RECORD_EOF; // 返回记录结束状态
 }
 
+bool ChunkFileScanner::next_page(PageNum &page_num)
+{
+  if (morsel_iterator_ == nullptr) {
+    if (!bp_iterator_.has_next()) {
+      return false;
+    }
+    page_num = bp_iterator_.next();
+    return true;
+  }
+
+  if (morsel_pos_ >= morsel_pages_.size()) {
+    morsel_pos_ = 0;
+    if (!morsel_iterator_->next_morsel(morsel_pages_)) {
+      return false;
+    }
+  }
+  page_num = morsel_pages_[morsel_pos_++];
+  return true;
+}
+
+bool ChunkFileScanner::skip_page(PageNum page_num) const
+{
+  if (zone_map_ == nullptr) {
+    return false;
+  }
+  return !zone_map_->may_match(page_num, predicates_) || !zone_map_->may_match(page_num, zone_predicates_);
+}
+
+void ChunkFileScanner::cleanup_page()
+{
+  if (morsel_iterator_ != nullptr) {
+    morsel_iterator_->close_page(*record_page_handler_);
+  } else {
+    record_page_handler_->cleanup();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RC PageMorselIterator::init(DiskBufferPool &buffer_pool, LogHandler &log_handler, int morsel_pages)
+{
+  lock_guard guard(lock_);
+  disk_buffer_pool_ = &buffer_pool;
+  log_handler_      = &log_handler;
+  morsel_pages_     = max(morsel_pages, 1);
+
+  RC rc = bp_iterator_.init(buffer_pool, 1);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
+  }
+  return rc;
+}
+
+bool PageMorselIterator::next_morsel(vector<PageNum> &pages)
+{
+  lock_guard guard(lock_);
+  pages.clear();
+  while (static_cast<int>(pages.size()) < morsel_pages_ && bp_iterator_.has_next()) {
+    pages.push_back(bp_iterator_.next());
+  }
+  return !pages.empty();
+}
+
+RC PageMorselIterator::open_page(RecordPageHandler &handler, PageNum page_num, ReadWriteMode mode)
+{
+  lock_guard guard(lock_);
+  return handler.init(*disk_buffer_pool_, *log_handler_, page_num, mode);
+}
+
+void PageMorselIterator::close_page(RecordPageHandler &handler)
+{
+  lock_guard guard(lock_);
+  handler.cleanup();
+}
+
@@ -14,12 +14,18 @@ See the Mulan PSL v2 for more details. */
 //
 #pragma once
 
+#include "common/lang/atomic.h"
 #include "common/lang/bitmap.h"
+#include "common/lang/random.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
 #include "common/lang/sstream.h"
+#include "common/lang/unordered_set.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/common/chunk.h"
 #include "storage/record/record.h"
 #include "storage/record/record_log.h"
+#include "storage/record/pax_minipage.h"
 #include "common/types.h"
 
 class LogHandler;
@@ -28,6 +34,7 @@ class RecordPageHandler;
 class LogHandler;
 class Trx;
 class Table;
+class FieldMeta;
 
 /**
  * @brief 这里负责管理在一个文件上表记录(行)的组织/管理
@@ -118,6 +125,17 @@ private:
   SlotNum            next_slot_num_ = 0;  ///< 当前遍历到了哪一个slot
 };
 
+/**
+ * @brief 下推到页面上的过滤条件：`列 comp 常量`
+ * @ingroup RecordManager
+ */
+struct ColumnPredicate
+{
+  int    column_id;  ///< 列在表的所有字段中的下标，与 Chunk 中的列编号相同
+  CompOp comp;
+  Value  value;
+};
+
 /**
  * @brief 负责处理一个页面中各种操作，比如插入记录、删除记录或者查找记录
  * @ingroup RecordManager
@@ -154,7 +172,7 @@ public:
    * @param record_size 每个记录的大小
    * @param table_meta  表的元数据
    */
-  RC init_empty_page(
+  virtual RC init_empty_page(
       DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size, TableMeta *table_meta);
 
   /**
@@ -165,7 +183,7 @@ public:
    * @param col_num  表中包含的列数
    * @param col_idx_data 列索引数据
    */
-  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+  virtual RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
       int col_num, const char *col_idx_data);
 
   /**
@@ -181,6 +199,16 @@ public:
    */
   virtual RC insert_record(const char *data, RID *rid) { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 在当前页面中插入尽可能多的记录
+   * @details 默认实现逐条调用 insert_record，页面满了就停止。
+   * @param datas    要插入的记录
+   * @param count    记录的个数
+   * @param rids     返回每条插入成功的记录的位置
+   * @param inserted 返回插入成功的记录个数，页面放不下时小于 count
+   */
+  virtual RC insert_records(const char *const *datas, int count, RID *rids, int &inserted);
+
   /**
    * @brief 数据库恢复时，在指定位置插入数据
    *
@@ -213,10 +241,23 @@ public:
   /**
    * @brief 获取整个页面中指定列的所有记录。
    *
-   * @param chunk 由 chunk.column(i).col_id() 指定列。
-   * 只需由 PaxRecordPageHandler 实现。
+   * @param chunk   由 chunk.column(i).col_id() 指定列。
+   * @param visible 按槽位号索引的选择向量，为 0 的记录不拷贝。为空时拷贝所有记录
    */
-  virtual RC get_chunk(Chunk &chunk) { return RC::UNIMPLEMENTED; }
+  virtual RC get_chunk(Chunk &chunk, const uint8_t *visible = nullptr) { return RC::UNIMPLEMENTED; }
+
+  /**
+   * @brief 读取页面上每个槽位中某个 int 字段的值，没有记录的槽位也会读取
+   * @details 用于一次判断整个页面上记录的事务可见性
+   * @param values 按槽位号索引，至少要有 record_capacity() 个元素
+   */
+  virtual RC read_int_field(const FieldMeta &field, int32_t *values) { return RC::UNIMPLEMENTED; }
+
+  /**
+   * @brief 判断页面上每个槽位中的记录是否满足过滤条件，不满足的把 select 中对应的位置置为 0
+   * @param select 按槽位号索引，至少要有 record_capacity() 个元素
+   */
+  virtual RC filter_column(const ColumnPredicate &predicate, uint8_t *select) { return RC::UNIMPLEMENTED; }
 
   /**
    * @brief 返回该记录页的页号
@@ -226,7 +267,27 @@ public:
   /**
    * @brief 当前页面是否已经没有空闲位置插入新的记录
    */
-  bool is_full() const;
+  virtual bool is_full() const;
+
+  /**
+   * @brief 页面在空闲空间映射中的等级，按空闲位置占总位置的比例计算，页面满了是 0
+   */
+  virtual int free_space_level() const;
+
+  /**
+   * @brief 页面中每条记录的实际大小
+   */
+  int record_size() const { return page_header_->record_real_size; }
+
+  /**
+   * @brief 页面最多可以存放的记录数，也就是槽位的个数
+   */
+  int record_capacity() const { return page_header_->record_capacity; }
+
+  /**
+   * @brief 页面上当前的记录数
+   */
+  int record_num() const { return page_header_->record_num; }
 
 protected:
   /**
@@ -280,10 +341,21 @@ protected:
 class RowRecordPageHandler : public RecordPageHandler
 {
 public:
-  RowRecordPageHandler() : RecordPageHandler(StorageFormat::ROW_FORMAT) {}
+  /**
+   * @param table_meta 表的元数据，用来找到每一列在记录中的位置。只有 get_chunk 需要
+   */
+  explicit RowRecordPageHandler(const TableMeta *table_meta = nullptr)
+      : RecordPageHandler(StorageFormat::ROW_FORMAT), table_meta_(table_meta)
+  {}
 
   virtual RC insert_record(const char *data, RID *rid) override;
 
+  /**
+   * @brief 在当前页面中插入尽可能多的记录
+   * @details 所有记录只写一条日志
+   */
+  virtual RC insert_records(const char *const *datas, int count, RID *rids, int &inserted) override;
+
   virtual RC recover_insert_record(const char *data, const RID &rid) override;
 
   virtual RC delete_record(const RID *rid) override;
@@ -297,57 +369,439 @@ public:
    * @param record 返回指定的数据。这里不会将数据复制出来，而是使用指针，所以调用者必须保证数据使用期间受到保护
    */
   virtual RC get_record(const RID &rid, Record &record) override;
+
+  /**
+   * @brief 把页面中所有记录的指定列拷贝到 chunk 中
+   * @details 需要在构造时传入表的元数据
+   */
+  virtual RC get_chunk(Chunk &chunk, const uint8_t *visible = nullptr) override;
+
+  virtual RC read_int_field(const FieldMeta &field, int32_t *values) override;
+
+private:
+  const TableMeta *table_meta_ = nullptr;
 };
 
 /**
  * @brief 负责处理 PAX 存储格式的页面中各种操作
  * @ingroup RecordManager
- * @details PAX 格式实现，当前定长记录模式下每个页面的组织大概是这样的：
+ * @details PAX 格式实现，每个页面的组织大概是这样的：
  * @code
- * | PageHeader | record allocate bitmap | column index  |
- * |------------|------------------------| ------------- |
- * | column1 | column2 | ..................... | columnN |
+ * | PageHeader | record allocate bitmap | column index | PaxPageHeader | minipage index |
+ * |-----------------------------------------------------------------------------------|
+ * | minipage1 | ... | minipageN | raw column1 | ... | raw columnN | free space ...... |
  * @endcode
+ * column index 记录每一列的长度和类型，日志回放时不需要表的元数据也可以初始化页面。
+ * 新插入的记录总是追加在最后，槽位号就是行号。每一列的值在未编码区(raw column)中连续存放，
+ * 未编码区满了以后封存(seal)页面：把所有行的每一列分别编码成一个 minipage，按照数据选择编码后
+ * 最小的方式（参考 MiniPageEncoding），编码区后面剩下的空间作为新的未编码区继续插入。
+ * 所以页面的槽位个数是不压缩时的 MAX_COMPRESSION_RATIO 倍，能放多少记录取决于数据压缩的效果。
+ * 封存只依赖页面中的数据，日志回放时重做插入会在同样的时机得到同样的结果，所以不需要写日志。
+ *
+ * 事务字段会被原地修改，始终不编码。修改其它已经编码的字段时需要重新编码整个页面，放不下时返回 RECORD_NOMEM。
+ * 删除记录只清除 bitmap，槽位不会重复使用，页面中的记录都删除以后整个页面重新开始。
  * 更多细节可参考：docs/design/miniob-pax-storage.md
  */
 class PaxRecordPageHandler : public RecordPageHandler
 {
 public:
+  /// 页面的槽位个数最多是不压缩时能存放的记录数的多少倍
+  static constexpr int MAX_COMPRESSION_RATIO = 4;
+  /// 页面的槽位个数上限，一个页面的记录要能放进一个 Chunk 中。不压缩就超过上限的页面不受影响
+  static constexpr int MAX_RECORD_CAPACITY = 2048;
+
   PaxRecordPageHandler() : RecordPageHandler(StorageFormat::PAX_FORMAT) {}
 
+  /**
+   * @brief 初始化一个空的 PAX 页面
+   * @details table_meta 中的每个字段对应页面中的一列，事务字段不编码
+   */
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      TableMeta *table_meta) override;
+
+  /**
+   * @brief 日志回放时初始化页面，col_idx_data 是页面中的 column index
+   */
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      int col_num, const char *col_idx_data) override;
+
   /**
    * @brief 插入一条记录
-   *
-   * @param data 要插入的记录
-   * @param rid  如果插入成功，通过这个参数返回插入的位置
-   * 注意：需要将record 按列拆分，在 Page 内按 PAX 格式存储。
+   * @details 记录按列拆分后追加到未编码区中，未编码区满了就封存页面
    */
-  virtual RC insert_record(const char *data, RID *rid) override;
+  RC insert_record(const char *data, RID *rid) override;
 
-  virtual RC delete_record(const RID *rid) override;
+  /**
+   * @brief 日志回放时插入记录，槽位号必须是下一个要追加的位置
+   */
+  RC recover_insert_record(const char *data, const RID &rid) override;
+
+  RC delete_record(const RID *rid) override;
+
+  /**
+   * @brief 修改记录
+   * @details 未编码的字段直接在原来的位置上修改，编码过的字段值变化时重新编码整个页面
+   */
+  RC update_record(const RID &rid, const char *data) override;
 
   /**
    * @brief 获取指定位置的记录数据
-   *
-   * @param rid 指定的位置
-   * @param record 返回指定的数据。
-   * 注意：需要将列数据组装成 Record 并返回。
+   * @details 把各列的值组装到当前对象的缓存中，下一次获取记录或者释放页面之前有效
    */
-  virtual RC get_record(const RID &rid, Record &record) override;
+  RC get_record(const RID &rid, Record &record) override;
 
   /**
-   * @brief 以 Chunk 格式获取整个页面中指定列的所有记录。
-   *
-   * @param chunk 由 chunk.column(i).col_id() 指定列。
+   * @brief 以 Chunk 格式获取整个页面中指定列的所有记录
+   * @details chunk.column_ids(i) 是列在页面中的下标。编码的数据直接解码到 Column 的内存中
+   */
+  RC get_chunk(Chunk &chunk, const uint8_t *visible = nullptr) override;
+
+  RC read_int_field(const FieldMeta &field, int32_t *values) override;
+
+  /**
+   * @brief 在编码后的数据上判断过滤条件，不需要先解码
    */
-  virtual RC get_chunk(Chunk &chunk) override;
+  RC filter_column(const ColumnPredicate &predicate, uint8_t *select) override;
+
+  /**
+   * @brief 槽位用完了，或者未编码区满了并且不再封存时，页面就是满的
+   */
+  bool is_full() const override;
+
+  /**
+   * @brief 按照未编码区中空闲的位置计算等级
+   */
+  int free_space_level() const override;
+
+  /// 已经追加到页面中的行数，包括删除的记录
+  int row_count() const;
+  /// 已经编码的行数
+  int sealed_row_count() const;
+  /// 数据占用的字节数，包括编码区和未编码区中已经使用的部分
+  int data_size() const;
+  /// 编码区中某一列的编码方式
+  MiniPageEncoding column_encoding(int col_id) const;
 
 private:
-  // get the field data by `slot_num` and `column id`
-  char *get_field_data(SlotNum slot_num, int col_id);
+  /// column index 中的一列，与 int 一样大，这样日志中的列数可以按照 int 计算
+  struct PaxColumn
+  {
+    int16_t len;
+    uint8_t attr_type;
+    uint8_t flags;
+  };
+  static_assert(sizeof(PaxColumn) == sizeof(int), "pax column should be as large as int");
 
-  // get the field length by `column id`, all columns are fixed length.
-  int get_field_len(int col_id);
+  struct PaxPageHeader
+  {
+    int32_t row_count;     ///< 已经追加的行数，也是下一条记录的槽位号
+    int32_t sealed_rows;   ///< 编码区中的行数
+    int32_t raw_start;     ///< 未编码区在页面中的偏移
+    int32_t raw_capacity;  ///< 未编码区中每一列可以存放的行数
+    int32_t flags;
+  };
+
+  /// 编码区中一列的位置
+  struct MiniPage
+  {
+    int32_t encoding;
+    int32_t offset;  ///< 在页面中的偏移
+    int32_t size;
+  };
+
+  static constexpr uint8_t COLUMN_KEEP_RAW = 1;  ///< 这一列不编码
+  static constexpr int32_t PAGE_SEAL_DONE  = 1;  ///< 不再封存，未编码区满了以后页面就满了
+  /// 封存后未编码区的行数少于已有行数的 1/MIN_SEAL_GAIN 时不再封存，避免频繁地重新编码
+  static constexpr int MIN_SEAL_GAIN = 8;
+
+  RC init_pax_page(int record_size, int col_num, const PaxColumn *pax_columns);
+
+  PaxColumn     *columns() const;
+  PaxPageHeader *pax_header() const;
+  MiniPage      *mini_pages() const;
+
+  /// 列在记录中的偏移
+  int column_offset(int col_id) const;
+  /// 未编码区中第 row 行的值，row 不小于 sealed_rows
+  char *raw_value(int col_id, int row) const;
+  /// 编码区中的一列
+  MiniPageReader sealed_reader(int col_id) const;
+  /// 第 row 行的值，返回的指针在页面或者 buffer 中
+  const char *field_value(int col_id, int row, char *buffer) const;
+
+  /// 追加一行，不写日志
+  SlotNum append_row(const char *data);
+  /// 把页面中所有行按列解码到 columns 中，每一列连续存放 row_count 个值
+  void decode_page(vector<char> &columns) const;
+  /// 把按列存放的数据全部编码到页面中，放不下时返回 RECORD_NOMEM，页面不变
+  RC encode_page(const vector<char> &columns);
+  void seal();
+  /// 清空页面中的数据，列信息不变
+  void reset_page();
+
+private:
+  vector<char> record_buffer_;  ///< get_record 返回的记录
+  vector<char> column_buffer_;  ///< 重新编码时解码出来的数据
+  vector<char> encode_buffer_;  ///< 编码后的数据
+  vector<int>  rows_;           ///< get_chunk 要拷贝的行
+};
+
+/**
+ * @brief 负责处理变长行存页面中各种操作
+ * @ingroup RecordManager
+ * @details 记录在内存中仍然是定长的，与 ROW_FORMAT 相同，只是在页面中按照变长的格式存放：
+ * 定长的字段原样保存，字符串字段只保存实际的长度和内容。页面的组织大概是这样的：
+ * @code
+ * | PageHeader | record allocate bitmap | column index | VarPageHeader | slot directory |
+ * |-----------------------------------------------------------------------------------|
+ * | free space ........................................ | recordN | ..... | record1 |
+ * @endcode
+ * column index 记录每一列的长度，字符串列记为负数，所以不需要表的元数据也可以解析页面中的记录。
+ * 槽位目录记录每条记录在页面中的偏移和长度，记录从页面的末尾向前存放。删除或者修改记录留下的空洞
+ * 在连续的空闲空间不够时通过整理页面回收，整理页面不改变槽位号，所以不需要写日志。
+ *
+ * 编码后的记录超过 MAX_INLINE_SIZE 时，把所有字符串字段放到溢出页面中，页面中只保留定长字段和溢出页面的位置，
+ * 这样判断可见性、修改事务字段时都不需要访问溢出页面。溢出页面与数据页面在同一个 buffer pool 中，
+ * 页头中记录的容量是 0，扫描时会被当作没有记录的页面跳过。
+ */
+class VarRecordPageHandler : public RecordPageHandler
+{
+public:
+  /// 页面中一条记录最多占用的空间，超过时字符串放到溢出页面中
+  static constexpr int MAX_INLINE_SIZE = BP_PAGE_DATA_SIZE / 8;
+
+  /**
+   * @param table_meta 表的元数据，用来找到每一列在记录中的位置。只有 get_chunk 需要
+   */
+  explicit VarRecordPageHandler(const TableMeta *table_meta = nullptr)
+      : RecordPageHandler(StorageFormat::VAR_ROW_FORMAT), table_meta_(table_meta)
+  {}
+
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      TableMeta *table_meta) override;
+  RC init_empty_page(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, int record_size,
+      int col_num, const char *col_idx_data) override;
+
+  RC insert_record(const char *data, RID *rid) override;
+
+  /**
+   * @brief 在当前页面中插入尽可能多的记录
+   * @details 每条记录的长度不同，页面放不下下一条记录时就停止
+   */
+  RC insert_records(const char *const *datas, int count, RID *rids, int &inserted) override;
+
+  /**
+   * @brief 删除记录，同时释放记录的溢出页面
+   */
+  RC delete_record(const RID *rid) override;
+
+  /**
+   * @brief 修改记录
+   * @details 只修改了定长字段时，比如事务字段，直接在原来的位置上修改，溢出页面也不变。
+   * 编码后变长了并且页面中放不下时返回 RECORD_NOMEM
+   */
+  RC update_record(const RID &rid, const char *data) override;
+
+  /**
+   * @brief 获取指定位置的记录数据
+   * @details 记录解码到当前对象的缓存中，下一次获取记录或者释放页面之前有效
+   */
+  RC get_record(const RID &rid, Record &record) override;
+
+  /**
+   * @brief 把页面中所有记录的指定列拷贝到 chunk 中
+   * @details 需要在构造时传入表的元数据。变长的列只拷贝字符串实际的内容
+   */
+  RC get_chunk(Chunk &chunk, const uint8_t *visible = nullptr) override;
+
+  RC read_int_field(const FieldMeta &field, int32_t *values) override;
+
+  /**
+   * @brief 剩余的空间放不下一条最长的记录，或者没有空闲的槽位时，页面就是满的
+   */
+  bool is_full() const override;
+
+  /**
+   * @brief 按照剩余空间和空闲槽位中比较少的那个计算等级
+   */
+  int free_space_level() const override;
+
+  /**
+   * @brief 页面中空闲的字节数，包括还没有整理的空洞
+   */
+  int free_space() const;
+
+  /**
+   * @brief 日志回放时，把编码后的记录放到指定的槽位上
+   * @details 插入和修改记录都使用这个日志，溢出页面有自己的日志，这里不需要处理
+   */
+  RC recover_put_record(const RID &rid, span<const char> payload, bool overflow);
+
+  /**
+   * @brief 日志回放时删除记录
+   * @details 溢出页面的释放由 buffer pool 的日志回放，这里只删除页面中的记录
+   */
+  RC recover_delete_record(const RID &rid);
+
+  /**
+   * @brief 日志回放时重建溢出页面
+   * @param data 溢出页面中从页头开始的有效数据
+   */
+  static RC recover_overflow_page(Frame &frame, span<const char> data);
+
+  /**
+   * @brief 当前页面中记录占用的字节数，不包括页头和槽位目录
+   */
+  int used_space() const;
+
+private:
+  struct VarPageHeader
+  {
+    int32_t data_start;       ///< 最前面一条记录的偏移，记录从页面末尾向前存放
+    int32_t fragment_size;    ///< 删除或修改记录后留下的空洞的大小
+    int32_t fixed_size;       ///< 所有定长字段的大小
+    int32_t var_column_num;   ///< 字符串字段的个数
+    int32_t slot_count;       ///< 槽位目录中已经使用过的槽位个数，目录随着插入向后增长
+  };
+
+  struct Slot
+  {
+    uint16_t offset;
+    uint16_t length;  ///< 最高位表示字符串字段放在溢出页面中
+  };
+
+  /// 记录中的字符串字段放在溢出页面时，页面中保存的位置信息
+  struct OverflowRef
+  {
+    PageNum first_page;
+    int32_t length;
+  };
+
+  /// 溢出页面在 PageHeader 之后的头部
+  struct OverflowPageHeader
+  {
+    PageNum next_page;
+    int32_t data_len;
+  };
+
+  static constexpr uint16_t OVERFLOW_FLAG = 0x8000;
+  static constexpr int      OVERFLOW_DATA_SIZE =
+      BP_PAGE_DATA_SIZE - static_cast<int>(sizeof(PageHeader) + sizeof(OverflowPageHeader));
+
+  RC init_var_page(int record_size, int col_num, const int *col_lens);
+
+  const int     *column_lens() const;
+  VarPageHeader *var_header() const;
+  Slot          *slots() const;
+  int            slots_end() const;
+  int            inline_limit() const;
+  int            max_payload_size() const;
+
+  /**
+   * @brief 把内存中的定长记录编码成页面中的格式，结果在 payload_ 中
+   * @param[out] overflow 字符串部分是否需要放到溢出页面中，这时字符串部分在 var_part_ 中
+   */
+  void encode(const char *data, bool &overflow);
+
+  /// 把页面中的记录解码到 buffer 中，buffer 的大小是内存中记录的大小
+  RC decode(const Slot &slot, char *buffer);
+
+  /// 在页面中找一块 size 大小的空间，连续空间不够时整理页面。new_slot 表示还要在槽位目录中增加一个槽位
+  RC allocate_space(int size, bool new_slot, uint16_t &offset);
+
+  /// 把所有记录移动到页面的末尾，消除空洞
+  void compact();
+
+  /// 把数据写入溢出页面，返回第一个页面
+  RC write_overflow(const char *data, int len, PageNum &first_page);
+  RC read_overflow(const OverflowRef &ref, vector<char> &data);
+  RC free_overflow(PageNum first_page);
+
+  /// 把编码后的记录放到一个空闲的槽位上，不写日志
+  RC put_payload(SlotNum slot_num, span<const char> payload, bool overflow);
+
+private:
+  const TableMeta *table_meta_ = nullptr;
+  vector<char>     payload_;        ///< 编码后的记录
+  vector<char>     var_part_;       ///< 编码后记录的字符串部分
+  vector<char>     record_buffer_;  ///< get_record 返回的记录
+  vector<char>     overflow_data_;  ///< 从溢出页面中读取的数据
+};
+
+/**
+ * @brief 区域映射(zone map)，记录每个页面上每一列的最小值和最大值
+ * @ingroup RecordManager
+ * @details 扫描时用下推的过滤条件与页面的取值范围比较，不可能有满足条件的记录的页面不需要加载。
+ * 只在内存中维护，不写日志。页面的范围在第一次带条件扫描它时根据页面上的记录计算，
+ * 新分配的页面从空范围开始。插入和修改记录时扩大范围；删除记录时不缩小范围，只有页面上的记录全部删除后才恢复成空范围。
+ * 所以范围可能比实际的大，但一定包含页面上所有的记录，跳过页面总是安全的。
+ * 只记录 INTS、FLOATS 和 CHARS 类型的用户字段。当前没有 NULL，所以不需要统计空值的个数。
+ * 记录的修改都经过 RecordFileHandler，它在持有页面锁时更新范围，与扫描时计算范围不会乱序。
+ * 并行扫描的线程可能同时计算范围，所以这里使用标准库的锁，而不是 CONCURRENCY 关闭时为空的 common::Mutex。
+ */
+class ZoneMap
+{
+public:
+  /**
+   * @param table_meta 为空或者没有可以记录的字段时不记录任何范围，所有页面都需要访问
+   */
+  void init(const TableMeta *table_meta);
+  void clear();
+
+  bool enabled() const { return !zone_columns_.empty(); }
+
+  /// 是否已经知道页面的范围
+  bool has_zone(PageNum page_num) const;
+
+  /**
+   * @brief 页面上是否可能有满足所有条件的记录
+   * @details 不知道页面的范围，或者条件中的列没有记录范围时返回 true
+   */
+  bool may_match(PageNum page_num, const vector<ColumnPredicate> &predicates) const;
+
+  /**
+   * @brief 根据页面上所有的记录计算范围
+   * @details 调用者需要持有页面的锁
+   */
+  RC build_zone(RecordPageHandler &record_page_handler);
+
+  /// 页面上没有记录了，比如刚刚分配的页面
+  void reset_zone(PageNum page_num);
+
+  /// 页面上插入或者修改了一条记录，已经知道页面的范围时把记录的值合并进去
+  void add_record(PageNum page_num, const char *data);
+
+  /// 页面上删除了记录，页面上没有记录时恢复成空范围
+  void remove_record(RecordPageHandler &record_page_handler);
+
+  /// 页面被没有经过区域映射的方式修改了，比如恢复时重做的插入
+  void invalidate(PageNum page_num);
+
+private:
+  struct ColumnZone
+  {
+    Value min;
+    Value max;
+  };
+
+  struct PageZone
+  {
+    bool               valid = false;  ///< 是否已经知道页面的范围
+    bool               empty = true;   ///< 页面上没有记录，所有条件都不满足
+    vector<ColumnZone> columns;        ///< 与 zone_columns_ 一一对应
+  };
+
+  /// 把记录的值合并到范围中，调用者需要持有写锁
+  void merge_record(PageZone &zone, const char *data) const;
+
+  static bool column_may_match(const ColumnZone &zone, CompOp comp, const Value &value);
+
+private:
+  vector<const FieldMeta *> zone_columns_;  ///< 记录范围的字段
+  vector<int>               column_index_;  ///< 按照列编号索引，字段在 zone_columns_ 中的位置，不记录时为 -1
+
+  mutable shared_mutex lock_;
+  vector<PageZone>     pages_;  ///< 按照页面编号索引
 };
 /**
  * @brief 管理整个文件中记录的增删改查
@@ -388,6 +842,16 @@ public:
    */
   RC insert_record(const char *data, int record_size, RID *rid);
 
+  /**
+   * @brief 批量插入记录
+   * @details 每个页面只加载一次，在一个页面中尽量多地插入记录
+   * @param datas       所有记录的内容
+   * @param record_size 记录大小
+   * @param rids        返回每条记录的标识符，与 datas 一一对应
+   * @param logging     是否记录日志。不记录日志时由调用者负责在结束后把页面刷到磁盘
+   */
+  RC insert_records(const vector<const char *> &datas, int record_size, vector<RID> &rids, bool logging = true);
+
   /**
    * @brief 数据库恢复时，在指定文件指定位置插入数据
    *
@@ -401,19 +865,116 @@ public:
 
   RC visit_record(const RID &rid, function<bool(Record &)> updater);
 
+  /**
+   * @brief 打开文件以来成功插入、删除的记录数
+   * @details 用来判断统计信息是否过期，不包含恢复时重做的插入
+   */
+  int64_t inserted_record_count() const { return inserted_record_count_.load(std::memory_order_relaxed); }
+  int64_t deleted_record_count() const { return deleted_record_count_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief 每个页面上每一列的取值范围，扫描时用来跳过页面
+   */
+  ZoneMap &zone_map() { return zone_map_; }
+
+private:
+  /**
+   * @brief 插入记录的目标页面
+   * @details 线程按照各自的编号映射到不同的槽位上，每个槽位独占一个目标页面，
+   * 这样并发插入的线程会把记录写到不同的页面上，不会都去争抢同一个页面的锁。
+   * 槽位中的页面处理器是重复使用的，不需要每插入一条记录就申请一次内存。
+   */
+  struct alignas(64) InsertSlot
+  {
+    common::Mutex                 lock;                             ///< 映射到同一个槽位的线程需要串行化
+    PageNum                       page_num = BP_INVALID_PAGE_NUM;  ///< 当前的目标页面
+    unique_ptr<RecordPageHandler> page_handler;
+  };
+
+  static constexpr int INSERT_SLOT_NUM = 32;
+
+  /**
+   * @brief 扫描所有页面，创建空闲空间映射
+   * @details 只有以前的文件在第一次打开时才需要。之后打开文件时空闲空间映射直接从映射页面中加载
+   */
+  RC build_free_space_map();
+
+  /**
+   * @brief 在空闲空间映射中更新页面的等级
+   * @details 调用时仍然持有页面的锁，避免与其它线程对同一个页面的更新乱序
+   */
+  void update_free_space(RecordPageHandler &record_page_handler);
+
+  /// 当前线程使用的槽位
+  InsertSlot &insert_slot();
+
+  /**
+   * @brief 打开槽位的目标页面，页面满了就换一个没有被其它槽位占用的页面，找不到就分配一个新的页面
+   * @details 调用者需要持有槽位的锁。成功时 slot.page_handler 使用读写模式打开了目标页面
+   * @param log_handler 页面修改使用的日志处理器
+   */
+  RC open_free_page(InsertSlot &slot, int record_size, LogHandler &log_handler);
+
+  /**
+   * @brief 从空闲空间映射中找一个没有被其它槽位占用的页面，并占用它
+   * @return 没有时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum claim_free_page();
+
+  /// 槽位不再使用当前的目标页面，其它槽位可以占用它了
+  void release_insert_page(InsertSlot &slot);
+
+  RC delete_record(const RID *rid, LogHandler &log_handler);
+
 private:
+  DiskBufferPool *disk_buffer_pool_ = nullptr;
+  LogHandler     *log_handler_      = nullptr;  ///< 记录日志的处理器
+  StorageFormat   storage_format_;
+  TableMeta      *table_meta_;
+  atomic<int64_t> inserted_record_count_{0};
+  atomic<int64_t> deleted_record_count_{0};
+
+  InsertSlot             insert_slots_[INSERT_SLOT_NUM];
+  common::Mutex          claim_lock_;     ///< 保护 claimed_pages_
+  unordered_set<PageNum> claimed_pages_;  ///< 正在作为某个槽位目标页面的页面
+
+  ZoneMap zone_map_;
+};
+
+/**
+ * @brief 一次判断整个页面上所有记录对事务是否可见
+ * @ingroup RecordManager
+ * @details 从页面中读出所有槽位的 begin_xid 和 end_xid，交给事务批量判断，
+ * 扫描时按照槽位号查询结果，不需要再逐条调用 Trx::visit_record。
+ * 只适用于只读的扫描，读写扫描还需要逐条检查与其它事务的冲突。
+ */
+class PageVisibilityFilter
+{
+public:
   /**
-   * @brief 初始化当前没有填满记录的页面，初始化free_pages_成员
+   * @brief 表上有事务字段时才需要判断可见性，否则 enabled 返回 false
    */
-  RC init_free_pages();
+  void init(Table *table, Trx *trx);
+
+  bool enabled() const { return trx_ != nullptr; }
+
+  /**
+   * @brief 计算当前页面上每个槽位的可见性
+   * @return 页面格式不支持批量读取字段时返回 UNIMPLEMENTED
+   */
+  RC filter_page(RecordPageHandler &record_page_handler);
+
+  /// 按槽位号索引的选择向量
+  const uint8_t *visible() const { return visible_.data(); }
+  bool           is_visible(SlotNum slot_num) const { return visible_[slot_num] != 0; }
 
 private:
-  DiskBufferPool        *disk_buffer_pool_ = nullptr;
-  LogHandler            *log_handler_      = nullptr;  ///< 记录日志的处理器
-  unordered_set<PageNum> free_pages_;                  ///< 没有填充满的页面集合
-  common::Mutex          lock_;  ///< 当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
-  StorageFormat          storage_format_;
-  TableMeta             *table_meta_;
+  Trx             *trx_             = nullptr;
+  const FieldMeta *begin_xid_field_ = nullptr;
+  const FieldMeta *end_xid_field_   = nullptr;
+  vector<int32_t>  begin_xids_;
+  vector<int32_t>  end_xids_;
+  vector<uint8_t>  visible_;
 };
 
 /**
@@ -453,6 +1014,27 @@ public:
 
   RC update_current(const Record &record);
 
+  /**
+   * @brief 按页面采样，只访问部分页面中的记录
+   * @details 每个页面独立地以 ratio 的概率被访问，用于 ANALYZE TABLE 收集统计信息。
+   * 需要在 open_scan 之后、读取记录之前调用，open_scan 会恢复成访问所有页面。
+   * @param ratio 页面被访问的概率，取值 (0, 1]
+   * @param seed  随机数种子，相同的种子访问相同的页面
+   */
+  void set_page_sample(double ratio, uint32_t seed);
+
+  /**
+   * @brief 设置用来跳过页面的过滤条件
+   * @details 根据表的区域映射跳过不可能有满足条件的记录的页面，不会过滤页面上的记录，
+   * 调用者仍然需要对返回的记录计算所有的条件。需要在 open_scan 之后、读取记录之前调用
+   */
+  void set_zone_predicates(vector<ColumnPredicate> predicates) { zone_predicates_ = std::move(predicates); }
+
+  /// 已经访问过的页面个数
+  int64_t scanned_page_count() const { return scanned_page_count_; }
+  /// 采样或者根据区域映射跳过的页面个数
+  int64_t skipped_page_count() const { return skipped_page_count_; }
+
 private:
   /**
    * @brief 获取该文件中的下一条记录
@@ -478,6 +1060,56 @@ private:
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
   RecordPageIterator record_page_iterator_;           ///< 遍历某个页面上的所有record
   Record             next_record_;                    ///< 获取的记录放在这里缓存起来
+
+  PageVisibilityFilter visibility_filter_;      ///< 只读扫描时批量判断记录的可见性
+  bool                 page_filtered_ = false;  ///< 当前页面是否已经批量判断过可见性
+
+  double  sample_ratio_       = 1.0;  ///< 页面采样的比例，1 表示访问所有页面
+  mt19937 sample_random_;             ///< 决定是否访问某个页面
+  int64_t scanned_page_count_ = 0;
+  int64_t skipped_page_count_ = 0;
+
+  ZoneMap                *zone_map_ = nullptr;  ///< 表的区域映射，没有时访问所有页面
+  vector<ColumnPredicate> zone_predicates_;     ///< 用来跳过页面的条件
+};
+
+/**
+ * @brief 并行扫描时多个线程共享的页面迭代器
+ * @ingroup RecordManager
+ * @details 每次给一个线程分配连续的若干个页面(morsel)，先处理完的线程继续领取新的页面，
+ * 数据分布不均匀时也不会有线程空等。
+ * 页面的打开和释放也通过这里串行执行：没有开启 CONCURRENCY 时缓冲池和页帧上的锁都是空实现，
+ * 多个线程同时加载、固定页面是不安全的。把页面上的数据拷贝到 Chunk 的过程是并行的。
+ */
+class PageMorselIterator
+{
+public:
+  static constexpr int DEFAULT_MORSEL_PAGES = 4;  ///< 每次分配的页面个数
+
+  RC init(DiskBufferPool &buffer_pool, LogHandler &log_handler, int morsel_pages = DEFAULT_MORSEL_PAGES);
+
+  /**
+   * @brief 领取下一批页面，可以在多个线程中同时调用
+   * @return 没有剩余的页面时返回 false
+   */
+  bool next_morsel(vector<PageNum> &pages);
+
+  /**
+   * @brief 使用 handler 打开指定的页面
+   */
+  RC open_page(RecordPageHandler &handler, PageNum page_num, ReadWriteMode mode);
+
+  /**
+   * @brief 释放 handler 打开的页面
+   */
+  void close_page(RecordPageHandler &handler);
+
+private:
+  mutex              lock_;
+  DiskBufferPool    *disk_buffer_pool_ = nullptr;
+  LogHandler        *log_handler_      = nullptr;
+  BufferPoolIterator bp_iterator_;
+  int                morsel_pages_ = DEFAULT_MORSEL_PAGES;
 };
 
 /**
@@ -491,8 +1123,12 @@ public:
   ChunkFileScanner() = default;
   ~ChunkFileScanner();
 
-  // TODO: not support filter and transaction
-  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode);
+  /**
+   * @brief 打开一个文件扫描
+   * @details 有事务时只返回对事务可见的记录。向量化扫描只用于查询，按照只读访问的规则判断可见性
+   */
+  // TODO: not support filter
+  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, Trx *trx, LogHandler &log_handler, ReadWriteMode mode);
 
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
@@ -504,6 +1140,46 @@ public:
    */
   RC next_chunk(Chunk &chunk);
 
+  /**
+   * @brief 从多个扫描共享的迭代器中领取页面，而不是遍历文件中所有的页面
+   * @details 需要在 open_scan_chunk 之后、读取数据之前调用，用于并行扫描
+   */
+  void set_morsel_iterator(PageMorselIterator *morsel_iterator) { morsel_iterator_ = morsel_iterator; }
+
+  /**
+   * @brief 设置下推到页面上的过滤条件，只返回满足所有条件的记录
+   * @details 需要在 open_scan_chunk 之后调用。只有 PAX 格式的页面支持，在编码后的数据上直接判断。
+   * 这些条件也会用来根据区域映射跳过页面
+   */
+  void set_predicates(vector<ColumnPredicate> predicates) { predicates_ = std::move(predicates); }
+
+  /**
+   * @brief 设置只用来跳过页面的过滤条件，参考 RecordFileScanner::set_zone_predicates
+   * @details 用于不支持在页面上过滤记录的格式，调用者仍然需要对返回的数据计算这些条件
+   */
+  void set_zone_predicates(vector<ColumnPredicate> predicates) { zone_predicates_ = std::move(predicates); }
+
+  /// 已经访问过的页面个数
+  int64_t scanned_page_count() const { return scanned_page_count_; }
+  /// 根据区域映射跳过的页面个数
+  int64_t skipped_page_count() const { return skipped_page_count_; }
+
+private:
+  /**
+   * @brief 获取下一个要访问的页面
+   */
+  bool next_page(PageNum &page_num);
+
+  /**
+   * @brief 释放当前打开的页面
+   */
+  void cleanup_page();
+
+  /**
+   * @brief 根据区域映射判断页面上是否不可能有满足条件的记录
+   */
+  bool skip_page(PageNum page_num) const;
+
 private:
   Table *table_ = nullptr;  ///< 当前遍历的是哪张表。
 
@@ -513,4 +1189,18 @@ private:
 
   BufferPoolIterator bp_iterator_;                    ///< 遍历buffer pool的所有页面
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
+
+  PageVisibilityFilter visibility_filter_;  ///< 过滤掉对事务不可见的记录
+
+  vector<ColumnPredicate> predicates_;       ///< 下推的过滤条件
+  vector<ColumnPredicate> zone_predicates_;  ///< 只用来跳过页面的条件
+  vector<uint8_t>         select_;           ///< 当前页面上可见并且满足过滤条件的记录
+
+  ZoneMap *zone_map_           = nullptr;  ///< 表的区域映射，没有时访问所有页面
+  int64_t  scanned_page_count_ = 0;
+  int64_t  skipped_page_count_ = 0;
+
+  PageMorselIterator *morsel_iterator_ = nullptr;  ///< 并行扫描时共享的页面迭代器
+  vector<PageNum>     morsel_pages_;               ///< 已经领取还没有访问的页面
+  size_t              morsel_pos_ = 0;             ///< 下一个要访问的页面在 morsel_pages_ 中的位置
 };
@@ -11,6 +11,7 @@ See the Mulan PSL v2 for more details. */
 // 作者：Meiyi & Wangyunlai 创建于 2021/5/13
 
 #include <limits.h>
+#include <math.h>
 #include <string.h>
 
 #include "common/defs.h"
@@ -24,6 +25,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/common/condition_filter.h"
 #include "storage/common/meta_util.h"
 #include "storage/index/bplus_tree_index.h"
+#include "storage/index/hash_index.h"
 #include "storage/index/index.h"
 #include "storage/record/record_manager.h"
 #include "storage/table/table.h"
@@ -162,10 +164,18 @@ RC Table::open(Db *db, const char *meta_file, const char *base_dir) {
       return RC::INTERNAL;
     }
 
-    BplusTreeIndex *index = new BplusTreeIndex(); // 创建B+树索引
     string index_file = table_index_file(base_dir, name(), index_meta->name()); // 构建索引文件路径
 
-    rc = index->open(this, index_file.c_str(), *index_meta, *field_meta); // 打开索引
+    Index *index = nullptr;
+    if (index_meta->type() == IndexType::HASH) {
+      HashIndex *hash_index = new HashIndex(); // 创建哈希索引
+      index = hash_index;
+      rc    = hash_index->open(this, index_file.c_str(), *index_meta, *field_meta); // 打开索引
+    } else {
+      BplusTreeIndex *bplus_tree_index = new BplusTreeIndex(); // 创建B+树索引
+      index = bplus_tree_index;
+      rc    = bplus_tree_index->open(this, index_file.c_str(), *index_meta, *field_meta); // 打开索引
+    }
     if (rc != RC::SUCCESS) {
       delete index; // 打开失败，删除索引
       LOG_ERROR("Failed to open index. table=%s, index=%s, file=%s, rc=%s",
@@ -200,6 +210,346 @@ RC Table::insert_record(Record &record) {
   return rc; // 返回成功
 }
 
+RC Table::insert_records(vector<Record> &records, bool logging)
+{
+  vector<const char *> datas;
+  vector<RID>          rids;
+  datas.reserve(records.size());
+  for (const Record &record : records) {
+    datas.push_back(record.data());
+  }
+
+  RC rc = record_handler_->insert_records(datas, table_meta_.record_size(), rids, logging);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Insert records failed. table name=%s, records=%d, rc=%s",
+              table_meta_.name(), static_cast<int>(records.size()), strrc(rc));
+    return rc;
+  }
+
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i].set_rid(rids[i]);
+  }
+
+  // 每个索引连续插入所有的记录，而不是每条记录轮流插入所有索引
+  for (Index *index : indexes_) {
+    for (size_t i = 0; i < records.size() && OB_SUCC(rc); i++) {
+      rc = index->insert_entry(records[i].data(), &records[i].rid());
+    }
+    if (OB_FAIL(rc)) {
+      break;
+    }
+  }
+
+  if (OB_FAIL(rc)) {  // 可能出现了键值重复，删除所有插入的数据
+    for (Record &record : records) {
+      // 失败位置之后的索引项还没有插入，忽略不存在的错误
+      RC rc2 = delete_entry_of_indexes(record.data(), record.rid(), true /*error_on_not_exists*/);
+      if (rc2 != RC::SUCCESS && rc2 != RC::RECORD_INVALID_KEY) {
+        LOG_ERROR("Delete entry of indexes failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc2));
+      }
+      rc2 = record_handler_->delete_record(&record.rid());
+      if (rc2 != RC::SUCCESS) {
+        LOG_ERROR("Delete record failed. table name=%s, rid=%s, rc=%s",
+                  table_meta_.name(), record.rid().to_string().c_str(), strrc(rc2));
+      }
+    }
+    LOG_ERROR("Insert records failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
+    return rc;
+  }
+  return rc;
+}
+
+RC Table::create_index(
+    Trx *trx, const FieldMeta *field_meta, const char *index_name, IndexType index_type, float fill_factor)
+{
+  if (common::is_blank(index_name) || nullptr == field_meta) {
+    LOG_INFO("Invalid input arguments, table name is %s, index_name is blank or attribute_name is blank", name());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  IndexMeta new_index_meta;
+
+  RC rc = new_index_meta.init(index_name, *field_meta, index_type);
+  if (rc != RC::SUCCESS) {
+    LOG_INFO("Failed to init IndexMeta in table:%s, index_name:%s, field_name:%s",
+             name(), index_name, field_meta->name());
+    return rc;
+  }
+
+  // 创建索引相关数据
+  string index_file = table_index_file(base_dir_.c_str(), name(), index_name);
+  Index *index      = nullptr;
+  if (index_type == IndexType::HASH) {
+    HashIndex *hash_index = new HashIndex();
+    index = hash_index;
+    rc    = hash_index->create(this, index_file.c_str(), new_index_meta, *field_meta);
+  } else {
+    BplusTreeIndex *bplus_tree_index = new BplusTreeIndex();
+    index = bplus_tree_index;
+    rc    = bplus_tree_index->create(this, index_file.c_str(), new_index_meta, *field_meta);
+  }
+  if (rc != RC::SUCCESS) {
+    delete index;
+    LOG_ERROR("Failed to create index. file name=%s, rc=%d:%s", index_file.c_str(), rc, strrc(rc));
+    return rc;
+  }
+
+  // 遍历当前的所有数据构建索引。B+树排序后批量构建，而不是逐条插入
+  RecordFileScanner scanner;
+  rc = get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY);
+  if (rc != RC::SUCCESS) {
+    delete index;
+    LOG_WARN("failed to create scanner while creating index. table=%s, index=%s, rc=%s",
+             name(), index_name, strrc(rc));
+    return rc;
+  }
+
+  if (index_type == IndexType::HASH) {
+    rc = static_cast<HashIndex *>(index)->build(scanner);
+  } else {
+    rc = static_cast<BplusTreeIndex *>(index)->bulk_load(scanner, fill_factor);
+  }
+  scanner.close_scan();
+  if (rc != RC::SUCCESS) {
+    delete index;
+    LOG_WARN("failed to build index from records. table=%s, index=%s, rc=%s", name(), index_name, strrc(rc));
+    return rc;
+  }
+  LOG_INFO("inserted all records into new index. table=%s, index=%s", name(), index_name);
+
+  indexes_.push_back(index);
+
+  /// 接下来将这个索引放到表的元数据中
+  TableMeta new_table_meta(table_meta_);
+  rc = new_table_meta.add_index(new_index_meta);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to add index (%s) on table (%s). error=%d:%s", index_name, name(), rc, strrc(rc));
+    return rc;
+  }
+
+  /// 内存中有一份元数据，磁盘文件也有一份元数据
+  rc = write_table_meta(new_table_meta);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to write table meta while creating index (%s) on table (%s). rc=%s", index_name, name(), strrc(rc));
+    return rc;  // 创建索引中途出错，要做还原操作
+  }
+
+  {
+    lock_guard<mutex> guard(statistics_lock_);
+    table_meta_.swap(new_table_meta);
+  }
+
+  LOG_INFO("Successfully added a new index (%s) on the table (%s)", index_name, name());
+  return rc;
+}
+
+RC Table::write_table_meta(const TableMeta &table_meta)
+{
+  // 修改磁盘文件时，先创建一个临时文件，写入完成后再rename为正式文件
+  string  tmp_file = table_meta_file(base_dir_.c_str(), name()) + ".tmp";
+  fstream fs;
+  fs.open(tmp_file, ios_base::out | ios_base::binary | ios_base::trunc);
+  if (!fs.is_open()) {
+    LOG_ERROR("Failed to open file for write. file name=%s, errmsg=%s", tmp_file.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  if (table_meta.serialize(fs) < 0) {
+    LOG_ERROR("Failed to dump new table meta to file: %s. sys err=%d:%s", tmp_file.c_str(), errno, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  fs.close();
+
+  // 覆盖原始元数据文件
+  string meta_file = table_meta_file(base_dir_.c_str(), name());
+
+  int ret = rename(tmp_file.c_str(), meta_file.c_str());
+  if (ret != 0) {
+    LOG_ERROR("Failed to rename tmp meta file (%s) to normal meta file (%s) on table (%s). system error=%d:%s",
+              tmp_file.c_str(), meta_file.c_str(), name(), errno, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  return RC::SUCCESS;
+}
+
+RC Table::analyze(Trx *trx)
+{
+  lock_guard<mutex> analyze_guard(analyze_lock_);
+  return collect_statistics(trx);
+}
+
+RC Table::collect_statistics(Trx *trx)
+{
+  // 页面较多时按页面采样，采样的比例由页面数决定
+  // 不包含文件头和空闲空间映射页面
+  const int64_t page_count =
+      max(data_buffer_pool_->allocated_pages() - 1 - data_buffer_pool_->free_space_map_page_count(), 0);
+  const double  sample_ratio = page_count > ANALYZE_SAMPLE_PAGES
+                                   ? static_cast<double>(ANALYZE_SAMPLE_PAGES) / page_count : 1.0;
+
+  const int64_t inserted_count = record_handler_->inserted_record_count();
+  const int64_t deleted_count  = record_handler_->deleted_record_count();
+
+  RecordFileScanner scanner;
+  RC rc = get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create scanner while analyzing table. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+  scanner.set_page_sample(sample_ratio, static_cast<uint32_t>(table_id()));
+
+  StatisticsCollector collector(table_meta_);
+  Record              record;
+  while (OB_SUCC(rc = scanner.next(record))) {
+    collector.add_record(record.data());
+  }
+  const int64_t scanned_pages = scanner.scanned_page_count();
+  const int64_t skipped_pages = scanner.skipped_page_count();
+  scanner.close_scan();
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to scan records while analyzing table. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  // 按照访问到的页面的比例推算总行数
+  int64_t total_rows = collector.row_count();
+  if (skipped_pages > 0 && scanned_pages > 0) {
+    total_rows = llround(static_cast<double>(total_rows) * (scanned_pages + skipped_pages) / scanned_pages);
+  }
+
+  auto statistics = make_shared<TableStatistics>();
+  collector.finish(total_rows, page_count, *statistics);
+
+  TableMeta new_table_meta(table_meta_);
+  new_table_meta.set_statistics(statistics);
+  rc = write_table_meta(new_table_meta);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write table meta while analyzing table. table=%s, rc=%s", name(), strrc(rc));
+    return rc;
+  }
+
+  {
+    lock_guard<mutex> guard(statistics_lock_);
+    table_meta_.swap(new_table_meta);
+  }
+  analyzed_inserted_count_.store(inserted_count);
+  analyzed_deleted_count_.store(deleted_count);
+
+  LOG_INFO("Successfully analyzed table. table=%s, rows=%ld, pages=%ld, scanned pages=%ld",
+           name(), statistics->row_count, statistics->page_count, scanned_pages);
+  return RC::SUCCESS;
+}
+
+RC Table::refresh_statistics_if_expired(bool &refreshed)
+{
+  refreshed = false;
+
+  shared_ptr<const TableStatistics> old_statistics = statistics();
+  if (old_statistics == nullptr) {
+    return RC::SUCCESS;
+  }
+
+  const int64_t modified_count = (record_handler_->inserted_record_count() - analyzed_inserted_count_.load()) +
+                                 (record_handler_->deleted_record_count() - analyzed_deleted_count_.load());
+  const int64_t threshold      = max<int64_t>(old_statistics->row_count / 5, 1000);
+  if (modified_count <= threshold) {
+    return RC::SUCCESS;
+  }
+
+  unique_lock<mutex> analyze_guard(analyze_lock_, std::try_to_lock);
+  if (!analyze_guard.owns_lock()) {
+    return RC::SUCCESS;  // 其它线程正在收集
+  }
+
+  LOG_INFO("statistics of table expired, analyze again. table=%s, modified rows=%ld", name(), modified_count);
+  RC rc = collect_statistics(nullptr);
+  if (OB_SUCC(rc)) {
+    refreshed = true;
+  }
+  return rc;
+}
+
+shared_ptr<const TableStatistics> Table::statistics() const
+{
+  lock_guard<mutex> guard(statistics_lock_);
+  return table_meta_.statistics();
+}
+
+int64_t Table::estimated_row_count() const
+{
+  shared_ptr<const TableStatistics> current_statistics = statistics();
+  if (current_statistics == nullptr) {
+    return -1;
+  }
+
+  const int64_t inserted_count = record_handler_->inserted_record_count() - analyzed_inserted_count_.load();
+  const int64_t deleted_count  = record_handler_->deleted_record_count() - analyzed_deleted_count_.load();
+  return max<int64_t>(current_statistics->row_count + inserted_count - deleted_count, 0);
+}
+
+RC Table::update_record(const Record &old_record, Record &new_record)
+{
+  const RID &rid = old_record.rid();
+  new_record.set_rid(rid);
+
+  // 只有索引字段的值发生了变化，才需要修改对应的索引
+  vector<Index *> changed_indexes;
+  for (Index *index : indexes_) {
+    const FieldMeta *field = table_meta_.field(index->index_meta().field());
+    if (0 != memcmp(old_record.data() + field->offset(), new_record.data() + field->offset(), field->len())) {
+      changed_indexes.push_back(index);
+    }
+  }
+
+  // 先插入新的索引项，比如唯一索引冲突时，表中的数据还没有被修改
+  RC     rc       = RC::SUCCESS;
+  size_t inserted = 0;
+  for (; inserted < changed_indexes.size(); inserted++) {
+    Index *index = changed_indexes[inserted];
+    rc           = index->insert_entry(new_record.data(), &rid);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert index entry. table=%s, index=%s, rid=%s, rc=%s",
+               name(), index->index_meta().name(), rid.to_string().c_str(), strrc(rc));
+      break;
+    }
+  }
+
+  // 原地修改记录，只会记录一条 UPDATE 日志
+  if (OB_SUCC(rc)) {
+    rc = record_handler_->visit_record(rid, [&new_record](Record &record) {
+      memcpy(record.data(), new_record.data(), min(record.len(), new_record.len()));
+      return true;
+    });
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to update record. table=%s, rid=%s, rc=%s", name(), rid.to_string().c_str(), strrc(rc));
+    }
+  }
+
+  if (OB_FAIL(rc)) {
+    for (size_t i = 0; i < inserted; i++) {
+      RC rc2 = changed_indexes[i]->delete_entry(new_record.data(), &rid);
+      ASSERT(OB_SUCC(rc2), "failed to rollback index entry. table=%s, rid=%s, rc=%s",
+             name(), rid.to_string().c_str(), strrc(rc2));
+    }
+    return rc;
+  }
+
+  for (Index *index : changed_indexes) {
+    rc = index->delete_entry(old_record.data(), &rid);
+    ASSERT(OB_SUCC(rc), "failed to delete old index entry. table=%s, index=%s, rid=%s, rc=%s",
+           name(), index->index_meta().name(), rid.to_string().c_str(), strrc(rc));
+  }
+  return RC::SUCCESS;
+}
+
+RC Table::init_morsel_iterator(PageMorselIterator &iterator)
+{
+  RC rc = iterator.init(*data_buffer_pool_, db_->log_handler());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init morsel iterator. table=%s, rc=%s", name(), strrc(rc));
+  }
+  return rc;
+}
+
 RC Table::delete_entry_of_indexes(const char *data, const RID &rid, bool ignore_nonexist) {
   // 删除索引条目的方法
   RC rc = RC::SUCCESS;
@@ -267,6 +617,23 @@ Index *Table::find_index_by_field(const char *field_name) const
   return nullptr; // 未找到索引，返回空指针
 }
 
+Index *Table::find_equality_index(const char *field_name) const
+{
+  Index *found = nullptr;
+  for (Index *index : indexes_) {
+    if (0 != strcmp(index->index_meta().field(), field_name)) {
+      continue;
+    }
+    if (index->index_meta().type() == IndexType::HASH) {
+      return index; // 哈希索引做等值查找只需要访问一个桶
+    }
+    if (found == nullptr) {
+      found = index;
+    }
+  }
+  return found;
+}
+
 RC Table::sync()
 {
   RC rc = RC::SUCCESS; // 初始化返回状态
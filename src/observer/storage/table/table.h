@@ -16,8 +16,10 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/table/table_meta.h"
 #include "common/types.h"
+#include "common/lang/atomic.h"
 #include "common/lang/span.h"
 #include "common/lang/functional.h"
+#include "common/lang/mutex.h"
 
 struct RID;
 class Record;
@@ -25,6 +27,7 @@ class DiskBufferPool;
 class RecordFileHandler;
 class RecordFileScanner;
 class ChunkFileScanner;
+class PageMorselIterator;
 class ConditionFilter;
 class DefaultConditionFilter;
 class Index;
@@ -76,19 +79,82 @@ public:
    * @param record[in/out] 传入的数据包含具体的数据，插入成功会通过此字段返回RID
    */
   RC insert_record(Record &record);
+
+  /**
+   * @brief 在当前的表中批量插入记录
+   * @details 同一个页面上的记录一起插入，只写一条日志；索引按索引逐个插入所有记录。
+   * 任何一条记录插入失败，已经插入的数据都会删除。
+   * @param records[in/out] 插入成功会设置每条记录的RID
+   * @param logging 是否记录数据页面的日志。不记录日志时，调用者要在结束后调用 sync 把数据刷到磁盘
+   */
+  RC insert_records(vector<Record> &records, bool logging = true);
   RC delete_record(const Record &record);
   RC delete_record(const RID &rid);
   RC get_record(const RID &rid, Record &record);
 
+  /**
+   * @brief 原地更新一条记录
+   * @details 记录的位置不变，只写一条 UPDATE 日志。只有索引字段的值发生了变化时才修改对应的索引，
+   * 新的索引项插入失败(比如唯一索引冲突)时不会修改任何数据。这里不关心事务相关操作
+   * @param old_record 更新前的记录
+   * @param new_record 更新后的数据，更新成功会设置为 old_record 的 RID
+   */
+  RC update_record(const Record &old_record, Record &new_record);
+
+  /**
+   * @brief 把一个字段的值写入到记录中
+   * @details value 的类型需要与字段相同
+   */
+  RC set_value_to_record(char *record_data, const Value &value, const FieldMeta *field);
+
   RC recover_insert_record(Record &record);
 
   // TODO refactor
-  RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name);
+  /**
+   * @brief 创建索引
+   * @details 如果表中已经有数据，B+树索引会先扫描全表排序，再批量构建索引；哈希索引逐条插入
+   * @param index_type 索引类型
+   * @param fill_factor 批量构建B+树索引时页面的填充因子
+   */
+  RC create_index(
+      Trx *trx, const FieldMeta *field_meta, const char *index_name, IndexType index_type, float fill_factor);
+
+  static constexpr int64_t ANALYZE_SAMPLE_PAGES = 1000;  ///< 收集统计信息时最多读取的页面数
+
+  /**
+   * @brief 收集表和字段的统计信息(ANALYZE TABLE)
+   * @details 页面较多时按页面采样，最多读取 ANALYZE_SAMPLE_PAGES 个页面，再根据采样比例推算总行数。
+   * 统计信息写入元数据文件，重新打开表时加载。
+   * @param trx 使用哪个事务读取数据，为空时读取所有的记录，包括还没有提交的
+   */
+  RC analyze(Trx *trx);
+
+  /**
+   * @brief 修改的行数超过阈值时重新收集统计信息
+   * @details 只处理收集过统计信息的表。插入和删除的行数超过上次收集时行数的 20%(至少 1000 行)时认为统计信息过期。
+   * 已经有其它线程在收集时直接返回。
+   * @param[out] refreshed 是否重新收集了统计信息
+   */
+  RC refresh_statistics_if_expired(bool &refreshed);
+
+  /// 最近一次收集的统计信息，没有收集过时返回空
+  shared_ptr<const TableStatistics> statistics() const;
+
+  /**
+   * @brief 估算当前的行数
+   * @details 在统计信息中的行数基础上加上之后插入的行数，减去删除的行数。没有统计信息时返回 -1
+   */
+  int64_t estimated_row_count() const;
 
   RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, ReadWriteMode mode);
 
   RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode);
 
+  /**
+   * @brief 初始化并行扫描时多个 ChunkFileScanner 共享的页面迭代器
+   */
+  RC init_morsel_iterator(PageMorselIterator &iterator);
+
   RecordFileHandler *record_handler() const { return record_handler_; }
 
   /**
@@ -113,14 +179,27 @@ public:
 private:
   RC insert_entry_of_indexes(const char *record, const RID &rid);
   RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
-  RC set_value_to_record(char *record_data, const Value &value, const FieldMeta *field);
 
 private:
   RC init_record_handler(const char *base_dir);
 
+  /**
+   * @brief 把新的元数据写入元数据文件
+   * @details 先写一个临时文件，写入完成后再rename为正式文件，防止文件内容不完整
+   */
+  RC write_table_meta(const TableMeta &table_meta);
+
+  /// 收集统计信息，调用者需要持有 analyze_lock_
+  RC collect_statistics(Trx *trx);
+
 public:
   Index *find_index(const char *index_name) const;
   Index *find_index_by_field(const char *field_name) const;
+  /**
+   * @brief 查找可以用于等值查询的索引
+   * @details 同一个字段上有多个索引时优先返回哈希索引
+   */
+  Index *find_equality_index(const char *field_name) const;
 
 private:
   Db                *db_ = nullptr;
@@ -129,4 +208,9 @@ private:
   DiskBufferPool    *data_buffer_pool_ = nullptr;  /// 数据文件关联的buffer pool
   RecordFileHandler *record_handler_   = nullptr;  /// 记录操作
   vector<Index *>    indexes_;
+
+  mutable mutex   statistics_lock_;               ///< 保护 table_meta_ 中的统计信息
+  mutex           analyze_lock_;                  ///< 同一时刻只有一个线程收集统计信息
+  atomic<int64_t> analyzed_inserted_count_{0};  ///< 收集统计信息时记录文件中累计插入的行数
+  atomic<int64_t> analyzed_deleted_count_{0};   ///< 收集统计信息时记录文件中累计删除的行数
 };
@@ -26,6 +26,7 @@ static const Json::StaticString FIELD_TABLE_NAME("table_name");
 static const Json::StaticString FIELD_STORAGE_FORMAT("storage_format");
 static const Json::StaticString FIELD_FIELDS("fields");
 static const Json::StaticString FIELD_INDEXES("indexes");
+static const Json::StaticString FIELD_STATISTICS("statistics");
 
 // TableMeta类的构造函数，复制构造
 TableMeta::TableMeta(const TableMeta &other)
@@ -34,6 +35,7 @@ TableMeta::TableMeta(const TableMeta &other)
       fields_(other.fields_),             // 复制字段元数据
       indexes_(other.indexes_),           // 复制索引元数据
       storage_format_(other.storage_format_), // 复制存储格式
+      statistics_(other.statistics_),     // 统计信息不会被修改，可以共享
       record_size_(other.record_size_)    // 复制记录大小
 {}
 
@@ -43,6 +45,7 @@ void TableMeta::swap(TableMeta &other) noexcept
   name_.swap(other.name_);               // 交换表名
   fields_.swap(other.fields_);           // 交换字段元数据
   indexes_.swap(other.indexes_);         // 交换索引元数据
+  statistics_.swap(other.statistics_);   // 交换统计信息
   std::swap(record_size_, other.record_size_); // 交换记录大小
 }
 
@@ -215,6 +218,12 @@ int TableMeta::serialize(std::ostream &ss) const
   }
   table_value[FIELD_INDEXES] = std::move(indexes_value); // 设置索引数组到表对象
 
+  if (statistics_ != nullptr) {
+    Json::Value statistics_value;
+    statistics_->to_json(statistics_value); // 将统计信息转换为JSON格式
+    table_value[FIELD_STATISTICS] = std::move(statistics_value);
+  }
+
   Json::StreamWriterBuilder builder; // 创建JSON写入器
   Json::StreamWriter       *writer = builder.newStreamWriter(); // 新建写入器
 
@@ -328,6 +337,18 @@ int TableMeta::deserialize(std::istream &is)
     indexes_.swap(indexes); // 交换索引元数据
   }
 
+  // 处理统计信息。统计信息只影响执行计划，损坏时丢弃，不影响表的打开
+  const Json::Value &statistics_value = table_value[FIELD_STATISTICS];
+  if (!statistics_value.isNull()) {
+    auto statistics = make_shared<TableStatistics>();
+    rc = TableStatistics::from_json(statistics_value, *statistics);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("Failed to deserialize table statistics, ignore it. table name=%s", name_.c_str());
+    } else {
+      statistics_ = std::move(statistics);
+    }
+  }
+
   return (int)(is.tellg() - old_pos); // 返回读取字节数
 }
 
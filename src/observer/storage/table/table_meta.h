@@ -18,11 +18,13 @@ See the Mulan PSL v2 for more details. */
 #include <vector>
 #include <span>
 
+#include "common/lang/memory.h"
 #include "common/lang/serializable.h"
 #include "common/rc.h"
 #include "common/types.h"
 #include "storage/field/field_meta.h"
 #include "storage/index/index_meta.h"
+#include "storage/table/table_statistics.h"
 
 /**
  * @brief 表元数据
@@ -64,6 +66,10 @@ public:
 
   int record_size() const;
 
+  /// ANALYZE TABLE 收集的统计信息，没有收集过时为空
+  const shared_ptr<const TableStatistics> &statistics() const { return statistics_; }
+  void set_statistics(shared_ptr<const TableStatistics> statistics) { statistics_ = std::move(statistics); }
+
 public:
   int  serialize(std::ostream &os) const override;
   int  deserialize(std::istream &is) override;
@@ -79,5 +85,7 @@ protected:
   std::vector<IndexMeta> indexes_;
   StorageFormat          storage_format_;
 
+  shared_ptr<const TableStatistics> statistics_;
+
   int record_size_ = 0;
 };
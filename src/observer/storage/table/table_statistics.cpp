@@ -0,0 +1,321 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <math.h>
+#include <string.h>
+
+#include "storage/table/table_statistics.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+#include "storage/field/field_meta.h"
+#include "storage/table/table_meta.h"
+#include "json/json.h"
+
+using namespace std;
+
+static const Json::StaticString FIELD_ROW_COUNT("row_count");
+static const Json::StaticString FIELD_PAGE_COUNT("page_count");
+static const Json::StaticString FIELD_COLUMNS("columns");
+static const Json::StaticString FIELD_NAME("name");
+static const Json::StaticString FIELD_TYPE("type");
+static const Json::StaticString FIELD_NDV("ndv");
+static const Json::StaticString FIELD_NULL_FRACTION("null_fraction");
+static const Json::StaticString FIELD_HISTOGRAM("histogram");
+
+namespace {
+
+bool value_less(const Value &left, const Value &right) { return left.compare(right) < 0; }
+
+bool is_numeric(AttrType type) { return type == AttrType::INTS || type == AttrType::FLOATS; }
+
+Json::Value value_to_json(const Value &value)
+{
+  switch (value.attr_type()) {
+    case AttrType::INTS: return Json::Value(value.get_int());
+    case AttrType::FLOATS: return Json::Value(static_cast<double>(value.get_float()));
+    case AttrType::BOOLEANS: return Json::Value(value.get_boolean());
+    default: return Json::Value(value.get_string());
+  }
+}
+
+RC value_from_json(const Json::Value &json_value, AttrType type, Value &value)
+{
+  switch (type) {
+    case AttrType::INTS: {
+      if (!json_value.isInt()) {
+        return RC::INTERNAL;
+      }
+      value = Value(json_value.asInt());
+    } break;
+    case AttrType::FLOATS: {
+      if (!json_value.isNumeric()) {
+        return RC::INTERNAL;
+      }
+      value = Value(static_cast<float>(json_value.asDouble()));
+    } break;
+    case AttrType::BOOLEANS: {
+      if (!json_value.isBool()) {
+        return RC::INTERNAL;
+      }
+      value = Value(json_value.asBool());
+    } break;
+    case AttrType::CHARS: {
+      if (!json_value.isString()) {
+        return RC::INTERNAL;
+      }
+      value = Value(json_value.asCString());
+    } break;
+    default: {
+      return RC::INTERNAL;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+}  // namespace
+
+double ColumnStatistics::selectivity(CompOp op, const Value &value) const
+{
+  Value casted_value;
+  if (value.attr_type() == type) {
+    casted_value = value;
+  } else if (OB_FAIL(Value::cast_to(value, type, casted_value))) {
+    return -1;
+  }
+
+  switch (op) {
+    case EQUAL_TO: return equal_selectivity(casted_value);
+    case NOT_EQUAL: return 1.0 - equal_selectivity(casted_value);
+    case LESS_THAN: return less_selectivity(casted_value, false);
+    case LESS_EQUAL: return less_selectivity(casted_value, true);
+    case GREAT_THAN: return 1.0 - less_selectivity(casted_value, true);
+    case GREAT_EQUAL: return 1.0 - less_selectivity(casted_value, false);
+    default: return -1;
+  }
+}
+
+double ColumnStatistics::equal_selectivity(const Value &value) const
+{
+  const int buckets = bucket_num();
+  if (ndv <= 0 || buckets <= 0) {
+    return 0;
+  }
+  if (value.compare(histogram.front()) < 0 || value.compare(histogram.back()) > 0) {
+    return 0;  // 超出了最小值和最大值的范围
+  }
+
+  // 等深直方图中，出现次数很多的值会成为多个桶的上界，这几个桶中只有这一个值
+  const auto   range          = std::equal_range(histogram.begin() + 1, histogram.end(), value, value_less);
+  const double frequent_ratio = static_cast<double>(std::max<ptrdiff_t>(range.second - range.first - 1, 0)) / buckets;
+  return std::max(1.0 / ndv, frequent_ratio);
+}
+
+double ColumnStatistics::less_selectivity(const Value &value, bool or_equal) const
+{
+  const int buckets = bucket_num();
+  if (buckets <= 0) {
+    return 0;
+  }
+  if (value.compare(histogram.front()) < 0) {
+    return 0;
+  }
+  if (value.compare(histogram.back()) > 0) {
+    return 1;
+  }
+
+  // 第 i 个桶中的值在 (histogram[i-1], histogram[i]] 之间
+  const int bucket = static_cast<int>(
+      std::lower_bound(histogram.begin() + 1, histogram.end(), value, value_less) - histogram.begin());
+  const Value &low  = histogram[bucket - 1];
+  const Value &high = histogram[bucket];
+
+  double position = 0.5;  // 字符串无法插值，认为在桶的中间
+  if (is_numeric(type)) {
+    const double low_value  = low.get_float();
+    const double high_value = high.get_float();
+    position = high_value > low_value ? (value.get_float() - low_value) / (high_value - low_value) : 1.0;
+  }
+
+  double result = (bucket - 1 + position) / buckets;
+  if (or_equal) {
+    result += equal_selectivity(value);
+  }
+  return std::clamp(result, 0.0, 1.0);
+}
+
+void ColumnStatistics::to_json(Json::Value &json_value) const
+{
+  json_value[FIELD_NAME]          = field_name;
+  json_value[FIELD_TYPE]          = attr_type_to_string(type);
+  json_value[FIELD_NDV]           = Json::Int64(ndv);
+  json_value[FIELD_NULL_FRACTION] = null_fraction;
+
+  Json::Value histogram_value(Json::arrayValue);
+  for (const Value &bound : histogram) {
+    histogram_value.append(value_to_json(bound));
+  }
+  json_value[FIELD_HISTOGRAM] = std::move(histogram_value);
+}
+
+RC ColumnStatistics::from_json(const Json::Value &json_value, ColumnStatistics &column)
+{
+  const Json::Value &name_value          = json_value[FIELD_NAME];
+  const Json::Value &type_value          = json_value[FIELD_TYPE];
+  const Json::Value &ndv_value           = json_value[FIELD_NDV];
+  const Json::Value &null_fraction_value = json_value[FIELD_NULL_FRACTION];
+  const Json::Value &histogram_value     = json_value[FIELD_HISTOGRAM];
+  if (!name_value.isString() || !type_value.isString() || !ndv_value.isIntegral() ||
+      !null_fraction_value.isNumeric() || !histogram_value.isArray()) {
+    LOG_ERROR("Invalid column statistics. json value=%s", json_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  column.field_name    = name_value.asString();
+  column.type          = attr_type_from_string(type_value.asCString());
+  column.ndv           = ndv_value.asInt64();
+  column.null_fraction = null_fraction_value.asDouble();
+  column.histogram.clear();
+  for (const Json::Value &bound_value : histogram_value) {
+    Value bound;
+    RC    rc = value_from_json(bound_value, column.type, bound);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Invalid histogram of column statistics. field=%s, json value=%s",
+                column.field_name.c_str(), bound_value.toStyledString().c_str());
+      return rc;
+    }
+    column.histogram.push_back(std::move(bound));
+  }
+  return RC::SUCCESS;
+}
+
+const ColumnStatistics *TableStatistics::column(const char *field_name) const
+{
+  for (const ColumnStatistics &column : columns) {
+    if (0 == strcmp(column.field_name.c_str(), field_name)) {
+      return &column;
+    }
+  }
+  return nullptr;
+}
+
+void TableStatistics::to_json(Json::Value &json_value) const
+{
+  json_value[FIELD_ROW_COUNT]  = Json::Int64(row_count);
+  json_value[FIELD_PAGE_COUNT] = Json::Int64(page_count);
+
+  Json::Value columns_value(Json::arrayValue);
+  for (const ColumnStatistics &column : columns) {
+    Json::Value column_value;
+    column.to_json(column_value);
+    columns_value.append(std::move(column_value));
+  }
+  json_value[FIELD_COLUMNS] = std::move(columns_value);
+}
+
+RC TableStatistics::from_json(const Json::Value &json_value, TableStatistics &statistics)
+{
+  const Json::Value &row_count_value  = json_value[FIELD_ROW_COUNT];
+  const Json::Value &page_count_value = json_value[FIELD_PAGE_COUNT];
+  const Json::Value &columns_value    = json_value[FIELD_COLUMNS];
+  if (!row_count_value.isIntegral() || !page_count_value.isIntegral() || !columns_value.isArray()) {
+    LOG_ERROR("Invalid table statistics. json value=%s", json_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  statistics.row_count  = row_count_value.asInt64();
+  statistics.page_count = page_count_value.asInt64();
+  statistics.columns.resize(columns_value.size());
+  for (Json::ArrayIndex i = 0; i < columns_value.size(); i++) {
+    RC rc = ColumnStatistics::from_json(columns_value[i], statistics.columns[i]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+StatisticsCollector::StatisticsCollector(const TableMeta &table_meta, int sample_rows, int bucket_num, uint32_t seed)
+    : sample_rows_(std::max(sample_rows, 1)), bucket_num_(std::max(bucket_num, 1)), random_(seed)
+{
+  for (const FieldMeta &field : *table_meta.field_metas()) {
+    if (!field.visible()) {
+      continue;  // 事务使用的隐藏字段不需要统计
+    }
+    Column column;
+    column.field = &field;
+    columns_.push_back(std::move(column));
+  }
+}
+
+void StatisticsCollector::add_record(const char *data)
+{
+  // 蓄水池抽样：第 n 行以 sample_rows/n 的概率替换掉已经保留的某一行，所有字段使用同一个位置
+  int64_t slot = row_count_;
+  row_count_++;
+  if (slot >= sample_rows_) {
+    slot = uniform_int_distribution<int64_t>(0, row_count_ - 1)(random_);
+  }
+  const bool sampled = slot < sample_rows_;
+
+  for (Column &column : columns_) {
+    const FieldMeta *field      = column.field;
+    const char      *field_data = data + field->offset();
+    int              length     = field->len();
+    if (field->type() == AttrType::CHARS) {
+      length = static_cast<int>(strnlen(field_data, length));
+    }
+    column.hll.add(field_data, length);
+
+    if (!sampled) {
+      continue;
+    }
+    Value value;
+    value.set_type(field->type());
+    value.set_data(field_data, length);
+    if (slot < static_cast<int64_t>(column.samples.size())) {
+      column.samples[slot] = std::move(value);
+    } else {
+      column.samples.push_back(std::move(value));
+    }
+  }
+}
+
+void StatisticsCollector::finish(int64_t total_rows, int64_t page_count, TableStatistics &statistics)
+{
+  total_rows = std::max(total_rows, row_count_);
+
+  statistics.row_count  = total_rows;
+  statistics.page_count = page_count;
+  statistics.columns.clear();
+  for (Column &column : columns_) {
+    ColumnStatistics column_statistics;
+    column_statistics.field_name = column.field->name();
+    column_statistics.type       = column.field->type();
+
+    double ndv = column.hll.estimate();
+    if (row_count_ > 0 && total_rows > row_count_ && ndv > 0.9 * row_count_) {
+      ndv = ndv * total_rows / row_count_;  // 采样中几乎都是不同的值，认为它是随行数增长的
+    }
+    column_statistics.ndv = std::clamp<int64_t>(llround(ndv), row_count_ > 0 ? 1 : 0, total_rows);
+
+    vector<Value> &samples = column.samples;
+    std::sort(samples.begin(), samples.end(), value_less);
+    const int64_t sample_num = static_cast<int64_t>(samples.size());
+    if (sample_num > 0) {
+      const int64_t buckets = std::min<int64_t>(bucket_num_, sample_num);
+      column_statistics.histogram.reserve(buckets + 1);
+      column_statistics.histogram.push_back(samples.front());
+      for (int64_t i = 1; i <= buckets; i++) {
+        column_statistics.histogram.push_back(samples[(i * sample_num + buckets - 1) / buckets - 1]);
+      }
+    }
+    statistics.columns.push_back(std::move(column_statistics));
+  }
+}
@@ -0,0 +1,116 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/random.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/math/hyper_log_log.h"
+#include "common/rc.h"
+#include "common/value.h"
+#include "sql/parser/parse_defs.h"
+
+namespace Json {
+class Value;
+}  // namespace Json
+
+class FieldMeta;
+class TableMeta;
+
+/**
+ * @brief 一个字段的统计信息
+ * @details 由 ANALYZE TABLE 收集，用于估算谓词的选择率
+ */
+struct ColumnStatistics
+{
+  string        field_name;
+  AttrType      type          = AttrType::UNDEFINED;
+  int64_t       ndv           = 0;  ///< 不同值的个数
+  double        null_fraction = 0;  ///< 空值的比例，当前不支持空值，总是0
+  vector<Value> histogram;          ///< 等深直方图，第一个是最小值，后面依次是每个桶的上界
+
+  /// 直方图中桶的个数，每个桶中的行数大致相同
+  int bucket_num() const { return histogram.empty() ? 0 : static_cast<int>(histogram.size()) - 1; }
+
+  /**
+   * @brief 估算 field op value 的选择率，即满足条件的行占的比例
+   * @details 值的类型与字段不同并且不能转换时返回 -1，由调用者使用默认的选择率
+   */
+  double selectivity(CompOp op, const Value &value) const;
+
+  /// 等于 value 的行占的比例，出现次数很多的值根据直方图估算，其它的值认为均匀分布
+  double equal_selectivity(const Value &value) const;
+
+  /// 小于(or_equal 时小于等于) value 的行占的比例，根据直方图在桶内线性插值
+  double less_selectivity(const Value &value, bool or_equal) const;
+
+  void      to_json(Json::Value &json_value) const;
+  static RC from_json(const Json::Value &json_value, ColumnStatistics &column);
+};
+
+/**
+ * @brief 表的统计信息
+ * @details 保存在表的元数据中，打开表时加载
+ */
+struct TableStatistics
+{
+  int64_t                  row_count  = 0;  ///< 收集统计信息时表中的行数
+  int64_t                  page_count = 0;  ///< 收集统计信息时数据文件的页面数，不包含文件头
+  vector<ColumnStatistics> columns;
+
+  const ColumnStatistics *column(const char *field_name) const;
+
+  void      to_json(Json::Value &json_value) const;
+  static RC from_json(const Json::Value &json_value, TableStatistics &statistics);
+};
+
+/**
+ * @brief 根据扫描到的记录生成统计信息
+ * @details 每个字段使用 HyperLogLog 估算NDV，同时使用蓄水池抽样保留一部分记录，排序后生成等深直方图。
+ * 按页面采样时，采样到的行中几乎都是不同的值的字段，认为它的NDV随行数线性增长，按照采样比例放大；
+ * 否则认为采样已经覆盖了所有的值。
+ */
+class StatisticsCollector
+{
+public:
+  static constexpr int DEFAULT_SAMPLE_ROWS = 30000;
+  static constexpr int DEFAULT_BUCKET_NUM  = 100;
+
+  StatisticsCollector(const TableMeta &table_meta, int sample_rows = DEFAULT_SAMPLE_ROWS,
+      int bucket_num = DEFAULT_BUCKET_NUM, uint32_t seed = 0);
+
+  /// 加入一条记录的数据
+  void add_record(const char *data);
+
+  /// 已经加入的记录数
+  int64_t row_count() const { return row_count_; }
+
+  /**
+   * @brief 生成统计信息
+   * @param total_rows 表中的总行数，按页面采样时由调用者根据采样比例推算
+   * @param page_count 数据文件的页面数
+   */
+  void finish(int64_t total_rows, int64_t page_count, TableStatistics &statistics);
+
+private:
+  struct Column
+  {
+    const FieldMeta   *field = nullptr;
+    common::HyperLogLog hll;
+    vector<Value>      samples;
+  };
+
+  vector<Column> columns_;
+  int64_t        row_count_ = 0;
+  int            sample_rows_;
+  int            bucket_num_;
+  mt19937        random_;
+};
@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/trx/lock_manager.h"
+#include "common/log/log.h"
+
+LockManager::~LockManager()
+{
+  ASSERT(waiting_.empty(), "lock manager destroyed while someone is waiting. waiting=%d", static_cast<int>(waiting_.size()));
+}
+
+RC LockManager::lock_row(int32_t trx_id, const RowLockKey &key)
+{
+  unique_lock<mutex> guard(lock_);
+
+  LockQueue &queue = queues_[key];
+  if (queue.holder == -1) {
+    ASSERT(queue.waiters.empty(), "got a free row lock with waiters. waiters=%d", static_cast<int>(queue.waiters.size()));
+    queue.holder = trx_id;
+    return RC::SUCCESS;
+  }
+
+  if (queue.holder == trx_id) {
+    return RC::SUCCESS;
+  }
+
+  if (detect_deadlock(trx_id, queue)) {
+    deadlock_count_++;
+    LOG_INFO("deadlock detected. trx id=%d, holder=%d, table id=%d, rid=%s",
+             trx_id, queue.holder, key.table_id, key.rid.to_string().c_str());
+    return RC::LOCKED_DEADLOCK;
+  }
+
+  Waiter waiter;
+  waiter.trx_id = trx_id;
+  queue.waiters.push_back(&waiter);
+  waiting_.emplace(trx_id, key);
+  wait_count_++;
+
+  LOG_TRACE("wait for row lock. trx id=%d, holder=%d, table id=%d, rid=%s",
+            trx_id, queue.holder, key.table_id, key.rid.to_string().c_str());
+  // 拿到锁时，释放锁的事务会负责把当前事务从 waiting_ 中删除
+  if (waiter.cond.wait_for(guard, wait_timeout_, [&waiter]() { return waiter.granted; })) {
+    return RC::SUCCESS;
+  }
+
+  // 有等待者时队列不会被删除，这里的 queue 仍然有效
+  queue.waiters.remove(&waiter);
+  waiting_.erase(trx_id);
+  timeout_count_++;
+  LOG_INFO("wait for row lock timeout. trx id=%d, holder=%d, table id=%d, rid=%s",
+           trx_id, queue.holder, key.table_id, key.rid.to_string().c_str());
+  return RC::LOCKED_WAIT_TIMEOUT;
+}
+
+void LockManager::unlock_rows(int32_t trx_id, const RowLockSet &keys)
+{
+  lock_guard<mutex> guard(lock_);
+  for (const RowLockKey &key : keys) {
+    auto iter = queues_.find(key);
+    if (iter == queues_.end() || iter->second.holder != trx_id) {
+      continue;
+    }
+
+    LockQueue &queue = iter->second;
+    if (queue.waiters.empty()) {
+      queues_.erase(iter);
+      continue;
+    }
+
+    Waiter *waiter = queue.waiters.front();
+    queue.waiters.pop_front();
+    queue.holder    = waiter->trx_id;
+    waiter->granted = true;
+    waiting_.erase(waiter->trx_id);
+    waiter->cond.notify_one();
+  }
+}
+
+int LockManager::locked_row_count() const
+{
+  lock_guard<mutex> guard(lock_);
+  return static_cast<int>(queues_.size());
+}
+
+bool LockManager::detect_deadlock(int32_t trx_id, const LockQueue &queue) const
+{
+  // 申请者还没有进入队列，队列中所有的事务都排在它前面
+  vector<int32_t> dependencies;
+  add_dependencies(trx_id, queue, dependencies);
+
+  unordered_set<int32_t> visited;
+  while (!dependencies.empty()) {
+    int32_t dependency = dependencies.back();
+    dependencies.pop_back();
+    if (dependency == trx_id) {
+      return true;
+    }
+    if (!visited.insert(dependency).second) {
+      continue;
+    }
+
+    auto waiting_iter = waiting_.find(dependency);
+    if (waiting_iter == waiting_.end()) {
+      continue;  // 这个事务没有在等待，依赖链到此结束
+    }
+    auto queue_iter = queues_.find(waiting_iter->second);
+    ASSERT(queue_iter != queues_.end(), "cannot find the lock queue of a waiting trx. trx id=%d", dependency);
+    add_dependencies(dependency, queue_iter->second, dependencies);
+  }
+  return false;
+}
+
+void LockManager::add_dependencies(int32_t trx_id, const LockQueue &queue, vector<int32_t> &dependencies) const
+{
+  dependencies.push_back(queue.holder);
+  for (const Waiter *waiter : queue.waiters) {
+    if (waiter->trx_id == trx_id) {
+      break;
+    }
+    dependencies.push_back(waiter->trx_id);
+  }
+}
@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/chrono.h"
+#include "common/lang/list.h"
+#include "common/lang/mutex.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/unordered_set.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+#include "storage/record/record.h"
+
+/**
+ * @brief 行锁的标识
+ * @ingroup Transaction
+ */
+struct RowLockKey
+{
+  int32_t table_id = -1;
+  RID     rid;
+
+  bool operator==(const RowLockKey &other) const { return table_id == other.table_id && rid == other.rid; }
+};
+
+struct RowLockKeyHash
+{
+  size_t operator()(const RowLockKey &key) const noexcept
+  {
+    return std::hash<int32_t>()(key.table_id) ^ (RIDHash()(key.rid) << 1);
+  }
+};
+
+using RowLockSet = unordered_set<RowLockKey, RowLockKeyHash>;
+
+/**
+ * @brief 行锁管理器
+ * @ingroup Transaction
+ * @details 只有排他锁，用来让修改同一行的事务排队，而不是发现冲突就立即失败。
+ * 每一行有一个持有者和一个先进先出的等待队列。事务持有的锁在提交或回滚时一起释放，
+ * 然后按照队列的顺序交给下一个等待者。
+ * 开始等待之前，在等待图上查找从申请者出发的环，有环说明会死锁，申请者直接返回 LOCKED_DEADLOCK。
+ * 等待超时返回 LOCKED_WAIT_TIMEOUT，作为死锁检测之外的兜底。
+ * 死锁检测需要看到所有的等待关系，所以所有的行锁共用一把互斥锁。
+ */
+class LockManager
+{
+public:
+  LockManager() = default;
+  ~LockManager();
+
+  /// 等待一个锁的最长时间
+  void set_wait_timeout(chrono::milliseconds timeout) { wait_timeout_ = timeout; }
+
+  /**
+   * @brief 申请一行的排他锁
+   * @details 已经持有这个锁时直接返回成功。锁被其它事务持有时会一直等待，直到拿到锁、发现死锁或者超时
+   * @param trx_id 申请锁的事务
+   * @param key    要加锁的行
+   */
+  RC lock_row(int32_t trx_id, const RowLockKey &key);
+
+  /**
+   * @brief 释放事务持有的一批锁
+   * @details 不是这个事务持有的锁会被忽略。每个锁都交给等待队列中的第一个事务
+   */
+  void unlock_rows(int32_t trx_id, const RowLockSet &keys);
+
+  /// 当前被持有的行锁的个数
+  int locked_row_count() const;
+
+  int64_t wait_count() const { return wait_count_.load(); }
+  int64_t deadlock_count() const { return deadlock_count_.load(); }
+  int64_t timeout_count() const { return timeout_count_.load(); }
+
+private:
+  struct Waiter
+  {
+    int32_t            trx_id  = -1;
+    bool               granted = false;
+    condition_variable cond;
+  };
+
+  struct LockQueue
+  {
+    int32_t        holder = -1;
+    list<Waiter *> waiters;  ///< 先进先出
+  };
+
+  /**
+   * @brief 判断 trx_id 在 queue 上等待是否会形成死锁
+   * @details 一个等待者依赖当前的持有者，以及排在它前面的等待者，因为这些事务会先拿到锁。
+   * 沿着这些依赖关系能回到 trx_id 就说明有环
+   */
+  bool detect_deadlock(int32_t trx_id, const LockQueue &queue) const;
+
+  /// 把 trx_id 依赖的事务加入到 dependencies 中。queue 是 trx_id 正在等待的锁
+  void add_dependencies(int32_t trx_id, const LockQueue &queue, vector<int32_t> &dependencies) const;
+
+private:
+  mutable mutex                                         lock_;
+  unordered_map<RowLockKey, LockQueue, RowLockKeyHash> queues_;
+  unordered_map<int32_t, RowLockKey>                    waiting_;  ///< 正在等待的事务以及它等待的锁
+
+  chrono::milliseconds wait_timeout_{chrono::seconds(10)};
+
+  atomic<int64_t> wait_count_{0};
+  atomic<int64_t> deadlock_count_{0};
+  atomic<int64_t> timeout_count_{0};
+};
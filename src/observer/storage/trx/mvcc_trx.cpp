@@ -17,6 +17,38 @@ See the Mulan PSL v2 for more details. */
 #include "storage/field/field.h"
 #include "storage/trx/mvcc_trx_log.h"
 #include "common/lang/algorithm.h"
+#include "common/math/simd_util.h"
+
+namespace {
+
+/**
+ * @brief 只读访问时记录对事务 trx_id 是否可见
+ * @details 与 MvccTrx::visit_record 在只读模式下的判断完全相同，只是写成了没有分支的形式：
+ * - begin_xid < 0：未提交的插入，只有插入它的事务可见
+ * - begin_xid >= 0 且 end_xid < 0：未提交的删除，只有删除它的事务不可见
+ * - 都大于 0：已经提交的记录，事务号在 [begin_xid, end_xid] 之间时可见
+ * - 其它情况都可见
+ */
+inline bool visible_for_read(int32_t trx_id, int32_t begin_xid, int32_t end_xid)
+{
+  const bool inserting = begin_xid < 0;
+  const bool deleting  = !inserting & (end_xid < 0);
+  const bool committed = (begin_xid > 0) & (end_xid > 0);
+  const bool in_range  = (begin_xid <= trx_id) & (trx_id <= end_xid);
+  return (inserting & (begin_xid == -trx_id)) | (deleting & (end_xid != -trx_id)) |
+         (!inserting & !deleting & (!committed | in_range));
+}
+
+/// 事务字段在记录中的位置。表的元数据中已经保存了这些字段，不需要每次都构造 Field 对象
+inline void trx_field_offsets(Table *table, int &begin_xid_offset, int &end_xid_offset)
+{
+  span<const FieldMeta> trx_fields = table->table_meta().trx_fields();
+  ASSERT(trx_fields.size() >= 2, "invalid trx fields number. %d", trx_fields.size());
+  begin_xid_offset = trx_fields[0].offset();
+  end_xid_offset   = trx_fields[1].offset();
+}
+
+}  // namespace
 
 MvccTrxKit::~MvccTrxKit()
 {
@@ -151,7 +183,11 @@ MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler, int32_t trx_id)
   recovering_ = true;
 }
 
-MvccTrx::~MvccTrx() {}
+MvccTrx::~MvccTrx()
+{
+  // 没有提交也没有回滚就销毁的事务，不能一直占着行锁
+  unlock_rows();
+}
 
 /**
  * 在多版本并发控制事务中插入记录
@@ -195,6 +231,34 @@ RC MvccTrx::insert_record(Table *table, Record &record)
   return rc;
 }
 
+RC MvccTrx::insert_records(Table *table, vector<Record> &records)
+{
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
+
+  // 与 insert_record 一样设置每条记录的版本号
+  for (Record &record : records) {
+    begin_field.set_int(record, -trx_id_);
+    end_field.set_int(record, trx_kit_.max_trx_id());
+  }
+
+  RC rc = table->insert_records(records);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to insert records into table. records=%d, rc=%s", static_cast<int>(records.size()), strrc(rc));
+    return rc;
+  }
+
+  for (Record &record : records) {
+    rc = log_handler_.insert_record(trx_id_, table, record.rid());
+    ASSERT(rc == RC::SUCCESS, "failed to append insert record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
+           trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
+
+    operations_.push_back(Operation(Operation::Type::INSERT, table, record.rid()));
+  }
+  return rc;
+}
+
 // 删除指定表中的记录
 // 参数:
 //   table: 表指针，表示要删除记录的表
@@ -208,11 +272,18 @@ RC MvccTrx::delete_record(Table *table, Record &record)
   Field end_field;
   trx_fields(table, begin_field, end_field);
 
+  // 先拿到行锁，其它事务正在修改这条记录时在这里等待
+  RC rc = lock_row(table, record.rid());
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("failed to lock record. trx id=%d, rid=%s, rc=%s", trx_id_, record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
   // 初始化删除结果为成功
   RC delete_result = RC::SUCCESS;
 
   // 遍历记录，执行删除操作
-  RC rc = table->visit_record(record.rid(), [this, table, &delete_result, &end_field](Record &inplace_record) -> bool {
+  rc = table->visit_record(record.rid(), [this, table, &delete_result, &end_field](Record &inplace_record) -> bool {
     // 访问记录，进行读写操作
     RC rc = this->visit_record(table, inplace_record, ReadWriteMode::READ_WRITE);
     if (OB_FAIL(rc)) {
@@ -249,6 +320,59 @@ RC MvccTrx::delete_record(Table *table, Record &record)
   return RC::SUCCESS;
 }
 
+RC MvccTrx::update_record(Table *table, Record &old_record, Record &new_record)
+{
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
+
+  RC rc = lock_row(table, old_record.rid());
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("failed to lock record. trx id=%d, rid=%s, rc=%s", trx_id_, old_record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  // 只读取当前版本，判断是否可见以及是不是当前事务自己插入的
+  RC      visit_result = RC::SUCCESS;
+  int32_t begin_xid    = 0;
+  rc = table->visit_record(old_record.rid(), [&](Record &inplace_record) -> bool {
+    visit_result = this->visit_record(table, inplace_record, ReadWriteMode::READ_WRITE);
+    begin_xid    = begin_field.get_int(inplace_record);
+    return false;
+  });
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to visit record. rc=%s", strrc(rc));
+    return rc;
+  }
+  if (OB_FAIL(visit_result)) {
+    LOG_TRACE("record is not visible. rid=%s, rc=%s", old_record.rid().to_string().c_str(), strrc(visit_result));
+    return visit_result;
+  }
+
+  if (begin_xid == -trx_id_) {
+    // 其它事务看不到这条记录，不需要保留旧版本。回滚时撤销插入操作就可以了
+    begin_field.set_int(new_record, -trx_id_);
+    end_field.set_int(new_record, trx_kit_.max_trx_id());
+    rc = table->update_record(old_record, new_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to update record in place. rid=%s, rc=%s", old_record.rid().to_string().c_str(), strrc(rc));
+    }
+    return rc;
+  }
+
+  rc = delete_record(table, old_record);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 插入失败时旧版本已经标记为删除，由事务回滚撤销
+  rc = insert_record(table, new_record);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to insert new version. rid=%s, rc=%s", old_record.rid().to_string().c_str(), strrc(rc));
+  }
+  return rc;
+}
+
 /**
  * @brief 访问记录并确定其可见性
  * 
@@ -262,14 +386,15 @@ RC MvccTrx::delete_record(Table *table, Record &record)
  */
 RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
 {
-  // 初始化记录的开始和结束字段
-  Field begin_field;
-  Field end_field;
-  trx_fields(table, begin_field, end_field);
-
   // 获取记录的开始和结束事务id
-  int32_t begin_xid = begin_field.get_int(record);
-  int32_t end_xid   = end_field.get_int(record);
+  int begin_xid_offset = 0;
+  int end_xid_offset   = 0;
+  trx_field_offsets(table, begin_xid_offset, end_xid_offset);
+
+  int32_t begin_xid = 0;
+  int32_t end_xid   = 0;
+  memcpy(&begin_xid, record.data() + begin_xid_offset, sizeof(begin_xid));
+  memcpy(&end_xid, record.data() + end_xid_offset, sizeof(end_xid));
 
   RC rc = RC::SUCCESS;
 
@@ -278,6 +403,12 @@ RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
     // 如果事务id在记录的开始和结束事务id之间，记录可见
     if (trx_id_ >= begin_xid && trx_id_ <= end_xid) {
       rc = RC::SUCCESS;
+      if (mode == ReadWriteMode::READ_WRITE && end_xid != trx_kit_.max_trx_id()) {
+        // 记录已经被当前事务开始之后提交的事务删除了，不能再修改当前事务看到的旧版本
+        LOG_TRACE("concurrency conflit. record has been deleted by a newer trx. trx id=%d, begin xid=%d, end xid=%d",
+                  trx_id_, begin_xid, end_xid);
+        rc = RC::LOCKED_CONCURRENCY_CONFLICT;
+      }
     } else {
       // 记录不可见，事务id不在记录的可见范围内
       LOG_TRACE("record invisible. trx id=%d, begin xid=%d, end xid=%d", trx_id_, begin_xid, end_xid);
@@ -308,10 +439,10 @@ RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
     } else {
       // 写事务处理未提交删除的记录
       if (-end_xid != trx_id_) {
-        // 并发冲突，有其他事务正在删除此记录
-        LOG_TRACE("concurrency conflit. someone is deleting this record right now. trx id=%d, begin xid=%d, end xid=%d",
+        // 有其他事务正在删除此记录。修改记录之前会等待对方的行锁，拿到锁以后再重新判断，这里先当作可见
+        LOG_TRACE("someone is deleting this record right now. trx id=%d, begin xid=%d, end xid=%d",
                   trx_id_, begin_xid, end_xid);
-        rc = RC::LOCKED_CONCURRENCY_CONFLICT;
+        rc = RC::SUCCESS;
       } else {
         // 记录不可见，当前事务已删除此记录
         LOG_TRACE("record invisible. self has deleted this record. trx id=%d, begin xid=%d, end xid=%d",
@@ -323,6 +454,46 @@ RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
   return rc;
 }
 
+void MvccTrx::filter_visible_records(const int32_t *begin_xids, const int32_t *end_xids, int count, uint8_t *visible)
+{
+  const int32_t trx_id = trx_id_;
+  int           i      = 0;
+#if defined(USE_SIMD)
+  const __m256i ones    = _mm256_set1_epi32(-1);
+  const __m256i zero    = _mm256_setzero_si256();
+  const __m256i trx     = _mm256_set1_epi32(trx_id);
+  const __m256i neg_trx = _mm256_set1_epi32(-trx_id);
+  for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH) {
+    const __m256i begin = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin_xids + i));
+    const __m256i end   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(end_xids + i));
+
+    const __m256i inserting = _mm256_cmpgt_epi32(zero, begin);
+    const __m256i deleting  = _mm256_andnot_si256(inserting, _mm256_cmpgt_epi32(zero, end));
+    const __m256i committed = _mm256_and_si256(_mm256_cmpgt_epi32(begin, zero), _mm256_cmpgt_epi32(end, zero));
+    const __m256i out_range = _mm256_or_si256(_mm256_cmpgt_epi32(begin, trx), _mm256_cmpgt_epi32(trx, end));
+
+    const __m256i insert_visible = _mm256_and_si256(inserting, _mm256_cmpeq_epi32(begin, neg_trx));
+    const __m256i delete_visible = _mm256_andnot_si256(_mm256_cmpeq_epi32(end, neg_trx), deleting);
+    // 没有未提交的修改时，只有已经提交并且事务号不在范围内的记录不可见
+    const __m256i other_visible = _mm256_andnot_si256(
+        _mm256_or_si256(inserting, deleting), _mm256_xor_si256(_mm256_and_si256(committed, out_range), ones));
+
+    const __m256i visible_mask =
+        _mm256_or_si256(_mm256_or_si256(insert_visible, delete_visible), other_visible);
+    const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(visible_mask));
+    if (mask == 0xFF) {
+      continue;
+    }
+    for (int j = 0; j < SIMD_WIDTH; j++) {
+      visible[i + j] &= (mask >> j) & 1;
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    visible[i] &= visible_for_read(trx_id, begin_xids[i], end_xids[i]);
+  }
+}
+
 /**
  * @brief 获取指定表上的事务使用的字段
  *
@@ -342,6 +513,34 @@ void MvccTrx::trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_fi
   end_xid_field.set_field(&trx_fields[1]);
 }
 
+RC MvccTrx::lock_row(Table *table, const RID &rid)
+{
+  // 恢复时只有一个线程在重放日志，不需要加锁
+  if (recovering_) {
+    return RC::SUCCESS;
+  }
+
+  RowLockKey key{table->table_id(), rid};
+  if (row_locks_.count(key) > 0) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = trx_kit_.lock_manager().lock_row(trx_id_, key);
+  if (OB_SUCC(rc)) {
+    row_locks_.insert(key);
+  }
+  return rc;
+}
+
+void MvccTrx::unlock_rows()
+{
+  if (row_locks_.empty()) {
+    return;
+  }
+  trx_kit_.lock_manager().unlock_rows(trx_id_, row_locks_);
+  row_locks_.clear();
+}
+
 RC MvccTrx::start_if_need()
 {
   if (!started_) {
@@ -435,6 +634,7 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
 
   // 清空操作列表
   operations_.clear();
+  unlock_rows();
 
   // 日志记录事务提交
   LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(rc));
@@ -524,6 +724,7 @@ RC MvccTrx::rollback()
   if (!recovering_) {
     rc = log_handler_.rollback(trx_id_);
   }
+  unlock_rows();
   // 记录事务回滚日志
   LOG_TRACE("append trx rollback log. trx id=%d, rc=%s", trx_id_, strrc(rc));
   return rc;
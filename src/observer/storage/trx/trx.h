@@ -147,6 +147,30 @@ public:
   virtual RC delete_record(Table *table, Record &record)                    = 0;
   virtual RC visit_record(Table *table, Record &record, ReadWriteMode mode) = 0;
 
+  /**
+   * @brief 把 old_record 修改为 new_record
+   * @details 成功后 new_record 的 rid 是新数据所在的位置，多版本时可能与 old_record 不同
+   */
+  virtual RC update_record(Table *table, Record &old_record, Record &new_record) = 0;
+
+  /**
+   * @brief 批量判断一批记录对当前事务是否可见
+   * @details 与只读模式的 visit_record 判断规则相同。不可见的记录在 visible 中对应的位置设置为 0，
+   * 其它位置保持不变，可以直接在已有的选择向量上继续过滤。
+   * 读写模式下可能与其它事务冲突，仍然需要逐条调用 visit_record。
+   * @param begin_xids 每条记录的 begin_xid 字段
+   * @param end_xids   每条记录的 end_xid 字段
+   * @param count      记录的条数
+   * @param visible    选择向量，至少有 count 个元素
+   */
+  virtual void filter_visible_records(const int32_t *begin_xids, const int32_t *end_xids, int count, uint8_t *visible) = 0;
+
+  /**
+   * @brief 批量插入多条记录
+   * @details 要么全部插入成功，要么一条都不插入。成功后每条记录的 rid 都会被设置
+   */
+  virtual RC insert_records(Table *table, vector<Record> &records) = 0;
+
   virtual RC start_if_need() = 0;
   virtual RC commit()        = 0;
   virtual RC rollback()      = 0;
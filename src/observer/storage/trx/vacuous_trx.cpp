@@ -44,6 +44,13 @@ LogReplayer *VacuousTrxKit::create_log_replayer(Db &, LogHandler &) { return new
  */
 RC VacuousTrx::insert_record(Table *table, Record &record) { return table->insert_record(record); }
 
+/**
+ * @brief 在空事务中批量插入记录
+ *
+ * 与 insert_record 一样，直接委托给表对象的 insert_records 方法。
+ */
+RC VacuousTrx::insert_records(Table *table, vector<Record> &records) { return table->insert_records(records); }
+
 /**
  * @brief 删除记录
  * 
@@ -56,6 +63,12 @@ RC VacuousTrx::insert_record(Table *table, Record &record) { return table->inser
  */
 RC VacuousTrx::delete_record(Table *table, Record &record) { return table->delete_record(record); }
 
+/// 没有多版本，直接在原来的位置上修改
+RC VacuousTrx::update_record(Table *table, Record &old_record, Record &new_record)
+{
+  return table->update_record(old_record, new_record);
+}
+
 /**
  * @brief 对一个表中的记录进行空操作事务访问
  * 
@@ -69,6 +82,8 @@ RC VacuousTrx::delete_record(Table *table, Record &record) { return table->delet
  */
 RC VacuousTrx::visit_record(Table *table, Record &record, ReadWriteMode) { return RC::SUCCESS; }
 
+void VacuousTrx::filter_visible_records(const int32_t *, const int32_t *, int, uint8_t *) {}
+
 /**
  * @brief 有条件地启动事务
  * 
@@ -46,7 +46,10 @@ public:
 
   RC insert_record(Table *table, Record &record) override;
   RC delete_record(Table *table, Record &record) override;
+  RC update_record(Table *table, Record &old_record, Record &new_record) override;
   RC visit_record(Table *table, Record &record, ReadWriteMode mode) override;
+  void filter_visible_records(const int32_t *begin_xids, const int32_t *end_xids, int count, uint8_t *visible) override;
+  RC insert_records(Table *table, vector<Record> &records) override;
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
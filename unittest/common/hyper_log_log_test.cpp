@@ -0,0 +1,63 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+#include "common/lang/string.h"
+#include "common/math/hyper_log_log.h"
+
+using namespace common;
+
+TEST(HyperLogLog, estimate)
+{
+  HyperLogLog empty;
+  ASSERT_DOUBLE_EQ(0.0, empty.estimate());
+
+  for (int count : {10, 1000, 100000, 1000000}) {
+    HyperLogLog hll;
+    for (int round = 0; round < 3; round++) {
+      // 重复加入的值不影响估算结果
+      for (int i = 0; i < count; i++) {
+        hll.add(&i, sizeof(i));
+      }
+    }
+    const double error = std::abs(hll.estimate() - count) / count;
+    ASSERT_LT(error, 0.05) << "count=" << count << ", estimate=" << hll.estimate();
+  }
+
+  HyperLogLog strings;
+  for (int i = 0; i < 5000; i++) {
+    const string value = "name_" + std::to_string(i % 500);
+    strings.add(value.data(), value.size());
+  }
+  ASSERT_NEAR(500.0, strings.estimate(), 25.0);
+}
+
+TEST(HyperLogLog, merge)
+{
+  HyperLogLog left;
+  HyperLogLog right;
+  for (int i = 0; i < 20000; i++) {
+    left.add(&i, sizeof(i));
+  }
+  for (int i = 10000; i < 30000; i++) {
+    right.add(&i, sizeof(i));
+  }
+  left.merge(right);
+  ASSERT_NEAR(30000.0, left.estimate(), 30000 * 0.05);
+
+  left.clear();
+  ASSERT_DOUBLE_EQ(0.0, left.estimate());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -121,6 +121,31 @@ TEST(BplusTreeLogEntry, normal_operation_log_entry)
   ASSERT_EQ(0, memcmp(insert_items.data(), entry2->items(), insert_items.size()));
 }
 
+TEST(BplusTreeLogEntry, normal_operation_remove_log_entry)
+{
+  Frame frame;
+  frame.set_page_num(100);
+  LogOperation                   operation = LogOperation::Type::NODE_REMOVE;
+  vector<char>                   remove_items(100);
+  int                            remove_index = 10;
+  int                            item_num     = 5;
+  NormalOperationLogEntryHandler entry(&frame, operation, remove_index, remove_items, item_num);
+
+  // 删除的数据只在回滚时使用，不写入日志
+  Serializer serializer;
+  ASSERT_EQ(RC::SUCCESS, entry.serialize(serializer));
+
+  Deserializer                deserializer(serializer.data());
+  unique_ptr<LogEntryHandler> handler;
+  ASSERT_EQ(RC::SUCCESS, LogEntryHandler::from_buffer(deserializer, handler));
+
+  auto entry2 = dynamic_cast<NormalOperationLogEntryHandler *>(handler.get());
+  ASSERT_EQ(operation.type(), entry2->operation_type().type());
+  ASSERT_EQ(remove_index, entry2->index());
+  ASSERT_EQ(item_num, entry2->item_num());
+  ASSERT_EQ(0, entry2->item_bytes());
+}
+
 TEST(BplusTreeLogEntry, leaf_init_empty_log_entry)
 {
   Frame frame;
@@ -227,6 +252,37 @@ TEST(BplusTreeLogEntry, internal_update_key_log_entry)
   ASSERT_EQ(0, memcmp(key.data(), entry2->key(), key.size()));
 }
 
+TEST(BplusTreeLogEntry, page_image_log_entry)
+{
+  Frame frame;
+  frame.set_page_num(100);
+  vector<char> image(1000);
+  for (size_t i = 0; i < image.size(); i++) {
+    image[i] = static_cast<char>(i);
+  }
+  vector<char> tail(200);
+  for (size_t i = 0; i < tail.size(); i++) {
+    tail[i] = static_cast<char>(tail.size() - i);
+  }
+  PageImageLogEntryHandler entry(&frame, image, tail);
+
+  // test serializer and desirializer
+  Serializer serializer;
+  ASSERT_EQ(RC::SUCCESS, entry.serialize(serializer));
+
+  Deserializer                deserializer(serializer.data());
+  unique_ptr<LogEntryHandler> handler;
+  ASSERT_EQ(RC::SUCCESS, LogEntryHandler::from_buffer(deserializer, handler));
+
+  auto entry2 = dynamic_cast<PageImageLogEntryHandler *>(handler.get());
+  ASSERT_NE(nullptr, entry2);
+  ASSERT_EQ(LogOperation::Type::PAGE_IMAGE, entry2->operation_type().type());
+  ASSERT_EQ(image.size(), entry2->image_bytes());
+  ASSERT_EQ(0, memcmp(image.data(), entry2->image(), image.size()));
+  ASSERT_EQ(tail.size(), entry2->tail_bytes());
+  ASSERT_EQ(0, memcmp(tail.data(), entry2->tail(), tail.size()));
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
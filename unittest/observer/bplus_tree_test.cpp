@@ -19,9 +19,12 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "common/lang/memory.h"
 #include "common/lang/filesystem.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/random.h"
 #include "sql/parser/parse_defs.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/index/bplus_tree.h"
+#include "storage/index/bplus_tree_bulk_loader.h"
 #include "storage/clog/vacuous_log_handler.h"
 #include "storage/buffer/double_write_buffer.h"
 #include "gtest/gtest.h"
@@ -826,6 +829,277 @@ TEST(test_bplus_tree, test_bplus_tree_insert)
   handler = nullptr;
 }
 
+TEST(test_bplus_tree, test_bplus_tree_bulk_load)
+{
+  LoggerFactory::init_default("test.log");
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "test_bplus_tree_bulk_load.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler *handler = new BplusTreeHandler();
+  ASSERT_EQ(RC::SUCCESS, handler->create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), ORDER, ORDER));
+
+  // 内存限制设置得很小，保证会写临时文件并做多路归并
+  const int64_t        memory_limit = 64 * (sizeof(int) + sizeof(RID));
+  BplusTreeEntrySorter sorter(AttrType::INTS, sizeof(int), buffer_pool_file.string(), memory_limit);
+
+  // 乱序添加
+  vector<int> keys(insert_num);
+  for (int i = 0; i < insert_num; i++) {
+    keys[i] = i;
+  }
+  std::shuffle(keys.begin(), keys.end(), mt19937(insert_num));
+
+  RID rid;
+  for (int key : keys) {
+    rid.page_num = key / page_size;
+    rid.slot_num = key % page_size;
+    ASSERT_EQ(RC::SUCCESS, sorter.add((const char *)&key, rid));
+  }
+  ASSERT_EQ(RC::SUCCESS, sorter.sort());
+  ASSERT_EQ(insert_num, sorter.count());
+
+  BplusTreeBulkLoader loader(*handler, 0.75f);
+  ASSERT_EQ(RC::SUCCESS, loader.load(sorter));
+  handler->print_tree();
+  ASSERT_EQ(true, handler->validate_tree());
+
+  // 已经有数据的树不能再批量构建
+  BplusTreeBulkLoader loader2(*handler);
+  ASSERT_NE(RC::SUCCESS, loader2.load(sorter));
+
+  // 批量构建出来的树，需要能够正常地查询、删除和插入
+  test_get(handler);
+  test_delete(handler);
+
+  handler->close();
+  delete handler;
+  handler = nullptr;
+}
+
+static void make_prefix_key(int i, char *key, int attr_length)
+{
+  // 大部分键值有很长的公共前缀，少数几个前缀不同或者占满整个字段，让页面的公共前缀变短
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%010d", i);
+  string str;
+  if (i % 97 == 0) {
+    str = string(attr_length - strlen(buffer), static_cast<char>('a' + i % 26)) + buffer;
+  } else {
+    str = (i % 7 == 0 ? "vendor/" : "customer/registered/") + string(buffer);
+  }
+  memset(key, 0, attr_length + 1);
+  memcpy(key, str.data(), str.size());
+}
+
+TEST(test_bplus_tree, test_chars_prefix_compression)
+{
+  LoggerFactory::init_default("test.log");
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "test_chars_prefix_compression.btree";
+  filesystem::path bulk_load_file   = test_directory / "test_chars_prefix_compression_bulk.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(bulk_load_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  DiskBufferPool *bulk_buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bulk_load_file.c_str(), bulk_buffer_pool));
+
+  const int        attr_length = 64;
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::CHARS, attr_length));
+
+  // 字符串去掉末尾的0并做前缀压缩，一个叶子页面能放下的元素比定长时多很多
+  const int fixed_item_size = attr_length + 2 * static_cast<int>(sizeof(RID));
+  ASSERT_GT(handler.file_header().leaf_max_size, 2 * BP_PAGE_DATA_SIZE / fixed_item_size);
+
+  const int   key_num = 20000;
+  vector<int> keys(key_num);
+  for (int i = 0; i < key_num; i++) {
+    keys[i] = i;
+  }
+  std::shuffle(keys.begin(), keys.end(), mt19937(key_num));
+
+  char key[attr_length + 1];
+  RID  rid;
+  for (int i : keys) {
+    make_prefix_key(i, key, attr_length);
+    rid.page_num = i;
+    rid.slot_num = 0;
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(key, &rid));
+  }
+  ASSERT_EQ(true, handler.validate_tree());
+
+  auto check_entries = [&](BplusTreeHandler &tree, bool deleted_odd) {
+    for (int i = 0; i < key_num; i++) {
+      make_prefix_key(i, key, attr_length);
+      list<RID> rids;
+      ASSERT_EQ(RC::SUCCESS, tree.get_entry(key, static_cast<int>(strlen(key)), rids));
+      if (deleted_odd && i % 2 != 0) {
+        ASSERT_EQ(0, static_cast<int>(rids.size())) << "key=" << i;
+      } else {
+        ASSERT_EQ(1, static_cast<int>(rids.size())) << "key=" << i;
+        ASSERT_EQ(i, rids.front().page_num);
+      }
+    }
+
+    BplusTreeScanner scanner(tree);
+    ASSERT_EQ(RC::SUCCESS, scanner.open(nullptr, 0, true, nullptr, 0, true));
+    int count = 0;
+    while (RC::SUCCESS == scanner.next_entry(rid)) {
+      count++;
+    }
+    scanner.close();
+    ASSERT_EQ(deleted_odd ? key_num / 2 : key_num, count);
+  };
+  check_entries(handler, false);
+
+  // 删除一半的数据，页面会合并或者重新分配
+  for (int i : keys) {
+    if (i % 2 == 0) {
+      continue;
+    }
+    make_prefix_key(i, key, attr_length);
+    rid.page_num = i;
+    rid.slot_num = 0;
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(key, &rid));
+  }
+  ASSERT_EQ(true, handler.validate_tree());
+  check_entries(handler, true);
+
+  // 批量构建的结果与逐条插入的一样
+  BplusTreeHandler bulk_handler;
+  ASSERT_EQ(RC::SUCCESS, bulk_handler.create(log_handler, *bulk_buffer_pool, AttrType::CHARS, attr_length));
+  BplusTreeEntrySorter sorter(AttrType::CHARS, attr_length, bulk_load_file.string());
+  for (int i : keys) {
+    make_prefix_key(i, key, attr_length);
+    ASSERT_EQ(RC::SUCCESS, sorter.add(key, RID(i, 0)));
+  }
+  ASSERT_EQ(RC::SUCCESS, sorter.sort());
+  BplusTreeBulkLoader loader(bulk_handler);
+  ASSERT_EQ(RC::SUCCESS, loader.load(sorter));
+  ASSERT_EQ(true, bulk_handler.validate_tree());
+  check_entries(bulk_handler, false);
+
+  handler.close();
+  bulk_handler.close();
+}
+
+TEST(test_bplus_tree, test_bplus_tree_get_entries)
+{
+  LoggerFactory::init_default("test.log");
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "test_bplus_tree_get_entries.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), ORDER, ORDER));
+
+  // 空树查不到任何数据
+  vector<int>          keys = {1, 2, 3};
+  vector<const char *> key_ptrs;
+  for (int &key : keys) {
+    key_ptrs.push_back((const char *)&key);
+  }
+  vector<pair<int, RID>> entries;
+  ASSERT_EQ(RC::SUCCESS, handler.get_entries(key_ptrs, entries));
+  ASSERT_EQ(0, static_cast<int>(entries.size()));
+
+  // 只插入偶数，每个值重复多次，让相同的值跨越多个叶子节点
+  const int max_key   = 200;
+  const int dup_count = ORDER + 1;
+  RID       rid;
+  for (int i = 0; i < max_key; i += 2) {
+    for (int j = 0; j < dup_count; j++) {
+      rid.page_num = i;
+      rid.slot_num = j;
+      ASSERT_EQ(RC::SUCCESS, handler.insert_entry((const char *)&i, &rid));
+    }
+  }
+  ASSERT_EQ(true, handler.validate_tree());
+
+  // 乱序的查找键，包含不存在的值、重复的值、比最小值小和比最大值大的值
+  keys = {-10, 0, 7, 8, 8, 100, 198, 199, 1000, 2, 3, 150, 64, 65, 66};
+  key_ptrs.clear();
+  for (int &key : keys) {
+    key_ptrs.push_back((const char *)&key);
+  }
+  entries.clear();
+  ASSERT_EQ(RC::SUCCESS, handler.get_entries(key_ptrs, entries));
+
+  vector<vector<RID>> results(keys.size());
+  for (auto &[key_index, entry_rid] : entries) {
+    ASSERT_TRUE(key_index >= 0 && key_index < static_cast<int>(keys.size()));
+    results[key_index].push_back(entry_rid);
+  }
+
+  int expected_total = 0;
+  for (int i = 0; i < static_cast<int>(keys.size()); i++) {
+    const int key = keys[i];
+    if (key >= 0 && key < max_key && key % 2 == 0) {
+      ASSERT_EQ(dup_count, static_cast<int>(results[i].size())) << "key=" << key;
+      for (const RID &entry_rid : results[i]) {
+        ASSERT_EQ(key, entry_rid.page_num);
+      }
+      expected_total += dup_count;
+    } else {
+      ASSERT_EQ(0, static_cast<int>(results[i].size())) << "key=" << key;
+    }
+  }
+  ASSERT_EQ(expected_total, static_cast<int>(entries.size()));
+
+  // 结果按照键值从小到大排列
+  for (size_t i = 1; i < entries.size(); i++) {
+    ASSERT_LE(keys[entries[i - 1].first], keys[entries[i].first]);
+  }
+
+  // 与逐个查找的结果一致
+  for (int key = -1; key <= max_key; key++) {
+    list<RID> rids;
+    ASSERT_EQ(RC::SUCCESS, handler.get_entry((const char *)&key, sizeof(key), rids));
+
+    const char            *key_ptr = (const char *)&key;
+    vector<pair<int, RID>> key_entries;
+    ASSERT_EQ(RC::SUCCESS, handler.get_entries(span<const char *const>(&key_ptr, 1), key_entries));
+    ASSERT_EQ(rids.size(), key_entries.size()) << "key=" << key;
+  }
+
+  handler.close();
+}
+
 int main(int argc, char **argv)
 {
 
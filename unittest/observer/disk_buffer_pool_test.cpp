@@ -105,6 +105,68 @@ TEST(DiskBufferPool, allocate_dispose)
   ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
 }
 
+TEST(DiskBufferPool, free_space_map)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+  filesystem::path buffer_pool_filename = directory / "free_space_map.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  const int page_num = 100;
+  for (int i = 0; i < page_num; ++i) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    ASSERT_EQ(buffer_pool->unpin_page(frame), RC::SUCCESS);
+  }
+
+  ASSERT_FALSE(buffer_pool->has_free_space_map());
+  ASSERT_EQ(BP_INVALID_PAGE_NUM, buffer_pool->find_free_space_page());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->create_free_space_map());
+  ASSERT_TRUE(buffer_pool->has_free_space_map());
+  ASSERT_EQ(1, buffer_pool->free_space_map_page_count());
+
+  // 映射页面不是使用者的页面
+  ASSERT_EQ(page_num, buffer_pool_page_count(buffer_pool));
+  ASSERT_TRUE(buffer_pool->is_free_space_map_page(page_num + 1));
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->set_free_space_level(50, 3));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->set_free_space_level(20, FSM_MAX_LEVEL));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->set_free_space_level(21, 1));
+  ASSERT_EQ(RC::INVALID_ARGUMENT, buffer_pool->set_free_space_level(22, FSM_MAX_LEVEL + 1));
+  ASSERT_EQ(3, buffer_pool->free_space_level(50));
+  ASSERT_EQ(FSM_MAX_LEVEL, buffer_pool->free_space_level(20));
+  ASSERT_EQ(1, buffer_pool->free_space_level(21));
+  ASSERT_EQ(0, buffer_pool->free_space_level(22));
+
+  // 优先返回页号小的页面
+  ASSERT_EQ(20, buffer_pool->find_free_space_page());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->set_free_space_level(20, 0));
+  ASSERT_EQ(21, buffer_pool->find_free_space_page());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->set_free_space_level(21, 0));
+  ASSERT_EQ(50, buffer_pool->find_free_space_page());
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->set_free_space_level(10, 2));
+  ASSERT_EQ(10, buffer_pool->find_free_space_page());
+
+  // 重新打开文件后直接从映射页面中加载
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+  ASSERT_TRUE(buffer_pool->has_free_space_map());
+  ASSERT_EQ(page_num, buffer_pool_page_count(buffer_pool));
+  ASSERT_EQ(2, buffer_pool->free_space_level(10));
+  ASSERT_EQ(0, buffer_pool->free_space_level(20));
+  ASSERT_EQ(3, buffer_pool->free_space_level(50));
+  ASSERT_EQ(10, buffer_pool->find_free_space_page());
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.close_file(buffer_pool_filename.c_str()));
+}
+
 TEST(BufferPool, create)
 {
   filesystem::path test_directory("buffer_pool");
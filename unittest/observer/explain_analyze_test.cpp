@@ -0,0 +1,140 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/explain_physical_operator.h"
+#include "sql/operator/join_physical_operator.h"
+#include "sql/operator/predicate_physical_operator.h"
+#include "sql/operator/table_scan_physical_operator.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+class ExplainAnalyzeTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "vacuous", "vacuous"));
+
+    create_table("t", 1000);
+    create_table("small", 3);
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  void create_table(const char *name, int rows)
+  {
+    AttrInfoSqlNode attr_info;
+    attr_info.name   = "id";
+    attr_info.type   = AttrType::INTS;
+    attr_info.length = sizeof(int);
+    ASSERT_EQ(RC::SUCCESS, db_->create_table(name, span<const AttrInfoSqlNode>(&attr_info, 1)));
+
+    Table *table = db_->find_table(name);
+    for (int i = 0; i < rows; i++) {
+      Value  value(i);
+      Record record;
+      ASSERT_EQ(RC::SUCCESS, table->make_record(1, &value, record));
+      ASSERT_EQ(RC::SUCCESS, table->insert_record(record));
+    }
+  }
+
+  unique_ptr<PhysicalOperator> scan(const char *table_name)
+  {
+    return make_unique<TableScanPhysicalOperator>(db_->find_table(table_name), ReadWriteMode::READ_ONLY);
+  }
+
+  /// select * from t where id < 100
+  unique_ptr<PhysicalOperator> filter_plan()
+  {
+    Table *table = db_->find_table("t");
+    auto   expr  = make_unique<ComparisonExpr>(LESS_THAN,
+        make_unique<FieldExpr>(table, table->table_meta().field("id")),
+        make_unique<ValueExpr>(Value(100)));
+    auto predicate = make_unique<PredicatePhysicalOperator>(std::move(expr));
+    predicate->add_child(scan("t"));
+    return predicate;
+  }
+
+  string explain(unique_ptr<PhysicalOperator> plan, bool analyze)
+  {
+    ExplainPhysicalOperator explain_oper(analyze);
+    explain_oper.add_child(std::move(plan));
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    EXPECT_EQ(RC::SUCCESS, explain_oper.open(trx));
+    EXPECT_EQ(RC::SUCCESS, explain_oper.next());
+
+    Value value;
+    EXPECT_EQ(RC::SUCCESS, explain_oper.current_tuple()->cell_at(0, value));
+    EXPECT_EQ(RC::RECORD_EOF, explain_oper.next());
+    EXPECT_EQ(RC::SUCCESS, explain_oper.close());
+    db_->trx_kit().destroy_trx(trx);
+    return value.to_string();
+  }
+
+protected:
+  filesystem::path test_directory_{"explain_analyze_test"};
+  unique_ptr<Db>   db_;
+};
+
+TEST_F(ExplainAnalyzeTest, explain_only)
+{
+  // 普通的 EXPLAIN 不执行计划，也不输出执行信息
+  string plan = explain(filter_plan(), false /*analyze*/);
+  EXPECT_EQ("OPERATOR(NAME)\nPREDICATE\n└─TABLE_SCAN(t)\n", plan);
+}
+
+TEST_F(ExplainAnalyzeTest, filter)
+{
+  string plan = explain(filter_plan(), true /*analyze*/);
+  EXPECT_NE(string::npos, plan.find("PREDICATE [loops=1 rows=100 ")) << plan;
+  EXPECT_NE(string::npos, plan.find("TABLE_SCAN(t) [loops=1 rows=1000 ")) << plan;
+  EXPECT_NE(string::npos, plan.find("Execution Time: ")) << plan;
+
+  // 扫描访问了表的页面，上层的过滤算子包含了子算子的页面访问
+  const size_t scan_pos = plan.find("TABLE_SCAN(t)");
+  EXPECT_EQ(string::npos, plan.find(" hit=0 miss=0 ", scan_pos)) << plan;
+  EXPECT_EQ(string::npos, plan.find(" hit=0 miss=0 ")) << plan;
+}
+
+TEST_F(ExplainAnalyzeTest, nested_loop_join)
+{
+  // 右表对左表的每一行都打开一次
+  auto join = make_unique<NestedLoopJoinPhysicalOperator>();
+  join->add_child(scan("small"));
+  join->add_child(scan("t"));
+
+  string plan = explain(std::move(join), true /*analyze*/);
+  EXPECT_NE(string::npos, plan.find("NESTED_LOOP_JOIN [loops=1 rows=3000 ")) << plan;
+  EXPECT_NE(string::npos, plan.find("├─TABLE_SCAN(small) [loops=1 rows=3 ")) << plan;
+  EXPECT_NE(string::npos, plan.find("└─TABLE_SCAN(t) [loops=3 rows=3000 ")) << plan;
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,245 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/memory.h"
+#include "common/lang/random.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/integrated_log_replayer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/index/hash_index_handler.h"
+
+using namespace std;
+using namespace common;
+
+static void check_int_entries(HashIndexHandler &handler, int max_key, int dup_count, bool deleted_odd)
+{
+  for (int key = -1; key <= max_key; key++) {
+    vector<RID> rids;
+    ASSERT_EQ(RC::SUCCESS, handler.get_entry(reinterpret_cast<const char *>(&key), rids));
+
+    int expected = (key >= 0 && key < max_key) ? dup_count : 0;
+    if (deleted_odd && key % 2 != 0) {
+      expected = 0;
+    }
+    ASSERT_EQ(expected, static_cast<int>(rids.size())) << "key=" << key;
+    for (const RID &rid : rids) {
+      ASSERT_EQ(key, rid.page_num);
+    }
+  }
+}
+
+TEST(test_hash_index, insert_get_delete)
+{
+  filesystem::path test_directory("hash_index");
+  filesystem::path index_file = test_directory / "insert_get_delete.hash";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  auto handler = make_unique<HashIndexHandler>();
+  ASSERT_EQ(RC::SUCCESS, handler->create(log_handler, bpm, index_file.c_str(), AttrType::INTS, sizeof(int)));
+
+  // 乱序插入，每个键值有多个条目，桶会分裂很多次
+  const int   max_key   = 20000;
+  const int   dup_count = 3;
+  vector<int> keys(max_key);
+  for (int i = 0; i < max_key; i++) {
+    keys[i] = i;
+  }
+  mt19937 random(1);
+  shuffle(keys.begin(), keys.end(), random);
+
+  for (int j = 0; j < dup_count; j++) {
+    for (int key : keys) {
+      RID rid(key, j);
+      ASSERT_EQ(RC::SUCCESS, handler->insert_entry(reinterpret_cast<const char *>(&key), &rid));
+    }
+  }
+  ASSERT_EQ(max_key * dup_count, handler->entry_count());
+  ASSERT_GT(handler->file_header().bucket_count, HashIndexHandler::INITIAL_BUCKET_COUNT);
+
+  // 键值和RID都相同时插入失败
+  int key = 100;
+  RID rid(key, 0);
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, handler->insert_entry(reinterpret_cast<const char *>(&key), &rid));
+
+  check_int_entries(*handler, max_key, dup_count, false);
+
+  // 删除所有的奇数
+  for (int key : keys) {
+    if (key % 2 == 0) {
+      continue;
+    }
+    for (int j = 0; j < dup_count; j++) {
+      RID rid(key, j);
+      ASSERT_EQ(RC::SUCCESS, handler->delete_entry(reinterpret_cast<const char *>(&key), &rid));
+    }
+  }
+  rid = RID(1, 0);
+  key = 1;
+  ASSERT_EQ(RC::RECORD_INVALID_KEY, handler->delete_entry(reinterpret_cast<const char *>(&key), &rid));
+  check_int_entries(*handler, max_key, dup_count, true);
+
+  // 批量查找
+  vector<int>          probe_keys = {4, 5, -3, 4, 19998};
+  vector<const char *> probe_key_ptrs;
+  for (int &probe_key : probe_keys) {
+    probe_key_ptrs.push_back(reinterpret_cast<const char *>(&probe_key));
+  }
+  vector<pair<int, RID>> entries;
+  ASSERT_EQ(RC::SUCCESS, handler->get_entries(probe_key_ptrs, entries));
+  ASSERT_EQ(3 * dup_count, static_cast<int>(entries.size()));
+  for (auto &[key_index, entry_rid] : entries) {
+    ASSERT_EQ(probe_keys[key_index], entry_rid.page_num);
+  }
+
+  // 关闭后重新打开，数据不变
+  const int bucket_count = handler->file_header().bucket_count;
+  ASSERT_EQ(RC::SUCCESS, handler->sync());
+  handler = make_unique<HashIndexHandler>();
+  ASSERT_EQ(RC::SUCCESS, handler->open(log_handler, bpm, index_file.c_str()));
+  check_int_entries(*handler, max_key, dup_count, true);
+  ASSERT_EQ(bucket_count, handler->file_header().bucket_count);
+  ASSERT_EQ(max_key / 2 * dup_count, handler->entry_count());
+  handler.reset();
+}
+
+TEST(test_hash_index, chars)
+{
+  filesystem::path test_directory("hash_index");
+  filesystem::path index_file = test_directory / "chars.hash";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  const int        attr_length = 16;
+  HashIndexHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, bpm, index_file.c_str(), AttrType::CHARS, attr_length));
+
+  // 字段中的字符串用0补齐，长度正好是字段长度的字符串没有结束符
+  const int key_num = 5000;
+  for (int i = 0; i < key_num; i++) {
+    char   key[attr_length] = {0};
+    string str              = i == 0 ? string(attr_length, 'x') : "key" + to_string(i);
+    memcpy(key, str.data(), str.size());
+    RID rid(i, 0);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(key, &rid));
+  }
+
+  for (int i = 0; i < key_num; i++) {
+    char   key[attr_length] = {0};
+    string str              = i == 0 ? string(attr_length, 'x') : "key" + to_string(i);
+    memcpy(key, str.data(), str.size());
+
+    vector<RID> rids;
+    ASSERT_EQ(RC::SUCCESS, handler.get_entry(key, rids));
+    ASSERT_EQ(1, static_cast<int>(rids.size())) << "key=" << str;
+    ASSERT_EQ(i, rids[0].page_num);
+  }
+
+  char        key[attr_length] = "key";
+  vector<RID> rids;
+  ASSERT_EQ(RC::SUCCESS, handler.get_entry(key, rids));
+  ASSERT_EQ(0, static_cast<int>(rids.size()));
+  handler.close();
+}
+
+TEST(test_hash_index, redo)
+{
+  filesystem::path test_directory("hash_index_log_test_dir");
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  const filesystem::path index_file      = test_directory / "hash_index.bp";
+  const filesystem::path index_file_copy = test_directory / "hash_index2.bp";
+  const filesystem::path log_directory   = test_directory / "clog";
+
+  const int max_key   = 10000;
+  const int dup_count = 2;
+  {
+    auto bpm = make_unique<BufferPoolManager>();
+    ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+    auto log_handler = make_unique<DiskLogHandler>();
+    ASSERT_EQ(RC::SUCCESS, bpm->create_file(index_file.c_str()));
+    DiskBufferPool *buffer_pool = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm->open_file(*log_handler, index_file.c_str(), buffer_pool));
+    ASSERT_EQ(RC::SUCCESS, log_handler->init(log_directory.c_str()));
+
+    IntegratedLogReplayer log_replayer(*bpm);
+    ASSERT_EQ(RC::SUCCESS, log_handler->replay(log_replayer, 0));
+    ASSERT_EQ(RC::SUCCESS, log_handler->start());
+
+    auto handler = make_unique<HashIndexHandler>();
+    ASSERT_EQ(RC::SUCCESS, handler->create(*log_handler, *buffer_pool, AttrType::INTS, sizeof(int)));
+
+    // 创建完索引就复制文件，之后所有的修改都要靠日志恢复
+    ASSERT_TRUE(filesystem::copy_file(index_file, index_file_copy));
+
+    for (int j = 0; j < dup_count; j++) {
+      for (int key = 0; key < max_key; key++) {
+        RID rid(key, j);
+        ASSERT_EQ(RC::SUCCESS, handler->insert_entry(reinterpret_cast<const char *>(&key), &rid));
+      }
+    }
+    for (int key = 1; key < max_key; key += 2) {
+      for (int j = 0; j < dup_count; j++) {
+        RID rid(key, j);
+        ASSERT_EQ(RC::SUCCESS, handler->delete_entry(reinterpret_cast<const char *>(&key), &rid));
+      }
+    }
+
+    ASSERT_EQ(RC::SUCCESS, log_handler->stop());
+    ASSERT_EQ(RC::SUCCESS, log_handler->await_termination());
+    handler.reset();
+    bpm.reset();
+    log_handler.reset();
+  }
+
+  auto bpm = make_unique<BufferPoolManager>();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  auto            log_handler = make_unique<DiskLogHandler>();
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(*log_handler, index_file_copy.c_str(), buffer_pool));
+  ASSERT_EQ(RC::SUCCESS, log_handler->init(log_directory.c_str()));
+
+  // 与打开表一样，先打开索引再回放日志，索引要在回放之后读取最新的目录
+  auto handler = make_unique<HashIndexHandler>();
+  ASSERT_EQ(RC::SUCCESS, handler->open(*log_handler, *buffer_pool));
+
+  IntegratedLogReplayer log_replayer(*bpm);
+  ASSERT_EQ(RC::SUCCESS, log_handler->replay(log_replayer, 0));
+
+  check_int_entries(*handler, max_key, dup_count, true);
+  ASSERT_GT(handler->file_header().bucket_count, HashIndexHandler::INITIAL_BUCKET_COUNT);
+
+  handler.reset();
+  bpm.reset();
+  log_handler.reset();
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  LoggerFactory::init_default("hash_index_test.log", LOG_LEVEL_INFO);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,286 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/join_logical_operator.h"
+#include "sql/operator/predicate_logical_operator.h"
+#include "sql/operator/table_get_logical_operator.h"
+#include "sql/optimizer/join_reorder_rule.h"
+#include "sql/optimizer/physical_plan_generator.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 类似 TPC-H 的三张表
+ * @details nation(n_id) 25行，customer(c_id, c_nation) 1000行，orders(o_id, o_cust) 5000行
+ */
+class JoinReorderTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "vacuous", "vacuous"));
+
+    create_table("nation", {"n_id"}, 25, [](int i, int) { return i; });
+    create_table("customer", {"c_id", "c_nation"}, 1000, [](int i, int field) { return field == 0 ? i : i % 25; });
+    create_table("orders", {"o_id", "o_cust"}, 5000, [](int i, int field) { return field == 0 ? i : i % 1000; });
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  Table *create_table(const string &name, const vector<string> &fields, int rows, function<int(int, int)> value_of)
+  {
+    vector<AttrInfoSqlNode> attr_infos;
+    for (const string &field : fields) {
+      AttrInfoSqlNode attr_info;
+      attr_info.name   = field;
+      attr_info.type   = AttrType::INTS;
+      attr_info.length = sizeof(int);
+      attr_infos.push_back(attr_info);
+    }
+    EXPECT_EQ(RC::SUCCESS, db_->create_table(name.c_str(), attr_infos));
+    Table *table = db_->find_table(name.c_str());
+    EXPECT_NE(nullptr, table);
+
+    vector<Value> values(fields.size());
+    for (int i = 0; i < rows; i++) {
+      for (size_t field = 0; field < fields.size(); field++) {
+        values[field] = Value(value_of(i, static_cast<int>(field)));
+      }
+      Record record;
+      EXPECT_EQ(RC::SUCCESS, table->make_record(static_cast<int>(values.size()), values.data(), record));
+      EXPECT_EQ(RC::SUCCESS, table->insert_record(record));
+    }
+    return table;
+  }
+
+  unique_ptr<Expression> field(const char *table_name, const char *field_name)
+  {
+    Table *table = db_->find_table(table_name);
+    return make_unique<FieldExpr>(table, table->table_meta().field(field_name));
+  }
+
+  unique_ptr<Expression> compare(CompOp op, unique_ptr<Expression> left, unique_ptr<Expression> right)
+  {
+    return make_unique<ComparisonExpr>(op, std::move(left), std::move(right));
+  }
+
+  /// 按照 from 中的顺序生成左深的连接树，条件都放在最上面，与 LogicalPlanGenerator 生成的计划相同
+  unique_ptr<LogicalOperator> make_plan(const vector<string> &from, vector<unique_ptr<Expression>> conditions)
+  {
+    unique_ptr<LogicalOperator> plan;
+    for (const string &table_name : from) {
+      Table *table     = db_->find_table(table_name.c_str());
+      auto   table_get = make_unique<TableGetLogicalOperator>(table, ReadWriteMode::READ_ONLY);
+      if (plan == nullptr) {
+        plan = std::move(table_get);
+      } else {
+        auto join = make_unique<JoinLogicalOperator>();
+        join->add_child(std::move(plan));
+        join->add_child(std::move(table_get));
+        plan = std::move(join);
+      }
+    }
+
+    auto predicate = make_unique<PredicateLogicalOperator>(
+        make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, conditions));
+    predicate->add_child(std::move(plan));
+    return predicate;
+  }
+
+  /// select * from orders, customer, nation where o_cust = c_id and c_nation = n_id and n_id < 5
+  unique_ptr<LogicalOperator> make_tpch_plan(const vector<string> &from)
+  {
+    vector<unique_ptr<Expression>> conditions;
+    conditions.emplace_back(compare(EQUAL_TO, field("orders", "o_cust"), field("customer", "c_id")));
+    conditions.emplace_back(compare(EQUAL_TO, field("customer", "c_nation"), field("nation", "n_id")));
+    conditions.emplace_back(compare(LESS_THAN, field("nation", "n_id"), make_unique<ValueExpr>(Value(5))));
+    return make_plan(from, std::move(conditions));
+  }
+
+  int execute(LogicalOperator &logical_oper, PhysicalOperatorType *root_type = nullptr)
+  {
+    unique_ptr<PhysicalOperator> physical_oper;
+    EXPECT_EQ(RC::SUCCESS, physical_plan_generator_.create(logical_oper, physical_oper));
+    if (root_type != nullptr) {
+      *root_type = physical_oper->type();
+    }
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    EXPECT_EQ(RC::SUCCESS, physical_oper->open(trx));
+    int rows = 0;
+    RC  rc   = RC::SUCCESS;
+    while (OB_SUCC(rc = physical_oper->next())) {
+      rows++;
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, physical_oper->close());
+    db_->trx_kit().destroy_trx(trx);
+    return rows;
+  }
+
+  /// 检查每个连接算子都有连接条件，也就是没有笛卡尔积
+  static void expect_no_cross_product(LogicalOperator &oper)
+  {
+    if (oper.type() == LogicalOperatorType::JOIN) {
+      EXPECT_FALSE(oper.expressions().empty());
+    }
+    for (unique_ptr<LogicalOperator> &child : oper.children()) {
+      expect_no_cross_product(*child);
+    }
+  }
+
+  static LogicalOperator *find_table_get(LogicalOperator &oper, const char *table_name)
+  {
+    if (oper.type() == LogicalOperatorType::TABLE_GET &&
+        0 == strcmp(static_cast<TableGetLogicalOperator &>(oper).table()->name(), table_name)) {
+      return &oper;
+    }
+    for (unique_ptr<LogicalOperator> &child : oper.children()) {
+      LogicalOperator *result = find_table_get(*child, table_name);
+      if (result != nullptr) {
+        return result;
+      }
+    }
+    return nullptr;
+  }
+
+  void analyze_all()
+  {
+    for (const char *table_name : {"nation", "customer", "orders"}) {
+      ASSERT_EQ(RC::SUCCESS, db_->find_table(table_name)->analyze(nullptr));
+    }
+  }
+
+protected:
+  filesystem::path      test_directory_{"join_reorder_test"};
+  unique_ptr<Db>        db_;
+  PhysicalPlanGenerator physical_plan_generator_;
+  JoinReorderRule       rule_;
+};
+
+TEST_F(JoinReorderTest, reorder)
+{
+  analyze_all();
+
+  // from 中任意的顺序都生成没有笛卡尔积的计划，结果相同
+  vector<string> from = {"customer", "nation", "orders"};
+  do {
+    unique_ptr<LogicalOperator> plan        = make_tpch_plan(from);
+    bool                        change_made = false;
+    ASSERT_EQ(RC::SUCCESS, rule_.rewrite(plan, change_made));
+    ASSERT_TRUE(change_made);
+
+    // 所有的条件都下推了，不再需要上面的过滤算子
+    ASSERT_EQ(LogicalOperatorType::JOIN, plan->type());
+    expect_no_cross_product(*plan);
+    auto *nation = static_cast<TableGetLogicalOperator *>(find_table_get(*plan, "nation"));
+    ASSERT_EQ(1, static_cast<int>(nation->predicates().size()));
+
+    // 最大的表作为哈希连接的探测侧
+    LogicalOperator *build_side = plan->children()[1].get();
+    ASSERT_EQ(nullptr, find_table_get(*build_side, "orders"));
+
+    PhysicalOperatorType root_type;
+    ASSERT_EQ(1000, execute(*plan, &root_type));
+    ASSERT_EQ(PhysicalOperatorType::HASH_JOIN, root_type);
+  } while (next_permutation(from.begin(), from.end()));
+}
+
+TEST_F(JoinReorderTest, no_statistics)
+{
+  // 没有统计信息时保持 from 中的顺序，但是条件仍然会下推
+  unique_ptr<LogicalOperator> plan        = make_tpch_plan({"orders", "nation", "customer"});
+  bool                        change_made = false;
+  ASSERT_EQ(RC::SUCCESS, rule_.rewrite(plan, change_made));
+  ASSERT_EQ(LogicalOperatorType::JOIN, plan->type());
+
+  LogicalOperator *left_deep = plan->children()[0].get();
+  ASSERT_EQ(LogicalOperatorType::JOIN, left_deep->type());
+  ASSERT_EQ(0, strcmp("orders", static_cast<TableGetLogicalOperator &>(*left_deep->children()[0]).table()->name()));
+  ASSERT_TRUE(left_deep->expressions().empty());  // orders 和 nation 之间没有连接条件
+  ASSERT_EQ(2, static_cast<int>(plan->expressions().size()));
+
+  ASSERT_EQ(1000, execute(*plan));
+}
+
+TEST_F(JoinReorderTest, residual_condition)
+{
+  analyze_all();
+
+  // 与表无关的条件和 OR 条件
+  vector<unique_ptr<Expression>> conditions;
+  conditions.emplace_back(compare(EQUAL_TO, field("customer", "c_nation"), field("nation", "n_id")));
+  conditions.emplace_back(compare(EQUAL_TO, make_unique<ValueExpr>(Value(1)), make_unique<ValueExpr>(Value(1))));
+  vector<unique_ptr<Expression>> or_children;
+  or_children.emplace_back(compare(LESS_THAN, field("customer", "c_id"), make_unique<ValueExpr>(Value(10))));
+  or_children.emplace_back(compare(EQUAL_TO, field("nation", "n_id"), make_unique<ValueExpr>(Value(3))));
+  conditions.emplace_back(make_unique<ConjunctionExpr>(ConjunctionExpr::Type::OR, or_children));
+
+  unique_ptr<LogicalOperator> plan        = make_plan({"nation", "customer"}, std::move(conditions));
+  bool                        change_made = false;
+  ASSERT_EQ(RC::SUCCESS, rule_.rewrite(plan, change_made));
+  ASSERT_EQ(LogicalOperatorType::PREDICATE, plan->type());
+  ASSERT_EQ(LogicalOperatorType::JOIN, plan->children()[0]->type());
+  ASSERT_EQ(2, static_cast<int>(plan->children()[0]->expressions().size()));
+
+  // c_id < 10 的10行，加上 n_id = 3 的40行，其中有一行重复
+  ASSERT_EQ(49, execute(*plan));
+}
+
+TEST_F(JoinReorderTest, greedy)
+{
+  // 超过动态规划限制的链式连接 t0.id = t1.id and t1.id = t2.id ...
+  const int table_num = JoinReorderRule::DP_INPUT_LIMIT + 2;
+  vector<string> from;
+  vector<unique_ptr<Expression>> conditions;
+  for (int i = 0; i < table_num; i++) {
+    const string name = "t" + to_string(i);
+    Table *table = create_table(name, {"id"}, 10 * (i + 1), [](int row, int) { return row; });
+    ASSERT_EQ(RC::SUCCESS, table->analyze(nullptr));
+    from.push_back(name);
+    if (i > 0) {
+      const string prev = "t" + to_string(i - 1);
+      conditions.emplace_back(compare(EQUAL_TO, field(prev.c_str(), "id"), field(name.c_str(), "id")));
+    }
+  }
+  std::reverse(from.begin(), from.end());
+
+  unique_ptr<LogicalOperator> plan        = make_plan(from, std::move(conditions));
+  bool                        change_made = false;
+  ASSERT_EQ(RC::SUCCESS, rule_.rewrite(plan, change_made));
+  ASSERT_EQ(LogicalOperatorType::JOIN, plan->type());
+  expect_no_cross_product(*plan);
+  ASSERT_EQ(10, execute(*plan));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
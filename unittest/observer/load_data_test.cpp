@@ -0,0 +1,194 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+#include "gtest/gtest.h"
+#include "sql/executor/data_loader.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+class LoadDataTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    open_db();
+
+    AttrInfoSqlNode attr_infos[2];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "name";
+    attr_infos[1].type   = AttrType::CHARS;
+    attr_infos[1].length = 16;
+    ASSERT_EQ(RC::SUCCESS, db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 2)));
+    table_ = db_->find_table("t");
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  void open_db()
+  {
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "vacuous", "disk"));
+    table_ = db_->find_table("t");
+  }
+
+  /// 生成 rows 行数据，id 从 0 开始。每隔 blank_every 行插入一个空行
+  string write_file(int rows, int blank_every = 0)
+  {
+    string   file_name = (test_directory_ / "data.txt").string();
+    ofstream ofs(file_name, ios::binary | ios::trunc);
+    for (int i = 0; i < rows; i++) {
+      if (blank_every > 0 && i % blank_every == 0) {
+        ofs << "  \n";
+      }
+      ofs << i << " | name" << i << "\n";
+    }
+    return file_name;
+  }
+
+  /// 读取表中所有的 id，检查没有重复
+  set<int> scan_ids()
+  {
+    set<int>          ids;
+    RecordFileScanner scanner;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY));
+    Record record;
+    RC     rc = RC::SUCCESS;
+    while (OB_SUCC(rc = scanner.next(record))) {
+      int id = *reinterpret_cast<const int *>(record.data() + table_->table_meta().field("id")->offset());
+      EXPECT_TRUE(ids.insert(id).second) << "duplicate id " << id;
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    scanner.close_scan();
+    return ids;
+  }
+
+  DataLoader::Options options(int threads, bool logging)
+  {
+    DataLoader::Options options;
+    options.threads = threads;
+    options.logging = logging;
+    // 块比较小，一个文件会分成很多块
+    options.block_size = 4096;
+    return options;
+  }
+
+protected:
+  filesystem::path test_directory_{"load_data_test"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+};
+
+TEST_F(LoadDataTest, same_result_with_threads)
+{
+  const int rows = 10000;
+  for (int threads : {1, 4}) {
+    SCOPED_TRACE(threads);
+    TearDown();
+    SetUp();
+
+    string     file_name = write_file(rows);
+    DataLoader loader(table_, options(threads, true /*logging*/));
+    ASSERT_EQ(RC::SUCCESS, loader.load(file_name.c_str()));
+    EXPECT_EQ(rows, loader.line_count());
+    EXPECT_EQ(rows, loader.record_count());
+    EXPECT_EQ(static_cast<int64_t>(filesystem::file_size(file_name)), loader.byte_count());
+
+    set<int> ids = scan_ids();
+    ASSERT_EQ(rows, static_cast<int>(ids.size()));
+    EXPECT_EQ(0, *ids.begin());
+    EXPECT_EQ(rows - 1, *ids.rbegin());
+  }
+}
+
+TEST_F(LoadDataTest, blank_lines_and_last_line)
+{
+  const int rows      = 1000;
+  string    file_name = write_file(rows, 10 /*blank_every*/);
+  {
+    // 最后一行没有换行符
+    ofstream ofs(file_name, ios::binary | ios::app);
+    ofs << rows << "|last";
+  }
+
+  DataLoader loader(table_, options(2, true /*logging*/));
+  ASSERT_EQ(RC::SUCCESS, loader.load(file_name.c_str()));
+  EXPECT_EQ(rows + rows / 10 + 1, loader.line_count());
+  EXPECT_EQ(rows + 1, loader.record_count());
+  EXPECT_EQ(rows + 1, static_cast<int>(scan_ids().size()));
+}
+
+TEST_F(LoadDataTest, report_error_line)
+{
+  for (int threads : {1, 4}) {
+    SCOPED_TRACE(threads);
+    TearDown();
+    SetUp();
+
+    string file_name = write_file(5000);
+    {
+      ofstream ofs(file_name, ios::binary | ios::app);
+      ofs << "5000\n";  // 缺少字段
+      ofs << "5001|name\n";
+    }
+
+    DataLoader loader(table_, options(threads, true /*logging*/));
+    EXPECT_EQ(RC::SCHEMA_FIELD_MISSING, loader.load(file_name.c_str()));
+    EXPECT_EQ(0, loader.error_message().find("Line:5001 insert record failed")) << loader.error_message();
+    EXPECT_EQ(5001, loader.line_count());
+    EXPECT_EQ(5000, loader.record_count());
+  }
+}
+
+TEST_F(LoadDataTest, file_not_exist)
+{
+  DataLoader loader(table_, options(1, true /*logging*/));
+  EXPECT_EQ(RC::FILE_NOT_EXIST, loader.load((test_directory_ / "no_such_file").c_str()));
+  EXPECT_FALSE(loader.error_message().empty());
+}
+
+TEST_F(LoadDataTest, without_logging)
+{
+  const int rows      = 10000;
+  string    file_name = write_file(rows);
+
+  DataLoader loader(table_, options(4, false /*logging*/));
+  ASSERT_EQ(RC::SUCCESS, loader.load(file_name.c_str()));
+  EXPECT_EQ(rows, loader.record_count());
+
+  // 不记录日志时导入结束会把数据刷到磁盘，重新打开数据库后数据还在
+  db_.reset();
+  open_db();
+  ASSERT_NE(nullptr, table_);
+  EXPECT_EQ(rows, static_cast<int>(scan_ids().size()));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,244 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <future>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "storage/db/db.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/lock_manager.h"
+#include "storage/trx/mvcc_trx.h"
+
+using namespace std;
+
+namespace {
+
+RowLockKey make_key(int32_t table_id, PageNum page_num, SlotNum slot_num)
+{
+  return RowLockKey{table_id, RID(page_num, slot_num)};
+}
+
+/// 等待有 count 个事务在锁上排队
+void wait_for_waiters(const LockManager &lock_manager, int64_t count)
+{
+  for (int i = 0; i < 5000 && lock_manager.wait_count() < count; i++) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  ASSERT_EQ(count, lock_manager.wait_count());
+}
+
+}  // namespace
+
+TEST(LockManager, lock_and_unlock)
+{
+  LockManager lock_manager;
+  RowLockKey  key1 = make_key(1, 1, 0);
+  RowLockKey  key2 = make_key(1, 1, 1);
+
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(1, key1));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(1, key1));  // 可以重入
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(2, key2));
+  ASSERT_EQ(2, lock_manager.locked_row_count());
+
+  // 不是自己持有的锁不会被释放
+  lock_manager.unlock_rows(1, RowLockSet{key1, key2});
+  ASSERT_EQ(1, lock_manager.locked_row_count());
+  lock_manager.unlock_rows(2, RowLockSet{key2});
+  ASSERT_EQ(0, lock_manager.locked_row_count());
+  ASSERT_EQ(0, lock_manager.wait_count());
+}
+
+TEST(LockManager, wait_in_fifo_order)
+{
+  LockManager lock_manager;
+  RowLockKey  key = make_key(1, 1, 0);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(1, key));
+
+  future<RC> waiter2 = async(launch::async, [&]() { return lock_manager.lock_row(2, key); });
+  wait_for_waiters(lock_manager, 1);
+  future<RC> waiter3 = async(launch::async, [&]() { return lock_manager.lock_row(3, key); });
+  wait_for_waiters(lock_manager, 2);
+
+  ASSERT_EQ(future_status::timeout, waiter2.wait_for(chrono::milliseconds(20)));
+
+  // 释放以后按照排队的顺序交给下一个事务
+  lock_manager.unlock_rows(1, RowLockSet{key});
+  ASSERT_EQ(RC::SUCCESS, waiter2.get());
+  ASSERT_EQ(future_status::timeout, waiter3.wait_for(chrono::milliseconds(20)));
+
+  lock_manager.unlock_rows(2, RowLockSet{key});
+  ASSERT_EQ(RC::SUCCESS, waiter3.get());
+  lock_manager.unlock_rows(3, RowLockSet{key});
+  ASSERT_EQ(0, lock_manager.locked_row_count());
+}
+
+TEST(LockManager, detect_deadlock)
+{
+  LockManager lock_manager;
+  RowLockKey  key1 = make_key(1, 1, 0);
+  RowLockKey  key2 = make_key(1, 1, 1);
+  RowLockKey  key3 = make_key(1, 1, 2);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(1, key1));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(2, key2));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(3, key3));
+
+  // 1 等待 2，2 等待 3，3 再等待 1 就形成了环
+  future<RC> waiter1 = async(launch::async, [&]() { return lock_manager.lock_row(1, key2); });
+  wait_for_waiters(lock_manager, 1);
+  future<RC> waiter2 = async(launch::async, [&]() { return lock_manager.lock_row(2, key3); });
+  wait_for_waiters(lock_manager, 2);
+
+  ASSERT_EQ(RC::LOCKED_DEADLOCK, lock_manager.lock_row(3, key1));
+  ASSERT_EQ(1, lock_manager.deadlock_count());
+
+  // 被选中的事务回滚以后，其它事务可以继续
+  lock_manager.unlock_rows(3, RowLockSet{key3});
+  ASSERT_EQ(RC::SUCCESS, waiter2.get());
+  lock_manager.unlock_rows(2, RowLockSet{key2, key3});
+  ASSERT_EQ(RC::SUCCESS, waiter1.get());
+  lock_manager.unlock_rows(1, RowLockSet{key1, key2});
+  ASSERT_EQ(0, lock_manager.locked_row_count());
+}
+
+TEST(LockManager, deadlock_with_waiter_ahead)
+{
+  LockManager lock_manager;
+  RowLockKey  key1 = make_key(1, 1, 0);
+  RowLockKey  key2 = make_key(1, 1, 1);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(1, key1));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(2, key2));
+
+  // 3 排在 key1 上，会比后来的 2 先拿到 key1。3 再等待 2 持有的 key2 就是死锁
+  future<RC> waiter3 = async(launch::async, [&]() { return lock_manager.lock_row(3, key1); });
+  wait_for_waiters(lock_manager, 1);
+  future<RC> waiter2 = async(launch::async, [&]() { return lock_manager.lock_row(2, key1); });
+  wait_for_waiters(lock_manager, 2);
+
+  lock_manager.unlock_rows(1, RowLockSet{key1});
+  ASSERT_EQ(RC::SUCCESS, waiter3.get());
+  ASSERT_EQ(RC::LOCKED_DEADLOCK, lock_manager.lock_row(3, key2));
+
+  lock_manager.unlock_rows(3, RowLockSet{key1});
+  ASSERT_EQ(RC::SUCCESS, waiter2.get());
+  lock_manager.unlock_rows(2, RowLockSet{key1, key2});
+  ASSERT_EQ(0, lock_manager.locked_row_count());
+}
+
+TEST(LockManager, wait_timeout)
+{
+  LockManager lock_manager;
+  lock_manager.set_wait_timeout(chrono::milliseconds(10));
+  RowLockKey key = make_key(1, 1, 0);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock_row(1, key));
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, lock_manager.lock_row(2, key));
+  ASSERT_EQ(1, lock_manager.timeout_count());
+
+  // 超时的事务已经离开队列，释放后锁是空闲的
+  lock_manager.unlock_rows(1, RowLockSet{key});
+  ASSERT_EQ(0, lock_manager.locked_row_count());
+}
+
+class MvccLockTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "mvcc", "vacuous"));
+
+    AttrInfoSqlNode attr_info;
+    attr_info.name   = "id";
+    attr_info.type   = AttrType::INTS;
+    attr_info.length = sizeof(int);
+    ASSERT_EQ(RC::SUCCESS, db_->create_table("t", span<const AttrInfoSqlNode>(&attr_info, 1)));
+    table_ = db_->find_table("t");
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    Value value(1);
+    ASSERT_EQ(RC::SUCCESS, table_->make_record(1, &value, record_));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table_, record_));
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    db_->trx_kit().destroy_trx(trx);
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  /// 两个事务删除同一行，第一个事务删除以后用 finish 结束，返回第二个事务删除的结果
+  RC delete_after(function<RC(Trx *)> finish)
+  {
+    Trx *trx1 = db_->trx_kit().create_trx(db_->log_handler());
+    Trx *trx2 = db_->trx_kit().create_trx(db_->log_handler());
+    trx1->start_if_need();
+    trx2->start_if_need();
+
+    EXPECT_EQ(RC::SUCCESS, trx1->delete_record(table_, record_));
+
+    // 第二个事务扫描时仍然能看到这条记录，删除时在行锁上等待
+    RecordFileScanner scanner;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, trx2, ReadWriteMode::READ_WRITE));
+    Record record;
+    EXPECT_EQ(RC::SUCCESS, scanner.next(record));
+    record.copy_data(record.data(), record.len());
+    scanner.close_scan();
+
+    LockManager &lock_manager = static_cast<MvccTrxKit &>(db_->trx_kit()).lock_manager();
+    future<RC>   deleter      = async(launch::async, [&]() { return trx2->delete_record(table_, record); });
+    wait_for_waiters(lock_manager, 1);
+    EXPECT_EQ(future_status::timeout, deleter.wait_for(chrono::milliseconds(20)));
+
+    EXPECT_EQ(RC::SUCCESS, finish(trx1));
+    RC rc = deleter.get();
+    if (OB_SUCC(rc)) {
+      EXPECT_EQ(RC::SUCCESS, trx2->commit());
+    } else {
+      EXPECT_EQ(RC::SUCCESS, trx2->rollback());
+    }
+    EXPECT_EQ(0, lock_manager.locked_row_count());
+
+    db_->trx_kit().destroy_trx(trx1);
+    db_->trx_kit().destroy_trx(trx2);
+    return rc;
+  }
+
+protected:
+  filesystem::path test_directory_{"lock_manager_test"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+  Record           record_;
+};
+
+TEST_F(MvccLockTest, wait_for_rollback)
+{
+  // 第一个事务回滚了，第二个事务拿到锁以后可以删除
+  ASSERT_EQ(RC::SUCCESS, delete_after([](Trx *trx) { return trx->rollback(); }));
+}
+
+TEST_F(MvccLockTest, wait_for_commit)
+{
+  // 第一个事务提交了，第二个事务看到的版本已经被删除，不能再修改
+  ASSERT_EQ(RC::LOCKED_CONCURRENCY_CONFLICT, delete_after([](Trx *trx) { return trx->commit(); }));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,196 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "storage/common/chunk.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/mvcc_trx.h"
+
+using namespace std;
+
+class MvccVisibilityTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "mvcc", "vacuous"));
+
+    AttrInfoSqlNode attr_info;
+    attr_info.name   = "id";
+    attr_info.type   = AttrType::INTS;
+    attr_info.length = sizeof(int);
+    ASSERT_EQ(RC::SUCCESS, db_->create_table("t", span<const AttrInfoSqlNode>(&attr_info, 1)));
+    table_ = db_->find_table("t");
+    ASSERT_EQ(2, static_cast<int>(table_->table_meta().trx_fields().size()));
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  int scan_count(Trx *trx)
+  {
+    RecordFileScanner scanner;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY));
+    int    count = 0;
+    Record record;
+    RC     rc = RC::SUCCESS;
+    while (OB_SUCC(rc = scanner.next(record))) {
+      count++;
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    scanner.close_scan();
+    return count;
+  }
+
+  int chunk_scan_count(Trx *trx)
+  {
+    const FieldMeta *field = table_->table_meta().field("id");
+    Chunk            chunk;
+    chunk.add_column(make_unique<Column>(*field), field->field_id());
+
+    ChunkFileScanner scanner;
+    EXPECT_EQ(RC::SUCCESS, table_->get_chunk_scanner(scanner, trx, ReadWriteMode::READ_ONLY));
+    int count = 0;
+    RC  rc    = RC::SUCCESS;
+    while (true) {
+      chunk.reset_data();
+      if (OB_FAIL(rc = scanner.next_chunk(chunk))) {
+        break;
+      }
+      count += chunk.rows();
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    scanner.close_scan();
+    return count;
+  }
+
+protected:
+  filesystem::path test_directory_{"mvcc_visibility_test"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+};
+
+TEST_F(MvccVisibilityTest, same_as_visit_record)
+{
+  // 覆盖已提交、未提交的插入和删除，以及事务号在范围边界上的各种组合
+  const int32_t xids[] = {
+      numeric_limits<int32_t>::max(), -8, -7, -5, -3, -1, 0, 1, 3, 5, 7, 8, numeric_limits<int32_t>::min() + 1};
+  vector<int32_t> begin_xids;
+  vector<int32_t> end_xids;
+  for (int32_t begin_xid : xids) {
+    for (int32_t end_xid : xids) {
+      begin_xids.push_back(begin_xid);
+      end_xids.push_back(end_xid);
+    }
+  }
+
+  const int             count      = static_cast<int>(begin_xids.size());
+  span<const FieldMeta> trx_fields = table_->table_meta().trx_fields();
+  vector<char>          data(table_->table_meta().record_size());
+  MvccTrxKit           &trx_kit = static_cast<MvccTrxKit &>(db_->trx_kit());
+  for (int32_t trx_id : {1, 3, 5, 7, 8, 100}) {
+    SCOPED_TRACE(trx_id);
+    Trx *trx = trx_kit.create_trx(db_->log_handler(), trx_id);
+
+    vector<uint8_t> visible(count, 1);
+    trx->filter_visible_records(begin_xids.data(), end_xids.data(), count, visible.data());
+    for (int i = 0; i < count; i++) {
+      memcpy(data.data() + trx_fields[0].offset(), &begin_xids[i], sizeof(int32_t));
+      memcpy(data.data() + trx_fields[1].offset(), &end_xids[i], sizeof(int32_t));
+      Record record;
+      record.set_data(data.data(), static_cast<int>(data.size()));
+      const bool expected = trx->visit_record(table_, record, ReadWriteMode::READ_ONLY) == RC::SUCCESS;
+      ASSERT_EQ(expected, visible[i] != 0) << "begin xid=" << begin_xids[i] << ", end xid=" << end_xids[i];
+    }
+
+    // 已经被过滤掉的位置保持不变
+    vector<uint8_t> none(count, 0);
+    trx->filter_visible_records(begin_xids.data(), end_xids.data(), count, none.data());
+    ASSERT_EQ(vector<uint8_t>(count, 0), none);
+    trx_kit.destroy_trx(trx);
+  }
+}
+
+TEST_F(MvccVisibilityTest, scan_with_uncommitted_changes)
+{
+  const int rows = 1000;
+  Trx      *trx1 = db_->trx_kit().create_trx(db_->log_handler());
+  ASSERT_EQ(RC::SUCCESS, trx1->start_if_need());
+  for (int i = 0; i < rows; i++) {
+    Value  value(i);
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table_->make_record(1, &value, record));
+    ASSERT_EQ(RC::SUCCESS, trx1->insert_record(table_, record));
+  }
+  ASSERT_EQ(RC::SUCCESS, trx1->commit());
+
+  // trx2 删除 100 行、插入 50 行，但是不提交
+  Trx           *trx2 = db_->trx_kit().create_trx(db_->log_handler());
+  vector<Record> to_delete;
+  ASSERT_EQ(RC::SUCCESS, trx2->start_if_need());
+  to_delete.reserve(100);
+  {
+    RecordFileScanner scanner;
+    ASSERT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, trx2, ReadWriteMode::READ_ONLY));
+    Record record;
+    while (OB_SUCC(scanner.next(record)) && to_delete.size() < 100) {
+      to_delete.push_back(record);
+      to_delete.back().copy_data(record.data(), record.len());
+    }
+    scanner.close_scan();
+  }
+  for (Record &record : to_delete) {
+    ASSERT_EQ(RC::SUCCESS, trx2->delete_record(table_, record));
+  }
+  for (int i = 0; i < 50; i++) {
+    Value  value(rows + i);
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table_->make_record(1, &value, record));
+    ASSERT_EQ(RC::SUCCESS, trx2->insert_record(table_, record));
+  }
+
+  Trx *trx3 = db_->trx_kit().create_trx(db_->log_handler());
+  ASSERT_EQ(RC::SUCCESS, trx3->start_if_need());
+
+  // 自己的修改可见，其它事务没有提交的修改不可见
+  EXPECT_EQ(rows - 100 + 50, scan_count(trx2));
+  EXPECT_EQ(rows, scan_count(trx3));
+  EXPECT_EQ(rows - 100 + 50, chunk_scan_count(trx2));
+  EXPECT_EQ(rows, chunk_scan_count(trx3));
+
+  ASSERT_EQ(RC::SUCCESS, trx2->rollback());
+  Trx *trx4 = db_->trx_kit().create_trx(db_->log_handler());
+  ASSERT_EQ(RC::SUCCESS, trx4->start_if_need());
+  EXPECT_EQ(rows, scan_count(trx4));
+  EXPECT_EQ(rows, chunk_scan_count(trx4));
+
+  db_->trx_kit().destroy_trx(trx1);
+  db_->trx_kit().destroy_trx(trx2);
+  db_->trx_kit().destroy_trx(trx3);
+  db_->trx_kit().destroy_trx(trx4);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,192 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <map>
+
+#include "gtest/gtest.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/group_by_vec_physical_operator.h"
+#include "sql/operator/parallel_group_by_vec_physical_operator.h"
+#include "sql/operator/table_scan_vec_physical_operator.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+class ParallelGroupByTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "vacuous", "vacuous"));
+
+    AttrInfoSqlNode attr_infos[2];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "g";
+    attr_infos[1].type   = AttrType::INTS;
+    attr_infos[1].length = sizeof(int);
+    ASSERT_EQ(RC::SUCCESS, db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 2)));
+    table_ = db_->find_table("t");
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  void insert_rows(int rows)
+  {
+    for (int i = 0; i < rows; i++) {
+      Value  values[2] = {Value(i), Value(i % group_num_)};
+      Record record;
+      ASSERT_EQ(RC::SUCCESS, table_->make_record(2, values, record));
+      ASSERT_EQ(RC::SUCCESS, table_->insert_record(record));
+    }
+  }
+
+  unique_ptr<Expression> field(const char *name)
+  {
+    return make_unique<FieldExpr>(table_, table_->table_meta().field(name));
+  }
+
+  /// select g, sum(id) from t [where id >= min_id] group by g
+  unique_ptr<PhysicalOperator> plan(int workers, bool group_by, int min_id = -1)
+  {
+    sum_expr_ = make_unique<AggregateExpr>(AggregateExpr::Type::SUM, field("id"));
+    vector<unique_ptr<Expression>> group_by_exprs;
+    if (group_by) {
+      group_by_exprs.push_back(field("g"));
+    }
+    vector<Expression *> aggregate_exprs{sum_expr_.get()};
+
+    auto make_scan = [this, min_id]() {
+      auto scan = make_unique<TableScanVecPhysicalOperator>(table_, ReadWriteMode::READ_ONLY);
+      if (min_id >= 0) {
+        vector<unique_ptr<Expression>> predicates;
+        predicates.push_back(
+            make_unique<ComparisonExpr>(GREAT_EQUAL, field("id"), make_unique<ValueExpr>(Value(min_id))));
+        scan->set_predicates(std::move(predicates));
+      }
+      return scan;
+    };
+
+    if (workers <= 1) {
+      auto group_by_oper = make_unique<GroupByVecPhysicalOperator>(std::move(group_by_exprs), std::move(aggregate_exprs));
+      group_by_oper->add_child(make_scan());
+      return group_by_oper;
+    }
+
+    auto parallel_oper = make_unique<ParallelGroupByVecPhysicalOperator>(
+        table_, std::move(group_by_exprs), std::move(aggregate_exprs));
+    for (int i = 0; i < workers; i++) {
+      auto scan = make_scan();
+      scan->set_morsel_iterator(&parallel_oper->morsel_iterator());
+      parallel_oper->add_child(std::move(scan));
+    }
+    return parallel_oper;
+  }
+
+  /// 执行计划，返回分组值到聚合值的映射。没有分组时使用 -1 作为分组值
+  map<int, int> execute(PhysicalOperator &oper, bool group_by)
+  {
+    map<int, int> result;
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    EXPECT_EQ(RC::SUCCESS, oper.open(trx));
+
+    RC    rc = RC::SUCCESS;
+    Chunk chunk;
+    while (OB_SUCC(rc = oper.next(chunk))) {
+      for (int i = 0; i < chunk.rows(); i++) {
+        const int key = group_by ? chunk.get_value(0, i).get_int() : -1;
+        EXPECT_EQ(0, result.count(key)) << "duplicate group " << key;
+        result[key] = chunk.get_value(group_by ? 1 : 0, i).get_int();
+      }
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, oper.close());
+    db_->trx_kit().destroy_trx(trx);
+    return result;
+  }
+
+protected:
+  filesystem::path          test_directory_{"parallel_group_by_test"};
+  unique_ptr<Db>            db_;
+  Table                    *table_     = nullptr;
+  const int                 group_num_ = 7;
+  unique_ptr<AggregateExpr> sum_expr_;
+};
+
+TEST_F(ParallelGroupByTest, same_result_as_serial)
+{
+  // 数据有很多个页面，每个线程都能分到页面
+  insert_rows(20000);
+
+  auto          serial_plan = plan(1, true /*group_by*/);
+  map<int, int> expected    = execute(*serial_plan, true);
+  ASSERT_EQ(group_num_, static_cast<int>(expected.size()));
+
+  for (int workers : {2, 4, 8}) {
+    auto parallel_plan = plan(workers, true /*group_by*/);
+    EXPECT_EQ(expected, execute(*parallel_plan, true)) << "workers=" << workers;
+  }
+}
+
+TEST_F(ParallelGroupByTest, with_predicate)
+{
+  insert_rows(20000);
+
+  auto          serial_plan = plan(1, true /*group_by*/, 15000 /*min_id*/);
+  map<int, int> expected    = execute(*serial_plan, true);
+
+  auto parallel_plan = plan(4, true /*group_by*/, 15000 /*min_id*/);
+  EXPECT_EQ(expected, execute(*parallel_plan, true));
+}
+
+TEST_F(ParallelGroupByTest, without_group_by)
+{
+  insert_rows(10000);
+
+  auto          parallel_plan = plan(4, false /*group_by*/);
+  map<int, int> result        = execute(*parallel_plan, false);
+  ASSERT_EQ(1, static_cast<int>(result.size()));
+  EXPECT_EQ(10000 * 9999 / 2, result[-1]);
+
+  // 计划可以重复执行
+  EXPECT_EQ(result, execute(*parallel_plan, false));
+}
+
+TEST_F(ParallelGroupByTest, empty_table)
+{
+  // 工作线程比页面多，没有分组时也要输出一行
+  auto          parallel_plan = plan(4, false /*group_by*/);
+  map<int, int> result        = execute(*parallel_plan, false);
+  ASSERT_EQ(1, static_cast<int>(result.size()));
+  EXPECT_EQ(0, result[-1]);
+
+  auto group_by_plan = plan(4, true /*group_by*/);
+  EXPECT_TRUE(execute(*group_by_plan, true).empty());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -64,6 +64,98 @@ TEST(ParserTest, DISABLED_group_by_test)
   }
 }
 
+TEST(ParserTest, insert_multiple_rows)
+{
+  {
+    ParsedSqlResult result;
+    const char     *sql = "insert into t values(1, 'a')";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().size(), 1);
+    const InsertSqlNode &insertion = result.sql_nodes().front()->insertion;
+    ASSERT_EQ(insertion.values.size(), 1);
+    ASSERT_EQ(insertion.values[0].size(), 2);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "insert into t values(1, 'a'), (2, 'b'), (3, 'c')";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().size(), 1);
+    const InsertSqlNode &insertion = result.sql_nodes().front()->insertion;
+    ASSERT_EQ(insertion.relation_name, "t");
+    ASSERT_EQ(insertion.values.size(), 3);
+    for (int i = 0; i < 3; i++) {
+      ASSERT_EQ(insertion.values[i].size(), 2);
+      EXPECT_EQ(insertion.values[i][0].get_int(), i + 1);
+      EXPECT_EQ(insertion.values[i][1].get_string(), string(1, 'a' + i));
+    }
+  }
+  {
+    // 每一行的值个数在解析时不检查
+    ParsedSqlResult result;
+    const char     *sql = "insert into t values(1), (2, 3)";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->insertion.values.size(), 2);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "insert into t values(1),";
+    parse(sql, &result);
+    ASSERT_EQ(result.sql_nodes().size(), 1);
+    ASSERT_EQ(result.sql_nodes().front()->flag, SCF_ERROR);
+  }
+}
+
+TEST(ParserTest, update_multiple_columns)
+{
+  {
+    ParsedSqlResult result;
+    const char     *sql = "update t set a=1";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    const UpdateSqlNode &update = result.sql_nodes().front()->update;
+    ASSERT_EQ(update.relation_name, "t");
+    ASSERT_EQ(update.set_clauses.size(), 1);
+    ASSERT_EQ(update.conditions.size(), 0);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "update t set a=1, b='x', c=2.5 where a=3";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->flag, SCF_UPDATE);
+    const UpdateSqlNode &update = result.sql_nodes().front()->update;
+    ASSERT_EQ(update.set_clauses.size(), 3);
+    EXPECT_EQ(update.set_clauses[0].attribute_name, "a");
+    EXPECT_EQ(update.set_clauses[0].value.get_int(), 1);
+    EXPECT_EQ(update.set_clauses[1].attribute_name, "b");
+    EXPECT_EQ(update.set_clauses[1].value.get_string(), "x");
+    EXPECT_EQ(update.set_clauses[2].attribute_name, "c");
+    ASSERT_EQ(update.conditions.size(), 1);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "update t set a=1,";
+    parse(sql, &result);
+    ASSERT_EQ(result.sql_nodes().front()->flag, SCF_ERROR);
+  }
+}
+
+TEST(ParserTest, create_table_var_len)
+{
+  ParsedSqlResult result;
+  const char     *sql = "create table t(id int, name varchar(32), info text, c char(4))";
+  ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+  ASSERT_EQ(result.sql_nodes().front()->flag, SCF_CREATE_TABLE);
+  const vector<AttrInfoSqlNode> &attrs = result.sql_nodes().front()->create_table.attr_infos;
+  ASSERT_EQ(attrs.size(), 4);
+  EXPECT_FALSE(attrs[0].var_len);
+  EXPECT_EQ(attrs[1].type, AttrType::CHARS);
+  EXPECT_EQ(attrs[1].length, 32);
+  EXPECT_TRUE(attrs[1].var_len);
+  EXPECT_EQ(attrs[2].type, AttrType::CHARS);
+  EXPECT_EQ(attrs[2].length, 4096);
+  EXPECT_TRUE(attrs[2].var_len);
+  EXPECT_FALSE(attrs[3].var_len);
+}
+
 int main(int argc, char **argv)
 {
 
@@ -0,0 +1,680 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <unordered_map>
+
+#define protected public
+#define private public
+#include "storage/table/table.h"
+#undef protected
+#undef private
+
+#include "gtest/gtest.h"
+#include "common/math/integer_generator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/integrated_log_replayer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/common/chunk.h"
+#include "storage/db/db.h"
+#include "storage/record/pax_minipage.h"
+#include "storage/record/record_manager.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+using namespace common;
+
+namespace {
+
+const CompOp ALL_COMP_OPS[] = {EQUAL_TO, LESS_EQUAL, NOT_EQUAL, LESS_THAN, GREAT_EQUAL, GREAT_THAN};
+
+bool compare_result(CompOp comp, int cmp)
+{
+  switch (comp) {
+    case EQUAL_TO: return cmp == 0;
+    case LESS_EQUAL: return cmp <= 0;
+    case NOT_EQUAL: return cmp != 0;
+    case LESS_THAN: return cmp < 0;
+    case GREAT_EQUAL: return cmp >= 0;
+    case GREAT_THAN: return cmp > 0;
+    default: return false;
+  }
+}
+
+/// 一列 int 值编码后逐个解码、批量解码和过滤，结果与原始数据一致
+void check_int_mini_page(const vector<int> &values, bool compress, MiniPageEncoding expected)
+{
+  const int    count = static_cast<int>(values.size());
+  vector<char> out;
+  MiniPageEncoding encoding =
+      MiniPageWriter::encode(AttrType::INTS, sizeof(int), (const char *)values.data(), count, compress, out);
+  ASSERT_EQ(expected, encoding) << mini_page_encoding_name(encoding);
+
+  MiniPageReader reader(encoding, AttrType::INTS, sizeof(int), out.data(), count);
+  char           buffer[sizeof(int)];
+  for (int i = 0; i < count; i++) {
+    int value = 0;
+    memcpy(&value, reader.value(i, buffer), sizeof(int));
+    ASSERT_EQ(values[i], value) << "row " << i;
+  }
+
+  vector<int> decoded(count);
+  reader.decode(0, count, (char *)decoded.data());
+  ASSERT_EQ(values, decoded);
+
+  vector<int> rows;
+  for (int i = 1; i < count; i += 3) {
+    rows.push_back(i);
+  }
+  vector<int> selected(rows.size());
+  reader.decode_rows(rows.data(), static_cast<int>(rows.size()), (char *)selected.data());
+  for (size_t i = 0; i < rows.size(); i++) {
+    ASSERT_EQ(values[rows[i]], selected[i]);
+  }
+
+  // 常量覆盖数据范围之内和之外的值
+  const int probes[] = {values[0], values[count / 2], values[count - 1], values[count / 3] + 1, INT32_MIN, INT32_MAX};
+  for (int probe : probes) {
+    for (CompOp comp : ALL_COMP_OPS) {
+      vector<uint8_t> select(count, 1);
+      reader.filter(comp, Value(probe), select.data());
+      for (int i = 0; i < count; i++) {
+        const int cmp = values[i] < probe ? -1 : (values[i] > probe ? 1 : 0);
+        ASSERT_EQ(compare_result(comp, cmp), select[i] != 0) << "row " << i << ", probe " << probe << ", comp " << comp;
+      }
+    }
+  }
+}
+
+/// 表 t(id int, day int, region char(8), amount float)
+void init_table_meta(TableMeta &table_meta)
+{
+  AttrInfoSqlNode attr_infos[4];
+  attr_infos[0].name   = "id";
+  attr_infos[0].type   = AttrType::INTS;
+  attr_infos[0].length = sizeof(int);
+  attr_infos[1].name   = "day";
+  attr_infos[1].type   = AttrType::INTS;
+  attr_infos[1].length = sizeof(int);
+  attr_infos[2].name   = "region";
+  attr_infos[2].type   = AttrType::CHARS;
+  attr_infos[2].length = 8;
+  attr_infos[3].name   = "amount";
+  attr_infos[3].type   = AttrType::FLOATS;
+  attr_infos[3].length = sizeof(float);
+  ASSERT_EQ(RC::SUCCESS,
+      table_meta.init(1, "t", nullptr, span<const AttrInfoSqlNode>(attr_infos, 4), StorageFormat::PAX_FORMAT));
+}
+
+const char *REGIONS[] = {"east", "west", "north", "south", "center"};
+
+struct Row
+{
+  int    id;
+  int    day;
+  string region;
+  float  amount;
+};
+
+/// 按照 id 生成一行适合压缩的数据：day 有序，region 基数很小，amount 随机
+Row make_row(int id)
+{
+  return Row{id, 20240000 + id / 100, REGIONS[id % 5], static_cast<float>((id * 7919) % 10007) / 8};
+}
+
+string make_record(const TableMeta &table_meta, const Row &row)
+{
+  string record(table_meta.record_size(), '\0');
+  memcpy(record.data() + table_meta.field("id")->offset(), &row.id, sizeof(row.id));
+  memcpy(record.data() + table_meta.field("day")->offset(), &row.day, sizeof(row.day));
+  memcpy(record.data() + table_meta.field("region")->offset(), row.region.data(), row.region.size());
+  memcpy(record.data() + table_meta.field("amount")->offset(), &row.amount, sizeof(row.amount));
+  return record;
+}
+
+Row parse_record(const TableMeta &table_meta, const char *data)
+{
+  Row              row;
+  const FieldMeta *region = table_meta.field("region");
+  memcpy(&row.id, data + table_meta.field("id")->offset(), sizeof(row.id));
+  memcpy(&row.day, data + table_meta.field("day")->offset(), sizeof(row.day));
+  row.region = string(data + region->offset(), strnlen(data + region->offset(), region->len()));
+  memcpy(&row.amount, data + table_meta.field("amount")->offset(), sizeof(row.amount));
+  return row;
+}
+
+void expect_row(const Row &expected, const Row &actual)
+{
+  EXPECT_EQ(expected.id, actual.id);
+  EXPECT_EQ(expected.day, actual.day);
+  EXPECT_EQ(expected.region, actual.region);
+  EXPECT_EQ(expected.amount, actual.amount);
+}
+
+}  // namespace
+
+TEST(MiniPage, int_encodings)
+{
+  vector<int> values(1000);
+
+  // 有序的值差别不大，FOR 只需要几位
+  for (int i = 0; i < 1000; i++) {
+    values[i] = 1000000 + i * 3;
+  }
+  check_int_mini_page(values, true, MiniPageEncoding::FOR);
+
+  // 长的游程
+  for (int i = 0; i < 1000; i++) {
+    values[i] = i / 250 - 2;
+  }
+  check_int_mini_page(values, true, MiniPageEncoding::RLE);
+
+  // 值的范围太大，不压缩
+  for (int i = 0; i < 1000; i++) {
+    values[i] = i % 2 == 0 ? INT32_MIN + i : INT32_MAX - i;
+  }
+  check_int_mini_page(values, true, MiniPageEncoding::RAW);
+
+  // 所有值都一样，FOR 的位数是 0
+  values.assign(1000, 42);
+  check_int_mini_page(values, true, MiniPageEncoding::RLE);
+
+  for (int i = 0; i < 1000; i++) {
+    values[i] = i;
+  }
+  check_int_mini_page(values, false, MiniPageEncoding::RAW);
+}
+
+TEST(MiniPage, char_encodings)
+{
+  const int    len   = 8;
+  const int    count = 1000;
+  vector<char> values(count * len, 0);
+  for (int i = 0; i < count; i++) {
+    const char *region = REGIONS[(i * 7) % 5];
+    memcpy(values.data() + i * len, region, strlen(region));
+  }
+
+  vector<char>     out;
+  MiniPageEncoding encoding = MiniPageWriter::encode(AttrType::CHARS, len, values.data(), count, true, out);
+  ASSERT_EQ(MiniPageEncoding::DICT, encoding);
+  ASSERT_LT(out.size(), values.size() / 4);
+
+  MiniPageReader reader(encoding, AttrType::CHARS, len, out.data(), count);
+  vector<char>   decoded(values.size());
+  reader.decode(0, count, decoded.data());
+  ASSERT_EQ(values, decoded);
+
+  for (const char *probe : {"east", "north", "a", "zzz", "center"}) {
+    for (CompOp comp : ALL_COMP_OPS) {
+      vector<uint8_t> select(count, 1);
+      reader.filter(comp, Value(probe), select.data());
+      for (int i = 0; i < count; i++) {
+        const int cmp = strcmp(REGIONS[(i * 7) % 5], probe);
+        ASSERT_EQ(compare_result(comp, cmp), select[i] != 0) << "row " << i << ", probe " << probe << ", comp " << comp;
+      }
+    }
+  }
+
+  // 有序的字符串游程编码更小
+  for (int i = 0; i < count; i++) {
+    memset(values.data() + i * len, 0, len);
+    const char *region = REGIONS[i * 5 / count];
+    memcpy(values.data() + i * len, region, strlen(region));
+  }
+  out.clear();
+  encoding = MiniPageWriter::encode(AttrType::CHARS, len, values.data(), count, true, out);
+  ASSERT_EQ(MiniPageEncoding::RLE, encoding);
+  MiniPageReader rle_reader(encoding, AttrType::CHARS, len, out.data(), count);
+  rle_reader.decode(0, count, decoded.data());
+  ASSERT_EQ(values, decoded);
+
+  vector<uint8_t> select(count, 1);
+  rle_reader.filter(EQUAL_TO, Value("north"), select.data());
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(strcmp(REGIONS[i * 5 / count], "north") == 0, select[i] != 0);
+  }
+}
+
+class PaxCompressionPageTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    ::remove(file_name_);
+    bpm_ = make_unique<BufferPoolManager>();
+    ASSERT_EQ(RC::SUCCESS, bpm_->init(make_unique<VacuousDoubleWriteBuffer>()));
+    ASSERT_EQ(RC::SUCCESS, bpm_->create_file(file_name_));
+    ASSERT_EQ(RC::SUCCESS, bpm_->open_file(log_handler_, file_name_, buffer_pool_));
+
+    init_table_meta(table_meta_);
+    handler_ = make_unique<PaxRecordPageHandler>();
+
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_->allocate_page(&frame));
+    page_num_ = frame->page_num();
+    ASSERT_EQ(RC::SUCCESS,
+        handler_->init_empty_page(*buffer_pool_, log_handler_, page_num_, table_meta_.record_size(), &table_meta_));
+    frame->unpin();
+  }
+
+  void TearDown() override
+  {
+    handler_.reset();
+    bpm_->close_file(file_name_);
+    bpm_.reset();
+    ::remove(file_name_);
+  }
+
+protected:
+  /// 插入到页面满为止，返回插入的行数
+  int fill_page()
+  {
+    int count = 0;
+    while (!handler_->is_full()) {
+      string record = make_record(table_meta_, make_row(count));
+      RID    rid;
+      EXPECT_EQ(RC::SUCCESS, handler_->insert_record(record.data(), &rid));
+      EXPECT_EQ(count, rid.slot_num);
+      count++;
+    }
+    return count;
+  }
+
+  Row read_row(SlotNum slot_num)
+  {
+    Record record;
+    EXPECT_EQ(RC::SUCCESS, handler_->get_record(RID(page_num_, slot_num), record));
+    return parse_record(table_meta_, record.data());
+  }
+
+  void add_columns(Chunk &chunk)
+  {
+    for (int i = 0; i < table_meta_.field_num(); i++) {
+      chunk.add_column(make_unique<Column>(*table_meta_.field(i), PaxRecordPageHandler::MAX_RECORD_CAPACITY), i);
+    }
+  }
+
+protected:
+  const char                      *file_name_ = "pax_compression_test.bp";
+  VacuousLogHandler                log_handler_;
+  unique_ptr<BufferPoolManager>    bpm_;
+  DiskBufferPool                  *buffer_pool_ = nullptr;
+  TableMeta                        table_meta_;
+  unique_ptr<PaxRecordPageHandler> handler_;
+  PageNum                          page_num_ = BP_INVALID_PAGE_NUM;
+};
+
+TEST_F(PaxCompressionPageTest, seal_and_read)
+{
+  // 不压缩时一个页面最多只能放 BP_PAGE_DATA_SIZE / 20 条记录
+  const int count = fill_page();
+  ASSERT_GT(count, BP_PAGE_DATA_SIZE / table_meta_.record_size() * 2);
+  ASSERT_GT(handler_->sealed_row_count(), 0);
+  ASSERT_LE(handler_->data_size(), BP_PAGE_DATA_SIZE);
+  EXPECT_EQ(MiniPageEncoding::FOR, handler_->column_encoding(0));
+  EXPECT_EQ(MiniPageEncoding::RLE, handler_->column_encoding(1));
+  EXPECT_EQ(MiniPageEncoding::DICT, handler_->column_encoding(2));
+  EXPECT_EQ(MiniPageEncoding::RAW, handler_->column_encoding(3));
+
+  string record = make_record(table_meta_, make_row(count));
+  RID    rid;
+  ASSERT_EQ(RC::RECORD_NOMEM, handler_->insert_record(record.data(), &rid));
+
+  for (int i = 0; i < count; i++) {
+    expect_row(make_row(i), read_row(i));
+  }
+
+  // 删除一部分记录后按列读取，编码区和未编码区的记录都有
+  for (int i = 0; i < count; i += 3) {
+    RID del_rid(page_num_, i);
+    ASSERT_EQ(RC::SUCCESS, handler_->delete_record(&del_rid));
+  }
+  Chunk chunk;
+  add_columns(chunk);
+  ASSERT_EQ(RC::SUCCESS, handler_->get_chunk(chunk));
+  ASSERT_EQ(count - (count + 2) / 3, chunk.rows());
+  for (int i = 0, id = 1; i < chunk.rows(); i++, id += (id % 3 == 2 ? 2 : 1)) {
+    Row row = make_row(id);
+    ASSERT_EQ(row.id, chunk.get_value(0, i).get_int());
+    ASSERT_EQ(row.day, chunk.get_value(1, i).get_int());
+    ASSERT_EQ(row.region, chunk.get_value(2, i).get_string());
+    ASSERT_EQ(row.amount, chunk.get_value(3, i).get_float());
+  }
+
+  // 只读取部分列，并且只要部分行，删除的记录不返回
+  Chunk           day_chunk;
+  vector<uint8_t> visible(handler_->record_capacity(), 0);
+  vector<int>     visible_ids;
+  for (int i = 1; i < count; i += 10) {
+    visible[i] = 1;
+    if (i % 3 != 0) {
+      visible_ids.push_back(i);
+    }
+  }
+  day_chunk.add_column(make_unique<Column>(*table_meta_.field(1), PaxRecordPageHandler::MAX_RECORD_CAPACITY), 1);
+  ASSERT_EQ(RC::SUCCESS, handler_->get_chunk(day_chunk, visible.data()));
+  ASSERT_EQ(static_cast<int>(visible_ids.size()), day_chunk.rows());
+  for (int i = 0; i < day_chunk.rows(); i++) {
+    ASSERT_EQ(make_row(visible_ids[i]).day, day_chunk.get_value(0, i).get_int());
+  }
+
+  vector<int32_t> days(handler_->record_capacity());
+  ASSERT_EQ(RC::SUCCESS, handler_->read_int_field(*table_meta_.field("day"), days.data()));
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(make_row(i).day, days[i]);
+  }
+}
+
+TEST_F(PaxCompressionPageTest, update_sealed_rows)
+{
+  const int count  = fill_page();
+  const int sealed = handler_->sealed_row_count();
+  ASSERT_GT(sealed, 10);
+
+  // 不编码的列原地修改
+  Row row    = make_row(5);
+  row.amount = -1.5f;
+  string record = make_record(table_meta_, row);
+  ASSERT_EQ(RC::SUCCESS, handler_->update_record(RID(page_num_, 5), record.data()));
+  expect_row(row, read_row(5));
+  ASSERT_EQ(sealed, handler_->sealed_row_count());
+
+  // 编码的列需要重新编码，新的值仍然可以放下
+  row.region = REGIONS[0];
+  row.day    = make_row(count - 1).day;
+  record     = make_record(table_meta_, row);
+  ASSERT_EQ(RC::SUCCESS, handler_->update_record(RID(page_num_, 5), record.data()));
+  expect_row(row, read_row(5));
+  for (int i = 0; i < count; i++) {
+    if (i != 5) {
+      expect_row(make_row(i), read_row(i));
+    }
+  }
+
+  // 把有序的 id 改得很大，FOR 放不下时修改失败，页面保持不变
+  Row big_row = make_row(6);
+  big_row.id  = INT32_MAX;
+  record      = make_record(table_meta_, big_row);
+  RC rc       = handler_->update_record(RID(page_num_, 6), record.data());
+  if (rc == RC::RECORD_NOMEM) {
+    expect_row(make_row(6), read_row(6));
+  } else {
+    ASSERT_EQ(RC::SUCCESS, rc);
+    expect_row(big_row, read_row(6));
+  }
+  expect_row(row, read_row(5));
+}
+
+TEST_F(PaxCompressionPageTest, filter_column)
+{
+  const int count = fill_page();
+  for (int i = 0; i < count; i += 7) {
+    RID del_rid(page_num_, i);
+    ASSERT_EQ(RC::SUCCESS, handler_->delete_record(&del_rid));
+  }
+
+  struct Probe
+  {
+    int   column_id;
+    Value value;
+  };
+  const Probe probes[] = {
+      {0, Value(count / 2)},
+      {0, Value(-1)},
+      {1, Value(make_row(count / 3).day)},
+      {2, Value("north")},
+      {2, Value("m")},
+      {3, Value(make_row(17).amount)},
+  };
+
+  for (const Probe &probe : probes) {
+    for (CompOp comp : ALL_COMP_OPS) {
+      vector<uint8_t> select(handler_->record_capacity(), 1);
+      ColumnPredicate predicate{probe.column_id, comp, probe.value};
+      ASSERT_EQ(RC::SUCCESS, handler_->filter_column(predicate, select.data()));
+
+      for (int i = 0; i < count; i++) {
+        Row   row = make_row(i);
+        Value value;
+        switch (probe.column_id) {
+          case 0: value = Value(row.id); break;
+          case 1: value = Value(row.day); break;
+          case 2: value = Value(row.region.c_str()); break;
+          default: value = Value(row.amount); break;
+        }
+        ASSERT_EQ(compare_result(comp, value.compare(probe.value)), select[i] != 0)
+            << "row " << i << ", column " << probe.column_id << ", comp " << comp;
+      }
+    }
+  }
+}
+
+TEST_F(PaxCompressionPageTest, reuse_empty_page)
+{
+  const int count = fill_page();
+  for (int i = 0; i < count; i++) {
+    RID del_rid(page_num_, i);
+    ASSERT_EQ(RC::SUCCESS, handler_->delete_record(&del_rid));
+  }
+  ASSERT_FALSE(handler_->is_full());
+  ASSERT_EQ(0, handler_->row_count());
+  ASSERT_EQ(count, fill_page());
+}
+
+TEST(PaxCompressionFile, durability)
+{
+  /*
+   * 测试场景：
+   * 1. 插入很多行，页面会多次封存，再修改、删除一些记录
+   * 2. 用还没有刷盘的文件和日志恢复，封存是确定的，重做之后的记录位置和内容都不变
+   */
+  filesystem::path directory("pax_compression_durability");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+  filesystem::path file = directory / "pax.bp";
+
+  TableMeta table_meta;
+  init_table_meta(table_meta);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskLogHandler        log_handler;
+  IntegratedLogReplayer log_replayer(bpm);
+  ASSERT_EQ(RC::SUCCESS, log_handler.init(directory.c_str()));
+  ASSERT_EQ(RC::SUCCESS, log_handler.replay(log_replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler.start());
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file.c_str()));
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, file.c_str(), buffer_pool));
+  RecordFileHandler record_file_handler(StorageFormat::PAX_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, record_file_handler.init(*buffer_pool, log_handler, &table_meta));
+
+  const int                        row_num = 5000;
+  unordered_map<RID, Row, RIDHash> expected;
+  vector<RID>                      rids;
+  for (int i = 0; i < row_num; i++) {
+    Row    row    = make_row(i);
+    string record = make_record(table_meta, row);
+    RID    rid;
+    ASSERT_EQ(RC::SUCCESS, record_file_handler.insert_record(record.data(), record.size(), &rid));
+    expected[rid] = row;
+    rids.push_back(rid);
+  }
+  for (int i = 0; i < row_num; i += 11) {
+    Row row    = make_row(i);
+    row.amount = -row.amount;
+    row.region = REGIONS[(i + 1) % 5];
+    RC rc      = record_file_handler.visit_record(rids[i], [&](Record &record) {
+      string data = make_record(table_meta, row);
+      memcpy(record.data(), data.data(), data.size());
+      return true;
+    });
+    if (OB_SUCC(rc)) {
+      expected[rids[i]] = row;
+    } else {
+      ASSERT_EQ(RC::RECORD_NOMEM, rc);
+    }
+  }
+  for (int i = 1; i < row_num; i += 4) {
+    ASSERT_EQ(RC::SUCCESS, record_file_handler.delete_record(&rids[i]));
+    expected.erase(rids[i]);
+  }
+
+  // 复制出还没有刷盘的文件，只靠日志恢复数据
+  filesystem::path file_copy = directory / "pax_copy.bp";
+  filesystem::copy_file(file, file_copy);
+  record_file_handler.close();
+  bpm.close_file(file.c_str());
+  filesystem::remove(file);
+  ASSERT_EQ(RC::SUCCESS, log_handler.stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler.await_termination());
+
+  DiskLogHandler    log_handler2;
+  BufferPoolManager bpm2;
+  ASSERT_EQ(RC::SUCCESS, bpm2.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *buffer_pool2 = nullptr;
+  filesystem::copy(file_copy, file);
+  ASSERT_EQ(RC::SUCCESS, bpm2.open_file(log_handler2, file.c_str(), buffer_pool2));
+
+  IntegratedLogReplayer log_replayer2(bpm2);
+  ASSERT_EQ(RC::SUCCESS, log_handler2.init(directory.c_str()));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.replay(log_replayer2, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.start());
+
+  RecordFileHandler record_file_handler2(StorageFormat::PAX_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, record_file_handler2.init(*buffer_pool2, log_handler2, &table_meta));
+  for (const auto &[rid, row] : expected) {
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, record_file_handler2.get_record(rid, record));
+    expect_row(row, parse_record(table_meta, record.data()));
+  }
+
+  Table table;
+  table.table_meta_.storage_format_ = StorageFormat::PAX_FORMAT;
+  RecordFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, scanner.open_scan(&table, *buffer_pool2, nullptr, log_handler2, ReadWriteMode::READ_ONLY, nullptr));
+  int    count = 0;
+  Record record;
+  while (OB_SUCC(scanner.next(record))) {
+    count++;
+  }
+  scanner.close_scan();
+  ASSERT_EQ(static_cast<int>(expected.size()), count);
+
+  record_file_handler2.close();
+  ASSERT_EQ(RC::SUCCESS, log_handler2.stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler2.await_termination());
+  bpm2.close_file(file.c_str());
+  filesystem::remove_all(directory);
+}
+
+/**
+ * @brief PAX 格式的表，使用 MVCC 事务，事务字段不编码
+ */
+class PaxCompressionTableTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "mvcc", "vacuous"));
+
+    AttrInfoSqlNode attr_infos[2];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "region";
+    attr_infos[1].type   = AttrType::CHARS;
+    attr_infos[1].length = 8;
+    ASSERT_EQ(RC::SUCCESS, db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 2), StorageFormat::PAX_FORMAT));
+    table_ = db_->find_table("t");
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  filesystem::path test_directory_{"pax_compression_test"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+};
+
+TEST_F(PaxCompressionTableTest, mvcc_chunk_scan_with_predicates)
+{
+  const int row_num = 10000;
+  Trx      *trx     = db_->trx_kit().create_trx(db_->log_handler());
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+  for (int i = 0; i < row_num; i++) {
+    Value  values[2] = {Value(i), Value(REGIONS[i % 5])};
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table_->make_record(2, values, record));
+    ASSERT_EQ(RC::SUCCESS, trx->insert_record(table_, record));
+  }
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  db_->trx_kit().destroy_trx(trx);
+
+  // 另一个没有提交的事务删除一部分记录，对读事务不可见
+  Trx *deleter = db_->trx_kit().create_trx(db_->log_handler());
+  ASSERT_EQ(RC::SUCCESS, deleter->start_if_need());
+  RecordFileScanner record_scanner;
+  ASSERT_EQ(RC::SUCCESS, table_->get_record_scanner(record_scanner, deleter, ReadWriteMode::READ_WRITE));
+  Record record;
+  int    deleted = 0;
+  while (OB_SUCC(record_scanner.next(record)) && deleted < 100) {
+    ASSERT_EQ(RC::SUCCESS, deleter->delete_record(table_, record));
+    deleted++;
+  }
+  record_scanner.close_scan();
+
+  const TableMeta &table_meta = table_->table_meta();
+  const FieldMeta *id_field   = table_meta.field("id");
+  const FieldMeta *region     = table_meta.field("region");
+  const int        id_column  = table_meta.sys_field_num() + id_field->field_id();
+  Chunk            chunk;
+  chunk.add_column(make_unique<Column>(*id_field), id_column);
+  chunk.add_column(make_unique<Column>(*region), table_meta.sys_field_num() + region->field_id());
+
+  Trx *reader = db_->trx_kit().create_trx(db_->log_handler());
+  ASSERT_EQ(RC::SUCCESS, reader->start_if_need());
+  ChunkFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, table_->get_chunk_scanner(scanner, reader, ReadWriteMode::READ_ONLY));
+  scanner.set_predicates({ColumnPredicate{id_column, GREAT_EQUAL, Value(1000)},
+      ColumnPredicate{table_meta.sys_field_num() + region->field_id(), EQUAL_TO, Value("west")}});
+  int rows = 0;
+  while (OB_SUCC(scanner.next_chunk(chunk))) {
+    for (int i = 0; i < chunk.rows(); i++) {
+      ASSERT_GE(chunk.get_value(0, i).get_int(), 1000);
+      ASSERT_EQ("west", chunk.get_value(1, i).get_string());
+    }
+    rows += chunk.rows();
+    chunk.reset_data();
+  }
+  scanner.close_scan();
+  ASSERT_EQ((row_num - 1000) / 5, rows);
+
+  ASSERT_EQ(RC::SUCCESS, deleter->rollback());
+  db_->trx_kit().destroy_trx(deleter);
+  db_->trx_kit().destroy_trx(reader);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -36,7 +36,7 @@ using namespace common;
 class PaxRecordFileScannerWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
+TEST_P(PaxRecordFileScannerWithParam, test_file_iterator)
 {
   int               record_insert_num = GetParam();
   VacuousLogHandler log_handler;
@@ -88,7 +88,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
   ASSERT_EQ(count, 0);
 
   // chunk iterator
-  rc = chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY);
+  rc = chunk_scanner.open_scan_chunk(&table, *bp, nullptr /*trx*/, log_handler, ReadWriteMode::READ_ONLY);
   ASSERT_EQ(rc, RC::SUCCESS);
   Chunk     chunk;
   FieldMeta fm;
@@ -127,7 +127,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
   ASSERT_EQ(count, rids.size());
 
   // chunk iterator
-  rc = chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY);
+  rc = chunk_scanner.open_scan_chunk(&table, *bp, nullptr /*trx*/, log_handler, ReadWriteMode::READ_ONLY);
   ASSERT_EQ(rc, RC::SUCCESS);
   chunk.reset_data();
   count = 0;
@@ -158,7 +158,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
   ASSERT_EQ(count, rids.size() / 2);
 
   // chunk iterator
-  rc = chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY);
+  rc = chunk_scanner.open_scan_chunk(&table, *bp, nullptr /*trx*/, log_handler, ReadWriteMode::READ_ONLY);
   ASSERT_EQ(rc, RC::SUCCESS);
   chunk.reset_data();
   count = 0;
@@ -176,7 +176,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
 class PaxPageHandlerTestWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
+TEST_P(PaxPageHandlerTestWithParam, PaxPageHandler)
 {
   int               record_num = GetParam();
   VacuousLogHandler log_handler;
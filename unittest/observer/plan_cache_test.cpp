@@ -0,0 +1,249 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/predicate_physical_operator.h"
+#include "sql/parser/parse.h"
+#include "sql/plan_cache/plan_cache.h"
+#include "sql/plan_cache/prepared_statement.h"
+
+using namespace std;
+
+/**
+ * @brief 按行输出固定数据的算子
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  RowsPhysicalOperator(int rows, PhysicalOperatorType type) : rows_(rows), type_(type) {}
+
+  PhysicalOperatorType type() const override { return type_; }
+
+  RC open(Trx *) override
+  {
+    index_ = -1;
+    return RC::SUCCESS;
+  }
+  RC next() override
+  {
+    if (++index_ >= rows_) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_cells({Value(index_)});
+    return RC::SUCCESS;
+  }
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  int                  rows_  = 0;
+  int                  index_ = -1;
+  PhysicalOperatorType type_;
+  ValueListTuple       tuple_;
+};
+
+static int count_rows(PhysicalOperator &oper)
+{
+  EXPECT_EQ(RC::SUCCESS, oper.open(nullptr));
+  int rows = 0;
+  while (oper.next() == RC::SUCCESS) {
+    rows++;
+  }
+  EXPECT_EQ(RC::SUCCESS, oper.close());
+  return rows;
+}
+
+static unique_ptr<CachedPlan> make_plan(const string &key, PhysicalOperatorType type = PhysicalOperatorType::TABLE_SCAN)
+{
+  auto plan            = make_unique<CachedPlan>();
+  plan->key            = key;
+  plan->schema_version = PlanCache::schema_version();
+  plan->plan           = make_unique<RowsPhysicalOperator>(1, type);
+  return plan;
+}
+
+TEST(PlanCache, parameterize)
+{
+  string        normalized_sql;
+  string        key;
+  vector<Value> params;
+  ASSERT_TRUE(PlanCache::parameterize(
+      "select id, 'x' from t1  where id = 12 and\nname='abc' and score > -1.5 order by id limit 10;",
+      normalized_sql, key, params));
+  // 只有 where 中的常量会被替换，标识符中的数字保持不变
+  ASSERT_EQ(string("select id, 'x' from t1 where id = ? and name=? and score > ? order by id limit 10;"), normalized_sql);
+  ASSERT_EQ(3, static_cast<int>(params.size()));
+  ASSERT_EQ(AttrType::INTS, params[0].attr_type());
+  ASSERT_EQ(12, params[0].get_int());
+  ASSERT_EQ(AttrType::CHARS, params[1].attr_type());
+  ASSERT_EQ(string("abc"), params[1].get_string());
+  ASSERT_EQ(AttrType::FLOATS, params[2].attr_type());
+  ASSERT_FLOAT_EQ(-1.5, params[2].get_float());
+
+  // 常量不同、空白不同的语句使用同一个键
+  string        other_normalized_sql;
+  string        other_key;
+  vector<Value> other_params;
+  ASSERT_TRUE(PlanCache::parameterize(
+      "select id, 'x' from t1 where id = 3 and name=\"d\" and score > 2.0 order by id limit 10;",
+      other_normalized_sql, other_key, other_params));
+  ASSERT_EQ(key, other_key);
+  ASSERT_EQ(3, other_params[0].get_int());
+
+  // 常量的类型不同时，隐式类型转换可能不同，不能共用计划
+  ASSERT_TRUE(PlanCache::parameterize(
+      "select id, 'x' from t1 where id = 3.5 and name='d' and score > 2.0 order by id limit 10;",
+      other_normalized_sql, other_key, other_params));
+  ASSERT_NE(key, other_key);
+
+  // limit 中的常量决定计划的形状，保留原样
+  ASSERT_TRUE(PlanCache::parameterize("select * from t limit 5", normalized_sql, key, params));
+  ASSERT_TRUE(PlanCache::parameterize("select * from t limit 6", other_normalized_sql, other_key, other_params));
+  ASSERT_NE(key, other_key);
+  ASSERT_TRUE(params.empty());
+
+  ASSERT_FALSE(PlanCache::parameterize("insert into t values(1)", normalized_sql, key, params));
+  ASSERT_FALSE(PlanCache::parameterize("explain select * from t where id=1", normalized_sql, key, params));
+  ASSERT_FALSE(PlanCache::parameterize("select * from t where name='abc", normalized_sql, key, params));
+  ASSERT_FALSE(PlanCache::parameterize("select * from t where id=?", normalized_sql, key, params));
+  ASSERT_FALSE(PlanCache::parameterize("", normalized_sql, key, params));
+}
+
+TEST(PlanCache, parse_param)
+{
+  string        normalized_sql;
+  string        key;
+  vector<Value> params;
+  ASSERT_TRUE(PlanCache::parameterize(
+      "select * from t where 1 = id and name = 'a' and 2 < 3", normalized_sql, key, params));
+
+  ParsedSqlResult result;
+  ASSERT_EQ(RC::SUCCESS, parse(normalized_sql.c_str(), &result));
+  ASSERT_EQ(4, result.param_num());
+  ASSERT_EQ(1, static_cast<int>(result.sql_nodes().size()));
+
+  // 条件按照出现的顺序编号
+  vector<ConditionSqlNode> &conditions = result.sql_nodes()[0]->selection.conditions;
+  ASSERT_EQ(3, static_cast<int>(conditions.size()));
+  int params_seen = 0;
+  for (const ConditionSqlNode &condition : conditions) {
+    if (condition.left_is_attr) {
+      ASSERT_EQ(1, condition.right_param);
+      params_seen++;
+    } else if (condition.right_is_attr) {
+      ASSERT_EQ(0, condition.left_param);
+      params_seen++;
+    } else {
+      ASSERT_EQ(2, condition.left_param);
+      ASSERT_EQ(3, condition.right_param);
+      params_seen += 2;
+    }
+  }
+  ASSERT_EQ(4, params_seen);
+}
+
+TEST(PlanCache, rebind_param)
+{
+  vector<Value> params = {Value(1)};
+
+  // select * from rows where ? = 1
+  auto param_expr = make_unique<ParamExpr>(0, &params);
+  auto cmp_expr   = make_unique<ComparisonExpr>(EQUAL_TO, std::move(param_expr), make_unique<ValueExpr>(Value(1)));
+  PredicatePhysicalOperator predicate(std::move(cmp_expr));
+  predicate.add_child(make_unique<RowsPhysicalOperator>(3, PhysicalOperatorType::TABLE_SCAN));
+  ASSERT_EQ(3, count_rows(predicate));
+
+  // 绑定新的参数值之后重新执行同一个计划
+  params[0] = Value(2);
+  ASSERT_EQ(0, count_rows(predicate));
+  params[0] = Value(1);
+  ASSERT_EQ(3, count_rows(predicate));
+
+  // 不支持的类型转换在生成计划时就报错，参数保持原来的类型
+  ParamExpr int_param(0, &params);
+  ASSERT_NE(RC::SUCCESS, int_param.cast_to(AttrType::CHARS));
+  ASSERT_EQ(AttrType::INTS, int_param.value_type());
+  Value value;
+  params[0] = Value(7);
+  ASSERT_EQ(RC::SUCCESS, int_param.try_get_value(value));
+  ASSERT_EQ(7, value.get_int());
+}
+
+TEST(PlanCache, lru)
+{
+  PlanCache cache(2);
+  cache.put(make_plan("a"));
+  cache.put(make_plan("b"));
+  ASSERT_EQ(2, static_cast<int>(cache.size()));
+
+  // 取出后缓存中就没有了，放回后成为最近使用的
+  unique_ptr<CachedPlan> plan = cache.take("a");
+  ASSERT_NE(nullptr, plan);
+  ASSERT_EQ(nullptr, cache.take("a"));
+  cache.put(std::move(plan));
+
+  cache.put(make_plan("c"));  // 淘汰 b
+  ASSERT_EQ(2, static_cast<int>(cache.size()));
+  ASSERT_EQ(nullptr, cache.take("b"));
+  ASSERT_NE(nullptr, cache.take("a"));
+  ASSERT_NE(nullptr, cache.take("c"));
+
+  // 包含不能重复执行的算子的计划不缓存
+  cache.put(make_plan("d", PhysicalOperatorType::HASH_GROUP_BY));
+  ASSERT_EQ(0, static_cast<int>(cache.size()));
+
+  // 元数据变化之后旧的计划失效
+  cache.put(make_plan("e"));
+  PlanCache::bump_schema_version();
+  ASSERT_EQ(nullptr, cache.take("e"));
+  ASSERT_EQ(0, static_cast<int>(cache.size()));
+
+  cache.put(make_plan("f"));
+  cache.clear();
+  ASSERT_EQ(nullptr, cache.take("f"));
+}
+
+TEST(PlanCache, prepared_statement)
+{
+  unique_ptr<PreparedStatement> stmt;
+  ASSERT_NE(RC::SUCCESS, PreparedStatement::create(1, "select * from where id = ?;", stmt));
+  ASSERT_NE(RC::SUCCESS, PreparedStatement::create(1, "select * from t; select * from t;", stmt));
+  ASSERT_EQ(RC::SUCCESS, PreparedStatement::create(1, "select * from t where id = ? and name < ?;", stmt));
+  ASSERT_EQ(1u, stmt->id());
+  ASSERT_EQ(2, stmt->param_num());
+
+  // 参数的类型决定了计划的键
+  const string key = PlanCache::make_key(stmt->sql(), {Value(1), Value("a")});
+  ASSERT_NE(key, PlanCache::make_key(stmt->sql(), {Value(1.0f), Value("a")}));
+  ASSERT_EQ(key, PlanCache::make_key(stmt->sql(), {Value(2), Value("b")}));
+
+  unique_ptr<CachedPlan> plan = make_plan(key);
+  plan->statement_id          = stmt->id();
+  stmt->put_plan(std::move(plan));
+  ASSERT_EQ(nullptr, stmt->take_plan(key + "x"));
+  plan = stmt->take_plan(key);
+  ASSERT_NE(nullptr, plan);
+  ASSERT_EQ(nullptr, stmt->take_plan(key));
+
+  // 计划同样受元数据版本的约束
+  stmt->put_plan(std::move(plan));
+  PlanCache::bump_schema_version();
+  ASSERT_EQ(nullptr, stmt->take_plan(key));
+
+  stmt->put_plan(make_plan(key, PhysicalOperatorType::HASH_GROUP_BY));
+  ASSERT_EQ(nullptr, stmt->take_plan(key));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,8 @@ See the Mulan PSL v2 for more details. */
 #include <string.h>
 #include <sstream>
 #include <filesystem>
+#include <unordered_set>
+#include <thread>
 #include <utility>
 
 #include "storage/buffer/disk_buffer_pool.h"
@@ -199,6 +201,24 @@ TEST(RecordFileScanner, test_record_file_iterator)
 
   file_scanner.close_scan();
   ASSERT_EQ(count, rids.size() / 2);
+  ASSERT_EQ(record_insert_num, file_handler.inserted_record_count());
+  ASSERT_EQ(record_insert_num / 2, file_handler.deleted_record_count());
+
+  // 按页面采样，每个页面要么被访问，要么被跳过
+  rc = file_scanner.open_scan(
+      nullptr /*table*/, *bp, &trx, log_handler, ReadWriteMode::READ_ONLY, nullptr /*condition_filter*/);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  file_scanner.set_page_sample(0.01, 1);
+
+  count = 0;
+  while (OB_SUCC(rc = file_scanner.next(record))) {
+    count++;
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(bp->allocated_pages() - 1 - bp->free_space_map_page_count(), file_scanner.scanned_page_count() + file_scanner.skipped_page_count());
+  ASSERT_GT(file_scanner.skipped_page_count(), 0);
+  ASSERT_LT(count, rids.size() / 2);
+  file_scanner.close_scan();
 
   bpm->close_file(record_manager_file);
   delete bpm;
@@ -355,6 +375,253 @@ TEST(RecordManager, durability)
   bpm2.close_file(record_manager_file.c_str());
 }
 
+TEST(RecordManager, batch_insert_durability)
+{
+  /*
+   * 测试场景：
+   * 1. 批量插入记录，记录跨越多个页面
+   * 2. 重启数据库，从批量插入的日志中恢复记录
+   */
+  filesystem::path directory("record_manager_batch_insert");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+
+  filesystem::path record_manager_file = directory / "record_manager.bp";
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(bpm.init(make_unique<VacuousDoubleWriteBuffer>()), RC::SUCCESS);
+
+  DiskLogHandler        log_handler;
+  IntegratedLogReplayer log_replayer(bpm);
+  ASSERT_EQ(log_handler.init(directory.c_str()), RC::SUCCESS);
+  ASSERT_EQ(log_handler.replay(log_replayer, 0), RC::SUCCESS);
+  ASSERT_EQ(log_handler.start(), RC::SUCCESS);
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(bpm.create_file(record_manager_file.c_str()), RC::SUCCESS);
+  ASSERT_EQ(bpm.open_file(log_handler, record_manager_file.c_str(), buffer_pool), RC::SUCCESS);
+
+  RecordFileHandler record_file_handler(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(record_file_handler.init(*buffer_pool, log_handler, nullptr), RC::SUCCESS);
+
+  const int record_size = 100;
+  const int batch_num   = 4;
+  const int batch_size  = 300;  // 一个页面放不下一批记录
+
+  vector<string> records;
+  vector<RID>    all_rids;
+  for (int batch = 0; batch < batch_num; batch++) {
+    vector<const char *> datas;
+    for (int i = 0; i < batch_size; i++) {
+      string record = "record " + to_string(batch * batch_size + i);
+      record.resize(record_size);
+      records.push_back(std::move(record));
+    }
+    for (int i = batch * batch_size; i < static_cast<int>(records.size()); i++) {
+      datas.push_back(records[i].data());
+    }
+
+    vector<RID> rids;
+    ASSERT_EQ(record_file_handler.insert_records(datas, record_size, rids), RC::SUCCESS);
+    ASSERT_EQ(static_cast<int>(rids.size()), batch_size);
+    all_rids.insert(all_rids.end(), rids.begin(), rids.end());
+  }
+
+  unordered_set<RID, RIDHash> rid_set(all_rids.begin(), all_rids.end());
+  ASSERT_EQ(rid_set.size(), records.size());
+  ASSERT_EQ(record_file_handler.inserted_record_count(), static_cast<int64_t>(records.size()));
+  for (size_t i = 0; i < records.size(); i++) {
+    Record record;
+    ASSERT_EQ(record_file_handler.get_record(all_rids[i], record), RC::SUCCESS);
+    ASSERT_EQ(memcmp(record.data(), records[i].data(), record_size), 0);
+  }
+
+  // 复制出还没有刷盘的文件，只靠日志恢复数据
+  filesystem::path record_manager_file_copy = directory / "record_manager_copy.bp";
+  filesystem::copy_file(record_manager_file, record_manager_file_copy);
+  bpm.close_file(record_manager_file.c_str());
+  filesystem::remove(record_manager_file);
+  ASSERT_EQ(log_handler.stop(), RC::SUCCESS);
+  ASSERT_EQ(log_handler.await_termination(), RC::SUCCESS);
+
+  DiskLogHandler    log_handler2;
+  BufferPoolManager bpm2;
+  ASSERT_EQ(RC::SUCCESS, bpm2.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *buffer_pool2 = nullptr;
+  filesystem::copy(record_manager_file_copy, record_manager_file);
+  ASSERT_EQ(bpm2.open_file(log_handler2, record_manager_file.c_str(), buffer_pool2), RC::SUCCESS);
+
+  IntegratedLogReplayer log_replayer2(bpm2);
+  ASSERT_EQ(log_handler2.init(directory.c_str()), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.replay(log_replayer2, 0), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.start(), RC::SUCCESS);
+
+  RecordFileHandler record_file_handler2(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(record_file_handler2.init(*buffer_pool2, log_handler2, nullptr), RC::SUCCESS);
+  for (size_t i = 0; i < records.size(); i++) {
+    Record record;
+    ASSERT_EQ(record_file_handler2.get_record(all_rids[i], record), RC::SUCCESS);
+    ASSERT_EQ(memcmp(record.data(), records[i].data(), record_size), 0);
+  }
+
+  ASSERT_EQ(log_handler2.stop(), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.await_termination(), RC::SUCCESS);
+  bpm2.close_file(record_manager_file.c_str());
+}
+
+TEST(RecordManager, insert_target_page_per_thread)
+{
+  /*
+   * 测试场景：
+   * 不同的线程插入记录时使用不同的目标页面，同一个线程一直使用自己的页面直到填满
+   * 线程是依次执行的，不依赖 CONCURRENCY 编译选项
+   */
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "record_manager_insert_slot.bp";
+  filesystem::remove(record_manager_file);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(record_manager_file));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, record_manager_file, bp));
+
+  RecordFileHandler file_handler(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, nullptr));
+
+  const int   thread_num        = 4;
+  const int   record_per_thread = 10;
+  char        record_data[20]   = {0};
+  vector<RID> rids[thread_num];
+  for (int i = 0; i < thread_num; i++) {
+    thread inserter([&, i]() {
+      for (int j = 0; j < record_per_thread; j++) {
+        RID rid;
+        ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+        rids[i].push_back(rid);
+      }
+    });
+    inserter.join();
+  }
+
+  unordered_set<PageNum> pages;
+  for (int i = 0; i < thread_num; i++) {
+    ASSERT_EQ(record_per_thread, static_cast<int>(rids[i].size()));
+    for (const RID &rid : rids[i]) {
+      ASSERT_EQ(rids[i].front().page_num, rid.page_num);
+    }
+    pages.insert(rids[i].front().page_num);
+  }
+  ASSERT_EQ(thread_num, static_cast<int>(pages.size()));
+
+  // 重新打开之后，没有填满的页面仍然可以使用
+  file_handler.close();
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, nullptr));
+  RID rid;
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+  ASSERT_EQ(1, static_cast<int>(pages.count(rid.page_num)));
+  ASSERT_EQ(thread_num * record_per_thread + 1, file_handler.inserted_record_count());
+
+  file_handler.close();
+  bpm.close_file(record_manager_file);
+}
+
+TEST(RecordManager, free_space_map_recovery)
+{
+  /*
+   * 测试场景：
+   * 1. 插入记录占满若干页面，删除中间某个页面上的记录
+   * 2. 只靠日志恢复后，空闲空间映射仍然记录着这个页面有空闲空间，新的记录插入到这个页面上
+   */
+  filesystem::path directory("record_manager_free_space_map");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+
+  filesystem::path record_manager_file = directory / "record_manager.bp";
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(bpm.init(make_unique<VacuousDoubleWriteBuffer>()), RC::SUCCESS);
+
+  DiskLogHandler        log_handler;
+  IntegratedLogReplayer log_replayer(bpm);
+  ASSERT_EQ(log_handler.init(directory.c_str()), RC::SUCCESS);
+  ASSERT_EQ(log_handler.replay(log_replayer, 0), RC::SUCCESS);
+  ASSERT_EQ(log_handler.start(), RC::SUCCESS);
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(bpm.create_file(record_manager_file.c_str()), RC::SUCCESS);
+  ASSERT_EQ(bpm.open_file(log_handler, record_manager_file.c_str(), buffer_pool), RC::SUCCESS);
+
+  RecordFileHandler record_file_handler(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(record_file_handler.init(*buffer_pool, log_handler, nullptr), RC::SUCCESS);
+  ASSERT_TRUE(buffer_pool->has_free_space_map());
+
+  const int   record_size = 100;
+  const int   record_num  = 1000;
+  string      record_data(record_size, 'a');
+  vector<RID> rids;
+  for (int i = 0; i < record_num; i++) {
+    RID rid;
+    ASSERT_EQ(record_file_handler.insert_record(record_data.data(), record_size, &rid), RC::SUCCESS);
+    rids.push_back(rid);
+  }
+
+  const PageNum last_page_num = rids.back().page_num;
+  const PageNum hole_page_num = rids.front().page_num + 1;
+  ASSERT_LT(hole_page_num, last_page_num);
+  // 只有最后一个页面有空闲空间
+  ASSERT_EQ(last_page_num, buffer_pool->find_free_space_page());
+
+  int deleted = 0;
+  for (const RID &rid : rids) {
+    if (rid.page_num == hole_page_num && rid.slot_num % 2 == 0) {
+      ASSERT_EQ(record_file_handler.delete_record(&rid), RC::SUCCESS);
+      deleted++;
+    }
+  }
+  ASSERT_GT(deleted, 0);
+  ASSERT_EQ(hole_page_num, buffer_pool->find_free_space_page());
+  ASSERT_GT(buffer_pool->free_space_level(hole_page_num), 0);
+
+  // 复制出还没有刷盘的文件，只靠日志恢复数据和空闲空间映射
+  filesystem::path record_manager_file_copy = directory / "record_manager_copy.bp";
+  filesystem::copy_file(record_manager_file, record_manager_file_copy);
+  bpm.close_file(record_manager_file.c_str());
+  filesystem::remove(record_manager_file);
+  ASSERT_EQ(log_handler.stop(), RC::SUCCESS);
+  ASSERT_EQ(log_handler.await_termination(), RC::SUCCESS);
+
+  DiskLogHandler    log_handler2;
+  BufferPoolManager bpm2;
+  ASSERT_EQ(RC::SUCCESS, bpm2.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *buffer_pool2 = nullptr;
+  filesystem::copy(record_manager_file_copy, record_manager_file);
+  ASSERT_EQ(bpm2.open_file(log_handler2, record_manager_file.c_str(), buffer_pool2), RC::SUCCESS);
+
+  IntegratedLogReplayer log_replayer2(bpm2);
+  ASSERT_EQ(log_handler2.init(directory.c_str()), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.replay(log_replayer2, 0), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.start(), RC::SUCCESS);
+
+  ASSERT_TRUE(buffer_pool2->has_free_space_map());
+  ASSERT_EQ(hole_page_num, buffer_pool2->find_free_space_page());
+
+  RecordFileHandler record_file_handler2(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(record_file_handler2.init(*buffer_pool2, log_handler2, nullptr), RC::SUCCESS);
+  for (int i = 0; i < deleted; i++) {
+    RID rid;
+    ASSERT_EQ(record_file_handler2.insert_record(record_data.data(), record_size, &rid), RC::SUCCESS);
+    ASSERT_EQ(hole_page_num, rid.page_num);
+  }
+  // 空洞填满之后回到最后一个页面
+  ASSERT_EQ(last_page_num, buffer_pool2->find_free_space_page());
+
+  ASSERT_EQ(log_handler2.stop(), RC::SUCCESS);
+  ASSERT_EQ(log_handler2.await_termination(), RC::SUCCESS);
+  bpm2.close_file(record_manager_file.c_str());
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
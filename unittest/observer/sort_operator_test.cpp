@@ -0,0 +1,334 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <random>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "sql/operator/join_physical_operator.h"
+#include "sql/operator/limit_physical_operator.h"
+#include "sql/operator/limit_vec_physical_operator.h"
+#include "sql/operator/sort_physical_operator.h"
+#include "sql/operator/sort_vec_physical_operator.h"
+#include "sql/operator/sorter.h"
+
+using namespace std;
+
+/**
+ * @brief 按行输出固定数据的算子，作为排序算子的子算子
+ */
+class ValueListPhysicalOperator : public PhysicalOperator
+{
+public:
+  ValueListPhysicalOperator(vector<string> names, vector<vector<Value>> rows) : names_(names), rows_(std::move(rows))
+  {
+    vector<TupleCellSpec> specs;
+    for (const string &name : names_) {
+      specs.emplace_back(name.c_str());
+    }
+    tuple_.set_names(specs);
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    index_ = -1;
+    open_count_++;
+    return RC::SUCCESS;
+  }
+  RC next() override
+  {
+    if (++index_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_cells(rows_[index_]);
+    return RC::SUCCESS;
+  }
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+  RC     tuple_schema(TupleSchema &schema) const override
+  {
+    for (const string &name : names_) {
+      schema.append_cell(name.c_str());
+    }
+    return RC::SUCCESS;
+  }
+
+  int open_count() const { return open_count_; }
+
+private:
+  vector<string>        names_;
+  vector<vector<Value>> rows_;
+  ValueListTuple        tuple_;
+  int                   index_      = -1;
+  int                   open_count_ = 0;
+};
+
+/**
+ * @brief 按批输出两列整数的算子，作为向量化排序算子的子算子
+ */
+class IntChunkPhysicalOperator : public PhysicalOperator
+{
+public:
+  IntChunkPhysicalOperator(vector<int> first, vector<int> second, int batch_size)
+      : first_(std::move(first)), second_(std::move(second)), batch_size_(batch_size)
+  {
+    chunk_.add_column(make_unique<Column>(AttrType::INTS, sizeof(int), batch_size_), 0);
+    chunk_.add_column(make_unique<Column>(AttrType::INTS, sizeof(int), batch_size_), 1);
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::TABLE_SCAN_VEC; }
+
+  RC open(Trx *) override
+  {
+    position_ = 0;
+    return RC::SUCCESS;
+  }
+  RC next(Chunk &chunk) override
+  {
+    if (position_ >= first_.size()) {
+      return RC::RECORD_EOF;
+    }
+    chunk_.reset_data();
+    const size_t num = std::min(first_.size() - position_, static_cast<size_t>(batch_size_));
+    chunk_.column(0).append(reinterpret_cast<char *>(&first_[position_]), static_cast<int>(num));
+    chunk_.column(1).append(reinterpret_cast<char *>(&second_[position_]), static_cast<int>(num));
+    position_ += num;
+    return chunk.reference(chunk_);
+  }
+  RC close() override { return RC::SUCCESS; }
+  RC tuple_schema(TupleSchema &schema) const override
+  {
+    schema.append_cell("a");
+    schema.append_cell("b");
+    return RC::SUCCESS;
+  }
+
+private:
+  vector<int> first_;
+  vector<int> second_;
+  int         batch_size_;
+  size_t      position_ = 0;
+  Chunk       chunk_;
+};
+
+static string int_key(int value, bool ascending = true)
+{
+  string key;
+  EXPECT_EQ(RC::SUCCESS, Sorter::append_key(AttrType::INTS, reinterpret_cast<char *>(&value), sizeof(value), ascending, key));
+  return key;
+}
+
+TEST(Sorter, normalized_key)
+{
+  // 整数
+  const int ints[] = {INT32_MIN, -100, -1, 0, 1, 7, 256, INT32_MAX};
+  for (size_t i = 1; i < sizeof(ints) / sizeof(ints[0]); i++) {
+    ASSERT_LT(int_key(ints[i - 1]), int_key(ints[i]));
+    ASSERT_GT(int_key(ints[i - 1], false), int_key(ints[i], false));
+  }
+
+  // 浮点数，-0.0 与 0.0 相等
+  const float floats[] = {-1e10f, -2.5f, -0.5f, 0.0f, 0.25f, 3.0f, 1e10f};
+  auto float_key = [](float value) {
+    string key;
+    EXPECT_EQ(RC::SUCCESS, Sorter::append_key(AttrType::FLOATS, reinterpret_cast<char *>(&value), sizeof(value), true, key));
+    return key;
+  };
+  for (size_t i = 1; i < sizeof(floats) / sizeof(floats[0]); i++) {
+    ASSERT_LT(float_key(floats[i - 1]), float_key(floats[i]));
+  }
+  ASSERT_EQ(float_key(-0.0f), float_key(0.0f));
+
+  // 字符串，短的是长的前缀时排在前面；多个值拼接时前一个值的结束符保证了顺序
+  auto chars_key = [](const char *value, int length, bool ascending) {
+    string key;
+    EXPECT_EQ(RC::SUCCESS, Sorter::append_key(AttrType::CHARS, value, length, ascending, key));
+    return key;
+  };
+  ASSERT_LT(chars_key("ab\0\0", 4, true), chars_key("abc\0", 4, true));
+  ASSERT_LT(chars_key("abc\0", 4, true), chars_key("abd\0", 4, true));
+  ASSERT_GT(chars_key("ab\0\0", 4, false), chars_key("abc\0", 4, false));
+  ASSERT_LT(chars_key("ab", 2, true) + int_key(9), chars_key("abc", 3, true) + int_key(1));
+
+  string key;
+  ASSERT_EQ(RC::UNSUPPORTED, Sorter::append_key(AttrType::UNDEFINED, "", 0, true, key));
+}
+
+/// 添加 row_num 个随机整数，负载是整数本身，检查输出有序并且是最小的 limit 个
+static void check_sorter(int64_t memory_limit, int64_t limit, int row_num, bool expect_spill)
+{
+  vector<int> values(row_num);
+  mt19937     random(row_num);
+  for (int &value : values) {
+    value = uniform_int_distribution<int>(-row_num, row_num)(random);
+  }
+
+  Sorter sorter(memory_limit, limit);
+  for (int value : values) {
+    const string key = int_key(value);
+    ASSERT_EQ(RC::SUCCESS, sorter.add(key.data(), key.size(), reinterpret_cast<char *>(&value), sizeof(value)));
+  }
+  ASSERT_EQ(RC::SUCCESS, sorter.sort());
+  ASSERT_EQ(row_num, sorter.count());
+  ASSERT_EQ(expect_spill, sorter.run_num() > 1);
+
+  std::sort(values.begin(), values.end());
+  if (limit >= 0 && limit < row_num) {
+    values.resize(limit);
+  }
+
+  const char *payload        = nullptr;
+  int         payload_length = 0;
+  for (int expect : values) {
+    ASSERT_EQ(RC::SUCCESS, sorter.next(payload, payload_length));
+    ASSERT_EQ(static_cast<int>(sizeof(int)), payload_length);
+    int value = 0;
+    memcpy(&value, payload, sizeof(value));
+    ASSERT_EQ(expect, value);
+  }
+  ASSERT_EQ(RC::RECORD_EOF, sorter.next(payload, payload_length));
+}
+
+TEST(Sorter, in_memory)
+{
+  check_sorter(64 * 1024 * 1024, -1, 10000, false);
+  check_sorter(64 * 1024 * 1024, -1, 0, false);
+}
+
+TEST(Sorter, external_merge)
+{
+  // 每条数据16个字节，加上排序用的16个字节，64KB 大约能放2000条
+  check_sorter(64 * 1024, -1, 100000, true);
+}
+
+TEST(Sorter, top_n)
+{
+  check_sorter(64 * 1024 * 1024, 10, 100000, false);
+  check_sorter(64 * 1024 * 1024, 0, 1000, false);
+  check_sorter(64 * 1024 * 1024, 100, 50, false);
+  // 堆超过了内存限制，退化成外部排序
+  check_sorter(64 * 1024, 50000, 100000, true);
+}
+
+TEST(SortPhysicalOperator, hidden_column)
+{
+  // select name from t order by score desc, name limit 2 offset 1
+  vector<vector<Value>> rows;
+  rows.push_back({Value("c"), Value(1.5f)});
+  rows.push_back({Value("a"), Value(-2.5f)});
+  rows.push_back({Value("b"), Value(3.0f)});
+  rows.push_back({Value("e"), Value(1.5f)});
+  rows.push_back({Value("d"), Value(-0.5f)});
+  auto child = make_unique<ValueListPhysicalOperator>(vector<string>{"name", "score"}, std::move(rows));
+
+  vector<OrderByUnit> order_by{{1, false}, {0, true}};
+  auto                sort = make_unique<SortPhysicalOperator>(order_by, 1, 3, 64 * 1024 * 1024);
+  sort->add_child(std::move(child));
+  LimitPhysicalOperator limit(2, 1);
+  limit.add_child(std::move(sort));
+
+  TupleSchema schema;
+  ASSERT_EQ(RC::SUCCESS, limit.tuple_schema(schema));
+  ASSERT_EQ(1, schema.cell_num());
+  ASSERT_STREQ("name", schema.cell_at(0).alias());
+
+  ASSERT_EQ(RC::SUCCESS, limit.open(nullptr));
+  vector<string> names;
+  RC             rc = RC::SUCCESS;
+  while (OB_SUCC(rc = limit.next())) {
+    Tuple *tuple = limit.current_tuple();
+    ASSERT_EQ(1, tuple->cell_num());
+    Value value;
+    ASSERT_EQ(RC::SUCCESS, tuple->cell_at(0, value));
+    names.push_back(value.get_string());
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(RC::SUCCESS, limit.close());
+  ASSERT_EQ((vector<string>{"c", "e"}), names);
+}
+
+TEST(SortVecPhysicalOperator, sort_and_limit)
+{
+  // select a from t order by b desc, a：b 是隐藏列
+  const int   row_num = 20000;
+  vector<int> first(row_num), second(row_num);
+  mt19937     random(row_num);
+  for (int i = 0; i < row_num; i++) {
+    first[i]  = uniform_int_distribution<int>(0, row_num)(random);
+    second[i] = uniform_int_distribution<int>(0, 100)(random);
+  }
+
+  vector<pair<int, int>> expect;  // (b, a)
+  for (int i = 0; i < row_num; i++) {
+    expect.emplace_back(-second[i], first[i]);
+  }
+  std::sort(expect.begin(), expect.end());
+
+  for (int64_t limit : {int64_t(-1), int64_t(10), int64_t(9000)}) {
+    const int64_t offset = limit < 0 ? 0 : 5;
+    auto          child  = make_unique<IntChunkPhysicalOperator>(first, second, 4096);
+    vector<OrderByUnit> order_by{{1, false}, {0, true}};
+    auto sort = make_unique<SortVecPhysicalOperator>(order_by, 1, limit < 0 ? -1 : limit + offset, 64 * 1024);
+    sort->add_child(std::move(child));
+    LimitVecPhysicalOperator limit_oper(limit, offset);
+    limit_oper.add_child(std::move(sort));
+
+    ASSERT_EQ(RC::SUCCESS, limit_oper.open(nullptr));
+    vector<int> result;
+    Chunk       chunk;
+    RC          rc = RC::SUCCESS;
+    while (OB_SUCC(rc = limit_oper.next(chunk))) {
+      ASSERT_EQ(1, chunk.column_num());
+      for (int i = 0; i < chunk.rows(); i++) {
+        result.push_back(chunk.get_value(0, i).get_int());
+      }
+    }
+    ASSERT_EQ(RC::RECORD_EOF, rc);
+    ASSERT_EQ(RC::SUCCESS, limit_oper.close());
+
+    const size_t expect_num = limit < 0 ? row_num : limit;
+    ASSERT_EQ(expect_num, result.size());
+    for (size_t i = 0; i < expect_num; i++) {
+      ASSERT_EQ(expect[i + offset].second, result[i]);
+    }
+  }
+}
+
+TEST(NestedLoopJoinPhysicalOperator, push_down_limit)
+{
+  vector<vector<Value>> left_rows, right_rows;
+  for (int i = 0; i < 10; i++) {
+    left_rows.push_back({Value(i)});
+    right_rows.push_back({Value(i * 10)});
+  }
+  auto left  = make_unique<ValueListPhysicalOperator>(vector<string>{"a"}, std::move(left_rows));
+  auto right = make_unique<ValueListPhysicalOperator>(vector<string>{"b"}, std::move(right_rows));
+  ValueListPhysicalOperator *right_ptr = right.get();
+
+  // select * from l, r limit 12：输出12行后直接结束，右表只打开两次
+  NestedLoopJoinPhysicalOperator join;
+  join.add_child(std::move(left));
+  join.add_child(std::move(right));
+  join.push_down_limit(12);
+
+  ASSERT_EQ(RC::SUCCESS, join.open(nullptr));
+  int rows = 0;
+  RC  rc   = RC::SUCCESS;
+  while (OB_SUCC(rc = join.next())) {
+    rows++;
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(12, rows);
+  ASSERT_EQ(2, right_ptr->open_count());
+  ASSERT_EQ(RC::SUCCESS, join.close());
+}
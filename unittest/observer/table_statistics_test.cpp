@@ -0,0 +1,165 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "storage/table/table_meta.h"
+#include "storage/table/table_statistics.h"
+#include "json/json.h"
+
+using namespace std;
+
+class TableStatisticsTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    vector<AttrInfoSqlNode> attributes(2);
+    attributes[0].type   = AttrType::INTS;
+    attributes[0].name   = "id";
+    attributes[0].length = sizeof(int);
+    attributes[1].type   = AttrType::CHARS;
+    attributes[1].name   = "name";
+    attributes[1].length = 8;
+    ASSERT_EQ(RC::SUCCESS, table_meta_.init(1, "t", nullptr, attributes, StorageFormat::ROW_FORMAT));
+  }
+
+  /// 插入 rows 行，id 从0开始递增，name 有 name_ndv 个不同的值
+  void add_records(StatisticsCollector &collector, int rows, int name_ndv)
+  {
+    vector<char> record(table_meta_.record_size());
+    for (int i = 0; i < rows; i++) {
+      memset(record.data(), 0, record.size());
+      memcpy(record.data() + table_meta_.field("id")->offset(), &i, sizeof(i));
+      snprintf(record.data() + table_meta_.field("name")->offset(), 8, "n%d", i % name_ndv);
+      collector.add_record(record.data());
+    }
+  }
+
+protected:
+  TableMeta table_meta_;
+};
+
+TEST_F(TableStatisticsTest, collect)
+{
+  // 保留的样本比行数少，直方图根据样本生成
+  StatisticsCollector collector(table_meta_, 2000 /*sample_rows*/, 10 /*bucket_num*/);
+  add_records(collector, 10000, 50);
+  ASSERT_EQ(10000, collector.row_count());
+
+  TableStatistics statistics;
+  collector.finish(collector.row_count(), 20, statistics);
+  ASSERT_EQ(10000, statistics.row_count);
+  ASSERT_EQ(20, statistics.page_count);
+  ASSERT_EQ(2, static_cast<int>(statistics.columns.size()));
+  ASSERT_EQ(nullptr, statistics.column("__trx_xid_begin"));
+
+  const ColumnStatistics *id = statistics.column("id");
+  ASSERT_NE(nullptr, id);
+  ASSERT_EQ(AttrType::INTS, id->type);
+  ASSERT_NEAR(10000, id->ndv, 500);
+  ASSERT_EQ(10, id->bucket_num());
+  ASSERT_DOUBLE_EQ(0, id->null_fraction);
+
+  // 直方图在桶内插值
+  ASSERT_NEAR(0.5, id->selectivity(LESS_THAN, Value(5000)), 0.05);
+  ASSERT_NEAR(0.9, id->selectivity(GREAT_EQUAL, Value(1000)), 0.05);
+  ASSERT_NEAR(1.0 / id->ndv, id->selectivity(EQUAL_TO, Value(123)), 1e-9);
+
+  // 超出最小值和最大值的范围
+  ASSERT_DOUBLE_EQ(0, id->selectivity(EQUAL_TO, Value(20000)));
+  ASSERT_DOUBLE_EQ(0, id->selectivity(LESS_THAN, Value(-1)));
+  ASSERT_DOUBLE_EQ(1, id->selectivity(LESS_EQUAL, Value(20000)));
+  ASSERT_DOUBLE_EQ(1, id->selectivity(NOT_EQUAL, Value(20000)));
+
+  const ColumnStatistics *name = statistics.column("name");
+  ASSERT_NE(nullptr, name);
+  ASSERT_NEAR(50, name->ndv, 2);  // HyperLogLog 的估算有误差
+  ASSERT_DOUBLE_EQ(1.0 / name->ndv, name->selectivity(EQUAL_TO, Value("n7")));
+  ASSERT_DOUBLE_EQ(0, name->selectivity(EQUAL_TO, Value("z")));
+
+  // 一半的行都是同一个值时，这个值是多个桶的上界
+  ColumnStatistics skewed;
+  skewed.type      = AttrType::INTS;
+  skewed.ndv       = 1000;
+  skewed.histogram = {Value(0), Value(1), Value(1), Value(1), Value(500), Value(1000)};
+  ASSERT_DOUBLE_EQ(0.4, skewed.selectivity(EQUAL_TO, Value(1)));
+  ASSERT_DOUBLE_EQ(0.001, skewed.selectivity(EQUAL_TO, Value(2)));
+}
+
+TEST_F(TableStatisticsTest, sample_ndv)
+{
+  // 按页面采样了十分之一的行，值几乎都不相同的字段按比例放大NDV，其它字段认为已经看到了所有的值
+  StatisticsCollector collector(table_meta_);
+  add_records(collector, 1000, 10);
+
+  TableStatistics statistics;
+  collector.finish(10000, 100, statistics);
+  ASSERT_EQ(10000, statistics.row_count);
+  ASSERT_NEAR(10000, statistics.column("id")->ndv, 500);
+  ASSERT_EQ(10, statistics.column("name")->ndv);
+
+  // 空表
+  StatisticsCollector empty_collector(table_meta_);
+  TableStatistics     empty_statistics;
+  empty_collector.finish(0, 0, empty_statistics);
+  ASSERT_EQ(0, empty_statistics.row_count);
+  ASSERT_EQ(0, empty_statistics.column("id")->ndv);
+  ASSERT_EQ(0, empty_statistics.column("id")->bucket_num());
+  ASSERT_DOUBLE_EQ(0, empty_statistics.column("id")->selectivity(EQUAL_TO, Value(1)));
+}
+
+TEST_F(TableStatisticsTest, serialize)
+{
+  StatisticsCollector collector(table_meta_, 100, 4);
+  add_records(collector, 100, 5);
+
+  auto statistics = make_shared<TableStatistics>();
+  collector.finish(100, 1, *statistics);
+
+  // 统计信息跟随表的元数据一起保存
+  table_meta_.set_statistics(statistics);
+  stringstream ss;
+  ASSERT_GT(table_meta_.serialize(ss), 0);
+
+  TableMeta loaded_meta;
+  ASSERT_GT(loaded_meta.deserialize(ss), 0);
+  const shared_ptr<const TableStatistics> &loaded = loaded_meta.statistics();
+  ASSERT_NE(nullptr, loaded);
+  ASSERT_EQ(statistics->row_count, loaded->row_count);
+  ASSERT_EQ(statistics->page_count, loaded->page_count);
+  ASSERT_EQ(statistics->columns.size(), loaded->columns.size());
+  for (size_t i = 0; i < statistics->columns.size(); i++) {
+    const ColumnStatistics &expected = statistics->columns[i];
+    const ColumnStatistics &actual   = loaded->columns[i];
+    ASSERT_EQ(expected.field_name, actual.field_name);
+    ASSERT_EQ(expected.type, actual.type);
+    ASSERT_EQ(expected.ndv, actual.ndv);
+    ASSERT_EQ(expected.histogram.size(), actual.histogram.size());
+    for (size_t j = 0; j < expected.histogram.size(); j++) {
+      ASSERT_EQ(0, expected.histogram[j].compare(actual.histogram[j]));
+    }
+  }
+
+  // 没有统计信息的元数据仍然可以加载
+  TableMeta    meta_without_statistics;
+  stringstream ss2;
+  table_meta_.set_statistics(nullptr);
+  ASSERT_GT(table_meta_.serialize(ss2), 0);
+  ASSERT_GT(meta_without_statistics.deserialize(ss2), 0);
+  ASSERT_EQ(nullptr, meta_without_statistics.statistics());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,275 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <map>
+
+#include "gtest/gtest.h"
+#include "storage/db/db.h"
+#include "storage/index/index.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 表 t(id int, score int, name char(8))，score 上有索引
+ * @details 参数是事务模型，vacuous 原地修改，mvcc 修改别人可见的数据时生成新版本
+ */
+class UpdateTest : public testing::TestWithParam<const char *>
+{
+public:
+  static constexpr int ROW_NUM = 10;
+
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), GetParam(), "vacuous"));
+
+    AttrInfoSqlNode attr_infos[3];
+    attr_infos[0].name   = "id";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = sizeof(int);
+    attr_infos[1].name   = "score";
+    attr_infos[1].type   = AttrType::INTS;
+    attr_infos[1].length = sizeof(int);
+    attr_infos[2].name   = "name";
+    attr_infos[2].type   = AttrType::CHARS;
+    attr_infos[2].length = 8;
+    ASSERT_EQ(RC::SUCCESS, db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 3)));
+    table_ = db_->find_table("t");
+
+    Trx *trx = create_trx();
+    ASSERT_EQ(RC::SUCCESS,
+        table_->create_index(trx, table_->table_meta().field("score"), "i_score", IndexType::BPLUS_TREE, 1.0f));
+    index_ = table_->find_index("i_score");
+    ASSERT_NE(nullptr, index_);
+
+    for (int i = 0; i < ROW_NUM; i++) {
+      Value  values[3] = {Value(i), Value(i * 10), Value("name")};
+      Record record;
+      ASSERT_EQ(RC::SUCCESS, table_->make_record(3, values, record));
+      ASSERT_EQ(RC::SUCCESS, trx->insert_record(table_, record));
+      rids_.push_back(record.rid());
+    }
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    db_->trx_kit().destroy_trx(trx);
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  Trx *create_trx()
+  {
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    EXPECT_EQ(RC::SUCCESS, trx->start_if_need());
+    return trx;
+  }
+
+  int get_int(const Record &record, const char *field_name)
+  {
+    int value = 0;
+    memcpy(&value, record.data() + table_->table_meta().field(field_name)->offset(), sizeof(value));
+    return value;
+  }
+
+  /// 按照 UPDATE 算子的方式生成修改后的记录
+  void set_int(const Record &old_record, const char *field_name, int value, Record &new_record)
+  {
+    new_record.copy_data(old_record.data(), old_record.len());
+    new_record.set_rid(old_record.rid());
+    ASSERT_EQ(RC::SUCCESS, table_->set_value_to_record(new_record.data(), Value(value), table_->table_meta().field(field_name)));
+  }
+
+  /// 事务可见的数据，id -> score
+  map<int, int> visible_rows(Trx *trx)
+  {
+    map<int, int>     rows;
+    RecordFileScanner scanner;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY));
+    Record record;
+    while (OB_SUCC(scanner.next(record))) {
+      rows[get_int(record, "id")] = get_int(record, "score");
+    }
+    scanner.close_scan();
+    return rows;
+  }
+
+  /// 在索引上查找 score，返回找到的记录位置
+  vector<RID> lookup(int score)
+  {
+    const char            *key = reinterpret_cast<const char *>(&score);
+    vector<pair<int, RID>> entries;
+    EXPECT_EQ(RC::SUCCESS, index_->get_entries(span<const char *const>(&key, 1), sizeof(score), entries));
+    vector<RID> rids;
+    for (const auto &entry : entries) {
+      rids.push_back(entry.second);
+    }
+    return rids;
+  }
+
+  /// 读出一条记录，内容复制出来
+  Record read(const RID &rid)
+  {
+    Record record;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record(rid, record));
+    Record copy;
+    copy.copy_data(record.data(), record.len());
+    copy.set_rid(rid);
+    return copy;
+  }
+
+protected:
+  filesystem::path test_directory_{"update_test"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+  Index           *index_ = nullptr;
+  vector<RID>      rids_;
+};
+
+TEST_P(UpdateTest, update_indexed_field)
+{
+  Trx   *trx        = create_trx();
+  Record old_record = read(rids_[3]);
+  Record new_record;
+  set_int(old_record, "score", 1000, new_record);
+  ASSERT_EQ(RC::SUCCESS, trx->update_record(table_, old_record, new_record));
+
+  // 当前事务看到新的值，旧值已经不能通过索引找到新版本
+  ASSERT_EQ(1000, visible_rows(trx)[3]);
+  ASSERT_EQ(vector<RID>{new_record.rid()}, lookup(1000));
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  db_->trx_kit().destroy_trx(trx);
+
+  Trx          *reader = create_trx();
+  map<int, int> rows   = visible_rows(reader);
+  ASSERT_EQ(ROW_NUM, static_cast<int>(rows.size()));
+  ASSERT_EQ(1000, rows[3]);
+  ASSERT_EQ(40, rows[4]);
+  db_->trx_kit().destroy_trx(reader);
+}
+
+TEST_P(UpdateTest, update_own_insert_in_place)
+{
+  // 修改当前事务自己插入的数据，两种事务模型都是原地修改
+  Trx   *trx       = create_trx();
+  Value  values[3] = {Value(100), Value(1), Value("new")};
+  Record record;
+  ASSERT_EQ(RC::SUCCESS, table_->make_record(3, values, record));
+  ASSERT_EQ(RC::SUCCESS, trx->insert_record(table_, record));
+
+  Record old_record = read(record.rid());
+  Record new_record;
+  set_int(old_record, "score", 2, new_record);
+  ASSERT_EQ(RC::SUCCESS, trx->update_record(table_, old_record, new_record));
+  ASSERT_EQ(record.rid(), new_record.rid());
+  ASSERT_EQ(2, get_int(read(record.rid()), "score"));
+  ASSERT_TRUE(lookup(1).empty());
+  ASSERT_EQ(vector<RID>{record.rid()}, lookup(2));
+
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  db_->trx_kit().destroy_trx(trx);
+}
+
+INSTANTIATE_TEST_SUITE_P(TrxKits, UpdateTest, testing::Values("vacuous", "mvcc"));
+
+using VacuousUpdateTest = UpdateTest;
+
+TEST_P(VacuousUpdateTest, update_in_place)
+{
+  Trx *trx = create_trx();
+
+  // 没有修改索引字段，索引不变
+  Record old_record = read(rids_[5]);
+  Record new_record;
+  set_int(old_record, "id", 500, new_record);
+  ASSERT_EQ(RC::SUCCESS, trx->update_record(table_, old_record, new_record));
+  ASSERT_EQ(rids_[5], new_record.rid());
+  ASSERT_EQ(500, get_int(read(rids_[5]), "id"));
+  ASSERT_EQ(vector<RID>{rids_[5]}, lookup(50));
+
+  // 修改索引字段，只替换这条记录的索引项
+  old_record = read(rids_[5]);
+  set_int(old_record, "score", 55, new_record);
+  ASSERT_EQ(RC::SUCCESS, trx->update_record(table_, old_record, new_record));
+  ASSERT_EQ(rids_[5], new_record.rid());
+  ASSERT_TRUE(lookup(50).empty());
+  ASSERT_EQ(vector<RID>{rids_[5]}, lookup(55));
+  ASSERT_EQ(vector<RID>{rids_[6]}, lookup(60));
+  ASSERT_EQ(ROW_NUM, static_cast<int>(visible_rows(trx).size()));
+  db_->trx_kit().destroy_trx(trx);
+}
+
+INSTANTIATE_TEST_SUITE_P(Vacuous, VacuousUpdateTest, testing::Values("vacuous"));
+
+using MvccUpdateTest = UpdateTest;
+
+TEST_P(MvccUpdateTest, new_version_visibility)
+{
+  Trx *reader  = create_trx();
+  Trx *updater = create_trx();
+
+  Record old_record = read(rids_[2]);
+  Record new_record;
+  set_int(old_record, "score", 21, new_record);
+  ASSERT_EQ(RC::SUCCESS, updater->update_record(table_, old_record, new_record));
+  ASSERT_NE(rids_[2], new_record.rid());
+
+  // 没有提交时，其它事务看到的还是旧版本
+  ASSERT_EQ(21, visible_rows(updater)[2]);
+  ASSERT_EQ(20, visible_rows(reader)[2]);
+  ASSERT_EQ(ROW_NUM, static_cast<int>(visible_rows(reader).size()));
+
+  ASSERT_EQ(RC::SUCCESS, updater->commit());
+
+  // 提交之前开始的事务仍然看到旧版本，之后开始的事务看到新版本
+  ASSERT_EQ(20, visible_rows(reader)[2]);
+  Trx *new_reader = create_trx();
+  ASSERT_EQ(21, visible_rows(new_reader)[2]);
+  ASSERT_EQ(ROW_NUM, static_cast<int>(visible_rows(new_reader).size()));
+
+  db_->trx_kit().destroy_trx(reader);
+  db_->trx_kit().destroy_trx(updater);
+  db_->trx_kit().destroy_trx(new_reader);
+}
+
+TEST_P(MvccUpdateTest, rollback)
+{
+  Trx   *trx        = create_trx();
+  Record old_record = read(rids_[7]);
+  Record new_record;
+  set_int(old_record, "score", 77, new_record);
+  ASSERT_EQ(RC::SUCCESS, trx->update_record(table_, old_record, new_record));
+  ASSERT_EQ(RC::SUCCESS, trx->rollback());
+  db_->trx_kit().destroy_trx(trx);
+
+  // 新版本被删除，旧版本恢复可见
+  ASSERT_TRUE(lookup(77).empty());
+  Trx          *reader = create_trx();
+  map<int, int> rows   = visible_rows(reader);
+  ASSERT_EQ(ROW_NUM, static_cast<int>(rows.size()));
+  ASSERT_EQ(70, rows[7]);
+  db_->trx_kit().destroy_trx(reader);
+}
+
+INSTANTIATE_TEST_SUITE_P(Mvcc, MvccUpdateTest, testing::Values("mvcc"));
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
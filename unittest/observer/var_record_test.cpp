@@ -0,0 +1,506 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <map>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/integrated_log_replayer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/common/chunk.h"
+#include "storage/db/db.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+namespace {
+
+/// 表 t(id int, name char(len))，没有事务字段
+void init_table_meta(TableMeta &table_meta, int name_len)
+{
+  AttrInfoSqlNode attr_infos[2];
+  attr_infos[0].name   = "id";
+  attr_infos[0].type   = AttrType::INTS;
+  attr_infos[0].length = sizeof(int);
+  attr_infos[1].name   = "name";
+  attr_infos[1].type   = AttrType::CHARS;
+  attr_infos[1].length = name_len;
+  ASSERT_EQ(RC::SUCCESS,
+      table_meta.init(1, "t", nullptr, span<const AttrInfoSqlNode>(attr_infos, 2), StorageFormat::VAR_ROW_FORMAT));
+}
+
+/// 按照表 t 的格式生成一条记录
+string make_record(const TableMeta &table_meta, int id, const string &name)
+{
+  string record(table_meta.record_size(), '\0');
+  memcpy(record.data() + table_meta.field("id")->offset(), &id, sizeof(id));
+  memcpy(record.data() + table_meta.field("name")->offset(), name.data(), name.size());
+  return record;
+}
+
+string get_name(const TableMeta &table_meta, const Record &record)
+{
+  const FieldMeta *field = table_meta.field("name");
+  const char      *data  = record.data() + field->offset();
+  return string(data, strnlen(data, field->len()));
+}
+
+}  // namespace
+
+class VarRecordPageTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    ::remove(file_name_);
+    bpm_ = make_unique<BufferPoolManager>();
+    ASSERT_EQ(RC::SUCCESS, bpm_->init(make_unique<VacuousDoubleWriteBuffer>()));
+    ASSERT_EQ(RC::SUCCESS, bpm_->create_file(file_name_));
+    ASSERT_EQ(RC::SUCCESS, bpm_->open_file(log_handler_, file_name_, buffer_pool_));
+  }
+
+  void TearDown() override
+  {
+    handler_.reset();
+    bpm_->close_file(file_name_);
+    bpm_.reset();
+    ::remove(file_name_);
+  }
+
+protected:
+  void init_page(int name_len)
+  {
+    init_table_meta(table_meta_, name_len);
+    handler_ = make_unique<VarRecordPageHandler>(&table_meta_);
+
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool_->allocate_page(&frame));
+    page_num_ = frame->page_num();
+    ASSERT_EQ(RC::SUCCESS,
+        handler_->init_empty_page(*buffer_pool_, log_handler_, page_num_, table_meta_.record_size(), &table_meta_));
+    frame->unpin();
+  }
+
+  string read_name(const RID &rid)
+  {
+    Record record;
+    EXPECT_EQ(RC::SUCCESS, handler_->get_record(rid, record));
+    return get_name(table_meta_, record);
+  }
+
+protected:
+  const char                      *file_name_ = "var_record_test.bp";
+  VacuousLogHandler                log_handler_;
+  unique_ptr<BufferPoolManager>    bpm_;
+  DiskBufferPool                  *buffer_pool_ = nullptr;
+  TableMeta                        table_meta_;
+  unique_ptr<VarRecordPageHandler> handler_;
+  PageNum                          page_num_ = BP_INVALID_PAGE_NUM;
+};
+
+TEST_F(VarRecordPageTest, insert_get_delete)
+{
+  init_page(100);
+
+  // 定长格式下一个页面只能放 BP_PAGE_DATA_SIZE / 104 条记录，短字符串只占用实际的长度
+  vector<RID> rids;
+  for (int i = 0;; i++) {
+    string record = make_record(table_meta_, i, "name" + to_string(i));
+    RID    rid;
+    RC     rc = handler_->insert_record(record.data(), &rid);
+    if (rc == RC::RECORD_NOMEM) {
+      break;
+    }
+    ASSERT_EQ(RC::SUCCESS, rc);
+    rids.push_back(rid);
+  }
+  ASSERT_GT(static_cast<int>(rids.size()), 4 * BP_PAGE_DATA_SIZE / table_meta_.record_size());
+  ASSERT_TRUE(handler_->is_full());
+  ASSERT_EQ(0, handler_->free_space_level());
+
+  for (int i = 0; i < static_cast<int>(rids.size()); i++) {
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, handler_->get_record(rids[i], record));
+    ASSERT_EQ(i, *reinterpret_cast<const int *>(record.data() + table_meta_.field("id")->offset()));
+    ASSERT_EQ("name" + to_string(i), get_name(table_meta_, record));
+  }
+
+  // 删除一半的记录，空洞在插入时通过整理页面回收
+  const int free_before = handler_->free_space();
+  for (size_t i = 0; i < rids.size(); i += 2) {
+    ASSERT_EQ(RC::SUCCESS, handler_->delete_record(&rids[i]));
+  }
+  ASSERT_EQ(RC::RECORD_NOT_EXIST, handler_->delete_record(&rids[0]));
+  ASSERT_GT(handler_->free_space(), free_before);
+  ASSERT_FALSE(handler_->is_full());
+
+  string long_name(90, 'x');
+  string record = make_record(table_meta_, -1, long_name);
+  RID    rid;
+  ASSERT_EQ(RC::SUCCESS, handler_->insert_record(record.data(), &rid));
+  ASSERT_EQ(long_name, read_name(rid));
+  for (size_t i = 1; i < rids.size(); i += 2) {
+    ASSERT_EQ("name" + to_string(i), read_name(rids[i]));
+  }
+}
+
+TEST_F(VarRecordPageTest, update_grow_and_shrink)
+{
+  init_page(200);
+
+  vector<RID> rids(10);
+  for (int i = 0; i < 10; i++) {
+    string record = make_record(table_meta_, i, "a");
+    ASSERT_EQ(RC::SUCCESS, handler_->insert_record(record.data(), &rids[i]));
+  }
+
+  // 变长以后换一个位置存放，槽位号不变
+  string long_name(150, 'b');
+  string record = make_record(table_meta_, 3, long_name);
+  ASSERT_EQ(RC::SUCCESS, handler_->update_record(rids[3], record.data()));
+  ASSERT_EQ(long_name, read_name(rids[3]));
+
+  record = make_record(table_meta_, 3, "c");
+  ASSERT_EQ(RC::SUCCESS, handler_->update_record(rids[3], record.data()));
+  ASSERT_EQ("c", read_name(rids[3]));
+  for (int i = 0; i < 10; i++) {
+    if (i != 3) {
+      ASSERT_EQ("a", read_name(rids[i]));
+    }
+  }
+
+  // 反复修改留下的空洞会被回收，页面不会被填满
+  for (int i = 0; i < 1000; i++) {
+    record = make_record(table_meta_, 5, string(100 + i % 100, 'd'));
+    ASSERT_EQ(RC::SUCCESS, handler_->update_record(rids[5], record.data()));
+  }
+  ASSERT_EQ(string(199, 'd'), read_name(rids[5]));
+  ASSERT_FALSE(handler_->is_full());
+}
+
+TEST_F(VarRecordPageTest, overflow)
+{
+  init_page(10000);
+
+  const int allocated = buffer_pool_->allocated_pages();
+  string    body(3000, 'o');
+  for (int i = 0; i < 3000; i++) {
+    body[i] = 'a' + i % 26;
+  }
+  string record = make_record(table_meta_, 1, body);
+  RID    rid;
+  ASSERT_EQ(RC::SUCCESS, handler_->insert_record(record.data(), &rid));
+  ASSERT_EQ(allocated + 1, buffer_pool_->allocated_pages());
+  ASSERT_EQ(body, read_name(rid));
+
+  // 页面中只保留了定长字段和溢出页面的位置
+  ASSERT_LT(handler_->used_space(), 32);
+
+  // 只修改定长字段时沿用原来的溢出页面
+  record = make_record(table_meta_, 2, body);
+  ASSERT_EQ(RC::SUCCESS, handler_->update_record(rid, record.data()));
+  ASSERT_EQ(allocated + 1, buffer_pool_->allocated_pages());
+  Record result;
+  ASSERT_EQ(RC::SUCCESS, handler_->get_record(rid, result));
+  ASSERT_EQ(2, *reinterpret_cast<const int *>(result.data() + table_meta_.field("id")->offset()));
+  ASSERT_EQ(body, get_name(table_meta_, result));
+
+  // 超过一个溢出页面的数据
+  string long_body(9999, 'z');
+  long_body[0] = 'y';
+  record       = make_record(table_meta_, 3, long_body);
+  RID rid2;
+  ASSERT_EQ(RC::SUCCESS, handler_->insert_record(record.data(), &rid2));
+  ASSERT_EQ(allocated + 3, buffer_pool_->allocated_pages());
+  ASSERT_EQ(long_body, read_name(rid2));
+
+  // 变短以后放回页面中，溢出页面被释放
+  record = make_record(table_meta_, 2, "short");
+  ASSERT_EQ(RC::SUCCESS, handler_->update_record(rid, record.data()));
+  ASSERT_EQ("short", read_name(rid));
+  ASSERT_EQ(RC::SUCCESS, handler_->delete_record(&rid2));
+  ASSERT_EQ(allocated, buffer_pool_->allocated_pages());
+}
+
+TEST(VarRecordFile, durability)
+{
+  /*
+   * 测试场景：
+   * 1. 插入、修改、删除一些记录，包括放在溢出页面中的记录
+   * 2. 用还没有刷盘的文件和日志恢复，检查记录是否恢复
+   */
+  filesystem::path directory("var_record_durability");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+  filesystem::path file = directory / "var_record.bp";
+
+  TableMeta table_meta;
+  init_table_meta(table_meta, 4000);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskLogHandler        log_handler;
+  IntegratedLogReplayer log_replayer(bpm);
+  ASSERT_EQ(RC::SUCCESS, log_handler.init(directory.c_str()));
+  ASSERT_EQ(RC::SUCCESS, log_handler.replay(log_replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler.start());
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file.c_str()));
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, file.c_str(), buffer_pool));
+  RecordFileHandler record_file_handler(StorageFormat::VAR_ROW_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, record_file_handler.init(*buffer_pool, log_handler, &table_meta));
+
+  // 每 7 条记录中有一条放在溢出页面中
+  unordered_map<RID, string, RIDHash> expected;
+  vector<RID>      rids;
+  for (int i = 0; i < 700; i++) {
+    string name   = i % 7 == 0 ? string(1000 + i, 'a' + i % 26) : "name" + to_string(i);
+    string record = make_record(table_meta, i, name);
+    RID    rid;
+    ASSERT_EQ(RC::SUCCESS, record_file_handler.insert_record(record.data(), record.size(), &rid));
+    expected[rid] = name;
+    rids.push_back(rid);
+  }
+  for (int i = 0; i < 700; i += 3) {
+    string name = i % 2 == 0 ? "updated" + to_string(i) : string(2000, 'u');
+    ASSERT_EQ(RC::SUCCESS, record_file_handler.visit_record(rids[i], [&](Record &record) {
+      memset(record.data() + table_meta.field("name")->offset(), 0, table_meta.field("name")->len());
+      memcpy(record.data() + table_meta.field("name")->offset(), name.data(), name.size());
+      return true;
+    }));
+    expected[rids[i]] = name;
+  }
+  for (int i = 1; i < 700; i += 5) {
+    ASSERT_EQ(RC::SUCCESS, record_file_handler.delete_record(&rids[i]));
+    expected.erase(rids[i]);
+  }
+
+  // 复制出还没有刷盘的文件，只靠日志恢复数据
+  filesystem::path file_copy = directory / "var_record_copy.bp";
+  filesystem::copy_file(file, file_copy);
+  record_file_handler.close();
+  bpm.close_file(file.c_str());
+  filesystem::remove(file);
+  ASSERT_EQ(RC::SUCCESS, log_handler.stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler.await_termination());
+
+  DiskLogHandler    log_handler2;
+  BufferPoolManager bpm2;
+  ASSERT_EQ(RC::SUCCESS, bpm2.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *buffer_pool2 = nullptr;
+  filesystem::copy(file_copy, file);
+  ASSERT_EQ(RC::SUCCESS, bpm2.open_file(log_handler2, file.c_str(), buffer_pool2));
+
+  IntegratedLogReplayer log_replayer2(bpm2);
+  ASSERT_EQ(RC::SUCCESS, log_handler2.init(directory.c_str()));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.replay(log_replayer2, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.start());
+
+  RecordFileHandler record_file_handler2(StorageFormat::VAR_ROW_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, record_file_handler2.init(*buffer_pool2, log_handler2, &table_meta));
+  for (const auto &[rid, name] : expected) {
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, record_file_handler2.get_record(rid, record));
+    ASSERT_EQ(name, get_name(table_meta, record));
+  }
+
+  RecordFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, scanner.open_scan(nullptr, *buffer_pool2, nullptr, log_handler2, ReadWriteMode::READ_ONLY, nullptr));
+  int    count = 0;
+  Record record;
+  while (OB_SUCC(scanner.next(record))) {
+    count++;
+  }
+  scanner.close_scan();
+  ASSERT_EQ(static_cast<int>(expected.size()), count);
+
+  record_file_handler2.close();
+  ASSERT_EQ(RC::SUCCESS, log_handler2.stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler2.await_termination());
+  bpm2.close_file(file.c_str());
+}
+
+/**
+ * @brief 表 t(id int, name varchar(64), body text)，使用 MVCC 事务
+ */
+class VarRecordTableTest : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    filesystem::remove_all(test_directory_);
+    filesystem::create_directories(test_directory_);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("test_db", test_directory_.c_str(), "mvcc", "vacuous"));
+
+    AttrInfoSqlNode attr_infos[3];
+    attr_infos[0].name    = "id";
+    attr_infos[0].type    = AttrType::INTS;
+    attr_infos[0].length  = sizeof(int);
+    attr_infos[1].name    = "name";
+    attr_infos[1].type    = AttrType::CHARS;
+    attr_infos[1].length  = 64;
+    attr_infos[1].var_len = true;
+    attr_infos[2].name    = "body";
+    attr_infos[2].type    = AttrType::CHARS;
+    attr_infos[2].length  = 4096;
+    attr_infos[2].var_len = true;
+    ASSERT_EQ(RC::SUCCESS,
+        db_->create_table("t", span<const AttrInfoSqlNode>(attr_infos, 3), StorageFormat::VAR_ROW_FORMAT));
+    table_ = db_->find_table("t");
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(test_directory_);
+  }
+
+protected:
+  Trx *create_trx()
+  {
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    EXPECT_EQ(RC::SUCCESS, trx->start_if_need());
+    return trx;
+  }
+
+  RC insert(Trx *trx, int id, const string &name, const string &body)
+  {
+    Value  values[3] = {Value(id), Value(name.c_str()), Value(body.c_str())};
+    Record record;
+    RC     rc = table_->make_record(3, values, record);
+    return OB_SUCC(rc) ? trx->insert_record(table_, record) : rc;
+  }
+
+  /// 事务可见的数据，id -> body
+  map<int, string> visible_rows(Trx *trx)
+  {
+    map<int, string>  rows;
+    RecordFileScanner scanner;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY));
+    Record record;
+    while (OB_SUCC(scanner.next(record))) {
+      int id = 0;
+      memcpy(&id, record.data() + table_->table_meta().field("id")->offset(), sizeof(id));
+      const FieldMeta *body = table_->table_meta().field("body");
+      rows[id] = string(record.data() + body->offset(), strnlen(record.data() + body->offset(), body->len()));
+    }
+    scanner.close_scan();
+    return rows;
+  }
+
+protected:
+  filesystem::path test_directory_{"var_record_test"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+};
+
+TEST_F(VarRecordTableTest, mvcc_scan_and_update)
+{
+  Trx *trx = create_trx();
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(RC::SUCCESS, insert(trx, i, "name" + to_string(i), i % 10 == 0 ? string(3000, 'x') : "body"));
+  }
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  db_->trx_kit().destroy_trx(trx);
+
+  Trx             *reader = create_trx();
+  map<int, string> rows   = visible_rows(reader);
+  ASSERT_EQ(100, static_cast<int>(rows.size()));
+  ASSERT_EQ(string(3000, 'x'), rows[10]);
+  ASSERT_EQ("body", rows[11]);
+
+  // 修改生成新版本，旧版本的溢出页面在删除标记之后仍然可以读取
+  Trx   *updater = create_trx();
+  Record old_record;
+  RecordFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, updater, ReadWriteMode::READ_WRITE));
+  Record record;
+  while (OB_SUCC(scanner.next(record))) {
+    int id = 0;
+    memcpy(&id, record.data() + table_->table_meta().field("id")->offset(), sizeof(id));
+    if (id == 11) {
+      old_record.copy_data(record.data(), record.len());
+      old_record.set_rid(record.rid());
+      break;
+    }
+  }
+  scanner.close_scan();
+
+  Record new_record;
+  new_record.copy_data(old_record.data(), old_record.len());
+  new_record.set_rid(old_record.rid());
+  ASSERT_EQ(RC::SUCCESS,
+      table_->set_value_to_record(new_record.data(), Value(string(2000, 'y').c_str()), table_->table_meta().field("body")));
+  ASSERT_EQ(RC::SUCCESS, updater->update_record(table_, old_record, new_record));
+  ASSERT_EQ(RC::SUCCESS, updater->commit());
+
+  ASSERT_EQ("body", visible_rows(reader)[11]);
+  Trx *new_reader = create_trx();
+  rows            = visible_rows(new_reader);
+  ASSERT_EQ(100, static_cast<int>(rows.size()));
+  ASSERT_EQ(string(2000, 'y'), rows[11]);
+
+  db_->trx_kit().destroy_trx(reader);
+  db_->trx_kit().destroy_trx(updater);
+  db_->trx_kit().destroy_trx(new_reader);
+}
+
+TEST_F(VarRecordTableTest, chunk_scan)
+{
+  Trx *trx = create_trx();
+  for (int i = 0; i < 50; i++) {
+    ASSERT_EQ(RC::SUCCESS, insert(trx, i, "name" + to_string(i), "body"));
+  }
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  db_->trx_kit().destroy_trx(trx);
+
+  // 定长的列按照字段长度补齐，变长的列只保存实际的内容。列的编号是字段在表元数据中的下标，包含事务字段
+  const TableMeta &table_meta = table_->table_meta();
+  const FieldMeta *id_field   = table_meta.field("id");
+  const FieldMeta *name_field = table_meta.field("name");
+  Chunk            chunk;
+  chunk.add_column(make_unique<Column>(*id_field), table_meta.sys_field_num() + id_field->field_id());
+  auto name_column = make_unique<Column>();
+  name_column->init_var_len(name_field->type(), name_field->len());
+  chunk.add_column(std::move(name_column), table_meta.sys_field_num() + name_field->field_id());
+
+  Trx             *reader = create_trx();
+  ChunkFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, table_->get_chunk_scanner(scanner, reader, ReadWriteMode::READ_ONLY));
+  int    rows      = 0;
+  int    name_size = 0;
+  while (OB_SUCC(scanner.next_chunk(chunk))) {
+    for (int i = 0; i < chunk.rows(); i++) {
+      int id = chunk.get_value(0, i).get_int();
+      ASSERT_EQ("name" + to_string(id), chunk.get_value(1, i).get_string());
+    }
+    rows += chunk.rows();
+    name_size += chunk.column(1).data_len();
+    chunk.reset_data();
+  }
+  scanner.close_scan();
+  ASSERT_EQ(50, rows);
+  ASSERT_LT(name_size, 50 * 7);
+  db_->trx_kit().destroy_trx(reader);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}